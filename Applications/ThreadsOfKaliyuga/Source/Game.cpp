@@ -1,6 +1,7 @@
 #include "Game.hpp"
 #include <objbase.h> // For CoInitializeEx and CoUninitialize
 #include <Angaraka/Log.hpp>
+#include <Angaraka/JobSystem.hpp>
 #include <Angaraka/Asset/BundleManager.hpp>
 
 // AI Integration Layer includes
@@ -135,6 +136,9 @@ namespace ThreadsOfKaliyuga {
         // Initialize logging
         Angaraka::Logger::Framework::Initialize();
 
+        // Start the shared job system before anything submits work
+        Angaraka::Core::JobSystem::Get().Initialize(config.jobs.workerThreads > 0 ? static_cast<size_t>(config.jobs.workerThreads) : 0);
+
         // Create window
         Angaraka::WindowCreateInfo windowInfo;
         windowInfo.Title = Angaraka::UTF8ToWString(config.window.title);
@@ -271,15 +275,9 @@ namespace ThreadsOfKaliyuga {
         // Spawn test NPCs for demonstration
         SpawnTestNPCs();
 
-        // load faction dialog models
-        if (!m_aiManager->LoadFactionConfigs("Assets/ai")) {
-            AGK_APP_ERROR("Failed to load faction configurations");
-        }
-        if (!m_aiManager->LoadSharedTokenizer("Assets/ai")) {
-            AGK_APP_ERROR("Failed to load shared tokenizer");
-        }
-        if (!m_aiManager->LoadSharedDialogueModel("Assets/ai/dialogue.onnx")) {
-            AGK_APP_ERROR("Failed to load shared dialogue model");
+        // load faction dialog models; configs, tokenizer and model load in parallel and the model is warmed up
+        if (!m_aiManager->PreloadDialogueResources("Assets/ai", "Assets/ai", "Assets/ai/dialogue.onnx")) {
+            AGK_APP_ERROR("Failed to load dialogue resources (faction configs, shared tokenizer or shared dialogue model)");
         }
 
         return true;
@@ -350,6 +348,9 @@ namespace ThreadsOfKaliyuga {
         // Update game logic
         UpdateGameLogic(m_deltaTime);
 
+        // Deliver events queued by this frame's updates
+        Angaraka::Events::EventManager::Get().FlushEvents();
+
         // Update scene management
         UpdateScene(m_deltaTime);
     }
@@ -708,6 +709,8 @@ namespace ThreadsOfKaliyuga {
         m_graphicsSystem = nullptr;
         AGK_APP_INFO("GraphicsSystem shutdown");
 
+        Angaraka::Core::JobSystem::Get().Shutdown();
+
         Angaraka::Logger::Framework::Shutdown();
     }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 module;
 
 #include "Angaraka/Base.hpp"
+#include "Angaraka/ResourceCache.hpp"
 #include <yaml-cpp/yaml.h>
 #include <filesystem>
 #include <iostream>
@@ -35,10 +36,16 @@ namespace Angaraka::Config {
         bool fullscreen{ false };
     };
 
+    export struct JobSystemConfig {
+        int workerThreads{ 0 };             // 0 = hardware threads - 1
+    };
+
     export struct ResourceCacheConfig {
         int maxMemoryMB = 512;
         int maxSingleResourceMB = 64;
         int evictionThreshold = 85;
+        int shardCount = 16;
+        String evictionPolicy{ "lru" };   // lru, clock, tinylfu
         bool enableEviction = true;
         bool logEvictions = true;
 
@@ -47,6 +54,8 @@ namespace Angaraka::Config {
             budget.maxTotalMemory = maxMemoryMB * 1024 * 1024;
             budget.maxSingleResource = maxSingleResourceMB * 1024 * 1024;
             budget.evictionThreshold = evictionThreshold;
+            budget.shardCount = shardCount;
+            budget.evictionPolicy = Core::EvictionPolicyFromString(evictionPolicy);
             budget.enableEviction = enableEviction;
             budget.logEvictions = logEvictions;
             return budget;
@@ -78,7 +87,18 @@ namespace Angaraka::Config {
         size_t maxVRAMUsageMB{ 16384 };        // 16GB default for RTX 4080/4090
         F32 dialogueTimeoutMs{ 100.0f };     // Max time for dialogue inference
         F32 terrainTimeoutMs{ 5000.0f };     // Max time for terrain generation
-        size_t backgroundThreadCount{ 4 };     // Threads for async operations
+        size_t maxDialogueTokens{ 48 };       // Max tokens generated per dialogue response
+        size_t maxDialogueContextTokens{ 512 }; // Prompt length the preallocated dialogue tensors are sized for
+        size_t dialogueBatchSize{ 8 };        // Max dialogue requests generated together
+        F32 dialogueBatchWindowMs{ 5.0f };   // How long a dialogue request waits for others to batch with
+        size_t maxConcurrentInferences{ 2 };  // AI requests running at once on the job system
+        size_t maxQueuedInferences{ 64 };     // Waiting AI requests before new ones are rejected
+        bool enableResponseCache{ true };     // Replay earlier responses to identical dialogue prompts
+        size_t responseCacheBudgetMB{ 4 };
+        F32 responseCacheTTLSeconds{ 600.0f };
+        String responseCachePath;             // Persisted between sessions when set
+        bool warmupModels{ true };            // Run a dummy inference at load so the first request skips graph setup
+        bool cacheOptimizedModels{ true };    // Save the optimized graph next to the model and load it on later runs
         String defaultFaction{ "neutral" };
         bool enablePerformanceMonitoring{ true };
     };
@@ -94,6 +114,7 @@ namespace Angaraka::Config {
         std::vector<String> pluginPaths;
 
         LogConfig logging;
+        JobSystemConfig jobs;
         WindowConfig window;
         RendererConfig renderer;
         AISystemConfig ai;
@@ -202,6 +223,12 @@ namespace Angaraka::Config {
                         ec.logging.game = loggingNode["game"].as<String>();
                 }
 
+                // Parse job system config
+                if (auto jobsNode = config["jobs"]) {
+                    if (jobsNode["worker_threads"])
+                        ec.jobs.workerThreads = jobsNode["worker_threads"].as<int>(0);
+                }
+
                 // Parse window config (now at root)
                 if (auto windowNode = config["window"]) {
                     ec.window = {};
@@ -223,8 +250,30 @@ namespace Angaraka::Config {
                         ec.ai.dialogueTimeoutMs = dialogueTimeoutNode.as<F32>(100.0f);
                     if (auto terrainTimeoutNode = aiNode["terrain_timeout_ms"])
                         ec.ai.terrainTimeoutMs = terrainTimeoutNode.as<F32>(5000.0f);
-                    if (auto backgroundThreadCountNode = aiNode["background_thread_count"])
-                        ec.ai.backgroundThreadCount = backgroundThreadCountNode.as<size_t>(4);
+                    if (auto maxDialogueTokensNode = aiNode["max_dialogue_tokens"])
+                        ec.ai.maxDialogueTokens = maxDialogueTokensNode.as<size_t>(48);
+                    if (auto maxDialogueContextTokensNode = aiNode["max_dialogue_context_tokens"])
+                        ec.ai.maxDialogueContextTokens = maxDialogueContextTokensNode.as<size_t>(512);
+                    if (auto dialogueBatchSizeNode = aiNode["dialogue_batch_size"])
+                        ec.ai.dialogueBatchSize = dialogueBatchSizeNode.as<size_t>(8);
+                    if (auto dialogueBatchWindowNode = aiNode["dialogue_batch_window_ms"])
+                        ec.ai.dialogueBatchWindowMs = dialogueBatchWindowNode.as<F32>(5.0f);
+                    if (auto maxConcurrentInferencesNode = aiNode["max_concurrent_inferences"])
+                        ec.ai.maxConcurrentInferences = maxConcurrentInferencesNode.as<size_t>(2);
+                    if (auto maxQueuedInferencesNode = aiNode["max_queued_inferences"])
+                        ec.ai.maxQueuedInferences = maxQueuedInferencesNode.as<size_t>(64);
+                    if (auto enableResponseCacheNode = aiNode["enable_response_cache"])
+                        ec.ai.enableResponseCache = enableResponseCacheNode.as<bool>(true);
+                    if (auto responseCacheBudgetNode = aiNode["response_cache_budget_mb"])
+                        ec.ai.responseCacheBudgetMB = responseCacheBudgetNode.as<size_t>(4);
+                    if (auto responseCacheTTLNode = aiNode["response_cache_ttl_seconds"])
+                        ec.ai.responseCacheTTLSeconds = responseCacheTTLNode.as<F32>(600.0f);
+                    if (auto responseCachePathNode = aiNode["response_cache_path"])
+                        ec.ai.responseCachePath = responseCachePathNode.as<String>("");
+                    if (auto warmupModelsNode = aiNode["warmup_models"])
+                        ec.ai.warmupModels = warmupModelsNode.as<bool>(true);
+                    if (auto cacheOptimizedModelsNode = aiNode["cache_optimized_models"])
+                        ec.ai.cacheOptimizedModels = cacheOptimizedModelsNode.as<bool>(true);
                     if (auto defaultFactionNode = aiNode["default_faction"])
                         ec.ai.defaultFaction = defaultFactionNode.as<String>("neutral");
                     if (auto enablePerformanceMonitoringNode = aiNode["enable_performance_monitoring"])
@@ -294,6 +343,10 @@ namespace Angaraka::Config {
                             ec.renderer.resourceCache.maxSingleResourceMB = cacheNode["max_single_resource_mb"].as<int>();
                         if (cacheNode["eviction_threshold"])
                             ec.renderer.resourceCache.evictionThreshold = cacheNode["eviction_threshold"].as<int>();
+                        if (cacheNode["shard_count"])
+                            ec.renderer.resourceCache.shardCount = cacheNode["shard_count"].as<int>();
+                        if (cacheNode["eviction_policy"])
+                            ec.renderer.resourceCache.evictionPolicy = cacheNode["eviction_policy"].as<String>();
                         if (cacheNode["enable_eviction"])
                             ec.renderer.resourceCache.enableEviction = cacheNode["enable_eviction"].as<bool>();
                         if (cacheNode["log_evictions"])
@@ -1,6 +1,10 @@
 module;
 
 #include "Angaraka/Base.hpp"
+#include <array>
+#include <bit>
+#include <mutex>
+#include <span>
 
 export module Angaraka.Core.Events;
 
@@ -59,6 +63,93 @@ namespace Angaraka::Events {
     using EventCallback = std::function<void(const Event&)>;
     using SubscriptionID = size_t; // Unique ID for each subscription
 
+    // Type-erased batch listener: receives a contiguous array of events of one type
+    using BatchEventCallback = std::function<void(const void* events, size_t count)>;
+    // Returns element 'index' of a contiguous array of one concrete event type
+    using EventAccessor = const Event& (*)(const void* events, size_t index);
+
+    export class IEventManager;
+
+    // --- Deferred Event Queue ---
+    // Type-erased view of a per-type event ring so the manager can flush every type in one pass.
+    export class IEventQueue {
+    public:
+        virtual ~IEventQueue() = default;
+
+        // Hands every committed event to the listeners of typeId. Single consumer only.
+        virtual void Flush(IEventManager& manager, size_t typeId) = 0;
+
+        // Events rejected because the ring was full since the last call
+        virtual size_t TakeDroppedCount() = 0;
+        virtual size_t GetCapacity() const = 0;
+    };
+
+    using EventQueueFactory = Reference<IEventQueue>(*)(size_t capacity);
+
+    // Bounded multi-producer, single-consumer ring of one event type.
+    // Producers claim a slot with a CAS on the tail and publish it through a per-slot sequence
+    // number, so Push never takes a lock. Events are stored contiguously, so a flush hands
+    // listeners at most two spans (one when the committed range does not wrap).
+    export template<typename EventType>
+    class EventQueue : public IEventQueue {
+    public:
+        explicit EventQueue(size_t capacity)
+            : m_capacity(std::bit_ceil(capacity < 2 ? size_t{ 2 } : capacity))
+            , m_mask(m_capacity - 1)
+            , m_events(m_capacity)
+            , m_sequences(new std::atomic<size_t>[m_capacity]) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                m_sequences[i].store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // Returns false (and counts a drop) when the ring is full
+        bool Push(EventType&& event) {
+            size_t position = m_tail.load(std::memory_order_relaxed);
+            while (true) {
+                size_t sequence = m_sequences[position & m_mask].load(std::memory_order_acquire);
+                auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (difference == 0) {
+                    if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (difference < 0) {
+                    // Slot still holds an event from a previous lap that has not been flushed
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else {
+                    position = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            m_events[position & m_mask] = std::move(event);
+            m_sequences[position & m_mask].store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        void Flush(IEventManager& manager, size_t typeId) override;
+
+        size_t TakeDroppedCount() override { return m_dropped.exchange(0, std::memory_order_relaxed); }
+        size_t GetCapacity() const override { return m_capacity; }
+
+    private:
+        static const Event& EventAt(const void* events, size_t index) {
+            return static_cast<const EventType*>(events)[index];
+        }
+
+        const size_t m_capacity;
+        const size_t m_mask;
+        std::vector<EventType> m_events;
+        Scope<std::atomic<size_t>[]> m_sequences;
+
+        alignas(64) std::atomic<size_t> m_tail{ 0 };   // Next slot producers claim
+        alignas(64) size_t m_head = 0;                 // Next slot the flush reads, consumer only
+        std::atomic<size_t> m_dropped{ 0 };
+    };
+
     // --- Event Manager Interface ---
     // This interface defines the core functionality of the event bus.
     export class IEventManager {
@@ -80,25 +171,104 @@ namespace Angaraka::Events {
             UnsubscribeInternal(EventType::GetStaticType_s(), id);
         }
 
+        // Subscribes a callback that receives every queued event of a type at once during FlushEvents.
+        // Events sent with Broadcast are not delivered to batch listeners. Unsubscribe with Unsubscribe<EventType>.
+        template<typename EventType>
+        inline SubscriptionID SubscribeBatch(std::function<void(std::span<const EventType>)> callback) {
+            AGK_INFO("EventManager: Subscribing batch callback to event type: {0}", typeid(EventType).name());
+            return SubscribeBatchInternal(EventType::GetStaticType_s(),
+                [callback = std::move(callback)](const void* events, size_t count) {
+                    callback(std::span<const EventType>(static_cast<const EventType*>(events), count));
+                });
+        }
+
         // Broadcasts an event to all subscribed listeners.
-        // The event object is passed by const reference.
+        // The event object is passed by const reference. Safe to call from any thread.
         template<typename EventType>
         inline void Broadcast(const EventType& event) {
-            AGK_TRACE("EventManager: Broadcasting event: {0}", event.GetName());
             BroadcastInternal(event.GetStaticType(), event);
         }
 
+        // Queues an event for the next FlushEvents. Lock-free and safe to call from any thread.
+        // Returns false if the type's ring is full and the event was dropped.
+        template<typename EventType>
+        inline bool Enqueue(EventType event) {
+            IEventQueue* queue = AcquireQueueInternal(EventType::GetStaticType_s(), &CreateQueue<EventType>, 0);
+            return static_cast<EventQueue<EventType>*>(queue)->Push(std::move(event));
+        }
+
+        // Creates the queue for a type up front with a specific capacity. Has no effect once the
+        // queue exists (the first Enqueue creates it with the default capacity).
+        template<typename EventType>
+        inline void ReserveEventQueue(size_t capacity) {
+            AcquireQueueInternal(EventType::GetStaticType_s(), &CreateQueue<EventType>, capacity);
+        }
+
+        // Delivers all queued events, one type at a time: batch listeners get a span, regular
+        // listeners get each event. Call once per frame from a single thread. Events queued by
+        // listeners during the flush are delivered on the next one.
+        virtual void FlushEvents() = 0;
+
     protected:
+        template<typename EventType> friend class EventQueue;
+
+        template<typename EventType>
+        static Reference<IEventQueue> CreateQueue(size_t capacity) {
+            return CreateReference<EventQueue<EventType>>(capacity);
+        }
+
         // Internal methods to be implemented by concrete EventManager.
         // Using size_t for type ID to keep map type-agnostic.
         virtual SubscriptionID SubscribeInternal(size_t typeId, EventCallback callback) = 0;
+        virtual SubscriptionID SubscribeBatchInternal(size_t typeId, BatchEventCallback callback) = 0;
         virtual void UnsubscribeInternal(size_t typeId, SubscriptionID id) = 0;
         virtual void BroadcastInternal(size_t typeId, const Event& event) = 0;
+        virtual IEventQueue* AcquireQueueInternal(size_t typeId, EventQueueFactory factory, size_t capacity) = 0;
+        virtual void DispatchBatchInternal(size_t typeId, const void* events, size_t count, EventAccessor accessor) = 0;
     };
 
+    template<typename EventType>
+    void EventQueue<EventType>::Flush(IEventManager& manager, size_t typeId) {
+        // Collect the committed run; a claimed but unwritten slot ends it until the next flush
+        size_t head = m_head;
+        size_t end = head;
+        while (end - head < m_capacity &&
+            m_sequences[end & m_mask].load(std::memory_order_acquire) == end + 1) {
+            ++end;
+        }
+
+        size_t count = end - head;
+        if (count == 0) {
+            return;
+        }
+
+        size_t first = head & m_mask;
+        size_t run = count < m_capacity - first ? count : m_capacity - first;
+        manager.DispatchBatchInternal(typeId, m_events.data() + first, run, &EventAt);
+        if (run < count) {
+            manager.DispatchBatchInternal(typeId, m_events.data(), count - run, &EventAt);
+        }
+
+        // Hand the slots back to producers for the next lap
+        for (size_t position = head; position < end; ++position) {
+            m_sequences[position & m_mask].store(position + m_capacity, std::memory_order_release);
+        }
+        m_head = end;
+    }
+
 
     // --- Concrete Event Manager Implementation ---
     // This class provides the actual implementation of the event bus.
+    //
+    // Listeners live in an immutable dispatch table indexed directly by event type ID.
+    // Subscribe/Unsubscribe build a new table under a mutex and publish it with an atomic
+    // pointer swap, so Broadcast takes no lock and allocates nothing. Replaced tables are
+    // reclaimed by epoch: readers count themselves in a per-thread stripe under the epoch's
+    // parity, and a table retired in epoch E is freed once both parities have drained, by the
+    // next writer or, failing that, the next broadcast.
+    //
+    // Each event type may also own a deferred EventQueue, created on first Enqueue and
+    // drained by FlushEvents.
     export class EventManager : public IEventManager {
     public:
         EventManager();
@@ -107,15 +277,92 @@ namespace Angaraka::Events {
         // Singleton accessor (simple for now, can be integrated with a PluginManager later)
         static EventManager& Get();
 
+        void FlushEvents() override;
+
+        // Capacity of queues created implicitly by Enqueue
+        void SetDefaultQueueCapacity(size_t capacity) { m_defaultQueueCapacity.store(capacity, std::memory_order_relaxed); }
+
     protected: // Protected as per IEventManager, but also allows direct calls from within the module if needed
         SubscriptionID SubscribeInternal(size_t typeId, EventCallback callback) override;
+        SubscriptionID SubscribeBatchInternal(size_t typeId, BatchEventCallback callback) override;
         void UnsubscribeInternal(size_t typeId, SubscriptionID id) override;
         void BroadcastInternal(size_t typeId, const Event& event) override;
+        IEventQueue* AcquireQueueInternal(size_t typeId, EventQueueFactory factory, size_t capacity) override;
+        void DispatchBatchInternal(size_t typeId, const void* events, size_t count, EventAccessor accessor) override;
 
     private:
-        // Map to store event listeners: Event Type ID -> (SubscriptionID -> Callback)
-        // Using a map for inner storage to allow easy removal by ID.
-        std::map<size_t, std::map<SubscriptionID, EventCallback>> m_listeners;
+        // Dense listener arrays for one event type. Never modified once published.
+        struct ListenerList {
+            std::vector<SubscriptionID> ids;
+            std::vector<EventCallback> callbacks;
+            std::vector<SubscriptionID> batchIds;
+            std::vector<BatchEventCallback> batchCallbacks;
+
+            bool IsEmpty() const { return ids.empty() && batchIds.empty(); }
+        };
+
+        // Event Type ID -> listeners and deferred queue. Missing entries hold null.
+        // Queues are never removed, so a queue pointer stays valid once read.
+        struct DispatchTable {
+            std::vector<Reference<const ListenerList>> lists;
+            std::vector<Reference<IEventQueue>> queues;
+        };
+
+        // In-flight readers of one thread stripe, counted under the parity of the epoch they entered
+        struct alignas(64) ReaderStripe {
+            std::atomic<U32> active[2]{};
+        };
+        static constexpr size_t ReaderStripeCount = 16;
+
+        struct RetiredTable {
+            Scope<DispatchTable> table;
+            U64 epoch;                                   // Epoch in which it was replaced
+        };
+
+        // Pins the current table for the lifetime of the guard so writers will not free it.
+        // Only touches the calling thread's stripe, so concurrent broadcasts do not contend.
+        class ReadGuard {
+        public:
+            explicit ReadGuard(EventManager& manager)
+                : m_manager(manager)
+                , m_counter(&manager.m_readerStripes[GetReaderStripe()].active[manager.m_epoch.load(std::memory_order_relaxed) & 1]) {
+                m_counter->fetch_add(1, std::memory_order_seq_cst);
+                m_table = m_manager.m_table.load(std::memory_order_seq_cst);
+            }
+            ~ReadGuard() {
+                m_counter->fetch_sub(1, std::memory_order_release);
+                if (m_manager.m_hasRetiredTables.load(std::memory_order_relaxed)) {
+                    m_manager.TryReclaimRetiredTables();
+                }
+            }
+
+            const DispatchTable* operator->() const { return m_table; }
+            explicit operator bool() const { return m_table != nullptr; }
+
+        private:
+            EventManager& m_manager;
+            std::atomic<U32>* m_counter;
+            const DispatchTable* m_table;
+        };
+
+        static size_t GetReaderStripe();
+
+        SubscriptionID AddListener(size_t typeId, EventCallback callback, BatchEventCallback batchCallback);
+        void PublishTable(Scope<DispatchTable> table);
+        void ReclaimRetiredTables();
+        void TryReclaimRetiredTables();
+        bool IsEpochDrained(U64 epoch) const;
+
+        std::atomic<const DispatchTable*> m_table{ nullptr };
+        std::array<ReaderStripe, ReaderStripeCount> m_readerStripes;
+        std::atomic<U64> m_epoch{ 0 };                     // Advanced by writers once the previous parity drains
+        std::atomic<bool> m_hasRetiredTables{ false };     // Lets broadcasts skip reclamation when nothing waits
+        std::vector<RetiredTable> m_retiredTables;         // Replaced tables waiting for readers to leave
+        Scope<DispatchTable> m_currentTable;               // Owns the table m_table points to
+        std::mutex m_writeMutex;                           // Serializes Subscribe/Unsubscribe and queue creation
+        std::mutex m_flushMutex;                           // Keeps FlushEvents single-consumer
+        std::atomic<size_t> m_defaultQueueCapacity{ 1024 };
+
         static Scope<EventManager> s_instance; // Singleton instance
         std::atomic<SubscriptionID> m_nextSubscriptionId; // For generating unique IDs
     };
@@ -3,6 +3,8 @@ module;
 
 #include <Angaraka/Base.hpp>
 #include <Angaraka/Asset/BundleConfig.hpp>
+#include <array>
+#include <mutex>
 
 export module Angaraka.Core.GraphicsFactory;
 
@@ -11,6 +13,11 @@ import <filesystem>;
 
 namespace Angaraka::Core {
 
+    // A factory whose Create*Impl calls may run concurrently on loader threads declares
+    // `static constexpr bool IsThreadSafe = true;`. DirectX12ResourceFactory does.
+    export template<typename T>
+    concept ThreadSafeResourceFactory = requires { requires T::IsThreadSafe; };
+
     // CRTP base interface
     export template<typename Derived>
     class IGraphicsResourceFactory {
@@ -37,7 +44,8 @@ namespace Angaraka::Core {
 
 
 
-    // Type-erased wrapper for storage
+    // Type-erased wrapper for storage. Calls into a factory that is not thread-safe are
+    // serialized per resource kind, so a texture load never waits on a mesh load.
     export class GraphicsResourceFactory {
     public:
         template<typename T>
@@ -83,22 +91,36 @@ namespace Angaraka::Core {
             virtual Reference<Resource> CreateSound(const AssetDefinition& asset, void* context) = 0;
         };
 
+        enum ResourceKind : size_t { Texture, Mesh, Material, Sound, KindCount };
+
         template<typename T>
         struct FactoryWrapper : IFactoryWrapper {
             T factory;
+            std::array<std::mutex, KindCount> kindMutexes;   // Unused by thread-safe factories
             FactoryWrapper(T&& f) : factory(std::forward<T>(f)) {}
 
             Reference<Resource> CreateTexture(const AssetDefinition& asset, void* context) override {
-                return factory.CreateTexture(asset, context);
+                return Call(Texture, [&] { return factory.CreateTexture(asset, context); });
             }
             Reference<Resource> CreateMesh(const AssetDefinition& asset, void* context) override {
-                return factory.CreateMesh(asset, context);
+                return Call(Mesh, [&] { return factory.CreateMesh(asset, context); });
             }
             Reference<Resource> CreateMaterial(const AssetDefinition& asset, void* context) override {
-                return factory.CreateMaterial(asset, context);
+                return Call(Material, [&] { return factory.CreateMaterial(asset, context); });
             }
             Reference<Resource> CreateSound(const AssetDefinition& asset, void* context) override {
-                return factory.CreateSound(asset, context);
+                return Call(Sound, [&] { return factory.CreateSound(asset, context); });
+            }
+
+            template<typename Fn>
+            Reference<Resource> Call(ResourceKind kind, Fn&& create) {
+                if constexpr (ThreadSafeResourceFactory<std::remove_cvref_t<T>>) {
+                    return create();
+                }
+                else {
+                    std::lock_guard<std::mutex> lock(kindMutexes[kind]);
+                    return create();
+                }
             }
         };
 
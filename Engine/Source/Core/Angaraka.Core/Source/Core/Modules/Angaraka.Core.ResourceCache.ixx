@@ -3,6 +3,7 @@ module;
 #include "Angaraka/Base.hpp"
 #include "Angaraka/ResourceCache.hpp"
 #include "Angaraka/Asset/BundleConfig.hpp"
+#include <future>
 
 export module Angaraka.Core.ResourceCache;
 
@@ -16,6 +17,7 @@ namespace Angaraka::Core {
     // Re-export cache types for public use
     export struct CacheEntry;
     export struct MemoryBudget;
+    export enum class EvictionPolicy : U8;
     export struct EvictionStats;
     export class ResourceCache;
 
@@ -40,9 +42,7 @@ namespace Angaraka::Core {
         // Resource access with caching
         template<typename T>
         Reference<T> GetResource(const String& id, const String& path = {}, void* context = nullptr) {
-            std::lock_guard<std::mutex> lock(m_managerMutex);
-
-            // Check cache first
+            // Check cache first. The cache is internally sharded, so hits never take the manager lock.
             if (auto cached = m_cache.Get(id)) {
                 if (auto typedResource = std::dynamic_pointer_cast<T>(cached)) {
                     AGK_TRACE("CachedResourceManager: Cache hit for '{}'", id);
@@ -53,31 +53,43 @@ namespace Angaraka::Core {
                 AGK_WARN("CachedResourceManager: Type mismatch for cached resource '{}', removing", id);
             }
 
-            // For cache miss, use factory instead of direct construction:
-            Reference<Resource> newResource;
-
-            // Try loading it as a graphics resource
-            if (m_graphicsFactory) {
-                // Determine asset type and use appropriate factory method
-                AssetDefinition tempAsset{};
-                tempAsset.id = id;
-                tempAsset.path = m_basePath + "/" + path;
-                // You'll need logic to determine asset type from ID/extension
-
-                newResource = m_graphicsFactory->Create(tempAsset, context);
-                
-                if (newResource) {
-                    m_cache.Put(id, newResource, EstimateResourceSize(newResource));
+            // Cache miss. Concurrent misses on the same id wait for the first one's load.
+            std::promise<Reference<Resource>> loadPromise;
+            std::shared_future<Reference<Resource>> pendingLoad;
+            Reference<Core::GraphicsResourceFactory> graphicsFactory;
+            bool loadHere = false;
+            {
+                std::lock_guard<std::mutex> lock(m_managerMutex);
+
+                auto pendingIt = m_pendingLoads.find(id);
+                if (pendingIt != m_pendingLoads.end()) {
+                    pendingLoad = pendingIt->second;
+                }
+                else if (auto cached = m_cache.Peek(id)) {
+                    // Cached by a load that finished after our lookup
+                    return std::dynamic_pointer_cast<T>(cached);
+                }
+                else {
+                    pendingLoad = loadPromise.get_future().share();
+                    m_pendingLoads.emplace(id, pendingLoad);
+                    graphicsFactory = m_graphicsFactory;
+                    loadHere = true;
                 }
-
-
-                return newResource;
             }
 
-            // Try loading as a ai resource
+            if (loadHere) {
+                try {
+                    Reference<Resource> newResource = LoadResource(graphicsFactory, id, path, context);
+                    FinishLoad(id);
+                    loadPromise.set_value(std::move(newResource));
+                }
+                catch (...) {
+                    FinishLoad(id);
+                    loadPromise.set_exception(std::current_exception());
+                }
+            }
 
-            AGK_ERROR("CachedResourceManager: Failed to load resource '{}'", id);
-            return nullptr;
+            return std::dynamic_pointer_cast<T>(pendingLoad.get());
         }
 
         // Cache management
@@ -86,7 +98,7 @@ namespace Angaraka::Core {
         void SetCacheConfig(const MemoryBudget& config);
 
         // Statistics and monitoring
-        const EvictionStats& GetCacheStats() const { return m_cache.GetEvictionStats(); }
+        EvictionStats GetCacheStats() const { return m_cache.GetEvictionStats(); }
         size_t GetCacheMemoryUsage() const { return m_cache.GetCurrentMemoryUsage(); }
         F32 GetCacheUtilization() const { return m_cache.GetMemoryUtilization(); }
         bool IsCacheHealthy() const { return m_cache.IsMemoryHealthy(); }
@@ -102,6 +114,14 @@ namespace Angaraka::Core {
 
         Reference<Core::GraphicsResourceFactory> m_graphicsFactory;
 
+        // Loads in flight by id, guarded by m_managerMutex
+        std::unordered_map<String, std::shared_future<Reference<Resource>>> m_pendingLoads;
+
+        // Creates the resource through the factory and caches it
+        Reference<Resource> LoadResource(const Reference<Core::GraphicsResourceFactory>& graphicsFactory,
+            const String& id, const String& path, void* context);
+        void FinishLoad(const String& id);
+
         // Generic fallback estimation
         size_t EstimateResourceSize(const Reference<Resource>& resource) const;
     };
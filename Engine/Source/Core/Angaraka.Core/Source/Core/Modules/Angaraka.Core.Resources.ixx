@@ -83,8 +83,15 @@ namespace Angaraka::Core {
          */ 
         virtual bool IsLoaded() const { return m_isLoaded; }
 
-        // Optionally, add a virtual method to prepare for GPU upload,
-        // or ensure GPU-specific setup happens in a specialized system.
+        /**
+         * @brief Invoke a callback once the resource can be used.
+         *
+         * Load may return while work it started is still in flight, such as GPU uploads.
+         * Such resources override this to defer the callback until that work has finished,
+         * in which case it may run on another thread. By default it runs immediately.
+         * @param callback Called exactly once.
+         */
+        virtual void WhenReady(std::function<void()> callback) { callback(); }
 
     protected:
         // Protected constructor to ensure Resource is only created by derived classes.
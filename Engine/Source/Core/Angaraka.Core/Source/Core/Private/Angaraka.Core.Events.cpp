@@ -2,7 +2,8 @@ module;
 
 #include "Angaraka/Base.hpp"
 #include "Angaraka/Log.hpp"
-#include <map>
+#include <algorithm>
+#include <mutex>
 
 module Angaraka.Core.Events;
 
@@ -21,67 +22,260 @@ namespace Angaraka::Events {
             AGK_ERROR("EventManager: Attempted to create a second EventManager instance!");
             throw std::runtime_error("Only one EventManager instance is allowed.");
         }
+
+        m_currentTable = CreateScope<DispatchTable>();
+        m_table.store(m_currentTable.get(), std::memory_order_release);
     }
 
     EventManager::~EventManager() {
         AGK_INFO("EventManager: Destructor called.");
-        m_listeners.clear(); // Clear all listeners
+
+        // Clear all listeners
+        m_table.store(nullptr, std::memory_order_release);
+        m_currentTable.reset();
+        m_retiredTables.clear();
     }
 
     EventManager& EventManager::Get() {
-        // Create the instance lazily if it doesn't exist
-        if (!s_instance) {
+        // Create the instance lazily; call_once keeps first use from several threads safe
+        static std::once_flag s_createFlag;
+        std::call_once(s_createFlag, [] {
             s_instance = Scope<EventManager>(new EventManager()); // Use new to create and manage lifetime
-        }
+        });
         return *s_instance;
     }
 
     SubscriptionID EventManager::SubscribeInternal(size_t typeId, EventCallback callback) {
-        SubscriptionID newId = std::atomic_fetch_add(&m_nextSubscriptionId, 1ULL);
-        m_listeners[typeId][newId] = callback; // Store callback with its new ID
+        SubscriptionID newId = AddListener(typeId, std::move(callback), nullptr);
         AGK_INFO("EventManager: Listener added for event type ID: {0}, Subscription ID: {1}", typeId, newId);
         return newId;
     }
 
+    SubscriptionID EventManager::SubscribeBatchInternal(size_t typeId, BatchEventCallback callback) {
+        SubscriptionID newId = AddListener(typeId, nullptr, std::move(callback));
+        AGK_INFO("EventManager: Batch listener added for event type ID: {0}, Subscription ID: {1}", typeId, newId);
+        return newId;
+    }
+
+    SubscriptionID EventManager::AddListener(size_t typeId, EventCallback callback, BatchEventCallback batchCallback) {
+        SubscriptionID newId = std::atomic_fetch_add(&m_nextSubscriptionId, 1ULL);
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        // Copy-on-write: only the list for this type is rebuilt, other types share their lists
+        auto table = CreateScope<DispatchTable>(*m_currentTable);
+        if (table->lists.size() <= typeId) {
+            table->lists.resize(typeId + 1);
+        }
+
+        auto list = table->lists[typeId]
+            ? CreateReference<ListenerList>(*table->lists[typeId])
+            : CreateReference<ListenerList>();
+        if (batchCallback) {
+            list->batchIds.push_back(newId);
+            list->batchCallbacks.push_back(std::move(batchCallback));
+        }
+        else {
+            list->ids.push_back(newId);
+            list->callbacks.push_back(std::move(callback));
+        }
+        table->lists[typeId] = std::move(list);
+
+        PublishTable(std::move(table));
+        return newId;
+    }
+
     void EventManager::UnsubscribeInternal(size_t typeId, SubscriptionID id) {
-        auto it = m_listeners.find(typeId);
-        if (it != m_listeners.end()) {
-            size_t erased_count = it->second.erase(id); // Erase by SubscriptionID
-            if (erased_count > 0) {
-                AGK_INFO("EventManager: Listener removed for event type ID: {0}, Subscription ID: {1}", typeId, id);
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        const auto& lists = m_currentTable->lists;
+        if (typeId >= lists.size() || !lists[typeId]) {
+            AGK_WARN("EventManager: Attempted to unsubscribe from non-existent event type ID: {0}", typeId);
+            return;
+        }
+
+        const ListenerList& existing = *lists[typeId];
+        auto it = std::find(existing.ids.begin(), existing.ids.end(), id);
+        auto batchIt = std::find(existing.batchIds.begin(), existing.batchIds.end(), id);
+        if (it == existing.ids.end() && batchIt == existing.batchIds.end()) {
+            AGK_WARN("EventManager: Attempted to unsubscribe non-existent listener for event type ID: {0}, Subscription ID: {1}", typeId, id);
+            return;
+        }
+
+        // Keep subscription order so listeners are still invoked in the order they subscribed
+        auto list = CreateReference<ListenerList>(existing);
+        if (it != existing.ids.end()) {
+            size_t index = static_cast<size_t>(it - existing.ids.begin());
+            list->ids.erase(list->ids.begin() + index);
+            list->callbacks.erase(list->callbacks.begin() + index);
+        }
+        else {
+            size_t index = static_cast<size_t>(batchIt - existing.batchIds.begin());
+            list->batchIds.erase(list->batchIds.begin() + index);
+            list->batchCallbacks.erase(list->batchCallbacks.begin() + index);
+        }
+
+        auto table = CreateScope<DispatchTable>(*m_currentTable);
+        if (list->IsEmpty()) {
+            // If no more listeners for this event type, drop the list
+            table->lists[typeId] = nullptr;
+            AGK_INFO("EventManager: All listeners for event type ID: {0} removed. Removing type entry.", typeId);
+        }
+        else {
+            table->lists[typeId] = std::move(list);
+        }
+
+        PublishTable(std::move(table));
+        AGK_INFO("EventManager: Listener removed for event type ID: {0}, Subscription ID: {1}", typeId, id);
+    }
+
+    void EventManager::BroadcastInternal(size_t typeId, const Event& event) {
+        ReadGuard table(*this);
+        if (!table || typeId >= table->lists.size()) {
+            return;
+        }
+
+        // The snapshot is immutable, so callbacks may subscribe or unsubscribe (even themselves)
+        // while we iterate; changes apply from the next broadcast.
+        if (const ListenerList* list = table->lists[typeId].get()) {
+            for (const auto& callback : list->callbacks) {
+                callback(event);
             }
-            else {
-                AGK_WARN("EventManager: Attempted to unsubscribe non-existent listener for event type ID: {0}, Subscription ID: {1}", typeId, id);
+        }
+    }
+
+    IEventQueue* EventManager::AcquireQueueInternal(size_t typeId, EventQueueFactory factory, size_t capacity) {
+        // Fast path: the queue exists, no lock
+        {
+            ReadGuard table(*this);
+            if (table && typeId < table->queues.size() && table->queues[typeId]) {
+                return table->queues[typeId].get();
             }
-            // If no more listeners for this event type, remove the inner map
-            if (it->second.empty()) {
-                m_listeners.erase(it);
-                AGK_INFO("EventManager: All listeners for event type ID: {0} removed. Removing type entry.", typeId);
+        }
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        // Another producer may have created it while we waited
+        if (typeId < m_currentTable->queues.size() && m_currentTable->queues[typeId]) {
+            return m_currentTable->queues[typeId].get();
+        }
+
+        if (capacity == 0) {
+            capacity = m_defaultQueueCapacity.load(std::memory_order_relaxed);
+        }
+
+        auto table = CreateScope<DispatchTable>(*m_currentTable);
+        if (table->queues.size() <= typeId) {
+            table->queues.resize(typeId + 1);
+        }
+        table->queues[typeId] = factory(capacity);
+        IEventQueue* queue = table->queues[typeId].get();
+
+        AGK_INFO("EventManager: Created event queue for event type ID: {0} (capacity: {1})", typeId, queue->GetCapacity());
+        PublishTable(std::move(table));
+        return queue;
+    }
+
+    void EventManager::DispatchBatchInternal(size_t typeId, const void* events, size_t count, EventAccessor accessor) {
+        ReadGuard table(*this);
+        if (!table || typeId >= table->lists.size()) {
+            return;
+        }
+
+        const ListenerList* list = table->lists[typeId].get();
+        if (!list) {
+            return;
+        }
+
+        for (const auto& batchCallback : list->batchCallbacks) {
+            batchCallback(events, count);
+        }
+
+        // Regular listeners still see queued events, one at a time
+        if (!list->callbacks.empty()) {
+            for (size_t i = 0; i < count; ++i) {
+                const Event& event = accessor(events, i);
+                for (const auto& callback : list->callbacks) {
+                    callback(event);
+                }
             }
         }
-        else {
-            AGK_WARN("EventManager: Attempted to unsubscribe from non-existent event type ID: {0}", typeId);
+    }
+
+    void EventManager::FlushEvents() {
+        std::lock_guard<std::mutex> flushLock(m_flushMutex);
+
+        ReadGuard table(*this);
+        if (!table) {
+            return;
+        }
+
+        for (size_t typeId = 0; typeId < table->queues.size(); ++typeId) {
+            IEventQueue* queue = table->queues[typeId].get();
+            if (!queue) {
+                continue;
+            }
+
+            queue->Flush(*this, typeId);
+
+            if (size_t dropped = queue->TakeDroppedCount()) {
+                AGK_WARN("EventManager: Dropped {0} queued events of type ID: {1} (queue capacity: {2})",
+                    dropped, typeId, queue->GetCapacity());
+            }
         }
     }
 
-    void EventManager::BroadcastInternal(size_t typeId, const Event& event) {
-        // Find listeners for this event type
-        auto it = m_listeners.find(typeId);
-        if (it != m_listeners.end()) {
-            // Iterate through all callbacks and invoke them
-            // Create a copy of the callbacks for thread-safety during iteration
-            // (prevents issues if a callback unsubscribes itself during iteration)
-            std::vector<EventCallback> callbacksToInvoke;
-            callbacksToInvoke.reserve(it->second.size());
-            for (const auto& pair : it->second) {
-                callbacksToInvoke.push_back(pair.second);
+    void EventManager::PublishTable(Scope<DispatchTable> table) {
+        // NOTE: Assumes m_writeMutex is already locked by caller
+        m_table.store(table.get(), std::memory_order_seq_cst);
+        m_retiredTables.push_back({ std::move(m_currentTable), m_epoch.load(std::memory_order_relaxed) });
+        m_currentTable = std::move(table);
+        m_hasRetiredTables.store(true, std::memory_order_relaxed);
+
+        ReclaimRetiredTables();
+    }
+
+    size_t EventManager::GetReaderStripe() {
+        static std::atomic<size_t> s_nextStripe{ 0 };
+        thread_local size_t t_stripe = s_nextStripe.fetch_add(1, std::memory_order_relaxed) % ReaderStripeCount;
+        return t_stripe;
+    }
+
+    bool EventManager::IsEpochDrained(U64 epoch) const {
+        for (const ReaderStripe& stripe : m_readerStripes) {
+            if (stripe.active[epoch & 1].load(std::memory_order_seq_cst) != 0) {
+                return false;
             }
+        }
+        return true;
+    }
 
-            for (const auto& callback : callbacksToInvoke) {
-                callback(event);
+    void EventManager::ReclaimRetiredTables() {
+        // NOTE: Assumes m_writeMutex is already locked by caller.
+        // A reader holding a retired table entered before it was replaced, so it is counted under
+        // one of the two parities. New readers only join the current epoch's parity, so the other
+        // one drains; once it has, the epoch advances. After two advances past a table's epoch both
+        // parities have been seen empty since it was replaced and nobody can still hold it.
+        for (int step = 0; step < 2; ++step) {
+            U64 epoch = m_epoch.load(std::memory_order_relaxed);
+            if (!IsEpochDrained(epoch + 1)) {
+                break;
             }
+            m_epoch.store(epoch + 1, std::memory_order_relaxed);
         }
+
+        U64 epoch = m_epoch.load(std::memory_order_relaxed);
+        std::erase_if(m_retiredTables, [epoch](const RetiredTable& retired) { return retired.epoch + 2 <= epoch; });
+        m_hasRetiredTables.store(!m_retiredTables.empty(), std::memory_order_relaxed);
     }
 
+    void EventManager::TryReclaimRetiredTables() {
+        // Called by broadcasts when no writer came along to free the last replaced tables.
+        // Skipped if a writer holds the lock; it reclaims on its own.
+        std::unique_lock<std::mutex> lock(m_writeMutex, std::try_to_lock);
+        if (lock.owns_lock()) {
+            ReclaimRetiredTables();
+        }
+    }
 
-}
\ No newline at end of file
+}
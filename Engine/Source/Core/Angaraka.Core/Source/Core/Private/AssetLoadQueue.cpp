@@ -1,5 +1,6 @@
 #include "Angaraka/Asset/LoadQueue.hpp"
 #include "Angaraka/Log.hpp"
+#include <algorithm>
 
 namespace Angaraka::Core {
 
@@ -10,45 +11,111 @@ namespace Angaraka::Core {
     void AssetLoadQueue::EnqueueAsset(const AssetDefinition& asset,
         const String& bundleName,
         std::function<void(const LoadRequest&)> onComplete) {
-        // Check status first (separate locks)
-        if (IsAssetQueued(asset.id) || IsAssetLoading(asset.id)) {
-            AGK_WARN("Asset {} already in queue or loading", asset.id);
-            return;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            EnqueueLocked(asset, bundleName, onComplete);
         }
+        NotifyWorkAvailable();
+    }
 
-        std::lock_guard<std::mutex> lock(m_queueMutex);
+    void AssetLoadQueue::EnqueueAssets(const std::vector<AssetDefinition>& assets,
+        const String& bundleName,
+        std::function<void(const LoadRequest&)> onComplete) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-        LoadRequest request;
-        request.asset = asset;
-        request.bundleName = bundleName;
-        request.onComplete = onComplete;
+            m_heap.reserve(m_heap.size() + assets.size());
+            m_slotIndex.reserve(m_slotIndex.size() + assets.size());
 
-        m_loadQueue.push(request);
-        AGK_TRACE("Enqueued asset: {} (priority: {})", asset.id, asset.priority);
+            for (const auto& asset : assets) {
+                EnqueueLocked(asset, bundleName, onComplete);
+            }
+        }
+        NotifyWorkAvailable();
     }
 
     void AssetLoadQueue::EnqueueBundle(const AssetBundleConfig& bundle,
         std::function<void(const LoadRequest&)> onComplete) {
-        auto sortedAssets = bundle.GetAssetsByPriority();
+        // The heap orders by priority, so the bundle does not need to be pre-sorted
+        EnqueueAssets(bundle.assets, bundle.name, onComplete);
+
+        AGK_INFO("Enqueued {} assets from bundle: {}", bundle.assets.size(), bundle.name);
+    }
+
+    void AssetLoadQueue::EnqueueLocked(const AssetDefinition& asset, const String& bundleName,
+        const std::function<void(const LoadRequest&)>& onComplete) {
+        // Chains a second requester onto an existing request so both get notified
+        auto attachCallback = [&](LoadRequest& existing) {
+            if (!onComplete) return;
+
+            auto previous = std::move(existing.onComplete);
+            existing.onComplete = [previous, onComplete, bundleName](const LoadRequest& request) {
+                if (previous) previous(request);
+
+                LoadRequest forwarded = request;
+                forwarded.bundleName = bundleName;
+                onComplete(forwarded);
+            };
+        };
+
+        auto loadingIt = m_loadingAssets.find(asset.id);
+        if (loadingIt != m_loadingAssets.end()) {
+            attachCallback(loadingIt->second);
+            AGK_TRACE("Asset {} already loading, attached requester from bundle {}", asset.id, bundleName);
+            return;
+        }
+
+        auto indexIt = m_slotIndex.find(asset.id);
+        if (indexIt != m_slotIndex.end()) {
+            U32 slot = indexIt->second;
+            LoadRequest& existing = m_slots[slot];
+            attachCallback(existing);
+
+            // Re-prioritize when the new requester is more urgent
+            if (asset.priority < existing.asset.priority) {
+                AGK_TRACE("Re-prioritized queued asset: {} ({} -> {})", asset.id, existing.asset.priority, asset.priority);
+                existing.asset.priority = asset.priority;
 
-        for (const auto& asset : sortedAssets) {
-            EnqueueAsset(asset, bundle.name, onComplete);
+                size_t position = m_heapPosition[slot];
+                m_heap[position].key = MakeKey(asset.priority);
+                SiftUp(position);
+            }
+            return;
         }
 
-        AGK_INFO("Enqueued {} assets from bundle: {}", sortedAssets.size(), bundle.name);
+        U32 slot;
+        if (!m_freeSlots.empty()) {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else {
+            slot = static_cast<U32>(m_slots.size());
+            m_slots.emplace_back();
+            m_heapPosition.push_back(INVALID_POSITION);
+        }
+
+        LoadRequest& request = m_slots[slot];
+        request.asset = asset;
+        request.bundleName = bundleName;
+        request.status = LoadStatus::Pending;
+        request.onComplete = onComplete;
+
+        m_slotIndex.emplace(asset.id, slot);
+        m_heap.push_back({ MakeKey(asset.priority), slot });
+        m_heapPosition[slot] = static_cast<U32>(m_heap.size() - 1);
+        SiftUp(m_heap.size() - 1);
+
+        AGK_TRACE("Enqueued asset: {} (priority: {})", asset.id, asset.priority);
     }
 
     std::optional<LoadRequest> AssetLoadQueue::DequeueNextAsset() {
-        std::lock_guard<std::mutex> queueLock(m_queueMutex);
-        std::lock_guard<std::mutex> statusLock(m_statusMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
 
-        if (m_loadQueue.empty()) {
+        if (m_heap.empty()) {
             return std::nullopt;
         }
 
-        LoadRequest request = m_loadQueue.top();
-        m_loadQueue.pop();
-
+        LoadRequest request = RemoveSlotLocked(m_heap.front().slot);
         request.status = LoadStatus::Loading;
         m_loadingAssets[request.asset.id] = request;
 
@@ -59,48 +126,125 @@ namespace Angaraka::Core {
     void AssetLoadQueue::MarkAssetCompleted(const String& assetId,
         Reference<Resource> resource,
         const String& errorMessage) {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
+        std::optional<LoadRequest> completed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
 
-        auto it = m_loadingAssets.find(assetId);
-        if (it == m_loadingAssets.end()) {
-            AGK_WARN("Attempted to mark unknown asset as completed: {}", assetId);
-            return;
+            if (m_loadingAssets.find(assetId) == m_loadingAssets.end()) {
+                AGK_WARN("Attempted to mark unknown asset as completed: {}", assetId);
+                return;
+            }
+
+            LoadStatus status = resource ? LoadStatus::Completed : LoadStatus::Failed;
+            completed = MoveToCompleted(assetId, status, resource, errorMessage);
+        }
+
+        // Call completion callback outside the lock, listeners query the queue
+        if (completed && completed->onComplete) {
+            completed->onComplete(*completed);
+        }
+    }
+
+    bool AssetLoadQueue::UpdateAssetPriority(const String& assetId, AssetPriority priority) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto indexIt = m_slotIndex.find(assetId);
+        if (indexIt == m_slotIndex.end()) {
+            return false;
+        }
+
+        U32 slot = indexIt->second;
+        AssetPriority oldPriority = m_slots[slot].asset.priority;
+        m_slots[slot].asset.priority = priority;
+
+        size_t position = m_heapPosition[slot];
+        m_heap[position].key = MakeKey(priority);
+        if (priority < oldPriority) {
+            SiftUp(position);
+        }
+        else {
+            SiftDown(position);
+        }
+
+        AGK_TRACE("Updated priority for asset: {} ({} -> {})", assetId, oldPriority, priority);
+        return true;
+    }
+
+    bool AssetLoadQueue::CancelAsset(const String& assetId) {
+        LoadRequest cancelled;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto indexIt = m_slotIndex.find(assetId);
+            if (indexIt == m_slotIndex.end()) {
+                return false;
+            }
+
+            cancelled = RemoveSlotLocked(indexIt->second);
+            cancelled.status = LoadStatus::Cancelled;
+            m_completedAssets[assetId] = cancelled;
+        }
+
+        AGK_TRACE("Cancelled asset: {}", assetId);
+        if (cancelled.onComplete) {
+            cancelled.onComplete(cancelled);
+        }
+        return true;
+    }
+
+    size_t AssetLoadQueue::CancelBundle(const String& bundleName) {
+        std::vector<LoadRequest> cancelled;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            std::vector<U32> slots;
+            for (const auto& node : m_heap) {
+                if (m_slots[node.slot].bundleName == bundleName) {
+                    slots.push_back(node.slot);
+                }
+            }
+
+            cancelled.reserve(slots.size());
+            for (U32 slot : slots) {
+                LoadRequest request = RemoveSlotLocked(slot);
+                request.status = LoadStatus::Cancelled;
+                m_completedAssets[request.asset.id] = request;
+                cancelled.push_back(std::move(request));
+            }
         }
 
-        LoadStatus status = resource ? LoadStatus::Completed : LoadStatus::Failed;
-        MoveToCompleted(assetId, status, resource, errorMessage);
+        for (const auto& request : cancelled) {
+            if (request.onComplete) {
+                request.onComplete(request);
+            }
+        }
+
+        AGK_INFO("Cancelled {} pending assets from bundle: {}", cancelled.size(), bundleName);
+        return cancelled.size();
     }
 
     size_t AssetLoadQueue::GetQueueSize() const {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        return m_loadQueue.size();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_heap.size();
     }
 
     size_t AssetLoadQueue::GetLoadingCount() const {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
         return m_loadingAssets.size();
     }
 
     bool AssetLoadQueue::IsAssetQueued(const String& assetId) const {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        auto queueCopy = m_loadQueue;
-
-        while (!queueCopy.empty()) {
-            if (queueCopy.top().asset.id == assetId) {
-                return true;
-            }
-            queueCopy.pop();
-        }
-        return false;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_slotIndex.find(assetId) != m_slotIndex.end();
     }
 
     bool AssetLoadQueue::IsAssetLoading(const String& assetId) const {
-        std::lock_guard<std::mutex> lock(m_statusMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
         return m_loadingAssets.find(assetId) != m_loadingAssets.end();
     }
 
     LoadStatus AssetLoadQueue::GetAssetStatus(const String& assetId) const {
-        std::lock_guard<std::mutex> lock(m_statusMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
 
         if (m_loadingAssets.find(assetId) != m_loadingAssets.end()) {
             return LoadStatus::Loading;
@@ -115,26 +259,30 @@ namespace Angaraka::Core {
     }
 
     std::vector<LoadRequest> AssetLoadQueue::GetPendingRequests() const {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
 
-        std::vector<LoadRequest> requests;
-        auto queueCopy = m_loadQueue;
+        std::vector<HeapNode> ordered = m_heap;
+        std::sort(ordered.begin(), ordered.end(),
+            [](const HeapNode& a, const HeapNode& b) { return a.key < b.key; });
 
-        while (!queueCopy.empty()) {
-            requests.push_back(queueCopy.top());
-            queueCopy.pop();
+        std::vector<LoadRequest> requests;
+        requests.reserve(ordered.size());
+        for (const auto& node : ordered) {
+            requests.push_back(m_slots[node.slot]);
         }
 
         return requests;
     }
 
     void AssetLoadQueue::Clear() {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
+        std::lock_guard<std::mutex> lock(m_mutex);
 
         // Clear queue
-        while (!m_loadQueue.empty()) {
-            m_loadQueue.pop();
-        }
+        m_slots.clear();
+        m_heapPosition.clear();
+        m_freeSlots.clear();
+        m_heap.clear();
+        m_slotIndex.clear();
 
         // Clear loading and completed maps
         m_loadingAssets.clear();
@@ -143,13 +291,100 @@ namespace Angaraka::Core {
         AGK_INFO("AssetLoadQueue cleared");
     }
 
-    void AssetLoadQueue::MoveToCompleted(const String& assetId, LoadStatus status,
+    void AssetLoadQueue::SetWorkAvailableCallback(std::function<void()> callback) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_onWorkAvailable = std::move(callback);
+    }
+
+    void AssetLoadQueue::NotifyWorkAvailable() {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_heap.empty()) return;
+            callback = m_onWorkAvailable;
+        }
+
+        if (callback) {
+            callback();
+        }
+    }
+
+    LoadRequest AssetLoadQueue::RemoveSlotLocked(U32 slot) {
+        size_t position = m_heapPosition[slot];
+        size_t last = m_heap.size() - 1;
+
+        if (position != last) {
+            SwapNodes(position, last);
+        }
+        m_heap.pop_back();
+
+        // The node moved into the hole may need to go either way
+        if (position < m_heap.size()) {
+            SiftDown(position);
+            SiftUp(position);
+        }
+
+        LoadRequest request = std::move(m_slots[slot]);
+        m_slots[slot] = LoadRequest{};
+        m_heapPosition[slot] = INVALID_POSITION;
+        m_freeSlots.push_back(slot);
+        m_slotIndex.erase(request.asset.id);
+
+        return request;
+    }
+
+    void AssetLoadQueue::SiftUp(size_t position) {
+        while (position > 0) {
+            size_t parent = (position - 1) / 2;
+            if (m_heap[parent].key <= m_heap[position].key) {
+                break;
+            }
+            SwapNodes(position, parent);
+            position = parent;
+        }
+    }
+
+    void AssetLoadQueue::SiftDown(size_t position) {
+        size_t count = m_heap.size();
+
+        while (true) {
+            size_t left = position * 2 + 1;
+            size_t right = left + 1;
+            size_t smallest = position;
+
+            if (left < count && m_heap[left].key < m_heap[smallest].key) {
+                smallest = left;
+            }
+            if (right < count && m_heap[right].key < m_heap[smallest].key) {
+                smallest = right;
+            }
+            if (smallest == position) {
+                break;
+            }
+
+            SwapNodes(position, smallest);
+            position = smallest;
+        }
+    }
+
+    void AssetLoadQueue::SwapNodes(size_t a, size_t b) {
+        std::swap(m_heap[a], m_heap[b]);
+        m_heapPosition[m_heap[a].slot] = static_cast<U32>(a);
+        m_heapPosition[m_heap[b].slot] = static_cast<U32>(b);
+    }
+
+    U64 AssetLoadQueue::MakeKey(AssetPriority priority) {
+        // Sequence breaks ties so equal-priority assets load in request order
+        return (static_cast<U64>(priority) << 32) | m_sequence++;
+    }
+
+    std::optional<LoadRequest> AssetLoadQueue::MoveToCompleted(const String& assetId, LoadStatus status,
         Reference<Resource> resource,
         const String& errorMessage) {
         auto it = m_loadingAssets.find(assetId);
-        if (it == m_loadingAssets.end()) return;
+        if (it == m_loadingAssets.end()) return std::nullopt;
 
-        LoadRequest request = it->second;
+        LoadRequest request = std::move(it->second);
         request.status = status;
         request.loadedResource = resource;
         request.errorMessage = errorMessage;
@@ -158,12 +393,8 @@ namespace Angaraka::Core {
         m_completedAssets[assetId] = request;
         m_loadingAssets.erase(it);
 
-        // Call completion callback if provided
-        if (request.onComplete) {
-            request.onComplete(request);
-        }
-
         AGK_TRACE("Asset completed: {} (status: {})", assetId, static_cast<int>(status));
+        return request;
     }
 
-}
\ No newline at end of file
+}
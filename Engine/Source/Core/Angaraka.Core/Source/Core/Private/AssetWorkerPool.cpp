@@ -1,6 +1,8 @@
 #include "Angaraka/Asset/WorkerPool.hpp"
+#include "Angaraka/JobSystem.hpp"
 #include "Angaraka/Log.hpp"
-#include <chrono>
+#include <algorithm>
+#include <thread>
 
 #undef max
 
@@ -16,10 +18,15 @@ namespace Angaraka::Core {
             m_numThreads = std::max(1u, std::thread::hardware_concurrency() - 1);
         }
 
-        AGK_INFO("AssetWorkerPool: Initialized with {} threads", m_numThreads);
+        AGK_INFO("AssetWorkerPool: Initialized with {} concurrent load jobs", m_numThreads);
     }
 
     AssetWorkerPool::~AssetWorkerPool() {
+        // The queue is shared and may outlive us
+        if (m_loadQueue) {
+            m_loadQueue->SetWorkAvailableCallback(nullptr);
+        }
+
         Stop();
     }
 
@@ -29,16 +36,15 @@ namespace Angaraka::Core {
             return;
         }
 
-        m_running.store(true);
         m_shouldStop.store(false);
         m_paused.store(false);
+        m_running.store(true);
 
-        m_workers.reserve(m_numThreads);
-        for (size_t i = 0; i < m_numThreads; ++i) {
-            m_workers.emplace_back(&AssetWorkerPool::WorkerThreadMain, this, i);
-        }
+        // Pick up anything queued before we started
+        Pump();
 
-        AGK_INFO("AssetWorkerPool: Started {} worker threads", m_numThreads);
+        AGK_INFO("AssetWorkerPool: Started with up to {} concurrent load jobs on {} job workers",
+            m_numThreads, JobSystem::Get().GetWorkerCount());
     }
 
     void AssetWorkerPool::Stop() {
@@ -46,20 +52,14 @@ namespace Angaraka::Core {
             return;
         }
 
-        AGK_INFO("AssetWorkerPool: Stopping worker threads...");
+        AGK_INFO("AssetWorkerPool: Waiting for in-flight load jobs...");
 
+        std::unique_lock<std::mutex> lock(m_workMutex);
         m_shouldStop.store(true);
-        m_workCondition.notify_all();
-
-        for (auto& worker : m_workers) {
-            if (worker.joinable()) {
-                worker.join();
-            }
-        }
+        m_workCondition.wait(lock, [this] { return m_activeJobs == 0; });
 
-        m_workers.clear();
         m_running.store(false);
-        AGK_INFO("AssetWorkerPool: All worker threads stopped");
+        AGK_INFO("AssetWorkerPool: All load jobs stopped");
     }
 
     void AssetWorkerPool::RegisterLoader(AssetType type, AssetLoaderFunction loader) {
@@ -69,45 +69,78 @@ namespace Angaraka::Core {
     }
 
     void AssetWorkerPool::SetLoadQueue(Reference<AssetLoadQueue> queue) {
-        std::lock_guard<std::mutex> lock(m_workMutex);
+        if (m_loadQueue) {
+            m_loadQueue->SetWorkAvailableCallback(nullptr);
+        }
+
         m_loadQueue = queue;
-        m_workCondition.notify_all();
+        if (m_loadQueue) {
+            m_loadQueue->SetWorkAvailableCallback([this]() { Pump(); });
+        }
+
+        Pump();
     }
 
     void AssetWorkerPool::PauseWorkers() {
+        // Drain jobs finish the asset they are loading and then return their worker
         m_paused.store(true);
         AGK_INFO("AssetWorkerPool: Workers paused");
     }
 
     void AssetWorkerPool::ResumeWorkers() {
         m_paused.store(false);
-        m_workCondition.notify_all();
+        Pump();
         AGK_INFO("AssetWorkerPool: Workers resumed");
     }
 
-    void AssetWorkerPool::WorkerThreadMain(size_t threadId) {
-        AGK_TRACE("Worker thread {} started", threadId);
+    void AssetWorkerPool::Pump() {
+        if (!m_loadQueue) {
+            return;
+        }
 
-        while (!m_shouldStop.load()) {
-            try {
-                if (m_paused.load()) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                    continue;
-                }
+        size_t queued = m_loadQueue->GetQueueSize();
+        size_t jobsToSubmit = 0;
+        {
+            // Slots are reserved under the same lock Stop and DrainQueue use, so a wake-up is never lost
+            std::lock_guard<std::mutex> lock(m_workMutex);
+            if (!CanProcess() || m_activeJobs >= m_numThreads) {
+                return;
+            }
+
+            jobsToSubmit = std::min(queued, m_numThreads - m_activeJobs);
+            m_activeJobs += jobsToSubmit;
+        }
+
+        for (size_t i = 0; i < jobsToSubmit; ++i) {
+            JobSystem::Get().Submit([this]() { DrainQueue(); }, JobPriority::Low);
+        }
+    }
 
-                if (!ProcessNextAsset()) {
-                    // No work available, wait for notification
-                    std::unique_lock<std::mutex> lock(m_workMutex);
-                    m_workCondition.wait_for(lock, std::chrono::milliseconds(100),
-                        [this] { return m_shouldStop.load() || !m_paused.load(); });
+    void AssetWorkerPool::DrainQueue() {
+        while (true) {
+            while (CanProcess()) {
+                try {
+                    if (!ProcessNextAsset()) {
+                        break;
+                    }
+                }
+                catch (const std::exception& e) {
+                    AGK_ERROR("AssetWorkerPool: Load job exception: {}", e.what());
                 }
             }
-            catch (const std::exception& e) {
-                AGK_ERROR("Worker thread {} exception: {}", threadId, e.what());
+
+            std::lock_guard<std::mutex> lock(m_workMutex);
+
+            // Work enqueued after we found the queue empty may have seen every slot taken, keep going
+            if (CanProcess() && m_loadQueue->GetQueueSize() > 0) {
+                continue;
             }
-        }
 
-        AGK_TRACE("Worker thread {} stopped", threadId);
+            // Must not touch the pool after this, Stop may return as soon as the lock is released
+            --m_activeJobs;
+            m_workCondition.notify_all();
+            return;
+        }
     }
 
     bool AssetWorkerPool::ProcessNextAsset() {
@@ -127,7 +160,10 @@ namespace Angaraka::Core {
             auto resource = LoadAsset(asset);
 
             if (resource) {
-                m_loadQueue->MarkAssetCompleted(asset.id, resource);
+                // GPU uploads may still be in flight, the asset completes once they have finished
+                resource->WhenReady([loadQueue = m_loadQueue, id = asset.id, resource] {
+                    loadQueue->MarkAssetCompleted(id, resource);
+                });
                 AGK_TRACE("Successfully loaded asset: {}", asset.id);
             }
             else {
@@ -144,16 +180,21 @@ namespace Angaraka::Core {
     }
 
     Reference<Resource> AssetWorkerPool::LoadAsset(const AssetDefinition& asset) {
-        std::lock_guard<std::mutex> lock(m_loadersMutex);
-
-        auto it = m_loaders.find(asset.type);
-        if (it == m_loaders.end()) {
-            AGK_ERROR("No loader registered for asset type: {}",
-                AssetDefinition::AssetTypeToString(asset.type));
-            return nullptr;
+        AssetLoaderFunction loader;
+        {
+            std::lock_guard<std::mutex> lock(m_loadersMutex);
+
+            auto it = m_loaders.find(asset.type);
+            if (it == m_loaders.end()) {
+                AGK_ERROR("No loader registered for asset type: {}",
+                    AssetDefinition::AssetTypeToString(asset.type));
+                return nullptr;
+            }
+            loader = it->second;
         }
 
-        return it->second(asset);
+        // Run the loader unlocked so concurrent load jobs do not serialize on each other
+        return loader(asset);
     }
 
 }
\ No newline at end of file
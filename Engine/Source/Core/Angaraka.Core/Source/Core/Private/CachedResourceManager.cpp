@@ -1,6 +1,8 @@
 module;
 
 #include <Angaraka/Base.hpp>
+#include "Angaraka/ResourceCache.hpp"
+#include "Angaraka/Asset/BundleConfig.hpp"
 
 module Angaraka.Core.ResourceCache;
 
@@ -63,17 +65,49 @@ namespace Angaraka::Core {
         size_t resourceCount = m_cache.GetResourceCount();
         F32 utilization = m_cache.GetMemoryUtilization();
 
-        AGK_INFO("Cache Status: {} resources, {}MB used ({:.1f}% utilization), {} total evictions",
+        AGK_INFO("Cache Status: {} resources, {}MB used ({:.1f}% utilization), {} total evictions, {:.1f}% hit ratio ({})",
             resourceCount,
             memoryUsage / (1024 * 1024),
             utilization * 100.0f,
-            stats.totalEvictions);
+            stats.totalEvictions,
+            m_cache.GetHitRatio() * 100.0f,
+            EvictionPolicyToString(m_cache.GetEvictionPolicy()));
 
         if (!m_cache.IsMemoryHealthy()) {
             AGK_WARN("Cache health warning: High memory usage detected");
         }
     }
 
+    Reference<Resource> CachedResourceManager::LoadResource(const Reference<GraphicsResourceFactory>& graphicsFactory,
+        const String& id, const String& path, void* context) {
+        // Try loading it as a graphics resource
+        if (graphicsFactory) {
+            // Determine asset type and use appropriate factory method
+            AssetDefinition tempAsset{};
+            tempAsset.id = id;
+            tempAsset.path = m_basePath + "/" + path;
+            // You'll need logic to determine asset type from ID/extension
+
+            // The factory wrapper serializes per resource kind unless the factory is thread-safe
+            Reference<Resource> newResource = graphicsFactory->Create(tempAsset, context);
+
+            if (newResource) {
+                m_cache.Put(id, newResource, EstimateResourceSize(newResource));
+            }
+            return newResource;
+        }
+
+        // Try loading as a ai resource
+
+        AGK_ERROR("CachedResourceManager: Failed to load resource '{}'", id);
+        return nullptr;
+    }
+
+    void CachedResourceManager::FinishLoad(const String& id) {
+        std::lock_guard<std::mutex> lock(m_managerMutex);
+        m_pendingLoads.erase(id);
+    }
+
     size_t CachedResourceManager::EstimateResourceSize(const Reference<Resource>& resource) const {
         return resource->GetSizeInBytes();
     }
@@ -0,0 +1,429 @@
+#include "Angaraka/JobSystem.hpp"
+#include "Angaraka/Log.hpp"
+#include <algorithm>
+
+namespace Angaraka::Core {
+
+    namespace {
+        constexpr size_t INVALID_WORKER = static_cast<size_t>(-1);
+
+        // Index of the worker running on this thread, INVALID_WORKER for every other thread
+        thread_local size_t t_workerIndex = INVALID_WORKER;
+    }
+
+    JobSystem& JobSystem::Get() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    JobSystem::~JobSystem() {
+        Shutdown();
+    }
+
+    void JobSystem::Initialize(size_t numThreads) {
+        std::lock_guard<std::mutex> lock(m_lifecycleMutex);
+
+        if (m_running.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        if (numThreads == 0) {
+            U32 hardwareThreads = std::thread::hardware_concurrency();
+            numThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        // Queues are only rebuilt when the worker count changes so a late Submit never sees them vanish
+        if (m_queues.size() != numThreads + 1) {
+            m_queues.clear();
+            m_queues.reserve(numThreads + 1);
+            for (size_t i = 0; i < numThreads + 1; ++i) {
+                m_queues.push_back(CreateScope<WorkQueue>());
+            }
+        }
+
+        m_shouldStop.store(false);
+        m_hasShutdown.store(false, std::memory_order_release);
+        m_running.store(true, std::memory_order_release);
+
+        m_workers.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; ++i) {
+            m_workers.emplace_back(&JobSystem::WorkerThreadMain, this, i);
+        }
+
+        AGK_INFO("JobSystem: Started {} worker threads", numThreads);
+    }
+
+    void JobSystem::Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(m_lifecycleMutex);
+
+            if (!m_running.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            AGK_INFO("JobSystem: Stopping worker threads...");
+
+            // From here on submissions run inline, including those made by jobs that are still finishing
+            m_hasShutdown.store(true, std::memory_order_release);
+            m_running.store(false, std::memory_order_release);
+
+            {
+                std::lock_guard<std::mutex> sleepLock(m_sleepMutex);
+                m_shouldStop.store(true);
+            }
+            m_wakeCondition.notify_all();
+
+            for (auto& worker : m_workers) {
+                if (worker.joinable()) {
+                    worker.join();
+                }
+            }
+            m_workers.clear();
+        }
+
+        // Run whatever is left so counters complete and futures are satisfied. This happens outside
+        // the lifecycle lock because the jobs may submit more work or call back into the job system.
+        size_t drained = 0;
+        Job job;
+        while (TryPop(job, JobPriority::Low)) {
+            Execute(job);
+            ++drained;
+        }
+
+        AGK_INFO("JobSystem: All worker threads stopped ({} jobs executed, {} stolen, {} drained at shutdown)",
+            m_executedJobs.load(), m_stolenJobs.load(), drained);
+    }
+
+    bool JobSystem::IsWorkerThread() const {
+        return t_workerIndex != INVALID_WORKER;
+    }
+
+    void JobSystem::Submit(JobFunction function, JobPriority priority, const JobHandle& counter) {
+        if (!function) {
+            return;
+        }
+
+        if (counter) {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+            NotePriority(counter, priority);
+        }
+
+        Dispatch(Job{ std::move(function), counter, priority });
+    }
+
+    void JobSystem::SubmitBatch(std::vector<JobFunction> functions, JobPriority priority, const JobHandle& counter) {
+        if (functions.empty()) {
+            return;
+        }
+
+        if (counter) {
+            counter->m_pending.fetch_add(static_cast<U32>(functions.size()), std::memory_order_relaxed);
+            NotePriority(counter, priority);
+        }
+
+        if (!EnsureRunning()) {
+            for (auto& function : functions) {
+                Job job{ std::move(function), counter, priority };
+                Execute(job);
+            }
+            return;
+        }
+
+        // One lock for the whole batch; idle workers steal from here
+        size_t queueIndex = IsWorkerThread() ? t_workerIndex : m_queues.size() - 1;
+        WorkQueue& queue = *m_queues[queueIndex];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& jobs = queue.jobs[static_cast<size_t>(priority)];
+            for (auto& function : functions) {
+                jobs.push_back(Job{ std::move(function), counter, priority });
+            }
+            m_queuedByPriority[static_cast<size_t>(priority)].fetch_add(functions.size(), std::memory_order_release);
+            m_queuedJobs.fetch_add(functions.size(), std::memory_order_release);
+        }
+
+        WakeWorkers(functions.size());
+    }
+
+    void JobSystem::Then(const JobHandle& dependency, JobFunction function, JobPriority priority, const JobHandle& counter) {
+        if (!dependency) {
+            Submit(std::move(function), priority, counter);
+            return;
+        }
+
+        // Count the continuation against its own group now so that group cannot complete early
+        if (counter) {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+            NotePriority(counter, priority);
+        }
+
+        Job job{ std::move(function), counter, priority };
+        {
+            std::lock_guard<std::mutex> lock(dependency->m_mutex);
+            if (!dependency->IsDone()) {
+                dependency->m_continuations.push_back(std::move(job));
+                return;
+            }
+        }
+
+        // Dependency already finished
+        Dispatch(std::move(job));
+    }
+
+    void JobSystem::Wait(const JobHandle& counter) {
+        if (!counter) {
+            return;
+        }
+
+        while (!counter->IsDone()) {
+            // Help with queued work, highest priority first. Workers take anything (see the header);
+            // other threads stop at the counter's least urgent priority, re-read each time because
+            // running jobs may add lower priority work to the group.
+            JobPriority lowestPriority = IsWorkerThread() ? JobPriority::Low : counter->GetLowestPriority();
+            Job job;
+            if (TryPop(job, lowestPriority)) {
+                Execute(job);
+                continue;
+            }
+
+            // Only sleep while there is nothing left to run at those priorities
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_waitCondition.wait(lock, [this, &counter, lowestPriority] {
+                return counter->IsDone() || HasQueuedJobs(lowestPriority) ||
+                    counter->GetLowestPriority() > lowestPriority;
+                });
+        }
+    }
+
+    void JobSystem::ParallelFor(size_t count, size_t grainSize,
+        const std::function<void(size_t begin, size_t end)>& body,
+        JobPriority priority) {
+        if (count == 0) {
+            return;
+        }
+
+        grainSize = std::max<size_t>(grainSize, 1);
+        size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+        if (chunkCount == 1) {
+            body(0, count);
+            return;
+        }
+
+        JobHandle counter = CreateCounter();
+
+        std::vector<JobFunction> jobs;
+        jobs.reserve(chunkCount - 1);
+        for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+            size_t begin = chunk * grainSize;
+            size_t end = std::min(begin + grainSize, count);
+            jobs.push_back([&body, begin, end]() { body(begin, end); });
+        }
+        SubmitBatch(std::move(jobs), priority, counter);
+
+        // The caller takes the first chunk, then helps with the rest.
+        // Jobs reference body, so always wait before leaving even if the chunk throws.
+        try {
+            body(0, std::min(grainSize, count));
+        }
+        catch (...) {
+            Wait(counter);
+            throw;
+        }
+        Wait(counter);
+    }
+
+    void JobSystem::WorkerThreadMain(size_t workerIndex) {
+        t_workerIndex = workerIndex;
+        AGK_TRACE("JobSystem: Worker thread {} started", workerIndex);
+
+        while (!m_shouldStop.load(std::memory_order_acquire)) {
+            Job job;
+            if (TryPop(job, JobPriority::Low)) {
+                Execute(job);
+                continue;
+            }
+
+            // Nothing to run or steal, sleep until a submission wakes us
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wakeCondition.wait(lock, [this] {
+                return m_shouldStop.load(std::memory_order_acquire) ||
+                    m_queuedJobs.load(std::memory_order_acquire) > 0;
+                });
+        }
+
+        t_workerIndex = INVALID_WORKER;
+        AGK_TRACE("JobSystem: Worker thread {} stopped", workerIndex);
+    }
+
+    bool JobSystem::EnsureRunning() {
+        if (IsRunning()) {
+            return true;
+        }
+
+        // Start lazily on first use, but never restart behind the back of an explicit Shutdown
+        if (m_hasShutdown.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        Initialize();
+        return IsRunning();
+    }
+
+    void JobSystem::Dispatch(Job&& job) {
+        if (EnsureRunning()) {
+            Push(std::move(job));
+            WakeWorkers(1);
+        }
+        else {
+            Execute(job);
+        }
+    }
+
+    void JobSystem::Push(Job&& job) {
+        // Workers push onto their own deque, everyone else goes through the injection queue
+        size_t queueIndex = IsWorkerThread() ? t_workerIndex : m_queues.size() - 1;
+        WorkQueue& queue = *m_queues[queueIndex];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        m_queuedByPriority[static_cast<size_t>(job.priority)].fetch_add(1, std::memory_order_release);
+        queue.jobs[static_cast<size_t>(job.priority)].push_back(std::move(job));
+        m_queuedJobs.fetch_add(1, std::memory_order_release);
+    }
+
+    bool JobSystem::TryPop(Job& job, JobPriority lowestPriority) {
+        if (!HasQueuedJobs(lowestPriority) || m_queues.empty()) {
+            return false;
+        }
+
+        size_t queueCount = m_queues.size();
+        size_t injectionIndex = queueCount - 1;
+        size_t self = IsWorkerThread() ? t_workerIndex : injectionIndex;
+
+        for (size_t p = 0; p <= static_cast<size_t>(lowestPriority); ++p) {
+            JobPriority priority = static_cast<JobPriority>(p);
+
+            // Own deque LIFO for locality, then the injection queue FIFO
+            if (self != injectionIndex && TryPopFrom(self, priority, true, job)) {
+                return true;
+            }
+            if (TryPopFrom(injectionIndex, priority, false, job)) {
+                return true;
+            }
+
+            // Steal the oldest job from the other workers, starting next to us to spread contention
+            for (size_t offset = 1; offset < queueCount; ++offset) {
+                size_t victim = (self + offset) % queueCount;
+                if (victim == injectionIndex || victim == self) {
+                    continue;
+                }
+                if (TryPopFrom(victim, priority, false, job)) {
+                    m_stolenJobs.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool JobSystem::TryPopFrom(size_t queueIndex, JobPriority priority, bool fromBack, Job& job) {
+        WorkQueue& queue = *m_queues[queueIndex];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        auto& jobs = queue.jobs[static_cast<size_t>(priority)];
+        if (jobs.empty()) {
+            return false;
+        }
+
+        if (fromBack) {
+            job = std::move(jobs.back());
+            jobs.pop_back();
+        }
+        else {
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        m_queuedByPriority[static_cast<size_t>(priority)].fetch_sub(1, std::memory_order_acq_rel);
+        m_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    bool JobSystem::HasQueuedJobs(JobPriority lowestPriority) const {
+        if (lowestPriority == JobPriority::Low) {
+            return m_queuedJobs.load(std::memory_order_acquire) > 0;
+        }
+        for (size_t p = 0; p <= static_cast<size_t>(lowestPriority); ++p) {
+            if (m_queuedByPriority[p].load(std::memory_order_acquire) > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void JobSystem::NotePriority(const JobHandle& counter, JobPriority priority) {
+        U8 value = static_cast<U8>(priority);
+        U8 seen = counter->m_lowestPriority.load(std::memory_order_relaxed);
+        while (value > seen && !counter->m_lowestPriority.compare_exchange_weak(seen, value, std::memory_order_acq_rel)) {}
+    }
+
+    void JobSystem::Execute(Job& job) {
+        try {
+            job.function();
+        }
+        catch (const std::exception& e) {
+            AGK_ERROR("JobSystem: Exception in job: {}", e.what());
+        }
+        catch (...) {
+            AGK_ERROR("JobSystem: Unknown exception in job");
+        }
+
+        m_executedJobs.fetch_add(1, std::memory_order_relaxed);
+        Complete(job.counter);
+
+        // Release captures now rather than when the slot is next reused
+        job.function = nullptr;
+        job.counter.reset();
+    }
+
+    void JobSystem::Complete(const JobHandle& counter) {
+        if (!counter || counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        std::vector<Job> continuations;
+        {
+            std::lock_guard<std::mutex> lock(counter->m_mutex);
+            continuations.swap(counter->m_continuations);
+        }
+
+        // Taking the sleep mutex orders the count reaching zero against a waiter checking its predicate
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_waitCondition.notify_all();
+
+        for (auto& continuation : continuations) {
+            Dispatch(std::move(continuation));
+        }
+    }
+
+    void JobSystem::WakeWorkers(size_t count) {
+        // Taking the sleep mutex orders the queued count against a worker checking its wait predicate
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+
+        if (count > 1) {
+            m_wakeCondition.notify_all();
+        }
+        else {
+            m_wakeCondition.notify_one();
+        }
+
+        // Threads blocked in Wait help with new work too
+        m_waitCondition.notify_all();
+    }
+
+}
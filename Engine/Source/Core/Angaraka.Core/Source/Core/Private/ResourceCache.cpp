@@ -1,6 +1,7 @@
 module;
 
 #include "Angaraka/Base.hpp"
+#include <bit>
 
 module Angaraka.Core.ResourceCache;
 
@@ -8,36 +9,153 @@ import Angaraka.Core.Resources;
 
 namespace Angaraka::Core {
 
+    FrequencySketch::FrequencySketch(size_t counterCount)
+        : m_table(std::bit_ceil(std::max<size_t>(16, counterCount)) / 16)
+        , m_counterMask(m_table.size() * 16 - 1)
+        , m_sampleSize(m_table.size() * 16 * 10)
+    {
+    }
+
+    size_t FrequencySketch::CounterIndex(size_t hash, U32 row) const {
+        static constexpr U64 seeds[4] = {
+            0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL,
+            0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+        };
+
+        U64 h = (static_cast<U64>(hash) + seeds[row]) * seeds[row];
+        h ^= h >> 32;
+        return static_cast<size_t>(h) & m_counterMask;
+    }
+
+    void FrequencySketch::Increment(size_t hash) {
+        bool added = false;
+
+        for (U32 row = 0; row < 4; ++row) {
+            size_t index = CounterIndex(hash, row);
+            auto& word = m_table[index >> 4];
+            U32 shift = static_cast<U32>(index & 15) * 4;
+
+            U64 current = word.load(std::memory_order_relaxed);
+            while (((current >> shift) & 0xF) < 15) {
+                if (word.compare_exchange_weak(current, current + (1ULL << shift), std::memory_order_relaxed)) {
+                    added = true;
+                    break;
+                }
+            }
+        }
+
+        if (added && m_additions.fetch_add(1, std::memory_order_relaxed) + 1 >= m_sampleSize) {
+            Reset();
+        }
+    }
+
+    U32 FrequencySketch::Estimate(size_t hash) const {
+        U32 frequency = 15;
+
+        for (U32 row = 0; row < 4; ++row) {
+            size_t index = CounterIndex(hash, row);
+            U64 word = m_table[index >> 4].load(std::memory_order_relaxed);
+            frequency = std::min(frequency, static_cast<U32>((word >> ((index & 15) * 4)) & 0xF));
+        }
+
+        return frequency;
+    }
+
+    void FrequencySketch::Reset() {
+        // Only one thread ages the sketch; increments racing with the halving may be lost,
+        // which is acceptable for a probabilistic counter
+        std::unique_lock<std::mutex> lock(m_resetMutex, std::try_to_lock);
+        if (!lock.owns_lock() || m_additions.load(std::memory_order_relaxed) < m_sampleSize) {
+            return;
+        }
+
+        for (auto& word : m_table) {
+            word.store((word.load(std::memory_order_relaxed) >> 1) & 0x7777777777777777ULL, std::memory_order_relaxed);
+        }
+        m_additions.store(m_sampleSize / 2, std::memory_order_relaxed);
+    }
+
     ResourceCache::ResourceCache(const MemoryBudget& budget)
-        : m_budget(budget)
-        , m_currentMemoryUsage(0)
+        : m_maxTotalMemory(budget.maxTotalMemory)
+        , m_maxSingleResource(budget.maxSingleResource)
+        , m_evictionThreshold(budget.evictionThreshold)
+        , m_enableEviction(budget.enableEviction)
+        , m_logEvictions(budget.logEvictions)
+        , m_evictionPolicy(budget.evictionPolicy)
         , m_stats{}
     {
-        AGK_INFO("ResourceCache: Initialized with {}MB budget, {}% eviction threshold",
-            m_budget.maxTotalMemory / (1024 * 1024), m_budget.evictionThreshold);
+        size_t shardCount = std::bit_ceil(std::max<size_t>(1, budget.shardCount));
+        m_shardMask = shardCount - 1;
+        m_shardShift = shardCount > 1 ? 64 - std::countr_zero(shardCount) : 0;
+
+        m_shards.reserve(shardCount);
+        for (size_t i = 0; i < shardCount; ++i) {
+            m_shards.emplace_back(CreateScope<CacheShard>());
+        }
+
+        AGK_INFO("ResourceCache: Initialized with {}MB budget, {}% eviction threshold, {} shards, {} eviction",
+            budget.maxTotalMemory / (1024 * 1024), budget.evictionThreshold, shardCount,
+            EvictionPolicyToString(m_evictionPolicy));
     }
 
     ResourceCache::~ResourceCache() {
-        AGK_INFO("ResourceCache: Destroyed. Final stats - {} resources, {}MB used, {} total evictions",
-            m_resourceMap.size(), m_currentMemoryUsage / (1024 * 1024), m_stats.totalEvictions);
+        AGK_INFO("ResourceCache: Destroyed. Final stats - {} resources, {}MB used, {} total evictions, {:.1f}% hit ratio",
+            GetResourceCount(), GetCurrentMemoryUsage() / (1024 * 1024), m_stats.totalEvictions, GetHitRatio() * 100.0f);
+        m_isShuttingDown = true;
         Clear();
     }
 
     Reference<Resource> ResourceCache::Get(const String& resourceId) {
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        size_t keyHash = std::hash<String>{}(resourceId);
+        CacheShard& shard = GetShard(keyHash);
 
-        auto mapIt = m_resourceMap.find(resourceId);
-        if (mapIt == m_resourceMap.end()) {
+        // TinyLFU records demand for misses as well, so a resource that keeps being
+        // requested eventually wins admission against the current victim
+        if (m_evictionPolicy == EvictionPolicy::TinyLFU) {
+            m_sketch.Increment(keyHash);
+        }
+
+        if (!UsesClock()) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            auto mapIt = shard.resourceMap.find(resourceId);
+            if (mapIt == shard.resourceMap.end()) {
+                shard.misses.fetch_add(1, std::memory_order_relaxed);
+                return nullptr; // Cache miss
+            }
+
+            // Move to front (most recently used)
+            TouchResource(shard, mapIt->second);
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+
+            AGK_TRACE("ResourceCache: Cache hit for '{}'", resourceId);
+            return mapIt->second->resource;
+        }
+
+        // CLOCK / TinyLFU: readers share the shard and a hit only sets the reference bit
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto mapIt = shard.resourceMap.find(resourceId);
+        if (mapIt == shard.resourceMap.end()) {
+            shard.misses.fetch_add(1, std::memory_order_relaxed);
             return nullptr; // Cache miss
         }
 
-        // Move to front (most recently used)
-        TouchResource(mapIt->second);
+        shard.referenceBits[mapIt->second->clockSlot].store(1, std::memory_order_relaxed);
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
 
         AGK_TRACE("ResourceCache: Cache hit for '{}'", resourceId);
         return mapIt->second->resource;
     }
 
+    Reference<Resource> ResourceCache::Peek(const String& resourceId) {
+        CacheShard& shard = GetShard(std::hash<String>{}(resourceId));
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto mapIt = shard.resourceMap.find(resourceId);
+        return mapIt != shard.resourceMap.end() ? mapIt->second->resource : nullptr;
+    }
+
     void ResourceCache::Put(const String& resourceId, Reference<Resource> resource, size_t memorySize) {
         if (!resource) {
             AGK_WARN("ResourceCache: Attempted to cache null resource '{}'", resourceId);
@@ -46,51 +164,65 @@ namespace Angaraka::Core {
 
         if (!ValidateResourceSize(memorySize)) {
             AGK_ERROR("ResourceCache: Resource '{}' exceeds maximum size limit ({}MB > {}MB)",
-                resourceId, memorySize / (1024 * 1024), m_budget.maxSingleResource / (1024 * 1024));
+                resourceId, memorySize / (1024 * 1024), m_maxSingleResource.load(std::memory_order_relaxed) / (1024 * 1024));
             return;
         }
 
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        size_t keyHash = std::hash<String>{}(resourceId);
+        CacheShard& shard = GetShard(keyHash);
+
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
 
-        // Check if resource already exists
-        auto existingIt = m_resourceMap.find(resourceId);
-        if (existingIt != m_resourceMap.end()) {
-            // Update existing entry
-            size_t oldSize = existingIt->second->memorySizeBytes;
-            existingIt->second->resource = resource;
-            existingIt->second->memorySizeBytes = memorySize;
-            existingIt->second->lastAccessTime = std::chrono::steady_clock::now();
+            // Check if resource already exists
+            auto existingIt = shard.resourceMap.find(resourceId);
+            if (existingIt != shard.resourceMap.end()) {
+                // Update existing entry
+                size_t oldSize = existingIt->second->memorySizeBytes;
+                existingIt->second->resource = resource;
+                existingIt->second->memorySizeBytes = memorySize;
 
-            m_currentMemoryUsage -= oldSize;
-            m_currentMemoryUsage += memorySize;
-            TouchResource(existingIt->second);
+                shard.memoryUsage = shard.memoryUsage - oldSize + memorySize;
+                m_currentMemoryUsage.fetch_sub(oldSize, std::memory_order_relaxed);
+                m_currentMemoryUsage.fetch_add(memorySize, std::memory_order_relaxed);
+                TouchResource(shard, existingIt->second);
 
-            AGK_DEBUG("ResourceCache: Updated existing resource '{}' ({}MB -> {}MB)",
-                resourceId, oldSize / (1024 * 1024), memorySize / (1024 * 1024));
+                AGK_DEBUG("ResourceCache: Updated existing resource '{}' ({}MB -> {}MB)",
+                    resourceId, oldSize / (1024 * 1024), memorySize / (1024 * 1024));
+                return;
+            }
+        }
+
+        // Evict if necessary before adding new resource. This locks other shards one at a
+        // time, so it must run without holding this shard's lock.
+        if (!EvictIfNecessary(memorySize, keyHash)) {
+            AGK_DEBUG("ResourceCache: Admission rejected for '{}' (less frequent than eviction victim)", resourceId);
+            return;
         }
-        else {
-            // Evict if necessary before adding new resource
-            EvictIfNecessary(memorySize);
 
-            // Add new entry at front of LRU list
-            m_lruList.emplace_front(resourceId, resource, memorySize);
-            m_resourceMap[resourceId] = m_lruList.begin();
-            m_currentMemoryUsage += memorySize;
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
 
-            AGK_DEBUG("ResourceCache: Cached new resource '{}' ({}MB). Total usage: {}MB",
-                resourceId, memorySize / (1024 * 1024), m_currentMemoryUsage / (1024 * 1024));
+        // Another thread may have inserted the same id while we were evicting
+        auto existingIt = shard.resourceMap.find(resourceId);
+        if (existingIt != shard.resourceMap.end()) {
+            TouchResource(shard, existingIt->second);
+            return;
         }
+
+        InsertEntry(shard, resourceId, resource, memorySize, keyHash);
+
+        AGK_DEBUG("ResourceCache: Cached new resource '{}' ({}MB). Total usage: {}MB",
+            resourceId, memorySize / (1024 * 1024), GetCurrentMemoryUsage() / (1024 * 1024));
     }
 
     void ResourceCache::Remove(const String& resourceId) {
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        CacheShard& shard = GetShard(std::hash<String>{}(resourceId));
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
 
-        auto mapIt = m_resourceMap.find(resourceId);
-        if (mapIt != m_resourceMap.end()) {
+        auto mapIt = shard.resourceMap.find(resourceId);
+        if (mapIt != shard.resourceMap.end()) {
             size_t memoryFreed = mapIt->second->memorySizeBytes;
-            m_lruList.erase(mapIt->second);
-            m_resourceMap.erase(mapIt);
-            m_currentMemoryUsage -= memoryFreed;
+            EraseEntry(shard, mapIt->second);
 
             AGK_DEBUG("ResourceCache: Manually removed '{}' ({}MB freed)",
                 resourceId, memoryFreed / (1024 * 1024));
@@ -98,113 +230,311 @@ namespace Angaraka::Core {
     }
 
     void ResourceCache::Clear() {
-        // Don't lock if already shutting down
-        if (!m_isShuttingDown) {
-            std::lock_guard<std::mutex> lock(m_cacheMutex);
-        }
+        size_t resourceCount = 0;
+        size_t memoryFreed = 0;
 
-        m_isShuttingDown = true;
-        size_t resourceCount = m_resourceMap.size();
-        size_t memoryFreed = m_currentMemoryUsage;
+        for (auto& shard : m_shards) {
+            std::unique_lock<std::shared_mutex> lock(shard->mutex);
+
+            resourceCount += shard->resourceMap.size();
+            memoryFreed += shard->memoryUsage;
+
+            shard->lruList.clear();
+            shard->resourceMap.clear();
+            shard->clockSlots.clear();
+            shard->freeClockSlots.clear();
+            shard->clockHand = 0;
+            shard->memoryUsage = 0;
+        }
 
-        m_lruList.clear();
-        m_resourceMap.clear();
-        m_currentMemoryUsage = 0;
+        m_currentMemoryUsage.fetch_sub(memoryFreed, std::memory_order_relaxed);
+        m_resourceCount.fetch_sub(resourceCount, std::memory_order_relaxed);
 
         AGK_INFO("ResourceCache: Cleared {} resources, freed {}MB",
             resourceCount, memoryFreed / (1024 * 1024));
     }
 
     void ResourceCache::SetMemoryBudget(const MemoryBudget& budget) {
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        {
+            // Updates are serialized with eviction passes; readers see each limit atomically
+            std::lock_guard<std::mutex> lock(m_evictionMutex);
+
+            AGK_INFO("ResourceCache: Updating budget from {}MB to {}MB",
+                m_maxTotalMemory.load(std::memory_order_relaxed) / (1024 * 1024), budget.maxTotalMemory / (1024 * 1024));
+
+            // Shard layout and eviction policy are fixed for the lifetime of the cache
+            m_maxTotalMemory.store(budget.maxTotalMemory, std::memory_order_relaxed);
+            m_maxSingleResource.store(budget.maxSingleResource, std::memory_order_relaxed);
+            m_evictionThreshold.store(budget.evictionThreshold, std::memory_order_relaxed);
+            m_enableEviction.store(budget.enableEviction, std::memory_order_relaxed);
+            m_logEvictions.store(budget.logEvictions, std::memory_order_relaxed);
+        }
 
-        AGK_INFO("ResourceCache: Updating budget from {}MB to {}MB",
-            m_budget.maxTotalMemory / (1024 * 1024), budget.maxTotalMemory / (1024 * 1024));
+        // Trigger eviction if current usage exceeds new budget
+        if (GetCurrentMemoryUsage() > GetEvictionTriggerSize()) {
+            EvictIfNecessary(0, 0);
+        }
+    }
 
-        m_budget = budget;
+    MemoryBudget ResourceCache::GetMemoryBudget() const {
+        MemoryBudget budget;
+        budget.maxTotalMemory = m_maxTotalMemory.load(std::memory_order_relaxed);
+        budget.maxSingleResource = m_maxSingleResource.load(std::memory_order_relaxed);
+        budget.evictionThreshold = m_evictionThreshold.load(std::memory_order_relaxed);
+        budget.shardCount = m_shards.size();
+        budget.evictionPolicy = m_evictionPolicy;
+        budget.enableEviction = m_enableEviction.load(std::memory_order_relaxed);
+        budget.logEvictions = m_logEvictions.load(std::memory_order_relaxed);
+        return budget;
+    }
 
-        // Trigger eviction if current usage exceeds new budget
-        if (m_currentMemoryUsage > m_budget.GetEvictionTriggerSize()) {
-            EvictIfNecessary(0);
+    CacheShard& ResourceCache::GetShard(size_t keyHash) {
+        // The shard maps bucket on the low bits of the same hash, so pick the shard from the
+        // high bits or every shard would only ever fill 1/N of its buckets
+        if (m_shardShift == 0) {
+            return *m_shards[0];
         }
+        return *m_shards[static_cast<U64>(keyHash) >> m_shardShift];
     }
 
-    void ResourceCache::TouchResource(std::list<CacheEntry>::iterator it) {
+    void ResourceCache::TouchResource(CacheShard& shard, LRUIterator it) {
+        if (UsesClock()) {
+            shard.referenceBits[it->clockSlot].store(1, std::memory_order_relaxed);
+            return;
+        }
+
         // Move to front of list (most recently used)
         it->lastAccessTime = std::chrono::steady_clock::now();
-        m_lruList.splice(m_lruList.begin(), m_lruList, it);
+        shard.lruList.splice(shard.lruList.begin(), shard.lruList, it);
     }
 
-    void ResourceCache::EvictIfNecessary(size_t incomingResourceSize) {
-        if (!m_budget.enableEviction) {
-            return;
+    void ResourceCache::InsertEntry(CacheShard& shard, const String& resourceId,
+        Reference<Resource> resource, size_t memorySize, size_t keyHash) {
+        // Add new entry at front of LRU list
+        shard.lruList.emplace_front(resourceId, std::move(resource), memorySize, keyHash);
+        LRUIterator it = shard.lruList.begin();
+
+        if (UsesClock()) {
+            U32 slot;
+            if (!shard.freeClockSlots.empty()) {
+                slot = shard.freeClockSlots.back();
+                shard.freeClockSlots.pop_back();
+                shard.clockSlots[slot] = it;
+            }
+            else {
+                slot = static_cast<U32>(shard.clockSlots.size());
+                shard.clockSlots.push_back(it);
+
+                if (slot >= shard.referenceCapacity) {
+                    // Grow the flat bit array; readers are excluded by the exclusive shard lock
+                    size_t newCapacity = std::max<size_t>(64, shard.referenceCapacity * 2);
+                    auto bits = std::make_unique<std::atomic<U8>[]>(newCapacity);
+                    for (size_t i = 0; i < shard.referenceCapacity; ++i) {
+                        bits[i].store(shard.referenceBits[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    }
+                    shard.referenceBits = std::move(bits);
+                    shard.referenceCapacity = newCapacity;
+                }
+            }
+
+            // New entries start unreferenced: they must be hit once to earn a second chance
+            shard.referenceBits[slot].store(0, std::memory_order_relaxed);
+            it->clockSlot = slot;
         }
 
-        size_t targetMemoryUsage = m_currentMemoryUsage + incomingResourceSize;
-        size_t evictionTrigger = m_budget.GetEvictionTriggerSize();
+        shard.resourceMap[resourceId] = it;
+        shard.memoryUsage += memorySize;
+        m_currentMemoryUsage.fetch_add(memorySize, std::memory_order_relaxed);
+        m_resourceCount.fetch_add(1, std::memory_order_relaxed);
+    }
 
+    void ResourceCache::EraseEntry(CacheShard& shard, LRUIterator it) {
+        size_t memoryFreed = it->memorySizeBytes;
+
+        if (UsesClock()) {
+            shard.clockSlots[it->clockSlot] = shard.lruList.end();
+            shard.freeClockSlots.push_back(it->clockSlot);
+            shard.referenceBits[it->clockSlot].store(0, std::memory_order_relaxed);
+        }
+
+        shard.resourceMap.erase(it->resourceId);
+        shard.lruList.erase(it);
+        shard.memoryUsage -= memoryFreed;
+        m_currentMemoryUsage.fetch_sub(memoryFreed, std::memory_order_relaxed);
+        m_resourceCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool ResourceCache::EvictIfNecessary(size_t incomingResourceSize, size_t incomingKeyHash) {
+        if (!m_enableEviction.load(std::memory_order_relaxed)) {
+            return true;
+        }
+
+        size_t evictionTrigger = GetEvictionTriggerSize();
+        if (GetCurrentMemoryUsage() + incomingResourceSize <= evictionTrigger) {
+            return true; // No eviction needed
+        }
+
+        // Only one thread evicts at a time; everyone else re-checks usage once it is done
+        std::lock_guard<std::mutex> evictionLock(m_evictionMutex);
+
+        size_t currentUsage = GetCurrentMemoryUsage();
+        size_t targetMemoryUsage = currentUsage + incomingResourceSize;
         if (targetMemoryUsage <= evictionTrigger) {
-            return; // No eviction needed
+            return true;
         }
 
         // Calculate how much memory we need to free
-        size_t memoryToFree = targetMemoryUsage - evictionTrigger;
-        size_t memoryFreed = 0;
-        size_t resourcesEvicted = 0;
+        EvictionPass pass;
+        pass.memoryToFree = targetMemoryUsage - evictionTrigger;
+        pass.checkAdmission = m_evictionPolicy == EvictionPolicy::TinyLFU && incomingResourceSize > 0;
+        if (pass.checkAdmission) {
+            pass.candidateFrequency = m_sketch.Estimate(incomingKeyHash);
+        }
 
-        if (m_budget.logEvictions) {
+        if (m_logEvictions.load(std::memory_order_relaxed)) {
             AGK_INFO("ResourceCache: Starting eviction - need to free {}MB (current: {}MB + incoming: {}MB > trigger: {}MB)",
-                memoryToFree / (1024 * 1024), m_currentMemoryUsage / (1024 * 1024),
+                pass.memoryToFree / (1024 * 1024), currentUsage / (1024 * 1024),
                 incomingResourceSize / (1024 * 1024), evictionTrigger / (1024 * 1024));
         }
 
+        // Walk the shards round-robin, taking one victim from each per visit.
+        // Stop once a full pass over every shard frees nothing (everything left is referenced).
+        size_t idleShards = 0;
+        while (pass.memoryFreed < pass.memoryToFree && idleShards < m_shards.size() && !pass.admissionRejected) {
+            size_t shardIndex = m_evictionCursor.fetch_add(1, std::memory_order_relaxed) & m_shardMask;
+            size_t evictedBefore = pass.resourcesEvicted;
+
+            EvictFromShard(*m_shards[shardIndex], pass);
+
+            idleShards = pass.resourcesEvicted > evictedBefore ? 0 : idleShards + 1;
+        }
+
+        if (m_logEvictions.load(std::memory_order_relaxed) && pass.resourcesEvicted > 0) {
+            AGK_INFO("ResourceCache: Eviction complete - {} resources evicted, {}MB freed",
+                pass.resourcesEvicted, pass.memoryFreed / (1024 * 1024));
+        }
+
+        if (pass.admissionRejected) {
+            std::lock_guard<std::mutex> statsLock(m_statsMutex);
+            m_stats.admissionsRejected++;
+        }
+
+        return !pass.admissionRejected;
+    }
+
+    void ResourceCache::EvictFromShard(CacheShard& shard, EvictionPass& pass) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        auto victim = UsesClock() ? SelectClockVictim(shard) : SelectLRUVictim(shard);
+        if (!victim.has_value()) {
+            return;
+        }
+
+        // TinyLFU admission: keep the victim if it is used at least as often as the newcomer
+        if (pass.checkAdmission && pass.candidateFrequency <= m_sketch.Estimate((*victim)->keyHash)) {
+            pass.admissionRejected = true;
+            return;
+        }
+
+        size_t entrySize = (*victim)->memorySizeBytes;
+        String entryId = (*victim)->resourceId;
+
+        EraseEntry(shard, *victim);
+
+        pass.memoryFreed += entrySize;
+        pass.resourcesEvicted++;
+
+        {
+            std::lock_guard<std::mutex> statsLock(m_statsMutex);
+            m_stats.RecordEviction(entrySize);
+        }
+
+        if (m_logEvictions.load(std::memory_order_relaxed)) {
+            AGK_DEBUG("ResourceCache: Evicted '{}' ({}MB freed)", entryId, entrySize / (1024 * 1024));
+        }
+    }
+
+    std::optional<LRUIterator> ResourceCache::SelectLRUVictim(CacheShard& shard) {
+        size_t entriesToScan = shard.lruList.size();
+
         // Evict from least recently used (back of list)
-        while (memoryFreed < memoryToFree && !m_lruList.empty()) {
-            auto& oldestEntry = m_lruList.back();
+        while (entriesToScan-- > 0) {
+            LRUIterator oldest = std::prev(shard.lruList.end());
 
             // Check if resource is still referenced elsewhere
-            if (oldestEntry.resource.use_count() <= 1) {
-                size_t entrySize = oldestEntry.memorySizeBytes;
-                String entryId = oldestEntry.resourceId;
+            if (oldest->resource.use_count() <= 1) {
+                return oldest;
+            }
+
+            // Resource still in use, move to front and try next
+            TouchResource(shard, oldest);
+        }
 
-                // Remove from both structures
-                m_resourceMap.erase(entryId);
-                m_lruList.pop_back();
+        return std::nullopt;
+    }
 
-                memoryFreed += entrySize;
-                resourcesEvicted++;
-                m_currentMemoryUsage -= entrySize;
-                m_stats.RecordEviction(entrySize);
+    std::optional<LRUIterator> ResourceCache::SelectClockVictim(CacheShard& shard) {
+        size_t slotCount = shard.clockSlots.size();
+        if (slotCount == 0) {
+            return std::nullopt;
+        }
 
-                if (m_budget.logEvictions) {
-                    AGK_DEBUG("ResourceCache: Evicted '{}' ({}MB freed)", entryId, entrySize / (1024 * 1024));
-                }
+        // Two sweeps are enough: the first clears every reference bit it passes
+        for (size_t step = 0; step < slotCount * 2; ++step) {
+            size_t slot = shard.clockHand;
+            shard.clockHand = (shard.clockHand + 1) % slotCount;
+
+            LRUIterator it = shard.clockSlots[slot];
+            if (it == shard.lruList.end()) {
+                continue; // Free slot
             }
-            else {
-                // Resource still in use, move to front and try next
-                TouchResource(std::prev(m_lruList.end()));
+
+            if (shard.referenceBits[slot].exchange(0, std::memory_order_relaxed) != 0) {
+                continue; // Second chance
             }
-        }
 
-        if (m_budget.logEvictions && resourcesEvicted > 0) {
-            AGK_INFO("ResourceCache: Eviction complete - {} resources evicted, {}MB freed",
-                resourcesEvicted, memoryFreed / (1024 * 1024));
+            if (it->resource.use_count() > 1) {
+                continue; // Still referenced elsewhere
+            }
+
+            return it;
         }
+
+        return std::nullopt;
     }
 
     void ResourceCache::EvictOldestResource() {
-        if (m_lruList.empty()) {
+        // Pick the shard whose tail entry was touched longest ago
+        CacheShard* oldestShard = nullptr;
+        std::chrono::steady_clock::time_point oldestTime = std::chrono::steady_clock::time_point::max();
+
+        for (auto& shard : m_shards) {
+            std::shared_lock<std::shared_mutex> lock(shard->mutex);
+            if (!shard->lruList.empty() && shard->lruList.back().lastAccessTime < oldestTime) {
+                oldestTime = shard->lruList.back().lastAccessTime;
+                oldestShard = shard.get();
+            }
+        }
+
+        if (!oldestShard) {
+            return;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(oldestShard->mutex);
+        if (oldestShard->lruList.empty()) {
             return;
         }
 
-        auto& oldestEntry = m_lruList.back();
-        size_t memoryFreed = oldestEntry.memorySizeBytes;
-        String resourceId = oldestEntry.resourceId;
+        LRUIterator oldest = std::prev(oldestShard->lruList.end());
+        size_t memoryFreed = oldest->memorySizeBytes;
+        String resourceId = oldest->resourceId;
 
-        m_resourceMap.erase(resourceId);
-        m_lruList.pop_back();
-        m_currentMemoryUsage -= memoryFreed;
-        m_stats.RecordEviction(memoryFreed);
+        EraseEntry(*oldestShard, oldest);
+
+        {
+            std::lock_guard<std::mutex> statsLock(m_statsMutex);
+            m_stats.RecordEviction(memoryFreed);
+        }
 
         AGK_DEBUG("ResourceCache: Force evicted oldest resource '{}' ({}MB)",
             resourceId, memoryFreed / (1024 * 1024));
@@ -217,7 +547,7 @@ namespace Angaraka::Core {
     }
 
     bool ResourceCache::ValidateResourceSize(size_t resourceSize) const {
-        return resourceSize <= m_budget.maxSingleResource;
+        return resourceSize <= m_maxSingleResource.load(std::memory_order_relaxed);
     }
 
-} // namespace Angaraka::Core
\ No newline at end of file
+} // namespace Angaraka::Core
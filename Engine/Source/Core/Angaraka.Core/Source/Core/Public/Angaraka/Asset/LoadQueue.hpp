@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Angaraka/Asset/BundleConfig.hpp"
-#include <queue>
+#include <optional>
 #include <mutex>
 #include <functional>
 #include <memory>
@@ -15,7 +15,8 @@ namespace Angaraka::Core {
         Pending,
         Loading,
         Completed,
-        Failed
+        Failed,
+        Cancelled
     };
 
     struct LoadRequest {
@@ -35,16 +36,31 @@ namespace Angaraka::Core {
         }
     };
 
+    /**
+     * @brief Priority queue of pending asset loads with an id index
+     *
+     * Pending requests live in stable slots; a binary heap orders slot handles by
+     * (priority, enqueue sequence) and every slot remembers its heap position. Duplicate
+     * checks are a hash lookup, and re-prioritizing or cancelling a queued asset is O(log n).
+     * A single mutex guards pending, loading and completed state, and completion callbacks
+     * are invoked after it has been released.
+     */
     class AssetLoadQueue {
     public:
         AssetLoadQueue();
         ~AssetLoadQueue() = default;
 
-        // Add single asset to load queue
+        // Add single asset to load queue. If the asset is already queued it is re-prioritized
+        // when the new request is more urgent, and the callback is attached to the existing request.
         void EnqueueAsset(const AssetDefinition& asset,
             const String& bundleName,
             std::function<void(const LoadRequest&)> onComplete = nullptr);
 
+        // Add a batch of assets under one lock
+        void EnqueueAssets(const std::vector<AssetDefinition>& assets,
+            const String& bundleName,
+            std::function<void(const LoadRequest&)> onComplete = nullptr);
+
         // Add all assets from bundle to queue
         void EnqueueBundle(const AssetBundleConfig& bundle,
             std::function<void(const LoadRequest&)> onComplete = nullptr);
@@ -57,6 +73,13 @@ namespace Angaraka::Core {
             Reference<Resource> resource = nullptr,
             const String& errorMessage = "");
 
+        // Change the priority of a pending asset. Returns false if it is not queued.
+        bool UpdateAssetPriority(const String& assetId, AssetPriority priority);
+
+        // Remove pending requests. Assets already being loaded are not affected.
+        bool CancelAsset(const String& assetId);
+        size_t CancelBundle(const String& bundleName);
+
         // Query methods
         size_t GetQueueSize() const;
         size_t GetLoadingCount() const;
@@ -70,10 +93,26 @@ namespace Angaraka::Core {
         // Clear all pending requests
         void Clear();
 
+        // Invoked (outside the lock) whenever new work is enqueued, so consumers need not poll
+        void SetWorkAvailableCallback(std::function<void()> callback);
+
     private:
-        mutable std::mutex m_queueMutex;      // Protects m_loadQueue
-        mutable std::mutex m_statusMutex;     // Protects m_loadingAssets, m_completedAssets
-        std::priority_queue<LoadRequest> m_loadQueue;
+        struct HeapNode {
+            U64 key;    // (priority << 32) | sequence, smaller is more urgent
+            U32 slot;
+        };
+
+        static constexpr U32 INVALID_POSITION = ~0u;
+
+        mutable std::mutex m_mutex;     // Protects all queue and status state
+
+        // Pending requests: stable slots, a heap of slot handles and the id -> slot index
+        std::vector<LoadRequest> m_slots;
+        std::vector<U32> m_heapPosition;    // Slot -> index into m_heap
+        std::vector<U32> m_freeSlots;
+        std::vector<HeapNode> m_heap;
+        std::unordered_map<String, U32> m_slotIndex;
+        U32 m_sequence = 0;
 
         // Track currently loading assets
         std::unordered_map<String, LoadRequest> m_loadingAssets;
@@ -81,8 +120,21 @@ namespace Angaraka::Core {
         // Track completed assets (for status queries)
         std::unordered_map<String, LoadRequest> m_completedAssets;
 
-        // Helper to move request to completed state
-        void MoveToCompleted(const String& assetId, LoadStatus status,
+        std::function<void()> m_onWorkAvailable;
+
+        void NotifyWorkAvailable();
+
+        // Queue operations, m_mutex must be held
+        void EnqueueLocked(const AssetDefinition& asset, const String& bundleName,
+            const std::function<void(const LoadRequest&)>& onComplete);
+        LoadRequest RemoveSlotLocked(U32 slot);
+        void SiftUp(size_t position);
+        void SiftDown(size_t position);
+        void SwapNodes(size_t a, size_t b);
+        U64 MakeKey(AssetPriority priority);
+
+        // Helper to move request to completed state, returns the finished request
+        std::optional<LoadRequest> MoveToCompleted(const String& assetId, LoadStatus status,
             Reference<Resource> resource = nullptr,
             const String& errorMessage = "");
     };
@@ -2,7 +2,6 @@
 
 #include "Angaraka/Asset/LoadQueue.hpp"
 #include "Angaraka/Asset/BundleConfig.hpp"
-#include <thread>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
@@ -13,12 +12,18 @@ namespace Angaraka::Core {
 
     using AssetLoaderFunction = std::function<Reference<Resource>(const AssetDefinition&)>;
 
+    /**
+     * @brief Drives asset loading on the shared JobSystem
+     *
+     * The pool owns no threads. When the load queue reports new work it submits up to
+     * numThreads low priority drain jobs, each of which loads assets until the queue is empty.
+     */
     class AssetWorkerPool {
     public:
         explicit AssetWorkerPool(CachedResourceManager* resourceManager, size_t numThreads = 2);
         ~AssetWorkerPool();
 
-        // Start/stop the worker threads
+        // Start/stop submitting load jobs. Stop waits for in-flight loads to finish.
         void Start();
         void Stop();
         bool IsRunning() const { return m_running.load(); }
@@ -34,21 +39,23 @@ namespace Angaraka::Core {
         void ResumeWorkers();
 
     private:
-        void WorkerThreadMain(size_t threadId);
+        void Pump();
+        void DrainQueue();
+        bool CanProcess() const { return m_running.load() && !m_paused.load() && !m_shouldStop.load(); }
         bool ProcessNextAsset();
         Reference<Resource> LoadAsset(const AssetDefinition& asset);
 
         CachedResourceManager* m_resourceManager;
         Reference<AssetLoadQueue> m_loadQueue;
 
-        size_t m_numThreads;
-        std::vector<std::thread> m_workers;
+        size_t m_numThreads;                    // Maximum drain jobs in flight
+        size_t m_activeJobs = 0;                // Drain jobs submitted and not yet finished
         std::atomic<bool> m_running{ false };
         std::atomic<bool> m_paused{ false };
         std::atomic<bool> m_shouldStop{ false };
 
-        mutable std::mutex m_workMutex;
-        std::condition_variable m_workCondition;
+        mutable std::mutex m_workMutex;         // Protects m_activeJobs, pairs with m_workCondition
+        std::condition_variable m_workCondition; // Signalled when a drain job finishes
 
         // Asset type loaders
         std::unordered_map<AssetType, AssetLoaderFunction> m_loaders;
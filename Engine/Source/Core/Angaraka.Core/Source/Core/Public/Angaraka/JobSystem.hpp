@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Angaraka/Base.hpp>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace Angaraka::Core {
+
+    /**
+     * @brief Scheduling class of a job. Workers always drain higher priorities first.
+     *
+     * High:   Frame work the game thread is waiting on (parallel-for over NPCs, culling, ...)
+     * Normal: Latency sensitive background work (AI inference requests)
+     * Low:    Throughput work that may take a while (asset loading)
+     */
+    enum class JobPriority : U8 {
+        High = 0,
+        Normal,
+        Low,
+        Count
+    };
+
+    class JobCounter;
+    using JobHandle = Reference<JobCounter>;
+    using JobFunction = std::function<void()>;
+
+    struct Job {
+        JobFunction function;
+        JobHandle counter;                          // Signalled when the job finishes, may be null
+        JobPriority priority = JobPriority::Normal;
+    };
+
+    /**
+     * @brief Dependency counter shared by a group of jobs
+     *
+     * Every job submitted against the counter increments it and decrements it when it
+     * finishes. Continuations registered with JobSystem::Then are submitted once the
+     * count drops to zero. The counter also remembers the least urgent priority it was
+     * used with, which bounds the work a non-worker thread helps with while waiting on it.
+     */
+    class JobCounter {
+    public:
+        bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+        U32 GetPendingCount() const { return m_pending.load(std::memory_order_acquire); }
+        JobPriority GetLowestPriority() const { return static_cast<JobPriority>(m_lowestPriority.load(std::memory_order_acquire)); }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<U32> m_pending{ 0 };
+        std::atomic<U8> m_lowestPriority{ static_cast<U8>(JobPriority::High) };
+        std::mutex m_mutex;                         // Protects m_continuations
+        std::vector<Job> m_continuations;
+    };
+
+    /**
+     * @brief Work-stealing job scheduler shared by the engine subsystems
+     *
+     * Each worker owns one deque per priority. Workers push and pop at the back of their own
+     * deques and steal from the front of other workers' deques when they run dry. Jobs
+     * submitted from non-worker threads go to a shared injection queue. Idle workers sleep on
+     * a condition variable and are woken by submission, so there is no polling.
+     */
+    class JobSystem {
+    public:
+        static JobSystem& Get();
+
+        // Lifecycle. numThreads == 0 uses hardware_concurrency - 1.
+        // Submitting before Initialize starts the workers with the default count. After Shutdown,
+        // submitted jobs run inline on the submitting thread until Initialize is called again.
+        void Initialize(size_t numThreads = 0);
+        void Shutdown();
+        bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+        size_t GetWorkerCount() const { return m_workers.size(); }
+
+        // Returns true when called from one of the job system's worker threads
+        bool IsWorkerThread() const;
+
+        // Submission. Passing a counter makes the job part of that group.
+        JobHandle CreateCounter() const { return CreateReference<JobCounter>(); }
+        void Submit(JobFunction function, JobPriority priority = JobPriority::Normal, const JobHandle& counter = nullptr);
+        void SubmitBatch(std::vector<JobFunction> functions, JobPriority priority, const JobHandle& counter);
+
+        // Submits the job once every job in the dependency group has finished
+        void Then(const JobHandle& dependency, JobFunction function,
+            JobPriority priority = JobPriority::Normal, const JobHandle& counter = nullptr);
+
+        // Blocks until the counter reaches zero, running queued jobs on the calling thread meanwhile.
+        // Workers run jobs of any priority: the jobs being waited on may be queued behind this one,
+        // so a worker that slept here could deadlock. Other threads only run jobs at least as urgent
+        // as the counter's own, so the game thread waiting on frame work never picks up an asset
+        // load or an inference request; the workers make progress on those.
+        void Wait(const JobHandle& counter);
+
+        // Splits [0, count) into chunks of grainSize and runs them across the workers.
+        // The calling thread takes part and returns once every chunk is done.
+        void ParallelFor(size_t count, size_t grainSize,
+            const std::function<void(size_t begin, size_t end)>& body,
+            JobPriority priority = JobPriority::High);
+
+        // Runs a callable on the workers and returns a future for its result.
+        // Unlike std::async the future does not block on destruction; use a counter to wait for in-flight calls.
+        template<typename Function>
+        auto Async(Function&& function, JobPriority priority = JobPriority::Normal, const JobHandle& counter = nullptr)
+            -> std::future<std::invoke_result_t<std::decay_t<Function>>> {
+            using Result = std::invoke_result_t<std::decay_t<Function>>;
+
+            auto task = CreateReference<std::packaged_task<Result()>>(std::forward<Function>(function));
+            auto future = task->get_future();
+            Submit([task]() { (*task)(); }, priority, counter);
+            return future;
+        }
+
+        // Statistics
+        size_t GetQueuedJobCount() const { return m_queuedJobs.load(std::memory_order_relaxed); }
+        size_t GetExecutedJobCount() const { return m_executedJobs.load(std::memory_order_relaxed); }
+        size_t GetStolenJobCount() const { return m_stolenJobs.load(std::memory_order_relaxed); }
+
+    private:
+        JobSystem() = default;
+        ~JobSystem();
+        DISABLE_COPY_AND_MOVE(JobSystem);
+
+        struct alignas(64) WorkQueue {
+            std::mutex mutex;
+            std::deque<Job> jobs[static_cast<size_t>(JobPriority::Count)];
+        };
+
+        void WorkerThreadMain(size_t workerIndex);
+        bool EnsureRunning();
+        void Dispatch(Job&& job);
+        void Push(Job&& job);
+        bool TryPop(Job& job, JobPriority lowestPriority);
+        bool HasQueuedJobs(JobPriority lowestPriority) const;
+        static void NotePriority(const JobHandle& counter, JobPriority priority);
+        bool TryPopFrom(size_t queueIndex, JobPriority priority, bool fromBack, Job& job);
+        void Execute(Job& job);
+        void Complete(const JobHandle& counter);
+        void WakeWorkers(size_t count);
+
+        // Queues [0, workerCount) belong to workers, the last one is the shared injection queue
+        std::vector<Scope<WorkQueue>> m_queues;
+        std::vector<std::thread> m_workers;
+
+        std::atomic<bool> m_running{ false };
+        std::atomic<bool> m_shouldStop{ false };
+        std::atomic<bool> m_hasShutdown{ false };   // Set by Shutdown, cleared by Initialize
+        std::atomic<size_t> m_queuedJobs{ 0 };
+        std::atomic<size_t> m_queuedByPriority[static_cast<size_t>(JobPriority::Count)]{};
+        std::atomic<size_t> m_executedJobs{ 0 };
+        std::atomic<size_t> m_stolenJobs{ 0 };
+
+        std::mutex m_lifecycleMutex;                // Serializes Initialize / Shutdown
+        std::mutex m_sleepMutex;                    // Pairs with m_wakeCondition and m_waitCondition
+        std::condition_variable m_wakeCondition;    // Idle workers
+        std::condition_variable m_waitCondition;    // Threads in Wait, woken by submissions and finished counters
+    };
+
+} // namespace Angaraka::Core
@@ -2,6 +2,7 @@
 #define ANGARAKA_CORE_LOG_HPP
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <format>
 #include <source_location>
@@ -31,6 +32,19 @@ namespace Angaraka::Logger
     class Framework {
     public:
 
+        // True if the logger would write a message at this level, checked before formatting
+        static bool ShouldLog(LogLevel level) {
+            return s_coreLogger && s_coreLogger->should_log(ToSpdlogLevel(level));
+        }
+        static bool ShouldLogApp(LogLevel level) {
+            return s_appLogger && s_appLogger->should_log(ToSpdlogLevel(level));
+        }
+
+        // Replaces the engine logger, e.g. with a null sink in tests and benchmarks. Not
+        // synchronized with logging calls; swap it while nothing else is logging.
+        static std::shared_ptr<spdlog::logger> GetCoreLogger() { return s_coreLogger; }
+        static void SetCoreLogger(std::shared_ptr<spdlog::logger> logger) { s_coreLogger = std::move(logger); }
+
         // Function to initialize the logging system (e.g., setup file output)
         static void Initialize();
 
@@ -39,7 +53,7 @@ namespace Angaraka::Logger
 
         // Core logging function
         template <typename... Args>
-        static void Log(LogLevel level, const std::string& message, Args ... args) {
+        static void Log(LogLevel level, std::string_view message, Args&& ... args) {
             if (s_coreLogger) {
                 switch (level) {
                 case LogLevel::Trace: s_coreLogger->trace(fmt::runtime(message),    std::forward<Args>(args)...); break;
@@ -52,7 +66,7 @@ namespace Angaraka::Logger
             }
         }
         template <typename... Args>
-        static void Log(LogLevel level, const std::wstring& message, Args ... args) {
+        static void Log(LogLevel level, const std::wstring& message, Args&& ... args) {
             if (s_coreLogger) {
                 switch (level) {
                 case LogLevel::Trace: s_coreLogger->trace(fmt::runtime(message),    std::forward<Args>(args)...); break;
@@ -67,8 +81,8 @@ namespace Angaraka::Logger
 
         // App logging function
         template <typename... Args>
-        static void LogApp(LogLevel level, const std::string& message, Args ... args) {
-            if (s_coreLogger) {
+        static void LogApp(LogLevel level, std::string_view message, Args&& ... args) {
+            if (s_appLogger) {
                 switch (level) {
                 case LogLevel::Trace: s_appLogger->trace(fmt::runtime(message), std::forward<Args>(args)...); break;
                 case LogLevel::Debug: s_appLogger->debug(fmt::runtime(message), std::forward<Args>(args)...); break;
@@ -80,8 +94,8 @@ namespace Angaraka::Logger
             }
         }
         template <typename... Args>
-        static void LogApp(LogLevel level, const std::wstring& message, Args ... args) {
-            if (s_coreLogger) {
+        static void LogApp(LogLevel level, const std::wstring& message, Args&& ... args) {
+            if (s_appLogger) {
                 switch (level) {
                 case LogLevel::Trace: s_appLogger->trace(fmt::runtime(message), std::forward<Args>(args)...); break;
                 case LogLevel::Debug: s_appLogger->debug(fmt::runtime(message), std::forward<Args>(args)...); break;
@@ -94,27 +108,75 @@ namespace Angaraka::Logger
         }
 
     private:
+        static constexpr spdlog::level::level_enum ToSpdlogLevel(LogLevel level) {
+            switch (level) {
+            case LogLevel::Trace: return spdlog::level::trace;
+            case LogLevel::Debug: return spdlog::level::debug;
+            case LogLevel::Info:  return spdlog::level::info;
+            case LogLevel::Warn:  return spdlog::level::warn;
+            case LogLevel::Error: return spdlog::level::err;
+            default:              return spdlog::level::critical;
+            }
+        }
+
         static std::shared_ptr<spdlog::logger> s_coreLogger;
         static std::shared_ptr<spdlog::logger> s_appLogger;
         static std::once_flag s_InitFlag;
     };
 
+// Lowest level compiled into the build, as a LogLevel value. Messages below it are removed
+// together with their arguments; messages at or above it are still filtered by the logger's
+// runtime level before anything is formatted. Override with /DAGK_LOG_LEVEL=<n>.
+#ifndef AGK_LOG_LEVEL
+#ifdef _DEBUG
+#define AGK_LOG_LEVEL 0     // Trace
+#else
+#define AGK_LOG_LEVEL 2     // Info
+#endif
+#endif
+
+#define AGK_LOG_COMPILED(level) (static_cast<int>(level) >= AGK_LOG_LEVEL)
+
+// Arguments are evaluated only when the message will be written, so they may be expensive
+#define AGK_LOG_LAZY(level, ...) \
+    do { \
+        if constexpr (AGK_LOG_COMPILED(level)) { \
+            if (::Angaraka::Logger::Framework::ShouldLog(level)) { \
+                ::Angaraka::Logger::Framework::Log(level, __VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+#define AGK_APP_LOG_LAZY(level, ...) \
+    do { \
+        if constexpr (AGK_LOG_COMPILED(level)) { \
+            if (::Angaraka::Logger::Framework::ShouldLogApp(level)) { \
+                ::Angaraka::Logger::Framework::LogApp(level, __VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+// For work that only feeds log output: if (AGK_TRACE_ENABLED) { ... }
+#define AGK_LOG_ENABLED(level) (AGK_LOG_COMPILED(level) && ::Angaraka::Logger::Framework::ShouldLog(level))
+#define AGK_TRACE_ENABLED AGK_LOG_ENABLED(::Angaraka::Logger::LogLevel::Trace)
+#define AGK_DEBUG_ENABLED AGK_LOG_ENABLED(::Angaraka::Logger::LogLevel::Debug)
+
 // Convenience macros for easier logging
-#define AGK_TRACE(...) ::Angaraka::Logger::Framework::Log(Angaraka::Logger::LogLevel::Trace, __VA_ARGS__)
-#define AGK_DEBUG(...) ::Angaraka::Logger::Framework::Log(Angaraka::Logger::LogLevel::Debug, __VA_ARGS__)
-#define AGK_INFO(...)  ::Angaraka::Logger::Framework::Log(Angaraka::Logger::LogLevel::Info,  __VA_ARGS__)
-#define AGK_WARN(...)  ::Angaraka::Logger::Framework::Log(Angaraka::Logger::LogLevel::Warn,  __VA_ARGS__)
-#define AGK_ERROR(...) ::Angaraka::Logger::Framework::Log(Angaraka::Logger::LogLevel::Error, __VA_ARGS__)
-#define AGK_FATAL(...) ::Angaraka::Logger::Framework::Log(Angaraka::Logger::LogLevel::Fatal, __VA_ARGS__)
+#define AGK_TRACE(...) AGK_LOG_LAZY(::Angaraka::Logger::LogLevel::Trace, __VA_ARGS__)
+#define AGK_DEBUG(...) AGK_LOG_LAZY(::Angaraka::Logger::LogLevel::Debug, __VA_ARGS__)
+#define AGK_INFO(...)  AGK_LOG_LAZY(::Angaraka::Logger::LogLevel::Info,  __VA_ARGS__)
+#define AGK_WARN(...)  AGK_LOG_LAZY(::Angaraka::Logger::LogLevel::Warn,  __VA_ARGS__)
+#define AGK_ERROR(...) AGK_LOG_LAZY(::Angaraka::Logger::LogLevel::Error, __VA_ARGS__)
+#define AGK_FATAL(...) AGK_LOG_LAZY(::Angaraka::Logger::LogLevel::Fatal, __VA_ARGS__)
 
 
 // Convenience macros for easier logging
-#define AGK_APP_TRACE(...) ::Angaraka::Logger::Framework::LogApp(Angaraka::Logger::LogLevel::Trace, __VA_ARGS__)
-#define AGK_APP_DEBUG(...) ::Angaraka::Logger::Framework::LogApp(Angaraka::Logger::LogLevel::Debug, __VA_ARGS__)
-#define AGK_APP_INFO(...)  ::Angaraka::Logger::Framework::LogApp(Angaraka::Logger::LogLevel::Info,  __VA_ARGS__)
-#define AGK_APP_WARN(...)  ::Angaraka::Logger::Framework::LogApp(Angaraka::Logger::LogLevel::Warn,  __VA_ARGS__)
-#define AGK_APP_ERROR(...) ::Angaraka::Logger::Framework::LogApp(Angaraka::Logger::LogLevel::Error, __VA_ARGS__)
-#define AGK_APP_FATAL(...) ::Angaraka::Logger::Framework::LogApp(Angaraka::Logger::LogLevel::Fatal, __VA_ARGS__)
+#define AGK_APP_TRACE(...) AGK_APP_LOG_LAZY(::Angaraka::Logger::LogLevel::Trace, __VA_ARGS__)
+#define AGK_APP_DEBUG(...) AGK_APP_LOG_LAZY(::Angaraka::Logger::LogLevel::Debug, __VA_ARGS__)
+#define AGK_APP_INFO(...)  AGK_APP_LOG_LAZY(::Angaraka::Logger::LogLevel::Info,  __VA_ARGS__)
+#define AGK_APP_WARN(...)  AGK_APP_LOG_LAZY(::Angaraka::Logger::LogLevel::Warn,  __VA_ARGS__)
+#define AGK_APP_ERROR(...) AGK_APP_LOG_LAZY(::Angaraka::Logger::LogLevel::Error, __VA_ARGS__)
+#define AGK_APP_FATAL(...) AGK_APP_LOG_LAZY(::Angaraka::Logger::LogLevel::Fatal, __VA_ARGS__)
 
 } // namespace Angaraka
 
@@ -5,6 +5,9 @@
 #include <unordered_map>
 #include <chrono>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <optional>
 
 namespace Angaraka::Core {
 
@@ -18,13 +21,16 @@ namespace Angaraka::Core {
         String resourceId;
         Reference<Resource> resource;
         size_t memorySizeBytes;
+        size_t keyHash;
+        U32 clockSlot = 0;      // Index into the shard's reference bit array (CLOCK / TinyLFU)
         std::chrono::steady_clock::time_point lastAccessTime;
         std::chrono::steady_clock::time_point loadTime;
 
-        CacheEntry(const String& id, Reference<Resource> res, size_t size)
+        CacheEntry(const String& id, Reference<Resource> res, size_t size, size_t hash = 0)
             : resourceId(id)
             , resource(std::move(res))
             , memorySizeBytes(size)
+            , keyHash(hash)
             , lastAccessTime(std::chrono::steady_clock::now())
             , loadTime(std::chrono::steady_clock::now())
         {
@@ -36,6 +42,35 @@ namespace Angaraka::Core {
      */
     using LRUIterator = std::list<CacheEntry>::iterator;
 
+    /**
+     * @brief Victim selection strategy for the resource cache
+     *
+     * LRU:     Exact recency order per shard. Every hit splices the entry to the front under an exclusive lock.
+     * Clock:   Second-chance sweep over a flat reference bit array. A hit is a shared lock plus one atomic store.
+     * TinyLFU: Clock victim selection plus a frequency sketch admission filter, so a one-off scan
+     *          (e.g. reloading a bundle) cannot push frequently used resources out of the cache.
+     */
+    enum class EvictionPolicy : U8 {
+        LRU,
+        Clock,
+        TinyLFU
+    };
+
+    inline const char* EvictionPolicyToString(EvictionPolicy policy) {
+        switch (policy) {
+        case EvictionPolicy::LRU:     return "LRU";
+        case EvictionPolicy::Clock:   return "Clock";
+        case EvictionPolicy::TinyLFU: return "TinyLFU";
+        }
+        return "Unknown";
+    }
+
+    inline EvictionPolicy EvictionPolicyFromString(const String& name) {
+        if (name == "clock" || name == "Clock") return EvictionPolicy::Clock;
+        if (name == "tinylfu" || name == "TinyLFU") return EvictionPolicy::TinyLFU;
+        return EvictionPolicy::LRU;
+    }
+
     /**
      * @brief Memory budget configuration
      */
@@ -43,6 +78,8 @@ namespace Angaraka::Core {
         size_t maxTotalMemory = 512 * 1024 * 1024;    // 512 MB default
         size_t maxSingleResource = 64 * 1024 * 1024;   // 64 MB per resource
         size_t evictionThreshold = 90;                  // Percentage to trigger eviction
+        size_t shardCount = 16;                         // Lock stripes, rounded up to a power of two (fixed at construction)
+        EvictionPolicy evictionPolicy = EvictionPolicy::LRU;   // Fixed at construction
         bool enableEviction = true;
         bool logEvictions = true;
 
@@ -59,6 +96,7 @@ namespace Angaraka::Core {
         size_t totalEvictions = 0;
         size_t memoryReclaimed = 0;
         size_t lastEvictionCount = 0;
+        size_t admissionsRejected = 0;
         std::chrono::steady_clock::time_point lastEvictionTime;
 
         void RecordEviction(size_t memoryFreed) {
@@ -74,7 +112,57 @@ namespace Angaraka::Core {
     };
 
     /**
-     * @brief LRU cache with configurable memory management
+     * @brief Count-min sketch of 4-bit saturating counters used by the TinyLFU admission filter
+     *
+     * Counters are packed sixteen to a word and updated with relaxed CAS so hits can record
+     * frequency without a lock. All counters are halved once enough increments have been
+     * observed, so popularity decays over time.
+     */
+    class FrequencySketch {
+    public:
+        explicit FrequencySketch(size_t counterCount = 1 << 16);
+
+        void Increment(size_t hash);
+        U32 Estimate(size_t hash) const;
+
+    private:
+        std::vector<std::atomic<U64>> m_table;
+        size_t m_counterMask;
+        size_t m_sampleSize;
+        std::atomic<size_t> m_additions{ 0 };
+        std::mutex m_resetMutex;
+
+        size_t CounterIndex(size_t hash, U32 row) const;
+        void Reset();
+    };
+
+    /**
+     * @brief One lock stripe of the cache. Each shard owns its own LRU list and index
+     * so lookups for different resource ids rarely contend on the same mutex.
+     */
+    struct alignas(64) CacheShard {
+        std::shared_mutex mutex;
+        std::list<CacheEntry> lruList;
+        std::unordered_map<String, LRUIterator> resourceMap;
+        size_t memoryUsage = 0;
+        std::atomic<size_t> hits{ 0 };
+        std::atomic<size_t> misses{ 0 };
+
+        // CLOCK / TinyLFU state. Slots map back to list entries; reference bits live in a
+        // separate flat array so hits only touch one byte and the sweep stays cache friendly.
+        std::vector<LRUIterator> clockSlots;
+        std::vector<U32> freeClockSlots;
+        Scope<std::atomic<U8>[]> referenceBits;
+        size_t referenceCapacity = 0;
+        size_t clockHand = 0;
+    };
+
+    /**
+     * @brief Sharded cache with configurable memory management and eviction policy
+     *
+     * Resources are distributed across MemoryBudget::shardCount shards by a hash of their id.
+     * Memory accounting is global and lock-free; eviction walks the shards round-robin and
+     * drops one victim from each, chosen by MemoryBudget::evictionPolicy.
      */
     class ResourceCache {
     public:
@@ -83,44 +171,97 @@ namespace Angaraka::Core {
 
         // Cache operations
         Reference<Resource> Get(const String& resourceId);
+        Reference<Resource> Peek(const String& resourceId);    // Lookup without counting a hit or touching recency
         void Put(const String& resourceId, Reference<Resource> resource, size_t memorySize);
         void Remove(const String& resourceId);
         void Clear();
 
         // Memory management
         void SetMemoryBudget(const MemoryBudget& budget);
-        const MemoryBudget& GetMemoryBudget() const { return m_budget; }
+        MemoryBudget GetMemoryBudget() const;
+        EvictionPolicy GetEvictionPolicy() const { return m_evictionPolicy; }
 
         // Statistics
-        size_t GetCurrentMemoryUsage() const { return m_currentMemoryUsage; }
-        size_t GetResourceCount() const { return m_resourceMap.size(); }
-        const EvictionStats& GetEvictionStats() const { return m_stats; }
+        size_t GetCurrentMemoryUsage() const { return m_currentMemoryUsage.load(std::memory_order_relaxed); }
+        size_t GetResourceCount() const { return m_resourceCount.load(std::memory_order_relaxed); }
+        size_t GetShardCount() const { return m_shards.size(); }
+        size_t GetHitCount() const {
+            size_t hits = 0;
+            for (const auto& shard : m_shards) hits += shard->hits.load(std::memory_order_relaxed);
+            return hits;
+        }
+        size_t GetMissCount() const {
+            size_t misses = 0;
+            for (const auto& shard : m_shards) misses += shard->misses.load(std::memory_order_relaxed);
+            return misses;
+        }
+        F32 GetHitRatio() const {
+            size_t hits = GetHitCount();
+            size_t total = hits + GetMissCount();
+            return total > 0 ? static_cast<F32>(hits) / static_cast<F32>(total) : 0.0f;
+        }
+        EvictionStats GetEvictionStats() const {
+            std::lock_guard<std::mutex> lock(m_statsMutex);
+            return m_stats;
+        }
         F32 GetMemoryUtilization() const {
-            return static_cast<F32>(m_currentMemoryUsage) / static_cast<F32>(m_budget.maxTotalMemory);
+            return static_cast<F32>(GetCurrentMemoryUsage()) / static_cast<F32>(m_maxTotalMemory.load(std::memory_order_relaxed));
         }
 
         // Cache health check
         bool IsMemoryHealthy() const {
-            return m_currentMemoryUsage < m_budget.GetEvictionTriggerSize();
+            return GetCurrentMemoryUsage() < GetEvictionTriggerSize();
         }
 
     private:
+        // State carried across shards during one eviction pass
+        struct EvictionPass {
+            size_t memoryToFree = 0;
+            size_t memoryFreed = 0;
+            size_t resourcesEvicted = 0;
+            U32 candidateFrequency = 0;     // TinyLFU: estimated frequency of the incoming resource
+            bool checkAdmission = false;
+            bool admissionRejected = false;
+        };
+
         // Core data structures
-        std::list<CacheEntry> m_lruList;
-        std::unordered_map<String, LRUIterator> m_resourceMap;
+        std::vector<Scope<CacheShard>> m_shards;
+        size_t m_shardMask;
+        U32 m_shardShift;                   // Selects the shard from the top bits of the key hash
+        FrequencySketch m_sketch;
+
+        // Budget limits, read without a lock on every Get/Put while SetMemoryBudget may change them
+        std::atomic<size_t> m_maxTotalMemory;
+        std::atomic<size_t> m_maxSingleResource;
+        std::atomic<size_t> m_evictionThreshold;
+        std::atomic<bool> m_enableEviction;
+        std::atomic<bool> m_logEvictions;
+        EvictionPolicy m_evictionPolicy;    // Fixed at construction
 
         // Memory tracking
-        MemoryBudget m_budget;
-        size_t m_currentMemoryUsage;
+        std::atomic<size_t> m_currentMemoryUsage{ 0 };
+        std::atomic<size_t> m_resourceCount{ 0 };
+        std::atomic<size_t> m_evictionCursor{ 0 };
         EvictionStats m_stats;
 
         // Thread safety
-        mutable std::mutex m_cacheMutex;
+        mutable std::mutex m_statsMutex;    // Protects m_stats
+        std::mutex m_evictionMutex;         // Serializes eviction passes across shards
         std::atomic<bool> m_isShuttingDown{ false };
 
         // Internal operations
-        void TouchResource(std::list<CacheEntry>::iterator it);
-        void EvictIfNecessary(size_t incomingResourceSize);
+        CacheShard& GetShard(size_t keyHash);
+        bool UsesClock() const { return m_evictionPolicy != EvictionPolicy::LRU; }
+        size_t GetEvictionTriggerSize() const {
+            return (m_maxTotalMemory.load(std::memory_order_relaxed) * m_evictionThreshold.load(std::memory_order_relaxed)) / 100;
+        }
+        void TouchResource(CacheShard& shard, LRUIterator it);
+        void InsertEntry(CacheShard& shard, const String& resourceId, Reference<Resource> resource, size_t memorySize, size_t keyHash);
+        void EraseEntry(CacheShard& shard, LRUIterator it);
+        bool EvictIfNecessary(size_t incomingResourceSize, size_t incomingKeyHash);
+        void EvictFromShard(CacheShard& shard, EvictionPass& pass);
+        std::optional<LRUIterator> SelectLRUVictim(CacheShard& shard);
+        std::optional<LRUIterator> SelectClockVictim(CacheShard& shard);
         void EvictOldestResource();
         size_t EstimateResourceMemorySize(const Reference<Resource>& resource) const;
 
@@ -128,4 +269,4 @@ namespace Angaraka::Core {
         bool ValidateResourceSize(size_t resourceSize) const;
     };
 
-} // namespace Angaraka::Core
\ No newline at end of file
+} // namespace Angaraka::Core
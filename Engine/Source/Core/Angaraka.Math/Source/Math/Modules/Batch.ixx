@@ -0,0 +1,95 @@
+module;
+
+#include <Angaraka/Base.hpp>
+#include <span>
+
+export module Angaraka.Math.Batch;
+
+import Angaraka.Math.Vector3;
+import Angaraka.Math.Matrix4x4;
+import Angaraka.Math.Quaternion;
+import Angaraka.Math.BoundingBox;
+
+namespace Angaraka::Math::Batch {
+
+    /**
+     * @brief Instruction set used by the batch kernels
+     *
+     * Detected once from CPUID on first use. The SSE4 and AVX2 kernels do the same
+     * arithmetic in the same order as the scalar kernels (no FMA), so results only
+     * differ where noted on the individual functions.
+     */
+    export enum class SimdLevel : U8 {
+        Scalar = 0,
+        SSE4,
+        AVX2
+    };
+
+    // Highest level the CPU and OS support
+    export SimdLevel GetSupportedSimdLevel();
+
+    // Level the kernels currently dispatch to
+    export SimdLevel GetSimdLevel();
+
+    // Forces a lower level (e.g. to compare against the scalar path). Clamped to the supported level.
+    export void SetSimdLevel(SimdLevel level);
+
+    export const char* SimdLevelToString(SimdLevel level);
+
+    // ==================================================================================
+    // Batch kernels
+    //
+    // Every kernel processes min(input sizes) elements and asserts that the output span is
+    // large enough. Outputs may alias inputs of the same type.
+    // ==================================================================================
+
+    /**
+     * @brief out[i] = matrix.TransformPoint(points[i])
+     *
+     * Bit-identical to Matrix4x4::TransformPoint, including the perspective divide.
+     */
+    export void TransformPoints(const Matrix4x4& matrix, std::span<const Vector3> points, std::span<Vector3> out);
+
+    /**
+     * @brief out[i] = matrix.TransformDirection(directions[i])
+     */
+    export void TransformDirections(const Matrix4x4& matrix, std::span<const Vector3> directions, std::span<Vector3> out);
+
+    /**
+     * @brief out[i] = lhs[i] * rhs[i]
+     *
+     * Bit-identical to Matrix4x4::operator*.
+     */
+    export void MultiplyMatrices(std::span<const Matrix4x4> lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> out);
+
+    /**
+     * @brief out[i] = lhs * rhs[i], e.g. parent world matrix times a run of local matrices
+     */
+    export void MultiplyMatrices(const Matrix4x4& lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> out);
+
+    /**
+     * @brief out[i] = Translation(t[i]) * rotations[i].ToMatrix() * Scale(s[i])
+     *
+     * Builds the matrix directly instead of multiplying three matrices. Matches the
+     * three-matrix product up to the sign of zero entries.
+     */
+    export void ComposeTRS(std::span<const Vector3> translations, std::span<const Quaternion> rotations,
+        std::span<const Vector3> scales, std::span<Matrix4x4> out);
+
+    /**
+     * @brief out[i] = rotations[i].Normalized()
+     *
+     * Bit-identical to Quaternion::Normalized, degenerate quaternions become identity.
+     */
+    export void NormalizeQuaternions(std::span<const Quaternion> rotations, std::span<Quaternion> out);
+
+    /**
+     * @brief out[i] = boxes[i].Transform(matrix) for affine matrices
+     *
+     * Uses the per-axis min/max method (Arvo) instead of transforming eight corners, so
+     * the bottom row of the matrix is assumed to be (0, 0, 0, 1). Results can differ from
+     * BoundingBox::Transform by rounding in the last bit.
+     */
+    export void TransformBoxes(const Matrix4x4& matrix, std::span<const BoundingBox> boxes, std::span<BoundingBox> out);
+
+} // namespace Angaraka::Math::Batch
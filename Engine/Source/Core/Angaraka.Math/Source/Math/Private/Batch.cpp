@@ -0,0 +1,735 @@
+module;
+
+#include <Angaraka/Base.hpp>
+#include <algorithm>
+#include <atomic>
+#include <span>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AGK_BATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define AGK_BATCH_X86 0
+#endif
+
+// MSVC emits any intrinsic regardless of /arch, GCC and Clang need the target per function
+#if AGK_BATCH_X86 && (defined(__GNUC__) || defined(__clang__))
+#define AGK_TARGET_SSE4 __attribute__((target("sse4.1")))
+#define AGK_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AGK_TARGET_SSE4
+#define AGK_TARGET_AVX2
+#endif
+
+module Angaraka.Math.Batch;
+
+import Angaraka.Math;
+import Angaraka.Math.Vector3;
+import Angaraka.Math.Matrix4x4;
+import Angaraka.Math.Quaternion;
+import Angaraka.Math.BoundingBox;
+
+namespace Angaraka::Math::Batch {
+
+    // The kernels load these types straight from memory
+    static_assert(sizeof(Vector3) == 3 * sizeof(F32));
+    static_assert(sizeof(Quaternion) == 4 * sizeof(F32));
+    static_assert(sizeof(Matrix4x4) == 16 * sizeof(F32));
+    static_assert(sizeof(BoundingBox) == 2 * sizeof(Vector3));
+
+    namespace {
+
+        struct KernelTable {
+            void (*transformPoints)(const Matrix4x4& matrix, const Vector3* points, Vector3* out, size_t count);
+            void (*transformDirections)(const Matrix4x4& matrix, const Vector3* directions, Vector3* out, size_t count);
+            // lhsStride is 1 for pairwise products and 0 when every rhs shares one lhs
+            void (*multiplyMatrices)(const Matrix4x4* lhs, size_t lhsStride, const Matrix4x4* rhs, Matrix4x4* out, size_t count);
+            void (*composeTRS)(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4x4* out, size_t count);
+            void (*normalizeQuaternions)(const Quaternion* rotations, Quaternion* out, size_t count);
+            void (*transformBoxes)(const Matrix4x4& matrix, const BoundingBox* boxes, BoundingBox* out, size_t count);
+        };
+
+        // ==================================================================================
+        // Scalar kernels - reference implementation and tail handling for the SIMD kernels
+        // ==================================================================================
+
+        void TransformPointsScalar(const Matrix4x4& matrix, const Vector3* points, Vector3* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = matrix.TransformPoint(points[i]);
+            }
+        }
+
+        void TransformDirectionsScalar(const Matrix4x4& matrix, const Vector3* directions, Vector3* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = matrix.TransformDirection(directions[i]);
+            }
+        }
+
+        void MultiplyMatricesScalar(const Matrix4x4* lhs, size_t lhsStride, const Matrix4x4* rhs, Matrix4x4* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = lhs[i * lhsStride] * rhs[i];
+            }
+        }
+
+        void ComposeTRSScalar(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4x4* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const Quaternion& q = rotations[i];
+                const Vector3& s = scales[i];
+                const Vector3& t = translations[i];
+
+                F32 xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+                F32 xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+                F32 wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+                // Same terms as Quaternion::ToMatrix, columns scaled by s
+                F32* m = out[i].m.data();
+                m[0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+                m[1] = (2.0f * (xy + wz)) * s.x;
+                m[2] = (2.0f * (xz - wy)) * s.x;
+                m[3] = 0.0f;
+
+                m[4] = (2.0f * (xy - wz)) * s.y;
+                m[5] = (1.0f - 2.0f * (xx + zz)) * s.y;
+                m[6] = (2.0f * (yz + wx)) * s.y;
+                m[7] = 0.0f;
+
+                m[8] = (2.0f * (xz + wy)) * s.z;
+                m[9] = (2.0f * (yz - wx)) * s.z;
+                m[10] = (1.0f - 2.0f * (xx + yy)) * s.z;
+                m[11] = 0.0f;
+
+                m[12] = t.x;
+                m[13] = t.y;
+                m[14] = t.z;
+                m[15] = 1.0f;
+            }
+        }
+
+        void NormalizeQuaternionsScalar(const Quaternion* rotations, Quaternion* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = rotations[i].Normalized();
+            }
+        }
+
+        void TransformBoxesScalar(const Matrix4x4& matrix, const BoundingBox* boxes, BoundingBox* out, size_t count) {
+            const F32* m = matrix.m.data();
+            for (size_t i = 0; i < count; ++i) {
+                const BoundingBox box = boxes[i];
+                BoundingBox result;
+
+                for (int row = 0; row < 3; ++row) {
+                    F32 lo = m[12 + row];
+                    F32 hi = m[12 + row];
+                    for (int axis = 0; axis < 3; ++axis) {
+                        F32 a = m[axis * 4 + row] * box.min[axis];
+                        F32 b = m[axis * 4 + row] * box.max[axis];
+                        lo += std::min(a, b);
+                        hi += std::max(a, b);
+                    }
+                    result.min[row] = lo;
+                    result.max[row] = hi;
+                }
+
+                out[i] = result;
+            }
+        }
+
+        constexpr KernelTable s_scalarKernels = {
+            TransformPointsScalar,
+            TransformDirectionsScalar,
+            MultiplyMatricesScalar,
+            ComposeTRSScalar,
+            NormalizeQuaternionsScalar,
+            TransformBoxesScalar
+        };
+
+#if AGK_BATCH_X86
+
+        // ==================================================================================
+        // SSE4 kernels - one element per iteration for matrices and points, four quaternions
+        // at a time (transposed to SoA) for the quaternion kernels
+        // ==================================================================================
+
+        AGK_TARGET_SSE4 inline __m128 Splat(F32 value) {
+            return _mm_set1_ps(value);
+        }
+
+        AGK_TARGET_SSE4 inline void StoreVector3(Vector3& v, __m128 value) {
+            // Two stores so we never write past the 12 bytes of the Vector3
+            _mm_storel_pi(reinterpret_cast<__m64*>(&v.x), value);
+            _mm_store_ss(&v.z, _mm_movehl_ps(value, value));
+        }
+
+        AGK_TARGET_SSE4 inline __m128 LinearCombination(__m128 c0, __m128 c1, __m128 c2, __m128 c3, F32 x, F32 y, F32 z, F32 w) {
+            // Same summation order as Matrix4x4::operator*(Vector4), no FMA
+            __m128 r = _mm_add_ps(_mm_mul_ps(c0, Splat(x)), _mm_mul_ps(c1, Splat(y)));
+            r = _mm_add_ps(r, _mm_mul_ps(c2, Splat(z)));
+            return _mm_add_ps(r, _mm_mul_ps(c3, Splat(w)));
+        }
+
+        AGK_TARGET_SSE4 void TransformPointsSSE4(const Matrix4x4& matrix, const Vector3* points, Vector3* out, size_t count) {
+            const __m128 c0 = _mm_loadu_ps(&matrix.m[0]);
+            const __m128 c1 = _mm_loadu_ps(&matrix.m[4]);
+            const __m128 c2 = _mm_loadu_ps(&matrix.m[8]);
+            const __m128 c3 = _mm_loadu_ps(&matrix.m[12]);
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            const __m128 epsilon = Splat(Constants::EpsilonF);
+
+            for (size_t i = 0; i < count; ++i) {
+                const Vector3 p = points[i];
+                __m128 r = LinearCombination(c0, c1, c2, c3, p.x, p.y, p.z, 1.0f);
+
+                // Perspective divide unless w is nearly zero, like TransformPoint
+                __m128 w = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3));
+                __m128 nearZero = _mm_cmple_ps(_mm_and_ps(w, absMask), epsilon);
+                StoreVector3(out[i], _mm_blendv_ps(_mm_div_ps(r, w), r, nearZero));
+            }
+        }
+
+        AGK_TARGET_SSE4 void TransformDirectionsSSE4(const Matrix4x4& matrix, const Vector3* directions, Vector3* out, size_t count) {
+            const __m128 c0 = _mm_loadu_ps(&matrix.m[0]);
+            const __m128 c1 = _mm_loadu_ps(&matrix.m[4]);
+            const __m128 c2 = _mm_loadu_ps(&matrix.m[8]);
+            const __m128 c3 = _mm_loadu_ps(&matrix.m[12]);
+
+            for (size_t i = 0; i < count; ++i) {
+                const Vector3 d = directions[i];
+                StoreVector3(out[i], LinearCombination(c0, c1, c2, c3, d.x, d.y, d.z, 0.0f));
+            }
+        }
+
+        AGK_TARGET_SSE4 void MultiplyMatricesSSE4(const Matrix4x4* lhs, size_t lhsStride, const Matrix4x4* rhs, Matrix4x4* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const F32* a = lhs[i * lhsStride].m.data();
+                const __m128 a0 = _mm_loadu_ps(a + 0);
+                const __m128 a1 = _mm_loadu_ps(a + 4);
+                const __m128 a2 = _mm_loadu_ps(a + 8);
+                const __m128 a3 = _mm_loadu_ps(a + 12);
+
+                // Column j of the result is lhs * (column j of rhs)
+                const F32* b = rhs[i].m.data();
+                __m128 r0 = LinearCombination(a0, a1, a2, a3, b[0], b[1], b[2], b[3]);
+                __m128 r1 = LinearCombination(a0, a1, a2, a3, b[4], b[5], b[6], b[7]);
+                __m128 r2 = LinearCombination(a0, a1, a2, a3, b[8], b[9], b[10], b[11]);
+                __m128 r3 = LinearCombination(a0, a1, a2, a3, b[12], b[13], b[14], b[15]);
+
+                F32* o = out[i].m.data();
+                _mm_storeu_ps(o + 0, r0);
+                _mm_storeu_ps(o + 4, r1);
+                _mm_storeu_ps(o + 8, r2);
+                _mm_storeu_ps(o + 12, r3);
+            }
+        }
+
+        AGK_TARGET_SSE4 void ComposeTRSSSE4(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4x4* out, size_t count) {
+            const __m128 one = Splat(1.0f);
+            const __m128 two = Splat(2.0f);
+            const __m128 zero = _mm_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128 x = _mm_loadu_ps(&rotations[i + 0].x);
+                __m128 y = _mm_loadu_ps(&rotations[i + 1].x);
+                __m128 z = _mm_loadu_ps(&rotations[i + 2].x);
+                __m128 w = _mm_loadu_ps(&rotations[i + 3].x);
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+                __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+                __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+                const Vector3* s = scales + i;
+                __m128 sx = _mm_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x);
+                __m128 sy = _mm_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y);
+                __m128 sz = _mm_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z);
+
+                // Lane k of column row r belongs to matrix i + k
+                __m128 c00 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+                __m128 c01 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+                __m128 c02 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+                __m128 c03 = zero;
+
+                __m128 c10 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+                __m128 c11 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+                __m128 c12 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+                __m128 c13 = zero;
+
+                __m128 c20 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+                __m128 c21 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+                __m128 c22 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+                __m128 c23 = zero;
+
+                // Back to one column per register
+                _MM_TRANSPOSE4_PS(c00, c01, c02, c03);
+                _MM_TRANSPOSE4_PS(c10, c11, c12, c13);
+                _MM_TRANSPOSE4_PS(c20, c21, c22, c23);
+
+                const __m128 column0[4] = { c00, c01, c02, c03 };
+                const __m128 column1[4] = { c10, c11, c12, c13 };
+                const __m128 column2[4] = { c20, c21, c22, c23 };
+                for (size_t k = 0; k < 4; ++k) {
+                    const Vector3& t = translations[i + k];
+                    F32* m = out[i + k].m.data();
+                    _mm_storeu_ps(m + 0, column0[k]);
+                    _mm_storeu_ps(m + 4, column1[k]);
+                    _mm_storeu_ps(m + 8, column2[k]);
+                    _mm_storeu_ps(m + 12, _mm_setr_ps(t.x, t.y, t.z, 1.0f));
+                }
+            }
+
+            ComposeTRSScalar(translations + i, rotations + i, scales + i, out + i, count - i);
+        }
+
+        AGK_TARGET_SSE4 void NormalizeQuaternionsSSE4(const Quaternion* rotations, Quaternion* out, size_t count) {
+            const __m128 one = Splat(1.0f);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            const __m128 epsilon = Splat(Constants::EpsilonF);
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m128 x = _mm_loadu_ps(&rotations[i + 0].x);
+                __m128 y = _mm_loadu_ps(&rotations[i + 1].x);
+                __m128 z = _mm_loadu_ps(&rotations[i + 2].x);
+                __m128 w = _mm_loadu_ps(&rotations[i + 3].x);
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                // sqrt and a true division (not rsqrt) so the result matches Normalized() exactly
+                __m128 lengthSq = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+                lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(z, z));
+                lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(w, w));
+                __m128 length = _mm_sqrt_ps(lengthSq);
+                __m128 inverse = _mm_div_ps(one, length);
+                __m128 degenerate = _mm_cmple_ps(_mm_and_ps(length, absMask), epsilon);
+
+                x = _mm_blendv_ps(_mm_mul_ps(x, inverse), zero, degenerate);
+                y = _mm_blendv_ps(_mm_mul_ps(y, inverse), zero, degenerate);
+                z = _mm_blendv_ps(_mm_mul_ps(z, inverse), zero, degenerate);
+                w = _mm_blendv_ps(_mm_mul_ps(w, inverse), one, degenerate);
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                _mm_storeu_ps(&out[i + 0].x, x);
+                _mm_storeu_ps(&out[i + 1].x, y);
+                _mm_storeu_ps(&out[i + 2].x, z);
+                _mm_storeu_ps(&out[i + 3].x, w);
+            }
+
+            NormalizeQuaternionsScalar(rotations + i, out + i, count - i);
+        }
+
+        AGK_TARGET_SSE4 void TransformBoxesSSE4(const Matrix4x4& matrix, const BoundingBox* boxes, BoundingBox* out, size_t count) {
+            const __m128 c0 = _mm_loadu_ps(&matrix.m[0]);
+            const __m128 c1 = _mm_loadu_ps(&matrix.m[4]);
+            const __m128 c2 = _mm_loadu_ps(&matrix.m[8]);
+            const __m128 c3 = _mm_loadu_ps(&matrix.m[12]);
+
+            for (size_t i = 0; i < count; ++i) {
+                const BoundingBox box = boxes[i];
+                __m128 lo = c3;
+                __m128 hi = c3;
+
+                __m128 a = _mm_mul_ps(c0, Splat(box.min.x));
+                __m128 b = _mm_mul_ps(c0, Splat(box.max.x));
+                lo = _mm_add_ps(lo, _mm_min_ps(a, b));
+                hi = _mm_add_ps(hi, _mm_max_ps(a, b));
+
+                a = _mm_mul_ps(c1, Splat(box.min.y));
+                b = _mm_mul_ps(c1, Splat(box.max.y));
+                lo = _mm_add_ps(lo, _mm_min_ps(a, b));
+                hi = _mm_add_ps(hi, _mm_max_ps(a, b));
+
+                a = _mm_mul_ps(c2, Splat(box.min.z));
+                b = _mm_mul_ps(c2, Splat(box.max.z));
+                lo = _mm_add_ps(lo, _mm_min_ps(a, b));
+                hi = _mm_add_ps(hi, _mm_max_ps(a, b));
+
+                StoreVector3(out[i].min, lo);
+                StoreVector3(out[i].max, hi);
+            }
+        }
+
+        constexpr KernelTable s_sse4Kernels = {
+            TransformPointsSSE4,
+            TransformDirectionsSSE4,
+            MultiplyMatricesSSE4,
+            ComposeTRSSSE4,
+            NormalizeQuaternionsSSE4,
+            TransformBoxesSSE4
+        };
+
+        // ==================================================================================
+        // AVX2 kernels - two points/matrix columns per register, eight quaternions at a time.
+        // Tails fall back to the SSE4 kernels.
+        // ==================================================================================
+
+        AGK_TARGET_AVX2 inline __m256 Splat2(F32 low, F32 high) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(low)), _mm_set1_ps(high), 1);
+        }
+
+        AGK_TARGET_AVX2 inline __m256 Load2(const F32* low, const F32* high) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+        }
+
+        AGK_TARGET_AVX2 inline __m256 BroadcastColumn(const Matrix4x4& matrix, size_t column) {
+            return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&matrix.m[column * 4]));
+        }
+
+        // _MM_TRANSPOSE4_PS within each 128-bit lane
+        AGK_TARGET_AVX2 inline void Transpose4x4Lanes(__m256& r0, __m256& r1, __m256& r2, __m256& r3) {
+            __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+            __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+            __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+            __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+            r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+            r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+            r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+
+        AGK_TARGET_AVX2 inline void Store2(F32* low, F32* high, __m256 value) {
+            _mm_storeu_ps(low, _mm256_castps256_ps128(value));
+            _mm_storeu_ps(high, _mm256_extractf128_ps(value, 1));
+        }
+
+        AGK_TARGET_AVX2 inline void StoreVector3x2(Vector3& low, Vector3& high, __m256 value) {
+            StoreVector3(low, _mm256_castps256_ps128(value));
+            StoreVector3(high, _mm256_extractf128_ps(value, 1));
+        }
+
+        AGK_TARGET_AVX2 void TransformPointsAVX2(const Matrix4x4& matrix, const Vector3* points, Vector3* out, size_t count) {
+            const __m256 c0 = BroadcastColumn(matrix, 0);
+            const __m256 c1 = BroadcastColumn(matrix, 1);
+            const __m256 c2 = BroadcastColumn(matrix, 2);
+            const __m256 c3 = BroadcastColumn(matrix, 3);
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            const __m256 epsilon = _mm256_set1_ps(Constants::EpsilonF);
+
+            size_t i = 0;
+            for (; i + 2 <= count; i += 2) {
+                const Vector3 p = points[i];
+                const Vector3 q = points[i + 1];
+
+                __m256 r = _mm256_add_ps(_mm256_mul_ps(c0, Splat2(p.x, q.x)), _mm256_mul_ps(c1, Splat2(p.y, q.y)));
+                r = _mm256_add_ps(r, _mm256_mul_ps(c2, Splat2(p.z, q.z)));
+                r = _mm256_add_ps(r, c3);
+
+                __m256 w = _mm256_permute_ps(r, _MM_SHUFFLE(3, 3, 3, 3));
+                __m256 nearZero = _mm256_cmp_ps(_mm256_and_ps(w, absMask), epsilon, _CMP_LE_OQ);
+                StoreVector3x2(out[i], out[i + 1], _mm256_blendv_ps(_mm256_div_ps(r, w), r, nearZero));
+            }
+
+            TransformPointsSSE4(matrix, points + i, out + i, count - i);
+        }
+
+        AGK_TARGET_AVX2 void TransformDirectionsAVX2(const Matrix4x4& matrix, const Vector3* directions, Vector3* out, size_t count) {
+            const __m256 c0 = BroadcastColumn(matrix, 0);
+            const __m256 c1 = BroadcastColumn(matrix, 1);
+            const __m256 c2 = BroadcastColumn(matrix, 2);
+            const __m256 c3w = _mm256_mul_ps(BroadcastColumn(matrix, 3), _mm256_setzero_ps());
+
+            size_t i = 0;
+            for (; i + 2 <= count; i += 2) {
+                const Vector3 p = directions[i];
+                const Vector3 q = directions[i + 1];
+
+                __m256 r = _mm256_add_ps(_mm256_mul_ps(c0, Splat2(p.x, q.x)), _mm256_mul_ps(c1, Splat2(p.y, q.y)));
+                r = _mm256_add_ps(r, _mm256_mul_ps(c2, Splat2(p.z, q.z)));
+                r = _mm256_add_ps(r, c3w);
+                StoreVector3x2(out[i], out[i + 1], r);
+            }
+
+            TransformDirectionsSSE4(matrix, directions + i, out + i, count - i);
+        }
+
+        AGK_TARGET_AVX2 void MultiplyMatricesAVX2(const Matrix4x4* lhs, size_t lhsStride, const Matrix4x4* rhs, Matrix4x4* out, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const Matrix4x4& a = lhs[i * lhsStride];
+                const __m256 a0 = BroadcastColumn(a, 0);
+                const __m256 a1 = BroadcastColumn(a, 1);
+                const __m256 a2 = BroadcastColumn(a, 2);
+                const __m256 a3 = BroadcastColumn(a, 3);
+
+                // Columns 0/1 and 2/3 of rhs, each lane splats its own column's elements
+                const F32* b = rhs[i].m.data();
+                const __m256 b01 = _mm256_loadu_ps(b + 0);
+                const __m256 b23 = _mm256_loadu_ps(b + 8);
+
+                __m256 r01 = _mm256_add_ps(
+                    _mm256_mul_ps(a0, _mm256_permute_ps(b01, _MM_SHUFFLE(0, 0, 0, 0))),
+                    _mm256_mul_ps(a1, _mm256_permute_ps(b01, _MM_SHUFFLE(1, 1, 1, 1))));
+                r01 = _mm256_add_ps(r01, _mm256_mul_ps(a2, _mm256_permute_ps(b01, _MM_SHUFFLE(2, 2, 2, 2))));
+                r01 = _mm256_add_ps(r01, _mm256_mul_ps(a3, _mm256_permute_ps(b01, _MM_SHUFFLE(3, 3, 3, 3))));
+
+                __m256 r23 = _mm256_add_ps(
+                    _mm256_mul_ps(a0, _mm256_permute_ps(b23, _MM_SHUFFLE(0, 0, 0, 0))),
+                    _mm256_mul_ps(a1, _mm256_permute_ps(b23, _MM_SHUFFLE(1, 1, 1, 1))));
+                r23 = _mm256_add_ps(r23, _mm256_mul_ps(a2, _mm256_permute_ps(b23, _MM_SHUFFLE(2, 2, 2, 2))));
+                r23 = _mm256_add_ps(r23, _mm256_mul_ps(a3, _mm256_permute_ps(b23, _MM_SHUFFLE(3, 3, 3, 3))));
+
+                F32* o = out[i].m.data();
+                _mm256_storeu_ps(o + 0, r01);
+                _mm256_storeu_ps(o + 8, r23);
+            }
+        }
+
+        AGK_TARGET_AVX2 void ComposeTRSAVX2(const Vector3* translations, const Quaternion* rotations, const Vector3* scales, Matrix4x4* out, size_t count) {
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 two = _mm256_set1_ps(2.0f);
+            const __m256 zero = _mm256_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                // Lane 0 holds elements i..i+3, lane 1 holds i+4..i+7
+                __m256 x = Load2(&rotations[i + 0].x, &rotations[i + 4].x);
+                __m256 y = Load2(&rotations[i + 1].x, &rotations[i + 5].x);
+                __m256 z = Load2(&rotations[i + 2].x, &rotations[i + 6].x);
+                __m256 w = Load2(&rotations[i + 3].x, &rotations[i + 7].x);
+                Transpose4x4Lanes(x, y, z, w);
+
+                __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+                __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+                __m256 wx = _mm256_mul_ps(w, x), wy = _mm256_mul_ps(w, y), wz = _mm256_mul_ps(w, z);
+
+                const Vector3* s = scales + i;
+                __m256 sx = _mm256_setr_ps(s[0].x, s[1].x, s[2].x, s[3].x, s[4].x, s[5].x, s[6].x, s[7].x);
+                __m256 sy = _mm256_setr_ps(s[0].y, s[1].y, s[2].y, s[3].y, s[4].y, s[5].y, s[6].y, s[7].y);
+                __m256 sz = _mm256_setr_ps(s[0].z, s[1].z, s[2].z, s[3].z, s[4].z, s[5].z, s[6].z, s[7].z);
+
+                __m256 c00 = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx);
+                __m256 c01 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, wz)), sx);
+                __m256 c02 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, wy)), sx);
+                __m256 c03 = zero;
+
+                __m256 c10 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), sy);
+                __m256 c11 = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy);
+                __m256 c12 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, wx)), sy);
+                __m256 c13 = zero;
+
+                __m256 c20 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, wy)), sz);
+                __m256 c21 = _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), sz);
+                __m256 c22 = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz);
+                __m256 c23 = zero;
+
+                Transpose4x4Lanes(c00, c01, c02, c03);
+                Transpose4x4Lanes(c10, c11, c12, c13);
+                Transpose4x4Lanes(c20, c21, c22, c23);
+
+                const __m256 column0[4] = { c00, c01, c02, c03 };
+                const __m256 column1[4] = { c10, c11, c12, c13 };
+                const __m256 column2[4] = { c20, c21, c22, c23 };
+                for (size_t k = 0; k < 4; ++k) {
+                    F32* low = out[i + k].m.data();
+                    F32* high = out[i + k + 4].m.data();
+                    Store2(low + 0, high + 0, column0[k]);
+                    Store2(low + 4, high + 4, column1[k]);
+                    Store2(low + 8, high + 8, column2[k]);
+
+                    const Vector3& tLow = translations[i + k];
+                    const Vector3& tHigh = translations[i + k + 4];
+                    _mm_storeu_ps(low + 12, _mm_setr_ps(tLow.x, tLow.y, tLow.z, 1.0f));
+                    _mm_storeu_ps(high + 12, _mm_setr_ps(tHigh.x, tHigh.y, tHigh.z, 1.0f));
+                }
+            }
+
+            ComposeTRSSSE4(translations + i, rotations + i, scales + i, out + i, count - i);
+        }
+
+        AGK_TARGET_AVX2 void NormalizeQuaternionsAVX2(const Quaternion* rotations, Quaternion* out, size_t count) {
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            const __m256 epsilon = _mm256_set1_ps(Constants::EpsilonF);
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                __m256 x = Load2(&rotations[i + 0].x, &rotations[i + 4].x);
+                __m256 y = Load2(&rotations[i + 1].x, &rotations[i + 5].x);
+                __m256 z = Load2(&rotations[i + 2].x, &rotations[i + 6].x);
+                __m256 w = Load2(&rotations[i + 3].x, &rotations[i + 7].x);
+                Transpose4x4Lanes(x, y, z, w);
+
+                __m256 lengthSq = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+                lengthSq = _mm256_add_ps(lengthSq, _mm256_mul_ps(z, z));
+                lengthSq = _mm256_add_ps(lengthSq, _mm256_mul_ps(w, w));
+                __m256 length = _mm256_sqrt_ps(lengthSq);
+                __m256 inverse = _mm256_div_ps(one, length);
+                __m256 degenerate = _mm256_cmp_ps(_mm256_and_ps(length, absMask), epsilon, _CMP_LE_OQ);
+
+                x = _mm256_blendv_ps(_mm256_mul_ps(x, inverse), zero, degenerate);
+                y = _mm256_blendv_ps(_mm256_mul_ps(y, inverse), zero, degenerate);
+                z = _mm256_blendv_ps(_mm256_mul_ps(z, inverse), zero, degenerate);
+                w = _mm256_blendv_ps(_mm256_mul_ps(w, inverse), one, degenerate);
+                Transpose4x4Lanes(x, y, z, w);
+
+                Store2(&out[i + 0].x, &out[i + 4].x, x);
+                Store2(&out[i + 1].x, &out[i + 5].x, y);
+                Store2(&out[i + 2].x, &out[i + 6].x, z);
+                Store2(&out[i + 3].x, &out[i + 7].x, w);
+            }
+
+            NormalizeQuaternionsSSE4(rotations + i, out + i, count - i);
+        }
+
+        AGK_TARGET_AVX2 void TransformBoxesAVX2(const Matrix4x4& matrix, const BoundingBox* boxes, BoundingBox* out, size_t count) {
+            const __m256 c0 = BroadcastColumn(matrix, 0);
+            const __m256 c1 = BroadcastColumn(matrix, 1);
+            const __m256 c2 = BroadcastColumn(matrix, 2);
+            const __m256 c3 = BroadcastColumn(matrix, 3);
+
+            size_t i = 0;
+            for (; i + 2 <= count; i += 2) {
+                const BoundingBox p = boxes[i];
+                const BoundingBox q = boxes[i + 1];
+                __m256 lo = c3;
+                __m256 hi = c3;
+
+                __m256 a = _mm256_mul_ps(c0, Splat2(p.min.x, q.min.x));
+                __m256 b = _mm256_mul_ps(c0, Splat2(p.max.x, q.max.x));
+                lo = _mm256_add_ps(lo, _mm256_min_ps(a, b));
+                hi = _mm256_add_ps(hi, _mm256_max_ps(a, b));
+
+                a = _mm256_mul_ps(c1, Splat2(p.min.y, q.min.y));
+                b = _mm256_mul_ps(c1, Splat2(p.max.y, q.max.y));
+                lo = _mm256_add_ps(lo, _mm256_min_ps(a, b));
+                hi = _mm256_add_ps(hi, _mm256_max_ps(a, b));
+
+                a = _mm256_mul_ps(c2, Splat2(p.min.z, q.min.z));
+                b = _mm256_mul_ps(c2, Splat2(p.max.z, q.max.z));
+                lo = _mm256_add_ps(lo, _mm256_min_ps(a, b));
+                hi = _mm256_add_ps(hi, _mm256_max_ps(a, b));
+
+                StoreVector3x2(out[i].min, out[i + 1].min, lo);
+                StoreVector3x2(out[i].max, out[i + 1].max, hi);
+            }
+
+            TransformBoxesSSE4(matrix, boxes + i, out + i, count - i);
+        }
+
+        constexpr KernelTable s_avx2Kernels = {
+            TransformPointsAVX2,
+            TransformDirectionsAVX2,
+            MultiplyMatricesAVX2,
+            ComposeTRSAVX2,
+            NormalizeQuaternionsAVX2,
+            TransformBoxesAVX2
+        };
+
+#endif // AGK_BATCH_X86
+
+        SimdLevel DetectSimdLevel() {
+#if !AGK_BATCH_X86
+            return SimdLevel::Scalar;
+#elif defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            const int maxLeaf = info[0];
+
+            __cpuid(info, 1);
+            const bool sse41 = (info[2] & (1 << 19)) != 0;
+            const bool osxsave = (info[2] & (1 << 27)) != 0;
+            const bool avx = (info[2] & (1 << 28)) != 0;
+
+            // AVX also needs the OS to save the YMM registers on context switches
+            bool avx2 = false;
+            if (osxsave && avx && maxLeaf >= 7 && (_xgetbv(0) & 0x6) == 0x6) {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+
+            return avx2 ? SimdLevel::AVX2 : (sse41 ? SimdLevel::SSE4 : SimdLevel::Scalar);
+#else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return SimdLevel::AVX2;
+            }
+            return __builtin_cpu_supports("sse4.1") ? SimdLevel::SSE4 : SimdLevel::Scalar;
+#endif
+        }
+
+        std::atomic<SimdLevel>& ActiveLevel() {
+            static std::atomic<SimdLevel> level{ GetSupportedSimdLevel() };
+            return level;
+        }
+
+        const KernelTable& Kernels() {
+#if AGK_BATCH_X86
+            switch (ActiveLevel().load(std::memory_order_relaxed)) {
+            case SimdLevel::AVX2: return s_avx2Kernels;
+            case SimdLevel::SSE4: return s_sse4Kernels;
+            default: break;
+            }
+#endif
+            return s_scalarKernels;
+        }
+
+    } // namespace
+
+    SimdLevel GetSupportedSimdLevel() {
+        static const SimdLevel supported = DetectSimdLevel();
+        return supported;
+    }
+
+    SimdLevel GetSimdLevel() {
+        return ActiveLevel().load(std::memory_order_relaxed);
+    }
+
+    void SetSimdLevel(SimdLevel level) {
+        ActiveLevel().store(std::min(level, GetSupportedSimdLevel()), std::memory_order_relaxed);
+    }
+
+    const char* SimdLevelToString(SimdLevel level) {
+        switch (level) {
+        case SimdLevel::Scalar: return "Scalar";
+        case SimdLevel::SSE4: return "SSE4";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "Unknown";
+        }
+    }
+
+    void TransformPoints(const Matrix4x4& matrix, std::span<const Vector3> points, std::span<Vector3> out) {
+        AGK_ASSERT(out.size() >= points.size(), "TransformPoints: output span is too small");
+        // Copy in case the matrix lives inside the output
+        const Matrix4x4 m = matrix;
+        Kernels().transformPoints(m, points.data(), out.data(), points.size());
+    }
+
+    void TransformDirections(const Matrix4x4& matrix, std::span<const Vector3> directions, std::span<Vector3> out) {
+        AGK_ASSERT(out.size() >= directions.size(), "TransformDirections: output span is too small");
+        const Matrix4x4 m = matrix;
+        Kernels().transformDirections(m, directions.data(), out.data(), directions.size());
+    }
+
+    void MultiplyMatrices(std::span<const Matrix4x4> lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> out) {
+        const size_t count = std::min(lhs.size(), rhs.size());
+        AGK_ASSERT(out.size() >= count, "MultiplyMatrices: output span is too small");
+        Kernels().multiplyMatrices(lhs.data(), 1, rhs.data(), out.data(), count);
+    }
+
+    void MultiplyMatrices(const Matrix4x4& lhs, std::span<const Matrix4x4> rhs, std::span<Matrix4x4> out) {
+        AGK_ASSERT(out.size() >= rhs.size(), "MultiplyMatrices: output span is too small");
+        const Matrix4x4 shared = lhs;
+        Kernels().multiplyMatrices(&shared, 0, rhs.data(), out.data(), rhs.size());
+    }
+
+    void ComposeTRS(std::span<const Vector3> translations, std::span<const Quaternion> rotations,
+        std::span<const Vector3> scales, std::span<Matrix4x4> out) {
+        const size_t count = std::min({ translations.size(), rotations.size(), scales.size() });
+        AGK_ASSERT(out.size() >= count, "ComposeTRS: output span is too small");
+        Kernels().composeTRS(translations.data(), rotations.data(), scales.data(), out.data(), count);
+    }
+
+    void NormalizeQuaternions(std::span<const Quaternion> rotations, std::span<Quaternion> out) {
+        AGK_ASSERT(out.size() >= rotations.size(), "NormalizeQuaternions: output span is too small");
+        Kernels().normalizeQuaternions(rotations.data(), out.data(), rotations.size());
+    }
+
+    void TransformBoxes(const Matrix4x4& matrix, std::span<const BoundingBox> boxes, std::span<BoundingBox> out) {
+        AGK_ASSERT(out.size() >= boxes.size(), "TransformBoxes: output span is too small");
+        const Matrix4x4 m = matrix;
+        Kernels().transformBoxes(m, boxes.data(), out.data(), boxes.size());
+    }
+
+} // namespace Angaraka::Math::Batch
@@ -193,9 +193,9 @@ namespace Angaraka::AI {
             stateEvent.newState = newState;
             stateEvent.reason = reason;
 
-            // Note: Actual event publishing would depend on your EventManager API
-            // m_eventManager->Publish(stateEvent);
-            Angaraka::Events::EventManager::Get().Broadcast(stateEvent);
+            // Queued rather than broadcast: state changes happen inside (possibly parallel)
+            // NPC updates, listeners receive them on the game thread at FlushEvents
+            Angaraka::Events::EventManager::Get().Enqueue(stateEvent);
             AGK_INFO("NPCController: Publishing state change event for NPC '{0}'", m_npcData.npcId);
         }
     }
@@ -309,6 +309,7 @@ namespace Angaraka::AI {
         // Prepare behavior request
         BehaviorRequest request;
         request.factionId = m_npcData.GetFactionString();
+        request.npcId = m_npcData.npcId;
         request.npcType = "civilian"; // Could be made configurable
         request.currentSituation = situation;
         request.availableActions = availableActions;
@@ -1,5 +1,6 @@
 #include "Angaraka/NPCManager.hpp"
 #include <Angaraka/AIManager.hpp>
+#include <Angaraka/JobSystem.hpp>
 #include <sstream>
 #include <fstream>
 
@@ -367,6 +368,11 @@ namespace Angaraka::AI {
 
         AGK_INFO("NPCManager: Destroying NPC '{0}' (Reason: {1})", npcId, reason);
 
+        // Nobody will read its pending AI results anymore
+        if (m_aiManager) {
+            m_aiManager->CancelRequestsForNPC(npcId);
+        }
+
         // Shutdown the NPC
         if (it->second) {
             it->second->Shutdown();
@@ -757,6 +763,9 @@ namespace Angaraka::AI {
             if (distance > m_settings.maxUpdateDistance) {
                 if (npcController->IsActive()) {
                     npcController->SetActive(false);
+                    if (m_aiManager) {
+                        m_aiManager->CancelRequestsForNPC(npcId);
+                    }
                     culledCount++;
                 }
             }
@@ -1031,13 +1040,25 @@ namespace Angaraka::AI {
     }
 
     void NPCManager::UpdateNPCBatch(const std::vector<NPCController*>& npcs, F32 deltaTime) {
-        for (NPCController* npc : npcs) {
-            if (!npc || !ShouldUpdateNPC(npc)) {
-                continue;
+        auto updateRange = [this, &npcs, deltaTime](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                NPCController* npc = npcs[i];
+                if (!npc || !ShouldUpdateNPC(npc)) {
+                    continue;
+                }
+
+                npc->Update(deltaTime);
             }
+        };
 
-            npc->Update(deltaTime);
+        // Each controller only touches its own state, so chunks can run on any worker.
+        // The game thread takes part and returns once the whole batch is done.
+        if (m_settings.enableParallelUpdates && npcs.size() > m_settings.parallelUpdateGrainSize) {
+            JobSystem::Get().ParallelFor(npcs.size(), m_settings.parallelUpdateGrainSize, updateRange, JobPriority::High);
+            return;
         }
+
+        updateRange(0, npcs.size());
     }
 
     void NPCManager::ProcessNPCEvents() {
@@ -119,6 +119,8 @@ namespace Angaraka::AI {
         bool enableDistanceCulling{ true };        // Enable distance-based performance optimization
         bool enableFrustumCulling{ false };        // Enable view frustum culling (requires camera integration)
         bool enableBatchUpdates{ true };           // Process NPCs in batches for better performance
+        bool enableParallelUpdates{ false };       // Spread NPC updates over the job system (custom update callbacks must be thread-safe)
+        U32 parallelUpdateGrainSize{ 4 };          // NPCs per job when parallel updates are enabled
 
         // Debug settings
         bool enableDebugLogging{ false };
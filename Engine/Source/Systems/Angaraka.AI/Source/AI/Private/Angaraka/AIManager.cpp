@@ -1,6 +1,7 @@
 ﻿// Engine/Source/Systems/Angaraka.AI/Source/AI/Modules/AIManager.cpp
 #include <Angaraka/AIManager.hpp>
 #include <Angaraka/AIBase.hpp>
+#include <Angaraka/JobSystem.hpp>
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
@@ -19,6 +20,43 @@ namespace Angaraka::AI {
 
     namespace {
 
+        InferenceTask::Clock::time_point DeadlineFromNow(F32 deadlineMs) {
+            if (deadlineMs <= 0.0f) {
+                return InferenceTask::Clock::time_point::max();
+            }
+            return InferenceTask::Clock::now()
+                + std::chrono::duration_cast<InferenceTask::Clock::duration>(std::chrono::duration<F32, std::milli>(deadlineMs));
+        }
+
+        // Queues a request and returns its future. run fulfils the promise, possibly later
+        // from another thread; a dropped request resolves with a default, unsuccessful response.
+        template<typename Response, typename Run>
+        std::future<Response> EnqueueInference(InferenceQueue& queue, const String& ownerId,
+            InferencePriority priority, F32 deadlineMs, Run&& run) {
+
+            auto promise = CreateReference<std::promise<Response>>();
+            auto future = promise->get_future();
+
+            InferenceTask task;
+            task.ownerId = ownerId;
+            task.priority = priority;
+            task.deadline = DeadlineFromNow(deadlineMs);
+            task.run = [promise, run = std::forward<Run>(run)]() mutable {
+                try {
+                    run(promise);
+                }
+                catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            };
+            task.drop = [promise](InferenceDropReason) {
+                promise->set_value(Response{});
+            };
+
+            queue.Submit(std::move(task));
+            return future;
+        }
+
 #pragma region AISystemManager for DML Initialization
         class AISystemManager {
         public:
@@ -120,7 +158,7 @@ namespace Angaraka::AI {
             const InitializationConfig& config,
             bool sharedModel
         ) {
-            auto env = Ort::Env(ORT_LOGGING_LEVEL_WARNING, "AngarakaAI");
+            Ort::Env& env = AIModelResource::GetEnvironment();
             try {
                 // Create session options
                 auto sessionOptions = CreateSessionOptions(capabilities, config, sharedModel);
@@ -239,7 +277,10 @@ namespace Angaraka::AI {
 
     AIManager::AIManager(const Config::AISystemConfig& config)
         : m_config(config)
+        , m_dialogueBatching{ config.dialogueBatchSize, config.dialogueBatchWindowMs }
         , m_activeFaction(config.defaultFaction)
+        , m_inferenceQueue(CreateScope<InferenceQueue>(InferenceQueueSettings{ config.maxConcurrentInferences, config.maxQueuedInferences }))
+        , m_responseCache(CreateScope<ResponseCache>(ResponseCacheSettings{ config.responseCacheBudgetMB * 1024 * 1024, config.responseCacheTTLSeconds }))
         , m_lastMetricsUpdate(std::chrono::steady_clock::now())
     {
         AGK_INFO("AIManager: Initializing with GPU acceleration: {0}, Max VRAM: {1}MB",
@@ -270,19 +311,16 @@ namespace Angaraka::AI {
                 return false;
             }
 
-            // Start background worker threads
-            m_shutdownRequested = false;
-            for (size_t i = 0; i < m_config.backgroundThreadCount; ++i) {
-                m_backgroundThreads.emplace_back([this]() { ProcessBackgroundTasks(); });
-                AGK_TRACE("AIManager: Started background thread {0}", i);
-            }
-
             // Initialize performance monitoring
             m_performanceMetrics = AIPerformanceMetrics{};
             m_profilingEnabled = m_config.enablePerformanceMonitoring;
 
-            AGK_INFO("AIManager: Successfully initialized with {0} background threads",
-                m_config.backgroundThreadCount);
+            if (m_config.enableResponseCache && !m_config.responseCachePath.empty()) {
+                m_responseCache->Load(m_config.responseCachePath);
+            }
+
+            AGK_INFO("AIManager: Successfully initialized, up to {0} async requests run at once",
+                m_inferenceQueue->GetSettings().maxConcurrent);
             return true;
         }
         catch (const std::exception& e) {
@@ -294,17 +332,14 @@ namespace Angaraka::AI {
     void AIManager::Shutdown() {
         AGK_INFO("AIManager: Starting shutdown...");
 
-        // Signal shutdown to background threads
-        m_shutdownRequested = true;
-        m_taskCondition.notify_all();
+        // In-flight async requests reference this manager, let them finish first
+        m_inferenceQueue->Shutdown();
 
-        // Wait for all background threads to finish
-        for (auto& thread : m_backgroundThreads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
+        // Queued generations store their responses, save once they are done
+        m_dialogueBatcher.reset();
+        if (m_config.enableResponseCache && !m_config.responseCachePath.empty()) {
+            m_responseCache->Save(m_config.responseCachePath);
         }
-        m_backgroundThreads.clear();
 
         // Unload shared AI resources
         UnloadSharedModel();
@@ -365,25 +400,122 @@ namespace Angaraka::AI {
     bool AIManager::LoadSharedDialogueModel(const String& modelPath) {
         AGK_INFO("AIManager: Loading shared dialogue model from '{0}'", modelPath);
 
-        if (m_sharedDialogueModel) {
-            AGK_WARN("AIManager: Shared dialogue model already loaded, unloading previous model");
-            size_t oldMemory = m_sharedDialogueModel->GetMemoryUsageMB();
-            m_currentVRAMUsage -= oldMemory;
-            m_sharedDialogueModel.reset();
-        }
+        ReleaseSharedDialogueModel();
+        return InstallSharedDialogueModel(modelPath, CreateModelResource("shared_dialogue_model", modelPath));
+    }
 
-        try {
-            m_sharedDialogueModel = CreateReference<AIModelResource>("shared_dialogue_model");
+    bool AIManager::PreloadDialogueResources(const String& modelsDirectory, const String& tokenizerPath, const String& modelPath) {
+        AGK_INFO("AIManager: Preloading dialogue resources (configs '{0}', tokenizer '{1}', model '{2}')",
+            modelsDirectory, tokenizerPath, modelPath);
 
-            if (!m_sharedDialogueModel->Load(modelPath, this)) {
-                AGK_ERROR("AIManager: Failed to load shared dialogue model from '{0}'", modelPath);
-                m_sharedDialogueModel.reset();
-                return false;
+        using Clock = std::chrono::steady_clock;
+        auto elapsedMs = [](Clock::time_point since) {
+            return std::chrono::duration<F32, std::milli>(Clock::now() - since).count();
+        };
+        const auto start = Clock::now();
+        m_startupTimings = AIStartupTimings{};
+
+        // Free the old model before the new one is loaded next to it
+        ReleaseSharedDialogueModel();
+
+        bool configsLoaded = false;
+        bool tokenizerLoaded = false;
+        Reference<AIModelResource> model;
+
+        // The phases write disjoint members; the model is installed once all of them are done
+        std::vector<Core::JobFunction> phases;
+        phases.push_back([&]() {
+            auto phaseStart = Clock::now();
+            configsLoaded = LoadFactionConfigs(modelsDirectory);
+            m_startupTimings.factionConfigsMs = elapsedMs(phaseStart);
+        });
+        phases.push_back([&]() {
+            auto phaseStart = Clock::now();
+            tokenizerLoaded = LoadSharedTokenizer(tokenizerPath);
+            m_startupTimings.tokenizerMs = elapsedMs(phaseStart);
+        });
+        phases.push_back([&]() {
+            model = CreateModelResource("shared_dialogue_model", modelPath);
+            if (model) {
+                m_startupTimings.sessionMs = model->GetSessionLoadTimeMs();
+                m_startupTimings.warmupMs = model->GetWarmupTimeMs();
+                m_startupTimings.usedOptimizedModelCache = model->IsLoadedFromOptimizedCache();
             }
+        });
+
+        auto& jobSystem = Core::JobSystem::Get();
+        if (jobSystem.IsRunning()) {
+            auto counter = jobSystem.CreateCounter();
+            jobSystem.SubmitBatch(std::move(phases), Core::JobPriority::Normal, counter);
+            jobSystem.Wait(counter);
+        }
+        else {
+            for (auto& phase : phases) {
+                phase();
+            }
+        }
+
+        bool modelLoaded = InstallSharedDialogueModel(modelPath, std::move(model));
+        m_startupTimings.totalMs = elapsedMs(start);
+
+        AGK_INFO("AIManager: Dialogue resources ready in {0:.1f}ms - faction configs {1:.1f}ms, tokenizer {2:.1f}ms, "
+            "session {3:.1f}ms{4}, warmup {5:.1f}ms",
+            m_startupTimings.totalMs, m_startupTimings.factionConfigsMs, m_startupTimings.tokenizerMs,
+            m_startupTimings.sessionMs, m_startupTimings.usedOptimizedModelCache ? " (optimized cache)" : "",
+            m_startupTimings.warmupMs);
+
+        return configsLoaded && tokenizerLoaded && modelLoaded;
+    }
+
+    Reference<AIModelResource> AIManager::CreateModelResource(const String& modelId, const String& modelPath) {
+        auto model = CreateReference<AIModelResource>(modelId);
+        model->SetLoadOptions(AIModelLoadOptions{ m_config.warmupModels, m_config.cacheOptimizedModels });
+
+        if (!model->Load(modelPath, this)) {
+            return nullptr;
+        }
+        return model;
+    }
+
+    void AIManager::ReleaseSharedDialogueModel() {
+        if (!m_sharedDialogueModel) {
+            return;
+        }
+
+        AGK_WARN("AIManager: Shared dialogue model already loaded, unloading previous model");
+        m_dialogueBatcher.reset();
+        m_dialogueContext.reset();
+        m_currentVRAMUsage -= m_sharedDialogueModel->GetMemoryUsageMB();
+        m_sharedDialogueModel.reset();
+        m_dialogueModelKey.clear();
+    }
+
+    bool AIManager::InstallSharedDialogueModel(const String& modelPath, Reference<AIModelResource> model) {
+        if (!model) {
+            AGK_ERROR("AIManager: Failed to load shared dialogue model from '{0}'", modelPath);
+            return false;
+        }
+
+        try {
+            m_sharedDialogueModel = std::move(model);
 
             // Update VRAM usage
             m_currentVRAMUsage += m_sharedDialogueModel->GetMemoryUsageMB();
 
+            // A retrained model in the same file must not replay old responses
+            std::error_code error;
+            auto fileSize = std::filesystem::file_size(modelPath, error);
+            auto writeTime = std::filesystem::last_write_time(modelPath, error).time_since_epoch().count();
+            m_dialogueModelKey = modelPath + "|" + std::to_string(fileSize) + "|" + std::to_string(writeTime)
+                + "|" + m_sharedDialogueModel->GetMetadata().version;
+
+            m_dialogueBatcher = CreateScope<InferenceBatcher>(m_sharedDialogueModel, m_dialogueBatching);
+
+            // Generation has its own decode loop, single-pass models reuse preallocated tensors
+            if (!m_sharedDialogueModel->SupportsGeneration()) {
+                m_dialogueContext = m_sharedDialogueModel->CreateInferenceContext(m_config.maxDialogueContextTokens);
+            }
+
 #ifdef _DEBUG
             // test
             AGK_INFO("=== Testing Enhanced Token Decoding ===");
@@ -411,6 +543,8 @@ namespace Angaraka::AI {
         }
         catch (const std::exception& e) {
             AGK_ERROR("AIManager: Exception loading shared dialogue model: {0}", e.what());
+            m_dialogueBatcher.reset();
+            m_dialogueContext.reset();
             m_sharedDialogueModel.reset();
             return false;
         }
@@ -435,20 +569,37 @@ namespace Angaraka::AI {
         bool allLoaded = true;
         int loadedCount = 0;
 
-        for (const auto& [factionId, fileName] : factionFiles) {
-            String configPath = modelsDirectory + "/" + fileName;
+        // Files are parsed in parallel, the config map is only written afterwards
+        std::vector<Reference<FactionConfig>> configs(factionFiles.size());
+        auto parseRange = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto& [factionId, fileName] = factionFiles[i];
+                String configPath = modelsDirectory + "/" + fileName;
 
-            if (std::filesystem::exists(configPath)) {
-                if (LoadFactionConfigFile(factionId, configPath)) {
-                    loadedCount++;
+                if (std::filesystem::exists(configPath)) {
+                    configs[i] = ParseFactionConfigFile(factionId, configPath);
                 }
                 else {
-                    AGK_WARN("AIManager: Failed to load config for faction '{0}'", factionId);
-                    allLoaded = false;
+                    AGK_WARN("AIManager: Config file not found: '{0}'", configPath);
                 }
             }
+        };
+
+        auto& jobSystem = Core::JobSystem::Get();
+        if (jobSystem.IsRunning()) {
+            jobSystem.ParallelFor(factionFiles.size(), 1, parseRange, Core::JobPriority::Normal);
+        }
+        else {
+            parseRange(0, factionFiles.size());
+        }
+
+        for (size_t i = 0; i < factionFiles.size(); ++i) {
+            if (configs[i]) {
+                m_factionConfigs[factionFiles[i].first] = configs[i];
+                loadedCount++;
+            }
             else {
-                AGK_WARN("AIManager: Config file not found: '{0}'", configPath);
+                AGK_WARN("AIManager: Failed to load config for faction '{0}'", factionFiles[i].first);
                 allLoaded = false;
             }
         }
@@ -489,9 +640,14 @@ namespace Angaraka::AI {
     }
 
     void AIManager::UnloadSharedModel() {
+        // Finishes queued generations, their completions still use the model and tokenizer
+        m_dialogueBatcher.reset();
+        m_dialogueContext.reset();
+
         if (m_sharedDialogueModel) {
             size_t modelMemory = m_sharedDialogueModel->GetMemoryUsageMB();
             m_sharedDialogueModel.reset();
+            m_dialogueModelKey.clear();
             m_currentVRAMUsage -= modelMemory;
             AGK_INFO("AIManager: Unloaded shared dialogue model, VRAM usage: {0}MB", m_currentVRAMUsage);
         }
@@ -576,34 +732,120 @@ namespace Angaraka::AI {
     // ===== HIGH-LEVEL AI INTERFACES =====
 
     std::future<DialogueResponse> AIManager::GenerateDialogue(const DialogueRequest& request) {
-        return std::async(std::launch::async, [this, request]() {
-            return GenerateDialogueSync(request);
+        // Cached responses skip the queue entirely
+        if (IsDialogueCacheable(request)) {
+            if (auto factionConfig = GetFactionConfig(request.factionId)) {
+                StageTimer timer;
+                DialogueTrace trace;
+                DialogueResponse response;
+                String prompt = BuildFactionPrompt(factionConfig, request);
+                trace.promptBuildMs = timer.Lap();
+                if (TryGetCachedDialogue(request, prompt, response)) {
+                    trace.cacheLookupMs = timer.Lap();
+                    trace.path = DialoguePath::Cached;
+                    FinishDialogue(request, response, trace, timer);
+
+                    std::promise<DialogueResponse> ready;
+                    ready.set_value(std::move(response));
+                    return ready.get_future();
+                }
+            }
+        }
+
+        // The queued request only prepares the prompt; generation is fulfilled by the batcher,
+        // so the job worker does not block on it. The batcher keeps the request's priority and
+        // deadline while it waits for a row.
+        const auto deadline = DeadlineFromNow(request.deadlineMs);
+        return EnqueueInference<DialogueResponse>(*m_inferenceQueue, request.npcId, request.priority, request.deadlineMs,
+            [this, request, deadline](const Reference<std::promise<DialogueResponse>>& promise) {
+                auto completion = [promise](DialogueResponse&& response) { promise->set_value(std::move(response)); };
+                if (auto response = StartDialogue(request, completion, true, deadline)) {
+                    promise->set_value(std::move(*response));
+                }
             });
     }
 
     std::future<TerrainResponse> AIManager::GenerateTerrain(const TerrainRequest& request) {
-        return std::async(std::launch::async, [this, request]() {
-            return GenerateTerrainSync(request);
-        });
+        return EnqueueInference<TerrainResponse>(*m_inferenceQueue, String{}, request.priority, request.deadlineMs,
+            [this, request](const Reference<std::promise<TerrainResponse>>& promise) {
+                promise->set_value(GenerateTerrainSync(request));
+            });
     }
 
     std::future<BehaviorResponse> AIManager::EvaluateBehavior(const BehaviorRequest& request) {
-        return std::async(std::launch::async, [this, request]() {
-            return EvaluateBehaviorSync(request);
-        });
+        return EnqueueInference<BehaviorResponse>(*m_inferenceQueue, request.npcId, request.priority, request.deadlineMs,
+            [this, request](const Reference<std::promise<BehaviorResponse>>& promise) {
+                promise->set_value(EvaluateBehaviorSync(request));
+            });
+    }
+
+    bool AIManager::IsDialogueCacheable(const DialogueRequest& request) const {
+        return m_config.enableResponseCache && !request.bypassResponseCache && !m_dialogueModelKey.empty();
+    }
+
+    bool AIManager::TryGetCachedDialogue(const DialogueRequest& request, const String& prompt, DialogueResponse& response) {
+        if (!IsDialogueCacheable(request)) {
+            return false;
+        }
+
+        auto key = ResponseCache::MakeKey(m_dialogueModelKey, request.factionId, prompt, m_dialogueSampling, m_config.maxDialogueTokens);
+        CachedDialogue cached;
+        if (!m_responseCache->TryGet(key, request.factionId, cached)) {
+            return false;
+        }
+
+        response.response = std::move(cached.response);
+        response.emotionalTone = std::move(cached.emotionalTone);
+        response.suggestedPlayerResponses = std::move(cached.suggestedPlayerResponses);
+        response.confidence = cached.confidence;
+        response.success = true;
+        return true;
+    }
+
+    void AIManager::StoreCachedDialogue(const DialogueRequest& request, const String& prompt, const DialogueResponse& response) {
+        // Fallback lines are not model output, keep them out so the model gets another chance
+        if (!response.success || !IsDialogueCacheable(request)) {
+            return;
+        }
+
+        auto key = ResponseCache::MakeKey(m_dialogueModelKey, request.factionId, prompt, m_dialogueSampling, m_config.maxDialogueTokens);
+        m_responseCache->Put(key, request.factionId,
+            CachedDialogue{ response.response, response.emotionalTone, response.suggestedPlayerResponses, response.confidence });
+    }
+
+    size_t AIManager::CancelRequestsForNPC(const String& npcId) {
+        size_t cancelled = m_inferenceQueue->CancelForOwner(npcId);
+        if (m_dialogueBatcher) {
+            cancelled += m_dialogueBatcher->CancelForOwner(npcId);
+        }
+        if (cancelled > 0) {
+            AGK_INFO("AIManager: Cancelled {0} queued request(s) for NPC '{1}'", cancelled, npcId);
+        }
+        return cancelled;
     }
 
     DialogueResponse AIManager::GenerateDialogueSync(const DialogueRequest& request) {
+        std::promise<DialogueResponse> queued;
+        auto future = queued.get_future();
+
+        auto response = StartDialogue(request, [&queued](DialogueResponse&& result) { queued.set_value(std::move(result)); });
+        return response ? std::move(*response) : future.get();
+    }
+
+    std::optional<DialogueResponse> AIManager::StartDialogue(const DialogueRequest& request, DialogueCompletion completion,
+        bool cacheChecked, InferenceTask::Clock::time_point deadline) {
         DialogueResponse response;
         response.success = false;
 
-        auto start = std::chrono::high_resolution_clock::now();
+        DialogueTrace trace;
+        StageTimer timer;
 
         try {
             // Check if shared dialogue model is loaded
             if (!m_sharedDialogueModel || !m_sharedDialogueModel->IsLoaded()) {
                 AGK_ERROR("AIManager: Shared dialogue model not loaded");
                 response.response = GenerateFallbackResponse(request);
+                FinishDialogue(request, response, trace, timer);
                 return response;
             }
 
@@ -612,6 +854,7 @@ namespace Angaraka::AI {
             if (!factionConfig) {
                 AGK_ERROR("AIManager: No faction config found for '{0}'", request.factionId);
                 response.response = GenerateFallbackResponse(request);
+                FinishDialogue(request, response, trace, timer);
                 return response;
             }
 
@@ -622,56 +865,147 @@ namespace Angaraka::AI {
             if (inputNames.empty()) {
                 AGK_ERROR("AIManager: Shared dialogue model has no inputs defined");
                 response.response = GenerateFallbackResponse(request);
+                FinishDialogue(request, response, trace, timer);
                 return response;
             }
 
-            AGK_INFO("AIManager: Generating dialogue for faction '{0}' using shared model", request.factionId);
-
             // Build faction-specific prompt using the actual config structure
             String prompt = BuildFactionPrompt(factionConfig, request);
-            AGK_INFO("AIManager: Built prompt: '{0}'", prompt.length() > 100 ? prompt.substr(0, 100) + "..." : prompt);
+            trace.promptBuildMs = timer.Lap();
+            AGK_TRACE("AIManager: Built prompt for faction '{0}': '{1}'", request.factionId, prompt);
+
+            if (!cacheChecked) {
+                const bool cached = TryGetCachedDialogue(request, prompt, response);
+                trace.cacheLookupMs = timer.Lap();
+                if (cached) {
+                    trace.path = DialoguePath::Cached;
+                    FinishDialogue(request, response, trace, timer);
+                    return response;
+                }
+            }
 
-            // Create input tensors
-            std::vector<Ort::Value> inputs = CreateDialogueInputs(prompt, request, inputNames, inputShapes);
+            // Causal language models get a real decode loop, other dialogue models keep the
+            // single pass below
+            if (m_dialogueBatcher && m_sharedTokenizer && m_sharedTokenizer->CanEncode() && m_sharedDialogueModel->SupportsGeneration()) {
+                SamplingParams sampling = m_dialogueSampling;
+                // Seeded like the cache key is built, so prompts that share a cache entry sample alike
+                sampling.seed ^= ResponseCache::HashPrompt(prompt);
+                auto sampler = CreateReference<LogitsSampler>(sampling);
+
+                GenerationConfig generation;
+                generation.maxNewTokens = m_config.maxDialogueTokens;
+                generation.sampler = [sampler](std::span<const F32> logits, std::span<const I64> sequence) {
+                    I64 token = sampler->Sample(logits, sequence);
+                    return SampledToken{ token, sampler->GetLastLogProbability() };
+                };
+                if (I64 eosToken = m_sharedTokenizer->GetEosTokenId(); eosToken >= 0) {
+                    generation.stopTokens.push_back(eosToken);
+                }
 
-            if (inputs.size() != inputNames.size()) {
-                AGK_ERROR("AIManager: Input count mismatch - created {0}, expected {1}",
-                    inputs.size(), inputNames.size());
-                response.response = GenerateFallbackResponse(request);
-                return response;
-            }
+                std::vector<I64> promptTokens = TokenizePrompt(prompt);
+                trace.tokenizeMs = timer.Lap();
+                trace.promptTokens = promptTokens.size();
 
-            DiagnoseInferenceInputs(inputs, inputNames);
+                // Dropped while waiting for a row, resolves like a request the inference queue dropped
+                auto onDropped = [completion](InferenceDropReason) { completion(DialogueResponse{}); };
 
-            // Run inference with shared model
-            auto outputs = m_sharedDialogueModel->RunInference(inputs);
-            if (outputs.empty()) {
-                AGK_ERROR("AIManager: Shared dialogue model inference failed for faction '{0}'", request.factionId);
-                response.response = GenerateFallbackResponse(request);
-                return response;
+                // Runs on a job worker once this request has finished generating
+                auto onGenerated = [this, request, prompt, factionConfig, trace, timer, completion = std::move(completion)](GenerationResult&& generated) mutable {
+                    // Whatever the batch did not spend running the model was spent waiting for it
+                    trace.inferenceMs = generated.promptTimeMs + generated.decodeTimeMs;
+                    trace.waitMs = std::max(0.0f, timer.Lap() - trace.inferenceMs);
+                    trace.outputTokens = generated.tokens.size();
+
+                    DialogueResponse response;
+                    try {
+                        response.response = generated.success ? DecodeTokensToText(generated.tokens, request.factionId) : String{};
+                        if (response.response.empty()) {
+                            AGK_WARN("AIManager: Generation produced no text for faction '{0}'", request.factionId);
+                            response.response = GenerateFallbackResponse(request);
+                        }
+                        else {
+                            response.confidence = generated.averageProbability;
+                            ApplyFactionPostProcessing(response, factionConfig);
+                            StoreCachedDialogue(request, prompt, response);
+                            trace.path = DialoguePath::Generated;
+                        }
+                    }
+                    catch (const std::exception& e) {
+                        AGK_ERROR("AIManager: Exception finishing dialogue generation: {0}", e.what());
+                        response.response = GenerateFallbackResponse(request);
+                        trace.path = DialoguePath::Fallback;
+                    }
+
+                    trace.decodeMs = timer.Lap();
+                    FinishDialogue(request, response, trace, timer);
+                    completion(std::move(response));
+                };
+
+                GenerationSchedule schedule{ request.npcId, request.priority, deadline };
+                m_dialogueBatcher->Submit(std::move(promptTokens), std::move(generation), std::move(onGenerated), schedule, std::move(onDropped));
+                return std::nullopt;
             }
 
-            // Process outputs
-            response = ProcessDialogueOutputs(outputs, m_sharedDialogueModel, request);
+            // Preallocated tensors when the model allows them, fresh ones otherwise
+            if (!RunBoundDialogueInference(prompt, request, response, trace, timer)) {
+                std::vector<Ort::Value> inputs = CreateDialogueInputs(prompt, request, inputNames, inputShapes);
+                trace.inputMs += timer.Lap();
+
+                if (inputs.size() != inputNames.size()) {
+                    AGK_ERROR("AIManager: Input count mismatch - created {0}, expected {1}",
+                        inputs.size(), inputNames.size());
+                    response.response = GenerateFallbackResponse(request);
+                    FinishDialogue(request, response, trace, timer);
+                    return response;
+                }
+
+                DiagnoseInferenceInputs(inputs, inputNames);
+
+                // Run inference with shared model
+                auto outputs = m_sharedDialogueModel->RunInference(inputs);
+                trace.inferenceMs += timer.Lap();
+                if (outputs.empty()) {
+                    AGK_ERROR("AIManager: Shared dialogue model inference failed for faction '{0}'", request.factionId);
+                    response.response = GenerateFallbackResponse(request);
+                    FinishDialogue(request, response, trace, timer);
+                    return response;
+                }
+
+                // Process outputs
+                response = ProcessDialogueOutputs(outputs, m_sharedDialogueModel, request);
+            }
 
             // Apply faction-specific post-processing
             ApplyFactionPostProcessing(response, factionConfig);
+            StoreCachedDialogue(request, prompt, response);
+            trace.decodeMs += timer.Lap();
+            trace.path = DialoguePath::SinglePass;
 
-            AGK_INFO("AIManager: Generated dialogue for faction '{0}': '{1}'",
-                request.factionId, response.response.length() > 100 ? response.response.substr(0, 100) + "..." : response.response);
-
+            AGK_TRACE("AIManager: Generated dialogue for faction '{0}': '{1}'", request.factionId, response.response);
         }
         catch (const std::exception& e) {
             AGK_ERROR("AIManager: Exception in dialogue generation: {0}", e.what());
             response.response = GenerateFallbackResponse(request);
+            trace.path = DialoguePath::Fallback;
         }
 
-        auto end = std::chrono::high_resolution_clock::now();
-        response.inferenceTimeMs = std::chrono::duration<F32, std::milli>(end - start).count();
-
+        FinishDialogue(request, response, trace, timer);
         return response;
     }
 
+    void AIManager::FinishDialogue(const DialogueRequest& request, DialogueResponse& response, DialogueTrace& trace, const StageTimer& timer) {
+        trace.totalMs = timer.TotalMs();
+        response.inferenceTimeMs = trace.totalMs;
+        response.trace = trace;
+
+        // One line per request instead of free text at every stage
+        AGK_DEBUG("AIManager: Dialogue npc='{0}' faction='{1}' path={2} tokens={3}/{4} prompt={5:.2f}ms cache={6:.2f}ms "
+            "tokenize={7:.2f}ms inputs={8:.2f}ms wait={9:.2f}ms inference={10:.2f}ms decode={11:.2f}ms total={12:.2f}ms",
+            request.npcId, request.factionId, ToString(trace.path), trace.promptTokens, trace.outputTokens,
+            trace.promptBuildMs, trace.cacheLookupMs, trace.tokenizeMs, trace.inputMs, trace.waitMs,
+            trace.inferenceMs, trace.decodeMs, trace.totalMs);
+    }
+
     TerrainResponse AIManager::GenerateTerrainSync(const TerrainRequest& request) {
         TerrainResponse response;
         response.success = false;
@@ -818,6 +1152,21 @@ namespace Angaraka::AI {
 
     // ===== PERFORMANCE AND MONITORING =====
 
+    void AIManager::SetDialogueBatchingSettings(const InferenceBatcherSettings& settings) {
+        m_dialogueBatching = settings;
+        if (m_dialogueBatcher) {
+            m_dialogueBatcher->SetSettings(settings);
+        }
+    }
+
+    InferenceBatcherSettings AIManager::GetDialogueBatchingSettings() const {
+        return m_dialogueBatcher ? m_dialogueBatcher->GetSettings() : m_dialogueBatching;
+    }
+
+    InferenceBatcherStats AIManager::GetDialogueBatchingStats() const {
+        return m_dialogueBatcher ? m_dialogueBatcher->GetStats() : InferenceBatcherStats{};
+    }
+
     F32 AIManager::GetVRAMUsagePercent() const {
         return static_cast<F32>(m_currentVRAMUsage) / static_cast<F32>(m_config.maxVRAMUsageMB) * 100.0f;
     }
@@ -1021,43 +1370,6 @@ namespace Angaraka::AI {
             vramPercent);
     }
 
-    void AIManager::ProcessBackgroundTasks() {
-        AGK_TRACE("AIManager: Background thread started");
-
-        while (!m_shutdownRequested) {
-            std::function<void()> task;
-
-            // Wait for a task or shutdown signal
-            {
-                std::unique_lock<std::mutex> lock(m_taskQueueMutex);
-                m_taskCondition.wait(lock, [this] {
-                    return !m_taskQueue.empty() || m_shutdownRequested;
-                    });
-
-                if (m_shutdownRequested) {
-                    break;
-                }
-
-                if (!m_taskQueue.empty()) {
-                    task = std::move(m_taskQueue.front());
-                    m_taskQueue.pop();
-                }
-            }
-
-            // Execute the task
-            if (task) {
-                try {
-                    task();
-                }
-                catch (const std::exception& e) {
-                    AGK_ERROR("AIManager: Exception in background task: {0}", e.what());
-                }
-            }
-        }
-
-        AGK_TRACE("AIManager: Background thread shutting down");
-    }
-
     void AIManager::CheckForModelFileChanges() {
         // Placeholder for development hot-swapping
         // Would monitor file modification times and trigger reloads
@@ -1079,8 +1391,8 @@ namespace Angaraka::AI {
         }
 
         // Create and load the model resource
-        auto model = CreateReference<AIModelResource>(modelId);
-        if (!model->Load(modelPath)) {
+        auto model = CreateModelResource(modelId, modelPath);
+        if (!model) {
             AGK_ERROR("AIManager: Failed to load model '{0}' from '{1}'", modelId, modelPath);
             return false;
         }
@@ -1139,11 +1451,10 @@ namespace Angaraka::AI {
             auto outputNames = model->GetOutputNames();
             auto outputShapes = model->GetOutputShapes();
 
-            AGK_INFO("AIManager: Processing {0} outputs from dialogue model:", outputs.size());
+            AGK_TRACE("AIManager: Processing {0} outputs from dialogue model:", outputs.size());
 
             // Process each output based on its name/type
             for (size_t i = 0; i < outputs.size() && i < outputNames.size(); ++i) {
-                const String& outputName = outputNames[i];
                 const auto& output = outputs[i];
 
                 if (!output.IsTensor()) {
@@ -1151,51 +1462,41 @@ namespace Angaraka::AI {
                     continue;
                 }
 
-                if (outputName == "output" || outputName == "response_tokens" || outputName == "output_ids" || outputName == "tokens") {
-                    // Check tensor type and process accordingly
-                    auto tensorInfo = output.GetTensorTypeAndShapeInfo();
-                    auto elementType = tensorInfo.GetElementType();
+                auto tensorInfo = output.GetTensorTypeAndShapeInfo();
+                auto shape = tensorInfo.GetShape();
+                ApplyDialogueOutput(outputNames[i], tensorInfo.GetElementType(), output.GetTensorRawData(), shape, request, response);
+            }
 
-                    AGK_INFO("AIManager: Output '{0}' has element type: {1}", outputName, static_cast<int>(elementType));
+            // Ensure we have at least some response
+            if (response.response.empty() && response.success) {
+                response.response = GenerateFallbackResponse(request);
+                AGK_WARN("AIManager: Generated fallback response for faction '{0}'", request.factionId);
+            }
 
-                    if (elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64) {
-                        // Token IDs that need to be decoded to text
-                        auto tokenIds = ExtractInt64Tensor(output);
-                        response.response = DecodeTokensToText(tokenIds, request.factionId);
-                        response.success = true;
-                    }
-                    else if (elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
-                        // Logits/probabilities - need to convert to tokens first
-                        auto logits = ExtractFloatTensor(output);
-                        auto tokenIds = ConvertLogitsToTokens(logits);
-                        response.response = DecodeTokensToText(tokenIds, request.factionId);
-                        response.success = true;
+        }
+        catch (const std::exception& e) {
+            AGK_ERROR("AIManager: Exception processing dialogue outputs: {0}", e.what());
+            response.success = false;
+        }
 
-                        // Also calculate confidence from logits
-                        if (!logits.empty()) {
-                            response.confidence = CalculateConfidenceFromLogits(logits);
-                        }
-                    }
-                    else {
-                        AGK_ERROR("AIManager: Unsupported tensor type for output '{0}': {1}",
-                            outputName, static_cast<int>(elementType));
-                    }
-                }
-                else if (outputName == "confidence" || outputName == "confidence_score") {
-                    // Confidence score for the response
-                    auto confidenceValues = ExtractFloatTensor(output);
-                    if (!confidenceValues.empty()) {
-                        response.confidence = confidenceValues[0];
-                    }
-                }
+        return response;
+    }
+
+    DialogueResponse AIManager::ProcessDialogueOutputs(const InferenceContext& context, const DialogueRequest& request) {
+        DialogueResponse response;
+        response.success = false;
+
+        try {
+            // Outputs are read where the model wrote them, trimmed to the prompt's positions
+            for (size_t i = 0; i < context.GetOutputCount(); ++i) {
+                ApplyDialogueOutput(context.GetOutputName(i), context.GetOutputType(i), context.GetOutputRawData(i),
+                    context.GetOutputShape(i), request, response);
             }
 
-            // Ensure we have at least some response
             if (response.response.empty() && response.success) {
                 response.response = GenerateFallbackResponse(request);
                 AGK_WARN("AIManager: Generated fallback response for faction '{0}'", request.factionId);
             }
-
         }
         catch (const std::exception& e) {
             AGK_ERROR("AIManager: Exception processing dialogue outputs: {0}", e.what());
@@ -1205,6 +1506,47 @@ namespace Angaraka::AI {
         return response;
     }
 
+    void AIManager::ApplyDialogueOutput(const String& outputName, ONNXTensorElementDataType elementType, const void* data,
+        std::span<const I64> shape, const DialogueRequest& request, DialogueResponse& response) {
+
+        size_t elementCount = 1;
+        for (I64 dim : shape) {
+            elementCount *= static_cast<size_t>(std::max<I64>(dim, 0));
+        }
+
+        if (outputName == "output" || outputName == "response_tokens" || outputName == "output_ids" || outputName == "tokens") {
+            AGK_TRACE("AIManager: Output '{0}' has element type: {1}", outputName, static_cast<int>(elementType));
+
+            if (elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64) {
+                // Token IDs that need to be decoded to text
+                std::span<const I64> tokenIds(static_cast<const I64*>(data), elementCount);
+                response.response = DecodeTokensToText(tokenIds, request.factionId);
+                response.success = true;
+            }
+            else if (elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+                // Logits shaped [..., sequence_length, vocab_size], converted to tokens first
+                std::span<const F32> logits(static_cast<const F32*>(data), elementCount);
+                size_t vocabSize = shape.empty() ? 0 : static_cast<size_t>(std::max<I64>(shape.back(), 0));
+                auto tokenIds = ConvertLogitsToTokens(logits, vocabSize);
+                response.response = DecodeTokensToText(tokenIds, request.factionId);
+                response.success = true;
+
+                // Also calculate confidence from logits
+                response.confidence = CalculateConfidenceFromLogits(logits);
+            }
+            else {
+                AGK_ERROR("AIManager: Unsupported tensor type for output '{0}': {1}",
+                    outputName, static_cast<int>(elementType));
+            }
+        }
+        else if (outputName == "confidence" || outputName == "confidence_score") {
+            // Confidence score for the response
+            if (elementType == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT && elementCount > 0) {
+                response.confidence = static_cast<const F32*>(data)[0];
+            }
+        }
+    }
+
     TerrainResponse AIManager::ProcessTerrainOutputs(const std::vector<Ort::Value>& outputs,
         Reference<AIModelResource> model, const TerrainRequest& request) {
 
@@ -1298,13 +1640,13 @@ namespace Angaraka::AI {
 
     // ===== DIALOGUE PROCESSING HELPERS =====
 
-    String AIManager::DecodeTokensToText(const std::vector<I64>& tokens, const String& factionId) {
+    String AIManager::DecodeTokensToText(std::span<const I64> tokens, const String& factionId) {
         if (tokens.empty()) {
             AGK_WARN("AIManager: No tokens to decode for faction '{}'", factionId);
             return GenerateFallbackResponse({ factionId, "", "", "", {}, {}, 0.5f });
         }
 
-        AGK_INFO("AIManager: Decoding {} tokens: [{}]", tokens.size(),
+        AGK_TRACE("AIManager: Decoding {} tokens: [{}]", tokens.size(),
             [&tokens]() {
                 String tokenStr;
                 for (size_t i = 0; i < tokens.size(); ++i) {
@@ -1338,14 +1680,14 @@ namespace Angaraka::AI {
         // Apply enhancements
         response = EnhanceDialogueResponse(response, factionId);
 
-        AGK_INFO("AIManager: Enhanced response: '{}'", response);
+        AGK_TRACE("AIManager: Enhanced response: '{}'", response);
         return response;
         /*if (tokens.empty()) {
             AGK_WARN("AIManager: No tokens to decode for faction '{0}'", factionId);
             return GenerateFallbackResponse({ factionId, "", "", "", {}, {}, 0.5f });
         }
 
-        AGK_INFO("AIManager: Decoding {0} tokens for faction '{1}': [{2}]",
+        AGK_TRACE("AIManager: Decoding {0} tokens for faction '{1}': [{2}]",
             tokens.size(), factionId,
             [&tokens]() {
                 String tokenStr;
@@ -1361,7 +1703,7 @@ namespace Angaraka::AI {
 
         // Use shared tokenizer if available
         if (m_sharedTokenizer && m_sharedTokenizer->IsLoaded()) {
-            AGK_INFO("AIManager: Using shared tokenizer for decoding");
+            AGK_TRACE("AIManager: Using shared tokenizer for decoding");
             decoded = m_sharedTokenizer->DecodeTokens(tokens);
         }
         else {
@@ -1384,7 +1726,7 @@ namespace Angaraka::AI {
             return GenerateFallbackResponse({ factionId, "", "", "", {}, {}, 0.5f });
         }
 
-        AGK_INFO("AIManager: Successfully decoded to text: '{0}'",
+        AGK_TRACE("AIManager: Successfully decoded to text: '{0}'",
             decoded.length() > 100 ? decoded.substr(0, 100) + "..." : decoded);
 
         return decoded;*/
@@ -1765,108 +2107,59 @@ namespace Angaraka::AI {
     }
 
     // ===== LOGITS PROCESSING HELPERS =====
-    std::vector<I64> AIManager::ConvertLogitsToTokens(const std::vector<F32>& logits) {
+    std::vector<I64> AIManager::ConvertLogitsToTokens(std::span<const F32> logits, size_t vocabSize) {
         std::vector<I64> tokens;
 
-        if (logits.empty()) {
+        // One row of vocabSize logits per position
+        const size_t sequenceLength = vocabSize > 0 ? logits.size() / vocabSize : 0;
+        if (sequenceLength == 0) {
             return tokens;
         }
 
-        // Your model shows 2,462,593 logits for 49 tokens = 50,257 vocab size (GPT-style)
-        const size_t vocabSize = 50257;
-
-        AGK_INFO("AIManager: Converting {0} logits (vocab size: {1})", logits.size(), vocabSize);
-
-        if (logits.size() % vocabSize == 0) {
-            // Shaped as [sequence_length, vocab_size]
-            size_t sequenceLength = logits.size() / vocabSize;
-            tokens.reserve(sequenceLength);
-
-            AGK_INFO("AIManager: Processing {0} token positions", sequenceLength);
-
-            for (size_t i = 0; i < sequenceLength; ++i) {
-                size_t start = i * vocabSize;
-
-                // Find token with highest probability
-                auto maxIt = std::max_element(logits.begin() + start, logits.begin() + start + vocabSize);
-                I64 tokenId = std::distance(logits.begin() + start, maxIt);
+        tokens.reserve(sequenceLength);
+        AGK_TRACE("AIManager: Processing {0} token positions", sequenceLength);
 
-                // Skip special tokens that shouldn't appear in dialogue
-                if (tokenId == 50256 || tokenId == 50257 || tokenId == 0) { // EOS, PAD tokens
-                    AGK_TRACE("AIManager: Skipping special token {0} at position {1}", tokenId, i);
-                    continue;
-                }
+        for (size_t i = 0; i < sequenceLength; ++i) {
+            std::span<const F32> row = logits.subspan(i * vocabSize, vocabSize);
 
-                // Skip tokens that are likely padding or noise
-                if (*maxIt < 0.01f) { // Very low probability
-                    AGK_TRACE("AIManager: Skipping low-probability token {0} (prob: {1:.4f}) at position {2}",
-                        tokenId, *maxIt, i);
-                    continue;
-                }
+            // Find token with highest probability
+            I64 tokenId = LogitsSampler::ArgMax(row);
+            F32 maxLogit = row[tokenId];
 
-                tokens.push_back(tokenId);
-                AGK_TRACE("AIManager: Token {0}: ID={1}, prob={2:.4f}", i, tokenId, *maxIt);
+            // Skip special tokens that shouldn't appear in dialogue
+            if (tokenId == 50256 || tokenId == 50257 || tokenId == 0) { // EOS, PAD tokens
+                AGK_TRACE("AIManager: Skipping special token {0} at position {1}", tokenId, i);
+                continue;
             }
-        }
-        else {
-            AGK_WARN("AIManager: Unexpected logits size {0}, not divisible by vocab size {1}",
-                logits.size(), vocabSize);
-
-            // Fallback: treat as single token prediction
-            auto maxIt = std::max_element(logits.begin(), logits.end());
-            I64 tokenId = std::distance(logits.begin(), maxIt);
 
-            if (tokenId != 50256 && tokenId != 50257 && tokenId != 0) {
-                tokens.push_back(tokenId);
+            // Skip tokens that are likely padding or noise
+            if (maxLogit < 0.01f) { // Very low probability
+                AGK_TRACE("AIManager: Skipping low-probability token {0} (prob: {1:.4f}) at position {2}",
+                    tokenId, maxLogit, i);
+                continue;
             }
+
+            tokens.push_back(tokenId);
+            AGK_TRACE("AIManager: Token {0}: ID={1}, prob={2:.4f}", i, tokenId, maxLogit);
         }
 
-        AGK_INFO("AIManager: Converted {0} logits to {1} valid tokens", logits.size(), tokens.size());
+        AGK_TRACE("AIManager: Converted {0} logit rows to {1} valid tokens", sequenceLength, tokens.size());
         return tokens;
     }
 
-    F32 AIManager::CalculateConfidenceFromLogits(const std::vector<F32>& logits) {
+    F32 AIManager::CalculateConfidenceFromLogits(std::span<const F32> logits) {
         if (logits.empty()) {
             return 0.0f;
         }
 
-        // Apply softmax to get probabilities, then take max probability as confidence
-        std::vector<F32> probabilities = ApplySoftmax(logits);
-
-        auto maxIt = std::max_element(probabilities.begin(), probabilities.end());
-        return *maxIt;
-    }
-
-    std::vector<F32> AIManager::ApplySoftmax(const std::vector<F32>& logits) {
-        std::vector<F32> probabilities(logits.size());
-
-        if (logits.empty()) {
-            return probabilities;
-        }
-
-        // Find max for numerical stability
-        F32 maxLogit = *std::max_element(logits.begin(), logits.end());
-
-        // Calculate exp(x - max) and sum
-        F32 sum = 0.0f;
-        for (size_t i = 0; i < logits.size(); ++i) {
-            probabilities[i] = std::exp(logits[i] - maxLogit);
-            sum += probabilities[i];
-        }
-
-        // Normalize
-        if (sum > 0.0f) {
-            for (F32& prob : probabilities) {
-                prob /= sum;
-            }
-        }
-
-        return probabilities;
+        // Max softmax probability over the whole tensor is exp(max - logSumExp)
+        F32 maxLogit = logits[LogitsSampler::ArgMax(logits)];
+        return std::exp(maxLogit - LogitsSampler::LogSumExp(logits));
     }
 
     // ===== NEW IMPLEMENTATION HELPERS =====
 
-    bool AIManager::LoadFactionConfigFile(const String& factionId, const String& configPath) {
+    Reference<AIManager::FactionConfig> AIManager::ParseFactionConfigFile(const String& factionId, const String& configPath) {
         try {
             std::ifstream file(configPath);
             nlohmann::json configJson;
@@ -1896,14 +2189,13 @@ namespace Angaraka::AI {
                 }
             }
 
-            m_factionConfigs[factionId] = config;
             AGK_INFO("AIManager: Loaded config for faction '{0}': {1}", factionId, config->displayName);
-            return true;
+            return config;
 
         }
         catch (const std::exception& e) {
             AGK_ERROR("AIManager: Failed to load faction config '{0}': {1}", configPath, e.what());
-            return false;
+            return nullptr;
         }
     }
 
@@ -1928,9 +2220,9 @@ namespace Angaraka::AI {
     std::vector<Ort::Value> AIManager::CreateDialogueInputs(const String& prompt, const DialogueRequest& request,
         const std::vector<String>& inputNames, const std::vector<std::vector<I64>>& inputShapes) {
 
-        AGK_INFO("=== CREATING DIALOGUE INPUTS DEBUG ===");
-        AGK_INFO("Prompt: '{}'", prompt);
-        AGK_INFO("Expected {} inputs", inputNames.size());
+        AGK_TRACE("=== CREATING DIALOGUE INPUTS DEBUG ===");
+        AGK_TRACE("Prompt: '{}'", prompt);
+        AGK_TRACE("Expected {} inputs", inputNames.size());
 
         std::vector<Ort::Value> inputs;
 
@@ -1938,9 +2230,9 @@ namespace Angaraka::AI {
         std::vector<I64> tokens = TokenizePrompt(prompt);
 
         // Immediate validation
-        AGK_INFO("Tokenization produced {} tokens", tokens.size());
+        AGK_TRACE("Tokenization produced {} tokens", tokens.size());
         for (size_t i = 0; i < std::min(tokens.size(), static_cast<size_t>(10)); ++i) {
-            AGK_INFO("Token[{}]: {}", i, tokens[i]);
+            AGK_TRACE("Token[{}]: {}", i, tokens[i]);
 
             // Check for the problematic value immediately
             if (tokens[i] == -2459565876494606883LL) {
@@ -1956,17 +2248,17 @@ namespace Angaraka::AI {
         try {
             for (size_t i = 0; i < inputNames.size(); ++i) {
                 const String& inputName = inputNames[i];
-                AGK_INFO("Creating input {}: '{}'", i, inputName);
+                AGK_TRACE("Creating input {}: '{}'", i, inputName);
 
                 if (inputName == "input" || inputName == "input_ids" || inputName == "tokens") {
                     // Use the stored tokens
                     std::vector<I64> shape = { 1, static_cast<I64>(m_lastTokenSequence.size()) };
 
-                    AGK_INFO("Creating input_ids: {} tokens, shape [{}, {}]",
+                    AGK_TRACE("Creating input_ids: {} tokens, shape [{}, {}]",
                         m_lastTokenSequence.size(), shape[0], shape[1]);
 
                     // Log the actual token values being used
-                    AGK_INFO("Token values: [{}]", [&]() {
+                    AGK_TRACE("Token values: [{}]", [&]() {
                         String tokenStr;
                         for (size_t j = 0; j < std::min(m_lastTokenSequence.size(), static_cast<size_t>(10)); ++j) {
                             if (j > 0) tokenStr += ", ";
@@ -1984,7 +2276,7 @@ namespace Angaraka::AI {
                     std::vector<I64> mask(m_lastTokenSequence.size(), 1);
                     std::vector<I64> shape = { 1, static_cast<I64>(mask.size()) };
 
-                    AGK_INFO("Creating attention_mask: {} elements, shape [{}, {}]",
+                    AGK_TRACE("Creating attention_mask: {} elements, shape [{}, {}]",
                         mask.size(), shape[0], shape[1]);
 
                     auto tensor = CreateValidatedInt64Tensor(mask, shape, "attention_mask");
@@ -1994,13 +2286,13 @@ namespace Angaraka::AI {
                     std::vector<F32> context = CreateFactionContextVector(request.factionId, request);
                     std::vector<I64> shape = { 1, static_cast<I64>(context.size()) };
 
-                    AGK_INFO("Creating context: {} elements, shape [{}, {}]",
+                    AGK_TRACE("Creating context: {} elements, shape [{}, {}]",
                         context.size(), shape[0], shape[1]);
 
                     inputs.push_back(AIModelResource::CreateFloatTensor(context, shape));
                 }
                 else {
-                    AGK_INFO("Creating default tensor for unknown input '{}'", inputName);
+                    AGK_TRACE("Creating default tensor for unknown input '{}'", inputName);
                     if (i < inputShapes.size() && !inputShapes[i].empty()) {
                         I64 totalSize = 1;
                         for (I64 dim : inputShapes[i]) {
@@ -2013,7 +2305,7 @@ namespace Angaraka::AI {
                 }
             }
 
-            AGK_INFO("Successfully created {} input tensors", inputs.size());
+            AGK_TRACE("Successfully created {} input tensors", inputs.size());
 
         }
         catch (const std::exception& e) {
@@ -2021,10 +2313,69 @@ namespace Angaraka::AI {
             inputs.clear();
         }
 
-        AGK_INFO("=== END DIALOGUE INPUTS DEBUG ===");
+        AGK_TRACE("=== END DIALOGUE INPUTS DEBUG ===");
         return inputs;
     }
 
+    bool AIManager::RunBoundDialogueInference(const String& prompt, const DialogueRequest& request, DialogueResponse& response,
+        DialogueTrace& trace, StageTimer& timer) {
+        if (!m_dialogueContext || !m_dialogueContext->IsValid()) {
+            return false;
+        }
+
+        std::vector<I64> tokens = TokenizePrompt(prompt);
+        trace.tokenizeMs += timer.Lap();
+        trace.promptTokens = tokens.size();
+        if (tokens.empty() || !ValidateTokenSequence(tokens)) {
+            return false;
+        }
+
+        InferenceContext& context = *m_dialogueContext;
+        auto lock = context.Lock();
+
+        // Keep the end of prompts longer than the tensors, the most recent context matters most
+        const size_t length = std::min(tokens.size(), context.GetMaxSequenceLength());
+        std::span<const I64> kept = std::span<const I64>(tokens).last(length);
+        if (!context.Prepare(length)) {
+            return false;
+        }
+
+        // Inputs are written in place; padding and unknown inputs stay zero
+        for (size_t i = 0; i < context.GetInputCount(); ++i) {
+            const String& inputName = context.GetInputName(i);
+
+            if (inputName == "input" || inputName == "input_ids" || inputName == "tokens" || inputName == "attention_mask") {
+                std::span<I64> values = context.GetInput<I64>(i);
+                if (values.size() < length) {
+                    AGK_WARN("AIManager: Dialogue input '{0}' cannot hold {1} tokens, using fresh tensors", inputName, length);
+                    return false;
+                }
+
+                if (inputName == "attention_mask") {
+                    std::fill_n(values.begin(), length, I64{ 1 });
+                }
+                else {
+                    std::copy(kept.begin(), kept.end(), values.begin());
+                }
+            }
+            else if (inputName == "context" || inputName == "context_vector") {
+                FillFactionContextVector(context.GetInput<F32>(i), request.factionId, request);
+            }
+        }
+
+        trace.inputMs += timer.Lap();
+
+        const bool ran = m_sharedDialogueModel->RunInference(context);
+        trace.inferenceMs += timer.Lap();
+        if (!ran) {
+            return false;
+        }
+
+        response = ProcessDialogueOutputs(context, request);
+        trace.decodeMs += timer.Lap();
+        return true;
+    }
+
     bool AIManager::ValidateTokenSequence(const std::vector<I64>& tokens) {
         const I64 MAX_VOCAB_SIZE = 50257;
 
@@ -2038,25 +2389,43 @@ namespace Angaraka::AI {
     }
 
     std::vector<I64> AIManager::TokenizePrompt(const String& prompt) {
-        AGK_INFO("=== TOKENIZATION DEBUG ===");
-        AGK_INFO("Input prompt: '{}'", prompt);
+        AGK_TRACE("=== TOKENIZATION DEBUG ===");
+        AGK_TRACE("Input prompt: '{}'", prompt);
 
         std::vector<I64> tokens;
 
+        if (m_sharedTokenizer && m_sharedTokenizer->CanEncode()) {
+            // Keep the end of over-long prompts, the most recent context matters most
+            const size_t MAX_PROMPT_TOKENS = 1024;
+
+            tokens = m_sharedTokenizer->Encode(prompt);
+            if (tokens.size() > MAX_PROMPT_TOKENS) {
+                AGK_WARN("Prompt encoded to {} tokens, keeping the last {}", tokens.size(), MAX_PROMPT_TOKENS);
+                tokens.erase(tokens.begin(), tokens.end() - MAX_PROMPT_TOKENS);
+            }
+
+            AGK_TRACE("Encoded prompt into {} tokens", tokens.size());
+            AGK_TRACE("=== END TOKENIZATION DEBUG ===");
+            return tokens;
+        }
+
+        // No merges available, fall back to placeholder ids in a range every model accepts
+        AGK_WARN("Shared tokenizer cannot encode, using placeholder prompt tokens");
+
         const I64 BOS_TOKEN = 1;
         const I64 EOS_TOKEN = 2;
         const I64 MIN_SAFE_TOKEN = 100;
         const I64 MAX_SAFE_TOKEN = 49999;
 
         tokens.push_back(BOS_TOKEN);
-        AGK_INFO("Added BOS token: {}", BOS_TOKEN);
+        AGK_TRACE("Added BOS token: {}", BOS_TOKEN);
 
         if (!prompt.empty()) {
             std::hash<String> hasher;
             size_t promptHash = hasher(prompt);
             size_t tokenCount = std::min(static_cast<size_t>(48), (prompt.length() + 3) / 4);
 
-            AGK_INFO("Prompt hash: {}, generating {} tokens", promptHash, tokenCount);
+            AGK_TRACE("Prompt hash: {}, generating {} tokens", promptHash, tokenCount);
 
             for (size_t i = 0; i < tokenCount; ++i) {
                 I64 tokenId = MIN_SAFE_TOKEN + ((promptHash + i * 137) % (MAX_SAFE_TOKEN - MIN_SAFE_TOKEN));
@@ -2068,17 +2437,17 @@ namespace Angaraka::AI {
                 }
 
                 tokens.push_back(tokenId);
-                AGK_INFO("Generated token[{}]: {}", i, tokenId);
+                AGK_TRACE("Generated token[{}]: {}", i, tokenId);
             }
         }
 
         tokens.push_back(EOS_TOKEN);
-        AGK_INFO("Added EOS token: {}", EOS_TOKEN);
+        AGK_TRACE("Added EOS token: {}", EOS_TOKEN);
 
         // Final validation
-        AGK_INFO("Final token sequence ({} tokens):", tokens.size());
+        AGK_TRACE("Final token sequence ({} tokens):", tokens.size());
         for (size_t i = 0; i < tokens.size(); ++i) {
-            AGK_INFO("  [{}]: {}", i, tokens[i]);
+            AGK_TRACE("  [{}]: {}", i, tokens[i]);
 
             if (tokens[i] == -2459565876494606883LL) {
                 AGK_ERROR("CRITICAL: Problematic token generated at position {}", i);
@@ -2087,12 +2456,12 @@ namespace Angaraka::AI {
             }
         }
 
-        AGK_INFO("=== END TOKENIZATION DEBUG ===");
+        AGK_TRACE("=== END TOKENIZATION DEBUG ===");
         return tokens;
     }
 
     Ort::Value AIManager::CreateValidatedInt64Tensor(const std::vector<I64>& data, const std::vector<I64>& shape, const String& tensorName) {
-        AGK_INFO("Creating validated tensor '{}'", tensorName);
+        AGK_TRACE("Creating validated tensor '{}'", tensorName);
 
         // Pre-validation
         if (data.empty()) {
@@ -2129,14 +2498,18 @@ namespace Angaraka::AI {
             throw std::runtime_error("Tensor shape mismatch");
         }
 
-        AGK_INFO("Tensor '{}' validation passed: {} elements, shape valid", tensorName, data.size());
+        AGK_TRACE("Tensor '{}' validation passed: {} elements, shape valid", tensorName, data.size());
 
         // Create tensor
         return AIModelResource::CreateInt64Tensor(data, shape);
     }
 
     void AIManager::DiagnoseInferenceInputs(const std::vector<Ort::Value>& inputs, const std::vector<String>& inputNames) {
-        AGK_INFO("=== INFERENCE INPUTS DIAGNOSTIC ===");
+        if (!AGK_TRACE_ENABLED) {
+            return;
+        }
+
+        AGK_TRACE("=== INFERENCE INPUTS DIAGNOSTIC ===");
 
         for (size_t i = 0; i < inputs.size() && i < inputNames.size(); ++i) {
             const String& name = inputNames[i];
@@ -2147,9 +2520,9 @@ namespace Angaraka::AI {
                 auto shape = info.GetShape();
                 auto elementType = info.GetElementType();
 
-                AGK_INFO("Input {}: '{}'", i, name);
-                AGK_INFO("  Type: {}", static_cast<int>(elementType));
-                AGK_INFO("  Shape: [{}]", shape.empty() ? "scalar" :
+                AGK_TRACE("Input {}: '{}'", i, name);
+                AGK_TRACE("  Type: {}", static_cast<int>(elementType));
+                AGK_TRACE("  Shape: [{}]", shape.empty() ? "scalar" :
                     std::to_string(shape[0]) + (shape.size() > 1 ? "," + std::to_string(shape[1]) : ""));
 
                 // Check tensor data if it's int64
@@ -2157,9 +2530,9 @@ namespace Angaraka::AI {
                     const I64* data = input.GetTensorData<I64>();
                     size_t elementCount = info.GetElementCount();
 
-                    AGK_INFO("  Int64 data (first 5 elements):");
+                    AGK_TRACE("  Int64 data (first 5 elements):");
                     for (size_t j = 0; j < std::min(elementCount, static_cast<size_t>(5)); ++j) {
-                        AGK_INFO("    [{}]: {}", j, data[j]);
+                        AGK_TRACE("    [{}]: {}", j, data[j]);
 
                         if (data[j] == -2459565876494606883LL) {
                             AGK_ERROR("CRITICAL: Problematic token found in tensor '{}' at position {}", name, j);
@@ -2169,7 +2542,7 @@ namespace Angaraka::AI {
             }
         }
 
-        AGK_INFO("=== END INFERENCE INPUTS DIAGNOSTIC ===");
+        AGK_TRACE("=== END INFERENCE INPUTS DIAGNOSTIC ===");
     }
 
     void AIManager::ApplyFactionPostProcessing(DialogueResponse& response, Reference<FactionConfig> config) {
@@ -2228,15 +2601,20 @@ namespace Angaraka::AI {
     }
 
     std::vector<F32> AIManager::CreateFactionContextVector(const String& factionId, const DialogueRequest& request) {
-        // Create a context vector that encodes faction characteristics
         std::vector<F32> context(512, 0.0f);
+        FillFactionContextVector(context, factionId, request);
+        return context;
+    }
 
-        // Get faction config
+    void AIManager::FillFactionContextVector(std::span<F32> context, const String& factionId, const DialogueRequest& request) {
+        // Encodes faction characteristics, slots without a value are left as they are
         auto config = GetFactionConfig(factionId);
 
         if (config) {
             // Encode dialogue context
-            context[0] = request.urgency;
+            if (!context.empty()) {
+                context[0] = request.urgency;
+            }
 
             // Encode emotional state
             size_t emotionStart = 10;
@@ -2249,8 +2627,8 @@ namespace Angaraka::AI {
             }
 
             // Fill remaining context with faction-specific patterns
+            F32 factionSeed = static_cast<F32>(std::hash<String>{}(factionId)) / static_cast<F32>(UINT64_MAX);
             for (size_t i = 50; i < context.size(); ++i) {
-                F32 factionSeed = static_cast<F32>(std::hash<String>{}(factionId)) / static_cast<F32>(UINT64_MAX);
                 context[i] = std::sin(static_cast<F32>(i) * factionSeed) * 0.1f;
             }
         }
@@ -2258,8 +2636,6 @@ namespace Angaraka::AI {
             // Default context if no config available
             std::fill(context.begin(), context.end(), 0.5f);
         }
-
-        return context;
     }
 
 } // namespace Angaraka::AI
@@ -1,20 +1,47 @@
 // Engine/Source/Systems/Angaraka.AI/Source/AI/Modules/AIModelResource.cpp
 #include <Angaraka/AIModelResource.hpp>
+#include <Angaraka/Sampler.hpp>
 #include <Angaraka/Base.hpp>
 #include <filesystem>
 #include <fstream>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <numeric>
 #include <nlohmann/json.hpp>
 
 namespace Angaraka::AI {
 
+    namespace {
+
+        I32 FindName(const std::vector<String>& names, std::initializer_list<const char*> candidates) {
+            for (const char* candidate : candidates) {
+                auto it = std::find(names.begin(), names.end(), candidate);
+                if (it != names.end()) {
+                    return static_cast<I32>(std::distance(names.begin(), it));
+                }
+            }
+            return -1;
+        }
+
+        // past_key_values.0.key -> present.0.key, past_0 -> present_0
+        String PresentNameForPast(const String& pastName) {
+            String presentName = pastName;
+            size_t pos = presentName.find("past_key_values");
+            if (pos != String::npos) {
+                return presentName.replace(pos, 15, "present");
+            }
+            pos = presentName.find("past");
+            return pos != String::npos ? presentName.replace(pos, 4, "present") : presentName;
+        }
+
+    } // namespace
+
     AIModelResource::AIModelResource(const String& id)
         : Resource(id)
     {
         AGK_INFO("AIModelResource: Created with ID '{0}'.", id);
 
-        // Initialize ONNX Runtime environment
-        m_environment = CreateScope<Ort::Env>(ORT_LOGGING_LEVEL_WARNING, "AngarakaAI");
         m_sessionOptions = CreateScope<Ort::SessionOptions>();
 
         // Configure session options for optimal performance
@@ -31,6 +58,12 @@ namespace Angaraka::AI {
         Unload();
     }
 
+    Ort::Env& AIModelResource::GetEnvironment() {
+        // Sessions share the environment's thread pools and allocators, one per process is enough
+        static Ort::Env environment(ORT_LOGGING_LEVEL_WARNING, "AngarakaAI");
+        return environment;
+    }
+
     bool AIModelResource::Load(const String& filePath, void* context) {
         AGK_INFO("AIModelResource: Loading AI model from '{0}'...", filePath);
         m_isLoaded = false; // Reset loaded state
@@ -48,16 +81,15 @@ namespace Angaraka::AI {
                 return m_isLoaded;
             }
 
-            // Convert path to wide string for ONNX Runtime
-            std::wstring wfilePath(filePath.begin(), filePath.end());
-
             auto start = std::chrono::high_resolution_clock::now();
 
             // Create ONNX Runtime session
-            m_session = std::make_unique<Ort::Session>(*m_environment, wfilePath.c_str(), *m_sessionOptions);
+            m_session = CreateSession(filePath);
+            m_decoderLayout = DecoderLayout{};
 
             auto end = std::chrono::high_resolution_clock::now();
             F32 loadTimeMs = std::chrono::duration<F32, std::milli>(end - start).count();
+            m_sessionLoadTimeMs = loadTimeMs;
 
             // Validate model inputs/outputs match metadata
             if (!ValidateModelInputsOutputs()) {
@@ -76,13 +108,17 @@ namespace Angaraka::AI {
             }
 
             // Warm up the model for optimal performance
-            if (IsSharedModel()) {
+            m_warmupTimeMs = 0.0f;
+            if (m_loadOptions.warmup) {
                 WarmupModel();
+            }
+            if (IsSharedModel()) {
                 OptimizeForSharedUsage();
             }
 
-            AGK_INFO("AIModelResource: Successfully loaded '{0}' (Type: {1}, Architecture: {2}) in {3:.2f}ms, Memory: {4}MB",
-                filePath, m_metadata.modelType, m_metadata.architecture, loadTimeMs, m_memoryUsageMB);
+            AGK_INFO("AIModelResource: Successfully loaded '{0}' (Type: {1}, Architecture: {2}) in {3:.2f}ms{4}, warmup {5:.2f}ms, Memory: {6}MB",
+                filePath, m_metadata.modelType, m_metadata.architecture, loadTimeMs,
+                m_loadedFromOptimizedCache ? " from optimized cache" : "", m_warmupTimeMs, m_memoryUsageMB);
             m_isLoaded = true;
             return m_isLoaded;
         }
@@ -99,7 +135,11 @@ namespace Angaraka::AI {
     void AIModelResource::Unload() {
         if (m_session) {
             AGK_INFO("AIModelResource: Unloading AI model '{0}'", GetId());
-            m_session.reset();
+            {
+                std::lock_guard<std::mutex> lock(m_inferenceMutex);
+                m_session.reset();
+                m_decoderLayout = DecoderLayout{};
+            }
             m_memoryUsageMB = 0;
 
             // Clear faction metrics
@@ -129,24 +169,25 @@ namespace Angaraka::AI {
         try {
             auto start = std::chrono::high_resolution_clock::now();
 
-            // Prepare input/output names
+            // Prepare input/output names, the allocated strings own the memory the pointers refer to
+            std::vector<Ort::AllocatedStringPtr> nameStorage;
             std::vector<const char*> inputNames;
             std::vector<const char*> outputNames;
 
             // Get input names from the model
             Ort::AllocatorWithDefaultOptions allocator;
             for (size_t i = 0; i < expectedInputs; ++i) {
-                auto inputName = m_session->GetInputNameAllocated(i, allocator);
-                inputNames.push_back(inputName.get());
-                AGK_TRACE("AIModelResource: Input {0}: {1}", i, inputName.get());
+                nameStorage.push_back(m_session->GetInputNameAllocated(i, allocator));
+                inputNames.push_back(nameStorage.back().get());
+                AGK_TRACE("AIModelResource: Input {0}: {1}", i, inputNames.back());
             }
 
             // Get output names from the model
             size_t outputCount = m_session->GetOutputCount();
             for (size_t i = 0; i < outputCount; ++i) {
-                auto outputName = m_session->GetOutputNameAllocated(i, allocator);
-                outputNames.push_back(outputName.get());
-                AGK_TRACE("AIModelResource: Output {0}: {1}", i, outputName.get());
+                nameStorage.push_back(m_session->GetOutputNameAllocated(i, allocator));
+                outputNames.push_back(nameStorage.back().get());
+                AGK_TRACE("AIModelResource: Output {0}: {1}", i, outputNames.back());
             }
 
             // Validate input tensors
@@ -223,6 +264,53 @@ namespace Angaraka::AI {
         }
     }
 
+    Scope<InferenceContext> AIModelResource::CreateInferenceContext(size_t maxSequenceLength) {
+        if (!m_session) {
+            AGK_ERROR("AIModelResource: Cannot create an inference context for unloaded model '{0}'", GetId());
+            return nullptr;
+        }
+
+        auto context = CreateScope<InferenceContext>(*m_session, maxSequenceLength);
+        if (!context->IsValid()) {
+            AGK_WARN("AIModelResource: Model '{0}' cannot run on preallocated tensors", GetId());
+            return nullptr;
+        }
+        return context;
+    }
+
+    bool AIModelResource::RunInference(InferenceContext& context) {
+        std::lock_guard<std::mutex> lock(m_inferenceMutex);
+
+        if (!m_session || !context.IsValid() || !context.m_active) {
+            return false;
+        }
+
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            context.Run(Ort::RunOptions{ nullptr });
+            auto end = std::chrono::high_resolution_clock::now();
+            F32 inferenceTimeMs = std::chrono::duration<F32, std::milli>(end - start).count();
+
+            UpdatePerformanceMetrics(inferenceTimeMs, m_memoryUsageMB);
+
+            if (inferenceTimeMs > m_metadata.maxInferenceTimeMs) {
+                AGK_WARN("AIModelResource: Inference time {0:.2f}ms exceeds target {1:.2f}ms for model '{2}'",
+                    inferenceTimeMs, m_metadata.maxInferenceTimeMs, GetId());
+            }
+
+            AGK_TRACE("AIModelResource: Bound inference completed in {0:.2f}ms for model '{1}' ({2} of {3} positions used)",
+                inferenceTimeMs, GetId(), context.m_sequenceLength, context.m_paddedLength);
+            return true;
+        }
+        catch (const Ort::Exception& e) {
+            // Usually an output whose shape does not follow the sequence length
+            AGK_WARN("AIModelResource: Bound inference failed for '{0}', disabling its preallocated tensors: {1}",
+                GetId(), e.what());
+            context.m_valid = false;
+            return false;
+        }
+    }
+
     std::vector<Ort::Value> AIModelResource::RunInferenceAsync(const std::vector<Ort::Value>& inputs) {
         // For now, delegate to synchronous inference
         // TODO: Implement proper async inference with thread pool
@@ -286,6 +374,413 @@ namespace Angaraka::AI {
         return outputs;
     }
 
+    // ===== AUTOREGRESSIVE GENERATION =====
+
+    GenerationBatch::RowId GenerationBatch::AddRow(std::vector<I64> promptTokens, GenerationConfig config) {
+        Row row;
+        row.id = m_nextRowId++;
+        row.sequence = std::move(promptTokens);
+        row.config = std::move(config);
+        row.sequence.reserve(row.sequence.size() + row.config.maxNewTokens);
+        row.result.tokens.reserve(row.config.maxNewTokens);
+        ++m_activeRows;
+
+        if (row.sequence.empty()) {
+            AGK_ERROR("GenerationBatch: Generation needs at least one prompt token");
+            Finish(row, Clock::now(), false);
+        }
+        else if (row.config.maxNewTokens == 0) {
+            Finish(row, Clock::now(), true);
+        }
+        else {
+            m_rows.push_back(std::move(row));
+            m_needsPrefill = true;
+        }
+
+        return m_nextRowId - 1;
+    }
+
+    std::vector<std::pair<GenerationBatch::RowId, GenerationResult>> GenerationBatch::TakeFinished() {
+        std::vector<std::pair<RowId, GenerationResult>> finished;
+        finished.swap(m_finished);
+        return finished;
+    }
+
+    void GenerationBatch::Finish(Row& row, Clock::time_point now, bool success) {
+        GenerationResult& result = row.result;
+        result.success = success;
+        result.averageProbability = row.steps > 0 ? row.probabilitySum / static_cast<F32>(row.steps) : 0.0f;
+        if (row.steps > 0) {
+            result.decodeTimeMs = std::chrono::duration<F32, std::milli>(now - row.firstStepEnd).count();
+        }
+
+        // Decode steps only, the prompt step scales with prompt length
+        if (row.steps > 1 && result.decodeTimeMs > 0.0f) {
+            result.tokensPerSecond = static_cast<F32>(row.steps - 1) * 1000.0f / result.decodeTimeMs;
+        }
+        else if (result.promptTimeMs > 0.0f) {
+            result.tokensPerSecond = static_cast<F32>(row.steps) * 1000.0f / result.promptTimeMs;
+        }
+
+        m_finished.emplace_back(row.id, std::move(result));
+        row.done = true;
+        --m_activeRows;
+    }
+
+    GenerationResult AIModelResource::Generate(std::span<const I64> promptTokens, const GenerationConfig& config) {
+        std::vector<std::vector<I64>> prompts{ std::vector<I64>(promptTokens.begin(), promptTokens.end()) };
+        std::vector<GenerationConfig> configs{ config };
+        return std::move(GenerateBatch(prompts, configs).front());
+    }
+
+    std::vector<GenerationResult> AIModelResource::GenerateBatch(const std::vector<std::vector<I64>>& prompts,
+        const std::vector<GenerationConfig>& configs) {
+
+        const size_t batchSize = prompts.size();
+        std::vector<GenerationResult> results(batchSize);
+        if (batchSize == 0) {
+            return results;
+        }
+
+        if (configs.size() != batchSize) {
+            AGK_ERROR("AIModelResource: GenerateBatch got {0} prompts but {1} configs", batchSize, configs.size());
+            return results;
+        }
+
+        GenerationBatch batch;
+        size_t promptLength = 0;
+        for (size_t b = 0; b < batchSize; ++b) {
+            batch.AddRow(prompts[b], configs[b]);
+            promptLength = std::max(promptLength, prompts[b].size());
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        while (batch.GetActiveRowCount() > 0 && StepGeneration(batch)) {
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        // Row ids of a fresh batch are the prompt indices
+        size_t generatedTokens = 0;
+        for (auto& [id, result] : batch.TakeFinished()) {
+            generatedTokens += result.tokens.size();
+            results[id] = std::move(result);
+        }
+
+        AGK_INFO("AIModelResource: Generated {0} tokens for {1} sequences with '{2}' (prompt {3} columns, {4:.2f}ms, KV cache: {5})",
+            generatedTokens, batchSize, GetId(), promptLength,
+            std::chrono::duration<F32, std::milli>(end - start).count(), results.front().usedKVCache);
+
+        return results;
+    }
+
+    bool AIModelResource::StepGeneration(GenerationBatch& batch) {
+        using Row = GenerationBatch::Row;
+        using Clock = GenerationBatch::Clock;
+
+        if (batch.m_activeRows == 0) {
+            return true;
+        }
+
+        auto failActive = [&batch]() {
+            auto now = Clock::now();
+            for (Row& row : batch.m_rows) {
+                if (!row.done) {
+                    batch.Finish(row, now, false);
+                }
+            }
+            batch.m_rows.clear();
+            batch.m_past.clear();
+            batch.m_needsPrefill = true;
+            return false;
+        };
+
+        std::lock_guard<std::mutex> lock(m_inferenceMutex);
+
+        if (!m_session) {
+            AGK_ERROR("AIModelResource: Attempted generation on unloaded model '{0}'", GetId());
+            return failActive();
+        }
+
+        const DecoderLayout& layout = ResolveDecoderLayout();
+        if (!layout.valid) {
+            AGK_ERROR("AIModelResource: Model '{0}' is not a causal language model, cannot generate", GetId());
+            return failActive();
+        }
+
+        // With the cache only the newest column is fed. A prefill feeds whole sequences: the
+        // first step, every step of a model without a cache, and the step after a row joined.
+        const bool useCache = !layout.pastToPresent.empty();
+        const bool prefill = batch.m_needsPrefill || !useCache;
+        if (prefill) {
+            // Finished rows leave, the rest are left-padded so every row ends at the same column
+            std::erase_if(batch.m_rows, [](const Row& row) { return row.done; });
+            batch.m_columns = 0;
+            for (const Row& row : batch.m_rows) {
+                batch.m_columns = std::max(batch.m_columns, row.sequence.size());
+            }
+            for (Row& row : batch.m_rows) {
+                row.padding = batch.m_columns - row.sequence.size();
+            }
+        }
+        else {
+            ++batch.m_columns;
+        }
+
+        const size_t batchSize = batch.m_rows.size();
+
+        // Left padding shifts positions, so batches need explicit position ids and a mask
+        if (batchSize > 1 && (layout.positionIdsIndex < 0 || layout.attentionMaskIndex < 0)) {
+            AGK_ERROR("AIModelResource: Model '{0}' has no position_ids/attention_mask inputs, cannot batch", GetId());
+            return failActive();
+        }
+
+        std::vector<const char*> inputNames;
+        std::vector<const char*> outputNames;
+        for (const String& name : layout.inputNames) inputNames.push_back(name.c_str());
+        for (const String& name : layout.outputNames) outputNames.push_back(name.c_str());
+
+        constexpr I64 PAD_TOKEN = 0;    // Masked out, the value is never attended to
+        const size_t columns = batch.m_columns;
+        const size_t pastLength = prefill ? 0 : columns - 1;
+        const size_t stepLength = columns - pastLength;
+
+        std::vector<I64>& stepIds = batch.m_stepIds;
+        std::vector<I64>& attentionMask = batch.m_attentionMask;
+        std::vector<I64>& positionIds = batch.m_positionIds;
+        stepIds.clear();
+        attentionMask.clear();
+        positionIds.clear();
+        for (const Row& row : batch.m_rows) {
+            if (prefill) {
+                stepIds.insert(stepIds.end(), row.padding, PAD_TOKEN);
+                stepIds.insert(stepIds.end(), row.sequence.begin(), row.sequence.end());
+            }
+            else {
+                // The token sampled last step; rows that stopped keep their column filled
+                stepIds.push_back(row.done ? PAD_TOKEN : row.sequence.back());
+            }
+            for (size_t j = 0; j < columns; ++j) {
+                attentionMask.push_back(j >= row.padding ? 1 : 0);
+            }
+            for (size_t j = pastLength; j < columns; ++j) {
+                positionIds.push_back(j >= row.padding ? static_cast<I64>(j - row.padding) : 0);
+            }
+        }
+        bool useCacheBranch = pastLength > 0;
+
+        const std::array<I64, 2> stepShape{ static_cast<I64>(batchSize), static_cast<I64>(stepLength) };
+        const std::array<I64, 2> maskShape{ static_cast<I64>(batchSize), static_cast<I64>(columns) };
+        const std::array<I64, 1> flagShape{ 1 };
+
+        Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+        Ort::AllocatorWithDefaultOptions allocator;
+        std::vector<size_t> stopped;
+        auto stepStart = Clock::now();
+
+        try {
+            if (prefill && useCache) {
+                // Nothing cached yet at this batch size
+                batch.m_past.clear();
+                for (size_t k = 0; k < layout.emptyPastShapes.size(); ++k) {
+                    std::vector<I64> shape = layout.emptyPastShapes[k];
+                    shape[layout.pastBatchAxes[k]] = static_cast<I64>(batchSize);
+                    batch.m_past.push_back(Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT));
+                }
+            }
+
+            std::vector<Ort::Value> inputs;
+            inputs.reserve(inputNames.size());
+            for (size_t i = 0; i < inputNames.size(); ++i) {
+                inputs.emplace_back(nullptr);
+            }
+
+            inputs[layout.inputIdsIndex] = Ort::Value::CreateTensor<I64>(memoryInfo,
+                stepIds.data(), stepIds.size(), stepShape.data(), stepShape.size());
+            if (layout.attentionMaskIndex >= 0) {
+                inputs[layout.attentionMaskIndex] = Ort::Value::CreateTensor<I64>(memoryInfo,
+                    attentionMask.data(), attentionMask.size(), maskShape.data(), maskShape.size());
+            }
+            if (layout.positionIdsIndex >= 0) {
+                inputs[layout.positionIdsIndex] = Ort::Value::CreateTensor<I64>(memoryInfo,
+                    positionIds.data(), positionIds.size(), stepShape.data(), stepShape.size());
+            }
+            if (layout.useCacheBranchIndex >= 0) {
+                inputs[layout.useCacheBranchIndex] = Ort::Value::CreateTensor<bool>(memoryInfo,
+                    &useCacheBranch, 1, flagShape.data(), flagShape.size());
+            }
+            for (size_t k = 0; k < batch.m_past.size(); ++k) {
+                inputs[layout.pastToPresent[k].first] = std::move(batch.m_past[k]);
+            }
+
+            auto outputs = m_session->Run(Ort::RunOptions{ nullptr },
+                inputNames.data(), inputs.data(), inputs.size(),
+                outputNames.data(), outputNames.size());
+
+            // Logits are [batch, step length, vocab], only each row's last position matters
+            const Ort::Value& logitsTensor = outputs[layout.logitsIndex];
+            auto logitsInfo = logitsTensor.GetTensorTypeAndShapeInfo();
+            const size_t vocabSize = static_cast<size_t>(logitsInfo.GetShape().back());
+            if (logitsInfo.GetElementCount() != batchSize * stepLength * vocabSize) {
+                throw std::runtime_error("unexpected logits shape");
+            }
+            const F32* logitsData = logitsTensor.GetTensorData<F32>();
+
+            for (size_t b = 0; b < batchSize; ++b) {
+                Row& row = batch.m_rows[b];
+                if (row.done) {
+                    continue;
+                }
+
+                std::span<const F32> logits(logitsData + ((b + 1) * stepLength - 1) * vocabSize, vocabSize);
+                const GenerationConfig& config = row.config;
+                GenerationResult& result = row.result;
+
+                // The sampler already normalized over its candidates, so no full vocabulary pass here.
+                // Greedy picks are certain.
+                SampledToken sampled = config.sampler ? config.sampler(logits, row.sequence) : SampledToken{ LogitsSampler::ArgMax(logits), 0.0f };
+                const I64 token = sampled.id;
+                row.probabilitySum += std::exp(sampled.logProbability);
+                ++row.steps;
+                result.usedKVCache = useCache;
+
+                if (std::find(config.stopTokens.begin(), config.stopTokens.end(), token) != config.stopTokens.end()) {
+                    result.stoppedOnToken = true;
+                    stopped.push_back(b);
+                }
+                else {
+                    row.sequence.push_back(token);
+                    result.tokens.push_back(token);
+                    if (result.tokens.size() >= config.maxNewTokens || (config.onToken && !config.onToken(token))) {
+                        stopped.push_back(b);
+                    }
+                }
+            }
+
+            for (size_t k = 0; k < batch.m_past.size(); ++k) {
+                batch.m_past[k] = std::move(outputs[layout.pastToPresent[k].second]);
+            }
+        }
+        catch (const Ort::Exception& e) {
+            AGK_ERROR("AIModelResource: Generation failed for '{0}' (batch {1}): {2}", GetId(), batchSize, e.what());
+            return failActive();
+        }
+        catch (const std::exception& e) {
+            AGK_ERROR("AIModelResource: Generation failed for '{0}' (batch {1}): {2}", GetId(), batchSize, e.what());
+            return failActive();
+        }
+
+        batch.m_needsPrefill = false;
+
+        auto stepEnd = Clock::now();
+        const F32 stepMs = std::chrono::duration<F32, std::milli>(stepEnd - stepStart).count();
+        for (Row& row : batch.m_rows) {
+            if (!row.done && row.steps == 1) {
+                row.result.promptTimeMs = stepMs;
+                row.firstStepEnd = stepEnd;
+            }
+        }
+        for (size_t b : stopped) {
+            batch.Finish(batch.m_rows[b], stepEnd, true);
+        }
+
+        UpdatePerformanceMetrics(stepMs, m_memoryUsageMB);
+        return true;
+    }
+
+    bool AIModelResource::SupportsGeneration() {
+        std::lock_guard<std::mutex> lock(m_inferenceMutex);
+        return m_session && ResolveDecoderLayout().valid;
+    }
+
+    bool AIModelResource::SupportsBatchedGeneration() {
+        std::lock_guard<std::mutex> lock(m_inferenceMutex);
+        return m_session && ResolveDecoderLayout().valid
+            && m_decoderLayout.positionIdsIndex >= 0 && m_decoderLayout.attentionMaskIndex >= 0;
+    }
+
+    bool AIModelResource::SupportsKVCache() {
+        std::lock_guard<std::mutex> lock(m_inferenceMutex);
+        return m_session && ResolveDecoderLayout().valid && !m_decoderLayout.pastToPresent.empty();
+    }
+
+    const AIModelResource::DecoderLayout& AIModelResource::ResolveDecoderLayout() {
+        // NOTE: Called with m_inferenceMutex held
+        DecoderLayout& layout = m_decoderLayout;
+        if (layout.resolved || !m_session) {
+            return layout;
+        }
+
+        layout = DecoderLayout{};
+        layout.resolved = true;
+
+        try {
+            Ort::AllocatorWithDefaultOptions allocator;
+            for (size_t i = 0; i < m_session->GetInputCount(); ++i) {
+                layout.inputNames.emplace_back(m_session->GetInputNameAllocated(i, allocator).get());
+            }
+            for (size_t i = 0; i < m_session->GetOutputCount(); ++i) {
+                layout.outputNames.emplace_back(m_session->GetOutputNameAllocated(i, allocator).get());
+            }
+
+            layout.inputIdsIndex = FindName(layout.inputNames, { "input_ids", "input", "tokens" });
+            layout.attentionMaskIndex = FindName(layout.inputNames, { "attention_mask" });
+            layout.positionIdsIndex = FindName(layout.inputNames, { "position_ids" });
+            layout.useCacheBranchIndex = FindName(layout.inputNames, { "use_cache_branch" });
+            layout.logitsIndex = FindName(layout.outputNames, { "logits", "output" });
+
+            size_t boundInputs = 0;
+            for (I32 index : { layout.inputIdsIndex, layout.attentionMaskIndex, layout.positionIdsIndex, layout.useCacheBranchIndex }) {
+                boundInputs += index >= 0 ? 1 : 0;
+            }
+
+            for (size_t i = 0; i < layout.inputNames.size(); ++i) {
+                const String& name = layout.inputNames[i];
+                if (name.rfind("past", 0) != 0) {
+                    continue;
+                }
+
+                I32 presentIndex = FindName(layout.outputNames, { PresentNameForPast(name).c_str() });
+                auto tensorInfo = m_session->GetInputTypeInfo(i).GetTensorTypeAndShapeInfo();
+                if (presentIndex < 0 || tensorInfo.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+                    AGK_WARN("AIModelResource: Cache input '{0}' of '{1}' has no matching float present output", name, GetId());
+                    return layout;
+                }
+
+                // First dynamic dimension is the batch, the remaining dynamic one the past length
+                std::vector<I64> shape = tensorInfo.GetShape();
+                size_t batchAxis = shape.size();
+                for (size_t axis = 0; axis < shape.size(); ++axis) {
+                    if (shape[axis] < 0) {
+                        shape[axis] = batchAxis == shape.size() ? 1 : 0;
+                        batchAxis = std::min(batchAxis, axis);
+                    }
+                }
+                if (batchAxis == shape.size()) {
+                    AGK_WARN("AIModelResource: Cache input '{0}' of '{1}' has a static shape", name, GetId());
+                    return layout;
+                }
+
+                layout.pastToPresent.emplace_back(i, static_cast<size_t>(presentIndex));
+                layout.pastBatchAxes.push_back(batchAxis);
+                layout.emptyPastShapes.push_back(std::move(shape));
+                ++boundInputs;
+            }
+
+            // Every input must be one we know how to fill
+            layout.valid = layout.inputIdsIndex >= 0 && layout.logitsIndex >= 0 && boundInputs == layout.inputNames.size();
+        }
+        catch (const Ort::Exception& e) {
+            AGK_ERROR("AIModelResource: Failed to inspect decoder layout of '{0}': {1}", GetId(), e.what());
+            layout.valid = false;
+        }
+
+        if (layout.valid) {
+            AGK_INFO("AIModelResource: Model '{0}' supports generation ({1} cache tensors)", GetId(), layout.pastToPresent.size());
+        }
+
+        return layout;
+    }
+
     // NEW: Check if model supports a specific faction
     bool AIModelResource::SupportsFaction(const String& factionId) const {
         if (m_metadata.supportedFactions.empty()) {
@@ -490,46 +985,30 @@ namespace Angaraka::AI {
 
             auto start = std::chrono::high_resolution_clock::now();
 
-            // Create dummy inputs based on expected shapes
-            auto inputShapes = GetInputShapes();
-            std::vector<Ort::Value> dummyInputs;
-
-            for (size_t i = 0; i < inputShapes.size(); ++i) {
-                const auto& shape = inputShapes[i];
-
-                if (shape.empty()) {
-                    AGK_WARN("AIModelResource: Skipping warmup for input {0} with unknown shape", i);
-                    continue;
-                }
-
-                // Calculate total elements
-                I64 totalElements = 1;
-                for (I64 dim : shape) {
-                    if (dim > 0) totalElements *= dim;
-                    else totalElements *= 1; // Handle dynamic dimensions
-                }
-
-                // Create dummy data (assume F32 tensors for warmup)
-                std::vector<F32> dummyData(totalElements, 0.0f);
-                auto tensor = CreateFloatTensor(dummyData, shape);
-                dummyInputs.push_back(std::move(tensor));
+            // The first run allocates and plans the graph, do it with inputs shaped like a request
+            bool warmed = false;
+            if (SupportsGeneration()) {
+                GenerationConfig config;
+                config.maxNewTokens = 2;            // Prompt step and one decode step, with the KV cache if there is one
+                const I64 prompt[] = { 0 };
+                warmed = Generate(prompt, config).success;
+            }
+            else {
+                // Zeroed inputs of every element type, dynamic axes resolved to a single position
+                InferenceContext context(*m_session, 1);
+                warmed = context.Prepare(1) && RunInference(context);
             }
 
-            if (!dummyInputs.empty()) {
-                // Run a dummy inference to warm up the model
-                auto outputs = RunInference(dummyInputs);
-
-                auto end = std::chrono::high_resolution_clock::now();
-                F32 warmupTimeMs = std::chrono::duration<F32, std::milli>(end - start).count();
+            auto end = std::chrono::high_resolution_clock::now();
+            m_warmupTimeMs = std::chrono::duration<F32, std::milli>(end - start).count();
 
-                AGK_INFO("AIModelResource: Model warmup completed in {0:.2f}ms", warmupTimeMs);
-                return true;
-            }
-            else {
-                AGK_WARN("AIModelResource: Could not create dummy inputs for warmup");
+            if (!warmed) {
+                AGK_WARN("AIModelResource: Could not warm up model '{0}', the first request pays for graph setup", GetId());
                 return false;
             }
 
+            AGK_INFO("AIModelResource: Model warmup completed in {0:.2f}ms", m_warmupTimeMs);
+            return true;
         }
         catch (const std::exception& e) {
             AGK_ERROR("AIModelResource: Model warmup failed: {0}", e.what());
@@ -569,6 +1048,48 @@ namespace Angaraka::AI {
 
     // ===== HELPER METHODS =====
 
+    Scope<Ort::Session> AIModelResource::CreateSession(const String& filePath) {
+        // ONNX Runtime takes wide paths on Windows
+        const std::filesystem::path modelPath(filePath);
+        const std::filesystem::path optimizedPath = std::filesystem::path(modelPath).replace_extension(".optimized.onnx");
+        const std::wstring modelFile = modelPath.wstring();
+        const std::wstring optimizedFile = optimizedPath.wstring();
+        m_loadedFromOptimizedCache = false;
+
+        if (m_loadOptions.cacheOptimizedModel) {
+            // Only trusted while it is newer than the model it was made from
+            std::error_code error;
+            auto optimizedTime = std::filesystem::last_write_time(optimizedPath, error);
+            bool fresh = !error && optimizedTime >= std::filesystem::last_write_time(modelPath, error) && !error;
+
+            if (fresh) {
+                try {
+                    // The graph was optimized when the cache was written
+                    Ort::SessionOptions options = m_sessionOptions->Clone();
+                    options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_DISABLE_ALL);
+                    auto session = CreateScope<Ort::Session>(GetEnvironment(), optimizedFile.c_str(), options);
+                    m_loadedFromOptimizedCache = true;
+                    return session;
+                }
+                catch (const Ort::Exception& e) {
+                    AGK_WARN("AIModelResource: Ignoring optimized model cache '{0}': {1}", optimizedPath.string(), e.what());
+                }
+            }
+
+            try {
+                Ort::SessionOptions options = m_sessionOptions->Clone();
+                options.SetOptimizedModelFilePath(optimizedFile.c_str());
+                return CreateScope<Ort::Session>(GetEnvironment(), modelFile.c_str(), options);
+            }
+            catch (const Ort::Exception& e) {
+                // Execution providers that compile graph partitions cannot serialize the result
+                AGK_WARN("AIModelResource: Cannot cache the optimized graph of '{0}', loading without: {1}", filePath, e.what());
+            }
+        }
+
+        return CreateScope<Ort::Session>(GetEnvironment(), modelFile.c_str(), *m_sessionOptions);
+    }
+
     bool AIModelResource::LoadMetadata(const String& metadataPath) {
         try {
             if (!std::filesystem::exists(metadataPath)) {
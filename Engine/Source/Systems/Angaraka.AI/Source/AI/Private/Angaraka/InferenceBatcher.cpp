@@ -0,0 +1,323 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Private/Angaraka/InferenceBatcher.cpp
+#include <Angaraka/InferenceBatcher.hpp>
+#include <algorithm>
+
+namespace Angaraka::AI {
+
+    InferenceBatcher::InferenceBatcher(Reference<AIModelResource> model, const InferenceBatcherSettings& settings)
+        : m_model(std::move(model))
+        , m_settings(settings)
+    {
+        m_settings.maxBatchSize = std::max<size_t>(m_settings.maxBatchSize, 1);
+        m_settings.maxQueueDepth = std::max<size_t>(m_settings.maxQueueDepth, 1);
+
+        // Resolved once here, asking during a step would wait on the running session
+        m_canBatch = m_model->SupportsBatchedGeneration();
+        m_usesKVCache = m_model->SupportsKVCache();
+    }
+
+    InferenceBatcher::~InferenceBatcher() {
+        Stop();
+    }
+
+    bool InferenceBatcher::Submit(std::vector<I64> promptTokens, GenerationConfig config, Completion completion,
+        const GenerationSchedule& schedule, DropCallback drop) {
+
+        std::vector<PendingRequest> expired;
+        std::vector<PendingRequest> rejected;
+        bool accepted = true;
+        bool stopping = false;
+        bool scheduleStep = false;
+        size_t queueDepth = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            queueDepth = m_settings.maxQueueDepth;
+            PendingRequest request{ std::move(promptTokens), std::move(config), std::move(completion), std::move(drop),
+                schedule, Clock::now(), m_nextSequence++ };
+            stopping = m_stopping;
+
+            if (!stopping && m_waiting.size() >= m_settings.maxQueueDepth) {
+                CollectExpired(request.submitTime, expired);
+                m_stats.expired += expired.size();
+            }
+
+            if (stopping) {
+                accepted = false;
+            }
+            else if (m_waiting.size() >= m_settings.maxQueueDepth) {
+                // Evict the request that would be admitted last if the new one outranks it
+                auto last = std::max_element(m_waiting.begin(), m_waiting.end(), RunsBefore);
+                if (last->schedule.priority > request.schedule.priority) {
+                    rejected.push_back(std::move(*last));
+                    m_waiting.erase(last);
+                    ++m_stats.evicted;
+                }
+                else {
+                    accepted = false;
+                    ++m_stats.rejected;
+                }
+            }
+
+            if (accepted) {
+                m_waiting.push_back(std::move(request));
+                scheduleStep = !m_stepScheduled;
+                m_stepScheduled = true;
+            }
+            else {
+                rejected.push_back(std::move(request));
+            }
+        }
+
+        if (stopping) {
+            AGK_WARN("InferenceBatcher: Request submitted after stop, failing it");
+        }
+        else if (!rejected.empty()) {
+            AGK_WARN("InferenceBatcher: Queue full ({0} waiting), dropped a request for '{1}'",
+                queueDepth, rejected.front().schedule.ownerId);
+        }
+
+        Drop(expired, InferenceDropReason::Expired);
+        Drop(rejected, stopping ? InferenceDropReason::Cancelled : InferenceDropReason::QueueFull);
+
+        // Outside the lock, the job runs inline when the JobSystem is shut down
+        if (scheduleStep) {
+            SubmitStep();
+        }
+        return accepted;
+    }
+
+    std::future<GenerationResult> InferenceBatcher::Submit(std::vector<I64> promptTokens, GenerationConfig config,
+        const GenerationSchedule& schedule) {
+
+        auto promise = CreateReference<std::promise<GenerationResult>>();
+        auto future = promise->get_future();
+        Submit(std::move(promptTokens), std::move(config), [promise](GenerationResult&& result) {
+            promise->set_value(std::move(result));
+        }, schedule);
+        return future;
+    }
+
+    size_t InferenceBatcher::CancelForOwner(const String& ownerId) {
+        if (ownerId.empty()) {
+            return 0;
+        }
+
+        std::vector<PendingRequest> cancelled;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto owned = std::stable_partition(m_waiting.begin(), m_waiting.end(), [&ownerId](const PendingRequest& request) {
+                return request.schedule.ownerId != ownerId;
+            });
+            cancelled.assign(std::make_move_iterator(owned), std::make_move_iterator(m_waiting.end()));
+            m_waiting.erase(owned, m_waiting.end());
+            m_stats.cancelled += cancelled.size();
+        }
+
+        const size_t count = cancelled.size();
+        Drop(cancelled, InferenceDropReason::Cancelled);
+        return count;
+    }
+
+    void InferenceBatcher::Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+
+        // Steps keep resubmitting until the queue is drained
+        Core::JobSystem::Get().Wait(m_jobs);
+    }
+
+    void InferenceBatcher::SetSettings(const InferenceBatcherSettings& settings) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_settings = settings;
+        m_settings.maxBatchSize = std::max<size_t>(m_settings.maxBatchSize, 1);
+        m_settings.maxQueueDepth = std::max<size_t>(m_settings.maxQueueDepth, 1);
+    }
+
+    InferenceBatcherSettings InferenceBatcher::GetSettings() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_settings;
+    }
+
+    InferenceBatcherStats InferenceBatcher::GetStats() const {
+        InferenceBatcherStats stats;
+        std::vector<F32> latencies;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            stats = m_stats;
+            if (stats.steps > 0) {
+                stats.averageBatchSize = static_cast<F32>(m_rowSteps) / static_cast<F32>(stats.steps);
+            }
+            latencies.assign(m_latencies.begin(), m_latencies.begin() + std::min(m_latencyCount, LATENCY_WINDOW));
+        }
+
+        auto percentile = [&latencies](F32 fraction) {
+            auto nth = latencies.begin() + static_cast<size_t>(fraction * static_cast<F32>(latencies.size() - 1));
+            std::nth_element(latencies.begin(), nth, latencies.end());
+            return *nth;
+        };
+        if (!latencies.empty()) {
+            stats.p50LatencyMs = percentile(0.50f);
+            stats.p99LatencyMs = percentile(0.99f);
+        }
+
+        return stats;
+    }
+
+    size_t InferenceBatcher::GetQueuedCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_waiting.size();
+    }
+
+    void InferenceBatcher::SubmitStep() {
+        Core::JobSystem::Get().Submit([this]() { StepJob(); }, Core::JobPriority::Normal, m_jobs);
+    }
+
+    void InferenceBatcher::StepJob() {
+        // One step per job, so other inference work interleaves with a long generation. Once the
+        // JobSystem is shut down a submitted step would run inline here, so loop instead.
+        bool more = RunStep();
+        while (more && !Core::JobSystem::Get().IsRunning()) {
+            more = RunStep();
+        }
+        if (more) {
+            SubmitStep();
+        }
+    }
+
+    bool InferenceBatcher::RunStep() {
+        std::vector<PendingRequest> expired;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        Admit(Clock::now(), expired);
+        const size_t activeRows = m_batch.GetActiveRowCount();
+        lock.unlock();
+
+        Drop(expired, InferenceDropReason::Expired);
+
+        if (activeRows > 0) {
+            m_model->StepGeneration(m_batch);
+        }
+
+        std::vector<std::pair<Completion, GenerationResult>> completed;
+        lock.lock();
+
+        // Recorded before the completions run, so a caller woken by one sees its request counted
+        auto now = Clock::now();
+        for (auto& [row, result] : m_batch.TakeFinished()) {
+            auto running = std::find_if(m_running.begin(), m_running.end(),
+                [row](const RunningRequest& request) { return request.row == row; });
+            if (running == m_running.end()) {
+                continue;
+            }
+
+            m_latencies[m_latencyCount++ % LATENCY_WINDOW] = std::chrono::duration<F32, std::milli>(now - running->submitTime).count();
+            ++m_stats.requests;
+            completed.emplace_back(std::move(running->completion), std::move(result));
+            m_running.erase(running);
+        }
+        if (activeRows > 0) {
+            ++m_stats.steps;
+            m_rowSteps += activeRows;
+        }
+
+        // Keep the count bounded while preserving the ring position
+        if (m_latencyCount >= 2 * LATENCY_WINDOW) {
+            m_latencyCount -= LATENCY_WINDOW;
+        }
+
+        const bool more = m_batch.GetActiveRowCount() > 0 || !m_waiting.empty();
+        if (!more) {
+            m_stepScheduled = false;
+            m_batch = GenerationBatch{};    // Frees the cache of the last step
+        }
+        lock.unlock();
+
+        for (auto& [completion, result] : completed) {
+            try {
+                completion(std::move(result));
+            }
+            catch (const std::exception& e) {
+                AGK_ERROR("InferenceBatcher: Completion threw: {0}", e.what());
+            }
+            catch (...) {
+                AGK_ERROR("InferenceBatcher: Completion threw an unknown exception");
+            }
+        }
+
+        return more;
+    }
+
+    bool InferenceBatcher::RunsBefore(const PendingRequest& a, const PendingRequest& b) {
+        if (a.schedule.priority != b.schedule.priority) {
+            return a.schedule.priority < b.schedule.priority;
+        }
+        if (a.schedule.deadline != b.schedule.deadline) {
+            return a.schedule.deadline < b.schedule.deadline;
+        }
+        return a.sequence < b.sequence;
+    }
+
+    void InferenceBatcher::CollectExpired(Clock::time_point now, std::vector<PendingRequest>& dropped) {
+        auto expired = std::stable_partition(m_waiting.begin(), m_waiting.end(), [now](const PendingRequest& request) {
+            return request.schedule.deadline > now;
+        });
+        dropped.insert(dropped.end(), std::make_move_iterator(expired), std::make_move_iterator(m_waiting.end()));
+        m_waiting.erase(expired, m_waiting.end());
+    }
+
+    void InferenceBatcher::Admit(Clock::time_point now, std::vector<PendingRequest>& expired) {
+        CollectExpired(now, expired);
+        m_stats.expired += expired.size();
+
+        const size_t capacity = m_canBatch ? m_settings.maxBatchSize : 1;
+        const size_t activeRows = m_batch.GetActiveRowCount();
+        if (m_waiting.empty() || activeRows >= capacity) {
+            return;
+        }
+
+        // Joining a KV cache batch costs every running request a full pass over its sequence,
+        // so wait for enough requests to fill the batch or for the oldest to run out of patience
+        if (activeRows > 0 && m_usesKVCache && !m_stopping) {
+            auto maxWait = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<F32, std::milli>(m_settings.maxWaitMs));
+            auto oldest = std::min_element(m_waiting.begin(), m_waiting.end(), [](const PendingRequest& a, const PendingRequest& b) {
+                return a.sequence < b.sequence;
+            });
+            if (m_waiting.size() < capacity - activeRows && now - oldest->submitTime < maxWait) {
+                return;
+            }
+        }
+
+        // Requests that finish on admission (empty prompt, no new tokens) do not take a row
+        while (!m_waiting.empty() && m_batch.GetActiveRowCount() < capacity) {
+            auto next = std::min_element(m_waiting.begin(), m_waiting.end(), RunsBefore);
+            PendingRequest request = std::move(*next);
+            m_waiting.erase(next);
+
+            GenerationBatch::RowId row = m_batch.AddRow(std::move(request.promptTokens), std::move(request.config));
+            m_running.push_back({ row, std::move(request.completion), request.submitTime });
+        }
+    }
+
+    void InferenceBatcher::Drop(std::vector<PendingRequest>& requests, InferenceDropReason reason) {
+        for (PendingRequest& request : requests) {
+            // A throwing callback must not skip the others
+            try {
+                if (request.drop) {
+                    request.drop(reason);
+                }
+                else if (request.completion) {
+                    request.completion(GenerationResult{});
+                }
+            }
+            catch (const std::exception& e) {
+                AGK_ERROR("InferenceBatcher: Drop callback for '{0}' threw: {1}", request.schedule.ownerId, e.what());
+            }
+            catch (...) {
+                AGK_ERROR("InferenceBatcher: Drop callback for '{0}' threw an unknown exception", request.schedule.ownerId);
+            }
+        }
+        requests.clear();
+    }
+
+} // namespace Angaraka::AI
@@ -0,0 +1,219 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Private/Angaraka/InferenceContext.cpp
+#include <Angaraka/InferenceContext.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace Angaraka::AI {
+
+    namespace {
+
+        constexpr size_t MIN_BUCKET_LENGTH = 16;
+        constexpr size_t ARENA_ALIGNMENT = 64;      // Every tensor starts on its own cache line
+
+        size_t ElementSize(ONNXTensorElementDataType type) {
+            switch (type) {
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+                return 4;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+                return 8;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+                return 2;
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+            case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+                return 1;
+            default:
+                return 0;   // Strings and anything else ORT has to allocate itself
+            }
+        }
+
+        size_t AlignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+    } // anonymous namespace
+
+    InferenceContext::InferenceContext(Ort::Session& session, size_t maxSequenceLength)
+        : m_session(session)
+        , m_memoryInfo(Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault))
+        , m_maxSequenceLength(std::max<size_t>(maxSequenceLength, 1))
+    {
+        try {
+            Ort::AllocatorWithDefaultOptions allocator;
+
+            m_inputs.resize(session.GetInputCount());
+            for (size_t i = 0; i < m_inputs.size(); ++i) {
+                m_inputs[i].name = session.GetInputNameAllocated(i, allocator).get();
+                if (!DescribeTensor(m_inputs[i], session.GetInputTypeInfo(i))) {
+                    return;
+                }
+            }
+
+            m_outputs.resize(session.GetOutputCount());
+            for (size_t i = 0; i < m_outputs.size(); ++i) {
+                m_outputs[i].name = session.GetOutputNameAllocated(i, allocator).get();
+                if (!DescribeTensor(m_outputs[i], session.GetOutputTypeInfo(i))) {
+                    return;
+                }
+            }
+        }
+        catch (const Ort::Exception& e) {
+            AGK_WARN("InferenceContext: Cannot describe model tensors: {0}", e.what());
+            return;
+        }
+
+        // One allocation for everything, sized for the longest bucket
+        size_t bytes = 0;
+        for (std::vector<Tensor>* tensors : { &m_inputs, &m_outputs }) {
+            for (Tensor& tensor : *tensors) {
+                tensor.offset = bytes;
+                bytes += AlignUp(tensor.elementCount * tensor.elementSize, ARENA_ALIGNMENT);
+            }
+        }
+
+        m_arena = std::make_unique<std::byte[]>(bytes);
+        m_arenaBytes = bytes;
+        m_bindings.resize(BucketIndex(m_maxSequenceLength) + 1);
+        m_valid = true;
+
+        AGK_INFO("InferenceContext: {0} inputs, {1} outputs, {2}KB arena for up to {3} positions",
+            m_inputs.size(), m_outputs.size(), m_arenaBytes / 1024, m_maxSequenceLength);
+    }
+
+    InferenceContext::~InferenceContext() = default;
+
+    bool InferenceContext::Prepare(size_t sequenceLength) {
+        if (!m_valid || sequenceLength == 0 || sequenceLength > m_maxSequenceLength) {
+            return false;
+        }
+
+        const size_t bucket = BucketIndex(sequenceLength);
+        if (!m_bindings[bucket]) {
+            m_bindings[bucket] = CreateBinding(BucketLength(bucket));
+            if (!m_bindings[bucket]) {
+                m_valid = false;
+                return false;
+            }
+        }
+
+        m_active = m_bindings[bucket].get();
+        m_sequenceLength = sequenceLength;
+        m_paddedLength = BucketLength(bucket);
+
+        for (Tensor& tensor : m_inputs) {
+            Resize(tensor, m_paddedLength, sequenceLength);
+            std::memset(m_arena.get() + tensor.offset, 0, tensor.elementCount * tensor.elementSize);
+        }
+        for (Tensor& tensor : m_outputs) {
+            Resize(tensor, m_paddedLength, sequenceLength);
+        }
+        return true;
+    }
+
+    bool InferenceContext::DescribeTensor(Tensor& tensor, const Ort::TypeInfo& typeInfo) {
+        auto info = typeInfo.GetTensorTypeAndShapeInfo();
+        tensor.type = info.GetElementType();
+        tensor.elementSize = ElementSize(tensor.type);
+        if (tensor.elementSize == 0) {
+            AGK_WARN("InferenceContext: Tensor '{0}' has element type {1}, which cannot be preallocated",
+                tensor.name, static_cast<int>(tensor.type));
+            return false;
+        }
+
+        tensor.maxShape = info.GetShape();
+        for (size_t axis = 0; axis < tensor.maxShape.size(); ++axis) {
+            if (tensor.maxShape[axis] > 0) {
+                continue;
+            }
+            if (axis == 0) {
+                tensor.maxShape[axis] = 1;
+                continue;
+            }
+            if (tensor.sequenceAxis >= 0) {
+                AGK_WARN("InferenceContext: Tensor '{0}' has more than one dynamic axis besides the batch", tensor.name);
+                return false;
+            }
+            tensor.sequenceAxis = static_cast<I32>(axis);
+            tensor.maxShape[axis] = static_cast<I64>(m_maxSequenceLength);
+        }
+
+        // The valid positions are a prefix of the buffer when only batch 1 comes before them
+        tensor.trimmable = tensor.sequenceAxis >= 0 && std::all_of(tensor.maxShape.begin(),
+            tensor.maxShape.begin() + tensor.sequenceAxis, [](I64 dim) { return dim == 1; });
+
+        tensor.validShape = tensor.maxShape;
+        Resize(tensor, m_maxSequenceLength, m_maxSequenceLength);
+        return true;
+    }
+
+    void InferenceContext::Resize(Tensor& tensor, size_t length, size_t validLength) const {
+        size_t elementCount = 1;
+        for (size_t axis = 0; axis < tensor.maxShape.size(); ++axis) {
+            const bool sequence = static_cast<I32>(axis) == tensor.sequenceAxis;
+            const I64 dim = sequence ? static_cast<I64>(length) : tensor.maxShape[axis];
+            tensor.validShape[axis] = sequence && tensor.trimmable ? static_cast<I64>(validLength) : dim;
+            elementCount *= static_cast<size_t>(dim);
+        }
+
+        tensor.elementCount = elementCount;
+        tensor.validCount = tensor.trimmable ? elementCount / length * validLength : elementCount;
+    }
+
+    size_t InferenceContext::BucketIndex(size_t length) const {
+        size_t bucket = 0;
+        while (BucketLength(bucket) < length) {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+    size_t InferenceContext::BucketLength(size_t bucket) const {
+        return std::min(MIN_BUCKET_LENGTH << bucket, m_maxSequenceLength);
+    }
+
+    Scope<InferenceContext::Binding> InferenceContext::CreateBinding(size_t length) {
+        auto binding = CreateScope<Binding>(m_session);
+        try {
+            std::vector<I64> shape;
+            for (std::vector<Tensor>* tensors : { &m_inputs, &m_outputs }) {
+                const bool input = tensors == &m_inputs;
+                for (Tensor& tensor : *tensors) {
+                    shape = tensor.maxShape;
+                    if (tensor.sequenceAxis >= 0) {
+                        shape[tensor.sequenceAxis] = static_cast<I64>(length);
+                    }
+
+                    size_t elementCount = 1;
+                    for (I64 dim : shape) {
+                        elementCount *= static_cast<size_t>(dim);
+                    }
+
+                    Ort::Value value = Ort::Value::CreateTensor(m_memoryInfo, m_arena.get() + tensor.offset,
+                        elementCount * tensor.elementSize, shape.data(), shape.size(), tensor.type);
+                    if (input) {
+                        binding->binding.BindInput(tensor.name.c_str(), value);
+                    }
+                    else {
+                        binding->binding.BindOutput(tensor.name.c_str(), value);
+                    }
+                    binding->values.push_back(std::move(value));
+                }
+            }
+        }
+        catch (const Ort::Exception& e) {
+            AGK_ERROR("InferenceContext: Failed to bind tensors for length {0}: {1}", length, e.what());
+            return nullptr;
+        }
+
+        AGK_DEBUG("InferenceContext: Bound tensors for length bucket {0}", length);
+        return binding;
+    }
+
+    void InferenceContext::Run(const Ort::RunOptions& options) {
+        m_session.Run(options, m_active->binding);
+    }
+
+} // namespace Angaraka::AI
@@ -0,0 +1,230 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Private/Angaraka/InferenceQueue.cpp
+#include <Angaraka/InferenceQueue.hpp>
+#include <algorithm>
+
+namespace Angaraka::AI {
+
+    InferenceQueue::InferenceQueue(const InferenceQueueSettings& settings)
+        : m_settings(settings)
+    {
+        m_settings.maxConcurrent = std::max<size_t>(m_settings.maxConcurrent, 1);
+        m_settings.maxQueueDepth = std::max<size_t>(m_settings.maxQueueDepth, 1);
+
+        // At least one slot has to stay open to lower priority work
+        m_settings.reservedConversationSlots = std::min(m_settings.reservedConversationSlots, m_settings.maxConcurrent - 1);
+    }
+
+    InferenceQueue::~InferenceQueue() {
+        Shutdown();
+    }
+
+    bool InferenceQueue::Submit(InferenceTask task) {
+        std::vector<Entry> expired;
+        std::vector<Entry> rejected;
+        bool accepted = true;
+        bool shutdown = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Entry entry{ std::move(task), m_nextSequence++ };
+            shutdown = m_shutdown;
+
+            if (!shutdown && m_waiting.size() >= m_settings.maxQueueDepth) {
+                CollectExpired(expired);
+                m_stats.expired += expired.size();
+            }
+
+            if (shutdown) {
+                accepted = false;
+            }
+            else if (m_waiting.size() >= m_settings.maxQueueDepth) {
+                // Evict the request that would run last if the new one outranks it
+                auto last = std::max_element(m_waiting.begin(), m_waiting.end(), RunsBefore);
+                if (last->task.priority > entry.task.priority) {
+                    rejected.push_back(std::move(*last));
+                    m_waiting.erase(last);
+                    ++m_stats.evicted;
+                }
+                else {
+                    accepted = false;
+                    ++m_stats.rejected;
+                }
+            }
+
+            if (accepted) {
+                m_waiting.push_back(std::move(entry));
+                Dispatch();
+            }
+            else {
+                rejected.push_back(std::move(entry));
+            }
+        }
+
+        if (!rejected.empty() && !shutdown) {
+            AGK_WARN("InferenceQueue: Queue full ({0} waiting), dropped a request for '{1}'",
+                m_settings.maxQueueDepth, rejected.front().task.ownerId);
+        }
+
+        Drop(expired, InferenceDropReason::Expired);
+        Drop(rejected, shutdown ? InferenceDropReason::Cancelled : InferenceDropReason::QueueFull);
+        return accepted;
+    }
+
+    size_t InferenceQueue::CancelForOwner(const String& ownerId) {
+        if (ownerId.empty()) {
+            return 0;
+        }
+
+        std::vector<Entry> cancelled;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto owned = std::stable_partition(m_waiting.begin(), m_waiting.end(), [&ownerId](const Entry& entry) {
+                return entry.task.ownerId != ownerId;
+            });
+            cancelled.assign(std::make_move_iterator(owned), std::make_move_iterator(m_waiting.end()));
+            m_waiting.erase(owned, m_waiting.end());
+            m_stats.cancelled += cancelled.size();
+        }
+
+        const size_t count = cancelled.size();
+        Drop(cancelled, InferenceDropReason::Cancelled);
+        return count;
+    }
+
+    void InferenceQueue::Shutdown() {
+        std::vector<Entry> cancelled;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+            cancelled.swap(m_waiting);
+            m_stats.cancelled += cancelled.size();
+        }
+
+        Drop(cancelled, InferenceDropReason::Cancelled);
+        Core::JobSystem::Get().Wait(m_jobs);
+    }
+
+    bool InferenceQueue::IsSaturated() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_waiting.size() >= m_settings.maxQueueDepth;
+    }
+
+    InferenceQueueStats InferenceQueue::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        InferenceQueueStats stats = m_stats;
+        stats.queued = m_waiting.size();
+        stats.running = m_running;
+        return stats;
+    }
+
+    InferenceQueueSettings InferenceQueue::GetSettings() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_settings;
+    }
+
+    bool InferenceQueue::RunsBefore(const Entry& a, const Entry& b) {
+        if (a.task.priority != b.task.priority) {
+            return a.task.priority < b.task.priority;
+        }
+        if (a.task.deadline != b.task.deadline) {
+            return a.task.deadline < b.task.deadline;
+        }
+        return a.sequence < b.sequence;
+    }
+
+    void InferenceQueue::CollectExpired(std::vector<Entry>& dropped) {
+        auto now = InferenceTask::Clock::now();
+        auto expired = std::stable_partition(m_waiting.begin(), m_waiting.end(), [now](const Entry& entry) {
+            return entry.task.deadline > now;
+        });
+        dropped.insert(dropped.end(), std::make_move_iterator(expired), std::make_move_iterator(m_waiting.end()));
+        m_waiting.erase(expired, m_waiting.end());
+    }
+
+    void InferenceQueue::Dispatch() {
+        // One job per free slot, each picks the best request when it starts
+        while (m_dispatched + m_running < m_settings.maxConcurrent && m_dispatched < m_waiting.size()) {
+            ++m_dispatched;
+
+            bool background = std::all_of(m_waiting.begin(), m_waiting.end(), [](const Entry& entry) {
+                return entry.task.priority == InferencePriority::Background;
+            });
+            Core::JobSystem::Get().Submit([this]() { RunNext(); },
+                background ? Core::JobPriority::Low : Core::JobPriority::Normal, m_jobs);
+        }
+    }
+
+    void InferenceQueue::RunNext() {
+        std::vector<Entry> expired;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        --m_dispatched;
+
+        CollectExpired(expired);
+        m_stats.expired += expired.size();
+
+        const bool lowPriorityAllowed = m_runningLowPriority < m_settings.maxConcurrent - m_settings.reservedConversationSlots;
+        auto next = m_waiting.end();
+        for (auto it = m_waiting.begin(); it != m_waiting.end(); ++it) {
+            if (it->task.priority != InferencePriority::Conversation && !lowPriorityAllowed) {
+                continue;
+            }
+            if (next == m_waiting.end() || RunsBefore(*it, *next)) {
+                next = it;
+            }
+        }
+
+        if (next == m_waiting.end()) {
+            // Only reserved slots are free, a finishing request dispatches again
+            lock.unlock();
+            Drop(expired, InferenceDropReason::Expired);
+            return;
+        }
+
+        Entry entry = std::move(*next);
+        m_waiting.erase(next);
+        const bool lowPriority = entry.task.priority != InferencePriority::Conversation;
+        ++m_running;
+        m_runningLowPriority += lowPriority ? 1 : 0;
+        lock.unlock();
+
+        Drop(expired, InferenceDropReason::Expired);
+
+        try {
+            entry.task.run();
+        }
+        catch (const std::exception& e) {
+            AGK_ERROR("InferenceQueue: Request for '{0}' threw: {1}", entry.task.ownerId, e.what());
+        }
+        catch (...) {
+            AGK_ERROR("InferenceQueue: Request for '{0}' threw an unknown exception", entry.task.ownerId);
+        }
+
+        lock.lock();
+        --m_running;
+        m_runningLowPriority -= lowPriority ? 1 : 0;
+        ++m_stats.executed;
+        if (!m_shutdown) {
+            Dispatch();
+        }
+    }
+
+    void InferenceQueue::Drop(std::vector<Entry>& entries, InferenceDropReason reason) {
+        for (Entry& entry : entries) {
+            if (!entry.task.drop) {
+                continue;
+            }
+
+            // A throwing callback must not skip the others or leave a slot counted as running
+            try {
+                entry.task.drop(reason);
+            }
+            catch (const std::exception& e) {
+                AGK_ERROR("InferenceQueue: Drop callback for '{0}' threw: {1}", entry.task.ownerId, e.what());
+            }
+            catch (...) {
+                AGK_ERROR("InferenceQueue: Drop callback for '{0}' threw an unknown exception", entry.task.ownerId);
+            }
+        }
+        entries.clear();
+    }
+
+} // namespace Angaraka::AI
@@ -0,0 +1,322 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Private/Angaraka/ResponseCache.cpp
+#include <Angaraka/ResponseCache.hpp>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace Angaraka::AI {
+
+    namespace {
+
+        constexpr U64 FNV_OFFSET = 0xcbf29ce484222325ull;
+        constexpr U64 FNV_PRIME = 0x100000001b3ull;
+        constexpr I32 CACHE_FILE_VERSION = 1;
+
+        U64 HashBytes(U64 hash, const void* data, size_t size) {
+            const U8* bytes = static_cast<const U8*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * FNV_PRIME;
+            }
+            return hash;
+        }
+
+        // Length-prefixed so ("ab", "c") and ("a", "bc") hash differently
+        U64 HashString(U64 hash, std::string_view text) {
+            U64 length = text.size();
+            hash = HashBytes(hash, &length, sizeof(length));
+            return HashBytes(hash, text.data(), text.size());
+        }
+
+        template<typename T>
+        U64 HashValue(U64 hash, T value) {
+            return HashBytes(hash, &value, sizeof(value));
+        }
+
+        // Calls emit for every byte of the normalized prompt, see ResponseCache::NormalizePrompt
+        template<typename Emit>
+        void ForEachNormalizedByte(std::string_view prompt, Emit&& emit) {
+            bool pendingSpace = false;
+            bool started = false;
+            for (char c : prompt) {
+                unsigned char byte = static_cast<unsigned char>(c);
+                if (std::isspace(byte)) {
+                    pendingSpace = started;
+                    continue;
+                }
+                if (pendingSpace) {
+                    emit(' ');
+                    pendingSpace = false;
+                }
+                emit(static_cast<char>(std::tolower(byte)));
+                started = true;
+            }
+        }
+
+    } // anonymous namespace
+
+    ResponseCache::ResponseCache(const ResponseCacheSettings& settings)
+        : m_settings(settings)
+    {
+    }
+
+    ResponseCache::Key ResponseCache::MakeKey(std::string_view modelId, std::string_view factionId, std::string_view prompt,
+        const SamplingParams& sampling, size_t maxTokens) {
+
+        U64 hash = FNV_OFFSET;
+        hash = HashString(hash, modelId);
+        hash = HashString(hash, factionId);
+
+        // Hashed while normalizing, no copy of the prompt is made
+        U64 promptLength = 0;
+        ForEachNormalizedByte(prompt, [&hash, &promptLength](char c) {
+            hash = (hash ^ static_cast<U8>(c)) * FNV_PRIME;
+            ++promptLength;
+        });
+        hash = HashValue(hash, promptLength);
+
+        hash = HashValue(hash, sampling.temperature);
+        hash = HashValue(hash, sampling.topK);
+        hash = HashValue(hash, sampling.topP);
+        hash = HashValue(hash, sampling.repetitionPenalty);
+        hash = HashValue(hash, static_cast<U64>(sampling.repetitionWindow));
+        hash = HashValue(hash, sampling.seed);
+        hash = HashValue(hash, static_cast<U64>(maxTokens));
+        return hash;
+    }
+
+    U64 ResponseCache::HashPrompt(std::string_view prompt) {
+        U64 hash = FNV_OFFSET;
+        ForEachNormalizedByte(prompt, [&hash](char c) {
+            hash = (hash ^ static_cast<U8>(c)) * FNV_PRIME;
+        });
+        return hash;
+    }
+
+    String ResponseCache::NormalizePrompt(std::string_view prompt) {
+        String normalized;
+        normalized.reserve(prompt.size());
+        ForEachNormalizedByte(prompt, [&normalized](char c) { normalized.push_back(c); });
+        return normalized;
+    }
+
+    bool ResponseCache::TryGet(Key key, const String& factionId, CachedDialogue& result) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FactionCacheStats& factionStats = m_factionStats[factionId];
+
+        auto it = m_index.find(key);
+        if (it != m_index.end() && it->second->factionId == factionId) {
+            if (WallClock::now() < it->second->expires) {
+                // Move to the front, iterators stay valid
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                result = it->second->value;
+                ++m_stats.hits;
+                ++factionStats.hits;
+                return true;
+            }
+
+            Erase(it->second);
+            ++m_stats.expirations;
+        }
+
+        ++m_stats.misses;
+        ++factionStats.misses;
+        return false;
+    }
+
+    void ResponseCache::Put(Key key, const String& factionId, CachedDialogue value) {
+        Entry entry{ key, factionId, std::move(value), WallClock::time_point{}, 0 };
+        entry.bytes = EstimateBytes(entry);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (entry.bytes > m_settings.memoryBudgetBytes) {
+            return;
+        }
+
+        entry.expires = ExpiryFromNow();
+        Insert(std::move(entry));
+        EnforceBudget();
+    }
+
+    void ResponseCache::Clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_index.clear();
+        m_stats.memoryBytes = 0;
+        m_stats.entries = 0;
+    }
+
+    bool ResponseCache::Save(const String& path) const {
+        nlohmann::json entries = nlohmann::json::array();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto now = WallClock::now();
+
+            // Least recently used first, so loading in file order restores the recency
+            for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) {
+                if (it->expires <= now) {
+                    continue;
+                }
+
+                entries.push_back({
+                    { "key", it->key },
+                    { "faction", it->factionId },
+                    { "expires", std::chrono::duration_cast<std::chrono::seconds>(it->expires.time_since_epoch()).count() },
+                    { "response", it->value.response },
+                    { "emotional_tone", it->value.emotionalTone },
+                    { "suggested_responses", it->value.suggestedPlayerResponses },
+                    { "confidence", it->value.confidence }
+                });
+            }
+        }
+
+        const size_t saved = entries.size();
+        try {
+            std::filesystem::path filePath(path);
+            if (filePath.has_parent_path()) {
+                std::filesystem::create_directories(filePath.parent_path());
+            }
+
+            // Write next to the target and swap in, a crash mid-save keeps the old file
+            String tempPath = path + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::trunc);
+                if (!file) {
+                    AGK_ERROR("ResponseCache: Cannot write '{0}'", tempPath);
+                    return false;
+                }
+                file << nlohmann::json{ { "version", CACHE_FILE_VERSION }, { "entries", std::move(entries) } }.dump();
+            }
+            std::filesystem::rename(tempPath, filePath);
+        }
+        catch (const std::exception& e) {
+            AGK_ERROR("ResponseCache: Failed to save '{0}': {1}", path, e.what());
+            return false;
+        }
+
+        AGK_INFO("ResponseCache: Saved {0} responses to '{1}'", saved, path);
+        return true;
+    }
+
+    bool ResponseCache::Load(const String& path) {
+        if (!std::filesystem::exists(path)) {
+            return false;
+        }
+
+        nlohmann::json document;
+        try {
+            std::ifstream file(path);
+            document = nlohmann::json::parse(file);
+        }
+        catch (const std::exception& e) {
+            AGK_WARN("ResponseCache: Ignoring unreadable cache file '{0}': {1}", path, e.what());
+            return false;
+        }
+
+        if (document.value("version", 0) != CACHE_FILE_VERSION || !document.contains("entries")) {
+            AGK_WARN("ResponseCache: Ignoring cache file '{0}' with unknown version", path);
+            return false;
+        }
+
+        size_t loaded = 0;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto now = WallClock::now();
+
+        for (const auto& item : document["entries"]) {
+            try {
+                Entry entry{};
+                entry.key = item.at("key").get<Key>();
+                entry.factionId = item.at("faction").get<String>();
+                entry.expires = WallClock::time_point(std::chrono::seconds(item.at("expires").get<I64>()));
+                entry.value.response = item.at("response").get<String>();
+                entry.value.emotionalTone = item.value("emotional_tone", String{});
+                entry.value.suggestedPlayerResponses = item.value("suggested_responses", std::vector<String>{});
+                entry.value.confidence = item.value("confidence", 0.0f);
+
+                if (entry.expires <= now) {
+                    continue;
+                }
+
+                // A shorter TTL set since the save still applies
+                entry.expires = std::min(entry.expires, ExpiryFromNow());
+                entry.bytes = EstimateBytes(entry);
+                Insert(std::move(entry));
+                ++loaded;
+            }
+            catch (const std::exception& e) {
+                AGK_WARN("ResponseCache: Skipping malformed entry in '{0}': {1}", path, e.what());
+            }
+        }
+
+        EnforceBudget();
+
+        AGK_INFO("ResponseCache: Loaded {0} responses from '{1}'", loaded, path);
+        return true;
+    }
+
+    void ResponseCache::SetSettings(const ResponseCacheSettings& settings) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_settings = settings;
+        EnforceBudget();
+    }
+
+    ResponseCacheSettings ResponseCache::GetSettings() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_settings;
+    }
+
+    ResponseCacheStats ResponseCache::GetStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    FactionCacheStats ResponseCache::GetFactionStats(const String& factionId) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_factionStats.find(factionId);
+        return it != m_factionStats.end() ? it->second : FactionCacheStats{};
+    }
+
+    size_t ResponseCache::EstimateBytes(const Entry& entry) {
+        // Node, index slot and string payloads; small strings are counted as if on the heap
+        size_t bytes = sizeof(Entry) + 4 * sizeof(void*) + sizeof(std::pair<Key, void*>) + 2 * sizeof(void*);
+        bytes += entry.factionId.size() + entry.value.response.size() + entry.value.emotionalTone.size();
+        for (const String& suggestion : entry.value.suggestedPlayerResponses) {
+            bytes += sizeof(String) + suggestion.size();
+        }
+        return bytes;
+    }
+
+    ResponseCache::WallClock::time_point ResponseCache::ExpiryFromNow() const {
+        if (m_settings.timeToLiveSeconds <= 0.0f) {
+            return WallClock::time_point::max();
+        }
+        return WallClock::now() + std::chrono::duration_cast<WallClock::duration>(std::chrono::duration<F32>(m_settings.timeToLiveSeconds));
+    }
+
+    void ResponseCache::Insert(Entry&& entry) {
+        auto existing = m_index.find(entry.key);
+        if (existing != m_index.end()) {
+            Erase(existing->second);
+        }
+
+        m_stats.memoryBytes += entry.bytes;
+        ++m_stats.entries;
+        m_entries.push_front(std::move(entry));
+        m_index[m_entries.front().key] = m_entries.begin();
+    }
+
+    void ResponseCache::Erase(std::list<Entry>::iterator it) {
+        m_stats.memoryBytes -= it->bytes;
+        --m_stats.entries;
+        m_index.erase(it->key);
+        m_entries.erase(it);
+    }
+
+    void ResponseCache::EnforceBudget() {
+        while (!m_entries.empty() && m_stats.memoryBytes > m_settings.memoryBudgetBytes) {
+            Erase(std::prev(m_entries.end()));
+            ++m_stats.evictions;
+        }
+    }
+
+} // namespace Angaraka::AI
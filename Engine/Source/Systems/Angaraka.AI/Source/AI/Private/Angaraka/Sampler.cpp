@@ -0,0 +1,316 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Private/Angaraka/Sampler.cpp
+#include <Angaraka/Sampler.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define AGK_SAMPLER_SSE2 1
+#endif
+
+namespace Angaraka::AI {
+
+    // ===== Tensor views =====
+
+    std::span<const F32> GetLogitsRow(const Ort::Value& logits, size_t row) {
+        auto tensorInfo = logits.GetTensorTypeAndShapeInfo();
+        auto shape = tensorInfo.GetShape();
+        if (shape.empty() || shape.back() <= 0 || tensorInfo.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+            return {};
+        }
+
+        const size_t vocabSize = static_cast<size_t>(shape.back());
+        const size_t rowCount = tensorInfo.GetElementCount() / vocabSize;
+        if (row >= rowCount) {
+            return {};
+        }
+
+        return std::span<const F32>(logits.GetTensorData<F32>() + row * vocabSize, vocabSize);
+    }
+
+    std::span<const F32> GetLastLogitsRow(const Ort::Value& logits) {
+        size_t rowCount = GetLogitsRowCount(logits);
+        return rowCount > 0 ? GetLogitsRow(logits, rowCount - 1) : std::span<const F32>{};
+    }
+
+    size_t GetLogitsRowCount(const Ort::Value& logits) {
+        auto tensorInfo = logits.GetTensorTypeAndShapeInfo();
+        auto shape = tensorInfo.GetShape();
+        if (shape.empty() || shape.back() <= 0) {
+            return 0;
+        }
+        return tensorInfo.GetElementCount() / static_cast<size_t>(shape.back());
+    }
+
+    // ===== LogitsSampler =====
+
+    LogitsSampler::LogitsSampler(const SamplingParams& params)
+        : m_params(params)
+        , m_rng(params.seed)
+    {
+        // A penalty below 1 would boost repeated tokens and break the candidate bound in SelectTop
+        m_params.repetitionPenalty = std::max(m_params.repetitionPenalty, 1.0f);
+        m_params.topP = std::clamp(m_params.topP, 0.0f, 1.0f);
+    }
+
+    I64 LogitsSampler::ArgMax(std::span<const F32> logits) {
+        const size_t count = logits.size();
+        if (count == 0) {
+            return -1;
+        }
+
+        const F32* data = logits.data();
+        size_t best = 0;
+        F32 bestValue = data[0];
+        size_t i = 1;
+
+#ifdef AGK_SAMPLER_SSE2
+        if (count >= 8) {
+            // Per-lane running maximum and its index, strict compare keeps the first occurrence
+            __m128 maxValues = _mm_loadu_ps(data);
+            __m128i maxIndices = _mm_setr_epi32(0, 1, 2, 3);
+            __m128i indices = maxIndices;
+            const __m128i step = _mm_set1_epi32(4);
+
+            for (i = 4; i + 4 <= count; i += 4) {
+                indices = _mm_add_epi32(indices, step);
+                __m128 values = _mm_loadu_ps(data + i);
+                __m128i greater = _mm_castps_si128(_mm_cmpgt_ps(values, maxValues));
+                maxValues = _mm_max_ps(values, maxValues);
+                maxIndices = _mm_or_si128(_mm_and_si128(greater, indices), _mm_andnot_si128(greater, maxIndices));
+            }
+
+            alignas(16) F32 laneValues[4];
+            alignas(16) I32 laneIndices[4];
+            _mm_store_ps(laneValues, maxValues);
+            _mm_store_si128(reinterpret_cast<__m128i*>(laneIndices), maxIndices);
+
+            best = static_cast<size_t>(laneIndices[0]);
+            bestValue = laneValues[0];
+            for (int lane = 1; lane < 4; ++lane) {
+                size_t laneIndex = static_cast<size_t>(laneIndices[lane]);
+                if (laneValues[lane] > bestValue || (laneValues[lane] == bestValue && laneIndex < best)) {
+                    best = laneIndex;
+                    bestValue = laneValues[lane];
+                }
+            }
+        }
+#endif
+
+        for (; i < count; ++i) {
+            if (data[i] > bestValue) {
+                best = i;
+                bestValue = data[i];
+            }
+        }
+
+        return static_cast<I64>(best);
+    }
+
+    F32 LogitsSampler::LogSumExp(std::span<const F32> logits) {
+        if (logits.empty()) {
+            return -std::numeric_limits<F32>::infinity();
+        }
+
+        F32 maxLogit = logits[ArgMax(logits)];
+        F32 sum = 0.0f;
+        for (F32 logit : logits) {
+            sum += std::exp(logit - maxLogit);
+        }
+        return maxLogit + std::log(sum);
+    }
+
+    I64 LogitsSampler::Sample(std::span<const F32> logits, std::span<const I64> history) {
+        m_lastLogProbability = 0.0f;
+        if (logits.empty()) {
+            return -1;
+        }
+
+        CollectPenalties(logits, history);
+
+        // Greedy: the filtered distribution is a single token
+        if (m_params.temperature <= 0.0f || m_params.topK == 1) {
+            if (m_penalized.empty()) {
+                return ArgMax(logits);
+            }
+            SelectTop(logits, 1);
+            return m_candidates.front().id;
+        }
+
+        if (m_params.topK > 0) {
+            // Softmax over the top-k candidates only
+            SelectTop(logits, std::min<size_t>(m_params.topK, logits.size()));
+
+            F32 maxLogit = m_candidates.front().logit;
+            F32 sum = 0.0f;
+            for (const Candidate& candidate : m_candidates) {
+                sum += std::exp(candidate.logit - maxLogit);
+            }
+            return SampleCandidates(maxLogit + std::log(sum));
+        }
+
+        if (m_params.topP < 1.0f) {
+            // Nucleus over the whole vocabulary: gather more candidates until they hold topP of the mass
+            F32 logNormalizer = LogNormalizer(logits);
+            for (size_t count = 64;; count *= 4) {
+                SelectTop(logits, std::min(count, logits.size()));
+
+                F32 mass = 0.0f;
+                for (const Candidate& candidate : m_candidates) {
+                    mass += std::exp(candidate.logit - logNormalizer);
+                }
+                if (mass >= m_params.topP || m_candidates.size() == logits.size()) {
+                    break;
+                }
+            }
+            return SampleCandidates(logNormalizer);
+        }
+
+        return SampleFullVocabulary(logits);
+    }
+
+    void LogitsSampler::CollectPenalties(std::span<const F32> logits, std::span<const I64> history) {
+        m_penalized.clear();
+        if (m_params.repetitionPenalty <= 1.0f || history.empty()) {
+            return;
+        }
+
+        size_t window = std::min(history.size(), m_params.repetitionWindow);
+        for (I64 token : history.subspan(history.size() - window)) {
+            if (token < 0 || static_cast<size_t>(token) >= logits.size()) {
+                continue;
+            }
+
+            I32 id = static_cast<I32>(token);
+            auto it = std::lower_bound(m_penalized.begin(), m_penalized.end(), id,
+                [](const std::pair<I32, F32>& entry, I32 value) { return entry.first < value; });
+            if (it != m_penalized.end() && it->first == id) {
+                continue;
+            }
+
+            F32 logit = logits[id];
+            F32 penalized = logit > 0.0f ? logit / m_params.repetitionPenalty : logit * m_params.repetitionPenalty;
+            m_penalized.insert(it, { id, penalized });
+        }
+    }
+
+    F32 LogitsSampler::Adjusted(std::span<const F32> logits, I32 id) const {
+        F32 logit = logits[id];
+
+        auto it = std::lower_bound(m_penalized.begin(), m_penalized.end(), id,
+            [](const std::pair<I32, F32>& entry, I32 value) { return entry.first < value; });
+        if (it != m_penalized.end() && it->first == id) {
+            logit = it->second;
+        }
+
+        return m_params.temperature > 0.0f ? logit / m_params.temperature : logit;
+    }
+
+    void LogitsSampler::SelectTop(std::span<const F32> logits, size_t count) {
+        // Penalties only lower logits, so the top `count` after penalties are among the top
+        // `count + penalized` raw logits
+        const size_t capacity = std::min(count + m_penalized.size(), logits.size());
+
+        // Min-heap on the raw logit, lower id wins ties
+        auto worse = [](const Candidate& a, const Candidate& b) {
+            return a.logit != b.logit ? a.logit > b.logit : a.id < b.id;
+        };
+
+        m_candidates.clear();
+        m_candidates.reserve(capacity);
+        for (size_t i = 0; i < logits.size(); ++i) {
+            if (m_candidates.size() < capacity) {
+                m_candidates.push_back({ static_cast<I32>(i), logits[i] });
+                std::push_heap(m_candidates.begin(), m_candidates.end(), worse);
+            }
+            else if (logits[i] > m_candidates.front().logit) {
+                std::pop_heap(m_candidates.begin(), m_candidates.end(), worse);
+                m_candidates.back() = { static_cast<I32>(i), logits[i] };
+                std::push_heap(m_candidates.begin(), m_candidates.end(), worse);
+            }
+        }
+
+        for (Candidate& candidate : m_candidates) {
+            candidate.logit = Adjusted(logits, candidate.id);
+        }
+
+        std::sort(m_candidates.begin(), m_candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return a.logit != b.logit ? a.logit > b.logit : a.id < b.id;
+        });
+        m_candidates.resize(std::min(count, m_candidates.size()));
+    }
+
+    F32 LogitsSampler::LogNormalizer(std::span<const F32> logits) const {
+        const F32 inverseTemperature = 1.0f / m_params.temperature;
+
+        // The raw maximum bounds every penalized logit, so it is a safe shift
+        const F32 shift = logits[ArgMax(logits)] * inverseTemperature;
+
+        F32 sum = 0.0f;
+        for (F32 logit : logits) {
+            sum += std::exp(logit * inverseTemperature - shift);
+        }
+        for (const auto& [id, penalized] : m_penalized) {
+            sum += std::exp(penalized * inverseTemperature - shift) - std::exp(logits[id] * inverseTemperature - shift);
+        }
+
+        return shift + std::log(std::max(sum, std::numeric_limits<F32>::min()));
+    }
+
+    I64 LogitsSampler::SampleFullVocabulary(std::span<const F32> logits) {
+        // Inverse CDF walk over the vocabulary, no candidate list needed
+        const F32 logNormalizer = LogNormalizer(logits);
+        const F32 target = std::uniform_real_distribution<F32>(0.0f, 1.0f)(m_rng);
+
+        F32 cumulative = 0.0f;
+        I64 lastNonZero = ArgMax(logits);
+        for (size_t i = 0; i < logits.size(); ++i) {
+            F32 logProbability = Adjusted(logits, static_cast<I32>(i)) - logNormalizer;
+            F32 probability = std::exp(logProbability);
+            if (probability <= 0.0f) {
+                continue;
+            }
+
+            cumulative += probability;
+            lastNonZero = static_cast<I64>(i);
+            if (cumulative > target) {
+                m_lastLogProbability = logProbability;
+                return lastNonZero;
+            }
+        }
+
+        // Rounding left the target just past the total mass
+        m_lastLogProbability = Adjusted(logits, static_cast<I32>(lastNonZero)) - logNormalizer;
+        return lastNonZero;
+    }
+
+    I64 LogitsSampler::SampleCandidates(F32 logNormalizer) {
+        // Candidates are sorted, keep the smallest prefix holding topP of the mass
+        size_t kept = 0;
+        F32 keptMass = 0.0f;
+        while (kept < m_candidates.size()) {
+            keptMass += std::exp(m_candidates[kept].logit - logNormalizer);
+            ++kept;
+            if (keptMass >= m_params.topP) {
+                break;
+            }
+        }
+
+        const F32 target = std::uniform_real_distribution<F32>(0.0f, keptMass)(m_rng);
+
+        F32 cumulative = 0.0f;
+        size_t chosen = kept - 1;
+        for (size_t i = 0; i < kept; ++i) {
+            cumulative += std::exp(m_candidates[i].logit - logNormalizer);
+            if (cumulative > target) {
+                chosen = i;
+                break;
+            }
+        }
+
+        m_lastLogProbability = m_candidates[chosen].logit - logNormalizer - std::log(keptMass);
+        return m_candidates[chosen].id;
+    }
+
+} // namespace Angaraka::AI
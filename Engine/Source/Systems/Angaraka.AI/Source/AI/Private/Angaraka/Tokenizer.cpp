@@ -3,11 +3,147 @@
 #include <fstream>
 #include <filesystem>
 #include <algorithm>
-#include <regex>
+#include <limits>
 #include <nlohmann/json.hpp>
 
 namespace Angaraka::AI {
 
+    namespace {
+
+        // GPT-2 byte-level BPE maps every byte to a printable codepoint so that vocabulary
+        // entries never contain raw whitespace or control bytes. Printable Latin-1 bytes map
+        // to themselves, the remaining bytes to 256, 257, ... in byte order.
+        std::array<U32, 256> BuildByteToCodepoint() {
+            std::array<U32, 256> table{};
+            U32 next = 256;
+            for (U32 b = 0; b < 256; ++b) {
+                bool printable = (b >= 0x21 && b <= 0x7E) || (b >= 0xA1 && b <= 0xAC) || (b >= 0xAE && b <= 0xFF);
+                table[b] = printable ? b : next++;
+            }
+            return table;
+        }
+
+        String CodepointToUtf8(U32 codepoint) {
+            String utf8;
+            if (codepoint < 0x80) {
+                utf8 += static_cast<char>(codepoint);
+            }
+            else if (codepoint < 0x800) {
+                utf8 += static_cast<char>(0xC0 | (codepoint >> 6));
+                utf8 += static_cast<char>(0x80 | (codepoint & 0x3F));
+            }
+            else {
+                utf8 += static_cast<char>(0xE0 | (codepoint >> 12));
+                utf8 += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+                utf8 += static_cast<char>(0x80 | (codepoint & 0x3F));
+            }
+            return utf8;
+        }
+
+        // Inverse of BuildByteToCodepoint, -1 for codepoints that stand for no byte
+        std::array<I16, 324> BuildCodepointToByte() {
+            std::array<I16, 324> table;
+            table.fill(-1);
+
+            std::array<U32, 256> byteToCodepoint = BuildByteToCodepoint();
+            for (U32 b = 0; b < 256; ++b) {
+                table[byteToCodepoint[b]] = static_cast<I16>(b);
+            }
+            return table;
+        }
+
+        // Number of bytes in the UTF-8 sequence introduced by lead, 1 for stray bytes
+        inline size_t Utf8SequenceLength(U8 lead) {
+            if (lead >= 0xF0) return 4;
+            if (lead >= 0xE0) return 3;
+            if (lead >= 0xC0) return 2;
+            return 1;
+        }
+
+        // Reverses the byte-to-codepoint mapping of a byte-level BPE token. Returns false if
+        // the token contains a character that does not stand for a byte.
+        bool DecodeByteLevelToken(const String& token, String& out) {
+            static const std::array<I16, 324> codepointToByte = BuildCodepointToByte();
+
+            size_t start = out.size();
+            for (size_t i = 0; i < token.size();) {
+                U8 lead = static_cast<U8>(token[i]);
+                size_t length = Utf8SequenceLength(lead);
+                if (length > 2 || i + length > token.size()) {
+                    out.resize(start);
+                    return false;
+                }
+
+                U32 codepoint = length == 1 ? lead : ((lead & 0x1Fu) << 6) | (static_cast<U8>(token[i + 1]) & 0x3Fu);
+                if (codepoint >= codepointToByte.size() || codepointToByte[codepoint] < 0) {
+                    out.resize(start);
+                    return false;
+                }
+
+                out += static_cast<char>(codepointToByte[codepoint]);
+                i += length;
+            }
+            return true;
+        }
+
+        inline U64 MergeKey(I64 left, I64 right) {
+            return (static_cast<U64>(static_cast<U32>(left)) << 32) | static_cast<U32>(right);
+        }
+
+        // Character classes of the GPT-2 pre-tokenizer pattern. Non-ASCII bytes count as
+        // letters so multi-byte UTF-8 words stay in one piece.
+        inline bool IsSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        inline bool IsDigit(char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        inline bool IsLetter(char c) {
+            U8 b = static_cast<U8>(c);
+            return (b >= 'a' && b <= 'z') || (b >= 'A' && b <= 'Z') || b >= 0x80;
+        }
+
+        enum class CharClass : U8 { Letter, Digit, Space, Other };
+
+        inline CharClass Classify(char c) {
+            if (IsLetter(c)) return CharClass::Letter;
+            if (IsDigit(c)) return CharClass::Digit;
+            if (IsSpace(c)) return CharClass::Space;
+            return CharClass::Other;
+        }
+
+        // Length of a contraction suffix ('s, 't, 're, 've, 'm, 'll, 'd) at pos, 0 if none
+        size_t MatchContraction(std::string_view text, size_t pos) {
+            if (text[pos] != '\'' || pos + 1 >= text.size()) {
+                return 0;
+            }
+
+            char c1 = text[pos + 1];
+            if (c1 == 's' || c1 == 't' || c1 == 'm' || c1 == 'd') {
+                return 2;
+            }
+
+            if (pos + 2 < text.size()) {
+                char c2 = text[pos + 2];
+                if ((c1 == 'r' && c2 == 'e') || (c1 == 'v' && c2 == 'e') || (c1 == 'l' && c2 == 'l')) {
+                    return 3;
+                }
+            }
+            return 0;
+        }
+
+        // End of the run of characters of the given class starting at pos
+        size_t ScanRun(std::string_view text, size_t pos, CharClass charClass) {
+            while (pos < text.size() && Classify(text[pos]) == charClass) {
+                ++pos;
+            }
+            return pos;
+        }
+
+    } // namespace
+
     bool Tokenizer::LoadVocabulary(const String& vocabFilePath) {
         AGK_INFO("Tokenizer: Loading vocabulary from '{0}'", vocabFilePath);
 
@@ -70,9 +206,167 @@ namespace Angaraka::AI {
         bool vocabLoaded = LoadVocabulary(vocabFilePath);
         bool specialLoaded = LoadSpecialTokens(specialTokensFilePath);
 
+        // Merges are optional, without them the tokenizer can still decode
+        std::filesystem::path mergesPath = std::filesystem::path(vocabFilePath).parent_path() / "merges.txt";
+        if (vocabLoaded && std::filesystem::exists(mergesPath)) {
+            LoadMerges(mergesPath.string());
+        }
+        else if (vocabLoaded) {
+            AGK_WARN("Tokenizer: No merges found at '{0}', encoding unavailable", mergesPath.string());
+        }
+
         return vocabLoaded && specialLoaded;
     }
 
+    bool Tokenizer::LoadMerges(const String& mergesFilePath) {
+        AGK_INFO("Tokenizer: Loading merges from '{0}'", mergesFilePath);
+
+        if (!m_vocabularyLoaded) {
+            AGK_ERROR("Tokenizer: Cannot load merges before the vocabulary");
+            return false;
+        }
+
+        if (!std::filesystem::exists(mergesFilePath)) {
+            AGK_ERROR("Tokenizer: Merges file not found: '{0}'", mergesFilePath);
+            return false;
+        }
+
+        try {
+            std::vector<std::pair<String, String>> pairs;
+            std::ifstream file(mergesFilePath);
+
+            if (std::filesystem::path(mergesFilePath).extension() == ".json") {
+                // tokenizer.json: {"model": {"merges": ["a b", ...] or [["a", "b"], ...]}}
+                nlohmann::json tokenizerJson;
+                file >> tokenizerJson;
+
+                const nlohmann::json& merges = tokenizerJson.contains("model") ? tokenizerJson["model"]["merges"] : tokenizerJson["merges"];
+                pairs.reserve(merges.size());
+                for (const auto& merge : merges) {
+                    if (merge.is_string()) {
+                        String line = merge.get<String>();
+                        size_t split = line.find(' ');
+                        if (split != String::npos) {
+                            pairs.emplace_back(line.substr(0, split), line.substr(split + 1));
+                        }
+                    }
+                    else if (merge.is_array() && merge.size() == 2) {
+                        pairs.emplace_back(merge[0].get<String>(), merge[1].get<String>());
+                    }
+                }
+            }
+            else {
+                // merges.txt: optional "#version" header, then one "left right" pair per line
+                String line;
+                while (std::getline(file, line)) {
+                    if (!line.empty() && line.back() == '\r') {
+                        line.pop_back();
+                    }
+                    if (line.empty() || line.rfind("#version", 0) == 0) {
+                        continue;
+                    }
+
+                    size_t split = line.find(' ');
+                    if (split != String::npos) {
+                        pairs.emplace_back(line.substr(0, split), line.substr(split + 1));
+                    }
+                }
+            }
+
+            m_mergeRules.clear();
+            m_mergeRules.reserve(pairs.size());
+
+            size_t skipped = 0;
+            for (size_t rank = 0; rank < pairs.size(); ++rank) {
+                const auto& [left, right] = pairs[rank];
+                auto leftIt = m_tokenToId.find(left);
+                auto rightIt = m_tokenToId.find(right);
+                auto mergedIt = m_tokenToId.find(left + right);
+                if (leftIt == m_tokenToId.end() || rightIt == m_tokenToId.end() || mergedIt == m_tokenToId.end()) {
+                    ++skipped;
+                    continue;
+                }
+
+                // First occurrence has the lowest rank and wins
+                m_mergeRules.try_emplace(MergeKey(leftIt->second, rightIt->second),
+                    MergeRule{ static_cast<I32>(rank), mergedIt->second });
+            }
+
+            if (skipped > 0) {
+                AGK_WARN("Tokenizer: Skipped {0} merges referencing tokens missing from the vocabulary", skipped);
+            }
+
+            ClearEncodeCache();
+            m_mergesLoaded = !m_mergeRules.empty();
+            AGK_INFO("Tokenizer: Successfully loaded {0} merges", m_mergeRules.size());
+            return m_mergesLoaded;
+
+        }
+        catch (const std::exception& e) {
+            AGK_ERROR("Tokenizer: Exception loading merges: {0}", e.what());
+            return false;
+        }
+    }
+
+    std::vector<I64> Tokenizer::Encode(std::string_view text) {
+        std::vector<I64> tokens;
+
+        if (!CanEncode()) {
+            AGK_ERROR("Tokenizer: Cannot encode text - vocabulary or merges not loaded");
+            return tokens;
+        }
+
+        tokens.reserve(text.size() / 3 + 1);
+
+        // Split around special tokens so "<|endoftext|>" and friends map to their own ids
+        // instead of being broken into bytes
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t specialPos = std::string_view::npos;
+            size_t specialLength = 0;
+            I64 specialId = -1;
+
+            for (const auto& [content, id] : m_specialTokenNames) {
+                if (content.empty()) {
+                    continue;
+                }
+
+                size_t found = text.find(content, pos);
+                if (found < specialPos || (found == specialPos && found != std::string_view::npos && content.size() > specialLength)) {
+                    specialPos = found;
+                    specialLength = content.size();
+                    specialId = id;
+                }
+            }
+
+            if (specialPos == std::string_view::npos) {
+                EncodeSegment(text.substr(pos), tokens);
+                break;
+            }
+
+            EncodeSegment(text.substr(pos, specialPos - pos), tokens);
+            tokens.push_back(specialId);
+            pos = specialPos + specialLength;
+        }
+
+        return tokens;
+    }
+
+    void Tokenizer::SetEncodeCacheCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(m_encodeCacheMutex);
+        m_encodeCacheCapacity = capacity;
+
+        while (m_encodeCacheOrder.size() > m_encodeCacheCapacity) {
+            m_encodeCache.erase(m_encodeCacheOrder.back().first);
+            m_encodeCacheOrder.pop_back();
+        }
+    }
+
+    size_t Tokenizer::GetEncodeCacheSize() const {
+        std::lock_guard<std::mutex> lock(m_encodeCacheMutex);
+        return m_encodeCacheOrder.size();
+    }
+
     String Tokenizer::DecodeTokens(const std::vector<I64>& tokenIds) {
         if (!IsLoaded()) {
             AGK_ERROR("Tokenizer: Cannot decode tokens - tokenizer not loaded");
@@ -83,41 +377,39 @@ namespace Angaraka::AI {
             return "";
         }
 
-        String result;
-        result.reserve(tokenIds.size() * 4); // Rough estimate
+        String raw;
+        raw.reserve(tokenIds.size() * 4); // Rough estimate
 
         for (I64 tokenId : tokenIds) {
             // Skip special tokens that shouldn't appear in output
-            if (tokenId == m_eosTokenId || tokenId == m_bosTokenId || tokenId == m_padTokenId) {
+            if (IsSkippedOnDecode(tokenId)) {
                 continue;
             }
 
-            String tokenText = DecodeToken(tokenId);
-            if (!tokenText.empty()) {
-                result += tokenText;
+            if (tokenId < 0 || static_cast<size_t>(tokenId) >= m_decodeKnown.size() || !m_decodeKnown[tokenId]) {
+                AGK_WARN("Tokenizer: Unknown token ID: {0}", tokenId);
             }
+            raw += DecodeTokenBytes(tokenId);
         }
 
         // Clean up the decoded text
-        return CleanDecodedText(result);
+        return CleanDecodedText(raw);
     }
 
     String Tokenizer::DecodeToken(I64 tokenId) {
-        // Check special tokens first
-        auto specialIt = m_specialTokens.find(tokenId);
-        if (specialIt != m_specialTokens.end()) {
-            return specialIt->second;
+        if (tokenId < 0 || static_cast<size_t>(tokenId) >= m_decodeKnown.size() || !m_decodeKnown[tokenId]) {
+            AGK_WARN("Tokenizer: Unknown token ID: {0}", tokenId);
         }
+        return String(DecodeTokenBytes(tokenId));
+    }
 
-        // Check regular vocabulary
-        auto vocabIt = m_idToToken.find(tokenId);
-        if (vocabIt != m_idToToken.end()) {
-            return ProcessBPEToken(vocabIt->second);
+    std::string_view Tokenizer::DecodeTokenBytes(I64 tokenId) const {
+        if (tokenId < 0 || static_cast<size_t>(tokenId) >= m_decodeKnown.size() || !m_decodeKnown[tokenId]) {
+            return "<unk>";
         }
 
-        // Unknown token
-        AGK_WARN("Tokenizer: Unknown token ID: {0}", tokenId);
-        return "<unk>";
+        U32 begin = m_decodeOffsets[tokenId];
+        return std::string_view(m_decodedBytes).substr(begin, m_decodeOffsets[tokenId + 1] - begin);
     }
 
     bool Tokenizer::IsSpecialToken(I64 tokenId) const {
@@ -134,28 +426,11 @@ namespace Angaraka::AI {
     }
 
     String Tokenizer::CleanDecodedText(const String& rawText) const {
-        String cleaned = rawText;
-
-        // Handle BPE merge artifacts (Ġ represents space in some tokenizers)
-        std::regex bpeSpace(R"(Ġ)");
-        cleaned = std::regex_replace(cleaned, bpeSpace, " ");
-
-        // Handle other BPE artifacts
-        std::regex bpeNewline(R"(Ċ)");
-        cleaned = std::regex_replace(cleaned, bpeNewline, "\n");
-
-        // Remove multiple consecutive spaces
-        std::regex multipleSpaces(R"( {2,})");
-        cleaned = std::regex_replace(cleaned, multipleSpaces, " ");
-
-        // Remove multiple consecutive newlines
-        std::regex multipleNewlines(R"(\n{3,})");
-        cleaned = std::regex_replace(cleaned, multipleNewlines, "\n\n");
-
-        // Trim leading/trailing whitespace
-        cleaned.erase(0, cleaned.find_first_not_of(" \t\n\r"));
-        cleaned.erase(cleaned.find_last_not_of(" \t\n\r") + 1);
+        String cleaned;
+        cleaned.reserve(rawText.size());
 
+        DecodedTextCleaner cleaner;
+        cleaner.Append(rawText, cleaned);
         return cleaned;
     }
 
@@ -190,6 +465,13 @@ namespace Angaraka::AI {
                 return false;
             }
 
+            // Merge rules and cached encodings refer to the previous vocabulary's ids
+            m_mergeRules.clear();
+            m_mergesLoaded = false;
+            ClearEncodeCache();
+            BuildByteTable();
+            BuildDecodeTable();
+
             AGK_INFO("Tokenizer: Parsed {0} vocabulary entries", m_idToToken.size());
             return true;
 
@@ -246,6 +528,8 @@ namespace Angaraka::AI {
                 }
             }
 
+            BuildDecodeTable();
+
             AGK_INFO("Tokenizer: Parsed {0} special tokens", m_specialTokens.size());
             return true;
 
@@ -256,6 +540,212 @@ namespace Angaraka::AI {
         }
     }
 
+    void Tokenizer::BuildByteTable() {
+        static const std::array<U32, 256> byteToCodepoint = BuildByteToCodepoint();
+
+        size_t missing = 0;
+        for (size_t b = 0; b < 256; ++b) {
+            auto it = m_tokenToId.find(CodepointToUtf8(byteToCodepoint[b]));
+            m_byteToId[b] = it != m_tokenToId.end() ? it->second : -1;
+            missing += it == m_tokenToId.end() ? 1 : 0;
+        }
+
+        if (missing > 0) {
+            AGK_WARN("Tokenizer: Vocabulary lacks {0} of 256 byte tokens, those bytes encode as UNK", missing);
+        }
+    }
+
+    void Tokenizer::BuildDecodeTable() {
+        // Token ids are dense in practice, so the table is indexed by id directly
+        constexpr I64 MAX_TABLE_ID = 1 << 24;
+
+        I64 maxId = -1;
+        for (const auto& [id, token] : m_idToToken) {
+            if (id >= 0 && id < MAX_TABLE_ID) maxId = std::max(maxId, id);
+        }
+        for (const auto& [id, content] : m_specialTokens) {
+            if (id >= 0 && id < MAX_TABLE_ID) maxId = std::max(maxId, id);
+        }
+
+        const size_t count = static_cast<size_t>(maxId + 1);
+        m_decodedBytes.clear();
+        m_decodeOffsets.assign(count + 1, 0);
+        m_decodeKnown.assign(count, 0);
+
+        // Byte-level vocabularies have all 256 byte tokens, anything else gets the old
+        // prefix-based cleanup per token
+        bool byteLevel = std::all_of(m_byteToId.begin(), m_byteToId.end(), [](I64 id) { return id >= 0; });
+
+        for (size_t id = 0; id < count; ++id) {
+            m_decodeOffsets[id] = static_cast<U32>(m_decodedBytes.size());
+
+            // Special tokens take precedence over vocabulary entries with the same id
+            auto specialIt = m_specialTokens.find(static_cast<I64>(id));
+            if (specialIt != m_specialTokens.end()) {
+                m_decodedBytes += specialIt->second;
+                m_decodeKnown[id] = 1;
+                continue;
+            }
+
+            auto vocabIt = m_idToToken.find(static_cast<I64>(id));
+            if (vocabIt != m_idToToken.end()) {
+                if (!byteLevel || !DecodeByteLevelToken(vocabIt->second, m_decodedBytes)) {
+                    m_decodedBytes += ProcessBPEToken(vocabIt->second);
+                }
+                m_decodeKnown[id] = 1;
+            }
+        }
+        m_decodeOffsets[count] = static_cast<U32>(m_decodedBytes.size());
+    }
+
+    void Tokenizer::EncodeSegment(std::string_view text, std::vector<I64>& out) {
+        // Hand-rolled equivalent of the GPT-2 pre-tokenizer pattern
+        // 's|'t|'re|'ve|'m|'ll|'d| ?\p{L}+| ?\p{N}+| ?[^\s\p{L}\p{N}]+|\s+(?!\S)|\s+
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = pos;
+
+            if (size_t contraction = MatchContraction(text, pos); contraction > 0) {
+                end = pos + contraction;
+            }
+            else if (text[pos] == ' ' && pos + 1 < text.size() && !IsSpace(text[pos + 1])) {
+                // A single leading space belongs to the following word
+                end = ScanRun(text, pos + 1, Classify(text[pos + 1]));
+            }
+            else if (IsSpace(text[pos])) {
+                end = ScanRun(text, pos, CharClass::Space);
+
+                // Leave the last whitespace character for the next word
+                if (end < text.size() && end - pos > 1) {
+                    --end;
+                }
+            }
+            else {
+                end = ScanRun(text, pos, Classify(text[pos]));
+            }
+
+            EncodeWord(text.substr(pos, end - pos), out);
+            pos = end;
+        }
+    }
+
+    void Tokenizer::EncodeWord(std::string_view word, std::vector<I64>& out) {
+        {
+            std::lock_guard<std::mutex> lock(m_encodeCacheMutex);
+            auto it = m_encodeCache.find(word);
+            if (it != m_encodeCache.end()) {
+                m_encodeCacheOrder.splice(m_encodeCacheOrder.begin(), m_encodeCacheOrder, it->second);
+                const std::vector<I64>& cached = it->second->second;
+                out.insert(out.end(), cached.begin(), cached.end());
+                return;
+            }
+        }
+
+        std::vector<I64> ids;
+        ApplyMerges(word, ids);
+        out.insert(out.end(), ids.begin(), ids.end());
+
+        std::lock_guard<std::mutex> lock(m_encodeCacheMutex);
+        if (m_encodeCacheCapacity == 0 || m_encodeCache.find(word) != m_encodeCache.end()) {
+            return;
+        }
+
+        // The map keys view the strings owned by the list nodes, which never move
+        m_encodeCacheOrder.emplace_front(String(word), std::move(ids));
+        m_encodeCache.emplace(m_encodeCacheOrder.front().first, m_encodeCacheOrder.begin());
+
+        while (m_encodeCacheOrder.size() > m_encodeCacheCapacity) {
+            m_encodeCache.erase(m_encodeCacheOrder.back().first);
+            m_encodeCacheOrder.pop_back();
+        }
+    }
+
+    void Tokenizer::ApplyMerges(std::string_view word, std::vector<I64>& out) const {
+        constexpr I64 REMOVED = std::numeric_limits<I64>::min();
+        const I32 count = static_cast<I32>(word.size());
+
+        // Doubly linked list of symbols, one per byte to begin with
+        std::vector<I64> ids(count);
+        std::vector<I32> prev(count);
+        std::vector<I32> next(count);
+        for (I32 i = 0; i < count; ++i) {
+            I64 id = m_byteToId[static_cast<U8>(word[i])];
+            ids[i] = id >= 0 ? id : m_unkTokenId;
+            prev[i] = i - 1;
+            next[i] = i + 1 < count ? i + 1 : -1;
+        }
+
+        // Candidate merges of adjacent symbols, lowest rank first, leftmost first on ties.
+        // Entries are validated when popped instead of being removed when a neighbour merges.
+        struct Candidate {
+            I32 rank;
+            I32 left;
+            I32 right;
+            I64 mergedId;
+
+            bool operator>(const Candidate& other) const {
+                return rank != other.rank ? rank > other.rank : left > other.left;
+            }
+        };
+
+        std::vector<Candidate> heap;
+        heap.reserve(count);
+
+        auto pushCandidate = [&](I32 left, I32 right) {
+            if (left < 0 || right < 0) {
+                return;
+            }
+
+            auto it = m_mergeRules.find(MergeKey(ids[left], ids[right]));
+            if (it != m_mergeRules.end()) {
+                heap.push_back({ it->second.rank, left, right, it->second.mergedId });
+                std::push_heap(heap.begin(), heap.end(), std::greater<Candidate>());
+            }
+        };
+
+        for (I32 i = 0; i + 1 < count; ++i) {
+            pushCandidate(i, i + 1);
+        }
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<Candidate>());
+            Candidate candidate = heap.back();
+            heap.pop_back();
+
+            // Stale if either side was merged away or the pair no longer produces this token
+            if (ids[candidate.left] == REMOVED || next[candidate.left] != candidate.right) {
+                continue;
+            }
+            auto it = m_mergeRules.find(MergeKey(ids[candidate.left], ids[candidate.right]));
+            if (it == m_mergeRules.end() || it->second.mergedId != candidate.mergedId) {
+                continue;
+            }
+
+            // Fold the right symbol into the left one
+            ids[candidate.left] = candidate.mergedId;
+            ids[candidate.right] = REMOVED;
+            next[candidate.left] = next[candidate.right];
+            if (next[candidate.right] >= 0) {
+                prev[next[candidate.right]] = candidate.left;
+            }
+
+            pushCandidate(prev[candidate.left], candidate.left);
+            pushCandidate(candidate.left, next[candidate.left]);
+        }
+
+        for (I32 i = 0; i >= 0 && i < count; i = next[i]) {
+            if (ids[i] >= 0) {
+                out.push_back(ids[i]);
+            }
+        }
+    }
+
+    void Tokenizer::ClearEncodeCache() {
+        std::lock_guard<std::mutex> lock(m_encodeCacheMutex);
+        m_encodeCache.clear();
+        m_encodeCacheOrder.clear();
+    }
+
     String Tokenizer::ProcessBPEToken(const String& token) const {
         String processed = token;
 
@@ -272,6 +762,101 @@ namespace Angaraka::AI {
         return processed;
     }
 
+    // ===== DecodedTextCleaner Implementation =====
+
+    void DecodedTextCleaner::Append(std::string_view text, String& out) {
+        for (size_t i = 0; i < text.size(); ++i) {
+            char c = text[i];
+
+            // Stray BPE markers: Ġ (U+0120) is a space, Ċ (U+010A) a newline
+            if (static_cast<U8>(c) == 0xC4 && i + 1 < text.size()) {
+                U8 next = static_cast<U8>(text[i + 1]);
+                if (next == 0xA0 || next == 0x8A) {
+                    c = next == 0xA0 ? ' ' : '\n';
+                    ++i;
+                }
+            }
+
+            Put(c, out);
+        }
+    }
+
+    void DecodedTextCleaner::Put(char c, String& out) {
+        bool whitespace = c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        if (!whitespace) {
+            out += m_heldWhitespace;
+            out += c;
+            m_heldWhitespace.clear();
+            m_started = true;
+        }
+        else {
+            // Leading whitespace is trimmed, the rest waits until we know it isn't trailing
+            if (!m_started) {
+                return;
+            }
+            if (c == ' ' && m_last == ' ') {
+                return;
+            }
+            if (c == '\n' && m_last == '\n' && m_beforeLast == '\n') {
+                return;
+            }
+            m_heldWhitespace += c;
+        }
+
+        m_beforeLast = m_last;
+        m_last = c;
+    }
+
+    void DecodedTextCleaner::Reset() {
+        m_heldWhitespace.clear();
+        m_last = '\0';
+        m_beforeLast = '\0';
+        m_started = false;
+    }
+
+    // ===== TokenStreamDecoder Implementation =====
+
+    TokenStreamDecoder::TokenStreamDecoder(std::shared_ptr<const Tokenizer> tokenizer)
+        : m_tokenizer(std::move(tokenizer)) {
+    }
+
+    String TokenStreamDecoder::Push(I64 tokenId) {
+        String text;
+        if (!m_tokenizer || m_tokenizer->IsSkippedOnDecode(tokenId)) {
+            return text;
+        }
+
+        m_pendingBytes += m_tokenizer->DecodeTokenBytes(tokenId);
+
+        // Hold back a trailing multi-byte character that the next token completes
+        size_t complete = m_pendingBytes.size();
+        for (size_t back = 1; back <= std::min<size_t>(3, m_pendingBytes.size()); ++back) {
+            U8 byte = static_cast<U8>(m_pendingBytes[m_pendingBytes.size() - back]);
+            if ((byte & 0xC0) != 0x80) {
+                if (byte >= 0xC0 && Utf8SequenceLength(byte) > back) {
+                    complete = m_pendingBytes.size() - back;
+                }
+                break;
+            }
+        }
+
+        m_cleaner.Append(std::string_view(m_pendingBytes).substr(0, complete), text);
+        m_pendingBytes.erase(0, complete);
+        return text;
+    }
+
+    String TokenStreamDecoder::Flush() {
+        String text;
+        m_cleaner.Append(m_pendingBytes, text);
+        Reset();
+        return text;
+    }
+
+    void TokenStreamDecoder::Reset() {
+        m_pendingBytes.clear();
+        m_cleaner.Reset();
+    }
+
     // ===== TokenizerFactory Implementation =====
     std::unordered_map<String, std::shared_ptr<Tokenizer>> TokenizerFactory::s_tokenizerCache;
 
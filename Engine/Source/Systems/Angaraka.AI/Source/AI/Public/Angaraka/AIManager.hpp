@@ -4,9 +4,16 @@
 #include <Angaraka/Base.hpp>
 #include <Angaraka/AIModelResource.hpp>
 #include <Angaraka/Tokenizer.hpp>
+#include <Angaraka/Sampler.hpp>
+#include <Angaraka/DialogueTrace.hpp>
+#include <Angaraka/InferenceBatcher.hpp>
+#include <Angaraka/InferenceContext.hpp>
+#include <Angaraka/InferenceQueue.hpp>
+#include <Angaraka/ResponseCache.hpp>
 #include <unordered_map>
 #include <memory>
 #include <future>
+#include <optional>
 #include <queue>
 #include <thread>
 
@@ -36,6 +43,17 @@ namespace Angaraka::AI {
         F32 gpuUtilizationPercent{ 0.0f };
     };
 
+    // Phases of AIManager::PreloadDialogueResources in milliseconds. The first three run in
+    // parallel, so the total is less than their sum.
+    struct AIStartupTimings {
+        F32 factionConfigsMs{ 0.0f };
+        F32 tokenizerMs{ 0.0f };
+        F32 sessionMs{ 0.0f };                  // Session creation, including graph optimization
+        F32 warmupMs{ 0.0f };
+        F32 totalMs{ 0.0f };
+        bool usedOptimizedModelCache{ false };
+    };
+
     // Central AI system manager
     class AIManager {
     private:
@@ -65,6 +83,11 @@ namespace Angaraka::AI {
         bool LoadSharedTokenizer(const String& tokenizerPath);
         void UnloadSharedModel();
 
+        // Startup path for the three loads above. Configs, tokenizer and model session are loaded
+        // in parallel on the job system and the model is warmed up before this returns.
+        bool PreloadDialogueResources(const String& modelsDirectory, const String& tokenizerPath, const String& modelPath);
+        const AIStartupTimings& GetStartupTimings() const { return m_startupTimings; }
+
         // Legacy methods (deprecated)
         [[deprecated("Use LoadSharedDialogueModel instead")]]
         bool LoadDialogueModel(const String& factionId, const String& modelPath);
@@ -73,11 +96,21 @@ namespace Angaraka::AI {
         void UnloadModel(const String& modelId);
         void UnloadFactionModels(const String& factionId);
 
-        // High-level AI interfaces
+        // High-level AI interfaces. Requests wait in the inference queue by priority and deadline, and
+        // generated dialogue again in the batcher; one that is dropped (expired, cancelled, queue full)
+        // resolves with success = false.
         std::future<DialogueResponse> GenerateDialogue(const DialogueRequest& request);
         std::future<TerrainResponse> GenerateTerrain(const TerrainRequest& request);
         std::future<BehaviorResponse> EvaluateBehavior(const BehaviorRequest& request);
 
+        // Drops the waiting requests of an NPC that no longer needs them (out of range, despawned)
+        size_t CancelRequestsForNPC(const String& npcId);
+        bool IsInferenceQueueSaturated() const { return m_inferenceQueue->IsSaturated(); }
+        InferenceQueueStats GetInferenceQueueStats() const { return m_inferenceQueue->GetStats(); }
+
+        // Responses to prompts seen before, consulted unless a request opts out
+        ResponseCache& GetResponseCache() { return *m_responseCache; }
+
         // Synchronous versions for immediate results
         DialogueResponse GenerateDialogueSync(const DialogueRequest& request);
         TerrainResponse GenerateTerrainSync(const TerrainRequest& request);
@@ -100,6 +133,16 @@ namespace Angaraka::AI {
 
         // Shared AI system access
         Reference<Tokenizer> GetSharedTokenizer() const { return m_sharedTokenizer; }
+
+        // Token sampling used by dialogue generation. The seed is mixed with the prompt, so
+        // the same prompt and settings always produce the same response.
+        void SetDialogueSamplingParams(const SamplingParams& params) { m_dialogueSampling = params; }
+        const SamplingParams& GetDialogueSamplingParams() const { return m_dialogueSampling; }
+
+        // Dialogue requests that arrive close together are generated as one batch
+        void SetDialogueBatchingSettings(const InferenceBatcherSettings& settings);
+        InferenceBatcherSettings GetDialogueBatchingSettings() const;
+        InferenceBatcherStats GetDialogueBatchingStats() const;
         Reference<FactionConfig> GetFactionConfig(const String& factionId);
         std::vector<String> GetAvailableFactions() const;
 
@@ -122,6 +165,13 @@ namespace Angaraka::AI {
         Reference<AIModelResource> m_sharedDialogueModel;   // Single 600MB model for all factions
         Reference<Tokenizer> m_sharedTokenizer;             // Single tokenizer for all factions
         std::vector<I64> m_lastTokenSequence;
+        SamplingParams m_dialogueSampling{ 0.8f, 40, 0.95f, 1.1f, 64 };
+        InferenceBatcherSettings m_dialogueBatching;
+        Scope<InferenceBatcher> m_dialogueBatcher;          // Steps the generations of the shared model as jobs
+        Scope<InferenceContext> m_dialogueContext;          // Preallocated tensors of a single-pass dialogue model
+        Scope<ResponseCache> m_responseCache;
+        String m_dialogueModelKey;                          // Identifies the loaded model file in cache keys
+        AIStartupTimings m_startupTimings;
 
         std::unordered_map<String, Reference<FactionConfig>> m_factionConfigs;
 
@@ -135,12 +185,8 @@ namespace Angaraka::AI {
         Reference<Angaraka::Core::CachedResourceManager> m_resourceManager;
         size_t m_currentVRAMUsage{ 0 };
 
-        // Threading for async operations
-        std::vector<std::thread> m_backgroundThreads;
-        std::queue<std::function<void()>> m_taskQueue;
-        std::mutex m_taskQueueMutex;
-        std::condition_variable m_taskCondition;
-        std::atomic<bool> m_shutdownRequested{ false };
+        // Async requests wait here and run on the shared job system
+        Scope<InferenceQueue> m_inferenceQueue;
 
         // Performance monitoring
         bool m_profilingEnabled{ true };
@@ -155,17 +201,36 @@ namespace Angaraka::AI {
         String GenerateModelId(const String& factionId, const String& modelType);
         bool ValidateModelCompatibility(const Reference<AIModelResource>& model);
         void UpdatePerformanceMetrics();
-        void ProcessBackgroundTasks();
         void CheckForModelFileChanges();
         void CleanupUnusedModels();
 
         // Model loading helpers
+        Reference<AIModelResource> CreateModelResource(const String& modelId, const String& modelPath);
+        void ReleaseSharedDialogueModel();
+        bool InstallSharedDialogueModel(const String& modelPath, Reference<AIModelResource> model);
         bool LoadModelInternal(const String& modelId, const String& modelPath, const String& factionId);
         void RegisterModelWithFaction(const String& modelId, const String& factionId);
         void UnregisterModelFromFaction(const String& modelId, const String& factionId);
 
+        // Returns the response, or nothing when generation was queued and completion will receive it.
+        // A queued generation that has not started by the deadline is dropped.
+        using DialogueCompletion = std::function<void(DialogueResponse&&)>;
+        std::optional<DialogueResponse> StartDialogue(const DialogueRequest& request, DialogueCompletion completion, bool cacheChecked = false,
+            InferenceTask::Clock::time_point deadline = InferenceTask::Clock::time_point::max());
+
+        // Stamps the total time and trace on the response and logs the trace at debug level
+        void FinishDialogue(const DialogueRequest& request, DialogueResponse& response, DialogueTrace& trace, const StageTimer& timer);
+
+        // Response cache helpers
+        bool IsDialogueCacheable(const DialogueRequest& request) const;
+        bool TryGetCachedDialogue(const DialogueRequest& request, const String& prompt, DialogueResponse& response);
+        void StoreCachedDialogue(const DialogueRequest& request, const String& prompt, const DialogueResponse& response);
+
         // Output processing helpers
         DialogueResponse ProcessDialogueOutputs(const std::vector<Ort::Value>& outputs, Reference<AIModelResource> model, const DialogueRequest& request);
+        DialogueResponse ProcessDialogueOutputs(const InferenceContext& context, const DialogueRequest& request);
+        void ApplyDialogueOutput(const String& outputName, ONNXTensorElementDataType elementType, const void* data,
+            std::span<const I64> shape, const DialogueRequest& request, DialogueResponse& response);
         TerrainResponse ProcessTerrainOutputs(const std::vector<Ort::Value>& outputs, Reference<AIModelResource> model, const TerrainRequest& request);
         BehaviorResponse ProcessBehaviorOutputs(const std::vector<Ort::Value>& outputs, Reference<AIModelResource> model, const BehaviorRequest& request);
 
@@ -176,7 +241,7 @@ namespace Angaraka::AI {
         std::vector<String> ExtractStringTensorArray(const Ort::Value& tensor);
 
         // Dialogue processing helpers
-        String DecodeTokensToText(const std::vector<I64>& tokens, const String& factionId);
+        String DecodeTokensToText(std::span<const I64> tokens, const String& factionId);
         String DecodeTokensBasic(const std::vector<I64>& tokens, const String& factionId);
         String DecodeTokensEnhanced(const std::vector<I64>& tokens, const String& factionId);
         String DecodeGPTToken(I64 tokenId);
@@ -191,19 +256,21 @@ namespace Angaraka::AI {
         String EnhanceDialogueResponse(const String& baseResponse, const String& factionId);
         String RemoveRepetitiveWords(const String& text);
 
-        // Logits processing helpers
-        std::vector<I64> ConvertLogitsToTokens(const std::vector<F32>& logits);
-        F32 CalculateConfidenceFromLogits(const std::vector<F32>& logits);
-        std::vector<F32> ApplySoftmax(const std::vector<F32>& logits);
+        // Logits processing helpers, logits are rows of vocabSize values read in place
+        std::vector<I64> ConvertLogitsToTokens(std::span<const F32> logits, size_t vocabSize);
+        F32 CalculateConfidenceFromLogits(std::span<const F32> logits);
 
         // Shared model helpers
         std::vector<I64> CreateDialogueTokens(const String& fullPrompt, const String& factionId);
         std::vector<F32> CreateFactionContextVector(const String& factionId, const DialogueRequest& request);
+        void FillFactionContextVector(std::span<F32> context, const String& factionId, const DialogueRequest& request);
 
         // New implementation helpers  
-        bool LoadFactionConfigFile(const String& factionId, const String& configPath);
+        Reference<FactionConfig> ParseFactionConfigFile(const String& factionId, const String& configPath);
         String BuildFactionPrompt(Reference<FactionConfig> config, const DialogueRequest& request);
         std::vector<Ort::Value> CreateDialogueInputs(const String& prompt, const DialogueRequest& request, const std::vector<String>& inputNames, const std::vector<std::vector<I64>>& inputShapes);
+        bool RunBoundDialogueInference(const String& prompt, const DialogueRequest& request, DialogueResponse& response,
+            DialogueTrace& trace, StageTimer& timer);
         std::vector<I64> TokenizePrompt(const String& prompt);
         Ort::Value CreateValidatedInt64Tensor(const std::vector<I64>& data, const std::vector<I64>& shape, const String& tensorName);
         void DiagnoseInferenceInputs(const std::vector<Ort::Value>& inputs, const std::vector<String>& inputNames);
@@ -220,6 +287,9 @@ namespace Angaraka::AI {
         std::unordered_map<String, F32> emotionalState;
         std::vector<String> recentEvents;
         F32 urgency{ 0.5f }; // 0.0 = casual, 1.0 = critical
+        InferencePriority priority{ InferencePriority::Conversation };
+        F32 deadlineMs{ 0.0f };     // Dropped if not started within this time, 0 = no deadline
+        bool bypassResponseCache{ false };  // Always run the model and do not store the result
     };
 
     struct DialogueResponse {
@@ -230,6 +300,7 @@ namespace Angaraka::AI {
         F32 confidence{ 0.0f };
         F32 inferenceTimeMs{ 0.0f };
         bool success{ false };
+        DialogueTrace trace;
     };
 
     struct TerrainRequest {
@@ -240,6 +311,8 @@ namespace Angaraka::AI {
         I32 seed;
         F32 philosophicalResonance{ 0.5f }; // How much the terrain reflects faction philosophy
         std::vector<String> requiredFeatures;
+        InferencePriority priority{ InferencePriority::Background };
+        F32 deadlineMs{ 0.0f };     // Dropped if not started within this time, 0 = no deadline
     };
 
     struct TerrainResponse {
@@ -253,11 +326,14 @@ namespace Angaraka::AI {
 
     struct BehaviorRequest {
         String factionId;
+        String npcId;
         String npcType;
         String currentSituation;
         std::vector<String> availableActions;
         std::unordered_map<String, F32> worldState;
         F32 timeConstraint{ 1.0f }; // How quickly decision is needed
+        InferencePriority priority{ InferencePriority::Normal };
+        F32 deadlineMs{ 0.0f };     // Dropped if not started within this time, 0 = no deadline
     };
 
     struct BehaviorResponse {
@@ -4,9 +4,13 @@
 #pragma once
 
 #include <Angaraka/Base.hpp>
+#include <Angaraka/InferenceContext.hpp>
 #include <onnxruntime_cxx_api.h>
 #include <unordered_map>
 #include <atomic>
+#include <chrono>
+#include <functional>
+#include <span>
 
 import Angaraka.Core.Resources;
 
@@ -29,6 +33,96 @@ namespace Angaraka::AI {
         String version;            // NEW: Model version for compatibility checking
     };
 
+    // A picked token and its log-probability under the distribution it was drawn from
+    struct SampledToken {
+        I64 id{ -1 };
+        F32 logProbability{ 0.0f };
+    };
+
+    // Picks the next token from the logits of the last position. sequence holds the prompt
+    // followed by everything generated so far.
+    using TokenSampler = std::function<SampledToken(std::span<const F32> logits, std::span<const I64> sequence)>;
+
+    // Settings for AIModelResource::Generate
+    struct GenerationConfig {
+        size_t maxNewTokens{ 48 };
+        std::vector<I64> stopTokens;                    // Generation ends after emitting one of these (usually EOS)
+        TokenSampler sampler;                           // Greedy argmax when empty
+        std::function<bool(I64 tokenId)> onToken;       // Called per generated token, return false to stop early
+    };
+
+    struct GenerationResult {
+        std::vector<I64> tokens;                        // Generated tokens only, stop token excluded
+        F32 averageProbability{ 0.0f };                 // Mean sampler probability of the chosen tokens, 1 when greedy
+        F32 promptTimeMs{ 0.0f };                       // First step, processes the whole prompt
+        F32 decodeTimeMs{ 0.0f };                       // All following steps
+        F32 tokensPerSecond{ 0.0f };                    // Generated tokens over decode time
+        bool usedKVCache{ false };
+        bool stoppedOnToken{ false };
+        bool success{ false };
+    };
+
+    /**
+     * @brief Generations advanced together, one token per AIModelResource::StepGeneration
+     *
+     * Rows can be added between steps, so a request does not wait for the rows already
+     * running to finish. Without a KV cache every step processes the full sequences anyway and
+     * a new row simply takes part in the next one. With a cache the new prompt has no entries
+     * yet, so the next step reprocesses every active row's sequence and rebuilds the cache at
+     * the new batch size; rows that finished leave the batch at that point.
+     *
+     * Not thread-safe, one thread steps a batch at a time.
+     */
+    class GenerationBatch {
+    public:
+        using RowId = U64;
+
+        // Ids are handed out in order, starting at 0
+        RowId AddRow(std::vector<I64> promptTokens, GenerationConfig config);
+
+        size_t GetActiveRowCount() const { return m_activeRows; }
+
+        // Results of the rows that finished since the last call
+        std::vector<std::pair<RowId, GenerationResult>> TakeFinished();
+
+    private:
+        friend class AIModelResource;
+        using Clock = std::chrono::high_resolution_clock;
+
+        struct Row {
+            RowId id{ 0 };
+            std::vector<I64> sequence;              // Prompt + generated, sampler history
+            GenerationConfig config;
+            GenerationResult result;
+            size_t padding{ 0 };                    // Left padding in the current layout
+            size_t steps{ 0 };
+            F32 probabilitySum{ 0.0f };
+            Clock::time_point firstStepEnd;
+            bool done{ false };
+        };
+
+        std::vector<Row> m_rows;                    // Batch layout of the cache, done rows keep their slot until the next prefill
+        std::vector<std::pair<RowId, GenerationResult>> m_finished;
+        std::vector<Ort::Value> m_past;             // Present outputs of the last step
+        size_t m_columns{ 0 };                      // Positions covered by m_past, padding included
+        size_t m_activeRows{ 0 };
+        RowId m_nextRowId{ 0 };
+        bool m_needsPrefill{ true };
+
+        // Tensors wrap these buffers without copying
+        std::vector<I64> m_stepIds;
+        std::vector<I64> m_attentionMask;
+        std::vector<I64> m_positionIds;
+
+        void Finish(Row& row, Clock::time_point now, bool success);
+    };
+
+    // How AIModelResource::Load prepares the session
+    struct AIModelLoadOptions {
+        bool warmup{ true };                            // Dummy inference so the first request skips graph setup
+        bool cacheOptimizedModel{ true };               // Save the optimized graph as <model>.optimized.onnx and load it next time
+    };
+
     // UPDATED: Enhanced model resource for shared architecture
     class AIModelResource : public Angaraka::Core::Resource {
     public:
@@ -37,6 +131,12 @@ namespace Angaraka::AI {
 
         AGK_RESOURCE_TYPE_ID(AIModelResource);
 
+        // The one ONNX Runtime environment every session in the process is created in
+        static Ort::Env& GetEnvironment();
+
+        // Applies to the next Load
+        void SetLoadOptions(const AIModelLoadOptions& options) { m_loadOptions = options; }
+
         // Implement Resource interface
         bool Load(const String& filePath, void* context = nullptr) override;
         void Unload() override;
@@ -48,9 +148,34 @@ namespace Angaraka::AI {
         // NEW: Batch inference for multiple requests (efficient for shared model)
         std::vector<std::vector<Ort::Value>> RunBatchInference(const std::vector<std::vector<Ort::Value>>& batchInputs);
 
+        // Runs on the preallocated tensors of a context made by CreateInferenceContext. A failed
+        // run marks the context invalid, callers fall back to the allocating overload.
+        Scope<InferenceContext> CreateInferenceContext(size_t maxSequenceLength);
+        bool RunInference(InferenceContext& context);
+
         // NEW: Faction-aware inference (adds logging/metrics per faction)
         std::vector<Ort::Value> RunFactionInference(const std::vector<Ort::Value>& inputs, const String& factionId);
 
+        // Autoregressive decoding for causal language models (input_ids in, logits out).
+        // Models exported with past_key_values inputs get their present outputs fed back each
+        // step, so every step after the first processes a single token. Other models are
+        // rerun over the whole sequence each step.
+        GenerationResult Generate(std::span<const I64> promptTokens, const GenerationConfig& config);
+
+        // Generates for several prompts in one session call per step. Prompts are left-padded
+        // to a common length and masked; each row stops on its own config. Needs a model with
+        // position_ids and attention_mask inputs (see SupportsBatchedGeneration).
+        std::vector<GenerationResult> GenerateBatch(const std::vector<std::vector<I64>>& prompts,
+            const std::vector<GenerationConfig>& configs);
+
+        // Gives every active row of the batch one token. Rows that stop move to the batch's
+        // finished results. A failed step fails every active row and returns false.
+        bool StepGeneration(GenerationBatch& batch);
+
+        bool SupportsGeneration();
+        bool SupportsBatchedGeneration();
+        bool SupportsKVCache();
+
         // Getters
         const AIModelMetadata& GetMetadata() const { return m_metadata; }
         bool IsLoaded() const { return m_session != nullptr; }
@@ -64,6 +189,9 @@ namespace Angaraka::AI {
 
         // Performance monitoring
         F32 GetLastInferenceTimeMs() const { return m_lastInferenceTimeMs; }
+        F32 GetSessionLoadTimeMs() const { return m_sessionLoadTimeMs; }
+        F32 GetWarmupTimeMs() const { return m_warmupTimeMs; }
+        bool IsLoadedFromOptimizedCache() const { return m_loadedFromOptimizedCache; }
         size_t GetMemoryUsageMB() const { return m_memoryUsageMB; }
 
         // Resource interface compliance
@@ -86,13 +214,16 @@ namespace Angaraka::AI {
 
     private:
         Scope<Ort::Session> m_session;
-        Scope<Ort::Env> m_environment;
         Scope<Ort::SessionOptions> m_sessionOptions;
         AIModelMetadata m_metadata;
+        AIModelLoadOptions m_loadOptions;
 
         // Performance tracking
         mutable F32 m_lastInferenceTimeMs{ 0.0f };
         mutable size_t m_memoryUsageMB{ 0 };
+        F32 m_sessionLoadTimeMs{ 0.0f };
+        F32 m_warmupTimeMs{ 0.0f };
+        bool m_loadedFromOptimizedCache{ false };
 
         // NEW: Per-faction performance tracking for shared models
         mutable std::unordered_map<String, F32> m_factionInferenceTimes;
@@ -107,7 +238,26 @@ namespace Angaraka::AI {
         std::atomic<bool> m_batchProcessingEnabled{ false };
         size_t m_optimalBatchSize{ 1 };
 
+        // Input/output layout of a causal LM session, resolved on first use
+        struct DecoderLayout {
+            bool resolved{ false };
+            bool valid{ false };
+            std::vector<String> inputNames;
+            std::vector<String> outputNames;
+            I32 inputIdsIndex{ -1 };
+            I32 attentionMaskIndex{ -1 };
+            I32 positionIdsIndex{ -1 };
+            I32 useCacheBranchIndex{ -1 };
+            I32 logitsIndex{ -1 };
+            std::vector<std::pair<size_t, size_t>> pastToPresent;     // past input index -> present output index
+            std::vector<std::vector<I64>> emptyPastShapes;            // batch 1, past length 0
+            std::vector<size_t> pastBatchAxes;                        // Batch axis of each past tensor
+        };
+        DecoderLayout m_decoderLayout;
+
         // Helper methods
+        Scope<Ort::Session> CreateSession(const String& filePath);
+        const DecoderLayout& ResolveDecoderLayout();
         bool LoadMetadata(const String& metadataPath);
         bool ValidateModelInputsOutputs();
         void UpdatePerformanceMetrics(F32 inferenceTimeMs, size_t memoryUsage) const;
@@ -0,0 +1,63 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Public/Angaraka/DialogueTrace.hpp
+#pragma once
+
+#include <Angaraka/Base.hpp>
+#include <chrono>
+
+namespace Angaraka::AI {
+
+    // How a dialogue request was answered
+    enum class DialoguePath : U8 {
+        Fallback,       // No usable model output, a canned line was returned
+        Cached,         // Replayed from the response cache
+        Generated,      // Autoregressive generation through the batcher
+        SinglePass      // One run of a single-pass model
+    };
+
+    inline const char* ToString(DialoguePath path) {
+        switch (path) {
+        case DialoguePath::Cached:     return "cached";
+        case DialoguePath::Generated:  return "generated";
+        case DialoguePath::SinglePass: return "single_pass";
+        default:                       return "fallback";
+        }
+    }
+
+    // Where the time of one dialogue request went. Stages a request skipped stay at zero.
+    struct DialogueTrace {
+        DialoguePath path{ DialoguePath::Fallback };
+        size_t promptTokens{ 0 };
+        size_t outputTokens{ 0 };
+        F32 promptBuildMs{ 0.0f };      // Faction prompt assembly
+        F32 cacheLookupMs{ 0.0f };
+        F32 tokenizeMs{ 0.0f };
+        F32 inputMs{ 0.0f };            // Writing or creating input tensors
+        F32 waitMs{ 0.0f };             // Until the generation batch started
+        F32 inferenceMs{ 0.0f };        // Model runs
+        F32 decodeMs{ 0.0f };           // Tokens to text and faction post-processing
+        F32 totalMs{ 0.0f };
+    };
+
+    // Splits elapsed time into consecutive stages
+    class StageTimer {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // Milliseconds since the previous lap, or since construction for the first
+        F32 Lap() {
+            auto now = Clock::now();
+            F32 elapsed = std::chrono::duration<F32, std::milli>(now - m_lap).count();
+            m_lap = now;
+            return elapsed;
+        }
+
+        F32 TotalMs() const {
+            return std::chrono::duration<F32, std::milli>(Clock::now() - m_start).count();
+        }
+
+    private:
+        Clock::time_point m_start{ Clock::now() };
+        Clock::time_point m_lap{ m_start };
+    };
+
+} // namespace Angaraka::AI
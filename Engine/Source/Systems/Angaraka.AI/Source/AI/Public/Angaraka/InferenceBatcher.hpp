@@ -0,0 +1,144 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Public/Angaraka/InferenceBatcher.hpp
+#pragma once
+
+#include <Angaraka/Base.hpp>
+#include <Angaraka/AIModelResource.hpp>
+#include <Angaraka/InferenceQueue.hpp>
+#include <Angaraka/JobSystem.hpp>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+
+namespace Angaraka::AI {
+
+    struct InferenceBatcherSettings {
+        size_t maxBatchSize{ 8 };       // Requests advanced together in one session call per step
+        F32 maxWaitMs{ 5.0f };          // How long new requests wait for others before joining a KV cache batch
+        size_t maxQueueDepth{ 64 };     // Waiting requests before backpressure kicks in
+    };
+
+    struct InferenceBatcherStats {
+        size_t requests{ 0 };
+        size_t steps{ 0 };
+        F32 averageBatchSize{ 0.0f };   // Requests generating per step
+        F32 p50LatencyMs{ 0.0f };       // Submit to completion, over the last LATENCY_WINDOW requests
+        F32 p99LatencyMs{ 0.0f };
+        size_t expired{ 0 };
+        size_t cancelled{ 0 };
+        size_t rejected{ 0 };           // Turned away at Submit because the queue was full
+        size_t evicted{ 0 };            // Waiting requests displaced by a higher priority one
+    };
+
+    // Who a generation is for and how urgent it is, the same scheduling as an InferenceTask
+    struct GenerationSchedule {
+        String ownerId;                                                             // NPC the request is for, empty if none
+        InferencePriority priority{ InferencePriority::Normal };
+        InferenceTask::Clock::time_point deadline{ InferenceTask::Clock::time_point::max() }; // Dropped if not admitted by then
+    };
+
+    /**
+     * @brief Runs the generation requests of one model as a shared batch on the JobSystem
+     *
+     * Each step of the batch is one job that gives every running request a token through
+     * AIModelResource::StepGeneration, then submits the next step while there is work left.
+     * Queued requests join between steps, up to maxBatchSize, so a short reply does not wait
+     * for a long one that started before it. For a model with a KV cache a join reprocesses
+     * the running sequences, so new requests are held back until they fill the free rows or
+     * the oldest has waited maxWaitMs. Models without batch inputs run one request at a time.
+     *
+     * Waiting requests are admitted like InferenceQueue requests: by priority, then deadline,
+     * then submission order. A request whose deadline passes before it gets a row is dropped,
+     * and with maxQueueDepth requests waiting a new one evicts the request that would be
+     * admitted last if it outranks it and is rejected otherwise. Running requests always finish.
+     *
+     * Completions and drop callbacks run on a job worker and should hand heavy work off.
+     */
+    class InferenceBatcher {
+    public:
+        using Completion = std::function<void(GenerationResult&&)>;
+        using DropCallback = std::function<void(InferenceDropReason)>;
+
+        static constexpr size_t LATENCY_WINDOW = 1024;
+
+        explicit InferenceBatcher(Reference<AIModelResource> model, const InferenceBatcherSettings& settings = InferenceBatcherSettings{});
+        ~InferenceBatcher();
+        DISABLE_COPY_AND_MOVE(InferenceBatcher);
+
+        // The config's sampler and callback are called on a job worker. A request that does not
+        // run gets its drop callback, or a failed result when it has none. Returns false if the
+        // request was rejected; it has been dropped already.
+        bool Submit(std::vector<I64> promptTokens, GenerationConfig config, Completion completion,
+            const GenerationSchedule& schedule = GenerationSchedule{}, DropCallback drop = {});
+        std::future<GenerationResult> Submit(std::vector<I64> promptTokens, GenerationConfig config,
+            const GenerationSchedule& schedule = GenerationSchedule{});
+
+        // Drops the waiting requests of an owner, running ones finish normally
+        size_t CancelForOwner(const String& ownerId);
+
+        // Runs what is already queued and waits for the last step. Later submissions are dropped as cancelled.
+        void Stop();
+
+        void SetSettings(const InferenceBatcherSettings& settings);
+        InferenceBatcherSettings GetSettings() const;
+        InferenceBatcherStats GetStats() const;
+        size_t GetQueuedCount() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct PendingRequest {
+            std::vector<I64> promptTokens;
+            GenerationConfig config;
+            Completion completion;
+            DropCallback drop;
+            GenerationSchedule schedule;
+            Clock::time_point submitTime;
+            U64 sequence;
+        };
+
+        struct RunningRequest {
+            GenerationBatch::RowId row;
+            Completion completion;
+            Clock::time_point submitTime;
+        };
+
+        Reference<AIModelResource> m_model;
+        InferenceBatcherSettings m_settings;
+        bool m_canBatch{ false };
+        bool m_usesKVCache{ false };
+        Core::JobHandle m_jobs = CreateReference<Core::JobCounter>();
+
+        mutable std::mutex m_mutex;
+        std::vector<PendingRequest> m_waiting;  // Small and bounded, scanned linearly
+        std::vector<RunningRequest> m_running;  // At most maxBatchSize
+        U64 m_nextSequence{ 0 };
+        bool m_stepScheduled{ false };          // A step job is queued or running
+        bool m_stopping{ false };
+
+        // Only touched by the step job, of which there is one at a time
+        GenerationBatch m_batch;
+
+        // Stats, guarded by m_mutex
+        InferenceBatcherStats m_stats;          // Counters only, the rest is computed by GetStats
+        size_t m_rowSteps{ 0 };
+        std::array<F32, LATENCY_WINDOW> m_latencies{};
+        size_t m_latencyCount{ 0 };
+
+        void SubmitStep();
+        void StepJob();
+
+        // Returns true while requests are running or queued
+        bool RunStep();
+
+        static bool RunsBefore(const PendingRequest& a, const PendingRequest& b);
+
+        // Called with m_mutex held
+        void CollectExpired(Clock::time_point now, std::vector<PendingRequest>& dropped);
+        void Admit(Clock::time_point now, std::vector<PendingRequest>& expired);
+
+        static void Drop(std::vector<PendingRequest>& requests, InferenceDropReason reason);
+    };
+
+} // namespace Angaraka::AI
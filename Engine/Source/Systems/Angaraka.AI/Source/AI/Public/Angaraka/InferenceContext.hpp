@@ -0,0 +1,123 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Public/Angaraka/InferenceContext.hpp
+#pragma once
+
+#include <Angaraka/Base.hpp>
+#include <onnxruntime_cxx_api.h>
+#include <mutex>
+#include <span>
+
+namespace Angaraka::AI {
+
+    /**
+     * @brief Preallocated, pre-bound tensors for repeated runs of one model
+     *
+     * All inputs and outputs live in a single arena allocated up front for maxSequenceLength
+     * positions. Dynamic dimensions are resolved as batch 1 on the first axis and the sequence
+     * length on the others. A run is padded to the next power of two length bucket (at least
+     * 16, at most maxSequenceLength) and every bucket gets its own IoBinding over the same
+     * arena, created the first time the bucket is used. Once the buckets in use exist, a run
+     * allocates nothing: callers write inputs in place and read outputs as spans.
+     *
+     * Padding positions read as zero, so the attention mask hides them. Created by
+     * AIModelResource::CreateInferenceContext and run by AIModelResource::RunInference; must be
+     * destroyed before the model is unloaded. Not thread-safe, hold Lock() from Prepare until
+     * the outputs have been read.
+     */
+    class InferenceContext {
+    public:
+        InferenceContext(Ort::Session& session, size_t maxSequenceLength);
+        ~InferenceContext();
+        DISABLE_COPY_AND_MOVE(InferenceContext);
+
+        // False if the model has tensors that cannot be preallocated, or a bound run failed
+        bool IsValid() const { return m_valid; }
+        size_t GetMaxSequenceLength() const { return m_maxSequenceLength; }
+        size_t GetArenaBytes() const { return m_arenaBytes; }
+
+        [[nodiscard]] std::unique_lock<std::mutex> Lock() { return std::unique_lock<std::mutex>(m_mutex); }
+
+        // Selects the bucket for sequenceLength valid positions and zeroes the inputs
+        bool Prepare(size_t sequenceLength);
+        size_t GetSequenceLength() const { return m_sequenceLength; }
+
+        size_t GetInputCount() const { return m_inputs.size(); }
+        size_t GetOutputCount() const { return m_outputs.size(); }
+        const String& GetInputName(size_t index) const { return m_inputs[index].name; }
+        const String& GetOutputName(size_t index) const { return m_outputs[index].name; }
+        ONNXTensorElementDataType GetInputType(size_t index) const { return m_inputs[index].type; }
+        ONNXTensorElementDataType GetOutputType(size_t index) const { return m_outputs[index].type; }
+        bool HasSequenceAxis(size_t inputIndex) const { return m_inputs[inputIndex].sequenceAxis >= 0; }
+
+        // Whole input at the prepared length, empty if T does not match the element type
+        template<typename T>
+        std::span<T> GetInput(size_t index) {
+            return ElementsAs<T>(m_inputs[index], m_inputs[index].elementCount);
+        }
+
+        // Output of the last run, trimmed to the valid positions when they are contiguous
+        template<typename T>
+        std::span<const T> GetOutput(size_t index) const {
+            return ElementsAs<const T>(m_outputs[index], m_outputs[index].validCount);
+        }
+
+        // Shape matching GetOutput
+        std::span<const I64> GetOutputShape(size_t index) const { return m_outputs[index].validShape; }
+        const void* GetOutputRawData(size_t index) const { return m_arena.get() + m_outputs[index].offset; }
+
+    private:
+        friend class AIModelResource;
+
+        struct Tensor {
+            String name;
+            ONNXTensorElementDataType type{ ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED };
+            size_t elementSize{ 0 };            // Bytes
+            std::vector<I64> maxShape;          // Sequence axis at maxSequenceLength
+            I32 sequenceAxis{ -1 };
+            bool trimmable{ false };            // Valid positions form a prefix of the buffer
+            size_t offset{ 0 };                 // Into the arena
+            size_t elementCount{ 0 };           // At the prepared length
+            size_t validCount{ 0 };
+            std::vector<I64> validShape;
+        };
+
+        struct Binding {
+            Ort::IoBinding binding;
+            std::vector<Ort::Value> values;     // Views into the arena, kept alive while bound
+            explicit Binding(Ort::Session& session) : binding(session) {}
+        };
+
+        Ort::Session& m_session;
+        Ort::MemoryInfo m_memoryInfo;
+        std::mutex m_mutex;
+        size_t m_maxSequenceLength;
+        bool m_valid{ false };
+
+        std::vector<Tensor> m_inputs;
+        std::vector<Tensor> m_outputs;
+        std::unique_ptr<std::byte[]> m_arena;
+        size_t m_arenaBytes{ 0 };
+
+        std::vector<Scope<Binding>> m_bindings; // One slot per length bucket
+        Binding* m_active{ nullptr };
+        size_t m_sequenceLength{ 0 };
+        size_t m_paddedLength{ 0 };
+
+        bool DescribeTensor(Tensor& tensor, const Ort::TypeInfo& typeInfo);
+        void Resize(Tensor& tensor, size_t length, size_t validLength) const;
+        size_t BucketIndex(size_t length) const;
+        size_t BucketLength(size_t bucket) const;
+        Scope<Binding> CreateBinding(size_t length);
+
+        // Runs the active binding, called by AIModelResource with its session lock held
+        void Run(const Ort::RunOptions& options);
+
+        template<typename T>
+        std::span<T> ElementsAs(const Tensor& tensor, size_t count) const {
+            if (Ort::TypeToTensorType<std::remove_const_t<T>>::type != tensor.type || !m_arena) {
+                return {};
+            }
+            return std::span<T>(reinterpret_cast<T*>(m_arena.get() + tensor.offset), count);
+        }
+    };
+
+} // namespace Angaraka::AI
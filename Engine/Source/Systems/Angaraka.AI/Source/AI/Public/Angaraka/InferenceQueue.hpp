@@ -0,0 +1,115 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Public/Angaraka/InferenceQueue.hpp
+#pragma once
+
+#include <Angaraka/Base.hpp>
+#include <Angaraka/JobSystem.hpp>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Angaraka::AI {
+
+    // Scheduling class of an inference request, lower values run first
+    enum class InferencePriority : U8 {
+        Conversation = 0,   // The player is in this conversation and waiting on the reply
+        Normal,             // NPC behavior decisions and ambient dialogue
+        Background          // Terrain and other work nobody is waiting on
+    };
+
+    enum class InferenceDropReason : U8 {
+        Cancelled,          // Cancelled by owner or on shutdown
+        Expired,            // Deadline passed before a slot picked it up
+        QueueFull           // Rejected or evicted by backpressure
+    };
+
+    struct InferenceQueueSettings {
+        size_t maxConcurrent{ 2 };                  // Requests running at once, each occupies a job worker
+        size_t maxQueueDepth{ 64 };                 // Waiting requests before backpressure kicks in
+        size_t reservedConversationSlots{ 1 };      // Slots only Conversation requests may use
+    };
+
+    struct InferenceQueueStats {
+        size_t queued{ 0 };
+        size_t running{ 0 };
+        size_t executed{ 0 };
+        size_t expired{ 0 };
+        size_t cancelled{ 0 };
+        size_t rejected{ 0 };       // Turned away at Submit because the queue was full
+        size_t evicted{ 0 };        // Waiting requests displaced by a higher priority one
+    };
+
+    struct InferenceTask {
+        using Clock = std::chrono::steady_clock;
+
+        String ownerId;                                         // NPC the request is for, empty if none
+        InferencePriority priority{ InferencePriority::Normal };
+        Clock::time_point deadline{ Clock::time_point::max() }; // Dropped if not started by then
+        std::function<void()> run;
+        std::function<void(InferenceDropReason)> drop;          // Fulfils the request when it will not run
+    };
+
+    /**
+     * @brief Bounded priority queue in front of the AI models
+     *
+     * Requests wait here until one of maxConcurrent slots is free, then run as jobs on the
+     * shared JobSystem. Which request runs is decided when a slot frees up, not when it is
+     * submitted: Conversation before Normal before Background, earliest deadline first within a
+     * priority, then submission order. Requests whose deadline has passed are dropped without
+     * running, and reservedConversationSlots slots are kept free of lower priority work so a
+     * conversation reply never waits behind a batch of behavior evaluations.
+     *
+     * When maxQueueDepth requests are waiting, a new request evicts the lowest priority
+     * waiting one if it outranks it and is rejected otherwise. Every request that does not
+     * run gets its drop callback, so futures are always fulfilled.
+     */
+    class InferenceQueue {
+    public:
+        explicit InferenceQueue(const InferenceQueueSettings& settings = InferenceQueueSettings{});
+        ~InferenceQueue();
+        DISABLE_COPY_AND_MOVE(InferenceQueue);
+
+        // Returns false if the request was rejected; its drop callback has been called
+        bool Submit(InferenceTask task);
+
+        // Drops the waiting requests of an owner, running ones finish normally
+        size_t CancelForOwner(const String& ownerId);
+
+        // Drops everything waiting and waits for running requests. Later submissions are rejected.
+        void Shutdown();
+
+        // True once a Background or Normal request would be rejected, callers can hold off
+        bool IsSaturated() const;
+
+        InferenceQueueStats GetStats() const;
+        InferenceQueueSettings GetSettings() const;
+
+    private:
+        struct Entry {
+            InferenceTask task;
+            U64 sequence;
+        };
+
+        InferenceQueueSettings m_settings;
+        Core::JobHandle m_jobs = CreateReference<Core::JobCounter>();
+
+        mutable std::mutex m_mutex;
+        std::vector<Entry> m_waiting;       // Small and bounded, scanned linearly
+        U64 m_nextSequence{ 0 };
+        size_t m_dispatched{ 0 };           // Jobs submitted that have not picked a request yet
+        size_t m_running{ 0 };
+        size_t m_runningLowPriority{ 0 };   // Running requests that are not Conversation
+        bool m_shutdown{ false };
+        InferenceQueueStats m_stats;
+
+        static bool RunsBefore(const Entry& a, const Entry& b);
+
+        // Called with m_mutex held
+        void CollectExpired(std::vector<Entry>& dropped);
+        void Dispatch();
+
+        void RunNext();
+        static void Drop(std::vector<Entry>& entries, InferenceDropReason reason);
+    };
+
+} // namespace Angaraka::AI
@@ -0,0 +1,109 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Public/Angaraka/ResponseCache.hpp
+#pragma once
+
+#include <Angaraka/Base.hpp>
+#include <Angaraka/Sampler.hpp>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace Angaraka::AI {
+
+    struct ResponseCacheSettings {
+        size_t memoryBudgetBytes{ 4 * 1024 * 1024 };
+        F32 timeToLiveSeconds{ 600.0f };        // 0 = entries only leave through the budget
+    };
+
+    struct ResponseCacheStats {
+        size_t hits{ 0 };
+        size_t misses{ 0 };
+        size_t entries{ 0 };
+        size_t memoryBytes{ 0 };
+        size_t evictions{ 0 };                  // Dropped to stay within the budget
+        size_t expirations{ 0 };                // Dropped because their TTL ran out
+    };
+
+    struct FactionCacheStats {
+        size_t hits{ 0 };
+        size_t misses{ 0 };
+    };
+
+    // The parts of a dialogue response worth replaying
+    struct CachedDialogue {
+        String response;
+        String emotionalTone;
+        std::vector<String> suggestedPlayerResponses;
+        F32 confidence{ 0.0f };
+    };
+
+    /**
+     * @brief Content-addressed cache of generated dialogue
+     *
+     * Entries are keyed on a 64-bit hash of (model id, faction, normalized prompt, sampling
+     * params, token budget). Generation is seeded from HashPrompt, the same normalized prompt,
+     * so equal keys sample alike and replaying the stored response stands in for a new one. Entries are evicted least recently
+     * used first once the memory budget is exceeded and expire after the TTL. Hits and misses
+     * are counted per faction.
+     *
+     * Thread-safe. Can be saved to and loaded from a JSON file to survive between sessions.
+     */
+    class ResponseCache {
+    public:
+        using Key = U64;
+
+        explicit ResponseCache(const ResponseCacheSettings& settings = ResponseCacheSettings{});
+        ~ResponseCache() = default;
+        DISABLE_COPY_AND_MOVE(ResponseCache);
+
+        static Key MakeKey(std::string_view modelId, std::string_view factionId, std::string_view prompt,
+            const SamplingParams& sampling, size_t maxTokens);
+
+        // Lower case, whitespace runs collapsed to one space, trimmed
+        static String NormalizePrompt(std::string_view prompt);
+
+        // Hash of the normalized prompt, for seeding the sampler of a cacheable generation
+        static U64 HashPrompt(std::string_view prompt);
+
+        bool TryGet(Key key, const String& factionId, CachedDialogue& result);
+        void Put(Key key, const String& factionId, CachedDialogue value);
+        void Clear();
+
+        // Persistence. Load merges into the current contents and skips expired entries.
+        bool Save(const String& path) const;
+        bool Load(const String& path);
+
+        void SetSettings(const ResponseCacheSettings& settings);
+        ResponseCacheSettings GetSettings() const;
+        ResponseCacheStats GetStats() const;
+        FactionCacheStats GetFactionStats(const String& factionId) const;
+
+    private:
+        using WallClock = std::chrono::system_clock;     // Expiry survives a save/load
+
+        struct Entry {
+            Key key;
+            String factionId;
+            CachedDialogue value;
+            WallClock::time_point expires;
+            size_t bytes;
+        };
+
+        mutable std::mutex m_mutex;
+        ResponseCacheSettings m_settings;
+        std::list<Entry> m_entries;                     // Most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator> m_index;
+        std::unordered_map<String, FactionCacheStats> m_factionStats;
+        ResponseCacheStats m_stats;
+
+        static size_t EstimateBytes(const Entry& entry);
+        WallClock::time_point ExpiryFromNow() const;
+
+        // Called with m_mutex held
+        void Insert(Entry&& entry);
+        void Erase(std::list<Entry>::iterator it);
+        void EnforceBudget();
+    };
+
+} // namespace Angaraka::AI
@@ -0,0 +1,86 @@
+// Engine/Source/Systems/Angaraka.AI/Source/AI/Public/Angaraka/Sampler.hpp
+#pragma once
+
+#include <Angaraka/Base.hpp>
+#include <Angaraka/AIModelResource.hpp>
+#include <onnxruntime_cxx_api.h>
+#include <random>
+#include <span>
+
+namespace Angaraka::AI {
+
+    // Token selection settings, the defaults sample from the unmodified distribution
+    struct SamplingParams {
+        F32 temperature{ 1.0f };            // <= 0 picks the most likely token (greedy)
+        U32 topK{ 0 };                      // Keep only the K most likely tokens, 0 = all
+        F32 topP{ 1.0f };                   // Keep the smallest set of tokens with this much probability mass
+        F32 repetitionPenalty{ 1.0f };      // >= 1, divides positive / multiplies negative logits of recent tokens
+        size_t repetitionWindow{ 64 };      // How many trailing tokens of the sequence are penalized
+        U64 seed{ 0x5EED };
+    };
+
+    // View of one row of a logits tensor shaped [..., vocab]; no copy is made
+    std::span<const F32> GetLogitsRow(const Ort::Value& logits, size_t row);
+    std::span<const F32> GetLastLogitsRow(const Ort::Value& logits);
+    size_t GetLogitsRowCount(const Ort::Value& logits);
+
+    /**
+     * @brief Picks tokens from logits with temperature, top-k, top-p and repetition penalty
+     *
+     * Works on a span over the tensor memory. Only the candidate tokens are gathered
+     * (top-k, or as many as the nucleus needs), and the softmax/log-softmax is computed
+     * over those. The full vocabulary is only scanned, never copied. Seeded, so a given
+     * seed and input always produce the same tokens.
+     *
+     * Not thread-safe, use one sampler per generation.
+     */
+    class LogitsSampler {
+    public:
+        explicit LogitsSampler(const SamplingParams& params = SamplingParams{});
+
+        // Picks the next token. history is the sequence so far, used for the repetition penalty.
+        I64 Sample(std::span<const F32> logits, std::span<const I64> history = {});
+
+        // Log-probability of the last sampled token under the filtered distribution
+        F32 GetLastLogProbability() const { return m_lastLogProbability; }
+
+        void Reseed(U64 seed) { m_rng.seed(seed); }
+        const SamplingParams& GetParams() const { return m_params; }
+
+        // Adapter for GenerationConfig::sampler, the sampler must outlive the generation
+        TokenSampler AsTokenSampler() {
+            return [this](std::span<const F32> logits, std::span<const I64> sequence) {
+                I64 token = Sample(logits, sequence);
+                return SampledToken{ token, m_lastLogProbability };
+            };
+        }
+
+        // Index of the largest logit, first one on ties (SSE when available)
+        static I64 ArgMax(std::span<const F32> logits);
+
+        // Log of the softmax normalizer, log(sum(exp(logits))), without allocating
+        static F32 LogSumExp(std::span<const F32> logits);
+
+    private:
+        struct Candidate {
+            I32 id;
+            F32 logit;      // After penalty and temperature
+        };
+
+        SamplingParams m_params;
+        std::mt19937_64 m_rng;
+        F32 m_lastLogProbability{ 0.0f };
+
+        // Scratch reused across calls
+        std::vector<Candidate> m_candidates;
+        std::vector<std::pair<I32, F32>> m_penalized;   // Token id, penalized logit
+
+        void CollectPenalties(std::span<const F32> logits, std::span<const I64> history);
+        F32 Adjusted(std::span<const F32> logits, I32 id) const;
+        void SelectTop(std::span<const F32> logits, size_t count);
+        F32 LogNormalizer(std::span<const F32> logits) const;
+        I64 SampleFullVocabulary(std::span<const F32> logits);
+        I64 SampleCandidates(F32 logNormalizer);
+    };
+
+} // namespace Angaraka::AI
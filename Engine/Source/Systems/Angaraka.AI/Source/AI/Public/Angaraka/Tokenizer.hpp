@@ -2,10 +2,32 @@
 
 #include "Angaraka/AIBase.hpp"
 #include <nlohmann/json.hpp>
+#include <array>
+#include <list>
+#include <string_view>
 
 namespace Angaraka::AI {
 
-    // Tokenizer for decoding model outputs to text
+    // Single-pass cleanup of decoded text: maps stray BPE markers (Ġ, Ċ), collapses runs of
+    // spaces and of more than two newlines, and trims leading/trailing whitespace. Trailing
+    // whitespace is held back until more text arrives, so the same cleaner serves both
+    // whole-string and streaming decode.
+    class DecodedTextCleaner {
+    public:
+        // Appends the cleaned form of complete UTF-8 text to out
+        void Append(std::string_view text, std::string& out);
+        void Reset();
+
+    private:
+        std::string m_heldWhitespace;
+        char m_last = '\0';
+        char m_beforeLast = '\0';
+        bool m_started = false;
+
+        void Put(char c, std::string& out);
+    };
+
+    // Tokenizer for encoding prompts and decoding model outputs to text
     class Tokenizer {
     public:
         Tokenizer() = default;
@@ -16,18 +38,42 @@ namespace Angaraka::AI {
         bool LoadSpecialTokens(const std::string& specialTokensFilePath);
         bool LoadTokenizer(const std::string& vocabFilePath, const std::string& specialTokensFilePath);
 
+        // BPE merge rules, either a merges.txt ("left right" per line) or a tokenizer.json
+        // with a "model.merges" array. Must be loaded after the vocabulary.
+        bool LoadMerges(const std::string& mergesFilePath);
+
+        // Text encoding (byte-level BPE, GPT-2 style pre-tokenization)
+        // Special token strings found in the text are emitted as their ids.
+        std::vector<int64_t> Encode(std::string_view text);
+        bool CanEncode() const { return m_vocabularyLoaded && m_mergesLoaded; }
+
         // Text decoding
         std::string DecodeTokens(const std::vector<int64_t>& tokenIds);
         std::string DecodeToken(int64_t tokenId);
 
+        // Raw decoded bytes of a token from the table built at load time ("<unk>" if unknown).
+        // May end in the middle of a multi-byte UTF-8 character.
+        std::string_view DecodeTokenBytes(int64_t tokenId) const;
+
+        // EOS/BOS/PAD tokens are dropped from decoded text
+        bool IsSkippedOnDecode(int64_t tokenId) const {
+            return tokenId == m_eosTokenId || tokenId == m_bosTokenId || tokenId == m_padTokenId;
+        }
+
         // Token information
         bool IsSpecialToken(int64_t tokenId) const;
         bool IsEndOfTextToken(int64_t tokenId) const;
         std::string GetSpecialTokenName(int64_t tokenId) const;
+        int64_t GetEosTokenId() const { return m_eosTokenId; }
 
         // Validation
         bool IsLoaded() const { return m_vocabularyLoaded && m_specialTokensLoaded; }
         size_t GetVocabularySize() const { return m_idToToken.size(); }
+        size_t GetMergeCount() const { return m_mergeRules.size(); }
+
+        // Cache of encoded pre-tokenized words, least recently used words are evicted first
+        void SetEncodeCacheCapacity(size_t capacity);
+        size_t GetEncodeCacheSize() const;
 
         // Cleanup and formatting
         std::string CleanDecodedText(const std::string& rawText) const;
@@ -47,15 +93,67 @@ namespace Angaraka::AI {
         int64_t m_padTokenId = -1;        // Padding token
         int64_t m_unkTokenId = -1;        // Unknown token
 
+        // BPE merge rules, keyed by (left id << 32 | right id)
+        struct MergeRule {
+            int32_t rank;
+            int64_t mergedId;
+        };
+        std::unordered_map<uint64_t, MergeRule> m_mergeRules;
+
+        // Decoded bytes of token id i are m_decodedBytes[m_decodeOffsets[i], m_decodeOffsets[i + 1]),
+        // valid only where m_decodeKnown[i] is set
+        std::string m_decodedBytes;
+        std::vector<uint32_t> m_decodeOffsets;
+        std::vector<uint8_t> m_decodeKnown;
+
+        // Vocabulary id of each raw byte's printable stand-in (-1 if the vocabulary lacks it)
+        std::array<int64_t, 256> m_byteToId{};
+
+        // Encoded words, most recently used at the front
+        using EncodeCacheEntry = std::pair<std::string, std::vector<int64_t>>;
+        std::list<EncodeCacheEntry> m_encodeCacheOrder;
+        std::unordered_map<std::string_view, std::list<EncodeCacheEntry>::iterator> m_encodeCache;
+        size_t m_encodeCacheCapacity = 4096;
+        mutable std::mutex m_encodeCacheMutex;
+
         // State
         bool m_vocabularyLoaded = false;
         bool m_specialTokensLoaded = false;
+        bool m_mergesLoaded = false;
 
         // Helper methods
         bool ParseVocabularyJson(const nlohmann::json& vocabJson);
         bool ParseSpecialTokensJson(const nlohmann::json& specialJson);
         std::string HandleSpecialCharacters(const std::string& tokenText) const;
         std::string ProcessBPEToken(const std::string& token) const;
+        void BuildDecodeTable();
+
+        // Encoding helpers
+        void BuildByteTable();
+        void EncodeSegment(std::string_view text, std::vector<int64_t>& out);
+        void EncodeWord(std::string_view word, std::vector<int64_t>& out);
+        void ApplyMerges(std::string_view word, std::vector<int64_t>& out) const;
+        void ClearEncodeCache();
+    };
+
+    // Incremental decoder for showing generated text token by token. Push returns only text
+    // that is final: complete UTF-8 characters, cleaned exactly as DecodeTokens would.
+    class TokenStreamDecoder {
+    public:
+        explicit TokenStreamDecoder(std::shared_ptr<const Tokenizer> tokenizer);
+
+        // Text that became final with this token (may be empty)
+        std::string Push(int64_t tokenId);
+
+        // Ends the stream and returns anything still pending
+        std::string Flush();
+
+        void Reset();
+
+    private:
+        std::shared_ptr<const Tokenizer> m_tokenizer;
+        std::string m_pendingBytes;      // Incomplete UTF-8 character split across tokens
+        DecodedTextCleaner m_cleaner;
     };
 
     // Tokenizer factory for creating faction-specific tokenizers
@@ -19,19 +19,28 @@ struct PS_INPUT
 // Constant Buffer for MVP matrix
 cbuffer ModelViewProjection : register(b0)
 {
-    float4x4 model; // World transformation matrix
+    float4x4 model; // Unused, world matrices come from g_Instances
     float4x4 view; // Camera transformation matrix
     float4x4 projection; // Projection transformation matrix
 };
 
-PS_INPUT VSMain(VS_INPUT input)
+// Per-instance data, matches Angaraka::Graphics::InstanceData.
+// Bound at the first instance of the current batch, so SV_InstanceID indexes it directly.
+struct InstanceData
+{
+    float4x4 world;
+};
+StructuredBuffer<InstanceData> g_Instances : register(t1);
+
+PS_INPUT VSMain(VS_INPUT input, uint instanceID : SV_InstanceID)
 {
     PS_INPUT output;
+    float4x4 world = g_Instances[instanceID].world;
     // Apply transformations in the correct order: Model -> View -> Projection
     // Note: HLSL mul(A, B) performs A * B if A is row vector, B is column vector.
     // For matrices, it's typically vector * matrix (row-major).
     // So, position * model * view * projection.
-    output.position = mul(mul(mul(float4(input.position, 0.5f), model), view), projection);
+    output.position = mul(mul(mul(float4(input.position, 0.5f), world), view), projection);
     output.color = input.color; // Pass the interpolated color to the pixel shader
     output.texCoord = input.texCoord;
 
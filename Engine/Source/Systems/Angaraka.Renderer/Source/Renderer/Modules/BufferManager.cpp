@@ -5,10 +5,15 @@ module;
 
 // Includes for internal implementation details
 #include "Angaraka/GraphicsBase.hpp"
+#include <algorithm>
+#include <bit>
 #include <stdexcept>
 
 module Angaraka.Graphics.DirectX12.BufferManager;
 
+import Angaraka.Graphics.InstanceBatcher;
+import Angaraka.Graphics.UploadRing;
+
 namespace {
 
     const Angaraka::Graphics::DirectX12::Vertex cubeVertices[] = {
@@ -71,6 +76,9 @@ namespace {
     const UINT vertexBufferSize = sizeof(cubeVertices);
     const UINT indexBufferSize = sizeof(cubeIndices);
     const UINT numIndicesInArray = _countof(cubeIndices);
+
+    const UINT64 initialUploadRingSize = 4 * 1024 * 1024;
+    const UINT64 instanceDataAlignment = 16;
 } // anonymous namespace
 
 
@@ -82,14 +90,14 @@ namespace Angaraka::Graphics::DirectX12 {
 
     BufferManager::~BufferManager() {
         AGK_INFO("BufferManager: Destructor called.");
-        if (m_mvpConstantBuffer && m_pCbvDataBegin) {
-            m_mvpConstantBuffer->Unmap(0, nullptr);
-            m_pCbvDataBegin = nullptr;
+        if (m_uploadBuffer && m_pUploadDataBegin) {
+            m_uploadBuffer->Unmap(0, nullptr);
+            m_pUploadDataBegin = nullptr;
         }
     }
 
     bool BufferManager::Initialize(ID3D12Device* device) {
-        AGK_INFO("BufferManager: Creating Vertex, Index, and Constant Buffers...");
+        AGK_INFO("BufferManager: Creating Vertex, Index, and Upload Buffers...");
         m_device = device;
 
         // --- Create Vertex Buffer ---
@@ -143,36 +151,101 @@ namespace Angaraka::Graphics::DirectX12 {
         NAME_D3D12_OBJECT(m_indexBuffer, "Index Buffer");
 
 
-        // --- Create Constant Buffer ---
-        // Constant buffers must be 256-byte aligned.
-        const UINT constantBufferSize = (sizeof(MVPConstantBuffer) + 255) & ~255;
+        // --- Create Upload Ring ---
+        // Per-frame constants and instance data are suballocated from here
+        if (!CreateUploadBuffer(initialUploadRingSize)) {
+            return false;
+        }
 
-        CD3DX12_HEAP_PROPERTIES cbHeapProps(D3D12_HEAP_TYPE_UPLOAD);
-        CD3DX12_RESOURCE_DESC cbResourceDesc = CD3DX12_RESOURCE_DESC::Buffer(constantBufferSize);
+        return true;
+    }
 
-        DXCall(m_device->CreateCommittedResource(
-            &cbHeapProps,
-            D3D12_HEAP_FLAG_NONE,
-            &cbResourceDesc,
-            D3D12_RESOURCE_STATE_GENERIC_READ, // Upload heap resources must be in this state
-            nullptr,
-            IID_PPV_ARGS(&m_mvpConstantBuffer)));
+    D3D12_GPU_VIRTUAL_ADDRESS BufferManager::AllocateConstants(const void* data, size_t size) {
+        // CBVs cover whole 256-byte blocks, so the padding is reserved too
+        const UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT;
+        D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+        if (UINT8* cpuAddress = Allocate((size + alignment - 1) & ~(alignment - 1), alignment, gpuAddress)) {
+            memcpy(cpuAddress, data, size);
+        }
+        return gpuAddress;
+    }
 
-        // Map the constant buffer. We don't unmap this until the app closes.
-        DXCall(m_mvpConstantBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_pCbvDataBegin)));
-        AGK_INFO("BufferManager: Constant Buffer Created and Mapped.");
-        NAME_D3D12_OBJECT(m_mvpConstantBuffer, "MVP Constant Buffer");
+    D3D12_GPU_VIRTUAL_ADDRESS BufferManager::WriteInstances(std::span<const InstanceData> instances) {
+        D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+        if (UINT8* cpuAddress = Allocate(instances.size_bytes(), instanceDataAlignment, gpuAddress)) {
+            memcpy(cpuAddress, instances.data(), instances.size_bytes());
+        }
+        return gpuAddress;
+    }
 
-        return true;
+    void BufferManager::FinishFrame(UINT64 fenceValue) {
+        m_uploadRing.FinishFrame(fenceValue);
+        for (RetiredUploadBuffer& retired : m_retiredUploadBuffers) {
+            if (!retired.frameFinished) {
+                retired.fenceValue = fenceValue;
+                retired.frameFinished = true;
+            }
+        }
     }
 
-    void BufferManager::UpdateConstantBuffer(const MVPConstantBuffer& data) {
-        if (m_pCbvDataBegin) {
-            memcpy(m_pCbvDataBegin, &data, sizeof(MVPConstantBuffer));
+    void BufferManager::RetireFrames(UINT64 completedFenceValue) {
+        m_uploadRing.Retire(completedFenceValue);
+        std::erase_if(m_retiredUploadBuffers, [completedFenceValue](const RetiredUploadBuffer& retired) {
+            return retired.frameFinished && retired.fenceValue <= completedFenceValue;
+        });
+    }
+
+    UINT8* BufferManager::Allocate(UINT64 size, UINT64 alignment, D3D12_GPU_VIRTUAL_ADDRESS& gpuAddress) {
+        if (size == 0) {
+            return nullptr;
+        }
+
+        UINT64 offset = m_uploadRing.Allocate(size, alignment);
+        if (offset == UploadRingAllocator::INVALID_OFFSET) {
+            // Frames in flight (this one included) still read the old buffer, keep it until they retire
+            if (m_uploadBuffer) {
+                m_uploadBuffer->Unmap(0, nullptr);
+                m_retiredUploadBuffers.push_back({ std::move(m_uploadBuffer), 0, false });
+            }
+            m_pUploadDataBegin = nullptr;
+
+            if (!CreateUploadBuffer(std::bit_ceil(std::max(m_uploadRing.GetCapacity() * 2, size + alignment)))) {
+                return nullptr;
+            }
+            offset = m_uploadRing.Allocate(size, alignment);
         }
-        else {
-            AGK_ERROR("BufferManager: Attempted to update unmapped constant buffer.");
+
+        gpuAddress = m_uploadBuffer->GetGPUVirtualAddress() + offset;
+        return m_pUploadDataBegin + offset;
+    }
+
+    bool BufferManager::CreateUploadBuffer(UINT64 capacity) {
+        CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+        CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(capacity);
+
+        HRESULT hr = m_device->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(&m_uploadBuffer));
+        if (FAILED(hr)) {
+            AGK_ERROR("BufferManager: Failed to create a {0} byte upload ring (HRESULT {1:#x}).",
+                capacity, static_cast<U32>(hr));
+            m_uploadBuffer.Reset();
+            m_uploadRing.Reset(0);
+            return false;
         }
+
+        CD3DX12_RANGE readRange(0, 0); // We do not intend to read from this resource on the CPU.
+        DXCall(m_uploadBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_pUploadDataBegin)));
+        NAME_D3D12_OBJECT(m_uploadBuffer, "Upload Ring");
+
+        // A fresh buffer has nothing in flight, older frames are tracked by the retired one
+        m_uploadRing.Reset(capacity);
+        AGK_INFO("BufferManager: Upload Ring Created and Mapped. {0} bytes.", capacity);
+        return true;
     }
 
 } // namespace Angaraka::Graphics::DirectX12
\ No newline at end of file
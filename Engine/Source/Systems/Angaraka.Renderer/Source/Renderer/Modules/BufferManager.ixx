@@ -3,9 +3,14 @@ module;
 // Module for managing D3D12 vertex, index, and constant buffers.
 
 #include "Angaraka/GraphicsBase.hpp"
+#include <span>
+#include <vector>
 
 export module Angaraka.Graphics.DirectX12.BufferManager;
 
+import Angaraka.Graphics.InstanceBatcher;
+import Angaraka.Graphics.UploadRing;
+
 namespace Angaraka::Graphics::DirectX12 {
 
     export class BufferManager {
@@ -13,7 +18,7 @@ namespace Angaraka::Graphics::DirectX12 {
         BufferManager();
         ~BufferManager();
 
-        // Initializes the buffers (vertex, index, constant).
+        // Initializes the buffers (vertex, index, upload ring).
         // Requires the D3D12 device.
         bool Initialize(ID3D12Device* device);
 
@@ -21,17 +26,31 @@ namespace Angaraka::Graphics::DirectX12 {
         const D3D12_VERTEX_BUFFER_VIEW& GetVertexBufferView() const { return m_vertexBufferView; }
         const D3D12_INDEX_BUFFER_VIEW& GetIndexBufferView() const { return m_indexBufferView; }
 
-        // Accessor for the GPU virtual address of the constant buffer.
-        D3D12_GPU_VIRTUAL_ADDRESS GetConstantBufferGPUAddress() const {
-            return m_mvpConstantBuffer->GetGPUVirtualAddress();
-        }
-
-        // Method to update the constant buffer data.
-        void UpdateConstantBuffer(const MVPConstantBuffer& data);
-
         // Accessor for the number of indices to draw.
         unsigned int GetNumIndices() const { return m_numIndices; }
 
+        // --- Per-frame upload ring ---
+        // Constants and instance data are suballocated from one persistently mapped upload buffer,
+        // so every draw reads its own copy. A frame's region is recycled once the GPU has passed
+        // the fence signaled after that frame's command list.
+
+        // Copies data into a 256-byte aligned suballocation and returns its GPU address for a CBV,
+        // or 0 if the ring could not be grown.
+        D3D12_GPU_VIRTUAL_ADDRESS AllocateConstants(const void* data, size_t size);
+
+        template<typename T>
+        D3D12_GPU_VIRTUAL_ADDRESS AllocateConstants(const T& data) { return AllocateConstants(&data, sizeof(T)); }
+
+        // Copies instances into a suballocation and returns the GPU address of the first one,
+        // bound as a structured buffer (t1) by the vertex shader, or 0 on failure.
+        D3D12_GPU_VIRTUAL_ADDRESS WriteInstances(std::span<const InstanceData> instances);
+
+        // Ties everything allocated since the previous call to the fence value signaled after this frame
+        void FinishFrame(UINT64 fenceValue);
+
+        // Recycles the regions of frames whose fence the GPU has passed
+        void RetireFrames(UINT64 completedFenceValue);
+
     private:
         Microsoft::WRL::ComPtr<ID3D12Resource> m_vertexBuffer;
         D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView;
@@ -39,8 +58,21 @@ namespace Angaraka::Graphics::DirectX12 {
         D3D12_INDEX_BUFFER_VIEW m_indexBufferView;
         unsigned int m_numIndices{ 0 };
 
-        Microsoft::WRL::ComPtr<ID3D12Resource> m_mvpConstantBuffer;
-        UINT8* m_pCbvDataBegin = nullptr; // Pointer to the mapped constant buffer data
+        // Upload buffer that filled up while frames using it were in flight, freed once they retire
+        struct RetiredUploadBuffer {
+            Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+            UINT64 fenceValue{ 0 };
+            bool frameFinished{ false };    // fenceValue is only known once the current frame finishes
+        };
+
+        Microsoft::WRL::ComPtr<ID3D12Resource> m_uploadBuffer;
+        UINT8* m_pUploadDataBegin = nullptr;
+        UploadRingAllocator m_uploadRing;
+        std::vector<RetiredUploadBuffer> m_retiredUploadBuffers;
+
+        // Reserves ring space, returns where to write it (nullptr on failure) and its GPU address
+        UINT8* Allocate(UINT64 size, UINT64 alignment, D3D12_GPU_VIRTUAL_ADDRESS& gpuAddress);
+        bool CreateUploadBuffer(UINT64 capacity);
 
         ID3D12Device* m_device{ nullptr }; // Raw pointer to device owned by DeviceManager
     };
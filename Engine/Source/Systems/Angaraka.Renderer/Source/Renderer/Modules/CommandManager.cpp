@@ -76,6 +76,13 @@ namespace Angaraka::Graphics::DirectX12 {
         commandQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
     }
 
+    UINT64 CommandQueueAndListManager::Signal(ID3D12CommandQueue* commandQueue) {
+        const UINT64 signaledFenceValue = m_fenceValue;
+        DXCall(commandQueue->Signal(m_fence.Get(), signaledFenceValue));
+        m_fenceValue++; // Increment for the next fence point
+        return signaledFenceValue;
+    }
+
     void CommandQueueAndListManager::WaitForGPU(ID3D12CommandQueue* commandQueue) {
         // Increment the fence value to signal the GPU to a new point.
         const UINT64 currentFenceValue = m_fenceValue;
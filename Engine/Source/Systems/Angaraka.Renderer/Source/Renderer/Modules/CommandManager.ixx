@@ -29,6 +29,12 @@ namespace Angaraka::Graphics::DirectX12 {
         // Waits for the GPU to finish all commands up to the current fence value.
         void WaitForGPU(ID3D12CommandQueue* commandQueue);
 
+        // Signals the next fence value after the work submitted so far and returns it, without waiting.
+        UINT64 Signal(ID3D12CommandQueue* commandQueue);
+
+        // Highest fence value the GPU has reached.
+        UINT64 GetCompletedFenceValue() const { return m_fence->GetCompletedValue(); }
+
         // Accessor for the main graphics command list.
         ID3D12GraphicsCommandList* GetCommandList() const { return m_commandList.Get(); }
 
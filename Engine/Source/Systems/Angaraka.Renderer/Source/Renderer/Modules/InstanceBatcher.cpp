@@ -0,0 +1,80 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/InstanceBatcher.cpp
+module;
+
+#include "Angaraka/Base.hpp"
+#include <cstring>
+
+module Angaraka.Graphics.InstanceBatcher;
+
+namespace Angaraka::Graphics {
+
+    void InstanceBatcher::Reset() {
+        m_pending.clear();
+        m_batches.clear();
+        m_instances.clear();
+        m_drawCount = 0;
+    }
+
+    void InstanceBatcher::Add(Core::Resource* mesh, Core::Resource* material, const Math::Matrix4x4& world) {
+        PendingDraw& draw = m_pending.emplace_back();
+        draw.key = { mesh, material };
+        std::memcpy(draw.data.world, world.GetColumnPtr(0), sizeof(draw.data.world));
+    }
+
+    void InstanceBatcher::Flush(BatchOrder order) {
+        if (m_pending.empty()) {
+            return;
+        }
+
+        const size_t firstBatch = m_batches.size();
+        const U32 firstInstance = static_cast<U32>(m_instances.size());
+        m_drawCount += m_pending.size();
+
+        if (order == BatchOrder::Preserve) {
+            // Instances of a run of equal draws are already adjacent
+            m_instances.reserve(m_instances.size() + m_pending.size());
+            for (const PendingDraw& draw : m_pending) {
+                DrawBatch* last = m_batches.size() > firstBatch ? &m_batches.back() : nullptr;
+                if (last && last->mesh == draw.key.mesh && last->material == draw.key.material) {
+                    ++last->instanceCount;
+                }
+                else {
+                    m_batches.push_back({ draw.key.mesh, draw.key.material, static_cast<U32>(m_instances.size()), 1 });
+                }
+                m_instances.push_back(draw.data);
+            }
+            m_pending.clear();
+            return;
+        }
+
+        // Counting pass: one batch per distinct mesh and material, in order of first appearance
+        m_runBatches.clear();
+        m_pendingBatch.resize(m_pending.size());
+        for (size_t i = 0; i < m_pending.size(); ++i) {
+            const BatchKey& key = m_pending[i].key;
+            auto [it, inserted] = m_runBatches.try_emplace(key, static_cast<U32>(m_batches.size()));
+            if (inserted) {
+                m_batches.push_back({ key.mesh, key.material, 0, 0 });
+            }
+            m_pendingBatch[i] = it->second;
+            ++m_batches[it->second].instanceCount;
+        }
+
+        // Give every batch its range, then scatter the instances into place. instanceCount
+        // doubles as the write cursor and ends up back at the count.
+        U32 next = firstInstance;
+        for (size_t b = firstBatch; b < m_batches.size(); ++b) {
+            m_batches[b].firstInstance = next;
+            next += m_batches[b].instanceCount;
+            m_batches[b].instanceCount = 0;
+        }
+
+        m_instances.resize(next);
+        for (size_t i = 0; i < m_pending.size(); ++i) {
+            DrawBatch& batch = m_batches[m_pendingBatch[i]];
+            m_instances[batch.firstInstance + batch.instanceCount++] = m_pending[i].data;
+        }
+        m_pending.clear();
+    }
+
+} // namespace Angaraka::Graphics
@@ -0,0 +1,90 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/InstanceBatcher.ixx
+module;
+
+#include "Angaraka/Base.hpp"
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+export module Angaraka.Graphics.InstanceBatcher;
+
+import Angaraka.Core.Resources;
+import Angaraka.Math.Matrix4x4;
+
+namespace Angaraka::Graphics {
+
+    // Per-instance data read by the vertex shader, one element of the instance buffer.
+    // The world matrix is stored in Matrix4x4 order, which is the layout HLSL reads a
+    // column-major float4x4 in, so packing is a plain copy.
+    export struct InstanceData {
+        F32 world[16];
+    };
+
+    // One instanced draw: instanceCount consecutive elements starting at firstInstance
+    export struct DrawBatch {
+        Core::Resource* mesh{ nullptr };
+        Core::Resource* material{ nullptr };
+        U32 firstInstance{ 0 };
+        U32 instanceCount{ 0 };
+    };
+
+    // How draws within one run may be reordered
+    export enum class BatchOrder {
+        Grouped,    // Any order: every draw of a mesh and material joins one batch, placed where it first appeared
+        Preserve    // Draw order matters (blending, overlays): only adjacent equal draws merge
+    };
+
+    /**
+     * @brief Groups draws of identical meshes into instanced batches
+     *
+     * Draws are added in submission order and grouped run by run: Flush closes the current
+     * run and batches never cross a run boundary, so callers flush wherever the order between
+     * draws must be kept (render queues, layers). Within a batch instances keep the order
+     * they were added in, so a front to back sorted queue stays front to back per mesh.
+     *
+     * The instances of all batches are packed into one contiguous array, ready to be copied
+     * into a GPU buffer. Nothing here touches a graphics API. Storage is reused between
+     * frames; call Reset at the start of each.
+     */
+    export class InstanceBatcher {
+    public:
+        InstanceBatcher() = default;
+        ~InstanceBatcher() = default;
+        DISABLE_COPY_AND_MOVE(InstanceBatcher);
+
+        void Reset();
+        void Add(Core::Resource* mesh, Core::Resource* material, const Math::Matrix4x4& world);
+        void Flush(BatchOrder order);
+
+        // Complete once the last run has been flushed
+        std::span<const DrawBatch> GetBatches() const { return m_batches; }
+        std::span<const InstanceData> GetInstances() const { return m_instances; }
+        size_t GetDrawCount() const { return m_drawCount; }
+
+    private:
+        struct BatchKey {
+            Core::Resource* mesh;
+            Core::Resource* material;
+            bool operator==(const BatchKey&) const = default;
+        };
+
+        struct BatchKeyHash {
+            size_t operator()(const BatchKey& key) const {
+                return std::hash<const void*>{}(key.mesh) ^ (std::hash<const void*>{}(key.material) * 31);
+            }
+        };
+
+        struct PendingDraw {
+            BatchKey key;
+            InstanceData data;
+        };
+
+        std::vector<PendingDraw> m_pending;             // Draws of the open run
+        std::vector<U32> m_pendingBatch;                // Batch of each pending draw, Grouped runs only
+        std::unordered_map<BatchKey, U32, BatchKeyHash> m_runBatches;
+        std::vector<DrawBatch> m_batches;
+        std::vector<InstanceData> m_instances;
+        size_t m_drawCount{ 0 };
+    };
+
+} // namespace Angaraka::Graphics
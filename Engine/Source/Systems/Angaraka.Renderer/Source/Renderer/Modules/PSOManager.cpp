@@ -73,7 +73,7 @@ namespace Angaraka::Graphics::DirectX12 {
         m_device = device;
 
         // Create Root Signature
-        CD3DX12_ROOT_PARAMETER rootParameters[2]{};
+        CD3DX12_ROOT_PARAMETER rootParameters[3]{};
 
         // Parameter 0: Constant Buffer View (your MVP matrix)
         rootParameters[0].InitAsConstantBufferView(0); // b0 in HLSL
@@ -83,6 +83,9 @@ namespace Angaraka::Graphics::DirectX12 {
         srvRange[0].Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); // t0 in HLSL
         rootParameters[1].InitAsDescriptorTable(1, srvRange);
 
+        // Parameter 2: Per-instance data, a structured buffer bound by address at the batch's first instance
+        rootParameters[2].InitAsShaderResourceView(1, 0, D3D12_SHADER_VISIBILITY_VERTEX); // t1 in HLSL
+
         // Create Static Sampler (Recommended for texture filtering)
         const D3D12_STATIC_SAMPLER_DESC samplers[]
         {
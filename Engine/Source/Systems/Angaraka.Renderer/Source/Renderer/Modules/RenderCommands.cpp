@@ -0,0 +1,115 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/RenderCommands.cpp
+module;
+
+#include "Angaraka/Base.hpp"
+#include <chrono>
+
+module Angaraka.Graphics.RenderCommands;
+
+namespace Angaraka::Graphics {
+
+    void RenderCommandBuffer::Reset() {
+        m_commands.clear();
+        m_instances.clear();
+        m_drawCount = 0;
+        m_pipeline = NO_PIPELINE;
+        m_mesh = nullptr;
+        m_firstInstance = U32(-1);
+    }
+
+    void RenderCommandBuffer::BindPipeline(U32 pipeline) {
+        if (pipeline == m_pipeline) {
+            return;
+        }
+        m_pipeline = pipeline;
+
+        RenderCommand& command = m_commands.emplace_back();
+        command.type = RenderCommandType::BindPipeline;
+        command.bindPipeline = { pipeline };
+    }
+
+    void RenderCommandBuffer::BindMesh(Core::Resource* mesh) {
+        if (mesh == m_mesh) {
+            return;
+        }
+        m_mesh = mesh;
+
+        RenderCommand& command = m_commands.emplace_back();
+        command.type = RenderCommandType::BindMesh;
+        command.bindMesh = { mesh };
+    }
+
+    void RenderCommandBuffer::SetInstances(U32 firstInstance) {
+        if (firstInstance == m_firstInstance) {
+            return;
+        }
+        m_firstInstance = firstInstance;
+
+        RenderCommand& command = m_commands.emplace_back();
+        command.type = RenderCommandType::SetInstances;
+        command.setInstances = { firstInstance };
+    }
+
+    void RenderCommandBuffer::Draw(U32 instanceCount) {
+        RenderCommand& command = m_commands.emplace_back();
+        command.type = RenderCommandType::Draw;
+        command.draw = { instanceCount };
+        ++m_drawCount;
+    }
+
+    U32 RenderCommandBuffer::AddInstances(std::span<const InstanceData> instances) {
+        const U32 first = static_cast<U32>(m_instances.size());
+        m_instances.insert(m_instances.end(), instances.begin(), instances.end());
+        return first;
+    }
+
+    void RenderCommandBuffer::AddBatches(const InstanceBatcher& batcher) {
+        const U32 base = AddInstances(batcher.GetInstances());
+        m_commands.reserve(m_commands.size() + batcher.GetBatches().size() * 3);
+
+        for (const DrawBatch& batch : batcher.GetBatches()) {
+            BindMesh(batch.mesh);
+            SetInstances(base + batch.firstInstance);
+            Draw(batch.instanceCount);
+        }
+    }
+
+    void NullRenderExecutor::Execute(const RenderCommandBuffer& commands) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        bool pipelineBound = false;
+        bool meshBound = false;
+        for (const RenderCommand& command : commands.GetCommands()) {
+            ++m_stats.commandCounts[static_cast<size_t>(command.type)];
+
+            switch (command.type) {
+            case RenderCommandType::BindPipeline:
+                pipelineBound = true;
+                break;
+            case RenderCommandType::BindMesh:
+                meshBound = command.bindMesh.mesh != nullptr;
+                break;
+            case RenderCommandType::Draw:
+                if (pipelineBound && meshBound) {
+                    m_stats.instances += command.draw.instanceCount;
+                }
+                else {
+                    ++m_stats.invalidDraws;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (m_recordCommands) {
+            m_recorded.assign(commands.GetCommands().begin(), commands.GetCommands().end());
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        m_stats.lastFrameMs = std::chrono::duration<F64, std::milli>(endTime - startTime).count();
+        m_stats.executeMs += m_stats.lastFrameMs;
+        ++m_stats.frames;
+    }
+
+} // namespace Angaraka::Graphics
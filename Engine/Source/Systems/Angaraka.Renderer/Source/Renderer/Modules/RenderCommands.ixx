@@ -0,0 +1,140 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/RenderCommands.ixx
+module;
+
+#include "Angaraka/Base.hpp"
+#include <array>
+#include <chrono>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+export module Angaraka.Graphics.RenderCommands;
+
+import Angaraka.Core.Resources;
+import Angaraka.Graphics.InstanceBatcher;
+
+namespace Angaraka::Graphics {
+
+    export enum class RenderCommandType : U8 {
+        BindPipeline,
+        BindMesh,
+        SetInstances,   // Per-draw data: following draws read instances from firstInstance on
+        Draw,           // Draws the bound mesh instanceCount times
+        Count
+    };
+
+    export constexpr U32 DEFAULT_PIPELINE = 0;
+
+    export struct BindPipelineCommand { U32 pipeline; };
+    export struct BindMeshCommand { Core::Resource* mesh; };
+    export struct SetInstancesCommand { U32 firstInstance; };
+    export struct DrawCommand { U32 instanceCount; };
+
+    export struct RenderCommand {
+        RenderCommandType type;
+        union {
+            BindPipelineCommand bindPipeline;
+            BindMeshCommand bindMesh;
+            SetInstancesCommand setInstances;
+            DrawCommand draw;
+        };
+    };
+
+    static_assert(std::is_trivially_copyable_v<RenderCommand> && sizeof(RenderCommand) <= 16,
+        "Render commands are copied around as plain memory");
+
+    /**
+     * @brief One frame of draws in a backend-neutral form
+     *
+     * Commands are fixed-size PODs in submission order; the instance data they refer to is
+     * stored alongside, so an executor uploads it once and walks the commands. Binds that
+     * would not change the current state are dropped while recording, so every recorded
+     * bind is a real state change. Storage is reused between frames; call Reset at the
+     * start of each.
+     */
+    export class RenderCommandBuffer {
+    public:
+        RenderCommandBuffer() = default;
+        ~RenderCommandBuffer() = default;
+        DISABLE_COPY_AND_MOVE(RenderCommandBuffer);
+
+        void Reset();
+
+        void BindPipeline(U32 pipeline);
+        void BindMesh(Core::Resource* mesh);
+        void SetInstances(U32 firstInstance);
+        void Draw(U32 instanceCount);
+
+        // Appends instance data and returns the index of the first new instance
+        U32 AddInstances(std::span<const InstanceData> instances);
+
+        // Records one SetInstances and Draw per batch, binding meshes as they change
+        void AddBatches(const InstanceBatcher& batcher);
+
+        std::span<const RenderCommand> GetCommands() const { return m_commands; }
+        std::span<const InstanceData> GetInstances() const { return m_instances; }
+        U32 GetDrawCount() const { return m_drawCount; }
+
+    private:
+        static constexpr U32 NO_PIPELINE = U32(-1);
+
+        std::vector<RenderCommand> m_commands;
+        std::vector<InstanceData> m_instances;
+        U32 m_drawCount{ 0 };
+
+        // Recording state, used to drop redundant binds
+        U32 m_pipeline{ NO_PIPELINE };
+        Core::Resource* m_mesh{ nullptr };
+        U32 m_firstInstance{ U32(-1) };
+    };
+
+    /**
+     * @brief Runs a recorded command buffer on some backend
+     */
+    export class RenderCommandExecutor {
+    public:
+        virtual ~RenderCommandExecutor() = default;
+        virtual void Execute(const RenderCommandBuffer& commands) = 0;
+    };
+
+    export struct RenderCommandStats {
+        U64 frames{ 0 };
+        std::array<U64, static_cast<size_t>(RenderCommandType::Count)> commandCounts{};
+        U64 instances{ 0 };             // Drawn, summed over all draws
+        U64 invalidDraws{ 0 };          // Draws without a bound pipeline or mesh
+        F64 executeMs{ 0.0 };           // Time spent in Execute
+        F64 lastFrameMs{ 0.0 };
+
+        U64 GetCount(RenderCommandType type) const { return commandCounts[static_cast<size_t>(type)]; }
+        U64 GetStateChanges() const {
+            return GetCount(RenderCommandType::BindPipeline) + GetCount(RenderCommandType::BindMesh)
+                + GetCount(RenderCommandType::SetInstances);
+        }
+    };
+
+    /**
+     * @brief Executor without a GPU
+     *
+     * Walks the commands like a backend would, counting and timing them, so frame costs and
+     * command counts can be measured headless. With recording enabled it also keeps a copy
+     * of the last frame's commands for inspection.
+     */
+    export class NullRenderExecutor : public RenderCommandExecutor {
+    public:
+        explicit NullRenderExecutor(bool recordCommands = false) : m_recordCommands(recordCommands) {}
+
+        void Execute(const RenderCommandBuffer& commands) override;
+
+        const RenderCommandStats& GetStats() const { return m_stats; }
+        void ResetStats() { m_stats = {}; }
+
+        // Commands of the last executed frame, empty unless recording
+        std::span<const RenderCommand> GetRecordedCommands() const { return m_recorded; }
+
+    private:
+        bool m_recordCommands;
+        RenderCommandStats m_stats;
+        std::vector<RenderCommand> m_recorded;
+    };
+
+} // namespace Angaraka::Graphics
@@ -20,6 +20,9 @@ import Angaraka.Graphics.DirectX12.CommandQueueAndListManager;
 import Angaraka.Graphics.DirectX12.ShaderManager;
 import Angaraka.Graphics.DirectX12.PipelineManager;
 import Angaraka.Graphics.DirectX12.BufferManager;
+import Angaraka.Graphics.DirectX12.UploadManager;
+import Angaraka.Graphics.InstanceBatcher;
+import Angaraka.Graphics.RenderCommands;
 
 import Angaraka.Graphics.DirectX12.Texture;
 import Angaraka.Graphics.DirectX12.Mesh;
@@ -57,6 +60,7 @@ namespace Angaraka { // Use the Angaraka namespace here
         m_shaderManager = CreateScope<Graphics::DirectX12::ShaderManager>();
         m_pipelineManager = CreateScope<Graphics::DirectX12::PipelineManager>();
         m_bufferManager = CreateScope<Graphics::DirectX12::BufferManager>();
+        m_uploadManager = CreateScope<Graphics::DirectX12::UploadManager>();
 
         m_textureManager = CreateReference<Graphics::DirectX12::TextureManager>();
         m_meshManager = CreateReference<Graphics::DirectX12::MeshManager>();
@@ -131,21 +135,24 @@ namespace Angaraka { // Use the Angaraka namespace here
         }
         AGK_INFO("DirectX12GraphicsSystem: BufferManager initialized.");
 
+        // Texture and mesh data is copied on a dedicated copy queue, the graphics queue waits for it on the GPU
+        if (!m_uploadManager->Initialize(m_deviceManager->GetDevice(), m_deviceManager->GetCommandQueue())) {
+            return false;
+        }
+        AGK_INFO("DirectX12GraphicsSystem: UploadManager initialized.");
 
         // Initialize the TextureManager
-        if (!m_textureManager->Initialize(m_deviceManager->GetDevice(), m_deviceManager->GetCommandQueue())) // Pass your D3D12 device and command list
+        if (!m_textureManager->Initialize(m_deviceManager->GetDevice(), m_uploadManager.get()))
         {
             AGK_ERROR("Failed to initialize Texture Manager.");
             return false;
         }
-        m_textureManager->ClearUploadHeaps();
 
         // Initialize the MeshManager
-        if (!m_meshManager->Initialize(m_deviceManager->GetDevice(), m_deviceManager->GetCommandQueue())) {
+        if (!m_meshManager->Initialize(m_deviceManager->GetDevice(), m_uploadManager.get())) {
             AGK_ERROR("Failed to initialize Mesh Manager.");
             return false;
         }
-        m_meshManager->ClearUploadHeaps(); // Clear any temporary upload heaps
 
         // Aspect ratio calculated based on window size
         m_camera->Initialize(
@@ -175,6 +182,9 @@ namespace Angaraka { // Use the Angaraka namespace here
     void DirectX12GraphicsSystem::Shutdown() {
         // Ensures all pending GPU commands are completed before releasing resources.
         // This is vital for a clean shutdown.
+        if (m_uploadManager) {
+            m_uploadManager->Shutdown();
+        }
         if (m_deviceManager && m_commandManager) {
             m_commandManager->WaitForGPU(m_deviceManager->GetCommandQueue());
         }
@@ -194,6 +204,7 @@ namespace Angaraka { // Use the Angaraka namespace here
             m_textureManager.reset();
         }
 
+        m_uploadManager.reset();
         m_bufferManager.reset();
         m_shaderManager.reset();
         m_commandManager.reset();
@@ -223,41 +234,108 @@ namespace Angaraka { // Use the Angaraka namespace here
 
     void DirectX12GraphicsSystem::RenderMesh(Core::Resource* resource, Math::Matrix4x4 worldMatrix)
     {
-        DirectX::XMMATRIX dxWorldMatrix = Angaraka::Math::MathConversion::ToDirectXMatrix(worldMatrix);
         Graphics::DirectX12::MeshResource* mesh = dynamic_cast<Graphics::DirectX12::MeshResource*>(resource);
         if (mesh && mesh->IsLoaded())
         {
-            m_camera->FillMVPConstantBuffer(cbData, worldMatrix);
-
-            // Update GPU constant buffer
-            m_bufferManager->UpdateConstantBuffer(cbData);
+            // A batch of one
+            Graphics::InstanceData instance;
+            memcpy(instance.world, worldMatrix.GetColumnPtr(0), sizeof(instance.world));
 
-            // Set vertex buffer
-            auto vertexBufferView = mesh->GetVertexBufferView();
-            commandList->IASetVertexBuffers(0, 1, vertexBufferView);
-
-            // Set index buffer if available
-            if (mesh->GetIndexCount() > 3)
+            D3D12_GPU_VIRTUAL_ADDRESS instances = m_bufferManager->WriteInstances({ &instance, 1 });
+            if (instances != 0)
             {
-                auto indexBufferView = mesh->GetIndexBufferView();
-                commandList->IASetIndexBuffer(indexBufferView);
-
-                // Draw indexed
-                commandList->DrawIndexedInstanced(
-                    static_cast<UINT>(mesh->GetIndexCount()),
-                    1, 0, 0, 0
-                );
+                commandList->SetGraphicsRootShaderResourceView(2, instances);
+                BindMesh(mesh);
+                DrawMesh(mesh, 1);
             }
-            else
+        }
+    }
+
+    void DirectX12GraphicsSystem::Execute(const Graphics::RenderCommandBuffer& commands)
+    {
+        D3D12_GPU_VIRTUAL_ADDRESS instances = m_bufferManager->WriteInstances(commands.GetInstances());
+        if (instances == 0 && !commands.GetInstances().empty())
+        {
+            return;
+        }
+
+        Graphics::DirectX12::MeshResource* mesh = nullptr;
+        for (const Graphics::RenderCommand& command : commands.GetCommands())
+        {
+            switch (command.type)
             {
-                // Draw non-indexed
-                commandList->DrawInstanced(
-                    static_cast<UINT>(mesh->GetVertexCount()),
-                    1, 0, 0
-                );
+            case Graphics::RenderCommandType::BindPipeline:
+                // Only the default pipeline exists so far
+                if (command.bindPipeline.pipeline == Graphics::DEFAULT_PIPELINE)
+                {
+                    commandList->SetPipelineState(m_pipelineManager->GetPipelineState());
+                }
+                break;
+
+            case Graphics::RenderCommandType::BindMesh:
+                mesh = dynamic_cast<Graphics::DirectX12::MeshResource*>(command.bindMesh.mesh);
+                if (mesh && mesh->IsLoaded())
+                {
+                    BindMesh(mesh);
+                }
+                else
+                {
+                    mesh = nullptr;
+                }
+                break;
+
+            case Graphics::RenderCommandType::SetInstances:
+                // The shader indexes from the start of the view, so it is bound at the first instance
+                commandList->SetGraphicsRootShaderResourceView(2,
+                    instances + static_cast<UINT64>(command.setInstances.firstInstance) * sizeof(Graphics::InstanceData));
+                break;
+
+            case Graphics::RenderCommandType::Draw:
+                if (mesh)
+                {
+                    DrawMesh(mesh, command.draw.instanceCount);
+                }
+                break;
+
+            default:
+                break;
             }
+        }
+
+        AGK_TRACE("DirectX12GraphicsSystem: Executed {} commands, {} draws", commands.GetCommands().size(), commands.GetDrawCount());
+    }
 
-            AGK_TRACE("DirectX12GraphicsSystem: Rendered test mesh with {} indices", mesh->GetIndexCount());
+    void DirectX12GraphicsSystem::BindMesh(Graphics::DirectX12::MeshResource* mesh)
+    {
+        // Set vertex buffer
+        auto vertexBufferView = mesh->GetVertexBufferView();
+        commandList->IASetVertexBuffers(0, 1, vertexBufferView);
+
+        // Set index buffer if available
+        if (mesh->GetIndexCount() > 3)
+        {
+            auto indexBufferView = mesh->GetIndexBufferView();
+            commandList->IASetIndexBuffer(indexBufferView);
+        }
+    }
+
+    void DirectX12GraphicsSystem::DrawMesh(Graphics::DirectX12::MeshResource* mesh, UINT instanceCount)
+    {
+        if (mesh->GetIndexCount() > 3)
+        {
+            // Draw indexed
+            commandList->DrawIndexedInstanced(
+                static_cast<UINT>(mesh->GetIndexCount()),
+                instanceCount, 0, 0, 0
+            );
+        }
+        else
+        {
+            // Draw non-indexed
+            commandList->DrawInstanced(
+                static_cast<UINT>(mesh->GetVertexCount()),
+                instanceCount, 0, 0
+            );
         }
     }
 
@@ -282,8 +360,16 @@ namespace Angaraka { // Use the Angaraka namespace here
         ID3D12DescriptorHeap* ppHeaps[] = { m_textureManager->GetSrvHeap() }; // Assuming TextureManager has a getter for its SRV heap
         commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
 
-        m_bufferManager->UpdateConstantBuffer(cbData);
-        commandList->SetGraphicsRootConstantBufferView(0, m_bufferManager->GetConstantBufferGPUAddress());
+        // Upload ring space of every frame the GPU has finished can be reused
+        m_bufferManager->RetireFrames(m_commandManager->GetCompletedFenceValue());
+
+        // Resource uploads the copy queue has finished complete their assets
+        m_uploadManager->RetireCompleted();
+
+        // View and projection are the same for every draw of the frame, world matrices are per instance.
+        // Each frame gets its own copy, so the GPU never reads constants the CPU is rewriting.
+        m_camera->FillMVPConstantBuffer(cbData, Math::Matrix4x4::Identity());
+        commandList->SetGraphicsRootConstantBufferView(0, m_bufferManager->AllocateConstants(cbData));
 
         unsigned int currentBackBufferIndex = m_swapChainManager->GetCurrentBackBufferIndex();
 
@@ -320,8 +406,14 @@ namespace Angaraka { // Use the Angaraka namespace here
         m_commandManager->GetCommandList()->ResourceBarrier(1, &presentBarrier);
 
         m_commandManager->Close();
+
+        // Copies recorded since the last frame go out as one batch, ahead of the draws that may read them
+        m_uploadManager->Flush();
         m_commandManager->Execute(m_deviceManager->GetCommandQueue());
 
+        // The upload ring space used this frame is recycled once the GPU passes this fence
+        m_bufferManager->FinishFrame(m_commandManager->Signal(m_deviceManager->GetCommandQueue()));
+
     }
 
     void DirectX12GraphicsSystem::Present() {
@@ -20,6 +20,8 @@ import Angaraka.Graphics.DirectX12.CommandQueueAndListManager;
 import Angaraka.Graphics.DirectX12.ShaderManager;
 import Angaraka.Graphics.DirectX12.PipelineManager;
 import Angaraka.Graphics.DirectX12.BufferManager;
+import Angaraka.Graphics.DirectX12.UploadManager;
+import Angaraka.Graphics.RenderCommands;
 
 import Angaraka.Graphics.DirectX12.Texture;
 import Angaraka.Graphics.DirectX12.Mesh;
@@ -31,7 +33,7 @@ import Angaraka.Math.Matrix4x4;
 
 namespace Angaraka { // Use the Angaraka namespace here
 
-    export class DirectX12GraphicsSystem
+    export class DirectX12GraphicsSystem : public Graphics::RenderCommandExecutor
     {
     public:
         DirectX12GraphicsSystem();
@@ -49,6 +51,8 @@ namespace Angaraka { // Use the Angaraka namespace here
 
         void RenderTexture(Core::Resource* texture);
         void RenderMesh(Core::Resource* resource, Math::Matrix4x4 worldMatrix);
+        // Records the commands into the frame's command list; instance data is uploaded once for all draws
+        void Execute(const Graphics::RenderCommandBuffer& commands) override;
 
         void OnWindowResize(unsigned int newWidth, unsigned int newHeight);
 
@@ -56,6 +60,7 @@ namespace Angaraka { // Use the Angaraka namespace here
         inline Graphics::DirectX12::TextureManager* GetTextureManager() const { return m_textureManager.get(); }
         inline Graphics::DirectX12::MeshManager* GetMeshManager() const { return m_meshManager.get(); }
         inline Graphics::DirectX12::DeviceManager* GetDeviceManager() const { return m_deviceManager.get(); }
+        inline Graphics::DirectX12::UploadManager* GetUploadManager() const { return m_uploadManager.get(); }
 
         Reference<Core::GraphicsResourceFactory> GetGraphicsFactory();
 
@@ -70,6 +75,7 @@ namespace Angaraka { // Use the Angaraka namespace here
         Scope<Graphics::DirectX12::ShaderManager> m_shaderManager;
         Scope<Graphics::DirectX12::PipelineManager> m_pipelineManager;
         Scope<Graphics::DirectX12::BufferManager> m_bufferManager;
+        Scope<Graphics::DirectX12::UploadManager> m_uploadManager;
 
         Reference<Graphics::DirectX12::TextureManager> m_textureManager;
         Reference<Graphics::DirectX12::MeshManager> m_meshManager;
@@ -81,11 +87,18 @@ namespace Angaraka { // Use the Angaraka namespace here
         unsigned int m_width{ 0 };
         unsigned int m_height{ 0 };
         F32 m_elapsedTime = 0.0f;
+
+        void BindMesh(Graphics::DirectX12::MeshResource* mesh);
+        void DrawMesh(Graphics::DirectX12::MeshResource* mesh, UINT instanceCount);
     };
 
 
     export class DirectX12ResourceFactory : public Core::IGraphicsResourceFactory<DirectX12ResourceFactory> {
     public:
+        // MeshManager, TextureManager and UploadManager lock their own state and the D3D12
+        // device is free-threaded, so loader threads may create resources concurrently
+        static constexpr bool IsThreadSafe = true;
+
         inline DirectX12ResourceFactory(DirectX12GraphicsSystem* graphicsSystem)
             : m_graphicsSystem(graphicsSystem) {
         }
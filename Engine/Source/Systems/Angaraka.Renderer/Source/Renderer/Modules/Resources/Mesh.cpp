@@ -12,6 +12,7 @@ module Angaraka.Graphics.DirectX12.Mesh;
 import Angaraka.Math;
 import Angaraka.Core.Resources;
 import Angaraka.Graphics.DirectX12;
+import Angaraka.Graphics.DirectX12.UploadManager;
 
 namespace Angaraka::Graphics::DirectX12 {
 
@@ -61,7 +62,8 @@ namespace Angaraka::Graphics::DirectX12 {
         AGK_INFO("MeshResource: CPU mesh data loaded - {} vertices, {} indices, layout: {}",
             meshData->vertexCount, meshData->indexCount, m_vertexLayoutString);
 
-        // Create GPU mesh using MeshManager
+        // Create GPU mesh using MeshManager, the data is copied to the GPU asynchronously
+        m_uploadManager = meshManager->GetUploadManager();
         m_gpuMesh = meshManager->CreateGPUMesh(*meshData);
         if (!m_gpuMesh || !m_gpuMesh->IsValid()) {
             AGK_ERROR("MeshResource: Failed to create GPU mesh for '{}'", filePath);
@@ -101,6 +103,14 @@ namespace Angaraka::Graphics::DirectX12 {
         return m_gpuMesh ? m_gpuMesh->GetTotalGPUMemorySizeBytes() : 0;
     }
 
+    void MeshResource::WhenReady(std::function<void()> callback) {
+        if (m_gpuMesh && m_uploadManager) {
+            m_uploadManager->WhenComplete(m_gpuMesh->uploadFenceValue, std::move(callback));
+            return;
+        }
+        callback();
+    }
+
 
 
 
@@ -118,9 +128,9 @@ namespace Angaraka::Graphics::DirectX12 {
         Shutdown();
     }
 
-    bool MeshManager::Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue) {
-        if (!device || !commandQueue) {
-            AGK_ERROR("MeshManager::Initialize: Invalid D3D12 device or command list");
+    bool MeshManager::Initialize(ID3D12Device* device, UploadManager* uploadManager) {
+        if (!device || !uploadManager) {
+            AGK_ERROR("MeshManager::Initialize: Invalid D3D12 device or upload manager");
             return false;
         }
 
@@ -130,21 +140,9 @@ namespace Angaraka::Graphics::DirectX12 {
         }
 
         m_device = device;
-        m_CommandQueue = commandQueue;
+        m_uploadManager = uploadManager;
         m_initialized = true;
 
-        // Create dedicated command allocator for texture loading
-        DXCall(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
-            IID_PPV_ARGS(&m_LoadingCommandAllocator)));
-
-        // Create dedicated command list for texture loading
-        DXCall(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT,
-            m_LoadingCommandAllocator.Get(), nullptr,
-            IID_PPV_ARGS(&m_LoadingCommandList)));
-
-        // Close it initially
-        DXCall(m_LoadingCommandList->Close());
-
         // Initialize statistics
         m_stats = {};
         m_statsDirty = true;
@@ -160,50 +158,17 @@ namespace Angaraka::Graphics::DirectX12 {
 
         std::lock_guard<std::mutex> lock(m_meshesMutex);
 
-        // Clear all upload heaps
-        m_uploadHeapsToRelease.clear();
-
         // Clear active meshes tracking
         m_activeMeshes.clear();
 
         // Reset state
         m_device = nullptr;
+        m_uploadManager = nullptr;
         m_initialized = false;
 
         AGK_INFO("MeshManager: Shutdown complete");
     }
 
-    ID3D12GraphicsCommandList* MeshManager::GetOrCreateCommandList() {
-        // Reset allocator and command list for new recording
-        DXCall(m_LoadingCommandAllocator->Reset());
-        DXCall(m_LoadingCommandList->Reset(m_LoadingCommandAllocator.Get(), nullptr));
-
-        return m_LoadingCommandList.Get();
-    }
-
-    void MeshManager::ExecuteAndWaitForGPU() {
-        // Close command list
-        DXCall(m_LoadingCommandList->Close());
-
-        // Execute on command queue
-        ID3D12CommandList* commandLists[] = { m_LoadingCommandList.Get() };
-        m_CommandQueue->ExecuteCommandLists(1, commandLists);
-
-        // Wait for completion (simple synchronization)
-        // In production, use proper fence synchronization
-        Microsoft::WRL::ComPtr<ID3D12Fence> fence;
-        DXCall(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
-
-        DXCall(m_CommandQueue->Signal(fence.Get(), 1));
-
-        if (fence->GetCompletedValue() < 1) {
-            HANDLE fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-            DXCall(fence->SetEventOnCompletion(1, fenceEvent));
-            WaitForSingleObject(fenceEvent, INFINITE);
-            CloseHandle(fenceEvent);
-        }
-    }
-
     Scope<GPUMesh> MeshManager::CreateGPUMesh(const MeshData& meshData) {
         if (!m_initialized) {
             AGK_ERROR("MeshManager: Not initialized when attempting to create GPU mesh");
@@ -235,22 +200,18 @@ namespace Angaraka::Graphics::DirectX12 {
         // Copy materials
         gpuMesh->materials = meshData.materials;
 
-        auto commandList = GetOrCreateCommandList();
-
         // Create vertex buffer
-        if (!CreateVertexBuffer(commandList, meshData, *gpuMesh)) {
+        if (!CreateVertexBuffer(meshData, *gpuMesh)) {
             AGK_ERROR("MeshManager: Failed to create vertex buffer");
             return nullptr;
         }
 
         // Create index buffer
-        if (!CreateIndexBuffer(commandList, meshData, *gpuMesh)) {
+        if (!CreateIndexBuffer(meshData, *gpuMesh)) {
             AGK_ERROR("MeshManager: Failed to create index buffer");
             return nullptr;
         }
 
-        ExecuteAndWaitForGPU();
-
         // Track the mesh for statistics
         {
             std::lock_guard<std::mutex> lock(m_meshesMutex);
@@ -258,8 +219,8 @@ namespace Angaraka::Graphics::DirectX12 {
             m_statsDirty = true;
         }
 
-        AGK_INFO("MeshManager: Successfully created GPU mesh - VB: {} bytes, IB: {} bytes",
-            gpuMesh->GetVertexBufferSize(), gpuMesh->GetIndexBufferSize());
+        AGK_INFO("MeshManager: Successfully created GPU mesh - VB: {} bytes, IB: {} bytes, upload batch {}",
+            gpuMesh->GetVertexBufferSize(), gpuMesh->GetIndexBufferSize(), gpuMesh->uploadFenceValue);
 
         return gpuMesh;
     }
@@ -281,7 +242,7 @@ namespace Angaraka::Graphics::DirectX12 {
         // ComPtr members go out of scope in the unique_ptr destructor
     }
 
-    bool MeshManager::CreateVertexBuffer(ID3D12GraphicsCommandList* commandList, const MeshData& meshData, GPUMesh& gpuMesh) {
+    bool MeshManager::CreateVertexBuffer(const MeshData& meshData, GPUMesh& gpuMesh) {
         const size_t vertexBufferSize = meshData.GetVertexBufferSize();
 
         // Create vertex buffer resource descriptor
@@ -293,7 +254,7 @@ namespace Angaraka::Graphics::DirectX12 {
             &defaultHeapProps,
             D3D12_HEAP_FLAG_NONE,
             &vertexBufferDesc,
-            D3D12_RESOURCE_STATE_COMMON, // Start in copy destination state
+            D3D12_RESOURCE_STATE_COMMON, // Promoted to COPY_DEST by the copy queue, then to VERTEX_AND_CONSTANT_BUFFER on first use
             nullptr,
             IID_PPV_ARGS(&gpuMesh.vertexBuffer)
         );
@@ -305,57 +266,13 @@ namespace Angaraka::Graphics::DirectX12 {
 
         NAME_D3D12_OBJECT(gpuMesh.vertexBuffer, "Mesh Vertex Buffer");
 
-        // Create upload heap for vertex data transfer
-        const UINT64 uploadBufferSize = GetRequiredIntermediateSize(gpuMesh.vertexBuffer.Get(), 0, 1);
-        CD3DX12_RESOURCE_DESC uploadBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize);
-
-        Microsoft::WRL::ComPtr<ID3D12Resource> vertexUploadHeap;
-        D3D12_HEAP_PROPERTIES uploadHeapProps = GetUploadHeapProperties();
-
-        hr = m_device->CreateCommittedResource(
-            &uploadHeapProps,
-            D3D12_HEAP_FLAG_NONE,
-            &uploadBufferDesc,
-            D3D12_RESOURCE_STATE_GENERIC_READ, // Upload heaps must be in this state
-            nullptr,
-            IID_PPV_ARGS(&vertexUploadHeap)
-        );
-
-        if (FAILED(hr)) {
-            AGK_ERROR("MeshManager: Failed to create vertex upload heap. HRESULT: {:#x}", hr);
+        // Copy data from CPU to GPU through the staging ring
+        const UINT64 fenceValue = m_uploadManager->UploadBuffer(gpuMesh.vertexBuffer.Get(), meshData.vertexData.data(), vertexBufferSize);
+        if (fenceValue == 0) {
+            AGK_ERROR("MeshManager: Failed to upload vertex data");
             return false;
         }
-
-        NAME_D3D12_OBJECT(vertexUploadHeap, "Mesh Vertex Upload Heap");
-
-        // Add to upload heaps list for later cleanup
-        m_uploadHeapsToRelease.push_back(vertexUploadHeap);
-
-        // Prepare subresource data
-        D3D12_SUBRESOURCE_DATA vertexData = {};
-        vertexData.pData = meshData.vertexData.data();
-        vertexData.RowPitch = vertexBufferSize;
-        vertexData.SlicePitch = vertexBufferSize;
-
-
-        // Transition vertex buffer from COMMON to COPY_DEST for upload
-        CD3DX12_RESOURCE_BARRIER vertexBufferBarrierToCopy = CD3DX12_RESOURCE_BARRIER::Transition(
-            gpuMesh.vertexBuffer.Get(),
-            D3D12_RESOURCE_STATE_COMMON,
-            D3D12_RESOURCE_STATE_COPY_DEST
-        );
-        commandList->ResourceBarrier(1, &vertexBufferBarrierToCopy);
-
-        // Copy data from CPU to GPU via upload heap
-        UpdateSubresources(commandList, gpuMesh.vertexBuffer.Get(), vertexUploadHeap.Get(), 0, 0, 1, &vertexData);
-
-        // Transition vertex buffer to vertex buffer state
-        CD3DX12_RESOURCE_BARRIER vertexBufferBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-            gpuMesh.vertexBuffer.Get(),
-            D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER
-        );
-        commandList->ResourceBarrier(1, &vertexBufferBarrier);
+        gpuMesh.uploadFenceValue = std::max(gpuMesh.uploadFenceValue, fenceValue);
 
         // Initialize vertex buffer view
         gpuMesh.vertexBufferView.BufferLocation = gpuMesh.vertexBuffer->GetGPUVirtualAddress();
@@ -365,7 +282,7 @@ namespace Angaraka::Graphics::DirectX12 {
         return true;
     }
 
-    bool MeshManager::CreateIndexBuffer(ID3D12GraphicsCommandList* commandList, const MeshData& meshData, GPUMesh& gpuMesh) {
+    bool MeshManager::CreateIndexBuffer(const MeshData& meshData, GPUMesh& gpuMesh) {
         const size_t indexBufferSize = meshData.GetIndexBufferSize();
 
         // Create index buffer resource descriptor
@@ -377,7 +294,7 @@ namespace Angaraka::Graphics::DirectX12 {
             &defaultHeapProps,
             D3D12_HEAP_FLAG_NONE,
             &indexBufferDesc,
-            D3D12_RESOURCE_STATE_COMMON, // Start in copy destination state
+            D3D12_RESOURCE_STATE_COMMON, // Promoted to COPY_DEST by the copy queue, then to INDEX_BUFFER on first use
             nullptr,
             IID_PPV_ARGS(&gpuMesh.indexBuffer)
         );
@@ -389,56 +306,13 @@ namespace Angaraka::Graphics::DirectX12 {
 
         NAME_D3D12_OBJECT(gpuMesh.indexBuffer, "Mesh Index Buffer");
 
-        // Create upload heap for index data transfer
-        const UINT64 uploadBufferSize = GetRequiredIntermediateSize(gpuMesh.indexBuffer.Get(), 0, 1);
-        CD3DX12_RESOURCE_DESC uploadBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize);
-
-        Microsoft::WRL::ComPtr<ID3D12Resource> indexUploadHeap;
-        D3D12_HEAP_PROPERTIES uploadHeapProps = GetUploadHeapProperties();
-
-        hr = m_device->CreateCommittedResource(
-            &uploadHeapProps,
-            D3D12_HEAP_FLAG_NONE,
-            &uploadBufferDesc,
-            D3D12_RESOURCE_STATE_GENERIC_READ, // Upload heaps must be in this state
-            nullptr,
-            IID_PPV_ARGS(&indexUploadHeap)
-        );
-
-        if (FAILED(hr)) {
-            AGK_ERROR("MeshManager: Failed to create index upload heap. HRESULT: {:#x}", hr);
+        // Copy data from CPU to GPU through the staging ring
+        const UINT64 fenceValue = m_uploadManager->UploadBuffer(gpuMesh.indexBuffer.Get(), meshData.indices.data(), indexBufferSize);
+        if (fenceValue == 0) {
+            AGK_ERROR("MeshManager: Failed to upload index data");
             return false;
         }
-
-        NAME_D3D12_OBJECT(indexUploadHeap, "Mesh Index Upload Heap");
-
-        // Add to upload heaps list for later cleanup
-        m_uploadHeapsToRelease.push_back(indexUploadHeap);
-
-        // Prepare subresource data
-        D3D12_SUBRESOURCE_DATA indexData = {};
-        indexData.pData = meshData.indices.data();
-        indexData.RowPitch = indexBufferSize;
-        indexData.SlicePitch = indexBufferSize;
-
-        // Transition index buffer from COMMON to COPY_DEST for upload
-        CD3DX12_RESOURCE_BARRIER indexBufferBarrierToCopy = CD3DX12_RESOURCE_BARRIER::Transition(
-            gpuMesh.indexBuffer.Get(),
-            D3D12_RESOURCE_STATE_COMMON,
-            D3D12_RESOURCE_STATE_COPY_DEST
-        );
-        commandList->ResourceBarrier(1, &indexBufferBarrierToCopy);
-
-        // Copy data from CPU to GPU via upload heap
-        UpdateSubresources(commandList, gpuMesh.indexBuffer.Get(), indexUploadHeap.Get(), 0, 0, 1, &indexData);
-
-        // Transition index buffer to index buffer state
-        CD3DX12_RESOURCE_BARRIER indexBufferBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-            gpuMesh.indexBuffer.Get(),
-            D3D12_RESOURCE_STATE_COPY_DEST,
-            D3D12_RESOURCE_STATE_INDEX_BUFFER
-        );
-        commandList->ResourceBarrier(1, &indexBufferBarrier);
+        gpuMesh.uploadFenceValue = std::max(gpuMesh.uploadFenceValue, fenceValue);
 
         // Initialize index buffer view
         gpuMesh.indexBufferView.BufferLocation = gpuMesh.indexBuffer->GetGPUVirtualAddress();
@@ -448,13 +322,6 @@ namespace Angaraka::Graphics::DirectX12 {
         return true;
     }
 
-    void MeshManager::ClearUploadHeaps() {
-        if (!m_uploadHeapsToRelease.empty()) {
-            AGK_INFO("MeshManager: Clearing {} upload heaps after GPU completion", m_uploadHeapsToRelease.size());
-            m_uploadHeapsToRelease.clear();
-        }
-    }
-
     MeshManager::Statistics MeshManager::GetStatistics() const {
         if (m_statsDirty) {
             UpdateStatistics();
@@ -477,12 +344,9 @@ namespace Angaraka::Graphics::DirectX12 {
             }
         }
 
-        // Calculate upload memory (temporary)
-        for (const auto& uploadHeap : m_uploadHeapsToRelease) {
-            if (uploadHeap) {
-                D3D12_RESOURCE_DESC desc = uploadHeap->GetDesc();
-                m_stats.totalUploadMemory += desc.Width;
-            }
+        // Staging space still held by uploads the copy queue has not finished
+        if (m_uploadManager) {
+            m_stats.totalUploadMemory = m_uploadManager->GetStagingBytesInUse();
         }
 
         m_statsDirty = false;
@@ -8,6 +8,7 @@ export module Angaraka.Graphics.DirectX12.Mesh;
 import <filesystem>;
 import Angaraka.Core.Resources;
 import Angaraka.Graphics.DirectX12.ObjLoader;
+import Angaraka.Graphics.DirectX12.UploadManager;
 
 namespace Angaraka::Graphics::DirectX12 {
 
@@ -33,6 +34,9 @@ namespace Angaraka::Graphics::DirectX12 {
         // Material information (for future use)
         std::vector<MeshData::MaterialInfo> materials;
 
+        // Upload batch that fills the buffers, 0 once nothing is pending
+        UINT64 uploadFenceValue;
+
         inline GPUMesh()
             : vertexCount(0)
             , indexCount(0)
@@ -41,6 +45,7 @@ namespace Angaraka::Graphics::DirectX12 {
             , boundingBoxMax(0.0f, 0.0f, 0.0f)
             , boundingSphereCenter(0.0f, 0.0f, 0.0f)
             , boundingSphereRadius(0.0f)
+            , uploadFenceValue(0)
         {
         }
 
@@ -68,16 +73,17 @@ namespace Angaraka::Graphics::DirectX12 {
      * @brief Manages GPU-side mesh resources and buffers.
      *
      * Similar to TextureManager, this class handles the creation, management,
-     * and cleanup of GPU mesh buffers. It works with the command list for
-     * uploading mesh data and manages temporary upload heaps.
+     * and cleanup of GPU mesh buffers. Vertex and index data are copied by the
+     * UploadManager; CreateGPUMesh returns before the copies have run and the
+     * mesh records the upload batch to wait for.
      */
     export class MeshManager {
     public:
         MeshManager();
         ~MeshManager();
 
-        // Initialize with D3D12 device and command queue
-        bool Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue);
+        // Initialize with D3D12 device and the uploader shared with the TextureManager
+        bool Initialize(ID3D12Device* device, UploadManager* uploadManager);
         void Shutdown();
 
         // Create GPU mesh from CPU mesh data
@@ -86,11 +92,7 @@ namespace Angaraka::Graphics::DirectX12 {
         // Destroy GPU mesh (called by MeshResource::Unload)
         void DestroyGPUMesh(GPUMesh* gpuMesh);
 
-        // Call this after GPU has finished processing upload commands
-        void ClearUploadHeaps();
-
-        ID3D12GraphicsCommandList* GetOrCreateCommandList();
-        void ExecuteAndWaitForGPU();
+        inline UploadManager* GetUploadManager() const { return m_uploadManager; }
 
         // Get statistics
         struct Statistics {
@@ -99,7 +101,7 @@ namespace Angaraka::Graphics::DirectX12 {
             uint32_t totalIndices;
             size_t totalVertexMemory;   // In bytes
             size_t totalIndexMemory;    // In bytes
-            size_t totalUploadMemory;   // In bytes (temporary)
+            size_t totalUploadMemory;   // In bytes, staging space of uploads in flight
         };
         Statistics GetStatistics() const;
 
@@ -112,14 +114,7 @@ namespace Angaraka::Graphics::DirectX12 {
 
     private:
         ID3D12Device* m_device = nullptr;
-
-        // Add command allocator for texture loading
-        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> m_LoadingCommandAllocator;
-        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> m_LoadingCommandList;
-        Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_CommandQueue; // Store command queue reference
-
-        // Track upload heaps that need to be released after GPU completes
-        std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> m_uploadHeapsToRelease;
+        UploadManager* m_uploadManager = nullptr;   // Owned by the graphics system
 
         // Statistics tracking
         mutable Statistics m_stats;
@@ -133,18 +128,14 @@ namespace Angaraka::Graphics::DirectX12 {
         bool m_initialized = false;
 
         // Helper methods
-        bool CreateVertexBuffer(ID3D12GraphicsCommandList* commandList, const MeshData& meshData, GPUMesh& gpuMesh);
-        bool CreateIndexBuffer(ID3D12GraphicsCommandList* commandList, const MeshData& meshData, GPUMesh& gpuMesh);
+        bool CreateVertexBuffer(const MeshData& meshData, GPUMesh& gpuMesh);
+        bool CreateIndexBuffer(const MeshData& meshData, GPUMesh& gpuMesh);
         void UpdateStatistics() const;
 
         // Memory utilities
         inline static D3D12_HEAP_PROPERTIES GetDefaultHeapProperties() {
             return CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
         }
-
-        inline static D3D12_HEAP_PROPERTIES GetUploadHeapProperties() {
-            return CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-        }
     };
 
     /**
@@ -167,6 +158,9 @@ namespace Angaraka::Graphics::DirectX12 {
 
         size_t GetSizeInBytes(void) const override;
 
+        // Deferred until the vertex and index data have reached the GPU
+        void WhenReady(std::function<void()> callback) override;
+
         // Getters for the underlying GPU mesh data
         const GPUMesh* GetGPUMesh() const { return m_gpuMesh.get(); }
         GPUMesh* GetGPUMesh() { return m_gpuMesh.get(); }
@@ -257,6 +251,9 @@ namespace Angaraka::Graphics::DirectX12 {
         Scope<MeshData> m_cpuMeshData;
         bool m_keepCPUData;
 
+        // Uploader the buffers were created through, for WhenReady
+        UploadManager* m_uploadManager = nullptr;
+
         // Vertex layout specification
         std::string m_vertexLayoutString;
 
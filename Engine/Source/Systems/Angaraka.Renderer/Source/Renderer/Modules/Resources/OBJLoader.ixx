@@ -2,12 +2,86 @@
 module;
 
 #include "Angaraka/MeshBase.hpp"
+#include "Angaraka/JobSystem.hpp"
+#include <bit>
+#include <charconv>
 #include <sstream>
 
 export module Angaraka.Graphics.DirectX12.ObjLoader;
 
 namespace Angaraka::Graphics::DirectX12 {
 
+    // Read-only view of a whole file
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { Close(); }
+        DISABLE_COPY_AND_MOVE(MappedFile);
+
+        inline bool Open(const String& filePath)
+        {
+            Close();
+
+            m_file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE) {
+                return false;
+            }
+
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(m_file, &size)) {
+                Close();
+                return false;
+            }
+
+            // Empty files cannot be mapped, they are an empty view
+            m_size = static_cast<size_t>(size.QuadPart);
+            if (m_size == 0) {
+                return true;
+            }
+
+            m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_mapping) {
+                Close();
+                return false;
+            }
+
+            m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!m_data) {
+                Close();
+                return false;
+            }
+            return true;
+        }
+
+        inline void Close()
+        {
+            if (m_data) {
+                UnmapViewOfFile(m_data);
+                m_data = nullptr;
+            }
+            if (m_mapping) {
+                CloseHandle(m_mapping);
+                m_mapping = nullptr;
+            }
+            if (m_file != INVALID_HANDLE_VALUE) {
+                CloseHandle(m_file);
+                m_file = INVALID_HANDLE_VALUE;
+            }
+            m_size = 0;
+        }
+
+        const char* GetData() const { return m_data; }
+        size_t GetSize() const { return m_size; }
+
+    private:
+        HANDLE m_file{ INVALID_HANDLE_VALUE };
+        HANDLE m_mapping{ nullptr };
+        const char* m_data{ nullptr };
+        size_t m_size{ 0 };
+    };
+
     export struct OBJ
     {
         struct Vertex
@@ -26,19 +100,14 @@ namespace Angaraka::Graphics::DirectX12 {
             }
         };
 
-        struct Face
+        // One triangle corner
+        struct VertexIndex
         {
-            struct VertexIndex
-            {
-                int position; // Index into positions array
-                int texCoord; // Index into texture coordinates array (-1 if not specified)
-                int normal;   // Index into normals array (-1 if not specified)
+            I32 position; // Index into positions array
+            I32 texCoord; // Index into texture coordinates array (-1 if not specified)
+            I32 normal;   // Index into normals array (-1 if not specified)
 
-                VertexIndex() : position(-1), texCoord(-1), normal(-1) {}
-            };
-
-            std::vector<VertexIndex> vertices;  // Indices of vertices in the face - usually 3 or 4 for triangles/quads
-            String material;                    // Material name for this face (if any)
+            VertexIndex() : position(-1), texCoord(-1), normal(-1) {}
         };
 
         struct Material
@@ -70,7 +139,7 @@ namespace Angaraka::Graphics::DirectX12 {
             std::vector<DirectX::XMFLOAT3> positions;  // Vertex positions
             std::vector<DirectX::XMFLOAT3> normals;    // Vertex normals
             std::vector<DirectX::XMFLOAT2> texCoords;  // Texture coordinates
-            std::vector<Face> faces;                   // Faces (triangles/quads)
+            std::vector<VertexIndex> triangles;        // Three corners per triangle, polygons are fan-split
             std::vector<Material> materials;           // Materials defined in the OBJ file
             std::unordered_map<String, size_t> materialMap; // Maps material names to indices
             String name;                               // Name of the OBJ file (for identification)
@@ -80,13 +149,97 @@ namespace Angaraka::Graphics::DirectX12 {
                 positions.clear();
                 normals.clear();
                 texCoords.clear();
-                faces.clear();
+                triangles.clear();
                 materials.clear();
                 materialMap.clear();
                 name.clear();
             }
         };
 
+        /**
+         * @brief Maps position/texCoord/normal triples to vertex indices
+         *
+         * The three indices are packed into a 96-bit key and stored inline in an
+         * open-addressing table with linear probing, so a lookup is a hash and a few
+         * compares on one cache line instead of building and hashing a string.
+         */
+        class VertexCache
+        {
+        public:
+            static constexpr U32 EMPTY = ~0u;
+
+            // Clears the table and sizes it for the expected number of unique vertices
+            inline void Reset(size_t expectedVertices)
+            {
+                m_slots.assign(std::bit_ceil(std::max<size_t>(expectedVertices * 2, 64)), Slot{});
+                m_mask = m_slots.size() - 1;
+                m_count = 0;
+            }
+
+            // Returns the vertex stored for the corner, or stores and returns newVertex if absent
+            inline U32 FindOrInsert(const VertexIndex& corner, U32 newVertex)
+            {
+                if ((m_count + 1) * 2 > m_slots.size()) {
+                    Grow();
+                }
+
+                const U64 low = static_cast<U64>(static_cast<U32>(corner.position)) |
+                    (static_cast<U64>(static_cast<U32>(corner.texCoord)) << 32);
+                const U32 high = static_cast<U32>(corner.normal);
+
+                for (size_t i = Hash(low, high) & m_mask;; i = (i + 1) & m_mask) {
+                    Slot& slot = m_slots[i];
+                    if (slot.vertex == EMPTY) {
+                        slot = { low, high, newVertex };
+                        ++m_count;
+                        return newVertex;
+                    }
+                    if (slot.low == low && slot.high == high) {
+                        return slot.vertex;
+                    }
+                }
+            }
+
+            size_t GetCount() const { return m_count; }
+
+        private:
+            struct Slot
+            {
+                U64 low{ 0 };           // Position and texCoord
+                U32 high{ 0 };          // Normal
+                U32 vertex{ EMPTY };
+            };
+
+            std::vector<Slot> m_slots;
+            size_t m_mask{ 0 };
+            size_t m_count{ 0 };
+
+            static inline size_t Hash(U64 low, U32 high)
+            {
+                // splitmix64 finalizer, the table index takes the low bits
+                U64 h = low + static_cast<U64>(high) * 0x9E3779B97F4A7C15ull;
+                h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+                h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+                return static_cast<size_t>(h ^ (h >> 31));
+            }
+
+            inline void Grow()
+            {
+                std::vector<Slot> old(std::max<size_t>(m_slots.size() * 2, 64));
+                old.swap(m_slots);
+                m_mask = m_slots.size() - 1;
+
+                for (const Slot& slot : old) {
+                    if (slot.vertex == EMPTY) continue;
+                    size_t i = Hash(slot.low, slot.high) & m_mask;
+                    while (m_slots[i].vertex != EMPTY) {
+                        i = (i + 1) & m_mask;
+                    }
+                    m_slots[i] = slot;
+                }
+            }
+        };
+
         // File Loader
         class Loader
         {
@@ -101,14 +254,14 @@ namespace Angaraka::Graphics::DirectX12 {
                 // Parse OBJ file
                 Data objData;
                 if (!ParseFile(filePath, objData)) {
-                    AGK_ERROR("OBJ::Loader: Failed to parse OBJ file '{}'", filePath);
+                    AGK_ERROR("OBJ::Loader: Failed to parse OBJ file '{}': {}", filePath, m_lastError);
                     return nullptr;
                 }
 
                 // Convert to MeshData
                 auto meshData = std::make_unique<MeshData>();
                 if (!ConvertToMeshData(objData, *meshData, targetLayout)) {
-                    AGK_ERROR("OBJ::Loader: Failed to convert OBJ data to MeshData for '{}'", filePath);
+                    AGK_ERROR("OBJ::Loader: Failed to convert OBJ data to MeshData for '{}': {}", filePath, m_lastError);
                     return nullptr;
                 }
 
@@ -124,97 +277,303 @@ namespace Angaraka::Graphics::DirectX12 {
                 return Load(filePath, layout);
             }
 
-            const String& GetLastError() const;
+            const String& GetLastError() const { return m_lastError; }
+
+            // Large files are split at line boundaries and parsed on the job system when it is running
+            void SetParallel(bool parallel) { m_parallel = parallel; }
+
+            // Smallest chunk a file is split into; files under twice this size are parsed on one
+            // thread. Lowering it lets small files take the chunked path, e.g. in tests.
+            void SetMinChunkBytes(size_t bytes) { m_minChunkBytes = std::max<size_t>(bytes, 1); }
 
         private:
+            static constexpr size_t DEFAULT_MIN_CHUNK_BYTES = 4 * 1024 * 1024;
+
+            // Elements parsed from one range of lines
+            struct Chunk
+            {
+                std::vector<DirectX::XMFLOAT3> positions;
+                std::vector<DirectX::XMFLOAT3> normals;
+                std::vector<DirectX::XMFLOAT2> texCoords;
+                std::vector<VertexIndex> triangles;
+                std::vector<size_t> relativeCorners[3];    // Per attribute, corners indexed from this chunk's first element
+                std::vector<String> materialLibraries;
+                String name;
+
+                size_t lines{ 0 };
+                size_t errorLine{ 0 };                      // Within the chunk, 0 when it parsed
+                String error;
+            };
+
             String m_lastError;
+            bool m_parallel{ true };
+            size_t m_minChunkBytes{ DEFAULT_MIN_CHUNK_BYTES };
+            VertexCache m_vertexCache;
 
             inline bool ParseFile(const String& filePath, Data& objData)
             {
-                std::ifstream file(filePath);
-                if (!file.is_open()) {
+                MappedFile file;
+                if (!file.Open(filePath)) {
                     m_lastError = "Could not open file: " + filePath;
                     return false;
                 }
 
                 objData.Clear();
-                String line;
-                String currentMaterial;
-                int lineNumber = 0;
 
-                while (std::getline(file, line)) {
-                    lineNumber++;
+                const char* begin = file.GetData();
+                const size_t size = file.GetSize();
 
-                    // Skip empty lines and comments
-                    if (line.empty() || line[0] == '#') continue;
+                size_t chunkCount = 1;
+                auto& jobSystem = Core::JobSystem::Get();
+                if (m_parallel && size >= 2 * m_minChunkBytes && jobSystem.IsRunning()) {
+                    chunkCount = std::min(size / m_minChunkBytes, (jobSystem.GetWorkerCount() + 1) * 2);
+                }
 
-                    std::istringstream iss(line);
-                    String token;
-                    iss >> token;
+                // Chunks start on the line after an even split point
+                std::vector<const char*> bounds(chunkCount + 1, begin + size);
+                bounds[0] = begin;
+                for (size_t i = 1; i < chunkCount; ++i) {
+                    const char* split = std::max(begin + size / chunkCount * i, bounds[i - 1]);
+                    const char* newline = static_cast<const char*>(memchr(split, '\n', begin + size - split));
+                    bounds[i] = newline ? newline + 1 : begin + size;
+                }
 
-                    try {
-                        if (token == "v") {
-                            // Vertex position: v x y z [w]
-                            DirectX::XMFLOAT3 pos;
-                            iss >> pos.x >> pos.y >> pos.z;
-                            objData.positions.push_back(pos);
+                std::vector<Chunk> chunks(chunkCount);
+                if (chunkCount > 1) {
+                    jobSystem.ParallelFor(chunkCount, 1, [&](size_t first, size_t last) {
+                        for (size_t i = first; i < last; ++i) {
+                            ParseChunk(bounds[i], bounds[i + 1], chunks[i]);
                         }
-                        else if (token == "vn") {
-                            // Vertex normal: vn x y z
-                            DirectX::XMFLOAT3 normal;
-                            iss >> normal.x >> normal.y >> normal.z;
-                            objData.normals.push_back(normal);
+                        }, Core::JobPriority::Normal);
+                }
+                else if (size > 0) {
+                    ParseChunk(begin, begin + size, chunks[0]);
+                }
+
+                if (!MergeChunks(chunks, objData)) {
+                    return false;
+                }
+
+                // Material libraries are resolved relative to the OBJ file
+                const String directory = GetDirectoryFromPath(filePath);
+                for (const Chunk& chunk : chunks) {
+                    for (const String& mtlFile : chunk.materialLibraries) {
+                        ParseMTLFile(directory + "/" + mtlFile, objData);
+                    }
+                }
+
+                // Validation
+                if (objData.positions.empty()) {
+                    m_lastError = "No vertex positions found in OBJ file";
+                    return false;
+                }
+
+                if (objData.triangles.empty()) {
+                    m_lastError = "No faces found in OBJ file";
+                    return false;
+                }
+
+                return true;
+            }
+
+            // Parses the lines in [begin, end). Indices are zero-based afterwards; relative ones
+            // are resolved against the chunk's own elements and recorded for MergeChunks.
+            static inline void ParseChunk(const char* begin, const char* end, Chunk& chunk)
+            {
+                std::vector<VertexIndex> polygon;
+                std::vector<U8> polygonRelative;     // Bit per attribute for each polygon corner
+
+                for (const char* line = begin; line < end;) {
+                    const char* newline = static_cast<const char*>(memchr(line, '\n', end - line));
+                    const char* lineEnd = newline ? newline : end;
+                    const char* next = newline ? newline + 1 : end;
+                    if (lineEnd > line && lineEnd[-1] == '\r') {
+                        --lineEnd;
+                    }
+                    ++chunk.lines;
+
+                    const char* p = SkipSpaces(line, lineEnd);
+                    if (p == lineEnd || *p == '#') {
+                        line = next;
+                        continue;
+                    }
+
+                    if (IsKeyword(p, lineEnd, "v")) {
+                        // Vertex position: v x y z [w]
+                        DirectX::XMFLOAT3 pos;
+                        p += 1;
+                        if (!ParseFloat(p, lineEnd, pos.x) || !ParseFloat(p, lineEnd, pos.y) || !ParseFloat(p, lineEnd, pos.z)) {
+                            SetChunkError(chunk, "Invalid vertex position");
+                            return;
                         }
-                        else if (token == "vt") {
-                            // Texture coordinate: vt u v [w]
-                            DirectX::XMFLOAT2 texCoord;
-                            iss >> texCoord.x >> texCoord.y;
-                            texCoord.y = 1.0f - texCoord.y; // Flip V coordinate for DirectX
-                            objData.texCoords.push_back(texCoord);
+                        chunk.positions.push_back(pos);
+                    }
+                    else if (IsKeyword(p, lineEnd, "vn")) {
+                        // Vertex normal: vn x y z
+                        DirectX::XMFLOAT3 normal;
+                        p += 2;
+                        if (!ParseFloat(p, lineEnd, normal.x) || !ParseFloat(p, lineEnd, normal.y) || !ParseFloat(p, lineEnd, normal.z)) {
+                            SetChunkError(chunk, "Invalid vertex normal");
+                            return;
                         }
-                        else if (token == "f") {
-                            // Face: f v1[/vt1[/vn1]] v2[/vt2[/vn2]] v3[/vt3[/vn3]] [v4[/vt4[/vn4]]]
-                            if (!ParseFace(line, objData, currentMaterial)) {
-                                m_lastError = "Failed to parse face at line " + std::to_string(lineNumber);
-                                return false;
-                            }
+                        chunk.normals.push_back(normal);
+                    }
+                    else if (IsKeyword(p, lineEnd, "vt")) {
+                        // Texture coordinate: vt u [v [w]]
+                        DirectX::XMFLOAT2 texCoord(0.0f, 0.0f);
+                        p += 2;
+                        if (!ParseFloat(p, lineEnd, texCoord.x)) {
+                            SetChunkError(chunk, "Invalid texture coordinate");
+                            return;
+                        }
+                        ParseFloat(p, lineEnd, texCoord.y);
+                        texCoord.y = 1.0f - texCoord.y; // Flip V coordinate for DirectX
+                        chunk.texCoords.push_back(texCoord);
+                    }
+                    else if (IsKeyword(p, lineEnd, "f")) {
+                        // Face: f v1[/vt1[/vn1]] v2[/vt2[/vn2]] v3[/vt3[/vn3]] [v4[/vt4[/vn4]] ...]
+                        if (!ParseFace(p + 1, lineEnd, chunk, polygon, polygonRelative)) {
+                            SetChunkError(chunk, "Failed to parse face");
+                            return;
+                        }
+                    }
+                    else if (IsKeyword(p, lineEnd, "mtllib")) {
+                        // Material library: mtllib filename.mtl
+                        chunk.materialLibraries.emplace_back(ReadToken(p + 6, lineEnd));
+                    }
+                    else if (IsKeyword(p, lineEnd, "o") || IsKeyword(p, lineEnd, "g")) {
+                        // Object/group name: o name or g name
+                        chunk.name = ReadToken(p + 1, lineEnd);
+                    }
+                    // Ignore other tokens (usemtl, s for smoothing groups, etc.)
+
+                    line = next;
+                }
+            }
+
+            static inline bool ParseFace(const char* p, const char* end, Chunk& chunk,
+                std::vector<VertexIndex>& polygon, std::vector<U8>& polygonRelative)
+            {
+                polygon.clear();
+                polygonRelative.clear();
+
+                const size_t counts[3] = { chunk.positions.size(), chunk.texCoords.size(), chunk.normals.size() };
+                while ((p = SkipSpaces(p, end)) < end) {
+                    I32 indices[3] = { -1, -1, -1 };
+                    U8 relative = 0;
+
+                    // Parse vertex index format: v[/vt][/vn], position index required
+                    for (U32 attribute = 0; attribute < 3; ++attribute) {
+                        if (attribute > 0) {
+                            if (p == end || *p != '/') break;
+                            ++p;
                         }
-                        else if (token == "mtllib") {
-                            // Material library: mtllib filename.mtl
-                            String mtlFile;
-                            iss >> mtlFile;
 
-                            // Extract directory from OBJ path
-                            String directory = GetDirectoryFromPath(filePath);
-                            String mtlPath = directory + "/" + mtlFile;
+                        I32 index = 0;
+                        if (!ParseIndex(p, end, index)) {
+                            if (attribute == 0) return false;
+                            continue;   // Empty, as in v//vn
+                        }
 
-                            ParseMTLFile(mtlPath, objData);
+                        if (index > 0) {
+                            indices[attribute] = index - 1;     // Convert to 0-based
                         }
-                        else if (token == "usemtl") {
-                            // Use material: usemtl material_name
-                            iss >> currentMaterial;
+                        else if (index < 0) {
+                            // Relative to the elements parsed so far
+                            indices[attribute] = static_cast<I32>(counts[attribute]) + index;
+                            relative |= 1 << attribute;
                         }
-                        else if (token == "o" || token == "g") {
-                            // Object/group name: o name or g name
-                            iss >> objData.name;
+                        else if (attribute == 0) {
+                            return false;
                         }
-                        // Ignore other tokens (s for smoothing groups, etc.)
                     }
-                    catch (const std::exception& e) {
-                        m_lastError = "Parse error at line " + std::to_string(lineNumber) + ": " + e.what();
+
+                    if (p < end && *p != ' ' && *p != '\t') {
                         return false;
                     }
+
+                    VertexIndex corner;
+                    corner.position = indices[0];
+                    corner.texCoord = indices[1];
+                    corner.normal = indices[2];
+                    polygon.push_back(corner);
+                    polygonRelative.push_back(relative);
                 }
 
-                // Validation
-                if (objData.positions.empty()) {
-                    m_lastError = "No vertex positions found in OBJ file";
+                // Must have at least 3 vertices
+                if (polygon.size() < 3) {
                     return false;
                 }
 
-                if (objData.faces.empty()) {
-                    m_lastError = "No faces found in OBJ file";
-                    return false;
+                // Fan triangulation: 0, i, i + 1
+                for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                    for (size_t corner : { size_t{ 0 }, i, i + 1 }) {
+                        for (U32 attribute = 0; attribute < 3; ++attribute) {
+                            if (polygonRelative[corner] & (1 << attribute)) {
+                                chunk.relativeCorners[attribute].push_back(chunk.triangles.size());
+                            }
+                        }
+                        chunk.triangles.push_back(polygon[corner]);
+                    }
+                }
+
+                return true;
+            }
+
+            // Concatenates the chunks in file order and rebases their relative indices
+            inline bool MergeChunks(std::vector<Chunk>& chunks, Data& objData)
+            {
+                size_t lineBase = 0;
+                size_t positionCount = 0, texCoordCount = 0, normalCount = 0, cornerCount = 0;
+                for (const Chunk& chunk : chunks) {
+                    if (chunk.errorLine != 0) {
+                        m_lastError = chunk.error + " at line " + std::to_string(lineBase + chunk.errorLine);
+                        return false;
+                    }
+                    lineBase += chunk.lines;
+                    positionCount += chunk.positions.size();
+                    texCoordCount += chunk.texCoords.size();
+                    normalCount += chunk.normals.size();
+                    cornerCount += chunk.triangles.size();
+                }
+
+                if (chunks.size() == 1) {
+                    objData.positions = std::move(chunks[0].positions);
+                    objData.texCoords = std::move(chunks[0].texCoords);
+                    objData.normals = std::move(chunks[0].normals);
+                    objData.triangles = std::move(chunks[0].triangles);
+                    objData.name = chunks[0].name;
+                    return true;
+                }
+
+                objData.positions.reserve(positionCount);
+                objData.texCoords.reserve(texCoordCount);
+                objData.normals.reserve(normalCount);
+                objData.triangles.reserve(cornerCount);
+
+                for (Chunk& chunk : chunks) {
+                    const I32 bases[3] = {
+                        static_cast<I32>(objData.positions.size()),
+                        static_cast<I32>(objData.texCoords.size()),
+                        static_cast<I32>(objData.normals.size())
+                    };
+                    const size_t firstCorner = objData.triangles.size();
+
+                    objData.positions.insert(objData.positions.end(), chunk.positions.begin(), chunk.positions.end());
+                    objData.texCoords.insert(objData.texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+                    objData.normals.insert(objData.normals.end(), chunk.normals.begin(), chunk.normals.end());
+                    objData.triangles.insert(objData.triangles.end(), chunk.triangles.begin(), chunk.triangles.end());
+
+                    for (size_t corner : chunk.relativeCorners[0]) objData.triangles[firstCorner + corner].position += bases[0];
+                    for (size_t corner : chunk.relativeCorners[1]) objData.triangles[firstCorner + corner].texCoord += bases[1];
+                    for (size_t corner : chunk.relativeCorners[2]) objData.triangles[firstCorner + corner].normal += bases[2];
+
+                    if (!chunk.name.empty()) {
+                        objData.name = chunk.name;
+                    }
+
+                    // Free each chunk as soon as it is copied to keep the peak down
+                    chunk = Chunk{};
                 }
 
                 return true;
@@ -227,63 +586,49 @@ namespace Angaraka::Graphics::DirectX12 {
                 meshData.layout = VertexLayoutFactory::CreateLayout(targetLayout);
                 meshData.name = objData.name.empty() ? "OBJ_Mesh" : objData.name;
 
-                // Create vertex map to avoid duplicates (OBJ can have shared vertices)
-                std::unordered_map<std::string, uint32_t> vertexMap;
-                std::vector<Vertex> uniqueVertices;
-
-                // Process each face
-                for (const Face& face : objData.faces) {
-                    if (face.vertices.size() != 3) continue; // Should be triangles by now
+                const I32 positionCount = static_cast<I32>(objData.positions.size());
+                const I32 texCoordCount = static_cast<I32>(objData.texCoords.size());
+                const I32 normalCount = static_cast<I32>(objData.normals.size());
 
-                    for (const auto& vertIdx : face.vertices) {
-                        // Create vertex key for deduplication
-                        std::string vertexKey = std::to_string(vertIdx.position) + "/" +
-                            std::to_string(vertIdx.texCoord) + "/" +
-                            std::to_string(vertIdx.normal);
+                // Deduplicate shared vertices (OBJ indexes each attribute separately)
+                m_vertexCache.Reset(std::max(objData.positions.size(), objData.triangles.size() / 6));
+                std::vector<Vertex> uniqueVertices;
+                uniqueVertices.reserve(objData.positions.size());
+                meshData.indices.reserve(objData.triangles.size());
 
-                        uint32_t finalVertexIndex;
-                        auto it = vertexMap.find(vertexKey);
+                for (VertexIndex vertIdx : objData.triangles) {
+                    // Position (required)
+                    if (vertIdx.position < 0 || vertIdx.position >= positionCount) {
+                        m_lastError = "Face references missing vertex position " + std::to_string(vertIdx.position + 1);
+                        return false;
+                    }
 
-                        if (it != vertexMap.end()) {
-                            // Vertex already exists
-                            finalVertexIndex = it->second;
+                    // Invalid optional attributes fall back to the defaults
+                    if (vertIdx.texCoord >= texCoordCount) vertIdx.texCoord = -1;
+                    if (vertIdx.normal >= normalCount) vertIdx.normal = -1;
+                    vertIdx.texCoord = std::max(vertIdx.texCoord, -1);
+                    vertIdx.normal = std::max(vertIdx.normal, -1);
+
+                    const U32 newVertex = static_cast<U32>(uniqueVertices.size());
+                    const U32 finalVertexIndex = m_vertexCache.FindOrInsert(vertIdx, newVertex);
+                    if (finalVertexIndex == newVertex) {
+                        Vertex vertex;
+                        vertex.position = objData.positions[vertIdx.position];
+                        if (vertIdx.normal >= 0) {
+                            vertex.normal = objData.normals[vertIdx.normal];
                         }
-                        else {
-                            // Create new vertex
-                            Vertex vertex;
-
-                            // Position (required)
-                            vertex.position = objData.positions[vertIdx.position];
-
-                            // Normal (optional - calculate if missing)
-                            if (vertIdx.normal >= 0) {
-                                vertex.normal = objData.normals[vertIdx.normal];
-                            }
-                            else {
-                                // Use default normal or calculate from face
-                                vertex.normal = DirectX::XMFLOAT3(0.0f, 1.0f, 0.0f);
-                            }
-
-                            // Texture coordinates (optional)
-                            if (vertIdx.texCoord >= 0) {
-                                vertex.texCoord = objData.texCoords[vertIdx.texCoord];
-                            }
-                            else {
-                                vertex.texCoord = DirectX::XMFLOAT2(0.0f, 0.0f);
-                            }
-
-                            // Color (default white, can be enhanced later)
-                            vertex.color = DirectX::XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
-
-                            finalVertexIndex = static_cast<uint32_t>(uniqueVertices.size());
-                            uniqueVertices.push_back(vertex);
-                            vertexMap[vertexKey] = finalVertexIndex;
+                        if (vertIdx.texCoord >= 0) {
+                            vertex.texCoord = objData.texCoords[vertIdx.texCoord];
                         }
-
-                        meshData.indices.push_back(finalVertexIndex);
+                        uniqueVertices.push_back(vertex);
                     }
+
+                    meshData.indices.push_back(finalVertexIndex);
                 }
 
+                // The table is only needed while converting
+                m_vertexCache = VertexCache{};
+
                 // Set counts
                 meshData.vertexCount = static_cast<uint32_t>(uniqueVertices.size());
                 meshData.indexCount = static_cast<uint32_t>(meshData.indices.size());
@@ -368,86 +713,66 @@ namespace Angaraka::Graphics::DirectX12 {
                 AGK_INFO("OBJ::Loader: Loaded {} materials from MTL file", objData.materials.size());
             }
 
-            inline bool ParseFace(const String& line, Data& objData, String& currentMaterial)
-            {
-                std::istringstream iss(line);
-                String token;
-                iss >> token; // Skip "f"
-
-                Face face;
-                face.material = currentMaterial;
-
-                String vertexStr;
-                while (iss >> vertexStr) {
-                    Face::VertexIndex vertIdx;
+            // Scanner helpers, all bounded by the end of the current line
 
-                    // Parse vertex index format: v[/vt[/vn]]
-                    std::istringstream vertexStream(vertexStr);
-                    String indexStr;
+            static inline const char* SkipSpaces(const char* p, const char* end)
+            {
+                while (p < end && (*p == ' ' || *p == '\t')) ++p;
+                return p;
+            }
 
-                    // Position index (required)
-                    if (std::getline(vertexStream, indexStr, '/')) {
-                        vertIdx.position = std::stoi(indexStr) - 1; // Convert to 0-based
-                        if (vertIdx.position < 0 || vertIdx.position >= static_cast<int>(objData.positions.size())) {
-                            return false;
-                        }
-                    }
+            // True if the line continues with the keyword followed by whitespace or the end of the line
+            static inline bool IsKeyword(const char* p, const char* end, std::string_view keyword)
+            {
+                const size_t length = keyword.size();
+                if (static_cast<size_t>(end - p) < length || std::string_view(p, length) != keyword) {
+                    return false;
+                }
+                return p + length == end || p[length] == ' ' || p[length] == '\t';
+            }
 
-                    // Texture coordinate index (optional)
-                    if (std::getline(vertexStream, indexStr, '/') && !indexStr.empty()) {
-                        vertIdx.texCoord = std::stoi(indexStr) - 1; // Convert to 0-based
-                        if (vertIdx.texCoord < 0 || vertIdx.texCoord >= static_cast<int>(objData.texCoords.size())) {
-                            vertIdx.texCoord = -1; // Invalid, will use default
-                        }
-                    }
+            static inline String ReadToken(const char* p, const char* end)
+            {
+                p = SkipSpaces(p, end);
+                const char* tokenEnd = p;
+                while (tokenEnd < end && *tokenEnd != ' ' && *tokenEnd != '\t') ++tokenEnd;
+                return String(p, tokenEnd);
+            }
 
-                    // Normal index (optional)
-                    if (std::getline(vertexStream, indexStr) && !indexStr.empty()) {
-                        vertIdx.normal = std::stoi(indexStr) - 1; // Convert to 0-based
-                        if (vertIdx.normal < 0 || vertIdx.normal >= static_cast<int>(objData.normals.size())) {
-                            vertIdx.normal = -1; // Invalid, will calculate
-                        }
-                    }
+            static inline bool ParseFloat(const char*& p, const char* end, F32& value)
+            {
+                p = SkipSpaces(p, end);
+                if (p < end && *p == '+') ++p;
 
-                    face.vertices.push_back(vertIdx);
+                const auto [next, error] = std::from_chars(p, end, value);
+                if (error == std::errc::result_out_of_range) {
+                    value = 0.0f;   // Denormals and overflow are not meaningful geometry
                 }
-
-                // Must have at least 3 vertices
-                if (face.vertices.size() < 3) {
+                else if (error != std::errc()) {
                     return false;
                 }
+                p = next;
+                return true;
+            }
 
-                // If quad, split into two triangles
-                if (face.vertices.size() == 4) {
-                    // First triangle: 0, 1, 2
-                    Face triangle1;
-                    triangle1.material = face.material;
-                    triangle1.vertices = { face.vertices[0], face.vertices[1], face.vertices[2] };
-                    objData.faces.push_back(triangle1);
-
-                    // Second triangle: 0, 2, 3
-                    Face triangle2;
-                    triangle2.material = face.material;
-                    triangle2.vertices = { face.vertices[0], face.vertices[2], face.vertices[3] };
-                    objData.faces.push_back(triangle2);
-                }
-                else if (face.vertices.size() == 3) {
-                    // Triangle - add directly
-                    objData.faces.push_back(face);
-                }
-                else {
-                    // Polygon with >4 vertices - triangulate (simple fan triangulation)
-                    for (size_t i = 1; i < face.vertices.size() - 1; ++i) {
-                        Face triangle;
-                        triangle.material = face.material;
-                        triangle.vertices = { face.vertices[0], face.vertices[i], face.vertices[i + 1] };
-                        objData.faces.push_back(triangle);
-                    }
-                }
+            static inline bool ParseIndex(const char*& p, const char* end, I32& value)
+            {
+                if (p < end && *p == '+') ++p;
 
+                const auto [next, error] = std::from_chars(p, end, value);
+                if (error != std::errc()) {
+                    return false;
+                }
+                p = next;
                 return true;
             }
 
+            static inline void SetChunkError(Chunk& chunk, const char* error)
+            {
+                chunk.errorLine = chunk.lines;
+                chunk.error = error;
+            }
+
             // Pack OBJVertex data into interleaved vertex buffer
             inline bool PackVertices(const std::vector<Vertex>& vertices, MeshData& meshData) {
                 const auto& layout = meshData.layout;
@@ -10,6 +10,7 @@ module Angaraka.Graphics.DirectX12.Texture;
 
 import Angaraka.Core.Resources;
 import Angaraka.Graphics.DirectX12;
+import Angaraka.Graphics.DirectX12.UploadManager;
 
 namespace Angaraka::Graphics::DirectX12 {
 
@@ -333,6 +334,7 @@ namespace Angaraka::Graphics::DirectX12 {
             return m_isLoaded;
         }
         
+        m_uploadManager = textureManager->GetUploadManager();
         m_textureData = textureManager->LoadTexture(filePath);
 
         if (m_textureData) {
@@ -360,6 +362,14 @@ namespace Angaraka::Graphics::DirectX12 {
         }
     }
 
+    void TextureResource::WhenReady(std::function<void()> callback) {
+        if (m_textureData && m_uploadManager) {
+            m_uploadManager->WhenComplete(m_textureData->UploadFenceValue, std::move(callback));
+            return;
+        }
+        callback();
+    }
+
     ID3D12Resource* TextureResource::GetD3D12Resource() const {
         return m_textureData ? m_textureData->Resource.Get() : nullptr;
     }
@@ -382,28 +392,16 @@ namespace Angaraka::Graphics::DirectX12 {
     TextureManager::TextureManager() { m_LoadedTextures.clear(); }
     TextureManager::~TextureManager() { Shutdown(); }
 
-    bool TextureManager::Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue)
+    bool TextureManager::Initialize(ID3D12Device* device, UploadManager* uploadManager)
     {
-        if (!device || !commandQueue)
+        if (!device || !uploadManager)
         {
-            AGK_ERROR("TextureManager::Initialize: Invalid D3D12 device or command queue.");
+            AGK_ERROR("TextureManager::Initialize: Invalid D3D12 device or upload manager.");
             return false;
         }
 
         m_Device = device;
-        m_CommandQueue = commandQueue;
-
-        // Create dedicated command allocator for texture loading
-        DXCall(m_Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
-            IID_PPV_ARGS(&m_LoadingCommandAllocator)));
-
-        // Create dedicated command list for texture loading
-        DXCall(m_Device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT,
-            m_LoadingCommandAllocator.Get(), nullptr,
-            IID_PPV_ARGS(&m_LoadingCommandList)));
-
-        // Close it initially
-        DXCall(m_LoadingCommandList->Close());
+        m_UploadManager = uploadManager;
 
         // Allocate a small descriptor heap for SRVs (Shader Resource Views)
         // This is a very basic, fixed-size heap for now. A real engine would have a dynamic allocator.
@@ -423,45 +421,18 @@ namespace Angaraka::Graphics::DirectX12 {
         if (!initialized) {
             return;
         }
-        m_LoadedTextures.clear(); // Release shared_ptrs to textures
+        {
+            std::lock_guard<std::mutex> lock(m_TexturesMutex);
+            m_LoadedTextures.clear(); // Release shared_ptrs to textures
+        }
         m_SrvHeap.Reset();
         m_Device = nullptr;
+        m_UploadManager = nullptr;
 
         initialized = false;
         AGK_INFO("TextureManager shut down.");
     }
 
-    ID3D12GraphicsCommandList* TextureManager::GetOrCreateCommandList() {
-        // Reset allocator and command list for new recording
-        DXCall(m_LoadingCommandAllocator->Reset());
-        DXCall(m_LoadingCommandList->Reset(m_LoadingCommandAllocator.Get(), nullptr));
-
-        return m_LoadingCommandList.Get();
-    }
-
-    void TextureManager::ExecuteAndWaitForGPU() {
-        // Close command list
-        DXCall(m_LoadingCommandList->Close());
-
-        // Execute on command queue
-        ID3D12CommandList* commandLists[] = { m_LoadingCommandList.Get() };
-        m_CommandQueue->ExecuteCommandLists(1, commandLists);
-
-        // Wait for completion (simple synchronization)
-        // In production, use proper fence synchronization
-        Microsoft::WRL::ComPtr<ID3D12Fence> fence;
-        DXCall(m_Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
-
-        DXCall(m_CommandQueue->Signal(fence.Get(), 1));
-
-        if (fence->GetCompletedValue() < 1) {
-            HANDLE fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-            DXCall(fence->SetEventOnCompletion(1, fenceEvent));
-            WaitForSingleObject(fenceEvent, INFINITE);
-            CloseHandle(fenceEvent);
-        }
-    }
-
     bool TextureManager::CreateSrvDescriptorHeap(UINT numDescriptors)
     {
         D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
@@ -562,16 +533,6 @@ namespace Angaraka::Graphics::DirectX12 {
             return nullptr;
         }
 
-        // For now, let's create a temporary unique name based on a counter
-        // Later, this would be based on the file path or a proper asset ID
-        String tempName = "TempTexture_" + std::to_string(m_LoadedTextures.size());
-        if (m_LoadedTextures.count(tempName))
-        {
-            AGK_WARN("Texture with temporary name '{}' already exists in cache. This indicates a potential issue with unique naming.", tempName);
-            // Return existing for now, but in a real system, you'd ensure uniqueness or better caching.
-            return m_LoadedTextures.at(tempName);
-        }
-
         Reference<Texture> texture = CreateReference<Texture>();
         texture->Width = static_cast<UINT>(imageData.Width);
         texture->Height = static_cast<UINT>(imageData.Height);
@@ -590,13 +551,14 @@ namespace Angaraka::Graphics::DirectX12 {
         textureDesc.SampleDesc.Quality = 0;
         textureDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
 
-        // 2. Create a default heap resource for the GPU texture
+        // 2. Create a default heap resource for the GPU texture. The device and the uploader are
+        //    free-threaded, so only the descriptor allocation and the cache below take the lock.
         CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_DEFAULT);
         HRESULT hr = m_Device->CreateCommittedResource(
             &heapProps, // Default heap for GPU-accessible resource
             D3D12_HEAP_FLAG_NONE,
             &textureDesc,
-            D3D12_RESOURCE_STATE_COPY_DEST, // Start in copy_dest state to upload data
+            D3D12_RESOURCE_STATE_COMMON, // Promoted to COPY_DEST by the copy queue, then to PIXEL_SHADER_RESOURCE on first use
             nullptr, // No optimized clear value for textures
             IID_PPV_ARGS(&texture->Resource));
         if (FAILED(hr))
@@ -606,48 +568,32 @@ namespace Angaraka::Graphics::DirectX12 {
         }
         NAME_D3D12_OBJECT(texture->Resource, "Angaraka Texture Resource");
 
-        // This is a temporary upload buffer. A real engine uses a single, persistent upload heap.
-        const UINT64 uploadBufferSize = GetRequiredIntermediateSize(texture->Resource.Get(), 0, 1);
-
-        // 3. Create an upload heap for copying CPU data to GPU
-        CD3DX12_HEAP_PROPERTIES uploadHeapProps(D3D12_HEAP_TYPE_UPLOAD);
-        CD3DX12_RESOURCE_DESC uploadResourceDesc = CD3DX12_RESOURCE_DESC::Buffer(GetRequiredIntermediateSize(texture->Resource.Get(), 0, 1));
-
-        Microsoft::WRL::ComPtr<ID3D12Resource> tempUploadHeap; // Temporary ComPtr for creation
-        DXCall(m_Device->CreateCommittedResource(
-            &uploadHeapProps,
-            D3D12_HEAP_FLAG_NONE,
-            &uploadResourceDesc,
-            D3D12_RESOURCE_STATE_GENERIC_READ, // Upload heaps are always in this state
-            nullptr,
-            IID_PPV_ARGS(&tempUploadHeap)));
-
-        NAME_D3D12_OBJECT(tempUploadHeap, "Angaraka Texture Upload Heap"); // Useful for debugging
-
-        // IMPORTANT: Add this temporary upload heap to the list to keep it alive
-        // The push_back operation copies the ComPtr, incrementing its reference count.
-        m_UploadHeapsToRelease.push_back(tempUploadHeap);
-
-        // Get the raw pointer to the resource that was just added to the vector
-        ID3D12Resource* currentUploadHeap = m_UploadHeapsToRelease.back().Get();
-
-        // Copy data from CPU ImageData to the upload heap, then to the default heap
+        // 3. Copy data from CPU ImageData through the staging ring into the default heap
         D3D12_SUBRESOURCE_DATA subresourceData = {};
         subresourceData.pData = imageData.Pixels.get();
         subresourceData.RowPitch = imageData.RowPitch;
         subresourceData.SlicePitch = imageData.SlicePitch;
 
-        // Use the currentUploadHeap obtained from the vector
-        auto commandList = GetOrCreateCommandList();
-        UpdateSubresources(commandList, texture->Resource.Get(), currentUploadHeap, 0, 0, 1, &subresourceData);
+        texture->UploadFenceValue = m_UploadManager->UploadTexture(texture->Resource.Get(), subresourceData);
+        if (texture->UploadFenceValue == 0)
+        {
+            AGK_ERROR("Failed to upload pixel data for {}x{} texture.", texture->Width, texture->Height);
+            return nullptr;
+        }
 
+        // 4. Create Shader Resource View (SRV)
+        std::lock_guard<std::mutex> lock(m_TexturesMutex);
 
-        // 5. Transition the texture resource to a shader resource state
-        CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(texture->Resource.Get(),
-            D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-        commandList->ResourceBarrier(1, &barrier);
+        // For now, let's create a temporary unique name based on a counter
+        // Later, this would be based on the file path or a proper asset ID
+        String tempName = "TempTexture_" + std::to_string(m_LoadedTextures.size());
+        if (m_LoadedTextures.count(tempName))
+        {
+            AGK_WARN("Texture with temporary name '{}' already exists in cache. This indicates a potential issue with unique naming.", tempName);
+            // Return existing for now, but in a real system, you'd ensure uniqueness or better caching.
+            return m_LoadedTextures.at(tempName);
+        }
 
-        // 6. Create Shader Resource View (SRV)
         if (m_NextSrvDescriptorIndex >= m_SrvHeap->GetDesc().NumDescriptors)
         {
             AGK_ERROR("SRV descriptor heap is full! Cannot create more texture SRVs.");
@@ -671,17 +617,8 @@ namespace Angaraka::Graphics::DirectX12 {
 
         m_LoadedTextures[tempName] = texture; // Add to cache
 
-        ExecuteAndWaitForGPU();
-
-        AGK_INFO("GPU Texture created for '{}'.", tempName);
+        AGK_INFO("GPU Texture created for '{}', upload batch {}.", tempName, texture->UploadFenceValue);
         return texture;
     }
 
-
-    void TextureManager::ClearUploadHeaps()
-    {
-        // Calling clear() on a vector of ComPtrs will release all the underlying D3D12 resources
-        m_UploadHeapsToRelease.clear();
-        AGK_INFO("TextureManager: Cleared temporary upload heaps after GPU completion.");
-    }
 }
\ No newline at end of file
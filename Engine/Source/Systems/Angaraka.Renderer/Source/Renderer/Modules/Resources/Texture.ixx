@@ -2,10 +2,12 @@
 module;
 
 #include "Angaraka/GraphicsBase.hpp"
+#include <mutex>
 
 export module Angaraka.Graphics.DirectX12.Texture;
 
 import Angaraka.Core.Resources;
+import Angaraka.Graphics.DirectX12.UploadManager;
 
 namespace Angaraka::Graphics::DirectX12 {
 
@@ -20,6 +22,7 @@ namespace Angaraka::Graphics::DirectX12 {
         UINT                                         Height = 0;
         DXGI_FORMAT                                  Format = DXGI_FORMAT_UNKNOWN;
         size_t                                       MemorySizeBytes = 0; // Size in bytes for this texture
+        UINT64                                       UploadFenceValue = 0; // Upload batch that fills the texture
     };
 
     // TextureManager to handle creation and management of GPU textures
@@ -29,12 +32,12 @@ namespace Angaraka::Graphics::DirectX12 {
         TextureManager();
         ~TextureManager();
 
-        // Initialize with D3D12 device and command list for upload
-        bool Initialize(ID3D12Device* device, ID3D12CommandQueue* commandQueue);
+        // Initialize with D3D12 device and the uploader shared with the MeshManager
+        bool Initialize(ID3D12Device* device, UploadManager* uploadManager);
         void Shutdown();
 
-        // Creates a GPU texture from CPU ImageData
-        // This is a temporary setup, later we'll use an upload heap/queue
+        // Creates a GPU texture from CPU ImageData. Safe to call from several asset worker threads at once.
+        // Returns before the pixels have been copied, wait for Texture::UploadFenceValue before sampling on another queue.
         // For now, it will return a shared_ptr to allow multiple systems to refer to it.
         Reference<Texture> LoadTexture(const String& filePath);
         Reference<Texture> CreateTextureFromImageData(const Angaraka::Core::ImageData& imageData);
@@ -42,12 +45,7 @@ namespace Angaraka::Graphics::DirectX12 {
         // Placeholder for getting already loaded textures (caching)
         // Reference<Texture> GetTexture(const std::wstring& name);
 
-        // Call this after GPU has finished processing initialization commands
-        void ClearUploadHeaps();
-
-        // Add method to get fresh command list for loading
-        ID3D12GraphicsCommandList* GetOrCreateCommandList();
-        void ExecuteAndWaitForGPU();
+        inline UploadManager* GetUploadManager() const { return m_UploadManager; }
 
         // Get the SRV heap and descriptor size
         inline ID3D12DescriptorHeap* GetSrvHeap() const { return m_SrvHeap.Get(); }
@@ -55,13 +53,7 @@ namespace Angaraka::Graphics::DirectX12 {
 
     private:
         ID3D12Device* m_Device = nullptr;
-
-        // Add command allocator for texture loading
-        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> m_LoadingCommandAllocator;
-        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> m_LoadingCommandList;
-        Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_CommandQueue; // Store command queue reference
-
-        std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> m_UploadHeapsToRelease;
+        UploadManager* m_UploadManager = nullptr; // Owned by the graphics system
 
         // For now, a very simple descriptor heap for SRVs
         Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_SrvHeap;
@@ -70,6 +62,7 @@ namespace Angaraka::Graphics::DirectX12 {
 
         // A map to store loaded textures (simple cache for now)
         std::map<String, Reference<Texture>> m_LoadedTextures;
+        std::mutex m_TexturesMutex; // Guards m_LoadedTextures and m_NextSrvDescriptorIndex
 
         // Internal helper to create a descriptor heap
         bool CreateSrvDescriptorHeap(UINT numDescriptors);
@@ -99,6 +92,9 @@ namespace Angaraka::Graphics::DirectX12 {
             return m_textureData ? m_textureData->MemorySizeBytes : 0;
         }
 
+        // Deferred until the pixels have reached the GPU
+        void WhenReady(std::function<void()> callback) override;
+
         // Getters for the underlying D3D12 texture data (e.g., for binding)
         ID3D12Resource* GetD3D12Resource() const;
         CD3DX12_CPU_DESCRIPTOR_HANDLE GetSrvDescriptorHandle() const;
@@ -112,5 +108,6 @@ namespace Angaraka::Graphics::DirectX12 {
         Reference<Texture> m_textureData; // Assuming TextureManager::LoadTexture returns this
 
         CD3DX12_GPU_DESCRIPTOR_HANDLE m_srvGpuHandle; // GPU handle for the SRV
+        UploadManager* m_uploadManager = nullptr;     // Uploader the texture was created through
     };
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/StagingRing.cpp
+module;
+
+#include "Angaraka/Base.hpp"
+#include <algorithm>
+#include <iterator>
+
+module Angaraka.Graphics.StagingRing;
+
+namespace Angaraka::Graphics {
+
+    void StagingRing::Reset(U64 capacity, U64 firstFenceValue) {
+        m_ring.Reset(capacity);
+        m_open = {};
+        m_open.fenceValue = firstFenceValue;
+        m_submitted.clear();
+        m_late.clear();
+        m_completedFenceValue = firstFenceValue - 1;
+    }
+
+    U64 StagingRing::Allocate(U64 size, U64 alignment) {
+        const U64 offset = m_ring.Allocate(size, alignment);
+        if (offset != INVALID_OFFSET) {
+            ++m_open.uploads;
+        }
+        return offset;
+    }
+
+    void StagingRing::OnComplete(U64 fenceValue, Callback callback) {
+        if (IsComplete(fenceValue)) {
+            m_late.push_back(std::move(callback));
+            return;
+        }
+
+        // Fence values newer than any submitted batch can only belong to the open one
+        if (fenceValue >= m_open.fenceValue) {
+            m_open.callbacks.push_back(std::move(callback));
+            return;
+        }
+
+        auto it = std::lower_bound(m_submitted.begin(), m_submitted.end(), fenceValue,
+            [](const Batch& batch, U64 value) { return batch.fenceValue < value; });
+        if (it == m_submitted.end()) {
+            m_open.callbacks.push_back(std::move(callback));
+            return;
+        }
+        it->callbacks.push_back(std::move(callback));
+    }
+
+    U64 StagingRing::Submit() {
+        if (!HasOpenWork()) {
+            return 0;
+        }
+
+        const U64 fenceValue = m_open.fenceValue;
+        m_ring.FinishFrame(fenceValue);
+        m_submitted.push_back(std::move(m_open));
+
+        m_open = {};
+        m_open.fenceValue = fenceValue + 1;
+        return fenceValue;
+    }
+
+    void StagingRing::Retire(U64 completedFenceValue, std::vector<Callback>& completed) {
+        // Never past the open batch, its fence has not been signalled yet
+        completedFenceValue = std::min(completedFenceValue, m_open.fenceValue - 1);
+        if (completedFenceValue > m_completedFenceValue) {
+            m_completedFenceValue = completedFenceValue;
+        }
+
+        m_ring.Retire(m_completedFenceValue);
+        while (!m_submitted.empty() && m_submitted.front().fenceValue <= m_completedFenceValue) {
+            std::vector<Callback>& callbacks = m_submitted.front().callbacks;
+            std::move(callbacks.begin(), callbacks.end(), std::back_inserter(completed));
+            m_submitted.pop_front();
+        }
+
+        std::move(m_late.begin(), m_late.end(), std::back_inserter(completed));
+        m_late.clear();
+    }
+
+    U64 StagingRing::GetOldestFenceValue() const {
+        return m_submitted.empty() ? 0 : m_submitted.front().fenceValue;
+    }
+
+} // namespace Angaraka::Graphics
@@ -0,0 +1,78 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/StagingRing.ixx
+module;
+
+#include "Angaraka/Base.hpp"
+#include <deque>
+
+export module Angaraka.Graphics.StagingRing;
+
+import Angaraka.Graphics.UploadRing;
+
+namespace Angaraka::Graphics {
+
+    /**
+     * @brief Batch and fence bookkeeping for asynchronous uploads through a staging ring
+     *
+     * Uploads are recorded into an open batch whose fence value is known up front, so a
+     * caller can hand out completion handles before anything is submitted. Submit closes
+     * the batch and ties its staging space to that fence value; Retire gives the space back
+     * and hands out the batch's callbacks once the copy queue has passed it. Batches retire
+     * in submission order.
+     *
+     * Only offsets and fence values are managed here; the caller owns the memory, the queue
+     * and the fence, and runs the returned callbacks. Not thread-safe.
+     */
+    export class StagingRing {
+    public:
+        using Callback = std::function<void()>;
+
+        static constexpr U64 INVALID_OFFSET = UploadRingAllocator::INVALID_OFFSET;
+
+        explicit StagingRing(U64 capacity = 0, U64 firstFenceValue = 1) { Reset(capacity, firstFenceValue); }
+
+        // Forgets all batches, dropping their callbacks. Fence values start over at firstFenceValue.
+        void Reset(U64 capacity, U64 firstFenceValue = 1);
+
+        // Staging space for one upload in the open batch. Returns INVALID_OFFSET when the ring
+        // has no room until older batches retire.
+        U64 Allocate(U64 size, U64 alignment);
+
+        // Runs callback once the batch with the given fence value has retired. Fence values
+        // that have already retired are handed out by the next Retire.
+        void OnComplete(U64 fenceValue, Callback callback);
+
+        // Closes the open batch and returns the fence value the caller must signal after it,
+        // or 0 when nothing was recorded
+        U64 Submit();
+
+        // Retires every submitted batch up to completedFenceValue and appends their callbacks
+        void Retire(U64 completedFenceValue, std::vector<Callback>& completed);
+
+        bool IsComplete(U64 fenceValue) const { return fenceValue <= m_completedFenceValue; }
+        bool HasOpenWork() const { return m_open.uploads > 0 || !m_open.callbacks.empty(); }
+
+        U64 GetOpenFenceValue() const { return m_open.fenceValue; }
+        U64 GetOldestFenceValue() const;                                // Oldest submitted batch, 0 if none
+        U64 GetCompletedFenceValue() const { return m_completedFenceValue; }
+
+        U64 GetCapacity() const { return m_ring.GetCapacity(); }
+        U64 GetUsedBytes() const { return m_ring.GetUsedBytes(); }
+        U64 GetOpenBytes() const { return m_ring.GetFrameBytes(); }
+        U32 GetOpenUploads() const { return m_open.uploads; }
+        size_t GetBatchesInFlight() const { return m_submitted.size(); }
+
+    private:
+        struct Batch {
+            U64 fenceValue{ 0 };
+            U32 uploads{ 0 };
+            std::vector<Callback> callbacks;
+        };
+
+        UploadRingAllocator m_ring;
+        Batch m_open;
+        std::deque<Batch> m_submitted;          // Oldest first, fence values increasing
+        std::vector<Callback> m_late;           // Registered after their batch retired
+        U64 m_completedFenceValue{ 0 };
+    };
+
+} // namespace Angaraka::Graphics
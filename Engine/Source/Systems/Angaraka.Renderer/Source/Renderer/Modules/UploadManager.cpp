@@ -0,0 +1,394 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/UploadManager.cpp
+// Implementation of Angaraka.Graphics.DirectX12.UploadManager module.
+module;
+
+#include "Angaraka/GraphicsBase.hpp"
+#include <algorithm>
+#include <mutex>
+
+module Angaraka.Graphics.DirectX12.UploadManager;
+
+import Angaraka.Graphics.StagingRing;
+
+namespace {
+    const UINT64 bufferDataAlignment = 16;
+} // anonymous namespace
+
+namespace Angaraka::Graphics::DirectX12 {
+
+    UploadManager::UploadManager() {
+        AGK_INFO("UploadManager: Constructor called.");
+    }
+
+    UploadManager::~UploadManager() {
+        AGK_INFO("UploadManager: Destructor called.");
+        Shutdown();
+    }
+
+    bool UploadManager::Initialize(ID3D12Device* device, ID3D12CommandQueue* graphicsQueue, UINT64 stagingSize) {
+        if (!device || !graphicsQueue) {
+            AGK_ERROR("UploadManager::Initialize: Invalid D3D12 device or command queue.");
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_device = device;
+        m_graphicsQueue = graphicsQueue;
+
+        // --- Copy queue, its command list and fence ---
+        D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+        queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+        queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        DXCall(m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_copyQueue)));
+        NAME_D3D12_OBJECT(m_copyQueue, "Upload Copy Queue");
+
+        DXCall(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&m_commandAllocator)));
+        DXCall(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY,
+            m_commandAllocator.Get(), nullptr, IID_PPV_ARGS(&m_commandList)));
+        DXCall(m_commandList->Close());
+        NAME_D3D12_OBJECT(m_commandList, "Upload Command List");
+
+        DXCall(m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)));
+        m_fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        if (m_fenceEvent == nullptr) {
+            AGK_ERROR("UploadManager: Failed to create fence event handle (HRESULT: {0:x}).", (int)HRESULT_FROM_WIN32(GetLastError()));
+            return false;
+        }
+
+        // --- Persistent staging buffer ---
+        CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+        CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(stagingSize);
+        HRESULT hr = m_device->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(&m_stagingBuffer));
+        if (FAILED(hr)) {
+            AGK_ERROR("UploadManager: Failed to create a {0} byte staging buffer (HRESULT {1:#x}).",
+                stagingSize, static_cast<U32>(hr));
+            return false;
+        }
+
+        CD3DX12_RANGE readRange(0, 0); // We do not intend to read from this resource on the CPU.
+        DXCall(m_stagingBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_pStagingDataBegin)));
+        NAME_D3D12_OBJECT(m_stagingBuffer, "Upload Staging Ring");
+
+        // Fence value 0 is the initial value and stands for "nothing to wait for"
+        m_staging.Reset(stagingSize, 1);
+        m_flushThreshold = stagingSize / 4;
+        m_stats = {};
+        m_initialized = true;
+
+        AGK_INFO("UploadManager: Initialized with a {0} byte staging ring.", stagingSize);
+        return true;
+    }
+
+    void UploadManager::Shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized) {
+                return;
+            }
+        }
+
+        WaitForIdle();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_staging.Reset(0);
+        m_completed.clear();
+        m_inFlightAllocators.clear();
+
+        if (m_stagingBuffer && m_pStagingDataBegin) {
+            m_stagingBuffer->Unmap(0, nullptr);
+        }
+        m_pStagingDataBegin = nullptr;
+        m_stagingBuffer.Reset();
+
+        if (m_fenceEvent != nullptr) {
+            CloseHandle(m_fenceEvent);
+            m_fenceEvent = nullptr;
+        }
+        m_fence.Reset();
+        m_commandList.Reset();
+        m_commandAllocator.Reset();
+        m_copyQueue.Reset();
+        m_graphicsQueue.Reset();
+        m_device = nullptr;
+
+        m_initialized = false;
+        AGK_INFO("UploadManager: Shutdown complete. {0} batches, {1} uploads, {2} bytes, {3} staging stalls.",
+            m_stats.batchesSubmitted, m_stats.uploads, m_stats.bytesUploaded, m_stats.stagingStalls);
+    }
+
+    UINT64 UploadManager::UploadBuffer(ID3D12Resource* destination, const void* data, UINT64 size) {
+        if (!destination || !data || size == 0) {
+            AGK_ERROR("UploadManager::UploadBuffer: Invalid destination or data.");
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_initialized) {
+            AGK_ERROR("UploadManager: Not initialized when attempting to upload a buffer.");
+            return 0;
+        }
+
+        StagingAllocation staging;
+        if (!AllocateStagingLocked(size, bufferDataAlignment, staging) || !BeginRecordingLocked()) {
+            return 0;
+        }
+
+        memcpy(staging.cpuAddress, data, size);
+        m_commandList->CopyBufferRegion(destination, 0, staging.resource, staging.offset, size);
+        TrackDestinationLocked(destination);
+
+        const UINT64 fenceValue = m_staging.GetOpenFenceValue();
+        ++m_stats.uploads;
+        m_stats.bytesUploaded += size;
+
+        // Large bundles keep the copy queue busy instead of waiting for the end of the frame
+        if (m_staging.GetOpenBytes() >= m_flushThreshold) {
+            FlushLocked();
+        }
+        return fenceValue;
+    }
+
+    UINT64 UploadManager::UploadTexture(ID3D12Resource* destination, const D3D12_SUBRESOURCE_DATA& data, UINT subresource) {
+        if (!destination || !data.pData) {
+            AGK_ERROR("UploadManager::UploadTexture: Invalid destination or data.");
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_initialized) {
+            AGK_ERROR("UploadManager: Not initialized when attempting to upload a texture.");
+            return 0;
+        }
+
+        // Row pitch in the staging buffer is padded to the copy alignment, so rows are copied one by one
+        const D3D12_RESOURCE_DESC desc = destination->GetDesc();
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+        UINT numRows = 0;
+        UINT64 rowSizeInBytes = 0;
+        UINT64 totalBytes = 0;
+        m_device->GetCopyableFootprints(&desc, subresource, 1, 0, &footprint, &numRows, &rowSizeInBytes, &totalBytes);
+
+        StagingAllocation staging;
+        if (!AllocateStagingLocked(totalBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, staging) || !BeginRecordingLocked()) {
+            return 0;
+        }
+
+        D3D12_MEMCPY_DEST destData = {
+            staging.cpuAddress,
+            footprint.Footprint.RowPitch,
+            static_cast<SIZE_T>(footprint.Footprint.RowPitch) * numRows
+        };
+        MemcpySubresource(&destData, &data, static_cast<SIZE_T>(rowSizeInBytes), numRows, footprint.Footprint.Depth);
+
+        footprint.Offset = staging.offset;
+        CD3DX12_TEXTURE_COPY_LOCATION dst(destination, subresource);
+        CD3DX12_TEXTURE_COPY_LOCATION src(staging.resource, footprint);
+        m_commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+        TrackDestinationLocked(destination);
+
+        const UINT64 fenceValue = m_staging.GetOpenFenceValue();
+        ++m_stats.uploads;
+        m_stats.bytesUploaded += totalBytes;
+
+        if (m_staging.GetOpenBytes() >= m_flushThreshold) {
+            FlushLocked();
+        }
+        return fenceValue;
+    }
+
+    void UploadManager::WhenComplete(UINT64 fenceValue, CompletionCallback callback) {
+        if (!callback) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_initialized) {
+                RetireLocked();
+                if (!m_staging.IsComplete(fenceValue)) {
+                    m_staging.OnComplete(fenceValue, std::move(callback));
+                    return;
+                }
+            }
+        }
+
+        callback();
+    }
+
+    bool UploadManager::IsComplete(UINT64 fenceValue) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_initialized || m_staging.IsComplete(fenceValue)) {
+            return true;
+        }
+        return fenceValue < m_staging.GetOpenFenceValue() && m_fence->GetCompletedValue() >= fenceValue;
+    }
+
+    void UploadManager::Flush() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_initialized) {
+            FlushLocked();
+        }
+    }
+
+    void UploadManager::RetireCompleted() {
+        std::vector<CompletionCallback> completed;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_initialized) {
+                RetireLocked();
+            }
+            completed.swap(m_completed);
+        }
+
+        // Outside the lock, callbacks may start new uploads
+        for (CompletionCallback& callback : completed) {
+            callback();
+        }
+    }
+
+    void UploadManager::WaitForIdle() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_initialized) {
+                return;
+            }
+            FlushLocked();
+            WaitForFenceLocked(m_staging.GetOpenFenceValue() - 1);
+        }
+        RetireCompleted();
+    }
+
+    UploadManager::Statistics UploadManager::GetStatistics() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    UINT64 UploadManager::GetStagingBytesInUse() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_staging.GetUsedBytes();
+    }
+
+    bool UploadManager::BeginRecordingLocked() {
+        if (m_recording) {
+            return true;
+        }
+
+        // Reuse an allocator whose batch has finished, a new one only while all are in flight
+        if (!m_commandAllocator) {
+            const UINT64 completedFenceValue = m_fence->GetCompletedValue();
+            auto it = std::find_if(m_inFlightAllocators.begin(), m_inFlightAllocators.end(),
+                [completedFenceValue](const InFlightAllocator& entry) { return entry.fenceValue <= completedFenceValue; });
+            if (it != m_inFlightAllocators.end()) {
+                m_commandAllocator = std::move(it->allocator);
+                m_inFlightAllocators.erase(it);
+            }
+            else {
+                HRESULT hr = m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&m_commandAllocator));
+                if (FAILED(hr)) {
+                    AGK_ERROR("UploadManager: Failed to create a copy command allocator (HRESULT {0:#x}).", static_cast<U32>(hr));
+                    return false;
+                }
+            }
+        }
+
+        DXCall(m_commandAllocator->Reset());
+        DXCall(m_commandList->Reset(m_commandAllocator.Get(), nullptr));
+        m_recording = true;
+        return true;
+    }
+
+    bool UploadManager::AllocateStagingLocked(UINT64 size, UINT64 alignment, StagingAllocation& allocation) {
+        UINT64 offset = m_staging.Allocate(size, alignment);
+        if (offset == StagingRing::INVALID_OFFSET && size <= m_staging.GetCapacity()) {
+            // The ring is full: submit what has been recorded and wait for batches to drain until it fits
+            ++m_stats.stagingStalls;
+            FlushLocked();
+            while (offset == StagingRing::INVALID_OFFSET && m_staging.GetBatchesInFlight() > 0) {
+                WaitForFenceLocked(m_staging.GetOldestFenceValue());
+                RetireLocked();
+                offset = m_staging.Allocate(size, alignment);
+            }
+        }
+
+        if (offset != StagingRing::INVALID_OFFSET) {
+            allocation.resource = m_stagingBuffer.Get();
+            allocation.offset = offset;
+            allocation.cpuAddress = m_pStagingDataBegin + offset;
+            return true;
+        }
+
+        // Larger than the whole ring, it gets an upload buffer of its own that lives as long as its batch
+        Microsoft::WRL::ComPtr<ID3D12Resource> dedicated;
+        CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+        CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+        HRESULT hr = m_device->CreateCommittedResource(
+            &heapProps,
+            D3D12_HEAP_FLAG_NONE,
+            &bufferDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ,
+            nullptr,
+            IID_PPV_ARGS(&dedicated));
+        if (FAILED(hr)) {
+            AGK_ERROR("UploadManager: Failed to create a {0} byte upload buffer (HRESULT {1:#x}).", size, static_cast<U32>(hr));
+            return false;
+        }
+
+        // Upload heap memory stays valid while the resource is alive, unmapping is not required
+        CD3DX12_RANGE readRange(0, 0);
+        DXCall(dedicated->Map(0, &readRange, reinterpret_cast<void**>(&allocation.cpuAddress)));
+        NAME_D3D12_OBJECT(dedicated, "Upload Dedicated Buffer");
+
+        allocation.resource = dedicated.Get();
+        allocation.offset = 0;
+        m_staging.OnComplete(m_staging.GetOpenFenceValue(), [dedicated] {});
+        ++m_stats.dedicatedBuffers;
+        return true;
+    }
+
+    void UploadManager::TrackDestinationLocked(ID3D12Resource* destination) {
+        // Holds a reference until the copy has run, in case the owner releases it first
+        m_staging.OnComplete(m_staging.GetOpenFenceValue(), [resource = Microsoft::WRL::ComPtr<ID3D12Resource>(destination)] {});
+    }
+
+    void UploadManager::FlushLocked() {
+        if (!m_staging.HasOpenWork()) {
+            return;
+        }
+
+        if (m_recording) {
+            DXCall(m_commandList->Close());
+            ID3D12CommandList* commandLists[] = { m_commandList.Get() };
+            m_copyQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
+            m_recording = false;
+        }
+
+        const UINT64 fenceValue = m_staging.Submit();
+        DXCall(m_copyQueue->Signal(m_fence.Get(), fenceValue));
+
+        // Graphics work submitted from now on runs after the copies, without the CPU waiting
+        DXCall(m_graphicsQueue->Wait(m_fence.Get(), fenceValue));
+
+        if (m_commandAllocator) {
+            m_inFlightAllocators.push_back({ std::move(m_commandAllocator), fenceValue });
+        }
+        ++m_stats.batchesSubmitted;
+    }
+
+    void UploadManager::RetireLocked() {
+        m_staging.Retire(m_fence->GetCompletedValue(), m_completed);
+    }
+
+    void UploadManager::WaitForFenceLocked(UINT64 fenceValue) {
+        if (m_fence->GetCompletedValue() < fenceValue) {
+            DXCall(m_fence->SetEventOnCompletion(fenceValue, m_fenceEvent));
+            WaitForSingleObject(m_fenceEvent, INFINITE);
+        }
+    }
+
+} // namespace Angaraka::Graphics::DirectX12
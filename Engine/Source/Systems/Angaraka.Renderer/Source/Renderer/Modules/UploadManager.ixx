@@ -0,0 +1,114 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/UploadManager.ixx
+// Module for asynchronous resource uploads on a dedicated copy queue.
+module;
+
+#include "Angaraka/GraphicsBase.hpp"
+#include <mutex>
+#include <vector>
+
+export module Angaraka.Graphics.DirectX12.UploadManager;
+
+import Angaraka.Graphics.StagingRing;
+
+namespace Angaraka::Graphics::DirectX12 {
+
+    /**
+     * @brief Streams buffer and texture data to default heap resources without blocking
+     *
+     * Source data is copied into one persistently mapped staging buffer and the copies are
+     * recorded into a shared command list for the copy queue. Flush submits everything
+     * recorded since the previous call as one batch, signals the batch's fence value and
+     * makes the graphics queue wait for it on the GPU, so draws submitted afterwards see the
+     * data. RetireCompleted recycles staging space of finished batches and runs their
+     * completion callbacks. The CPU only waits when the staging ring is full.
+     *
+     * Destinations must be created in D3D12_RESOURCE_STATE_COMMON. The copy queue promotes
+     * them to COPY_DEST and they decay back to COMMON after the batch, from where the graphics
+     * queue promotes them to the read state it needs.
+     *
+     * Uploads may be recorded from any thread; Flush and RetireCompleted are called once per
+     * frame by the renderer.
+     */
+    export class UploadManager {
+    public:
+        using CompletionCallback = std::function<void()>;
+
+        UploadManager();
+        ~UploadManager();
+        DISABLE_COPY_AND_MOVE(UploadManager);
+
+        bool Initialize(ID3D12Device* device, ID3D12CommandQueue* graphicsQueue, UINT64 stagingSize = 32 * 1024 * 1024);
+        void Shutdown();
+
+        // Record a copy of the data into the destination and return the fence value of the
+        // batch it belongs to, or 0 on failure. The data may be released on return.
+        UINT64 UploadBuffer(ID3D12Resource* destination, const void* data, UINT64 size);
+        UINT64 UploadTexture(ID3D12Resource* destination, const D3D12_SUBRESOURCE_DATA& data, UINT subresource = 0);
+
+        // Runs the callback once the batch with the given fence value has finished, immediately
+        // if it already has. Deferred callbacks run on the thread calling RetireCompleted.
+        void WhenComplete(UINT64 fenceValue, CompletionCallback callback);
+        bool IsComplete(UINT64 fenceValue) const;
+
+        // Submits the recorded copies as one batch
+        void Flush();
+
+        // Recycles staging space of finished batches and runs their callbacks
+        void RetireCompleted();
+
+        // Submits pending copies and waits until the copy queue is idle
+        void WaitForIdle();
+
+        struct Statistics {
+            U64 batchesSubmitted{ 0 };
+            U64 uploads{ 0 };
+            U64 bytesUploaded{ 0 };
+            U64 stagingStalls{ 0 };         // Times an upload waited for the ring to drain
+            U64 dedicatedBuffers{ 0 };      // Uploads larger than the whole ring
+        };
+        Statistics GetStatistics() const;
+        UINT64 GetStagingBytesInUse() const;
+
+    private:
+        struct StagingAllocation {
+            ID3D12Resource* resource{ nullptr };
+            UINT64 offset{ 0 };
+            UINT8* cpuAddress{ nullptr };
+        };
+
+        struct InFlightAllocator {
+            Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator;
+            UINT64 fenceValue{ 0 };
+        };
+
+        ID3D12Device* m_device{ nullptr };
+        Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_graphicsQueue;
+        Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_copyQueue;
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> m_commandList;
+        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> m_commandAllocator;    // Recording the open batch
+        std::vector<InFlightAllocator> m_inFlightAllocators;
+        Microsoft::WRL::ComPtr<ID3D12Fence> m_fence;
+        HANDLE m_fenceEvent{ nullptr };
+
+        Microsoft::WRL::ComPtr<ID3D12Resource> m_stagingBuffer;
+        UINT8* m_pStagingDataBegin{ nullptr };
+        StagingRing m_staging;
+        UINT64 m_flushThreshold{ 0 };       // Open batch size that triggers an early submit
+
+        bool m_recording{ false };
+        std::vector<CompletionCallback> m_completed;    // Retired, waiting for RetireCompleted
+        Statistics m_stats;
+        mutable std::mutex m_mutex;
+
+        bool m_initialized{ false };
+
+        // m_mutex must be held
+        bool BeginRecordingLocked();
+        bool AllocateStagingLocked(UINT64 size, UINT64 alignment, StagingAllocation& allocation);
+        void TrackDestinationLocked(ID3D12Resource* destination);
+        void FlushLocked();
+        void RetireLocked();
+        void WaitForFenceLocked(UINT64 fenceValue);
+    };
+
+} // namespace Angaraka::Graphics::DirectX12
@@ -0,0 +1,61 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/UploadRing.cpp
+module;
+
+#include "Angaraka/Base.hpp"
+
+module Angaraka.Graphics.UploadRing;
+
+namespace Angaraka::Graphics {
+
+    void UploadRingAllocator::Reset(U64 capacity) {
+        m_capacity = capacity;
+        m_head = 0;
+        m_usedBytes = 0;
+        m_frameBytes = 0;
+        m_frames.clear();
+    }
+
+    U64 UploadRingAllocator::Allocate(U64 size, U64 alignment) {
+        if (size == 0 || size > m_capacity) {
+            return INVALID_OFFSET;
+        }
+
+        // Nothing live, start over so the whole capacity is one contiguous run again
+        if (m_usedBytes == 0) {
+            m_head = 0;
+        }
+
+        // The free space is the arc from the head to the oldest live byte, so an allocation
+        // fits exactly when the bytes it consumes from the head on (padding or the skipped
+        // tail included) fit in what is not used
+        U64 offset = (m_head + alignment - 1) & ~(alignment - 1);
+        if (offset + size > m_capacity) {
+            offset = 0;
+        }
+        const U64 consumed = (offset >= m_head ? offset - m_head : m_capacity - m_head) + size;
+        if (m_usedBytes + consumed > m_capacity) {
+            return INVALID_OFFSET;
+        }
+
+        m_head = offset + size == m_capacity ? 0 : offset + size;
+        m_usedBytes += consumed;
+        m_frameBytes += consumed;
+        return offset;
+    }
+
+    void UploadRingAllocator::FinishFrame(U64 fenceValue) {
+        if (m_frameBytes == 0) {
+            return;
+        }
+        m_frames.push_back({ fenceValue, m_frameBytes });
+        m_frameBytes = 0;
+    }
+
+    void UploadRingAllocator::Retire(U64 completedFenceValue) {
+        while (!m_frames.empty() && m_frames.front().fenceValue <= completedFenceValue) {
+            m_usedBytes -= m_frames.front().bytes;
+            m_frames.pop_front();
+        }
+    }
+
+} // namespace Angaraka::Graphics
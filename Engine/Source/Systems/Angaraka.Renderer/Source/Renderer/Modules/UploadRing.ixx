@@ -0,0 +1,56 @@
+// Engine/Source/Systems/Angaraka.Renderer/Source/Renderer/Modules/UploadRing.ixx
+module;
+
+#include "Angaraka/Base.hpp"
+#include <deque>
+
+export module Angaraka.Graphics.UploadRing;
+
+namespace Angaraka::Graphics {
+
+    /**
+     * @brief Offset bookkeeping for a ring of per-frame GPU upload memory
+     *
+     * Hands out aligned, linearly increasing offsets into a buffer of fixed capacity. When an
+     * allocation does not fit before the end, the tail is skipped and it wraps to offset 0.
+     * FinishFrame ties everything allocated since the previous call to a fence value, and
+     * Retire gives a frame's bytes back once the GPU has passed its fence. Frames retire in
+     * the order they were finished, so the live region is always one contiguous arc.
+     *
+     * Only offsets are managed here; the caller owns the memory. Not thread-safe.
+     */
+    export class UploadRingAllocator {
+    public:
+        static constexpr U64 INVALID_OFFSET = U64(-1);
+
+        explicit UploadRingAllocator(U64 capacity = 0) { Reset(capacity); }
+
+        // Forgets all allocations, including those of frames still in flight
+        void Reset(U64 capacity);
+
+        // Alignment must be a power of two that divides the capacity. Returns INVALID_OFFSET
+        // when the ring has no room until older frames retire.
+        U64 Allocate(U64 size, U64 alignment);
+
+        void FinishFrame(U64 fenceValue);
+        void Retire(U64 completedFenceValue);
+
+        U64 GetCapacity() const { return m_capacity; }
+        U64 GetUsedBytes() const { return m_usedBytes; }          // Including skipped tails and padding
+        U64 GetFrameBytes() const { return m_frameBytes; }        // Allocated since the last FinishFrame
+        size_t GetFramesInFlight() const { return m_frames.size(); }
+
+    private:
+        struct FrameMark {
+            U64 fenceValue;
+            U64 bytes;
+        };
+
+        U64 m_capacity{ 0 };
+        U64 m_head{ 0 };                // Next free offset
+        U64 m_usedBytes{ 0 };
+        U64 m_frameBytes{ 0 };
+        std::deque<FrameMark> m_frames; // Finished but not yet retired, oldest first
+    };
+
+} // namespace Angaraka::Graphics
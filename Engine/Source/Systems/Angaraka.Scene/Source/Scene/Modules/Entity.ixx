@@ -159,6 +159,9 @@ namespace Angaraka::SceneSystem {
                 componentPtr->InternalStart();
             }
 
+            // Components such as MeshRenderer change the entity's bounds
+            NotifySpatialChanged();
+
             return componentPtr;
         }
 
@@ -222,6 +225,8 @@ namespace Angaraka::SceneSystem {
                 // Destroy component
                 component->InternalDestroy();
                 m_components.erase(it);
+
+                NotifySpatialChanged();
             }
         }
 
@@ -354,8 +359,12 @@ namespace Angaraka::SceneSystem {
         EntityTag m_tag = 0;
         U32 m_layer = 0;
 
+        // Set by the owning scene to keep its spatial index up to date
+        std::function<void(Entity*)> m_onSpatialChanged;
+
         // Helper methods
         void NotifyTransformChanged();
+        void NotifySpatialChanged();
 
         template<typename T>
         T* GetComponentInChildrenRecursive(Entity* entity, bool includeInactive);
@@ -0,0 +1,101 @@
+module;
+
+#include "Angaraka/Base.hpp"
+#include <vector>
+#include <unordered_map>
+
+export module Angaraka.Scene.LinearBVH;
+
+import Angaraka.Scene.Entity;
+
+import Angaraka.Math.Vector3;
+import Angaraka.Math.BoundingBox;
+import Angaraka.Math.Frustum;
+import Angaraka.Math.Ray;
+
+namespace Angaraka::SceneSystem {
+
+    /**
+     * @brief Pointerless 4-wide bounding volume hierarchy
+     *
+     * Entities are sorted along a Morton curve and the hierarchy is built by splitting
+     * that order, so every subtree covers one contiguous range of items. Nodes live in a
+     * flat array (parents before children) and store the bounds of their four children as
+     * SoA, which lets a single SSE pass test all four against a frustum plane.
+     *
+     * Children that are fully inside the frustum emit their whole item range without
+     * further tests. Moving entities only needs a refit; adding or removing entities
+     * needs a rebuild.
+     */
+    export class LinearBVH {
+    public:
+        static constexpr U32 MAX_LEAF_SIZE = 8;
+
+        LinearBVH() = default;
+        ~LinearBVH() = default;
+
+        // Building
+        void Build(const std::vector<Entity*>& entities);
+        void Clear();
+
+        // Re-reads the entity's bounds; call Refit once all moved entities are updated
+        bool UpdateBounds(Entity* entity);
+        void Refit();
+
+        // Spatial queries (same semantics as the Octree)
+        void Query(const Math::Frustum& frustum, std::vector<Entity*>& results) const;
+        void Query(const Math::BoundingBox& bounds, std::vector<Entity*>& results) const;
+        void Query(const Math::Vector3& center, F32 radius, std::vector<Entity*>& results) const;
+        void QueryRay(const Math::Ray& ray, F32 maxDistance, std::vector<Entity*>& results) const;
+
+        // Properties
+        bool Contains(Entity* entity) const { return m_entityToItem.contains(entity); }
+        U32 GetEntityCount() const { return static_cast<U32>(m_entities.size()); }
+        U32 GetNodeCount() const { return static_cast<U32>(m_nodes.size()); }
+        bool IsEmpty() const { return m_entities.empty(); }
+
+    private:
+        static constexpr U32 LEAF = U32(-1);
+
+        /**
+         * @brief Four children with SoA bounds
+         *
+         * child[i] is the node index of an internal child or LEAF. first/count give the
+         * item range covered by the child's subtree; count == 0 marks an unused slot.
+         */
+        struct alignas(16) Node {
+            F32 minX[4], minY[4], minZ[4];
+            F32 maxX[4], maxY[4], maxZ[4];
+            U32 child[4];
+            U32 first[4];
+            U32 count[4];
+        };
+
+        struct Range {
+            U32 first;
+            U32 count;
+        };
+
+        // Items in Morton order; bounds are SoA and padded so 4-wide loads never run past the end
+        std::vector<Entity*> m_entities;
+        std::vector<F32> m_minX, m_minY, m_minZ;
+        std::vector<F32> m_maxX, m_maxY, m_maxZ;
+        std::unordered_map<Entity*, U32> m_entityToItem;
+
+        std::vector<Node> m_nodes;
+
+        // Build helpers
+        U32 BuildNode(const std::vector<U32>& codes, U32 first, U32 count);
+        U32 FindSplit(const std::vector<U32>& codes, U32 first, U32 count) const;
+        void SetItemBounds(U32 item, const Math::BoundingBox& bounds);
+        Math::BoundingBox GetItemBounds(U32 item) const;
+        Math::BoundingBox ComputeRangeBounds(U32 first, U32 count) const;
+        Math::BoundingBox ComputeNodeBounds(const Node& node) const;
+        static void SetSlotBounds(Node& node, U32 slot, const Math::BoundingBox& bounds);
+        static U32 ValidSlotMask(const Node& node);
+
+        // Query helpers
+        void EmitRange(U32 first, U32 count, bool renderableOnly, std::vector<Entity*>& results) const;
+    };
+
+} // namespace Angaraka::SceneSystem
@@ -4,6 +4,7 @@ module;
 #include <vector>
 #include <array>
 #include <functional>
+#include <unordered_map>
 #include <unordered_set>
 
 export module Angaraka.Scene.Octree;
@@ -18,14 +19,25 @@ import Angaraka.Math.Ray;
 
 namespace Angaraka::SceneSystem {
 
+    /**
+     * @brief World-space bounds used to place an entity in the octree
+     *
+     * MeshRenderer bounds when the entity has one, otherwise a unit box around its position.
+     */
+    export Math::BoundingBox ComputeEntityBounds(const Entity* entity);
+
     /**
      * @brief Octree node for spatial partitioning
      *
      * Each node can have up to 8 children, dividing space into octants.
-     * Entities are stored in leaf nodes up to a maximum count, then subdivided.
+     * An entity is stored once, in the deepest node that fully contains its bounds,
+     * together with a cached copy of those bounds so queries never touch components.
      */
     export class OctreeNode {
     public:
+        // Node each entity currently lives in, kept up to date as entities move between nodes
+        using EntityNodeMap = std::unordered_map<Entity*, OctreeNode*>;
+
         /**
          * @brief Octant indices
          *
@@ -43,21 +55,26 @@ namespace Angaraka::SceneSystem {
             PosXPosYPosZ = 7   // 111
         };
 
-        OctreeNode(const Math::BoundingBox& bounds, U32 depth = 0);
+        OctreeNode(const Math::BoundingBox& bounds, U32 depth = 0, OctreeNode* parent = nullptr);
         ~OctreeNode() = default;
 
         // Node properties
         const Math::BoundingBox& GetBounds() const { return m_bounds; }
         U32 GetDepth() const { return m_depth; }
+        OctreeNode* GetParent() const { return m_parent; }
         bool IsLeaf() const { return m_children[0] == nullptr; }
         size_t GetEntityCount() const { return m_entities.size(); }
+        U32 GetSubtreeEntityCount() const { return m_subtreeCount; }
 
         // Entity management
-        void InsertEntity(Entity* entity);
-        void RemoveEntity(Entity* entity);
-        void UpdateEntity(Entity* entity);
+        void InsertEntity(Entity* entity, const Math::BoundingBox& bounds, EntityNodeMap& entityToNode);
+        bool RemoveEntity(Entity* entity);
         bool ContainsEntity(Entity* entity) const;
 
+        // Refreshes the cached bounds in place. Returns false when the entity no longer
+        // belongs in this node and has to be re-inserted.
+        bool TryUpdateEntityBounds(Entity* entity, const Math::BoundingBox& bounds);
+
         // Spatial queries
         void GetEntitiesInFrustum(const Math::Frustum& frustum,
             std::vector<Entity*>& results) const;
@@ -73,8 +90,8 @@ namespace Angaraka::SceneSystem {
         const OctreeNode* GetChild(Octant octant) const { return m_children[octant].get(); }
 
         // Subdivision
-        void Subdivide();
-        void Collapse();
+        void Subdivide(EntityNodeMap& entityToNode);
+        void Collapse(EntityNodeMap& entityToNode);
         bool ShouldSubdivide() const;
         bool ShouldCollapse() const;
 
@@ -94,23 +111,30 @@ namespace Angaraka::SceneSystem {
         U32 m_depth;
         Math::Vector3 m_center;
         Math::Vector3 m_halfSize;
+        OctreeNode* m_parent;
 
         // Children (only allocated when subdivided)
         std::array<Scope<OctreeNode>, 8> m_children;
 
-        // Entities in this node (only in leaf nodes)
+        // Entities stored in this node and their cached world bounds (parallel arrays)
         std::vector<Entity*> m_entities;
+        std::vector<Math::BoundingBox> m_entityBounds;
+
+        // Entities in this node and all of its descendants
+        U32 m_subtreeCount = 0;
 
         // Configuration (could be static or passed in)
         static constexpr U32 MAX_ENTITIES_PER_NODE = 16;
         static constexpr U32 MIN_ENTITIES_TO_COLLAPSE = 4;
+        static constexpr U32 MAX_DEPTH = 8;
         static constexpr F32 MIN_NODE_SIZE = 1.0f;
 
         // Helper methods
-        void InsertIntoChildren(Entity* entity);
-        void CollectFromChildren();
-        bool FitsInOctant(Entity* entity, Octant octant) const;
-        Math::BoundingBox GetEntityBounds(Entity* entity) const;
+        OctreeNode* FindContainingChild(const Math::BoundingBox& bounds) const;
+        void StoreEntity(Entity* entity, const Math::BoundingBox& bounds, EntityNodeMap& entityToNode);
+        void AdjustSubtreeCount(I32 delta);
+        void CollectActiveEntities(std::vector<Entity*>& results, bool renderableOnly) const;
+        void CollectFromChildren(EntityNodeMap& entityToNode);
     };
 
     /**
@@ -119,6 +143,9 @@ namespace Angaraka::SceneSystem {
      * Manages a dynamic octree that automatically subdivides and collapses
      * based on entity distribution. Optimized for frustum culling and
      * spatial queries.
+     *
+     * Update() is cheap when an entity stays inside its node: only the cached
+     * bounds are refreshed. It is only re-inserted once it crosses a node boundary.
      */
     export class Octree {
     public:
@@ -197,17 +224,17 @@ namespace Angaraka::SceneSystem {
         Scope<OctreeNode> m_root;
 
         // Track which node each entity is in for fast updates
-        std::unordered_map<Entity*, OctreeNode*> m_entityToNode;
+        OctreeNode::EntityNodeMap m_entityToNode;
 
-        // Pending updates (batched for efficiency)
+        // Pending updates (batched for efficiency). Batches nest; only the outermost
+        // EndBatchUpdate applies them.
         std::unordered_set<Entity*> m_pendingUpdates;
-        bool m_batchMode = false;
+        U32 m_batchDepth = 0;
 
         // Helper methods
         void RemoveFromNode(Entity* entity, OctreeNode* node);
-        void InsertIntoNode(Entity* entity, OctreeNode* node);
-        OctreeNode* FindBestNode(Entity* entity, OctreeNode* start) const;
-        void CollapseEmptyNodes(OctreeNode* node);
+        void CollapseSparseAncestors(OctreeNode* node);
+        void CollapseSparseNodes(OctreeNode* node);
 
         template<typename Func>
         void TraverseNodesRecursive(const OctreeNode* node, Func&& visitor) const {
@@ -222,7 +249,7 @@ namespace Angaraka::SceneSystem {
         }
 
         // Batch update support
-        void BeginBatchUpdate() { m_batchMode = true; }
+        void BeginBatchUpdate() { ++m_batchDepth; }
         void EndBatchUpdate();
     };
 
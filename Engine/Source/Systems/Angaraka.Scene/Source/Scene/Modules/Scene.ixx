@@ -2,6 +2,7 @@ module;
 
 #include "Angaraka/Base.hpp"
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <functional>
 
@@ -14,9 +15,14 @@ import Angaraka.Math.Ray;
 import Angaraka.Math.Frustum;
 
 import Angaraka.Scene.Transform;
+import Angaraka.Scene.TransformSystem;
 import Angaraka.Scene.Component;
 import Angaraka.Scene.Entity;
+import Angaraka.Scene.Octree;
+import Angaraka.Scene.LinearBVH;
 import Angaraka.Graphics.DirectX12;
+import Angaraka.Graphics.InstanceBatcher;
+import Angaraka.Graphics.RenderCommands;
 import Angaraka.Core.ResourceCache;
 
 namespace Angaraka::SceneSystem {
@@ -56,15 +62,22 @@ namespace Angaraka::SceneSystem {
             F32 updateTimeMs = 0.0f;
             F32 cullingTimeMs = 0.0f;
             F32 renderTimeMs = 0.0f;
+            U32 drawCalls = 0;          // Instanced draws after batching identical meshes
         };
 
         /**
          * @brief Render queue entry
+         *
+         * sortKey is packed once during collection, most significant bits first:
+         * queue (2) | render layer (8) | quantized camera depth (24) | mesh id (30).
+         * Depth is inverted for the transparent queue, so sorting the keys ascending gives
+         * front-to-back opaque and back-to-front transparent order.
          */
         struct RenderEntry {
             Entity* entity = nullptr;
             F32 distanceToCamera = 0.0f;
             U32 renderOrder = 0;
+            U64 sortKey = 0;
         };
 
         /**
@@ -78,6 +91,15 @@ namespace Angaraka::SceneSystem {
             Count
         };
 
+        /**
+         * @brief How spatial queries and culling find candidate entities
+         */
+        enum class SpatialQueryMode {
+            Linear,     // Test every entity, no acceleration structure to maintain
+            Octree,     // Walk the octree, kept up to date from transform changes
+            LinearBVH   // Flat SIMD-friendly BVH, refit on moves and rebuilt when entities come and go
+        };
+
         Scene(Core::CachedResourceManager* resourceManager, DirectX12GraphicsSystem* graphicsSystem);
         ~Scene();
 
@@ -217,6 +239,44 @@ namespace Angaraka::SceneSystem {
         void RaycastAll(const Math::Ray& ray, F32 maxDistance, U32 layerMask,
             std::vector<RaycastHit>& outHits) const;
 
+        /**
+         * @brief Select how spatial queries are answered
+         *
+         * Switching to Octree or LinearBVH builds that structure from all current
+         * entities. Only the structure for the active mode is maintained.
+         */
+        void SetSpatialQueryMode(SpatialQueryMode mode);
+        SpatialQueryMode GetSpatialQueryMode() const { return m_spatialQueryMode; }
+
+        /**
+         * @brief Get the octree (empty unless the query mode is Octree)
+         */
+        const Octree& GetOctree() const;
+
+        /**
+         * @brief Get the BVH (empty unless the query mode is LinearBVH)
+         */
+        const LinearBVH& GetLinearBVH() const;
+
+        // ================== Transform Hierarchy ==================
+
+        /**
+         * @brief Keep entity transforms in the scene's TransformSystem
+         *
+         * Enabled by default. World matrices are then recomputed in one pass per frame
+         * (end of Update and before spatial queries) instead of lazily on every read.
+         * Disabling moves every transform back to its own storage.
+         */
+        void SetTransformSystemEnabled(bool enabled);
+        bool IsTransformSystemEnabled() const { return m_transformSystemEnabled; }
+
+        /**
+         * @brief Run the transform pass now (no-op when nothing changed)
+         */
+        void UpdateTransforms();
+
+        const TransformSystem& GetTransformSystem() const { return *m_transformSystem; }
+
         // ================== Scene Lifecycle ==================
 
         /**
@@ -250,11 +310,18 @@ namespace Angaraka::SceneSystem {
         void PrepareRender(const Math::Vector3& cameraPosition,
             const Math::Frustum& frustum);
 
+        /**
+         * @brief Record draws for all visible entities
+         * @param commands Buffer to append to, identical meshes become instanced draws
+         */
+        void RecordRenderCommands(Graphics::RenderCommandBuffer& commands);
+
         /**
          * @brief Execute rendering for all visible entities
-         * @param renderer Graphics system to use for rendering
+         * @param executor Backend to run the recorded commands on, e.g. the DirectX12GraphicsSystem
+         *                 or a NullRenderExecutor for headless profiling
          */
-        void ExecuteRendering(DirectX12GraphicsSystem* renderer);
+        void ExecuteRendering(Graphics::RenderCommandExecutor* executor);
 
         /**
          * @brief Get render queue
@@ -263,6 +330,22 @@ namespace Angaraka::SceneSystem {
          */
         const std::vector<RenderEntry>& GetRenderQueue(RenderQueueType queueType) const;
 
+        /**
+         * @brief Pack the sort key of a render entry, see RenderEntry for the layout
+         * @param queue Queue the entry goes into
+         * @param layer Render layer, clamped to 255
+         * @param distanceToCamera Distance from the camera
+         * @param mesh Mesh drawn, only used to group equal meshes at equal depth
+         */
+        static U64 MakeRenderSortKey(RenderQueueType queue, U32 layer, F32 distanceToCamera, const void* mesh);
+
+        /**
+         * @brief Stable sort of a render queue by sortKey
+         * @param entries Queue to sort
+         * @param scratch Buffer of the radix sort, reuse it across calls to avoid allocating
+         */
+        static void SortRenderQueue(std::vector<RenderEntry>& entries, std::vector<RenderEntry>& scratch);
+
         // ================== Scene Management ==================
 
         /**
@@ -329,6 +412,9 @@ namespace Angaraka::SceneSystem {
         // Render queues
         std::array<std::vector<RenderEntry>,
             static_cast<size_t>(RenderQueueType::Count)> m_renderQueues;
+        std::vector<RenderEntry> m_sortScratch;               // Radix sort ping-pong buffer, reused every frame
+        Graphics::InstanceBatcher m_instanceBatcher;          // Groups sorted entries into instanced draws, reused every frame
+        Graphics::RenderCommandBuffer m_renderCommands;       // Recorded by ExecuteRendering, reused every frame
 
         // Scene properties
         String m_name = "Untitled Scene";
@@ -338,13 +424,25 @@ namespace Angaraka::SceneSystem {
         mutable Statistics m_statistics;
         bool m_collectStatistics = true;
 
-        // Spatial acceleration (future)
-        // Scope<Octree> m_octree;
+        // Spatial acceleration
+        SpatialQueryMode m_spatialQueryMode = SpatialQueryMode::Octree;
+        Scope<Octree> m_octree;
+        Scope<LinearBVH> m_bvh;
+        mutable std::unordered_set<Entity*> m_spatialDirty;   // Moved since the last query
+        mutable bool m_bvhRebuildPending = false;             // Entities were added or removed
+        std::vector<Entity*> m_visibleEntities;               // Culling scratch, reused every frame
+
+        // Transform hierarchy
+        Scope<TransformSystem> m_transformSystem;
+        bool m_transformSystemEnabled = true;
 
         // Helper methods
         void DestroyEntityInternal(Entity* entity);
-        void CollectRenderables(const Math::Frustum& frustum);
-        void SortRenderQueues(const Math::Vector3& cameraPosition);
+        void MarkSpatialDirty(Entity* entity);
+        void FlushSpatialUpdates() const;
+        void RebuildLinearBVH() const;
+        void CollectRenderables(const Math::Vector3& cameraPosition, const Math::Frustum& frustum);
+        void SortRenderQueues();
         void UpdateStatistics();
     };
 
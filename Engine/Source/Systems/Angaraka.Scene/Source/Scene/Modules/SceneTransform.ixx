@@ -8,6 +8,7 @@ import Angaraka.Math.Vector3;
 import Angaraka.Math.Matrix4x4;
 import Angaraka.Math.Quaternion;
 import Angaraka.Math.Transform;
+import Angaraka.Scene.TransformSystem;
 
 namespace Angaraka::SceneSystem {
 
@@ -19,6 +20,10 @@ namespace Angaraka::SceneSystem {
      * - Automatic dirty flag propagation
      * - Cached world transformation matrices
      * - Transform change notifications
+     *
+     * A transform can be attached to a TransformSystem, in which case its TRS and
+     * matrices live in the system's arrays and this object acts as a handle. World
+     * matrices are then updated in one pass per frame instead of lazily per read.
      */
     export class SceneTransform {
     public:
@@ -28,34 +33,37 @@ namespace Angaraka::SceneSystem {
         SceneTransform();
         ~SceneTransform();
 
-        // Non-copyable but moveable
-        SceneTransform(const SceneTransform&) = delete;
-        SceneTransform& operator=(const SceneTransform&) = delete;
-        SceneTransform(SceneTransform&&) noexcept = default;
-        SceneTransform& operator=(SceneTransform&&) noexcept = default;
+        // Parent, children and the transform system point at this object
+        DISABLE_COPY_AND_MOVE(SceneTransform);
 
         // ================== Local Transform ==================
 
         // Position
         void SetLocalPosition(const Math::Vector3& position);
         void SetLocalPosition(F32 x, F32 y, F32 z);
-        const Math::Vector3& GetLocalPosition() const { return m_localTransform.position; }
+        const Math::Vector3& GetLocalPosition() const {
+            return m_system ? m_system->GetLocalPosition(m_handle) : m_localTransform.position;
+        }
 
         // Rotation
         void SetLocalRotation(const Math::Quaternion& rotation);
         void SetLocalRotationEuler(const Math::Vector3& eulerAngles);
         void SetLocalRotationEuler(F32 x, F32 y, F32 z);
-        const Math::Quaternion& GetLocalRotation() const { return m_localTransform.rotation; }
+        const Math::Quaternion& GetLocalRotation() const {
+            return m_system ? m_system->GetLocalRotation(m_handle) : m_localTransform.rotation;
+        }
         Math::Vector3 GetLocalRotationEuler() const;
 
         // Scale
         void SetLocalScale(const Math::Vector3& scale);
         void SetLocalScale(F32 uniformScale);
         void SetLocalScale(F32 x, F32 y, F32 z);
-        const Math::Vector3& GetLocalScale() const { return m_localTransform.scale; }
+        const Math::Vector3& GetLocalScale() const {
+            return m_system ? m_system->GetLocalScale(m_handle) : m_localTransform.scale;
+        }
 
         // Get the entire local transform
-        const Math::Transform& GetLocalTransform() const { return m_localTransform; }
+        Math::Transform GetLocalTransform() const;
         void SetLocalTransform(const Math::Transform& transform);
 
         // ================== World Transform ==================
@@ -138,7 +146,18 @@ namespace Angaraka::SceneSystem {
 
         // Manually mark as dirty (forces recalculation)
         void SetDirty();
-        bool IsDirty() const { return m_localDirty || m_worldDirty; }
+        bool IsDirty() const;
+
+        // ================== Transform System ==================
+
+        // Moves the local TRS into the system, the parent (if any) must already be attached to it
+        bool AttachToSystem(TransformSystem* system);
+
+        // Copies the data back and unregisters. Detach attached children first.
+        void DetachFromSystem();
+
+        TransformSystem* GetSystem() const { return m_system; }
+        TransformHandle GetSystemHandle() const { return m_handle; }
 
         // ================== Utility ==================
 
@@ -147,7 +166,9 @@ namespace Angaraka::SceneSystem {
         const String& GetName() const { return m_name; }
 
     private:
-        // Core transform data
+        friend class TransformSystem;
+
+        // Core transform data (unused while attached to a transform system)
         Math::Transform m_localTransform;
 
         // Cached matrices (mutable for lazy evaluation)
@@ -159,6 +180,11 @@ namespace Angaraka::SceneSystem {
         mutable bool m_localDirty = true;
         mutable bool m_worldDirty = true;
 
+        // Transform system slot, m_worldToLocalMatrix is valid for m_worldToLocalVersion
+        TransformSystem* m_system = nullptr;
+        TransformHandle m_handle = InvalidTransformHandle;
+        mutable U32 m_worldToLocalVersion = 0;
+
         // Hierarchy
         SceneTransform* m_parent = nullptr;
         std::vector<SceneTransform*> m_children;
@@ -175,6 +201,9 @@ namespace Angaraka::SceneSystem {
         void AddChild(SceneTransform* child);
         void RemoveChild(SceneTransform* child);
 
+        // Writes the local TRS to wherever it lives
+        void WriteLocalTransform(const Math::Transform& transform);
+
         // Dirty flag propagation
         void MarkLocalDirty();
         void MarkWorldDirty();
@@ -187,5 +216,6 @@ namespace Angaraka::SceneSystem {
 
         // Notify listeners
         void NotifyTransformChanged();
+        void OnWorldChangedBySystem();
     };
 }
@@ -0,0 +1,152 @@
+module;
+
+#include "Angaraka/Base.hpp"
+#include <vector>
+
+export module Angaraka.Scene.TransformSystem;
+
+import Angaraka.Math.Vector3;
+import Angaraka.Math.Matrix4x4;
+import Angaraka.Math.Quaternion;
+import Angaraka.Math.Transform;
+
+namespace Angaraka::SceneSystem {
+
+    // Forward declarations
+    export class SceneTransform;
+
+    /**
+     * @brief Stable handle of a transform registered with a TransformSystem
+     */
+    export using TransformHandle = U32;
+    export constexpr TransformHandle InvalidTransformHandle = U32(-1);
+
+    /**
+     * @brief Data-oriented storage and update pass for transform hierarchies
+     *
+     * Local TRS, local matrices and world matrices live in contiguous arrays kept in
+     * breadth-first order, so every depth level is one contiguous range and siblings sit
+     * next to each other. Attached SceneTransforms are handles into these arrays.
+     *
+     * Changing a transform only flags that slot. Update() propagates the flags and
+     * recomputes world matrices level by level (parents before children), using the batch
+     * math kernels and running large levels on the JobSystem. World matrix reads between
+     * a change and the next Update() resolve just the affected chain; once Update() has
+     * run they are a plain array lookup.
+     *
+     * Not thread-safe, owned and used by the game thread. Update() parallelizes internally.
+     */
+    export class TransformSystem {
+    public:
+        // Levels with fewer transforms than this are updated on the calling thread
+        static constexpr size_t PARALLEL_GRAIN_SIZE = 512;
+
+        TransformSystem() = default;
+        ~TransformSystem() = default;
+        DISABLE_COPY_AND_MOVE(TransformSystem);
+
+        // ================== Registration ==================
+        // Driven by SceneTransform::AttachToSystem / DetachFromSystem
+
+        TransformHandle Register(SceneTransform* owner, const Math::Transform& local, TransformHandle parent);
+        void Unregister(TransformHandle handle);
+        void SetParent(TransformHandle handle, TransformHandle parent);
+        bool IsValid(TransformHandle handle) const;
+
+        // ================== Local Transform ==================
+
+        const Math::Vector3& GetLocalPosition(TransformHandle handle) const { return m_positions[IndexOf(handle)]; }
+        const Math::Quaternion& GetLocalRotation(TransformHandle handle) const { return m_rotations[IndexOf(handle)]; }
+        const Math::Vector3& GetLocalScale(TransformHandle handle) const { return m_scales[IndexOf(handle)]; }
+
+        void SetLocalPosition(TransformHandle handle, const Math::Vector3& position);
+        void SetLocalRotation(TransformHandle handle, const Math::Quaternion& rotation);
+        void SetLocalScale(TransformHandle handle, const Math::Vector3& scale);
+
+        // Flags the world matrix without touching the local TRS (e.g. after reparenting)
+        void MarkWorldDirty(TransformHandle handle);
+
+        // Forces both matrices to be recomputed
+        void SetDirty(TransformHandle handle);
+
+        // ================== Matrices ==================
+
+        const Math::Matrix4x4& GetLocalMatrix(TransformHandle handle);
+        const Math::Matrix4x4& GetWorldMatrix(TransformHandle handle);
+
+        // Changes every time the world matrix is recomputed, lets callers cache derived data
+        U32 GetWorldVersion(TransformHandle handle);
+
+        // True if the world matrix is stale because of this transform or one of its ancestors
+        bool IsDirty(TransformHandle handle) const;
+
+        // ================== Update ==================
+
+        /**
+         * @brief Recompute every stale world matrix
+         *
+         * Transforms whose world matrix changed only because an ancestor moved get their
+         * change notification here; directly modified transforms were notified when the
+         * change was made.
+         */
+        void Update();
+
+        bool HasPendingChanges() const { return m_pendingChanges > 0 || m_orderDirty; }
+
+        // ================== Statistics ==================
+
+        U32 GetTransformCount() const { return m_liveCount; }
+        U32 GetLevelCount() const { return m_levelOffsets.empty() ? 0 : static_cast<U32>(m_levelOffsets.size() - 1); }
+        U32 GetLastUpdateCount() const { return m_lastUpdateCount; }
+
+    private:
+        static constexpr U32 InvalidIndex = U32(-1);
+
+        enum SlotFlags : U8 {
+            LocalDirty = 1 << 0,    // Local matrix is stale
+            WorldDirty = 1 << 1,    // World matrix is stale because this transform changed
+            Inherited = 1 << 2,     // World matrix changed because an ancestor moved, owner not notified yet
+            Dead = 1 << 3           // Unregistered, dropped on the next reorder
+        };
+
+        // Per slot, in breadth-first order once m_orderDirty is clear
+        std::vector<Math::Vector3> m_positions;
+        std::vector<Math::Quaternion> m_rotations;
+        std::vector<Math::Vector3> m_scales;
+        std::vector<Math::Matrix4x4> m_localMatrices;
+        std::vector<Math::Matrix4x4> m_worldMatrices;
+        std::vector<U32> m_worldVersions;           // A child is stale when its parent's version is newer
+        std::vector<U32> m_parents;                 // Slot index of the parent or InvalidIndex
+        std::vector<U8> m_flags;
+        std::vector<SceneTransform*> m_owners;
+        std::vector<TransformHandle> m_slotHandles;
+
+        // Per handle
+        std::vector<U32> m_handleToIndex;
+        std::vector<TransformHandle> m_freeHandles;
+
+        // Level d covers slots [m_levelOffsets[d], m_levelOffsets[d + 1])
+        std::vector<U32> m_levelOffsets;
+
+        bool m_orderDirty = false;
+        U32 m_liveCount = 0;
+        U32 m_pendingChanges = 0;
+        U32 m_nextWorldVersion = 1;
+        U32 m_lastUpdateCount = 0;
+
+        U32 IndexOf(TransformHandle handle) const;
+        void MarkDirty(U32 index, U8 flags);
+
+        // Lazy path for reads between a change and the next Update
+        const Math::Matrix4x4& ResolveLocal(U32 index);
+        const Math::Matrix4x4& ResolveWorld(U32 index);
+        bool IsStale(U32 index) const;
+
+        // Update pass
+        void RebuildOrder();
+        U32 BreakParentCycles(const std::vector<U32>& reachable);
+        void UpdateRange(U32 begin, U32 end, U32 version);
+        void NotifyInherited(U32 version);
+    };
+
+} // namespace Angaraka::SceneSystem
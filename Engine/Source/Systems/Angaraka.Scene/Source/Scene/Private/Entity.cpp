@@ -242,6 +242,14 @@ namespace Angaraka::SceneSystem {
                 }
             }
         }
+
+        NotifySpatialChanged();
+    }
+
+    void Entity::NotifySpatialChanged() {
+        if (m_onSpatialChanged) {
+            m_onSpatialChanged(this);
+        }
     }
 
     template<typename T>
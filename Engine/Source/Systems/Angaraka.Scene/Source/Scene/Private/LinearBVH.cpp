@@ -0,0 +1,580 @@
+module;
+
+#include "Angaraka/Base.hpp"
+#include <algorithm>
+#include <bit>
+#include <xmmintrin.h>
+
+module Angaraka.Scene.LinearBVH;
+
+import Angaraka.Math.Vector3;
+import Angaraka.Math.Vector4;
+import Angaraka.Math.BoundingBox;
+import Angaraka.Math.Frustum;
+import Angaraka.Math.Ray;
+
+import Angaraka.Scene.Entity;
+import Angaraka.Scene.Octree;
+import Angaraka.Scene.Components.MeshRenderer;
+
+namespace Angaraka::SceneSystem {
+
+    namespace {
+
+        // Worst case depth is bounded by the 30 Morton bits plus the log of the item count,
+        // and a node pushes at most 4 children, so this never overflows in practice
+        constexpr U32 MAX_TRAVERSAL_STACK = 256;
+
+        // ================== Morton Codes ==================
+
+        // Spreads the lower 10 bits of v so there are two zero bits between each
+        U32 ExpandBits(U32 v) {
+            v = (v * 0x00010001u) & 0xFF0000FFu;
+            v = (v * 0x00000101u) & 0x0F00F00Fu;
+            v = (v * 0x00000011u) & 0xC30C30C3u;
+            v = (v * 0x00000005u) & 0x49249249u;
+            return v;
+        }
+
+        // 30-bit Morton code for a point in the unit cube
+        U32 MortonCode(F32 x, F32 y, F32 z) {
+            auto quantize = [](F32 value) {
+                return static_cast<U32>(std::clamp(value * 1024.0f, 0.0f, 1023.0f));
+            };
+            return (ExpandBits(quantize(x)) << 2) | (ExpandBits(quantize(y)) << 1) | ExpandBits(quantize(z));
+        }
+
+        // ================== SIMD Box Tests ==================
+
+        /**
+         * @brief Frustum planes broadcast for 4-wide tests
+         *
+         * The sign of each normal component is resolved once per query, so picking the
+         * positive / negative box vertex is a register choice rather than a blend.
+         */
+        struct FrustumPlanes4 {
+            __m128 nx[Math::Frustum::Count];
+            __m128 ny[Math::Frustum::Count];
+            __m128 nz[Math::Frustum::Count];
+            __m128 d[Math::Frustum::Count];
+            bool positiveX[Math::Frustum::Count];
+            bool positiveY[Math::Frustum::Count];
+            bool positiveZ[Math::Frustum::Count];
+        };
+
+        FrustumPlanes4 LoadPlanes(const Math::Frustum& frustum) {
+            FrustumPlanes4 planes;
+            const auto& source = frustum.GetPlanes();
+            for (size_t p = 0; p < source.size(); ++p) {
+                planes.nx[p] = _mm_set1_ps(source[p].x);
+                planes.ny[p] = _mm_set1_ps(source[p].y);
+                planes.nz[p] = _mm_set1_ps(source[p].z);
+                planes.d[p] = _mm_set1_ps(source[p].w);
+                planes.positiveX[p] = source[p].x >= 0.0f;
+                planes.positiveY[p] = source[p].y >= 0.0f;
+                planes.positiveZ[p] = source[p].z >= 0.0f;
+            }
+            return planes;
+        }
+
+        /**
+         * @brief Tests 4 SoA boxes against all frustum planes
+         * @param outsideMask Lanes completely outside at least one plane
+         * @param partialMask Lanes crossing at least one plane (not fully inside)
+         */
+        void TestFrustum4(const FrustumPlanes4& planes,
+            const F32* minX, const F32* minY, const F32* minZ,
+            const F32* maxX, const F32* maxY, const F32* maxZ,
+            U32& outsideMask, U32& partialMask) {
+            const __m128 boxMinX = _mm_loadu_ps(minX);
+            const __m128 boxMinY = _mm_loadu_ps(minY);
+            const __m128 boxMinZ = _mm_loadu_ps(minZ);
+            const __m128 boxMaxX = _mm_loadu_ps(maxX);
+            const __m128 boxMaxY = _mm_loadu_ps(maxY);
+            const __m128 boxMaxZ = _mm_loadu_ps(maxZ);
+            const __m128 zero = _mm_setzero_ps();
+
+            __m128 outside = zero;
+            __m128 partial = zero;
+
+            for (U32 p = 0; p < Math::Frustum::Count; ++p) {
+                // Positive vertex is the corner furthest along the normal, negative the nearest
+                __m128 posX = planes.positiveX[p] ? boxMaxX : boxMinX;
+                __m128 posY = planes.positiveY[p] ? boxMaxY : boxMinY;
+                __m128 posZ = planes.positiveZ[p] ? boxMaxZ : boxMinZ;
+                __m128 negX = planes.positiveX[p] ? boxMinX : boxMaxX;
+                __m128 negY = planes.positiveY[p] ? boxMinY : boxMaxY;
+                __m128 negZ = planes.positiveZ[p] ? boxMinZ : boxMaxZ;
+
+                __m128 positiveDistance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(planes.nx[p], posX), _mm_mul_ps(planes.ny[p], posY)),
+                    _mm_add_ps(_mm_mul_ps(planes.nz[p], posZ), planes.d[p]));
+                __m128 negativeDistance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(planes.nx[p], negX), _mm_mul_ps(planes.ny[p], negY)),
+                    _mm_add_ps(_mm_mul_ps(planes.nz[p], negZ), planes.d[p]));
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(positiveDistance, zero));
+                partial = _mm_or_ps(partial, _mm_cmplt_ps(negativeDistance, zero));
+            }
+
+            outsideMask = static_cast<U32>(_mm_movemask_ps(outside));
+            partialMask = static_cast<U32>(_mm_movemask_ps(partial));
+        }
+
+        // Lanes whose box overlaps [queryMin, queryMax]
+        U32 OverlapBox4(const F32* minX, const F32* minY, const F32* minZ,
+            const F32* maxX, const F32* maxY, const F32* maxZ,
+            const Math::BoundingBox& query) {
+            __m128 overlap = _mm_and_ps(
+                _mm_and_ps(
+                    _mm_cmple_ps(_mm_loadu_ps(minX), _mm_set1_ps(query.max.x)),
+                    _mm_cmple_ps(_mm_loadu_ps(minY), _mm_set1_ps(query.max.y))),
+                _mm_cmple_ps(_mm_loadu_ps(minZ), _mm_set1_ps(query.max.z)));
+            overlap = _mm_and_ps(overlap, _mm_and_ps(
+                _mm_and_ps(
+                    _mm_cmpge_ps(_mm_loadu_ps(maxX), _mm_set1_ps(query.min.x)),
+                    _mm_cmpge_ps(_mm_loadu_ps(maxY), _mm_set1_ps(query.min.y))),
+                _mm_cmpge_ps(_mm_loadu_ps(maxZ), _mm_set1_ps(query.min.z))));
+            return static_cast<U32>(_mm_movemask_ps(overlap));
+        }
+
+        // Lanes whose box is within radius of center (squared distance to the closest point)
+        U32 OverlapSphere4(const F32* minX, const F32* minY, const F32* minZ,
+            const F32* maxX, const F32* maxY, const F32* maxZ,
+            const Math::Vector3& center, F32 radius) {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 cx = _mm_set1_ps(center.x);
+            const __m128 cy = _mm_set1_ps(center.y);
+            const __m128 cz = _mm_set1_ps(center.z);
+
+            __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minX), cx), _mm_sub_ps(cx, _mm_loadu_ps(maxX))), zero);
+            __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minY), cy), _mm_sub_ps(cy, _mm_loadu_ps(maxY))), zero);
+            __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(minZ), cz), _mm_sub_ps(cz, _mm_loadu_ps(maxZ))), zero);
+            __m128 distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            return static_cast<U32>(_mm_movemask_ps(_mm_cmple_ps(distanceSq, _mm_set1_ps(radius * radius))));
+        }
+
+        // Lanes [0, count) set
+        U32 LaneMask(U32 count) {
+            return count >= 4 ? 0xFu : (1u << count) - 1u;
+        }
+    }
+
+    // ================== Building ==================
+
+    void LinearBVH::Build(const std::vector<Entity*>& entities) {
+        Clear();
+
+        if (entities.empty()) {
+            return;
+        }
+
+        U32 itemCount = static_cast<U32>(entities.size());
+
+        // Gather bounds and the extent of their centers for quantization
+        std::vector<Math::BoundingBox> bounds(itemCount);
+        Math::BoundingBox centerBounds;
+        for (U32 i = 0; i < itemCount; ++i) {
+            bounds[i] = ComputeEntityBounds(entities[i]);
+            centerBounds.ExpandToInclude(bounds[i].GetCenter());
+        }
+
+        Math::Vector3 extent = centerBounds.GetSize();
+        Math::Vector3 inverseExtent(
+            extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+            extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+            extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+        // Sort items along the Morton curve
+        std::vector<std::pair<U32, U32>> keyed(itemCount);
+        for (U32 i = 0; i < itemCount; ++i) {
+            Math::Vector3 offset = bounds[i].GetCenter() - centerBounds.min;
+            keyed[i] = {
+                MortonCode(offset.x * inverseExtent.x, offset.y * inverseExtent.y, offset.z * inverseExtent.z),
+                i
+            };
+        }
+        std::sort(keyed.begin(), keyed.end());
+
+        // Lay out items in curve order; three zeroed padding slots keep 4-wide loads in bounds
+        std::vector<U32> codes(itemCount);
+        m_entities.resize(itemCount);
+        for (auto* column : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ }) {
+            column->assign(itemCount + 3, 0.0f);
+        }
+        m_entityToItem.reserve(itemCount);
+
+        for (U32 i = 0; i < itemCount; ++i) {
+            U32 source = keyed[i].second;
+            codes[i] = keyed[i].first;
+            m_entities[i] = entities[source];
+            m_entityToItem[entities[source]] = i;
+            SetItemBounds(i, bounds[source]);
+        }
+
+        m_nodes.reserve(itemCount / 2 + 1);
+        BuildNode(codes, 0, itemCount);
+    }
+
+    void LinearBVH::Clear() {
+        m_entities.clear();
+        m_minX.clear();
+        m_minY.clear();
+        m_minZ.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+        m_maxZ.clear();
+        m_entityToItem.clear();
+        m_nodes.clear();
+    }
+
+    U32 LinearBVH::BuildNode(const std::vector<U32>& codes, U32 first, U32 count) {
+        // Allocate before recursing so parents always precede their children
+        U32 nodeIndex = static_cast<U32>(m_nodes.size());
+        m_nodes.emplace_back();
+
+        // Split along the highest differing Morton bit, then split each half once more
+        Range ranges[4];
+        U32 rangeCount = 0;
+
+        if (count <= MAX_LEAF_SIZE) {
+            ranges[rangeCount++] = { first, count };
+        }
+        else {
+            U32 split = FindSplit(codes, first, count);
+            Range halves[2] = { { first, split - first }, { split, first + count - split } };
+
+            for (const Range& half : halves) {
+                if (half.count > MAX_LEAF_SIZE) {
+                    U32 quarterSplit = FindSplit(codes, half.first, half.count);
+                    ranges[rangeCount++] = { half.first, quarterSplit - half.first };
+                    ranges[rangeCount++] = { quarterSplit, half.first + half.count - quarterSplit };
+                }
+                else {
+                    ranges[rangeCount++] = half;
+                }
+            }
+        }
+
+        for (U32 slot = 0; slot < rangeCount; ++slot) {
+            const Range& range = ranges[slot];
+
+            Math::BoundingBox slotBounds;
+            U32 child = LEAF;
+            if (range.count > MAX_LEAF_SIZE) {
+                // Recursion grows m_nodes, so always index rather than hold a reference
+                child = BuildNode(codes, range.first, range.count);
+                slotBounds = ComputeNodeBounds(m_nodes[child]);
+            }
+            else {
+                slotBounds = ComputeRangeBounds(range.first, range.count);
+            }
+
+            Node& node = m_nodes[nodeIndex];
+            node.child[slot] = child;
+            node.first[slot] = range.first;
+            node.count[slot] = range.count;
+            SetSlotBounds(node, slot, slotBounds);
+        }
+
+        return nodeIndex;
+    }
+
+    U32 LinearBVH::FindSplit(const std::vector<U32>& codes, U32 first, U32 count) const {
+        U32 last = first + count - 1;
+
+        // Identical codes carry no spatial information, split the range in the middle
+        if (codes[first] == codes[last]) {
+            return first + count / 2;
+        }
+
+        // Binary search for the last item sharing more leading bits with the first than the last does
+        int commonPrefix = std::countl_zero(codes[first] ^ codes[last]);
+        U32 split = first;
+        U32 step = last - first;
+        do {
+            step = (step + 1) >> 1;
+            U32 candidate = split + step;
+            if (candidate < last && std::countl_zero(codes[first] ^ codes[candidate]) > commonPrefix) {
+                split = candidate;
+            }
+        } while (step > 1);
+
+        return split + 1;
+    }
+
+    // ================== Refitting ==================
+
+    bool LinearBVH::UpdateBounds(Entity* entity) {
+        auto it = m_entityToItem.find(entity);
+        if (it == m_entityToItem.end()) {
+            return false;
+        }
+
+        SetItemBounds(it->second, ComputeEntityBounds(entity));
+        return true;
+    }
+
+    void LinearBVH::Refit() {
+        // Children always follow their parent, so walking backwards sees them first
+        for (size_t n = m_nodes.size(); n-- > 0;) {
+            Node& node = m_nodes[n];
+            for (U32 slot = 0; slot < 4; ++slot) {
+                if (node.count[slot] == 0) {
+                    continue;
+                }
+
+                Math::BoundingBox slotBounds = node.child[slot] == LEAF
+                    ? ComputeRangeBounds(node.first[slot], node.count[slot])
+                    : ComputeNodeBounds(m_nodes[node.child[slot]]);
+                SetSlotBounds(node, slot, slotBounds);
+            }
+        }
+    }
+
+    // ================== Spatial Queries ==================
+
+    void LinearBVH::Query(const Math::Frustum& frustum, std::vector<Entity*>& results) const {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        FrustumPlanes4 planes = LoadPlanes(frustum);
+
+        U32 stack[MAX_TRAVERSAL_STACK];
+        U32 stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            const Node& node = m_nodes[stack[--stackSize]];
+
+            U32 outsideMask, partialMask;
+            TestFrustum4(planes, node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ,
+                outsideMask, partialMask);
+            U32 visibleMask = ValidSlotMask(node) & ~outsideMask;
+
+            for (U32 slot = 0; slot < 4; ++slot) {
+                if ((visibleMask & (1u << slot)) == 0) {
+                    continue;
+                }
+
+                // Fully inside: the subtree is one contiguous item range, emit it untested
+                if ((partialMask & (1u << slot)) == 0) {
+                    EmitRange(node.first[slot], node.count[slot], true, results);
+                    continue;
+                }
+
+                if (node.child[slot] != LEAF) {
+                    stack[stackSize++] = node.child[slot];
+                    continue;
+                }
+
+                // Straddling leaf, test its items four at a time
+                for (U32 offset = 0; offset < node.count[slot]; offset += 4) {
+                    U32 item = node.first[slot] + offset;
+                    U32 itemOutside, itemPartial;
+                    TestFrustum4(planes, &m_minX[item], &m_minY[item], &m_minZ[item],
+                        &m_maxX[item], &m_maxY[item], &m_maxZ[item], itemOutside, itemPartial);
+
+                    U32 itemVisible = LaneMask(node.count[slot] - offset) & ~itemOutside;
+                    for (U32 lane = 0; lane < 4; ++lane) {
+                        if (itemVisible & (1u << lane)) {
+                            EmitRange(item + lane, 1, true, results);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void LinearBVH::Query(const Math::BoundingBox& bounds, std::vector<Entity*>& results) const {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        U32 stack[MAX_TRAVERSAL_STACK];
+        U32 stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            const Node& node = m_nodes[stack[--stackSize]];
+            U32 overlapMask = ValidSlotMask(node) &
+                OverlapBox4(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ, bounds);
+
+            for (U32 slot = 0; slot < 4; ++slot) {
+                if ((overlapMask & (1u << slot)) == 0) {
+                    continue;
+                }
+
+                if (node.child[slot] != LEAF) {
+                    stack[stackSize++] = node.child[slot];
+                    continue;
+                }
+
+                for (U32 offset = 0; offset < node.count[slot]; offset += 4) {
+                    U32 item = node.first[slot] + offset;
+                    U32 itemOverlap = LaneMask(node.count[slot] - offset) &
+                        OverlapBox4(&m_minX[item], &m_minY[item], &m_minZ[item],
+                            &m_maxX[item], &m_maxY[item], &m_maxZ[item], bounds);
+
+                    for (U32 lane = 0; lane < 4; ++lane) {
+                        if (itemOverlap & (1u << lane)) {
+                            EmitRange(item + lane, 1, false, results);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void LinearBVH::Query(const Math::Vector3& center, F32 radius, std::vector<Entity*>& results) const {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        F32 radiusSq = radius * radius;
+
+        U32 stack[MAX_TRAVERSAL_STACK];
+        U32 stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            const Node& node = m_nodes[stack[--stackSize]];
+            U32 overlapMask = ValidSlotMask(node) &
+                OverlapSphere4(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ, center, radius);
+
+            for (U32 slot = 0; slot < 4; ++slot) {
+                if ((overlapMask & (1u << slot)) == 0) {
+                    continue;
+                }
+
+                if (node.child[slot] != LEAF) {
+                    stack[stackSize++] = node.child[slot];
+                    continue;
+                }
+
+                // Entity positions, matching the octree and linear paths
+                for (U32 item = node.first[slot]; item < node.first[slot] + node.count[slot]; ++item) {
+                    Entity* entity = m_entities[item];
+                    if (!entity->IsActive()) continue;
+
+                    F32 distSq = (entity->GetTransform().GetWorldPosition() - center).LengthSquared();
+                    if (distSq <= radiusSq) {
+                        results.push_back(entity);
+                    }
+                }
+            }
+        }
+    }
+
+    void LinearBVH::QueryRay(const Math::Ray& ray, F32 maxDistance, std::vector<Entity*>& results) const {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        U32 stack[MAX_TRAVERSAL_STACK];
+        U32 stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            const Node& node = m_nodes[stack[--stackSize]];
+
+            for (U32 slot = 0; slot < 4; ++slot) {
+                if (node.count[slot] == 0) {
+                    continue;
+                }
+
+                Math::BoundingBox slotBounds(
+                    Math::Vector3(node.minX[slot], node.minY[slot], node.minZ[slot]),
+                    Math::Vector3(node.maxX[slot], node.maxY[slot], node.maxZ[slot]));
+
+                F32 tMin, tMax;
+                if (!slotBounds.IntersectsRay(ray.origin, ray.direction, tMin, tMax) || tMin > maxDistance) {
+                    continue;
+                }
+
+                if (node.child[slot] != LEAF) {
+                    stack[stackSize++] = node.child[slot];
+                    continue;
+                }
+
+                for (U32 item = node.first[slot]; item < node.first[slot] + node.count[slot]; ++item) {
+                    if (!m_entities[item]->IsActive()) continue;
+
+                    if (GetItemBounds(item).IntersectsRay(ray.origin, ray.direction, tMin, tMax) &&
+                        tMin <= maxDistance) {
+                        results.push_back(m_entities[item]);
+                    }
+                }
+            }
+        }
+    }
+
+    // ================== Private Helper Methods ==================
+
+    void LinearBVH::SetItemBounds(U32 item, const Math::BoundingBox& bounds) {
+        m_minX[item] = bounds.min.x;
+        m_minY[item] = bounds.min.y;
+        m_minZ[item] = bounds.min.z;
+        m_maxX[item] = bounds.max.x;
+        m_maxY[item] = bounds.max.y;
+        m_maxZ[item] = bounds.max.z;
+    }
+
+    Math::BoundingBox LinearBVH::GetItemBounds(U32 item) const {
+        return Math::BoundingBox(
+            Math::Vector3(m_minX[item], m_minY[item], m_minZ[item]),
+            Math::Vector3(m_maxX[item], m_maxY[item], m_maxZ[item]));
+    }
+
+    Math::BoundingBox LinearBVH::ComputeRangeBounds(U32 first, U32 count) const {
+        Math::BoundingBox bounds;
+        for (U32 item = first; item < first + count; ++item) {
+            bounds.ExpandToInclude(GetItemBounds(item));
+        }
+        return bounds;
+    }
+
+    Math::BoundingBox LinearBVH::ComputeNodeBounds(const Node& node) const {
+        Math::BoundingBox bounds;
+        for (U32 slot = 0; slot < 4; ++slot) {
+            if (node.count[slot] > 0) {
+                bounds.ExpandToInclude(Math::BoundingBox(
+                    Math::Vector3(node.minX[slot], node.minY[slot], node.minZ[slot]),
+                    Math::Vector3(node.maxX[slot], node.maxY[slot], node.maxZ[slot])));
+            }
+        }
+        return bounds;
+    }
+
+    void LinearBVH::SetSlotBounds(Node& node, U32 slot, const Math::BoundingBox& bounds) {
+        node.minX[slot] = bounds.min.x;
+        node.minY[slot] = bounds.min.y;
+        node.minZ[slot] = bounds.min.z;
+        node.maxX[slot] = bounds.max.x;
+        node.maxY[slot] = bounds.max.y;
+        node.maxZ[slot] = bounds.max.z;
+    }
+
+    U32 LinearBVH::ValidSlotMask(const Node& node) {
+        // Unused slots hold zeroed bounds and must never pass a test
+        U32 mask = 0;
+        for (U32 slot = 0; slot < 4; ++slot) {
+            if (node.count[slot] > 0) {
+                mask |= 1u << slot;
+            }
+        }
+        return mask;
+    }
+
+    void LinearBVH::EmitRange(U32 first, U32 count, bool renderableOnly, std::vector<Entity*>& results) const {
+        for (U32 item = first; item < first + count; ++item) {
+            Entity* entity = m_entities[item];
+            if (!entity->IsActive()) continue;
+            if (renderableOnly && !entity->HasComponent<MeshRenderer>()) continue;
+            results.push_back(entity);
+        }
+    }
+
+} // namespace Angaraka::SceneSystem
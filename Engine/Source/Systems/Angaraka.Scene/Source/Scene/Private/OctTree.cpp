@@ -17,67 +17,89 @@ import Angaraka.Scene.Components.MeshRenderer;
 
 namespace Angaraka::SceneSystem {
 
+    // ================== Entity Bounds ==================
+
+    Math::BoundingBox ComputeEntityBounds(const Entity* entity) {
+        if (const auto* renderer = entity->GetComponent<MeshRenderer>()) {
+            return renderer->GetBounds();
+        }
+
+        // Fallback to point bounds
+        Math::Vector3 pos = entity->GetTransform().GetWorldPosition();
+        return Math::BoundingBox(pos - Math::Vector3(0.5f), pos + Math::Vector3(0.5f));
+    }
+
     // ================== OctreeNode Implementation ==================
 
-    OctreeNode::OctreeNode(const Math::BoundingBox& bounds, U32 depth)
+    OctreeNode::OctreeNode(const Math::BoundingBox& bounds, U32 depth, OctreeNode* parent)
         : m_bounds(bounds)
-        , m_depth(depth) {
+        , m_depth(depth)
+        , m_parent(parent) {
         m_center = bounds.GetCenter();
         m_halfSize = bounds.GetHalfExtents();
     }
 
-    void OctreeNode::InsertEntity(Entity* entity) {
+    void OctreeNode::InsertEntity(Entity* entity, const Math::BoundingBox& bounds, EntityNodeMap& entityToNode) {
         if (!entity) return;
 
-        if (IsLeaf()) {
-            // Add to this node
-            m_entities.push_back(entity);
-
-            // Check if we should subdivide
-            if (ShouldSubdivide()) {
-                Subdivide();
+        // Descend as long as a single child fully contains the entity
+        OctreeNode* node = this;
+        while (!node->IsLeaf()) {
+            OctreeNode* child = node->FindContainingChild(bounds);
+            if (!child) {
+                break; // Entity spans multiple children, stay at this level
             }
+            node = child;
         }
-        else {
-            // Insert into appropriate child
-            InsertIntoChildren(entity);
+
+        node->StoreEntity(entity, bounds, entityToNode);
+        node->AdjustSubtreeCount(1);
+
+        if (node->ShouldSubdivide()) {
+            node->Subdivide(entityToNode);
         }
     }
 
-    void OctreeNode::RemoveEntity(Entity* entity) {
-        if (!entity) return;
+    bool OctreeNode::RemoveEntity(Entity* entity) {
+        auto it = std::find(m_entities.begin(), m_entities.end(), entity);
+        if (it == m_entities.end()) {
+            return false;
+        }
 
-        if (IsLeaf()) {
-            auto it = std::find(m_entities.begin(), m_entities.end(), entity);
-            if (it != m_entities.end()) {
-                m_entities.erase(it);
-            }
+        // Swap with the last entry, order within a node does not matter
+        size_t index = static_cast<size_t>(it - m_entities.begin());
+        m_entities[index] = m_entities.back();
+        m_entityBounds[index] = m_entityBounds.back();
+        m_entities.pop_back();
+        m_entityBounds.pop_back();
+
+        AdjustSubtreeCount(-1);
+        return true;
+    }
+
+    bool OctreeNode::TryUpdateEntityBounds(Entity* entity, const Math::BoundingBox& bounds) {
+        // Root keeps anything it cannot place elsewhere, other nodes must still contain the entity
+        if (m_parent && !m_bounds.Contains(bounds)) {
+            return false;
         }
-        else {
-            // Remove from all children (entity might span multiple)
-            for (auto& child : m_children) {
-                if (child) {
-                    child->RemoveEntity(entity);
-                }
-            }
 
-            // Check if we should collapse
-            if (ShouldCollapse()) {
-                Collapse();
-            }
+        // Moved far enough into one child that it should live further down
+        if (!IsLeaf() && FindContainingChild(bounds)) {
+            return false;
+        }
+
+        auto it = std::find(m_entities.begin(), m_entities.end(), entity);
+        if (it == m_entities.end()) {
+            return false;
         }
-    }
 
-    void OctreeNode::UpdateEntity(Entity* entity) {
-        // For now, just remove and re-insert
-        // Could be optimized to check if entity moved octants
-        RemoveEntity(entity);
-        InsertEntity(entity);
+        m_entityBounds[static_cast<size_t>(it - m_entities.begin())] = bounds;
+        return true;
     }
 
     bool OctreeNode::ContainsEntity(Entity* entity) const {
-        if (IsLeaf()) {
-            return std::find(m_entities.begin(), m_entities.end(), entity) != m_entities.end();
+        if (std::find(m_entities.begin(), m_entities.end(), entity) != m_entities.end()) {
+            return true;
         }
 
         for (const auto& child : m_children) {
@@ -90,89 +112,90 @@ namespace Angaraka::SceneSystem {
 
     void OctreeNode::GetEntitiesInFrustum(const Math::Frustum& frustum,
         std::vector<Entity*>& results) const {
+        if (m_subtreeCount == 0) {
+            return;
+        }
+
         // Check if node intersects frustum
         auto intersection = frustum.IntersectsBoundingBox(m_bounds);
         if (intersection == Math::Frustum::IntersectionResult::Outside) {
             return;
         }
 
-        if (IsLeaf()) {
-            // Add all entities that are visible
-            for (Entity* entity : m_entities) {
-                if (!entity->IsActive()) continue;
-
-                if (auto* renderer = entity->GetComponent<MeshRenderer>()) {
-                    if (intersection == Math::Frustum::IntersectionResult::Inside ||
-                        renderer->IsVisibleInFrustum(frustum)) {
-                        results.push_back(entity);
-                    }
-                }
+        // Everything below a fully contained node is visible, no need to test further
+        if (intersection == Math::Frustum::IntersectionResult::Inside) {
+            CollectActiveEntities(results, true);
+            return;
+        }
+
+        for (size_t i = 0; i < m_entities.size(); ++i) {
+            Entity* entity = m_entities[i];
+            if (!entity->IsActive() || !entity->HasComponent<MeshRenderer>()) continue;
+
+            if (frustum.Intersects(m_entityBounds[i])) {
+                results.push_back(entity);
             }
         }
-        else {
-            // Recurse to children
-            for (const auto& child : m_children) {
-                if (child) {
-                    child->GetEntitiesInFrustum(frustum, results);
-                }
+
+        for (const auto& child : m_children) {
+            if (child) {
+                child->GetEntitiesInFrustum(frustum, results);
             }
         }
     }
 
     void OctreeNode::GetEntitiesInBounds(const Math::BoundingBox& bounds,
         std::vector<Entity*>& results) const {
-        if (!m_bounds.Intersects(bounds)) {
+        if (m_subtreeCount == 0 || !m_bounds.Intersects(bounds)) {
             return;
         }
 
-        if (IsLeaf()) {
-            for (Entity* entity : m_entities) {
-                if (!entity->IsActive()) continue;
+        for (size_t i = 0; i < m_entities.size(); ++i) {
+            Entity* entity = m_entities[i];
+            if (!entity->IsActive()) continue;
 
-                Math::BoundingBox entityBounds = GetEntityBounds(entity);
-                if (bounds.Intersects(entityBounds)) {
-                    results.push_back(entity);
-                }
+            if (bounds.Intersects(m_entityBounds[i])) {
+                results.push_back(entity);
             }
         }
-        else {
-            for (const auto& child : m_children) {
-                if (child) {
-                    child->GetEntitiesInBounds(bounds, results);
-                }
+
+        for (const auto& child : m_children) {
+            if (child) {
+                child->GetEntitiesInBounds(bounds, results);
             }
         }
     }
 
     void OctreeNode::GetEntitiesInSphere(const Math::Vector3& center, F32 radius,
         std::vector<Entity*>& results) const {
-        if (!m_bounds.IntersectsSphere(center, radius)) {
+        if (m_subtreeCount == 0 || !m_bounds.IntersectsSphere(center, radius)) {
             return;
         }
 
-        if (IsLeaf()) {
-            F32 radiusSq = radius * radius;
-            for (Entity* entity : m_entities) {
-                if (!entity->IsActive()) continue;
-
-                Math::Vector3 entityPos = entity->GetTransform().GetWorldPosition();
-                F32 distSq = (entityPos - center).LengthSquared();
-                if (distSq <= radiusSq) {
-                    results.push_back(entity);
-                }
+        F32 radiusSq = radius * radius;
+        for (Entity* entity : m_entities) {
+            if (!entity->IsActive()) continue;
+
+            Math::Vector3 entityPos = entity->GetTransform().GetWorldPosition();
+            F32 distSq = (entityPos - center).LengthSquared();
+            if (distSq <= radiusSq) {
+                results.push_back(entity);
             }
         }
-        else {
-            for (const auto& child : m_children) {
-                if (child) {
-                    child->GetEntitiesInSphere(center, radius, results);
-                }
+
+        for (const auto& child : m_children) {
+            if (child) {
+                child->GetEntitiesInSphere(center, radius, results);
             }
         }
     }
 
     void OctreeNode::GetEntitiesAlongRay(const Math::Ray& ray, F32 maxDistance,
         std::vector<Entity*>& results) const {
+        if (m_subtreeCount == 0) {
+            return;
+        }
+
         F32 tMin, tMax;
         if (!m_bounds.IntersectsRay(ray.origin, ray.direction, tMin, tMax)) {
             return;
@@ -182,52 +205,62 @@ namespace Angaraka::SceneSystem {
             return;
         }
 
-        if (IsLeaf()) {
-            for (Entity* entity : m_entities) {
-                if (!entity->IsActive()) continue;
-
-                // Simple distance check for now
-                // Could add more precise ray-entity intersection
-                Math::Vector3 entityPos = entity->GetTransform().GetWorldPosition();
-                F32 dist = ray.DistanceToPoint(entityPos);
-                if (dist < 1.0f) { // Threshold
-                    results.push_back(entity);
-                }
+        for (size_t i = 0; i < m_entities.size(); ++i) {
+            Entity* entity = m_entities[i];
+            if (!entity->IsActive()) continue;
+
+            if (m_entityBounds[i].IntersectsRay(ray.origin, ray.direction, tMin, tMax) &&
+                tMin <= maxDistance) {
+                results.push_back(entity);
             }
         }
-        else {
-            for (const auto& child : m_children) {
-                if (child) {
-                    child->GetEntitiesAlongRay(ray, maxDistance, results);
-                }
+
+        for (const auto& child : m_children) {
+            if (child) {
+                child->GetEntitiesAlongRay(ray, maxDistance, results);
             }
         }
     }
 
-    void OctreeNode::Subdivide() {
+    void OctreeNode::Subdivide(EntityNodeMap& entityToNode) {
         if (!IsLeaf()) return;
 
         // Create children
         for (U32 i = 0; i < 8; ++i) {
             Octant octant = static_cast<Octant>(i);
             Math::BoundingBox childBounds = GetOctantBounds(octant);
-            m_children[i] = CreateScope<OctreeNode>(childBounds, m_depth + 1);
+            m_children[i] = CreateScope<OctreeNode>(childBounds, m_depth + 1, this);
         }
 
-        // Move entities to children
+        // Push down every entity that fits in a single child, the rest stay here
         std::vector<Entity*> entities = std::move(m_entities);
+        std::vector<Math::BoundingBox> entityBounds = std::move(m_entityBounds);
         m_entities.clear();
+        m_entityBounds.clear();
 
-        for (Entity* entity : entities) {
-            InsertIntoChildren(entity);
+        for (size_t i = 0; i < entities.size(); ++i) {
+            if (OctreeNode* child = FindContainingChild(entityBounds[i])) {
+                child->StoreEntity(entities[i], entityBounds[i], entityToNode);
+                child->m_subtreeCount++;
+            }
+            else {
+                StoreEntity(entities[i], entityBounds[i], entityToNode);
+            }
+        }
+
+        // Clustered entities may overflow a child straight away
+        for (auto& child : m_children) {
+            if (child->ShouldSubdivide()) {
+                child->Subdivide(entityToNode);
+            }
         }
     }
 
-    void OctreeNode::Collapse() {
+    void OctreeNode::Collapse(EntityNodeMap& entityToNode) {
         if (IsLeaf()) return;
 
-        // Collect all entities from children
-        CollectFromChildren();
+        // Pull all entities from children up into this node
+        CollectFromChildren(entityToNode);
 
         // Delete children
         for (auto& child : m_children) {
@@ -238,19 +271,14 @@ namespace Angaraka::SceneSystem {
     bool OctreeNode::ShouldSubdivide() const {
         if (!IsLeaf()) return false;
         if (m_entities.size() <= MAX_ENTITIES_PER_NODE) return false;
+        if (m_depth >= MAX_DEPTH) return false;
         if (m_halfSize.x < MIN_NODE_SIZE || m_halfSize.y < MIN_NODE_SIZE || m_halfSize.z < MIN_NODE_SIZE) return false;
         return true;
     }
 
     bool OctreeNode::ShouldCollapse() const {
         if (IsLeaf()) return false;
-
-        U32 totalEntities = 0;
-        GetAllEntities(const_cast<std::vector<Entity*>&>(m_entities)); // Temporary hack
-        totalEntities = static_cast<U32>(m_entities.size());
-        const_cast<std::vector<Entity*>&>(m_entities).clear();
-
-        return totalEntities <= MIN_ENTITIES_TO_COLLAPSE;
+        return m_subtreeCount <= MIN_ENTITIES_TO_COLLAPSE;
     }
 
     OctreeNode::Octant OctreeNode::GetOctantForPoint(const Math::Vector3& point) const {
@@ -278,14 +306,11 @@ namespace Angaraka::SceneSystem {
     }
 
     void OctreeNode::GetAllEntities(std::vector<Entity*>& results) const {
-        if (IsLeaf()) {
-            results.insert(results.end(), m_entities.begin(), m_entities.end());
-        }
-        else {
-            for (const auto& child : m_children) {
-                if (child) {
-                    child->GetAllEntities(results);
-                }
+        results.insert(results.end(), m_entities.begin(), m_entities.end());
+
+        for (const auto& child : m_children) {
+            if (child) {
+                child->GetAllEntities(results);
             }
         }
     }
@@ -330,43 +355,50 @@ namespace Angaraka::SceneSystem {
         return maxChildDepth;
     }
 
-    void OctreeNode::InsertIntoChildren(Entity* entity) {
-        Math::BoundingBox entityBounds = GetEntityBounds(entity);
-
-        // Check which octants the entity overlaps
-        for (U32 i = 0; i < 8; ++i) {
-            if (m_children[i]) {
-                if (m_children[i]->GetBounds().Intersects(entityBounds)) {
-                    m_children[i]->InsertEntity(entity);
-                }
-            }
+    OctreeNode* OctreeNode::FindContainingChild(const Math::BoundingBox& bounds) const {
+        // Octants do not overlap, so the octant of the center is the only candidate
+        const auto& child = m_children[GetOctantForPoint(bounds.GetCenter())];
+        if (child && child->GetBounds().Contains(bounds)) {
+            return child.get();
         }
+        return nullptr;
     }
 
-    void OctreeNode::CollectFromChildren() {
-        m_entities.clear();
-        for (auto& child : m_children) {
-            if (child) {
-                child->GetAllEntities(m_entities);
-            }
+    void OctreeNode::StoreEntity(Entity* entity, const Math::BoundingBox& bounds, EntityNodeMap& entityToNode) {
+        m_entities.push_back(entity);
+        m_entityBounds.push_back(bounds);
+        entityToNode[entity] = this;
+    }
+
+    void OctreeNode::AdjustSubtreeCount(I32 delta) {
+        for (OctreeNode* node = this; node; node = node->m_parent) {
+            node->m_subtreeCount = static_cast<U32>(static_cast<I32>(node->m_subtreeCount) + delta);
         }
     }
 
-    bool OctreeNode::FitsInOctant(Entity* entity, Octant octant) const {
-        if (!m_children[octant]) return false;
+    void OctreeNode::CollectActiveEntities(std::vector<Entity*>& results, bool renderableOnly) const {
+        for (Entity* entity : m_entities) {
+            if (!entity->IsActive()) continue;
+            if (renderableOnly && !entity->HasComponent<MeshRenderer>()) continue;
+            results.push_back(entity);
+        }
 
-        Math::BoundingBox entityBounds = GetEntityBounds(entity);
-        return m_children[octant]->GetBounds().Contains(entityBounds);
+        for (const auto& child : m_children) {
+            if (child && child->m_subtreeCount > 0) {
+                child->CollectActiveEntities(results, renderableOnly);
+            }
+        }
     }
 
-    Math::BoundingBox OctreeNode::GetEntityBounds(Entity* entity) const {
-        if (auto* renderer = entity->GetComponent<MeshRenderer>()) {
-            return renderer->GetBounds();
-        }
+    void OctreeNode::CollectFromChildren(EntityNodeMap& entityToNode) {
+        for (auto& child : m_children) {
+            if (!child) continue;
 
-        // Fallback to point bounds
-        Math::Vector3 pos = entity->GetTransform().GetWorldPosition();
-        return Math::BoundingBox(pos - Math::Vector3(0.5f), pos + Math::Vector3(0.5f));
+            child->Collapse(entityToNode);
+            for (size_t i = 0; i < child->m_entities.size(); ++i) {
+                StoreEntity(child->m_entities[i], child->m_entityBounds[i], entityToNode);
+            }
+        }
     }
 
     // ================== Octree Implementation ==================
@@ -381,6 +413,12 @@ namespace Angaraka::SceneSystem {
     void Octree::Insert(Entity* entity) {
         if (!entity) return;
 
+        // Already tracked, treat as a move
+        if (m_entityToNode.contains(entity)) {
+            Update(entity);
+            return;
+        }
+
         // Ensure we have a root
         if (!m_root) {
             Math::Vector3 pos = entity->GetTransform().GetWorldPosition();
@@ -391,19 +429,16 @@ namespace Angaraka::SceneSystem {
             m_root = CreateScope<OctreeNode>(m_config.worldBounds, 0);
         }
 
+        Math::BoundingBox entityBounds = ComputeEntityBounds(entity);
+
         // Expand if needed
-        if (m_config.dynamicExpansion) {
-            if (auto* renderer = entity->GetComponent<MeshRenderer>()) {
-                Math::BoundingBox entityBounds = renderer->GetBounds();
-                if (!m_root->GetBounds().Contains(entityBounds)) {
-                    ExpandToInclude(entityBounds);
-                }
-            }
+        if (m_config.dynamicExpansion && !m_root->GetBounds().Contains(entityBounds)) {
+            ExpandToInclude(entityBounds);
         }
 
-        // Find best node and insert
-        OctreeNode* bestNode = FindBestNode(entity, m_root.get());
-        InsertIntoNode(entity, bestNode);
+        // Descends to the deepest node that fully contains the entity; anything
+        // outside the root bounds stays in the root
+        m_root->InsertEntity(entity, entityBounds, m_entityToNode);
     }
 
     void Octree::Remove(Entity* entity) {
@@ -418,13 +453,24 @@ namespace Angaraka::SceneSystem {
     void Octree::Update(Entity* entity) {
         if (!entity) return;
 
-        if (m_batchMode) {
+        if (m_batchDepth > 0) {
             m_pendingUpdates.insert(entity);
+            return;
         }
-        else {
-            Remove(entity);
+
+        auto it = m_entityToNode.find(entity);
+        if (it == m_entityToNode.end()) {
             Insert(entity);
+            return;
+        }
+
+        // Most moves stay within the same node, only refresh the cached bounds then
+        if (it->second->TryUpdateEntityBounds(entity, ComputeEntityBounds(entity))) {
+            return;
         }
+
+        Remove(entity);
+        Insert(entity);
     }
 
     void Octree::Clear() {
@@ -532,8 +578,8 @@ namespace Angaraka::SceneSystem {
     void Octree::Optimize() {
         if (!m_root) return;
 
-        // Collapse empty nodes
-        CollapseEmptyNodes(m_root.get());
+        // Collapse sparse subtrees
+        CollapseSparseNodes(m_root.get());
 
         // Could add more optimizations here
         // - Rebalance tree
@@ -555,9 +601,7 @@ namespace Angaraka::SceneSystem {
         if (!allEntities.empty()) {
             Math::BoundingBox newBounds;
             for (Entity* entity : allEntities) {
-                if (auto* renderer = entity->GetComponent<MeshRenderer>()) {
-                    newBounds.ExpandToInclude(renderer->GetBounds());
-                }
+                newBounds.ExpandToInclude(ComputeEntityBounds(entity));
             }
 
             // Add padding
@@ -585,13 +629,14 @@ namespace Angaraka::SceneSystem {
             allEntities.push_back(pair.first);
         }
 
-        // Create new root with expanded bounds
-        Clear();
+        // Create new root with expanded bounds and re-insert all entities into it directly;
+        // Clear would also drop the updates a batch in progress still has pending
+        m_entityToNode.clear();
         m_config.worldBounds = newBounds;
         m_root = CreateScope<OctreeNode>(m_config.worldBounds, 0);
-
-        // Re-insert all entities
-        InsertMultiple(allEntities);
+        for (Entity* entity : allEntities) {
+            m_root->InsertEntity(entity, ComputeEntityBounds(entity), m_entityToNode);
+        }
     }
 
     Octree::Statistics Octree::GetStatistics() const {
@@ -641,74 +686,41 @@ namespace Angaraka::SceneSystem {
         node->RemoveEntity(entity);
         m_entityToNode.erase(entity);
 
-        // Collapse empty nodes up the tree
-        CollapseEmptyNodes(node);
+        // Fold subtrees that became too sparse back into their parent
+        CollapseSparseAncestors(node);
     }
 
-    void Octree::InsertIntoNode(Entity* entity, OctreeNode* node) {
-        if (!entity || !node) return;
-
-        node->InsertEntity(entity);
-        m_entityToNode[entity] = node;
-    }
-
-    OctreeNode* Octree::FindBestNode(Entity* entity, OctreeNode* start) const {
-        if (!entity || !start) return nullptr;
-
-        // Get entity bounds
-        Math::BoundingBox entityBounds;
-        if (auto* renderer = entity->GetComponent<MeshRenderer>()) {
-            entityBounds = renderer->GetBounds();
-        }
-        else {
-            Math::Vector3 pos = entity->GetTransform().GetWorldPosition();
-            entityBounds = Math::BoundingBox(pos - Math::Vector3(0.1f), pos + Math::Vector3(0.1f));
-        }
-
-        // Find deepest node that fully contains the entity
-        OctreeNode* current = start;
-        while (!current->IsLeaf()) {
-            bool foundChild = false;
-
-            // Check if entity fits entirely in one child
-            for (U32 i = 0; i < 8; ++i) {
-                if (auto* child = current->GetChild(static_cast<OctreeNode::Octant>(i))) {
-                    if (child->GetBounds().Contains(entityBounds)) {
-                        current = child;
-                        foundChild = true;
-                        break;
-                    }
-                }
-            }
-
-            if (!foundChild) {
-                break; // Entity spans multiple children, stay at current level
+    void Octree::CollapseSparseAncestors(OctreeNode* node) {
+        // Collapse at the highest ancestor that qualifies so the tree shrinks in one step
+        OctreeNode* highest = nullptr;
+        for (OctreeNode* current = node; current; current = current->GetParent()) {
+            if (current->ShouldCollapse()) {
+                highest = current;
             }
         }
 
-        return current;
+        if (highest) {
+            highest->Collapse(m_entityToNode);
+        }
     }
 
-    void Octree::CollapseEmptyNodes(OctreeNode* node) {
+    void Octree::CollapseSparseNodes(OctreeNode* node) {
         if (!node || node->IsLeaf()) return;
 
-        // Check if all children are empty leaves
-        bool allChildrenEmpty = true;
-        for (U32 i = 0; i < 8; ++i) {
-            auto* child = node->GetChild(static_cast<OctreeNode::Octant>(i));
-            if (child && (!child->IsLeaf() || child->GetEntityCount() > 0)) {
-                allChildrenEmpty = false;
-                break;
-            }
+        if (node->ShouldCollapse()) {
+            node->Collapse(m_entityToNode);
+            return;
         }
 
-        if (allChildrenEmpty) {
-            node->Collapse();
+        for (U32 i = 0; i < 8; ++i) {
+            CollapseSparseNodes(node->GetChild(static_cast<OctreeNode::Octant>(i)));
         }
     }
 
     void Octree::EndBatchUpdate() {
-        m_batchMode = false;
+        if (m_batchDepth == 0 || --m_batchDepth > 0) {
+            return;
+        }
 
         // Process all pending updates
         for (Entity* entity : m_pendingUpdates) {
@@ -2,26 +2,54 @@ module;
 
 #include "Angaraka/Base.hpp"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <chrono>
+#include <cmath>
+#include <limits>
 
 module Angaraka.Scene;
 
 import Angaraka.Scene.Component;
 import Angaraka.Core.ResourceCache;
 import Angaraka.Graphics.DirectX12;
+import Angaraka.Graphics.InstanceBatcher;
+import Angaraka.Graphics.RenderCommands;
 import Angaraka.Scene.Components.MeshRenderer;
+import Angaraka.Scene.Octree;
+import Angaraka.Scene.LinearBVH;
+import Angaraka.Scene.TransformSystem;
 
 import Angaraka.Math;
 import Angaraka.Math.Vector3;
 import Angaraka.Math.Quaternion;
+import Angaraka.Math.BoundingBox;
 
 namespace Angaraka::SceneSystem {
 
+    namespace {
+
+        constexpr U32 SORT_LAYER_BITS = 8;
+        constexpr U32 SORT_DEPTH_BITS = 24;
+        constexpr U32 SORT_MESH_BITS = 30;
+        constexpr size_t RADIX_SORT_MIN_ENTRIES = 64;   // Below this a comparison sort is faster
+
+        // Non-negative floats order like their bit patterns. The top bits keep the exponent and
+        // 15 mantissa bits, a relative depth precision of about 0.003% at any range.
+        U64 QuantizeDepth(F32 distance) {
+            return std::bit_cast<U32>(std::max(distance, 0.0f)) >> (32 - SORT_DEPTH_BITS);
+        }
+
+    } // anonymous namespace
+
     // ================== Scene Implementation ==================
 
     Scene::Scene(Angaraka::Core::CachedResourceManager* resourceManager, Angaraka::DirectX12GraphicsSystem* graphicsSystem)
         : m_resourceManager(resourceManager)
-        , m_graphicsSystem(graphicsSystem) {
+        , m_graphicsSystem(graphicsSystem)
+        , m_octree(CreateScope<Octree>())
+        , m_bvh(CreateScope<LinearBVH>())
+        , m_transformSystem(CreateScope<TransformSystem>()) {
         AGK_ASSERT(resourceManager, "Scene: ResourceManager cannot be null!");
         AGK_ASSERT(graphicsSystem, "Scene: GraphicsSystem cannot be null!");
 
@@ -49,6 +77,16 @@ namespace Angaraka::SceneSystem {
 
         // Register transform mapping
         RegisterTransformMapping(&entityPtr->GetTransform(), entityPtr);
+        if (m_transformSystemEnabled) {
+            entityPtr->GetTransform().AttachToSystem(m_transformSystem.get());
+        }
+
+        // Keep the octree in sync with transform and component changes
+        entityPtr->m_onSpatialChanged = [this](Entity* changed) { MarkSpatialDirty(changed); };
+        MarkSpatialDirty(entityPtr);
+        if (m_spatialQueryMode == SpatialQueryMode::LinearBVH) {
+            m_bvhRebuildPending = true;
+        }
 
         // Store entity
         m_entities[id] = std::move(entity);
@@ -135,6 +173,14 @@ namespace Angaraka::SceneSystem {
         // Remove from transform mapping
         UnregisterTransformMapping(&entity->GetTransform());
 
+        // Remove from spatial index
+        entity->m_onSpatialChanged = nullptr;
+        m_spatialDirty.erase(entity);
+        m_octree->Remove(entity);
+        if (m_spatialQueryMode == SpatialQueryMode::LinearBVH) {
+            m_bvhRebuildPending = true;
+        }
+
         // Remove from name mapping
         auto nameIt = m_nameToEntities.find(name);
         if (nameIt != m_nameToEntities.end()) {
@@ -240,27 +286,51 @@ namespace Angaraka::SceneSystem {
 
     void Scene::GetVisibleEntities(const Math::Frustum& frustum,
         std::vector<Entity*>& outEntities) const {
-        // TODO: Use spatial acceleration structure (octree) when implemented
-        // For now, brute force check all entities
+        size_t firstResult = outEntities.size();
 
-        for (const auto& [id, entity] : m_entities) {
-            if (!entity->IsActive()) {
-                continue;
-            }
+        if (m_spatialQueryMode == SpatialQueryMode::Octree) {
+            FlushSpatialUpdates();
+            m_octree->Query(frustum, outEntities);
+        }
+        else if (m_spatialQueryMode == SpatialQueryMode::LinearBVH) {
+            FlushSpatialUpdates();
+            m_bvh->Query(frustum, outEntities);
+        }
+        else {
+            for (const auto& [id, entity] : m_entities) {
+                if (!entity->IsActive()) {
+                    continue;
+                }
 
-            // TODO: Get bounding box from MeshRenderer component
-            // For now, just add all active entities
-            outEntities.push_back(entity.get());
+                const MeshRenderer* meshRenderer = entity->GetComponent<MeshRenderer>();
+                if (meshRenderer && meshRenderer->IsVisibleInFrustum(frustum)) {
+                    outEntities.push_back(entity.get());
+                }
+            }
         }
 
         if (m_collectStatistics) {
-            m_statistics.visibleEntities = static_cast<U32>(outEntities.size());
-            m_statistics.culledEntities = m_statistics.activeEntities - m_statistics.visibleEntities;
+            m_statistics.visibleEntities = static_cast<U32>(outEntities.size() - firstResult);
+            // activeEntities is only recounted by UpdateStatistics, and the octree returns inactive
+            // entities too, so visible can exceed it; clamp instead of wrapping around
+            m_statistics.culledEntities = m_statistics.activeEntities > m_statistics.visibleEntities
+                ? m_statistics.activeEntities - m_statistics.visibleEntities : 0;
         }
     }
 
     void Scene::GetEntitiesInRadius(const Math::Vector3& center, F32 radius,
         std::vector<Entity*>& outEntities) const {
+        if (m_spatialQueryMode == SpatialQueryMode::Octree) {
+            FlushSpatialUpdates();
+            m_octree->Query(center, radius, outEntities);
+            return;
+        }
+        if (m_spatialQueryMode == SpatialQueryMode::LinearBVH) {
+            FlushSpatialUpdates();
+            m_bvh->Query(center, radius, outEntities);
+            return;
+        }
+
         F32 radiusSq = radius * radius;
 
         for (const auto& [id, entity] : m_entities) {
@@ -279,14 +349,23 @@ namespace Angaraka::SceneSystem {
 
     void Scene::GetEntitiesInBounds(const Math::BoundingBox& bounds,
         std::vector<Entity*>& outEntities) const {
+        if (m_spatialQueryMode == SpatialQueryMode::Octree) {
+            FlushSpatialUpdates();
+            m_octree->Query(bounds, outEntities);
+            return;
+        }
+        if (m_spatialQueryMode == SpatialQueryMode::LinearBVH) {
+            FlushSpatialUpdates();
+            m_bvh->Query(bounds, outEntities);
+            return;
+        }
+
         for (const auto& [id, entity] : m_entities) {
             if (!entity->IsActive()) {
                 continue;
             }
 
-            // TODO: Get bounding box from MeshRenderer component
-            Math::Vector3 pos = entity->GetTransform().GetWorldPosition();
-            if (bounds.Contains(pos)) {
+            if (bounds.Intersects(ComputeEntityBounds(entity.get()))) {
                 outEntities.push_back(entity.get());
             }
         }
@@ -298,11 +377,8 @@ namespace Angaraka::SceneSystem {
         RaycastAll(ray, maxDistance, layerMask, hits);
 
         if (!hits.empty()) {
-            // Return closest hit
-            outHit = *std::min_element(hits.begin(), hits.end(),
-                [](const RaycastHit& a, const RaycastHit& b) {
-                    return a.distance < b.distance;
-                });
+            // Hits are sorted, closest first
+            outHit = hits.front();
             return true;
         }
 
@@ -311,9 +387,143 @@ namespace Angaraka::SceneSystem {
 
     void Scene::RaycastAll(const Math::Ray& ray, F32 maxDistance, U32 layerMask,
         std::vector<RaycastHit>& outHits) const {
-        // TODO: Implement proper raycasting against colliders
-        // For now, this is a placeholder
-        AGK_WARN("Scene::RaycastAll not fully implemented - requires collider components");
+        // NOTE: Tests against entity world bounds until collider components exist
+        std::vector<Entity*> candidates;
+
+        if (m_spatialQueryMode == SpatialQueryMode::Octree) {
+            FlushSpatialUpdates();
+            m_octree->QueryRay(ray, maxDistance, candidates);
+        }
+        else if (m_spatialQueryMode == SpatialQueryMode::LinearBVH) {
+            FlushSpatialUpdates();
+            m_bvh->QueryRay(ray, maxDistance, candidates);
+        }
+        else {
+            candidates.reserve(m_entities.size());
+            for (const auto& [id, entity] : m_entities) {
+                if (entity->IsActive()) {
+                    candidates.push_back(entity.get());
+                }
+            }
+        }
+
+        size_t firstHit = outHits.size();
+
+        for (Entity* entity : candidates) {
+            U32 layer = entity->GetLayer();
+            if (layer >= 32 || (layerMask & (1u << layer)) == 0) {
+                continue;
+            }
+
+            Math::BoundingBox bounds = ComputeEntityBounds(entity);
+            F32 tMin, tMax;
+            if (!bounds.IntersectsRay(ray.origin, ray.direction, tMin, tMax) || tMin > maxDistance) {
+                continue;
+            }
+
+            RaycastHit hit;
+            hit.entity = entity;
+            hit.component = entity->GetComponent<MeshRenderer>();
+            hit.distance = tMin;
+            hit.point = ray.GetPoint(tMin);
+
+            // Normal of the box face closest to the hit point
+            Math::Vector3 local = hit.point - bounds.GetCenter();
+            Math::Vector3 halfExtents = bounds.GetHalfExtents();
+            F32 bestDistance = std::numeric_limits<F32>::max();
+            for (size_t axis = 0; axis < 3; ++axis) {
+                F32 faceDistance = std::abs(halfExtents[axis] - std::abs(local[axis]));
+                if (faceDistance < bestDistance) {
+                    bestDistance = faceDistance;
+                    hit.normal = Math::Vector3(0.0f, 0.0f, 0.0f);
+                    hit.normal[axis] = local[axis] < 0.0f ? -1.0f : 1.0f;
+                }
+            }
+
+            outHits.push_back(hit);
+        }
+
+        std::sort(outHits.begin() + firstHit, outHits.end(),
+            [](const RaycastHit& a, const RaycastHit& b) {
+                return a.distance < b.distance;
+            });
+    }
+
+    void Scene::SetSpatialQueryMode(SpatialQueryMode mode) {
+        if (m_spatialQueryMode == mode) {
+            return;
+        }
+
+        m_spatialQueryMode = mode;
+        m_spatialDirty.clear();
+        m_octree->Clear();
+        m_bvh->Clear();
+        m_bvhRebuildPending = false;
+
+        if (mode == SpatialQueryMode::Octree) {
+            std::vector<Entity*> entities;
+            entities.reserve(m_entities.size());
+            for (const auto& [id, entity] : m_entities) {
+                entities.push_back(entity.get());
+            }
+            m_octree->InsertMultiple(entities);
+        }
+        else if (mode == SpatialQueryMode::LinearBVH) {
+            RebuildLinearBVH();
+        }
+
+        static constexpr const char* modeNames[] = { "linear scans", "the octree", "the linear BVH" };
+        AGK_INFO("Scene: Spatial queries for '{}' now use {}", m_name, modeNames[static_cast<size_t>(mode)]);
+    }
+
+    void Scene::SetTransformSystemEnabled(bool enabled) {
+        if (m_transformSystemEnabled == enabled) {
+            return;
+        }
+
+        m_transformSystemEnabled = enabled;
+
+        // Parents have to be attached before and detached after their children
+        std::vector<std::pair<size_t, SceneTransform*>> transforms;
+        transforms.reserve(m_entities.size());
+        for (const auto& [id, entity] : m_entities) {
+            transforms.emplace_back(entity->GetTransform().GetDepth(), &entity->GetTransform());
+        }
+
+        if (enabled) {
+            std::sort(transforms.begin(), transforms.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+            for (const auto& [depth, transform] : transforms) {
+                transform->AttachToSystem(m_transformSystem.get());
+            }
+            m_transformSystem->Update();
+        }
+        else {
+            std::sort(transforms.begin(), transforms.end(),
+                [](const auto& a, const auto& b) { return a.first > b.first; });
+            for (const auto& [depth, transform] : transforms) {
+                transform->DetachFromSystem();
+            }
+        }
+
+        AGK_INFO("Scene: Transform system {} for '{}' ({} transforms)",
+            enabled ? "enabled" : "disabled", m_name, transforms.size());
+    }
+
+    void Scene::UpdateTransforms() {
+        if (m_transformSystemEnabled) {
+            m_transformSystem->Update();
+        }
+    }
+
+    const Octree& Scene::GetOctree() const {
+        FlushSpatialUpdates();
+        return *m_octree;
+    }
+
+    const LinearBVH& Scene::GetLinearBVH() const {
+        FlushSpatialUpdates();
+        return *m_bvh;
     }
 
     // ================== Scene Lifecycle ==================
@@ -344,6 +554,9 @@ namespace Angaraka::SceneSystem {
             }
         }
 
+        // One hierarchy pass for everything that moved this frame
+        UpdateTransforms();
+
         if (m_collectStatistics) {
             auto endTime = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -380,10 +593,10 @@ namespace Angaraka::SceneSystem {
         }
 
         // Collect visible renderables
-        CollectRenderables(frustum);
+        CollectRenderables(cameraPosition, frustum);
 
         // Sort render queues
-        SortRenderQueues(cameraPosition);
+        SortRenderQueues();
 
         if (m_collectStatistics) {
             auto endTime = std::chrono::high_resolution_clock::now();
@@ -399,6 +612,64 @@ namespace Angaraka::SceneSystem {
         return m_renderQueues[index];
     }
 
+    U64 Scene::MakeRenderSortKey(RenderQueueType queue, U32 layer, F32 distanceToCamera, const void* mesh) {
+        U64 depth = QuantizeDepth(distanceToCamera);
+        if (queue == RenderQueueType::Transparent) {
+            depth = ((1ull << SORT_DEPTH_BITS) - 1) - depth;
+        }
+
+        // Only groups equal meshes at equal depth, so a truncated address is enough
+        const U64 meshId = (reinterpret_cast<uintptr_t>(mesh) >> 4) & ((1ull << SORT_MESH_BITS) - 1);
+        const U64 clampedLayer = std::min<U32>(layer, (1u << SORT_LAYER_BITS) - 1);
+
+        return (static_cast<U64>(queue) << (SORT_LAYER_BITS + SORT_DEPTH_BITS + SORT_MESH_BITS))
+            | (clampedLayer << (SORT_DEPTH_BITS + SORT_MESH_BITS))
+            | (depth << SORT_MESH_BITS)
+            | meshId;
+    }
+
+    // Stable LSD radix sort on sortKey, one byte per pass. Passes where every key has the
+    // same byte are skipped, so keys that only differ in a few bytes cost a few passes.
+    void Scene::SortRenderQueue(std::vector<RenderEntry>& entries, std::vector<RenderEntry>& scratch) {
+        const size_t count = entries.size();
+        if (count < RADIX_SORT_MIN_ENTRIES) {
+            std::stable_sort(entries.begin(), entries.end(),
+                [](const RenderEntry& a, const RenderEntry& b) { return a.sortKey < b.sortKey; });
+            return;
+        }
+
+        // One read of the keys builds the histograms of all passes
+        constexpr size_t PASSES = sizeof(U64);
+        std::array<std::array<U32, 256>, PASSES> histograms{};
+        for (const RenderEntry& entry : entries) {
+            for (size_t pass = 0; pass < PASSES; ++pass) {
+                ++histograms[pass][(entry.sortKey >> (pass * 8)) & 0xFF];
+            }
+        }
+
+        scratch.resize(count);
+        for (size_t pass = 0; pass < PASSES; ++pass) {
+            auto& histogram = histograms[pass];
+            const size_t shift = pass * 8;
+            if (histogram[(entries[0].sortKey >> shift) & 0xFF] == count) {
+                continue;
+            }
+
+            // Exclusive prefix sum turns counts into the first slot of each byte value
+            U32 offset = 0;
+            for (U32& bucket : histogram) {
+                const U32 bucketCount = bucket;
+                bucket = offset;
+                offset += bucketCount;
+            }
+
+            for (const RenderEntry& entry : entries) {
+                scratch[histogram[(entry.sortKey >> shift) & 0xFF]++] = entry;
+            }
+            entries.swap(scratch);
+        }
+    }
+
     // ================== Scene Management ==================
 
     void Scene::Clear() {
@@ -414,6 +685,12 @@ namespace Angaraka::SceneSystem {
         m_tagToEntities.clear();
         m_transformToEntity.clear();
 
+        // Clear spatial index
+        m_octree->Clear();
+        m_bvh->Clear();
+        m_spatialDirty.clear();
+        m_bvhRebuildPending = false;
+
         // Clear render queues
         for (auto& queue : m_renderQueues) {
             queue.clear();
@@ -445,114 +722,141 @@ namespace Angaraka::SceneSystem {
 
     // ================== Private Helper Methods ==================
 
-    void Scene::CollectRenderables(const Math::Frustum& frustum) {
-        for (auto& [id, entity] : m_entities) {
-            if (!entity->IsActive()) {
+    void Scene::CollectRenderables(const Math::Vector3& cameraPosition, const Math::Frustum& frustum) {
+        m_visibleEntities.clear();
+        GetVisibleEntities(frustum, m_visibleEntities);
+
+        for (Entity* entity : m_visibleEntities) {
+            // Visible entities always have a MeshRenderer, skip disabled ones
+            MeshRenderer* meshRenderer = entity->GetComponent<MeshRenderer>();
+            if (!meshRenderer->IsEnabled()) {
                 continue;
             }
 
-            // Check if entity has a MeshRenderer component
-            if (MeshRenderer* meshRenderer = entity->GetComponent<MeshRenderer>()) {
-                // Check if mesh renderer is enabled
-                if (!meshRenderer->IsEnabled()) {
-                    continue;
-                }
+            // For now, assume all meshes are opaque
+            // TODO: Check material properties to determine queue
+            constexpr RenderQueueType queue = RenderQueueType::Opaque;
 
-                // Frustum culling
-                if (!meshRenderer->IsVisibleInFrustum(frustum)) {
-                    if (m_collectStatistics) {
-                        m_statistics.culledEntities++;
-                    }
-                    continue;
-                }
+            // The world position is read once here, sorting only compares the packed keys
+            RenderEntry entry;
+            entry.entity = entity;
+            entry.renderOrder = meshRenderer->GetRenderLayer();
+            entry.distanceToCamera = (entity->GetTransform().GetWorldPosition() - cameraPosition).Length();
+            entry.sortKey = MakeRenderSortKey(queue, entry.renderOrder, entry.distanceToCamera, meshRenderer->GetMeshResource());
 
-                // Add to appropriate render queue
-                RenderEntry entry;
-                entry.entity = entity.get();
-                entry.renderOrder = meshRenderer->GetRenderLayer();
-
-                // For now, assume all meshes are opaque
-                // TODO: Check material properties to determine queue
-                m_renderQueues[static_cast<size_t>(RenderQueueType::Opaque)].push_back(entry);
-            }
+            m_renderQueues[static_cast<size_t>(queue)].push_back(entry);
         }
     }
 
-    void Scene::ExecuteRendering(DirectX12GraphicsSystem* renderer) {
-        if (!renderer) {
-            AGK_ERROR("Scene::ExecuteRendering - Renderer is null!");
-            return;
-        }
-
-        auto startTime = std::chrono::high_resolution_clock::now();
-
-        // Render each queue in order
+    void Scene::RecordRenderCommands(Graphics::RenderCommandBuffer& commands) {
+        // Queues and layers are drawn in order. Within an opaque layer every entity with the same
+        // mesh joins one instanced draw; the other queues only merge neighbours so blending and
+        // overlay order are kept.
+        m_instanceBatcher.Reset();
         for (size_t i = 0; i < static_cast<size_t>(RenderQueueType::Count); ++i) {
             const auto& queue = m_renderQueues[i];
+            const Graphics::BatchOrder order = i == static_cast<size_t>(RenderQueueType::Opaque)
+                ? Graphics::BatchOrder::Grouped
+                : Graphics::BatchOrder::Preserve;
 
+            U32 layer = queue.empty() ? 0 : queue.front().renderOrder;
             for (const RenderEntry& entry : queue) {
-                Entity* entity = entry.entity;
-
-                // Get MeshRenderer component
-                if (MeshRenderer* meshRenderer = entity->GetComponent<MeshRenderer>()) {
-                    // Get mesh resource
-                    if (Core::Resource* meshResource = meshRenderer->GetMeshResource()) {
-                        // Get world transform matrix
-                        Math::Matrix4x4 worldMatrix = entity->GetTransform().GetWorldMatrix();
-
-                        // Call the renderer
-                        renderer->RenderMesh(meshResource, worldMatrix);
-                    }
+                if (entry.renderOrder != layer) {
+                    m_instanceBatcher.Flush(order);
+                    layer = entry.renderOrder;
+                }
+
+                // Collection only queues entities with a MeshRenderer
+                MeshRenderer* meshRenderer = entry.entity->GetComponent<MeshRenderer>();
+                if (Core::Resource* meshResource = meshRenderer->GetMeshResource()) {
+                    // No materials yet, batches are split by mesh only
+                    m_instanceBatcher.Add(meshResource, nullptr, entry.entity->GetTransform().GetWorldMatrix());
                 }
             }
+            m_instanceBatcher.Flush(order);
+        }
+
+        // Every queue uses the default pipeline until materials select their own
+        commands.BindPipeline(Graphics::DEFAULT_PIPELINE);
+        commands.AddBatches(m_instanceBatcher);
+    }
+
+    void Scene::ExecuteRendering(Graphics::RenderCommandExecutor* executor) {
+        if (!executor) {
+            AGK_ERROR("Scene::ExecuteRendering - Executor is null!");
+            return;
         }
 
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        m_renderCommands.Reset();
+        RecordRenderCommands(m_renderCommands);
+        executor->Execute(m_renderCommands);
+
         if (m_collectStatistics) {
             auto endTime = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
                 endTime - startTime);
             m_statistics.renderTimeMs = duration.count() / 1000.0f;
+            m_statistics.drawCalls = m_renderCommands.GetDrawCount();
         }
     }
 
-    void Scene::SortRenderQueues(const Math::Vector3& cameraPosition) {
-        // Sort opaque queue (front to back for early Z rejection)
-        auto& opaqueQueue = m_renderQueues[static_cast<size_t>(RenderQueueType::Opaque)];
-        std::sort(opaqueQueue.begin(), opaqueQueue.end(),
-            [&cameraPosition](const RenderEntry& a, const RenderEntry& b) {
-                // First sort by render order (layer)
-                if (a.renderOrder != b.renderOrder) {
-                    return a.renderOrder < b.renderOrder;
-                }
+    void Scene::SortRenderQueues() {
+        // Layer order and direction are in the keys: opaque front to back for early Z rejection,
+        // transparent back to front for proper blending
+        SortRenderQueue(m_renderQueues[static_cast<size_t>(RenderQueueType::Opaque)], m_sortScratch);
+        SortRenderQueue(m_renderQueues[static_cast<size_t>(RenderQueueType::Transparent)], m_sortScratch);
+    }
 
-                // Then sort by distance (front to back)
-                F32 distA = (a.entity->GetTransform().GetWorldPosition() - cameraPosition).LengthSquared();
-                F32 distB = (b.entity->GetTransform().GetWorldPosition() - cameraPosition).LengthSquared();
-                return distA < distB;
-            });
+    void Scene::MarkSpatialDirty(Entity* entity) {
+        // Only tracked while a spatial structure is in use; switching modes rebuilds it from scratch
+        if (m_spatialQueryMode != SpatialQueryMode::Linear) {
+            m_spatialDirty.insert(entity);
+        }
+    }
 
-        // Sort transparent queue (back to front for proper blending)
-        auto& transparentQueue = m_renderQueues[static_cast<size_t>(RenderQueueType::Transparent)];
-        std::sort(transparentQueue.begin(), transparentQueue.end(),
-            [&cameraPosition](const RenderEntry& a, const RenderEntry& b) {
-                // First sort by render order (layer)
-                if (a.renderOrder != b.renderOrder) {
-                    return a.renderOrder < b.renderOrder;
+    void Scene::FlushSpatialUpdates() const {
+        // Children moved by a deferred hierarchy change are notified (and marked dirty) here
+        if (m_transformSystemEnabled) {
+            m_transformSystem->Update();
+        }
+
+        if (m_spatialQueryMode == SpatialQueryMode::LinearBVH) {
+            // Refitting keeps the topology, once a large share has moved a rebuild gives tighter nodes
+            if (m_bvhRebuildPending || m_spatialDirty.size() * 4 > m_bvh->GetEntityCount()) {
+                RebuildLinearBVH();
+            }
+            else if (!m_spatialDirty.empty()) {
+                for (Entity* entity : m_spatialDirty) {
+                    m_bvh->UpdateBounds(entity);
                 }
+                m_bvh->Refit();
+            }
+            m_spatialDirty.clear();
+            return;
+        }
 
-                // Then sort by distance (back to front)
-                F32 distA = (a.entity->GetTransform().GetWorldPosition() - cameraPosition).LengthSquared();
-                F32 distB = (b.entity->GetTransform().GetWorldPosition() - cameraPosition).LengthSquared();
-                return distA > distB;
-            });
+        if (m_spatialDirty.empty()) {
+            return;
+        }
 
-        // Update distances in entries
-        for (auto& queue : m_renderQueues) {
-            for (auto& entry : queue) {
-                entry.distanceToCamera = (entry.entity->GetTransform().GetWorldPosition()
-                    - cameraPosition).Length();
-            }
+        // Entities that stay inside their node only refresh their cached bounds
+        for (Entity* entity : m_spatialDirty) {
+            m_octree->Update(entity);
         }
+        m_spatialDirty.clear();
+    }
+
+    void Scene::RebuildLinearBVH() const {
+        std::vector<Entity*> entities;
+        entities.reserve(m_entities.size());
+        for (const auto& [id, entity] : m_entities) {
+            entities.push_back(entity.get());
+        }
+
+        m_bvh->Build(entities);
+        m_bvhRebuildPending = false;
     }
 
     void Scene::UpdateStatistics() {
@@ -6,6 +6,8 @@ module;
 
 module Angaraka.Scene.Transform;
 
+import Angaraka.Scene.TransformSystem;
+
 namespace Angaraka::SceneSystem {
 
     SceneTransform::SceneTransform()
@@ -27,15 +29,27 @@ namespace Angaraka::SceneSystem {
             if (m_parent) {
                 m_parent->m_children.push_back(child);
             }
+            if (child->m_system) {
+                child->m_system->SetParent(child->m_handle, m_parent ? m_parent->m_handle : InvalidTransformHandle);
+            }
         }
         m_children.clear();
+
+        if (m_system) {
+            m_system->Unregister(m_handle);
+        }
     }
 
     // ================== Local Transform ==================
 
     void SceneTransform::SetLocalPosition(const Math::Vector3& position) {
-        if (m_localTransform.position != position) {
-            m_localTransform.position = position;
+        if (GetLocalPosition() != position) {
+            if (m_system) {
+                m_system->SetLocalPosition(m_handle, position);
+            }
+            else {
+                m_localTransform.position = position;
+            }
             MarkLocalDirty();
         }
     }
@@ -45,8 +59,13 @@ namespace Angaraka::SceneSystem {
     }
 
     void SceneTransform::SetLocalRotation(const Math::Quaternion& rotation) {
-        if (m_localTransform.rotation != rotation) {
-            m_localTransform.rotation = rotation;
+        if (GetLocalRotation() != rotation) {
+            if (m_system) {
+                m_system->SetLocalRotation(m_handle, rotation);
+            }
+            else {
+                m_localTransform.rotation = rotation;
+            }
             MarkLocalDirty();
         }
     }
@@ -64,8 +83,13 @@ namespace Angaraka::SceneSystem {
     }
 
     void SceneTransform::SetLocalScale(const Math::Vector3& scale) {
-        if (m_localTransform.scale != scale) {
-            m_localTransform.scale = scale;
+        if (GetLocalScale() != scale) {
+            if (m_system) {
+                m_system->SetLocalScale(m_handle, scale);
+            }
+            else {
+                m_localTransform.scale = scale;
+            }
             MarkLocalDirty();
         }
     }
@@ -78,11 +102,18 @@ namespace Angaraka::SceneSystem {
         SetLocalScale(Math::Vector3(x, y, z));
     }
 
+    Math::Transform SceneTransform::GetLocalTransform() const {
+        if (m_system) {
+            return Math::Transform(GetLocalPosition(), GetLocalRotation(), GetLocalScale());
+        }
+        return m_localTransform;
+    }
+
     void SceneTransform::SetLocalTransform(const Math::Transform& transform) {
-        if (m_localTransform.position != transform.position ||
-            m_localTransform.rotation != transform.rotation ||
-            m_localTransform.scale != transform.scale) {
-            m_localTransform = transform;
+        if (GetLocalPosition() != transform.position ||
+            GetLocalRotation() != transform.rotation ||
+            GetLocalScale() != transform.scale) {
+            WriteLocalTransform(transform);
             MarkLocalDirty();
         }
     }
@@ -141,19 +172,19 @@ namespace Angaraka::SceneSystem {
     }
 
     Math::Transform SceneTransform::GetWorldTransform() const {
-        if (m_worldDirty) {
-            UpdateWorldMatrix();
-        }
-
         // Decompose world matrix back to transform
         Math::Transform worldTransform;
-        m_worldMatrix.Decompose(worldTransform.position, worldTransform.rotation, worldTransform.scale);
+        GetWorldMatrix().Decompose(worldTransform.position, worldTransform.rotation, worldTransform.scale);
         return worldTransform;
     }
 
     // ================== Matrix Access ==================
 
     const Math::Matrix4x4& SceneTransform::GetLocalMatrix() const {
+        if (m_system) {
+            return m_system->GetLocalMatrix(m_handle);
+        }
+
         if (m_localDirty) {
             UpdateLocalMatrix();
         }
@@ -161,6 +192,10 @@ namespace Angaraka::SceneSystem {
     }
 
     const Math::Matrix4x4& SceneTransform::GetWorldMatrix() const {
+        if (m_system) {
+            return m_system->GetWorldMatrix(m_handle);
+        }
+
         if (m_worldDirty) {
             UpdateWorldMatrix();
         }
@@ -168,6 +203,15 @@ namespace Angaraka::SceneSystem {
     }
 
     const Math::Matrix4x4& SceneTransform::GetWorldToLocalMatrix() const {
+        if (m_system) {
+            U32 version = m_system->GetWorldVersion(m_handle);
+            if (version != m_worldToLocalVersion) {
+                m_worldToLocalMatrix = m_system->GetWorldMatrix(m_handle).Inverted();
+                m_worldToLocalVersion = version;
+            }
+            return m_worldToLocalMatrix;
+        }
+
         if (m_worldDirty) {
             UpdateWorldMatrix();
             UpdateWorldToLocalMatrix();
@@ -183,11 +227,16 @@ namespace Angaraka::SceneSystem {
             return;
         }
 
-        if (parent && IsChildOf(parent)) {
+        if (parent && parent->IsChildOf(this)) {
             AGK_ERROR("SceneTransform: Cannot set child as parent (would create cycle)!");
             return;
         }
 
+        if (parent && parent->m_system != m_system) {
+            AGK_ERROR("SceneTransform: Parent belongs to a different transform system!");
+            return;
+        }
+
         // Store world transform if needed
         Math::Transform worldTransform;
         if (worldPositionStays) {
@@ -207,16 +256,20 @@ namespace Angaraka::SceneSystem {
             m_parent->AddChild(this);
         }
 
+        if (m_system) {
+            m_system->SetParent(m_handle, m_parent ? m_parent->m_handle : InvalidTransformHandle);
+        }
+
         // Restore world transform if needed
         if (worldPositionStays) {
             if (m_parent) {
                 // Convert world transform to local space of new parent
                 Math::Transform parentWorld = m_parent->GetWorldTransform();
                 Math::Transform parentWorldInv = parentWorld.Inverted();
-                m_localTransform = parentWorldInv * worldTransform;
+                WriteLocalTransform(parentWorldInv * worldTransform);
             }
             else {
-                m_localTransform = worldTransform;
+                WriteLocalTransform(worldTransform);
             }
             MarkLocalDirty();
         }
@@ -383,9 +436,60 @@ namespace Angaraka::SceneSystem {
     // ================== Change Notification ==================
 
     void SceneTransform::SetDirty() {
+        if (m_system) {
+            m_system->SetDirty(m_handle);
+        }
         MarkLocalDirty();
     }
 
+    bool SceneTransform::IsDirty() const {
+        if (m_system) {
+            return m_system->IsDirty(m_handle);
+        }
+        return m_localDirty || m_worldDirty;
+    }
+
+    // ================== Transform System ==================
+
+    bool SceneTransform::AttachToSystem(TransformSystem* system) {
+        if (m_system == system) {
+            return true;
+        }
+
+        if (!system) {
+            DetachFromSystem();
+            return true;
+        }
+
+        if (m_parent && m_parent->m_system != system) {
+            AGK_ERROR("SceneTransform: Attach the parent of '{}' to the transform system first!", m_name);
+            return false;
+        }
+
+        Math::Transform local = GetLocalTransform();
+        DetachFromSystem();
+
+        m_handle = system->Register(this, local, m_parent ? m_parent->m_handle : InvalidTransformHandle);
+        m_system = system;
+        m_worldToLocalVersion = 0;
+        return true;
+    }
+
+    void SceneTransform::DetachFromSystem() {
+        if (!m_system) {
+            return;
+        }
+
+        m_localTransform = GetLocalTransform();
+        m_system->Unregister(m_handle);
+        m_system = nullptr;
+        m_handle = InvalidTransformHandle;
+
+        // Our own caches were not maintained while attached
+        m_localDirty = true;
+        m_worldDirty = true;
+    }
+
     // ================== Internal Methods ==================
 
     void SceneTransform::AddChild(SceneTransform* child) {
@@ -401,12 +505,35 @@ namespace Angaraka::SceneSystem {
         }
     }
 
+    void SceneTransform::WriteLocalTransform(const Math::Transform& transform) {
+        if (m_system) {
+            m_system->SetLocalPosition(m_handle, transform.position);
+            m_system->SetLocalRotation(m_handle, transform.rotation);
+            m_system->SetLocalScale(m_handle, transform.scale);
+        }
+        else {
+            m_localTransform = transform;
+        }
+    }
+
     void SceneTransform::MarkLocalDirty() {
+        if (m_system) {
+            // The setter already flagged the slot, descendants follow in the system's next update
+            NotifyTransformChanged();
+            return;
+        }
+
         m_localDirty = true;
         MarkWorldDirty();
     }
 
     void SceneTransform::MarkWorldDirty() {
+        if (m_system) {
+            m_system->MarkWorldDirty(m_handle);
+            NotifyTransformChanged();
+            return;
+        }
+
         m_worldDirty = true;
         PropagateWorldDirty();
         NotifyTransformChanged();
@@ -443,4 +570,8 @@ namespace Angaraka::SceneSystem {
         }
     }
 
+    void SceneTransform::OnWorldChangedBySystem() {
+        NotifyTransformChanged();
+    }
+
 } // namespace Angaraka::Scene
\ No newline at end of file
@@ -0,0 +1,455 @@
+module;
+
+#include "Angaraka/Base.hpp"
+#include "Angaraka/JobSystem.hpp"
+#include <algorithm>
+#include <span>
+
+module Angaraka.Scene.TransformSystem;
+
+import Angaraka.Scene.Transform;
+import Angaraka.Math.Batch;
+
+namespace Angaraka::SceneSystem {
+
+    // ================== Registration ==================
+
+    TransformHandle TransformSystem::Register(SceneTransform* owner, const Math::Transform& local, TransformHandle parent) {
+        TransformHandle handle;
+        if (!m_freeHandles.empty()) {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        }
+        else {
+            handle = static_cast<TransformHandle>(m_handleToIndex.size());
+            m_handleToIndex.push_back(InvalidIndex);
+        }
+
+        // New slots go to the end, the next Update moves them to their level
+        U32 index = static_cast<U32>(m_flags.size());
+        m_handleToIndex[handle] = index;
+
+        m_positions.push_back(local.position);
+        m_rotations.push_back(local.rotation);
+        m_scales.push_back(local.scale);
+        m_localMatrices.push_back(Math::Matrix4x4::Identity());
+        m_worldMatrices.push_back(Math::Matrix4x4::Identity());
+        m_worldVersions.push_back(0);
+        m_parents.push_back(parent != InvalidTransformHandle ? IndexOf(parent) : InvalidIndex);
+        m_flags.push_back(0);
+        m_owners.push_back(owner);
+        m_slotHandles.push_back(handle);
+
+        MarkDirty(index, LocalDirty | WorldDirty);
+        m_orderDirty = true;
+        m_liveCount++;
+        return handle;
+    }
+
+    void TransformSystem::Unregister(TransformHandle handle) {
+        U32 index = IndexOf(handle);
+
+        // The slot stays in place until the next reorder so other indices remain valid
+        m_flags[index] = Dead;
+        m_owners[index] = nullptr;
+        m_handleToIndex[handle] = InvalidIndex;
+        m_freeHandles.push_back(handle);
+
+        m_orderDirty = true;
+        m_liveCount--;
+    }
+
+    void TransformSystem::SetParent(TransformHandle handle, TransformHandle parent) {
+        U32 index = IndexOf(handle);
+        m_parents[index] = parent != InvalidTransformHandle ? IndexOf(parent) : InvalidIndex;
+        MarkDirty(index, WorldDirty);
+        m_orderDirty = true;
+    }
+
+    bool TransformSystem::IsValid(TransformHandle handle) const {
+        return handle < m_handleToIndex.size() && m_handleToIndex[handle] != InvalidIndex;
+    }
+
+    // ================== Local Transform ==================
+
+    void TransformSystem::SetLocalPosition(TransformHandle handle, const Math::Vector3& position) {
+        U32 index = IndexOf(handle);
+        m_positions[index] = position;
+        MarkDirty(index, LocalDirty | WorldDirty);
+    }
+
+    void TransformSystem::SetLocalRotation(TransformHandle handle, const Math::Quaternion& rotation) {
+        U32 index = IndexOf(handle);
+        m_rotations[index] = rotation;
+        MarkDirty(index, LocalDirty | WorldDirty);
+    }
+
+    void TransformSystem::SetLocalScale(TransformHandle handle, const Math::Vector3& scale) {
+        U32 index = IndexOf(handle);
+        m_scales[index] = scale;
+        MarkDirty(index, LocalDirty | WorldDirty);
+    }
+
+    void TransformSystem::MarkWorldDirty(TransformHandle handle) {
+        MarkDirty(IndexOf(handle), WorldDirty);
+    }
+
+    void TransformSystem::SetDirty(TransformHandle handle) {
+        MarkDirty(IndexOf(handle), LocalDirty | WorldDirty);
+    }
+
+    // ================== Matrices ==================
+
+    const Math::Matrix4x4& TransformSystem::GetLocalMatrix(TransformHandle handle) {
+        return ResolveLocal(IndexOf(handle));
+    }
+
+    const Math::Matrix4x4& TransformSystem::GetWorldMatrix(TransformHandle handle) {
+        U32 index = IndexOf(handle);
+
+        // Nothing changed since the last Update, every world matrix is current
+        if (m_pendingChanges == 0) {
+            return m_worldMatrices[index];
+        }
+        return ResolveWorld(index);
+    }
+
+    U32 TransformSystem::GetWorldVersion(TransformHandle handle) {
+        U32 index = IndexOf(handle);
+        if (m_pendingChanges > 0) {
+            ResolveWorld(index);
+        }
+        return m_worldVersions[index];
+    }
+
+    bool TransformSystem::IsDirty(TransformHandle handle) const {
+        return m_pendingChanges > 0 && IsStale(IndexOf(handle));
+    }
+
+    // ================== Update ==================
+
+    void TransformSystem::Update() {
+        if (!HasPendingChanges()) {
+            m_lastUpdateCount = 0;
+            return;
+        }
+
+        if (m_orderDirty) {
+            RebuildOrder();
+        }
+
+        // Every matrix recomputed in this pass gets the same version
+        const U32 version = m_nextWorldVersion++;
+
+        auto& jobSystem = Core::JobSystem::Get();
+        for (size_t level = 0; level + 1 < m_levelOffsets.size(); ++level) {
+            const U32 begin = m_levelOffsets[level];
+            const U32 end = m_levelOffsets[level + 1];
+            const size_t count = end - begin;
+
+            // Levels depend on the previous one, ParallelFor returns once the whole level is done
+            if (count > PARALLEL_GRAIN_SIZE && jobSystem.IsRunning()) {
+                jobSystem.ParallelFor(count, PARALLEL_GRAIN_SIZE, [this, begin, version](size_t first, size_t last) {
+                    UpdateRange(begin + static_cast<U32>(first), begin + static_cast<U32>(last), version);
+                    }, Core::JobPriority::High);
+            }
+            else {
+                UpdateRange(begin, end, version);
+            }
+        }
+
+        // Callbacks may modify transforms again, those changes belong to the next Update
+        m_pendingChanges = 0;
+        NotifyInherited(version);
+    }
+
+    // ================== Internal Methods ==================
+
+    U32 TransformSystem::IndexOf(TransformHandle handle) const {
+        AGK_ASSERT(IsValid(handle), "TransformSystem: Invalid transform handle");
+        return m_handleToIndex[handle];
+    }
+
+    void TransformSystem::MarkDirty(U32 index, U8 flags) {
+        m_flags[index] |= flags;
+        m_pendingChanges++;
+    }
+
+    const Math::Matrix4x4& TransformSystem::ResolveLocal(U32 index) {
+        if (m_flags[index] & LocalDirty) {
+            Math::Batch::ComposeTRS(
+                std::span(&m_positions[index], 1),
+                std::span(&m_rotations[index], 1),
+                std::span(&m_scales[index], 1),
+                std::span(&m_localMatrices[index], 1));
+            m_flags[index] &= ~LocalDirty;
+        }
+        return m_localMatrices[index];
+    }
+
+    const Math::Matrix4x4& TransformSystem::ResolveWorld(U32 index) {
+        U32 parent = m_parents[index];
+        const Math::Matrix4x4* parentWorld = parent != InvalidIndex ? &ResolveWorld(parent) : nullptr;
+
+        bool selfDirty = (m_flags[index] & WorldDirty) != 0;
+        bool parentMoved = parentWorld && m_worldVersions[parent] > m_worldVersions[index];
+        if (!selfDirty && !parentMoved) {
+            return m_worldMatrices[index];
+        }
+
+        m_worldMatrices[index] = parentWorld ? *parentWorld * ResolveLocal(index) : ResolveLocal(index);
+        m_worldVersions[index] = m_nextWorldVersion++;
+
+        // Update will not recompute this slot again, so it has to remember the pending notification
+        m_flags[index] = static_cast<U8>((m_flags[index] & ~WorldDirty) | (selfDirty ? 0 : Inherited));
+        return m_worldMatrices[index];
+    }
+
+    bool TransformSystem::IsStale(U32 index) const {
+        if (m_flags[index] & (LocalDirty | WorldDirty)) {
+            return true;
+        }
+
+        U32 parent = m_parents[index];
+        if (parent == InvalidIndex) {
+            return false;
+        }
+        return m_worldVersions[parent] > m_worldVersions[index] || IsStale(parent);
+    }
+
+    void TransformSystem::RebuildOrder() {
+        const U32 slotCount = static_cast<U32>(m_flags.size());
+
+        // Children of every slot as one flat array, in current slot order
+        std::vector<U32> childOffsets(slotCount + 1, 0);
+        for (U32 slot = 0; slot < slotCount; ++slot) {
+            if (m_flags[slot] & Dead) {
+                continue;
+            }
+
+            // Transforms whose parent went away become roots
+            U32 parent = m_parents[slot];
+            if (parent != InvalidIndex && (m_flags[parent] & Dead)) {
+                m_parents[slot] = InvalidIndex;
+                m_flags[slot] |= WorldDirty;
+                parent = InvalidIndex;
+            }
+
+            if (parent != InvalidIndex) {
+                childOffsets[parent + 1]++;
+            }
+        }
+        for (U32 slot = 0; slot < slotCount; ++slot) {
+            childOffsets[slot + 1] += childOffsets[slot];
+        }
+
+        std::vector<U32> children(childOffsets[slotCount]);
+        std::vector<U32> fill(childOffsets.begin(), childOffsets.end() - 1);
+        for (U32 slot = 0; slot < slotCount; ++slot) {
+            if (!(m_flags[slot] & Dead) && m_parents[slot] != InvalidIndex) {
+                children[fill[m_parents[slot]]++] = slot;
+            }
+        }
+
+        // Breadth-first from the roots: levels become contiguous and siblings adjacent
+        std::vector<U32> order;
+        order.reserve(m_liveCount);
+        for (U32 slot = 0; slot < slotCount; ++slot) {
+            if (!(m_flags[slot] & Dead) && m_parents[slot] == InvalidIndex) {
+                order.push_back(slot);
+            }
+        }
+
+        m_levelOffsets.clear();
+        m_levelOffsets.push_back(0);
+        size_t levelEnd = order.size();
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (i == levelEnd) {
+                m_levelOffsets.push_back(static_cast<U32>(i));
+                levelEnd = order.size();
+            }
+
+            U32 slot = order[i];
+            for (U32 c = childOffsets[slot]; c < childOffsets[slot + 1]; ++c) {
+                order.push_back(children[c]);
+            }
+        }
+        if (!order.empty()) {
+            m_levelOffsets.push_back(static_cast<U32>(order.size()));
+        }
+
+        if (order.size() != m_liveCount) {
+            // Slots in a parent cycle never reach a root and would keep stale indices. Detach one
+            // slot per cycle so the rest of each chain hangs below it again, then start over.
+            U32 detached = BreakParentCycles(order);
+            AGK_ERROR("TransformSystem: {} transforms were not reachable from a root, detached {} from parent cycles",
+                m_liveCount - order.size(), detached);
+            RebuildOrder();
+            return;
+        }
+
+        // Gather every array into the new order
+        std::vector<U32> newIndex(slotCount, InvalidIndex);
+        for (U32 i = 0; i < order.size(); ++i) {
+            newIndex[order[i]] = i;
+        }
+
+        auto permute = [&order](auto& values) {
+            std::remove_reference_t<decltype(values)> sorted;
+            sorted.reserve(order.size());
+            for (U32 slot : order) {
+                sorted.push_back(values[slot]);
+            }
+            values.swap(sorted);
+            };
+
+        permute(m_positions);
+        permute(m_rotations);
+        permute(m_scales);
+        permute(m_localMatrices);
+        permute(m_worldMatrices);
+        permute(m_worldVersions);
+        permute(m_parents);
+        permute(m_flags);
+        permute(m_owners);
+        permute(m_slotHandles);
+
+        for (U32 i = 0; i < order.size(); ++i) {
+            if (m_parents[i] != InvalidIndex) {
+                m_parents[i] = newIndex[m_parents[i]];
+            }
+            m_handleToIndex[m_slotHandles[i]] = i;
+        }
+
+        m_orderDirty = false;
+    }
+
+    U32 TransformSystem::BreakParentCycles(const std::vector<U32>& reachable) {
+        const U32 slotCount = static_cast<U32>(m_flags.size());
+
+        enum : U8 { Unvisited, OnWalk, Settled };
+        std::vector<U8> state(slotCount, Unvisited);
+        for (U32 slot : reachable) {
+            state[slot] = Settled;
+        }
+
+        U32 detached = 0;
+        std::vector<U32> walk;
+        for (U32 slot = 0; slot < slotCount; ++slot) {
+            if (state[slot] != Unvisited || (m_flags[slot] & Dead)) {
+                continue;
+            }
+
+            // Follow the parents until the walk meets itself (a new cycle) or a slot already settled
+            U32 current = slot;
+            while (current != InvalidIndex && state[current] == Unvisited) {
+                state[current] = OnWalk;
+                walk.push_back(current);
+                current = m_parents[current];
+            }
+
+            if (current != InvalidIndex && state[current] == OnWalk) {
+                m_parents[current] = InvalidIndex;
+
+                // Inherited so the owner hears about its new world matrix in this Update
+                m_flags[current] |= WorldDirty | Inherited;
+                if (SceneTransform* owner = m_owners[current]; owner && owner->m_parent) {
+                    owner->m_parent->RemoveChild(owner);
+                    owner->m_parent = nullptr;
+                }
+                detached++;
+            }
+
+            for (U32 visited : walk) {
+                state[visited] = Settled;
+            }
+            walk.clear();
+        }
+        return detached;
+    }
+
+    void TransformSystem::UpdateRange(U32 begin, U32 end, U32 version) {
+        // Local matrices, one batch per run of consecutive dirty slots
+        for (U32 i = begin; i < end;) {
+            if (!(m_flags[i] & LocalDirty)) {
+                ++i;
+                continue;
+            }
+
+            U32 runEnd = i + 1;
+            while (runEnd < end && (m_flags[runEnd] & LocalDirty)) {
+                ++runEnd;
+            }
+
+            const size_t count = runEnd - i;
+            Math::Batch::ComposeTRS(
+                std::span(&m_positions[i], count),
+                std::span(&m_rotations[i], count),
+                std::span(&m_scales[i], count),
+                std::span(&m_localMatrices[i], count));
+
+            for (; i < runEnd; ++i) {
+                m_flags[i] &= ~LocalDirty;
+            }
+        }
+
+        // World matrices. Siblings are adjacent, so a run of stale siblings shares one parent matrix.
+        auto isStale = [this](U32 index) {
+            U32 parent = m_parents[index];
+            return (m_flags[index] & WorldDirty) != 0 ||
+                (parent != InvalidIndex && m_worldVersions[parent] > m_worldVersions[index]);
+            };
+
+        for (U32 i = begin; i < end;) {
+            if (!isStale(i)) {
+                ++i;
+                continue;
+            }
+
+            const U32 parent = m_parents[i];
+            U32 runEnd = i + 1;
+            while (runEnd < end && m_parents[runEnd] == parent && isStale(runEnd)) {
+                ++runEnd;
+            }
+
+            const size_t count = runEnd - i;
+            if (parent == InvalidIndex) {
+                std::copy_n(&m_localMatrices[i], count, &m_worldMatrices[i]);
+            }
+            else {
+                Math::Batch::MultiplyMatrices(m_worldMatrices[parent],
+                    std::span<const Math::Matrix4x4>(&m_localMatrices[i], count),
+                    std::span(&m_worldMatrices[i], count));
+            }
+
+            for (; i < runEnd; ++i) {
+                if (!(m_flags[i] & WorldDirty)) {
+                    m_flags[i] |= Inherited;
+                }
+                m_flags[i] &= ~WorldDirty;
+                m_worldVersions[i] = version;
+            }
+        }
+    }
+
+    void TransformSystem::NotifyInherited(U32 version) {
+        m_lastUpdateCount = 0;
+
+        // Index loop, a callback may register new transforms
+        for (size_t i = 0; i < m_flags.size(); ++i) {
+            if (m_worldVersions[i] == version) {
+                m_lastUpdateCount++;
+            }
+
+            if (!(m_flags[i] & Inherited)) {
+                continue;
+            }
+
+            m_flags[i] &= ~Inherited;
+            if (m_owners[i]) {
+                m_owners[i]->OnWorldChangedBySystem();
+            }
+        }
+    }
+
+} // namespace Angaraka::SceneSystem
@@ -0,0 +1,118 @@
+# Engine/Tests/Angaraka.Tests/Fixtures/Generation/generate_fixture.py
+#
+# Regenerates bigram_lm.onnx and dialogue_lm.onnx with their .meta next to this script, tiny causal
+# language models:
+#
+#   input_ids      int64 [batch, sequence]
+#   attention_mask int64 [batch, sequence]    (unused, present so batched generation is allowed)
+#   position_ids   int64 [batch, sequence]    (unused)
+#   logits         float [batch, sequence, 64] = table[input_ids]
+#
+# Each row of the table only depends on the current token: next = id + 1 scores 4, next = id + 2
+# scores 4 - ln 3 and every other token 0, all modulo the vocabulary. Top-2 sampling therefore
+# picks +1 with probability 0.75 and +2 with 0.25, greedy always picks +1.
+#
+# dialogue_lm.onnx is the same table indexed by input_ids modulo 64, so the ids of a real tokenizer
+# are valid inputs. The dialogue benchmarks run AIManager on it with the Tokenizer fixture.
+#
+# The protobuf is written by hand so regenerating it needs nothing beyond the standard library.
+import json
+import math
+import os
+import struct
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+FLOAT = 1
+INT64 = 7
+VOCAB = 64
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def field_varint(number, value):
+    return varint(number << 3) + varint(value)
+
+
+def field_bytes(number, payload):
+    if isinstance(payload, str):
+        payload = payload.encode()
+    return varint((number << 3) | 2) + varint(len(payload)) + payload
+
+
+def tensor_type(elem_type, dims):
+    shape = b"".join(field_bytes(1, field_bytes(2, d) if isinstance(d, str) else field_varint(1, d)) for d in dims)
+    return field_bytes(1, field_varint(1, elem_type) + field_bytes(2, shape))
+
+
+def value_info(name, elem_type, dims):
+    return field_bytes(1, name) + field_bytes(2, tensor_type(elem_type, dims))
+
+
+def initializer(name, data_type, dims, raw):
+    return b"".join(field_varint(1, d) for d in dims) + field_varint(2, data_type) + field_bytes(8, name) + field_bytes(9, raw)
+
+
+def node(op_type, inputs, outputs, attributes=b""):
+    return (b"".join(field_bytes(1, i) for i in inputs) + b"".join(field_bytes(2, o) for o in outputs)
+            + field_bytes(3, outputs[0]) + field_bytes(4, op_type) + attributes)
+
+
+def bigram_table():
+    table = [0.0] * (VOCAB * VOCAB)
+    for token in range(VOCAB):
+        table[token * VOCAB + (token + 1) % VOCAB] = 4.0
+        table[token * VOCAB + (token + 2) % VOCAB] = 4.0 - math.log(3.0)
+    return struct.pack(f"<{len(table)}f", *table)
+
+
+def write_model(name, wrap_ids, description):
+    # Gather indexes the table directly, or the ids wrapped into the vocabulary first
+    nodes = [field_bytes(1, node("Gather", ["table", "input_ids"], ["logits"]))]
+    initializers = [field_bytes(5, initializer("table", FLOAT, [VOCAB, VOCAB], bigram_table()))]
+    if wrap_ids:
+        nodes = [
+            field_bytes(1, node("Mod", ["input_ids", "vocab"], ["wrapped_ids"])),
+            field_bytes(1, node("Gather", ["table", "wrapped_ids"], ["logits"])),
+        ]
+        initializers.append(field_bytes(5, initializer("vocab", INT64, [], struct.pack("<q", VOCAB))))
+
+    graph = b"".join(nodes + [field_bytes(2, name)] + initializers + [
+        field_bytes(11, value_info("input_ids", INT64, ["batch", "sequence"])),
+        field_bytes(11, value_info("attention_mask", INT64, ["batch", "sequence"])),
+        field_bytes(11, value_info("position_ids", INT64, ["batch", "sequence"])),
+        field_bytes(12, value_info("logits", FLOAT, ["batch", "sequence", VOCAB])),
+    ])
+
+    model = b"".join([
+        field_varint(1, 7),                                         # ir_version
+        field_bytes(2, "generate_fixture.py"),                      # producer_name
+        field_bytes(7, graph),
+        field_bytes(8, field_bytes(1, "") + field_varint(2, 13)),   # opset_import, default domain
+    ])
+
+    with open(os.path.join(HERE, f"{name}.onnx"), "wb") as f:
+        f.write(model)
+    with open(os.path.join(HERE, f"{name}.onnx.meta"), "w", newline="\n") as f:
+        json.dump({"modelType": "dialogue", "architecture": "single_faction", "description": description}, f, indent=4)
+        f.write("\n")
+    print(f"{name}.onnx, {len(model)} bytes")
+
+
+def main():
+    write_model("bigram_lm", False, "Generation test model")
+    write_model("dialogue_lm", True, "Dialogue benchmark model")
+
+
+if __name__ == "__main__":
+    main()
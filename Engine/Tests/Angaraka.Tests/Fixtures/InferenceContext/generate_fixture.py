@@ -0,0 +1,96 @@
+# Engine/Tests/Angaraka.Tests/Fixtures/InferenceContext/generate_fixture.py
+#
+# Regenerates scale_by_mask.onnx and its .meta next to this script, a tiny model shaped like a
+# dialogue model:
+#
+#   ids    int64 [batch, sequence]
+#   mask   int64 [batch, sequence]
+#   scores float [batch, sequence, 4] = float(ids * mask)[..., None] * [1, 2, 3, 4]
+#
+# The protobuf is written by hand so regenerating it needs nothing beyond the standard library.
+import json
+import os
+import struct
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+FLOAT = 1
+INT64 = 7
+ATTRIBUTE_INT = 2
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def field_varint(number, value):
+    return varint(number << 3) + varint(value)
+
+
+def field_bytes(number, payload):
+    if isinstance(payload, str):
+        payload = payload.encode()
+    return varint((number << 3) | 2) + varint(len(payload)) + payload
+
+
+def tensor_type(elem_type, dims):
+    shape = b"".join(field_bytes(1, field_bytes(2, d) if isinstance(d, str) else field_varint(1, d)) for d in dims)
+    return field_bytes(1, field_varint(1, elem_type) + field_bytes(2, shape))
+
+
+def value_info(name, elem_type, dims):
+    return field_bytes(1, name) + field_bytes(2, tensor_type(elem_type, dims))
+
+
+def initializer(name, data_type, dims, raw):
+    return b"".join(field_varint(1, d) for d in dims) + field_varint(2, data_type) + field_bytes(8, name) + field_bytes(9, raw)
+
+
+def node(op_type, inputs, outputs, attributes=b""):
+    return (b"".join(field_bytes(1, i) for i in inputs) + b"".join(field_bytes(2, o) for o in outputs)
+            + field_bytes(3, outputs[0]) + field_bytes(4, op_type) + attributes)
+
+
+def int_attribute(name, value):
+    return field_bytes(5, field_bytes(1, name) + field_varint(3, value) + field_varint(20, ATTRIBUTE_INT))
+
+
+def main():
+    graph = b"".join([
+        field_bytes(1, node("Mul", ["ids", "mask"], ["masked"])),
+        field_bytes(1, node("Cast", ["masked"], ["masked_float"], int_attribute("to", FLOAT))),
+        field_bytes(1, node("Unsqueeze", ["masked_float", "last_axis"], ["column"])),
+        field_bytes(1, node("Mul", ["column", "scale"], ["scores"])),
+        field_bytes(2, "scale_by_mask"),
+        field_bytes(5, initializer("last_axis", INT64, [1], struct.pack("<q", 2))),
+        field_bytes(5, initializer("scale", FLOAT, [4], struct.pack("<4f", 1.0, 2.0, 3.0, 4.0))),
+        field_bytes(11, value_info("ids", INT64, ["batch", "sequence"])),
+        field_bytes(11, value_info("mask", INT64, ["batch", "sequence"])),
+        field_bytes(12, value_info("scores", FLOAT, ["batch", "sequence", 4])),
+    ])
+
+    model = b"".join([
+        field_varint(1, 7),                                         # ir_version
+        field_bytes(2, "generate_fixture.py"),                      # producer_name
+        field_bytes(7, graph),
+        field_bytes(8, field_bytes(1, "") + field_varint(2, 13)),   # opset_import, default domain
+    ])
+
+    with open(os.path.join(HERE, "scale_by_mask.onnx"), "wb") as f:
+        f.write(model)
+    with open(os.path.join(HERE, "scale_by_mask.onnx.meta"), "w", newline="\n") as f:
+        json.dump({"modelType": "test", "architecture": "single_faction", "description": "InferenceContext test model"}, f, indent=4)
+        f.write("\n")
+    print(f"scale_by_mask.onnx, {len(model)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,70 @@
+# Engine/Tests/Angaraka.Tests/Fixtures/OBJ/generate_fixture.py
+#
+# Regenerates the OBJ fixture next to this script: one wavy grid written twice, once with
+# relative (negative) indices and once with the same corners as absolute indices. Rows are
+# interleaved, each row's vertices followed by the faces of the band above it, so when the
+# loader splits the relative file into chunks the faces at the start of a chunk reach back
+# into elements parsed by the previous chunk. Faces mix v/vt/vn, v//vn, v/vt and plain v
+# corners, quads, triangles and pentagons, and some lines end in CRLF.
+import math
+import os
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SIZE = 48
+
+
+def write(path, relative):
+    counts = {'v': 0, 'vt': 0, 'vn': 0}
+    lines = ['# Angaraka OBJ fixture, see generate_fixture.py', 'o WavyGrid']
+
+    def index(kind, absolute):
+        # 1-based absolute index, or how far back from the newest element of its kind
+        return str(absolute - counts[kind] - 1) if relative else str(absolute)
+
+    def corner(style, x, y):
+        v = y * (SIZE + 1) + x + 1
+        vn = y + 1
+        if style == 0:
+            return f"{index('v', v)}/{index('vt', v)}/{index('vn', vn)}"
+        if style == 1:
+            return f"{index('v', v)}//{index('vn', vn)}"
+        if style == 2:
+            return f"{index('v', v)}/{index('vt', v)}"
+        return index('v', v)
+
+    for y in range(SIZE + 1):
+        for x in range(SIZE + 1):
+            height = math.sin(x * 0.3) * math.cos(y * 0.2)
+            lines.append(f"v {x * 0.25:.6f} {height:.6f} {y * 0.25:.6f}")
+            lines.append(f"vt {x / SIZE:.6f} {y / SIZE:.6f}")
+            counts['v'] += 1
+            counts['vt'] += 1
+        lines.append(f"vn 0 1 {y / SIZE:.3f}")
+        counts['vn'] += 1
+        if y == 0:
+            continue
+
+        lines.append(f"g band{y}\r")
+        lines.append("usemtl grid")
+        lines.append("s 1")
+        row = y - 1
+        for x in range(SIZE):
+            style = (x + row) % 4
+            a, b, c, d = (x, row), (x + 1, row), (x + 1, row + 1), (x, row + 1)
+            if x % 9 == 4 and x + 2 <= SIZE:
+                # Pentagon over this cell and half of the next, fanned by the loader
+                e = (x + 2, row)
+                lines.append('f ' + ' '.join(corner(style, *p) for p in (a, b, e, c, d)))
+            elif x % 5 == 1:
+                lines.append('f ' + ' '.join(corner(style, *p) for p in (a, b, c)) + '\r')
+                lines.append('f ' + ' '.join(corner(style, *p) for p in (a, c, d)))
+            else:
+                lines.append('f ' + ' '.join(corner(style, *p) for p in (a, b, c, d)))
+
+    with open(path, 'w', newline='\n') as file:
+        file.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    write(os.path.join(HERE, 'wavy_grid_relative.obj'), True)
+    write(os.path.join(HERE, 'wavy_grid_absolute.obj'), False)
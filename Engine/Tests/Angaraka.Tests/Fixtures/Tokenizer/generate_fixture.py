@@ -0,0 +1,128 @@
+# Engine/Tests/Angaraka.Tests/Fixtures/Tokenizer/generate_fixture.py
+#
+# Regenerates the tokenizer fixture next to this script: a small byte-level BPE vocabulary and
+# merge list trained on synthetic text, and golden ids for a set of prompts. The golden ids come
+# from a straightforward reference implementation of GPT-2 style BPE (rescan for the best-ranked
+# pair until none is left), independent of the engine's heap-based encoder.
+import collections
+import json
+import os
+import random
+import re
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def bytes_to_unicode():
+    bs = list(range(ord("!"), ord("~") + 1)) + list(range(ord("¡"), ord("¬") + 1)) + list(range(ord("®"), ord("ÿ") + 1))
+    cs = bs[:]
+    n = 0
+    for b in range(256):
+        if b not in bs:
+            bs.append(b)
+            cs.append(256 + n)
+            n += 1
+    return dict(zip(bs, map(chr, cs)))
+
+
+BYTE_TO_UNICODE = bytes_to_unicode()
+PRETOKENIZE = re.compile(r"""'s|'t|'re|'ve|'m|'ll|'d| ?[A-Za-z\x80-\U0010FFFF]+| ?[0-9]+| ?[^\sA-Za-z0-9\x80-\U0010FFFF]+|\s+(?!\S)|\s+""")
+END_OF_TEXT = "<|endoftext|>"
+
+random.seed(3)
+WORDS = "the quick brown fox jumps over lazy dog it's we're they've I'm you'll he'd 1234 99 hello, world!! ... \n\n  tabs\t end".split(' ')
+
+
+def random_text(word_count):
+    out = []
+    for _ in range(word_count):
+        out.append(random.choice(WORDS + ["aaaa", "aaa", "abab", "  ", "\n", "café", "naïve", "''s", "x'll"]))
+    return ''.join(random.choice([' ', '', '  ', '\n']) + w for w in out)
+
+
+def to_symbols(word):
+    return ''.join(BYTE_TO_UNICODE[b] for b in word.encode())
+
+
+def train(corpus, merge_count):
+    word_counts = collections.Counter(to_symbols(w) for w in PRETOKENIZE.findall(corpus))
+    vocab = {BYTE_TO_UNICODE[b]: i for i, b in enumerate(sorted(BYTE_TO_UNICODE))}
+    splits = {w: list(w) for w in word_counts}
+    merges = []
+    for _ in range(merge_count):
+        pair_counts = collections.Counter()
+        for w, c in word_counts.items():
+            s = splits[w]
+            for pair in zip(s, s[1:]):
+                pair_counts[pair] += c
+        if not pair_counts:
+            break
+        (a, b), _ = pair_counts.most_common(1)[0]
+        merges.append((a, b))
+        vocab.setdefault(a + b, len(vocab))
+        for w in word_counts:
+            s = splits[w]
+            merged = []
+            i = 0
+            while i < len(s):
+                if i + 1 < len(s) and s[i] == a and s[i + 1] == b:
+                    merged.append(a + b)
+                    i += 2
+                else:
+                    merged.append(s[i])
+                    i += 1
+            splits[w] = merged
+    return vocab, merges
+
+
+def bpe(symbols, ranks):
+    word = list(symbols)
+    while len(word) > 1:
+        best = min(set(zip(word, word[1:])), key=lambda p: ranks.get(p, float('inf')))
+        if best not in ranks:
+            break
+        a, b = best
+        merged = []
+        i = 0
+        while i < len(word):
+            if i + 1 < len(word) and word[i] == a and word[i + 1] == b:
+                merged.append(a + b)
+                i += 2
+            else:
+                merged.append(word[i])
+                i += 1
+        word = merged
+    return word
+
+
+def main():
+    vocab, merges = train(random_text(3000), 300)
+    ranks = {m: i for i, m in enumerate(merges)}
+    vocab[END_OF_TEXT] = len(vocab)
+
+    def encode(text):
+        ids = []
+        for k, part in enumerate(text.split(END_OF_TEXT)):
+            if k:
+                ids.append(vocab[END_OF_TEXT])
+            for w in PRETOKENIZE.findall(part):
+                ids += [vocab[s] for s in bpe(to_symbols(w), ranks)]
+        return ids
+
+    prompts = [random_text(random.randint(0, 40)) for _ in range(40)]
+    prompts += ["", " ", "  x", "a\n\nb", "hi<|endoftext|>there", "'s", " 's", "x  ", "\t\tfoo", "café naïve", "<|endoftext|>"]
+
+    with open(os.path.join(HERE, "tokenizer_vocab.json"), "w", encoding="utf-8") as f:
+        json.dump(vocab, f, ensure_ascii=False)
+    with open(os.path.join(HERE, "merges.txt"), "w", encoding="utf-8", newline="\n") as f:
+        f.write("#version: 0.2\n" + ''.join(f"{a} {b}\n" for a, b in merges))
+    with open(os.path.join(HERE, "special_tokens.json"), "w", encoding="utf-8") as f:
+        json.dump({"eos_token": {"content": END_OF_TEXT, "id": vocab[END_OF_TEXT]}}, f)
+    with open(os.path.join(HERE, "golden_ids.json"), "w", encoding="utf-8", newline="\n") as f:
+        f.write("[\n" + ",\n".join(json.dumps({"text": p, "ids": encode(p)}, ensure_ascii=False) for p in prompts) + "\n]\n")
+
+    print(f"{len(vocab)} tokens, {len(merges)} merges, {len(prompts)} prompts")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,149 @@
+// Engine/Tests/Angaraka.Tests/Source/AI/GenerationTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/AIModelResource.hpp>
+#include <Angaraka/Sampler.hpp>
+
+using namespace Angaraka;
+using namespace Angaraka::AI;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // Fixtures/Generation/bigram_lm.onnx: the logits of a position only depend on its token. The
+    // next token is id + 1 (logit 4) or id + 2 (logit 4 - ln 3), modulo the vocabulary, every
+    // other token scores 0.
+    constexpr I64 c_vocabSize = 64;
+
+    Reference<AIModelResource> LoadModel() {
+        auto model = CreateReference<AIModelResource>("bigram_lm");
+        AIModelLoadOptions options;
+        options.warmup = false;
+        options.cacheOptimizedModel = false;    // Keep the fixture directory clean
+        model->SetLoadOptions(options);
+        CHECK(model->Load(FixturePath("Generation/bigram_lm.onnx")));
+        return model;
+    }
+
+    // What greedy decoding produces after 'last': last + 1, last + 2, ...
+    std::vector<I64> GreedyContinuation(I64 last, size_t count) {
+        std::vector<I64> tokens(count);
+        for (size_t i = 0; i < count; ++i) {
+            tokens[i] = (last + 1 + static_cast<I64>(i)) % c_vocabSize;
+        }
+        return tokens;
+    }
+
+    I64 Step(I64 from, I64 to) {
+        return (to - from + c_vocabSize) % c_vocabSize;
+    }
+
+} // anonymous namespace
+
+// Left padding must not change what a row generates, and rows stop on their own config
+AGK_TEST(Generation, GreedyBatchMatchesSingleGenerate)
+{
+    Reference<AIModelResource> model = LoadModel();
+    CHECK(model->SupportsBatchedGeneration());
+    CHECK(!model->SupportsKVCache());
+
+    const std::vector<std::vector<I64>> prompts = { { 5 }, { 1, 2, 3, 20 }, { 40, 60 } };
+    std::vector<GenerationConfig> configs(prompts.size());
+    for (GenerationConfig& config : configs) {
+        config.maxNewTokens = 6;
+    }
+    configs[2].stopTokens.push_back(63);
+
+    std::vector<GenerationResult> batch = model->GenerateBatch(prompts, configs);
+    CHECK_EQ(batch.size(), prompts.size());
+
+    CHECK(batch[0].tokens == GreedyContinuation(5, 6));
+    CHECK(batch[1].tokens == GreedyContinuation(20, 6));
+    CHECK(batch[2].tokens == GreedyContinuation(60, 2));
+    CHECK(batch[2].stoppedOnToken);
+
+    for (size_t b = 0; b < prompts.size(); ++b) {
+        CHECK(batch[b].success);
+        CHECK_EQ(batch[b].averageProbability, 1.0f);
+        GenerationResult single = model->Generate(prompts[b], configs[b]);
+        CHECK(single.tokens == batch[b].tokens);
+    }
+}
+
+// The reported probability is the sampler's, over its top-2 candidates: 0.75 for a +1 step and
+// 0.25 for a +2 step. A full vocabulary softmax would give about 0.4 and 0.13.
+AGK_TEST(Generation, AverageProbabilityComesFromSampler)
+{
+    Reference<AIModelResource> model = LoadModel();
+
+    SamplingParams params;
+    params.topK = 2;
+    params.seed = 17;
+    LogitsSampler sampler(params);
+
+    GenerationConfig config;
+    config.maxNewTokens = 40;
+    config.sampler = sampler.AsTokenSampler();
+
+    const std::vector<I64> prompt = { 3 };
+    GenerationResult result = model->Generate(prompt, config);
+    CHECK(result.success);
+    CHECK_EQ(result.tokens.size(), size_t(40));
+
+    F64 expected = 0.0;
+    U32 plusTwo = 0;
+    I64 previous = prompt.back();
+    for (I64 token : result.tokens) {
+        const I64 step = Step(previous, token);
+        CHECK(step == 1 || step == 2);
+        expected += step == 1 ? 0.75 : 0.25;
+        plusTwo += step == 2 ? 1 : 0;
+        previous = token;
+    }
+    CHECK_NEAR(result.averageProbability, expected / result.tokens.size(), 1e-4);
+
+    // Both candidates actually get drawn
+    CHECK(plusTwo > 0);
+    CHECK(plusTwo < result.tokens.size());
+}
+
+// Tokens per second of batched sampled generation. The fixture has no KV cache, so every step
+// reruns the whole sequence; the numbers are mostly session and sampling overhead.
+AGK_BENCHMARK(Generation, GenerateBatchTokensPerSecond)
+{
+    constexpr size_t newTokens = 64;
+    Reference<AIModelResource> model = LoadModel();
+
+    std::vector<I64> prompt(16);
+    for (size_t i = 0; i < prompt.size(); ++i) prompt[i] = static_cast<I64>(i);
+
+    for (size_t batchSize : { 1u, 4u, 8u }) {
+        std::vector<std::vector<I64>> prompts(batchSize, prompt);
+        std::vector<Scope<LogitsSampler>> samplers;
+        std::vector<GenerationConfig> configs(batchSize);
+        for (size_t b = 0; b < batchSize; ++b) {
+            SamplingParams params;
+            params.topK = 40;
+            params.topP = 0.9f;
+            params.temperature = 0.8f;
+            params.seed = b;
+            samplers.push_back(CreateScope<LogitsSampler>(params));
+            configs[b].maxNewTokens = newTokens;
+            configs[b].sampler = samplers.back()->AsTokenSampler();
+        }
+
+        model->GenerateBatch(prompts, configs);
+
+        Stopwatch timer;
+        std::vector<GenerationResult> results = model->GenerateBatch(prompts, configs);
+        const F64 seconds = timer.ElapsedSeconds();
+
+        size_t generated = 0;
+        for (const GenerationResult& result : results) {
+            CHECK(result.success);
+            generated += result.tokens.size();
+        }
+        CHECK_EQ(generated, batchSize * newTokens);
+        ReportRate(std::format("GenerateBatch, batch {}", batchSize), static_cast<F64>(generated), "tokens", seconds);
+        std::printf("    decode only, per row: %.1f tokens/s\n", results.front().tokensPerSecond);
+    }
+}
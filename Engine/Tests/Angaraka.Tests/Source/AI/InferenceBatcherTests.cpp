@@ -0,0 +1,305 @@
+// Engine/Tests/Angaraka.Tests/Source/AI/InferenceBatcherTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/InferenceBatcher.hpp>
+#include <array>
+#include <future>
+#include <thread>
+
+using namespace Angaraka;
+using namespace Angaraka::AI;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // Fixtures/Generation/bigram_lm.onnx, greedy decoding continues last + 1, last + 2, ...
+    constexpr I64 c_vocabSize = 64;
+
+    Reference<AIModelResource> LoadModel() {
+        auto model = CreateReference<AIModelResource>("bigram_lm");
+        AIModelLoadOptions options;
+        options.warmup = false;
+        options.cacheOptimizedModel = false;    // Keep the fixture directory clean
+        model->SetLoadOptions(options);
+        CHECK(model->Load(FixturePath("Generation/bigram_lm.onnx")));
+        return model;
+    }
+
+    std::vector<I64> GreedyContinuation(I64 last, size_t count) {
+        std::vector<I64> tokens(count);
+        for (size_t i = 0; i < count; ++i) {
+            tokens[i] = (last + 1 + static_cast<I64>(i)) % c_vocabSize;
+        }
+        return tokens;
+    }
+
+    GenerationConfig Greedy(size_t maxNewTokens, std::function<bool(I64)> onToken = {}) {
+        GenerationConfig config;
+        config.maxNewTokens = maxNewTokens;
+        config.onToken = std::move(onToken);
+        return config;
+    }
+
+    // Holds the batcher's step job inside a one token request until released
+    struct StepGate {
+        std::promise<void> entered;
+        std::promise<void> release;
+
+        std::future<GenerationResult> Submit(InferenceBatcher& batcher) {
+            std::shared_future<void> released = release.get_future().share();
+            auto future = batcher.Submit({ 0 }, Greedy(2, [this, released](I64) {
+                entered.set_value();
+                released.wait();
+                return false;
+            }));
+            entered.get_future().wait();
+            return future;
+        }
+    };
+
+    constexpr int c_ran = 100;
+
+    // How each request ended, c_ran or its drop reason, -1 while pending
+    struct Outcomes {
+        std::array<std::atomic<int>, 8> results;
+
+        Outcomes() {
+            for (auto& result : results) result = -1;
+        }
+
+        bool Submit(InferenceBatcher& batcher, size_t index, const String& ownerId, InferencePriority priority,
+            F32 deadlineMs = 0.0f) {
+            GenerationSchedule schedule;
+            schedule.ownerId = ownerId;
+            schedule.priority = priority;
+            if (deadlineMs > 0.0f) {
+                schedule.deadline = InferenceTask::Clock::now()
+                    + std::chrono::duration_cast<InferenceTask::Clock::duration>(std::chrono::duration<F32, std::milli>(deadlineMs));
+            }
+            return batcher.Submit({ static_cast<I64>(index) }, Greedy(4),
+                [this, index](GenerationResult&& result) { results[index] = result.success ? c_ran : -2; },
+                schedule,
+                [this, index](InferenceDropReason reason) { results[index] = static_cast<int>(reason); });
+        }
+    };
+
+} // anonymous namespace
+
+// Requests queued while a step runs all join the next one and advance together, one session call
+// per token instead of one per token and request
+AGK_TEST(InferenceBatcher, QueuedRequestsShareSteps)
+{
+    Core::JobSystem::Get().Initialize(2);
+    InferenceBatcher batcher(LoadModel(), { 4, 5.0f });
+
+    StepGate gate;
+    auto gated = gate.Submit(batcher);
+
+    std::vector<std::future<GenerationResult>> futures;
+    for (I64 i = 0; i < 4; ++i) {
+        futures.push_back(batcher.Submit({ i * 10, i * 10 + 3 }, Greedy(16)));
+    }
+    CHECK_EQ(batcher.GetQueuedCount(), size_t(4));
+    gate.release.set_value();
+
+    CHECK(gated.get().success);
+    for (I64 i = 0; i < 4; ++i) {
+        GenerationResult result = futures[i].get();
+        CHECK(result.success);
+        CHECK(result.tokens == GreedyContinuation(i * 10 + 3, 16));
+    }
+
+    // The gate's step, then 16 shared ones
+    InferenceBatcherStats stats = batcher.GetStats();
+    CHECK_EQ(stats.requests, size_t(5));
+    CHECK_EQ(stats.steps, size_t(17));
+    CHECK(stats.averageBatchSize > 3.0f);
+}
+
+// A request submitted while a long generation runs joins it at the next token and finishes
+// without waiting for the long one
+AGK_TEST(InferenceBatcher, LateRequestJoinsAtTokenBoundary)
+{
+    Core::JobSystem::Get().Initialize(2);
+    InferenceBatcher batcher(LoadModel(), { 4, 5.0f });
+
+    constexpr size_t longTokens = 60;
+    std::atomic<size_t> longGenerated{ 0 };
+    std::atomic<size_t> longGeneratedWhenShortFinished{ 0 };
+    std::promise<GenerationResult> shortRequest;
+
+    auto longRequest = batcher.Submit({ 1 }, Greedy(longTokens, [&](I64) {
+        if (++longGenerated == 5) {
+            batcher.Submit({ 30 }, Greedy(3), [&](GenerationResult&& result) {
+                longGeneratedWhenShortFinished = longGenerated.load();
+                shortRequest.set_value(std::move(result));
+            });
+        }
+        return true;
+    }));
+
+    GenerationResult longResult = longRequest.get();
+    CHECK(longResult.tokens == GreedyContinuation(1, longTokens));
+
+    // Submitted during step 5, so steps 6 to 8 are shared
+    GenerationResult shortResult = shortRequest.get_future().get();
+    CHECK(shortResult.tokens == GreedyContinuation(30, 3));
+    CHECK_EQ(longGeneratedWhenShortFinished.load(), size_t(8));
+
+    InferenceBatcherStats stats = batcher.GetStats();
+    CHECK_EQ(stats.requests, size_t(2));
+    CHECK_EQ(stats.steps, longTokens);
+    CHECK_NEAR(stats.averageBatchSize, (longTokens + 3.0) / longTokens, 1e-4);
+}
+
+// Many quick replies and a few long generations, run one after another so each latency is just
+// its own generation. The median is a quick reply and the tail a long one.
+AGK_TEST(InferenceBatcher, LatencyPercentilesSeparateShortAndLong)
+{
+    Core::JobSystem::Get().Initialize(2);
+    InferenceBatcher batcher(LoadModel());
+
+    F64 shortestLongMs = std::numeric_limits<F64>::max();
+    F64 longestMs = 0.0;
+    for (U32 i = 0; i < 100; ++i) {
+        const bool isLong = i % 10 == 9;
+        Stopwatch timer;
+        GenerationResult result = batcher.Submit({ static_cast<I64>(i % c_vocabSize) }, Greedy(isLong ? 200 : 1)).get();
+        const F64 elapsedMs = timer.ElapsedSeconds() * 1000.0;
+
+        CHECK(result.success);
+        longestMs = std::max(longestMs, elapsedMs);
+        if (isLong) {
+            shortestLongMs = std::min(shortestLongMs, elapsedMs);
+        }
+    }
+
+    InferenceBatcherStats stats = batcher.GetStats();
+    CHECK_EQ(stats.requests, size_t(100));
+    CHECK_EQ(stats.averageBatchSize, 1.0f);
+    CHECK(stats.p50LatencyMs > 0.0f);
+    CHECK(stats.p99LatencyMs > 4.0f * stats.p50LatencyMs);
+
+    // Latency runs from Submit to completion, inside what the caller measured
+    CHECK(stats.p99LatencyMs <= longestMs);
+    CHECK(stats.p50LatencyMs < shortestLongMs);
+}
+
+// Stop finishes what was queued before it, requests after it fail right away
+AGK_TEST(InferenceBatcher, StopDrainsQueueThenFailsSubmissions)
+{
+    Core::JobSystem::Get().Initialize(2);
+    InferenceBatcher batcher(LoadModel(), { 2, 5.0f });
+
+    std::atomic<U32> completed{ 0 };
+    for (I64 i = 0; i < 6; ++i) {
+        batcher.Submit({ i }, Greedy(8), [&completed, i](GenerationResult&& result) {
+            if (result.success && result.tokens == GreedyContinuation(i, 8)) {
+                completed++;
+            }
+        });
+    }
+    batcher.Stop();
+    CHECK_EQ(completed.load(), 6u);
+    CHECK_EQ(batcher.GetQueuedCount(), size_t(0));
+
+    bool failed = false;
+    batcher.Submit({ 1 }, Greedy(8), [&failed](GenerationResult&& result) { failed = !result.success; });
+    CHECK(failed);
+}
+
+// While the batcher is busy a full queue makes room for a conversation by evicting the background
+// request, turns away another background one and lets a request that waited past its deadline
+// expire. What is left is admitted by priority.
+AGK_TEST(InferenceBatcher, LowPriorityRequestsDropWhileBusy)
+{
+    Core::JobSystem::Get().Initialize(2);
+    InferenceBatcherSettings settings;
+    settings.maxBatchSize = 1;
+    settings.maxQueueDepth = 3;
+    InferenceBatcher batcher(LoadModel(), settings);
+    Outcomes outcomes;
+
+    StepGate gate;
+    auto gated = gate.Submit(batcher);
+
+    CHECK(outcomes.Submit(batcher, 0, "guard", InferencePriority::Normal));
+    CHECK(outcomes.Submit(batcher, 1, "merchant", InferencePriority::Background));
+    CHECK(outcomes.Submit(batcher, 2, "sentry", InferencePriority::Normal, 50.0f));
+    CHECK(outcomes.Submit(batcher, 3, "player", InferencePriority::Conversation));     // Evicts 1
+    CHECK(!outcomes.Submit(batcher, 4, "merchant", InferencePriority::Background));   // Rejected
+
+    CHECK_EQ(outcomes.results[1].load(), static_cast<int>(InferenceDropReason::QueueFull));
+    CHECK_EQ(outcomes.results[4].load(), static_cast<int>(InferenceDropReason::QueueFull));
+    CHECK_EQ(batcher.GetQueuedCount(), size_t(3));
+
+    // 2 expires while the gate still holds the only row
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    gate.release.set_value();
+    gated.get();
+    batcher.Stop();
+
+    CHECK_EQ(outcomes.results[0].load(), c_ran);
+    CHECK_EQ(outcomes.results[2].load(), static_cast<int>(InferenceDropReason::Expired));
+    CHECK_EQ(outcomes.results[3].load(), c_ran);
+
+    InferenceBatcherStats stats = batcher.GetStats();
+    CHECK_EQ(stats.requests, size_t(3));
+    CHECK_EQ(stats.evicted, size_t(1));
+    CHECK_EQ(stats.rejected, size_t(1));
+    CHECK_EQ(stats.expired, size_t(1));
+}
+
+// Cancelling an NPC drops its waiting generations, the one already running finishes
+AGK_TEST(InferenceBatcher, CancelForOwnerDropsWaitingRequests)
+{
+    Core::JobSystem::Get().Initialize(2);
+    InferenceBatcher batcher(LoadModel(), { 1, 5.0f });
+    Outcomes outcomes;
+
+    StepGate gate;
+    auto gated = gate.Submit(batcher);
+
+    CHECK(outcomes.Submit(batcher, 0, "npc", InferencePriority::Conversation));
+    CHECK(outcomes.Submit(batcher, 1, "other", InferencePriority::Normal));
+    CHECK(outcomes.Submit(batcher, 2, "npc", InferencePriority::Background));
+
+    CHECK_EQ(batcher.CancelForOwner("npc"), size_t(2));
+    CHECK_EQ(batcher.CancelForOwner(""), size_t(0));
+    CHECK_EQ(outcomes.results[0].load(), static_cast<int>(InferenceDropReason::Cancelled));
+    CHECK_EQ(outcomes.results[2].load(), static_cast<int>(InferenceDropReason::Cancelled));
+
+    gate.release.set_value();
+    CHECK(gated.get().success);
+    batcher.Stop();
+    CHECK_EQ(outcomes.results[1].load(), c_ran);
+    CHECK_EQ(batcher.GetStats().cancelled, size_t(2));
+}
+
+// Tokens per second for 16 concurrent requests, batched against one at a time
+AGK_BENCHMARK(InferenceBatcher, ConcurrentRequestsTokensPerSecond)
+{
+    Core::JobSystem::Get().Initialize();
+    constexpr size_t requests = 16;
+    constexpr size_t newTokens = 32;
+    Reference<AIModelResource> model = LoadModel();
+
+    for (size_t maxBatchSize : { 1u, 8u }) {
+        InferenceBatcher batcher(model, { maxBatchSize, 5.0f });
+
+        Stopwatch timer;
+        std::vector<std::future<GenerationResult>> futures;
+        for (size_t i = 0; i < requests; ++i) {
+            futures.push_back(batcher.Submit({ static_cast<I64>(i) }, Greedy(newTokens)));
+        }
+        size_t generated = 0;
+        for (auto& future : futures) {
+            generated += future.get().tokens.size();
+        }
+        const F64 seconds = timer.ElapsedSeconds();
+
+        CHECK_EQ(generated, requests * newTokens);
+        InferenceBatcherStats stats = batcher.GetStats();
+        ReportRate(std::format("{} requests, max batch {}", requests, maxBatchSize), static_cast<F64>(generated), "tokens", seconds);
+        std::printf("    %.1f rows per step, p50 %.2f ms, p99 %.2f ms\n", stats.averageBatchSize, stats.p50LatencyMs, stats.p99LatencyMs);
+    }
+}
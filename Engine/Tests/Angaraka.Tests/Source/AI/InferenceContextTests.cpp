@@ -0,0 +1,162 @@
+// Engine/Tests/Angaraka.Tests/Source/AI/InferenceContextTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/AIModelResource.hpp>
+#include <Angaraka/InferenceContext.hpp>
+
+using namespace Angaraka;
+using namespace Angaraka::AI;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // Fixtures/InferenceContext/scale_by_mask.onnx: ids and mask [batch, sequence] in, scores
+    // [batch, sequence, 4] out with scores[t][k] = ids[t] * mask[t] * (k + 1).
+    constexpr size_t c_scoreWidth = 4;
+    constexpr size_t c_maxSequenceLength = 100;
+
+    Reference<AIModelResource> LoadModel() {
+        auto model = CreateReference<AIModelResource>("scale_by_mask");
+        AIModelLoadOptions options;
+        options.warmup = false;
+        options.cacheOptimizedModel = false;    // Keep the fixture directory clean
+        model->SetLoadOptions(options);
+        CHECK(model->Load(FixturePath("InferenceContext/scale_by_mask.onnx")));
+        return model;
+    }
+
+    // Writes ids 1..length with every position unmasked and runs the prepared bucket
+    bool RunSequence(AIModelResource& model, InferenceContext& context, size_t length) {
+        if (!context.Prepare(length)) {
+            return false;
+        }
+
+        std::span<I64> ids = context.GetInput<I64>(0);
+        std::span<I64> mask = context.GetInput<I64>(1);
+        for (size_t t = 0; t < length; ++t) {
+            ids[t] = static_cast<I64>(t + 1);
+            mask[t] = 1;
+        }
+        return model.RunInference(context);
+    }
+
+} // anonymous namespace
+
+AGK_TEST(InferenceContext, DescribesModelTensors)
+{
+    Reference<AIModelResource> model = LoadModel();
+    Scope<InferenceContext> context = model->CreateInferenceContext(c_maxSequenceLength);
+    CHECK(context != nullptr);
+
+    CHECK_EQ(context->GetInputCount(), 2u);
+    CHECK_EQ(context->GetOutputCount(), 1u);
+    CHECK_EQ(context->GetInputName(0), String("ids"));
+    CHECK_EQ(context->GetInputName(1), String("mask"));
+    CHECK_EQ(context->GetOutputName(0), String("scores"));
+    CHECK(context->HasSequenceAxis(0));
+    CHECK(context->GetInputType(0) == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64);
+    CHECK(context->GetOutputType(0) == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+
+    // Two int64 inputs and a float output at the longest bucket, each rounded up to a cache line
+    CHECK(context->GetArenaBytes() >= c_maxSequenceLength * (8 + 8 + 4 * c_scoreWidth));
+
+    // Element types are checked, lengths outside 1..max are rejected
+    CHECK(context->Prepare(1));
+    CHECK(context->GetInput<F32>(0).empty());
+    CHECK(!context->Prepare(0));
+    CHECK(!context->Prepare(c_maxSequenceLength + 1));
+}
+
+// Lengths inside, at and across bucket boundaries (16, 32, 64 and the 100 cap). Outputs are
+// trimmed to the valid positions and always read from the same arena.
+AGK_TEST(InferenceContext, RunsEveryBucketInPlace)
+{
+    Reference<AIModelResource> model = LoadModel();
+    Scope<InferenceContext> context = model->CreateInferenceContext(c_maxSequenceLength);
+    CHECK(context != nullptr);
+
+    const void* outputData = context->GetOutputRawData(0);
+    for (size_t length : { 5u, 16u, 17u, 3u, 40u, 100u, 33u }) {
+        auto lock = context->Lock();
+        CHECK(RunSequence(*model, *context, length));
+        CHECK_EQ(context->GetSequenceLength(), length);
+
+        std::span<const I64> shape = context->GetOutputShape(0);
+        CHECK_EQ(shape.size(), 3u);
+        CHECK_EQ(shape[1], static_cast<I64>(length));
+        CHECK_EQ(shape[2], static_cast<I64>(c_scoreWidth));
+
+        std::span<const F32> scores = context->GetOutput<F32>(0);
+        CHECK_EQ(scores.size(), length * c_scoreWidth);
+        CHECK(static_cast<const void*>(scores.data()) == outputData);
+        for (size_t t = 0; t < length; ++t) {
+            for (size_t k = 0; k < c_scoreWidth; ++k) {
+                CHECK_EQ(scores[t * c_scoreWidth + k], static_cast<F32>((t + 1) * (k + 1)));
+            }
+        }
+    }
+    CHECK(context->IsValid());
+}
+
+// A shorter run in a bucket a longer one used sees zeroed padding, so masked positions score 0
+AGK_TEST(InferenceContext, PrepareZeroesPaddingFromEarlierRuns)
+{
+    Reference<AIModelResource> model = LoadModel();
+    Scope<InferenceContext> context = model->CreateInferenceContext(c_maxSequenceLength);
+    CHECK(context != nullptr);
+
+    CHECK(RunSequence(*model, *context, 30));
+    CHECK(context->Prepare(20));
+
+    std::span<I64> ids = context->GetInput<I64>(0);
+    std::span<I64> mask = context->GetInput<I64>(1);
+    CHECK_EQ(ids.size(), 32u);
+    for (size_t t = 0; t < ids.size(); ++t) {
+        CHECK_EQ(ids[t], 0);
+        CHECK_EQ(mask[t], 0);
+    }
+
+    // Ids without a mask are hidden
+    for (size_t t = 0; t < 20; ++t) {
+        ids[t] = 7;
+        mask[t] = t % 2;
+    }
+    CHECK(model->RunInference(*context));
+    std::span<const F32> scores = context->GetOutput<F32>(0);
+    for (size_t t = 0; t < 20; ++t) {
+        CHECK_EQ(scores[t * c_scoreWidth], t % 2 ? 7.0f : 0.0f);
+    }
+}
+
+// Bound runs against the allocating overload, which builds and returns fresh tensors each call
+AGK_BENCHMARK(InferenceContext, BoundVsAllocatingRuns)
+{
+    constexpr U32 runs = 2000;
+    Reference<AIModelResource> model = LoadModel();
+    Scope<InferenceContext> context = model->CreateInferenceContext(c_maxSequenceLength);
+    CHECK(context != nullptr);
+
+    for (size_t length : { 16u, 64u }) {
+        CHECK(RunSequence(*model, *context, length));
+        Stopwatch timer;
+        for (U32 i = 0; i < runs; ++i) {
+            RunSequence(*model, *context, length);
+            DoNotOptimize(context->GetOutput<F32>(0)[0]);
+        }
+        ReportRate(std::format("bound, {} positions", length), runs, "runs", timer.ElapsedSeconds());
+
+        std::vector<I64> ids(length);
+        std::vector<I64> mask(length, 1);
+        for (size_t t = 0; t < length; ++t) ids[t] = static_cast<I64>(t + 1);
+        const std::vector<I64> shape = { 1, static_cast<I64>(length) };
+
+        timer.Restart();
+        for (U32 i = 0; i < runs; ++i) {
+            std::vector<Ort::Value> inputs;
+            inputs.push_back(AIModelResource::CreateInt64Tensor(ids, shape));
+            inputs.push_back(AIModelResource::CreateInt64Tensor(mask, shape));
+            std::vector<Ort::Value> outputs = model->RunInference(inputs);
+            DoNotOptimize(outputs);
+        }
+        ReportRate(std::format("allocating, {} positions", length), runs, "runs", timer.ElapsedSeconds());
+    }
+}
@@ -0,0 +1,169 @@
+// Engine/Tests/Angaraka.Tests/Source/AI/InferenceQueueTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/InferenceQueue.hpp>
+#include <future>
+#include <thread>
+
+using namespace Angaraka;
+using namespace Angaraka::AI;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // Records how each request ended, -1 while it has neither run nor been dropped
+    struct Outcomes {
+        std::mutex mutex;
+        std::vector<int> results;
+
+        InferenceTask MakeTask(InferencePriority priority, std::function<void()> run = {}) {
+            size_t index;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                index = results.size();
+                results.push_back(-1);
+            }
+
+            InferenceTask task;
+            task.priority = priority;
+            task.run = [this, index, run = std::move(run)]() {
+                if (run) run();
+                Set(index, 100);
+            };
+            task.drop = [this, index](InferenceDropReason reason) { Set(index, static_cast<int>(reason)); };
+            return task;
+        }
+
+        void Set(size_t index, int value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            results[index] = value;
+        }
+
+        int Get(size_t index) {
+            std::lock_guard<std::mutex> lock(mutex);
+            return results[index];
+        }
+    };
+
+    constexpr int c_ran = 100;
+
+    void WaitUntilRunning(const InferenceQueue& queue, size_t running) {
+        while (queue.GetStats().running != running) {
+            std::this_thread::yield();
+        }
+    }
+
+} // anonymous namespace
+
+// With the only slot held, a full queue turns away work that does not outrank anything waiting
+// and lets higher priority work evict the request that would run last. Only the first counts
+// as a rejection.
+AGK_TEST(InferenceQueue, FullQueueRejectsOrEvicts)
+{
+    Core::JobSystem::Get().Initialize(2);
+
+    InferenceQueueSettings settings;
+    settings.maxConcurrent = 1;
+    settings.maxQueueDepth = 2;
+    settings.reservedConversationSlots = 0;
+    InferenceQueue queue(settings);
+    Outcomes outcomes;
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    CHECK(queue.Submit(outcomes.MakeTask(InferencePriority::Normal, [released] { released.wait(); })));
+    WaitUntilRunning(queue, 1);
+
+    CHECK(queue.Submit(outcomes.MakeTask(InferencePriority::Normal)));         // 1
+    CHECK(queue.Submit(outcomes.MakeTask(InferencePriority::Normal)));         // 2
+    CHECK(queue.IsSaturated());
+
+    CHECK(!queue.Submit(outcomes.MakeTask(InferencePriority::Background)));    // 3, rejected
+    CHECK(!queue.Submit(outcomes.MakeTask(InferencePriority::Normal)));        // 4, rejected
+    CHECK(queue.Submit(outcomes.MakeTask(InferencePriority::Conversation)));   // 5, evicts 2
+
+    CHECK_EQ(outcomes.Get(3), static_cast<int>(InferenceDropReason::QueueFull));
+    CHECK_EQ(outcomes.Get(4), static_cast<int>(InferenceDropReason::QueueFull));
+    CHECK_EQ(outcomes.Get(2), static_cast<int>(InferenceDropReason::QueueFull));
+
+    InferenceQueueStats stats = queue.GetStats();
+    CHECK_EQ(stats.rejected, 2u);
+    CHECK_EQ(stats.evicted, 1u);
+    CHECK_EQ(stats.queued, 2u);
+
+    // Shutdown cancels whatever is still waiting, so let the queue empty first
+    release.set_value();
+    while (queue.GetStats().executed < 3) {
+        std::this_thread::yield();
+    }
+    queue.Shutdown();
+
+    CHECK_EQ(outcomes.Get(0), c_ran);
+    CHECK_EQ(outcomes.Get(1), c_ran);
+    CHECK_EQ(outcomes.Get(5), c_ran);
+    CHECK_EQ(queue.GetStats().cancelled, 0u);
+}
+
+// A request throwing something that is not a std::exception still frees its slot, so the
+// queue keeps running the requests behind it.
+AGK_TEST(InferenceQueue, ThrowingRequestFreesItsSlot)
+{
+    Core::JobSystem::Get().Initialize(2);
+
+    InferenceQueueSettings settings;
+    settings.maxConcurrent = 1;
+    settings.reservedConversationSlots = 0;
+    InferenceQueue queue(settings);
+
+    std::atomic<U32> ran{ 0 };
+    for (U32 i = 0; i < 4; ++i) {
+        InferenceTask task;
+        task.run = [&ran] { ran++; throw 42; };
+        CHECK(queue.Submit(std::move(task)));
+    }
+
+    std::promise<void> lastRan;
+    InferenceTask last;
+    last.run = [&lastRan] { lastRan.set_value(); };
+    CHECK(queue.Submit(std::move(last)));
+    lastRan.get_future().wait();
+    queue.Shutdown();
+
+    CHECK_EQ(ran.load(), 4u);
+    InferenceQueueStats stats = queue.GetStats();
+    CHECK_EQ(stats.executed, 5u);
+    CHECK_EQ(stats.running, 0u);
+}
+
+// Throwing drop callbacks do not stop the remaining ones from being called
+AGK_TEST(InferenceQueue, ThrowingDropCallbackDoesNotSkipOthers)
+{
+    Core::JobSystem::Get().Initialize(2);
+
+    InferenceQueueSettings settings;
+    settings.maxConcurrent = 1;
+    settings.reservedConversationSlots = 0;
+    InferenceQueue queue(settings);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    InferenceTask blocker;
+    blocker.run = [released] { released.wait(); };
+    CHECK(queue.Submit(std::move(blocker)));
+    WaitUntilRunning(queue, 1);
+
+    std::atomic<U32> dropped{ 0 };
+    for (U32 i = 0; i < 4; ++i) {
+        InferenceTask task;
+        task.ownerId = "npc";
+        task.run = [] {};
+        task.drop = [&dropped](InferenceDropReason) { dropped++; throw std::runtime_error("drop failed"); };
+        CHECK(queue.Submit(std::move(task)));
+    }
+
+    CHECK_EQ(queue.CancelForOwner("npc"), 4u);
+    CHECK_EQ(dropped.load(), 4u);
+
+    release.set_value();
+    queue.Shutdown();
+    CHECK_EQ(queue.GetStats().cancelled, 4u);
+}
@@ -0,0 +1,206 @@
+// Engine/Tests/Angaraka.Tests/Source/AI/SamplerTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/Sampler.hpp>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <set>
+
+using namespace Angaraka;
+using namespace Angaraka::AI;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    std::vector<F32> RandomLogits(size_t count, U32 seed) {
+        std::mt19937 random(seed);
+        std::normal_distribution<F32> logit(0.0f, 3.0f);
+        std::vector<F32> logits(count);
+        for (F32& value : logits) {
+            value = logit(random);
+        }
+        return logits;
+    }
+
+    // Logits whose softmax is exactly the given head probabilities, the rest of the vocabulary
+    // shares what is left
+    std::vector<F32> LogitsForProbabilities(std::initializer_list<F32> head, size_t vocabSize) {
+        F32 headMass = 0.0f;
+        std::vector<F32> logits;
+        for (F32 probability : head) {
+            logits.push_back(std::log(probability));
+            headMass += probability;
+        }
+        const F32 tail = std::log((1.0f - headMass) / static_cast<F32>(vocabSize - logits.size()));
+        logits.resize(vocabSize, tail);
+        return logits;
+    }
+
+    // Feeds each sampled token back as history, like a decode loop
+    std::vector<I64> SampleSequence(LogitsSampler& sampler, std::span<const F32> logits, size_t count) {
+        std::vector<I64> tokens;
+        for (size_t i = 0; i < count; ++i) {
+            tokens.push_back(sampler.Sample(logits, tokens));
+        }
+        return tokens;
+    }
+
+    std::set<I64> TopIds(std::span<const F32> logits, size_t count) {
+        std::vector<I64> ids(logits.size());
+        std::iota(ids.begin(), ids.end(), I64(0));
+        std::partial_sort(ids.begin(), ids.begin() + count, ids.end(),
+            [&logits](I64 a, I64 b) { return logits[a] > logits[b]; });
+        return std::set<I64>(ids.begin(), ids.begin() + count);
+    }
+
+} // anonymous namespace
+
+// Every sampling path (full vocabulary, top-k, nucleus), with and without a repetition penalty
+AGK_TEST(Sampler, SameSeedReproducesTokens)
+{
+    const std::vector<F32> logits = RandomLogits(5000, 1);
+
+    std::vector<SamplingParams> modes(4);
+    modes[1].topK = 40;
+    modes[2].topP = 0.9f;
+    modes[3].topK = 100;
+    modes[3].topP = 0.8f;
+    modes[3].temperature = 0.7f;
+    modes[3].repetitionPenalty = 1.3f;
+
+    for (const SamplingParams& params : modes) {
+        LogitsSampler first(params);
+        LogitsSampler second(params);
+        const std::vector<I64> tokens = SampleSequence(first, logits, 200);
+        CHECK(SampleSequence(second, logits, 200) == tokens);
+
+        // Reseeding restarts the same stream, another seed gives another one
+        first.Reseed(params.seed);
+        CHECK(SampleSequence(first, logits, 200) == tokens);
+        first.Reseed(params.seed + 1);
+        CHECK(SampleSequence(first, logits, 200) != tokens);
+    }
+}
+
+AGK_TEST(Sampler, TopKOnlyDrawsTheKMostLikely)
+{
+    const std::vector<F32> logits = RandomLogits(1000, 2);
+    const std::set<I64> top = TopIds(logits, 5);
+
+    SamplingParams params;
+    params.topK = 5;
+    LogitsSampler sampler(params);
+
+    F32 normalizer = 0.0f;
+    for (I64 id : top) {
+        normalizer += std::exp(logits[id]);
+    }
+
+    std::set<I64> seen;
+    for (U32 i = 0; i < 2000; ++i) {
+        const I64 token = sampler.Sample(logits);
+        CHECK(top.contains(token));
+        seen.insert(token);
+
+        // Renormalized over the five candidates only
+        CHECK_NEAR(sampler.GetLastLogProbability(), logits[token] - std::log(normalizer), 1e-4);
+    }
+    CHECK_EQ(seen.size(), top.size());
+}
+
+// Head probabilities 0.5, 0.3, 0.15: a 0.75 nucleus needs the first two, 0.9 the first three.
+// The vocabulary is larger than the first candidate batch, so the nucleus path has to grow it.
+AGK_TEST(Sampler, TopPKeepsSmallestNucleus)
+{
+    const std::vector<F32> logits = LogitsForProbabilities({ 0.5f, 0.3f, 0.15f }, 4000);
+
+    for (auto [topP, kept] : { std::pair{ 0.75f, size_t(2) }, std::pair{ 0.9f, size_t(3) } }) {
+        SamplingParams params;
+        params.topP = topP;
+        LogitsSampler sampler(params);
+
+        const F32 keptMass = kept == 2 ? 0.8f : 0.95f;
+        constexpr U32 draws = 4000;
+        U32 first = 0;
+        for (U32 i = 0; i < draws; ++i) {
+            const I64 token = sampler.Sample(logits);
+            CHECK(token >= 0 && static_cast<size_t>(token) < kept);
+            CHECK_NEAR(sampler.GetLastLogProbability(), logits[token] - std::log(keptMass), 1e-4);
+            first += token == 0 ? 1 : 0;
+        }
+
+        // Token 0 holds 0.5 of the kept mass, give or take sampling noise
+        CHECK_NEAR(static_cast<F64>(first) / draws, 0.5 / keptMass, 0.04);
+    }
+
+    // With a nucleus of 1 and every token a candidate, the tail stays reachable
+    SamplingParams everything;
+    everything.topP = 1.0f;
+    everything.topK = 4000;
+    LogitsSampler sampler(everything);
+    bool tailDrawn = false;
+    for (U32 i = 0; i < 4000 && !tailDrawn; ++i) {
+        tailDrawn = sampler.Sample(logits) >= 3;
+    }
+    CHECK(tailDrawn);
+}
+
+// The SSE2 path runs for 8 or more logits in blocks of four, the rest is a scalar tail. The
+// maximum is placed at every position of every length, including inside the tail.
+AGK_TEST(Sampler, ArgMaxFindsFirstMaximumInEveryLane)
+{
+    for (size_t count = 1; count <= 37; ++count) {
+        std::vector<F32> logits = RandomLogits(count, static_cast<U32>(count));
+        for (F32& value : logits) {
+            value = std::min(value, 10.0f);
+        }
+
+        for (size_t position = 0; position < count; ++position) {
+            std::vector<F32> row = logits;
+            row[position] = 50.0f;
+            CHECK_EQ(LogitsSampler::ArgMax(row), static_cast<I64>(position));
+
+            // A later tie, in a lane or the tail, does not win
+            for (size_t later = position + 1; later < count; ++later) {
+                std::vector<F32> tied = row;
+                tied[later] = 50.0f;
+                CHECK_EQ(LogitsSampler::ArgMax(tied), static_cast<I64>(position));
+            }
+        }
+    }
+
+    // All equal and all negative
+    CHECK_EQ(LogitsSampler::ArgMax(std::vector<F32>(13, -2.0f)), I64(0));
+    CHECK_EQ(LogitsSampler::ArgMax(std::span<const F32>()), I64(-1));
+}
+
+// Temperature 0 and top-k 1 are both greedy: the argmax, with certainty, unless the repetition
+// penalty pushed it below the runner up
+AGK_TEST(Sampler, GreedySamplingPicksArgMax)
+{
+    const std::vector<F32> logits = RandomLogits(1003, 4);
+    const I64 best = LogitsSampler::ArgMax(logits);
+
+    SamplingParams cold;
+    cold.temperature = 0.0f;
+    SamplingParams topOne;
+    topOne.topK = 1;
+
+    for (const SamplingParams& params : { cold, topOne }) {
+        LogitsSampler sampler(params);
+        for (U32 i = 0; i < 10; ++i) {
+            CHECK_EQ(sampler.Sample(logits), best);
+            CHECK_EQ(sampler.GetLastLogProbability(), 0.0f);
+        }
+    }
+
+    // Penalize the winner hard enough that the second best takes over
+    std::vector<F32> penalized = logits;
+    penalized[best] = std::numeric_limits<F32>::lowest();
+    const I64 runnerUp = LogitsSampler::ArgMax(penalized);
+
+    cold.repetitionPenalty = 1000.0f;
+    LogitsSampler sampler(cold);
+    const I64 history[] = { best };
+    CHECK_EQ(sampler.Sample(logits, history), runnerUp);
+}
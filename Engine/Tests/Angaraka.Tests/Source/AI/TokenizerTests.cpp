@@ -0,0 +1,123 @@
+// Engine/Tests/Angaraka.Tests/Source/AI/TokenizerTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/Tokenizer.hpp>
+#include <fstream>
+
+using namespace Angaraka;
+using namespace Angaraka::AI;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    struct GoldenCase {
+        String text;
+        std::vector<I64> ids;
+    };
+
+    // Fixtures/Tokenizer holds a small BPE vocabulary and golden ids produced by an independent
+    // reference encoder; generate_fixture.py in the same directory regenerates them.
+    void LoadFixture(Tokenizer& tokenizer) {
+        CHECK(tokenizer.LoadTokenizer(FixturePath("Tokenizer/tokenizer_vocab.json"), FixturePath("Tokenizer/special_tokens.json")));
+        CHECK(tokenizer.CanEncode());
+    }
+
+    std::vector<GoldenCase> LoadGoldenCases() {
+        std::ifstream file(FixturePath("Tokenizer/golden_ids.json"));
+        CHECK(file.is_open());
+
+        nlohmann::json json = nlohmann::json::parse(file);
+        std::vector<GoldenCase> cases;
+        for (const auto& entry : json) {
+            cases.push_back({ entry["text"].get<String>(), entry["ids"].get<std::vector<I64>>() });
+        }
+        CHECK(!cases.empty());
+        return cases;
+    }
+
+    // Compared as strings so a mismatch prints both id sequences
+    String FormatIds(const std::vector<I64>& ids) {
+        String text;
+        for (I64 id : ids) {
+            text += std::format("{} ", id);
+        }
+        return text;
+    }
+
+} // anonymous namespace
+
+AGK_TEST(Tokenizer, LoadsFixtureVocabularyAndMerges)
+{
+    Tokenizer tokenizer;
+    LoadFixture(tokenizer);
+
+    CHECK_EQ(tokenizer.GetVocabularySize(), 557u);
+    CHECK_EQ(tokenizer.GetMergeCount(), 300u);
+    CHECK_EQ(tokenizer.GetEosTokenId(), 556);
+}
+
+// Each text is encoded twice so the second pass is served from the word cache, then again with
+// a cache small enough to evict on nearly every word.
+AGK_TEST(Tokenizer, EncodeMatchesGoldenIds)
+{
+    Tokenizer tokenizer;
+    LoadFixture(tokenizer);
+    std::vector<GoldenCase> cases = LoadGoldenCases();
+
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const GoldenCase& golden : cases) {
+            CHECK_EQ(FormatIds(tokenizer.Encode(golden.text)), FormatIds(golden.ids));
+        }
+    }
+    CHECK(tokenizer.GetEncodeCacheSize() > 0);
+
+    tokenizer.SetEncodeCacheCapacity(3);
+    CHECK(tokenizer.GetEncodeCacheSize() <= 3);
+    for (const GoldenCase& golden : cases) {
+        CHECK_EQ(FormatIds(tokenizer.Encode(golden.text)), FormatIds(golden.ids));
+    }
+    CHECK(tokenizer.GetEncodeCacheSize() <= 3);
+}
+
+AGK_TEST(Tokenizer, DecodedBytesRoundTripGoldenIds)
+{
+    Tokenizer tokenizer;
+    LoadFixture(tokenizer);
+
+    for (const GoldenCase& golden : LoadGoldenCases()) {
+        String decoded;
+        for (I64 id : golden.ids) {
+            decoded += tokenizer.DecodeTokenBytes(id);
+        }
+        CHECK_EQ(decoded, golden.text);
+    }
+}
+
+// Encode throughput over the golden texts repeated to ~4 MB, with the word cache disabled and
+// with the default capacity (warmed by an untimed pass).
+AGK_BENCHMARK(Tokenizer, EncodeThroughput)
+{
+    Tokenizer tokenizer;
+    LoadFixture(tokenizer);
+
+    String corpus;
+    for (const GoldenCase& golden : LoadGoldenCases()) {
+        corpus += golden.text;
+    }
+    while (corpus.size() < 4 * 1024 * 1024) {
+        corpus += corpus;
+    }
+    const F64 megabytes = static_cast<F64>(corpus.size()) / (1024.0 * 1024.0);
+
+    tokenizer.SetEncodeCacheCapacity(0);
+    Stopwatch timer;
+    std::vector<I64> ids = tokenizer.Encode(corpus);
+    ReportRate(std::format("uncached, {} tokens", ids.size()), megabytes, "MB", timer.ElapsedSeconds());
+    DoNotOptimize(ids);
+
+    tokenizer.SetEncodeCacheCapacity(4096);
+    DoNotOptimize(tokenizer.Encode(corpus));
+    timer.Restart();
+    ids = tokenizer.Encode(corpus);
+    ReportRate(std::format("cached, {} words", tokenizer.GetEncodeCacheSize()), megabytes, "MB", timer.ElapsedSeconds());
+    DoNotOptimize(ids);
+}
@@ -0,0 +1,232 @@
+// Engine/Tests/Angaraka.Tests/Source/Core/AssetLoadQueueTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/Asset/LoadQueue.hpp>
+#include <map>
+#include <random>
+
+using namespace Angaraka;
+using namespace Angaraka::Core;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    AssetDefinition MakeAsset(const String& id, AssetPriority priority) {
+        AssetDefinition asset;
+        asset.id = id;
+        asset.path = id + ".png";
+        asset.priority = priority;
+        return asset;
+    }
+
+    // Ids in the order the queue hands them out, e.g. "a b c "
+    String DrainIds(AssetLoadQueue& queue) {
+        String ids;
+        while (auto request = queue.DequeueNextAsset()) {
+            ids += request->asset.id + " ";
+        }
+        return ids;
+    }
+
+    AssetBundleConfig MakeBundle(const String& name, U32 first, U32 count, U32 seed) {
+        AssetBundleConfig bundle;
+        bundle.name = name;
+        bundle.assets.reserve(count);
+        std::mt19937 random(seed);
+        for (U32 i = first; i < first + count; ++i) {
+            bundle.assets.push_back(MakeAsset(std::format("bundle/asset_{}", i), random() % 128));
+        }
+        return bundle;
+    }
+
+} // anonymous namespace
+
+AGK_TEST(AssetLoadQueue, DequeuesByPriorityThenRequestOrder)
+{
+    AssetLoadQueue queue;
+    queue.EnqueueAsset(MakeAsset("low", PRIORITY_LOW), "b");
+    queue.EnqueueAsset(MakeAsset("medium1", PRIORITY_MEDIUM), "b");
+    queue.EnqueueAsset(MakeAsset("critical", PRIORITY_CRITICAL), "b");
+    queue.EnqueueAsset(MakeAsset("medium2", PRIORITY_MEDIUM), "b");
+    queue.EnqueueAsset(MakeAsset("medium1", PRIORITY_LOW), "b");     // Duplicate, less urgent: ignored
+
+    CHECK_EQ(queue.GetQueueSize(), 4u);
+    CHECK(queue.IsAssetQueued("medium1"));
+    CHECK_EQ(DrainIds(queue), String("critical medium1 medium2 low "));
+    CHECK_EQ(queue.GetLoadingCount(), 4u);
+    CHECK_EQ(queue.GetAssetStatus("low"), LoadStatus::Loading);
+}
+
+// A more urgent request for a queued asset moves it up and chains its callback onto the
+// existing request, so both requesters hear about the one load
+AGK_TEST(AssetLoadQueue, ReEnqueueRaisesPriorityAndChainsCallbacks)
+{
+    AssetLoadQueue queue;
+    String calls;
+    queue.EnqueueAsset(MakeAsset("a", PRIORITY_MEDIUM), "first");
+    queue.EnqueueAsset(MakeAsset("b", PRIORITY_MEDIUM), "first",
+        [&](const LoadRequest& request) { calls += "first:" + request.bundleName + " "; });
+    queue.EnqueueAsset(MakeAsset("b", PRIORITY_HIGH), "second",
+        [&](const LoadRequest& request) { calls += "second:" + request.bundleName + " "; });
+    CHECK_EQ(queue.GetQueueSize(), 2u);
+
+    auto next = queue.DequeueNextAsset();
+    CHECK(next.has_value());
+    CHECK_EQ(next->asset.id, String("b"));
+    CHECK_EQ(next->asset.priority, PRIORITY_HIGH);
+
+    queue.MarkAssetCompleted("b", nullptr, "missing file");
+    CHECK_EQ(calls, String("first:first second:second "));
+    CHECK_EQ(queue.GetAssetStatus("b"), LoadStatus::Failed);
+}
+
+AGK_TEST(AssetLoadQueue, UpdateAssetPriorityMovesBothWays)
+{
+    AssetLoadQueue queue;
+    for (const char* id : { "a", "b", "c", "d", "e" }) {
+        queue.EnqueueAsset(MakeAsset(id, PRIORITY_MEDIUM), "bundle");
+    }
+
+    CHECK(queue.UpdateAssetPriority("d", PRIORITY_CRITICAL));
+    CHECK(queue.UpdateAssetPriority("a", PRIORITY_LOW));
+    CHECK(queue.UpdateAssetPriority("c", PRIORITY_HIGH));
+    CHECK(!queue.UpdateAssetPriority("missing", PRIORITY_HIGH));
+
+    auto pending = queue.GetPendingRequests();
+    CHECK_EQ(pending.size(), 5u);
+    CHECK_EQ(pending.front().asset.id, String("d"));
+    CHECK_EQ(pending.back().asset.id, String("a"));
+    CHECK_EQ(DrainIds(queue), String("d c b e a "));
+
+    // Dequeued assets are no longer pending and cannot be re-prioritized
+    CHECK(!queue.UpdateAssetPriority("d", PRIORITY_LOW));
+}
+
+AGK_TEST(AssetLoadQueue, CancelRemovesFromAnyHeapPosition)
+{
+    AssetLoadQueue queue;
+    std::vector<LoadStatus> cancelledStatus;
+    auto onComplete = [&](const LoadRequest& request) { cancelledStatus.push_back(request.status); };
+    for (U32 i = 0; i < 8; ++i) {
+        queue.EnqueueAsset(MakeAsset(std::format("a{}", i), PRIORITY_LOW - i * 10), "ui", onComplete);
+        queue.EnqueueAsset(MakeAsset(std::format("b{}", i), PRIORITY_HIGH + i), "level", onComplete);
+    }
+
+    CHECK(queue.CancelAsset("b0"));                     // The root
+    CHECK(queue.CancelAsset("a0"));                     // A leaf
+    CHECK(queue.CancelAsset("a7"));
+    CHECK(!queue.CancelAsset("a0"));
+    CHECK_EQ(queue.GetAssetStatus("a0"), LoadStatus::Cancelled);
+    CHECK(!queue.IsAssetQueued("a0"));
+
+    CHECK_EQ(queue.CancelBundle("level"), 7u);
+    CHECK_EQ(queue.GetQueueSize(), 6u);
+    CHECK_EQ(cancelledStatus.size(), 10u);
+    for (LoadStatus status : cancelledStatus) {
+        CHECK_EQ(status, LoadStatus::Cancelled);
+    }
+
+    // Freed slots are reused and the heap order survives the removals
+    queue.EnqueueAsset(MakeAsset("late", PRIORITY_CRITICAL), "ui");
+    CHECK_EQ(DrainIds(queue), String("late a6 a5 a4 a3 a2 a1 "));
+}
+
+// Random enqueues, re-prioritizations, cancellations and dequeues checked against an ordered
+// map of (priority, request order) -> id
+AGK_TEST(AssetLoadQueue, RandomOperationsMatchReferenceOrder)
+{
+    AssetLoadQueue queue;
+    std::map<std::pair<AssetPriority, U32>, String> reference;
+    std::unordered_map<String, std::pair<AssetPriority, U32>> keys;
+    U32 sequence = 0;
+    U32 nextId = 0;
+
+    auto eraseKey = [&](const String& id) {
+        reference.erase(keys[id]);
+        keys.erase(id);
+    };
+    auto setKey = [&](const String& id, AssetPriority priority) {
+        keys[id] = { priority, sequence++ };
+        reference[keys[id]] = id;
+    };
+
+    std::mt19937 random(5);
+    for (U32 step = 0; step < 20000; ++step) {
+        const U32 operation = random() % 10;
+        const AssetPriority priority = random() % 64;
+        if (operation < 4 || keys.empty()) {
+            // New asset, or a duplicate that only counts when more urgent
+            String id = std::format("asset_{}", (random() % 4 == 0 && nextId > 0) ? random() % nextId : nextId++);
+            auto existing = keys.find(id);
+            queue.EnqueueAsset(MakeAsset(id, priority), "bundle");
+            if (existing == keys.end() && !queue.IsAssetLoading(id)) {
+                setKey(id, priority);
+            }
+            else if (existing != keys.end() && priority < existing->second.first) {
+                eraseKey(id);
+                setKey(id, priority);
+            }
+            continue;
+        }
+
+        auto it = reference.begin();
+        std::advance(it, random() % reference.size());
+        const String id = it->second;
+        if (operation < 6) {
+            CHECK(queue.UpdateAssetPriority(id, priority));
+            eraseKey(id);
+            setKey(id, priority);
+        }
+        else if (operation < 7) {
+            CHECK(queue.CancelAsset(id));
+            eraseKey(id);
+        }
+        else {
+            auto request = queue.DequeueNextAsset();
+            CHECK(request.has_value());
+            CHECK_EQ(request->asset.id, reference.begin()->second);
+            eraseKey(request->asset.id);
+            queue.MarkAssetCompleted(request->asset.id, nullptr, "not loaded");
+        }
+        CHECK_EQ(queue.GetQueueSize(), reference.size());
+    }
+
+    for (const auto& [key, id] : reference) {
+        auto request = queue.DequeueNextAsset();
+        CHECK(request.has_value());
+        CHECK_EQ(request->asset.id, id);
+    }
+    CHECK(!queue.DequeueNextAsset().has_value());
+}
+
+// Enqueues a 100k-asset bundle, then a second bundle that re-requests half of it at higher
+// priority, then drains the queue.
+AGK_BENCHMARK(AssetLoadQueue, Enqueue100kAssetBundle)
+{
+    constexpr U32 assetCount = 100000;
+    const AssetBundleConfig bundle = MakeBundle("world", 0, assetCount, 1);
+    AssetBundleConfig overlapping = MakeBundle("district", assetCount / 2, assetCount, 2);
+    for (auto& asset : overlapping.assets) {
+        asset.priority /= 4;
+    }
+
+    for (U32 run = 0; run < 3; ++run) {
+        AssetLoadQueue queue;
+
+        Stopwatch timer;
+        queue.EnqueueBundle(bundle);
+        ReportRate("EnqueueBundle, 100k new assets", assetCount, "assets", timer.ElapsedSeconds());
+
+        timer.Restart();
+        queue.EnqueueBundle(overlapping);
+        ReportRate("EnqueueBundle, 50k re-prioritized + 50k new", assetCount, "assets", timer.ElapsedSeconds());
+        CHECK_EQ(queue.GetQueueSize(), size_t(assetCount + assetCount / 2));
+
+        timer.Restart();
+        size_t drained = 0;
+        while (queue.DequeueNextAsset()) {
+            ++drained;
+        }
+        ReportRate("DequeueNextAsset, 150k", static_cast<F64>(drained), "assets", timer.ElapsedSeconds());
+        CHECK_EQ(drained, size_t(assetCount + assetCount / 2));
+    }
+}
@@ -0,0 +1,153 @@
+// Engine/Tests/Angaraka.Tests/Source/Core/EventsTests.cpp
+#include "../TestFramework.hpp"
+#include <latch>
+#include <thread>
+
+import Angaraka.Core.Events;
+
+using namespace Angaraka;
+using namespace Angaraka::Events;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    class PingEvent : public Event {
+    public:
+        explicit PingEvent(U32 value = 0) : value(value) {}
+
+        static size_t GetStaticType_s() { return GetEventTypeId<PingEvent>(); }
+        size_t GetStaticType() const override { return GetStaticType_s(); }
+        const char* GetName() const override { return "PingEvent"; }
+        int GetCategoryFlags() const override { return static_cast<int>(EventCategory::Application); }
+
+        U32 value;
+    };
+
+    // Listener side effect that does not race between broadcasting threads
+    thread_local U64 t_pingSum = 0;
+
+    // Subscribes a listener that keeps 'token' alive for as long as some dispatch table holds it
+    SubscriptionID SubscribeHolding(EventManager& events, const Reference<U32>& token) {
+        return events.Subscribe<PingEvent>([token](const Event&) {});
+    }
+
+} // anonymous namespace
+
+// With no broadcast in flight, the table an unsubscribe replaces is freed right away
+AGK_TEST(Events, UnsubscribeFreesReplacedTableWhenIdle)
+{
+    EventManager events;
+    auto token = CreateReference<U32>(0u);
+    SubscriptionID id = SubscribeHolding(events, token);
+    CHECK_EQ(token.use_count(), 2);
+
+    events.Unsubscribe<PingEvent>(id);
+    CHECK_EQ(token.use_count(), 1);
+}
+
+// A broadcast pinned inside a callback keeps its table alive. The broadcast frees the table itself
+// on the way out, without waiting for another Subscribe or Unsubscribe.
+AGK_TEST(Events, BroadcastReclaimsTableRetiredWhileItRan)
+{
+    EventManager events;
+    auto token = CreateReference<U32>(0u);
+    SubscriptionID holder = SubscribeHolding(events, token);
+
+    std::latch inCallback(1);
+    std::latch release(1);
+    std::atomic<U32> delivered{ 0 };
+    events.Subscribe<PingEvent>([&](const Event& event) {
+        delivered++;
+        if (static_cast<const PingEvent&>(event).value == 1) {
+            inCallback.count_down();
+            release.wait();
+        }
+    });
+
+    std::thread broadcaster([&events] { events.Broadcast(PingEvent(1)); });
+    inCallback.wait();
+
+    events.Unsubscribe<PingEvent>(holder);
+    CHECK_EQ(token.use_count(), 2);
+
+    release.count_down();
+    broadcaster.join();
+    CHECK_EQ(token.use_count(), 1);
+
+    events.Broadcast(PingEvent(2));
+    CHECK_EQ(delivered.load(), 2u);
+}
+
+// Listeners come and go while other threads broadcast; every retired table must outlive its readers
+// and be freed once they leave
+AGK_TEST(Events, ConcurrentBroadcastsAndResubscribesReclaimEveryTable)
+{
+    EventManager events;
+    auto token = CreateReference<U32>(0u);
+    std::atomic<U64> sum{ 0 };
+    events.Subscribe<PingEvent>([&sum](const Event& event) { sum += static_cast<const PingEvent&>(event).value; });
+
+    constexpr U32 broadcastsPerThread = 20000;
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> broadcasters;
+    for (U32 t = 0; t < 4; ++t) {
+        broadcasters.emplace_back([&events] {
+            for (U32 i = 0; i < broadcastsPerThread; ++i) {
+                events.Broadcast(PingEvent(1));
+            }
+        });
+    }
+    std::thread writer([&] {
+        while (!done.load()) {
+            events.Unsubscribe<PingEvent>(SubscribeHolding(events, token));
+        }
+    });
+
+    for (auto& broadcaster : broadcasters) {
+        broadcaster.join();
+    }
+    done = true;
+    writer.join();
+
+    CHECK_EQ(sum.load(), U64(4) * broadcastsPerThread);
+    events.Broadcast(PingEvent(0));
+    CHECK_EQ(token.use_count(), 1);
+}
+
+AGK_BENCHMARK(Events, BroadcastNsPerListenerCount)
+{
+    constexpr U32 broadcasts = 1000000;
+    const U32 threadCounts[] = { 1, 4 };
+
+    for (U32 listeners : { 1u, 10u, 100u }) {
+        EventManager events;
+        for (U32 i = 0; i < listeners; ++i) {
+            events.Subscribe<PingEvent>([](const Event& event) {
+                t_pingSum += static_cast<const PingEvent&>(event).value;
+            });
+        }
+
+        for (U32 threads : threadCounts) {
+            // Each thread broadcasts its share; ns/op is wall time per broadcast across all threads
+            const U32 perThread = broadcasts / threads;
+            std::latch start(threads + 1);
+            std::vector<std::thread> workers;
+            for (U32 t = 0; t < threads; ++t) {
+                workers.emplace_back([&events, &start, perThread] {
+                    start.arrive_and_wait();
+                    for (U32 i = 0; i < perThread; ++i) {
+                        events.Broadcast(PingEvent(i));
+                    }
+                });
+            }
+
+            start.arrive_and_wait();
+            Stopwatch timer;
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            ReportNsPerOp(std::format("Broadcast, {} listeners, {} threads", listeners, threads),
+                static_cast<F64>(perThread) * threads, timer.ElapsedSeconds());
+        }
+    }
+}
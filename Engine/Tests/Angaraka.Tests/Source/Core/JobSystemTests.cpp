@@ -0,0 +1,139 @@
+// Engine/Tests/Angaraka.Tests/Source/Core/JobSystemTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/JobSystem.hpp>
+#include <latch>
+
+using namespace Angaraka;
+using namespace Angaraka::Core;
+using namespace Angaraka::Tests;
+
+AGK_TEST(JobSystem, ParallelForRunsEveryIndexOnce)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Initialize(4);
+
+    std::vector<std::atomic<U32>> visits(10000);
+    jobs.ParallelFor(visits.size(), 64, [&visits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) visits[i]++;
+    });
+
+    for (const auto& visit : visits) {
+        CHECK_EQ(visit.load(), 1u);
+    }
+}
+
+// Every worker is inside a job that waits on lower priority work queued behind it, so nobody
+// is left to run that work unless Wait runs it itself instead of sleeping.
+AGK_TEST(JobSystem, NestedParallelForInsideJobsCompletes)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Initialize(2);
+
+    const size_t outerCount = jobs.GetWorkerCount();
+    std::latch allWorkersBusy(static_cast<std::ptrdiff_t>(outerCount));
+    std::atomic<size_t> innerTotal{ 0 };
+    JobHandle outer = jobs.CreateCounter();
+
+    for (size_t i = 0; i < outerCount; ++i) {
+        jobs.Submit([&jobs, &innerTotal, &allWorkersBusy] {
+            allWorkersBusy.arrive_and_wait();
+            jobs.ParallelFor(256, 16, [&innerTotal](size_t begin, size_t end) {
+                innerTotal.fetch_add(end - begin);
+            }, JobPriority::Low);
+        }, JobPriority::Normal, outer);
+    }
+    jobs.Wait(outer);
+
+    CHECK_EQ(innerTotal.load(), outerCount * 256);
+}
+
+// The game thread waiting on frame work sleeps while the worker finishes it, rather than picking
+// up a queued asset load or inference request and stalling the frame on it.
+AGK_TEST(JobSystem, GameThreadWaitDoesNotRunLowerPriorityJobs)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Shutdown();
+    jobs.Initialize(1);
+
+    const std::thread::id gameThread = std::this_thread::get_id();
+    std::latch frameJobStarted(1);
+    JobHandle frame = jobs.CreateCounter();
+    jobs.Submit([&frameJobStarted] {
+        frameJobStarted.count_down();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }, JobPriority::High, frame);
+    frameJobStarted.wait();
+
+    // Queued while the only worker is busy with the frame job
+    std::atomic<U32> backgroundOnGameThread{ 0 };
+    JobHandle background = jobs.CreateCounter();
+    for (JobPriority priority : { JobPriority::Low, JobPriority::Normal }) {
+        jobs.Submit([&backgroundOnGameThread, gameThread] {
+            if (std::this_thread::get_id() == gameThread) backgroundOnGameThread++;
+        }, priority, background);
+    }
+
+    jobs.Wait(frame);
+    CHECK_EQ(backgroundOnGameThread.load(), 0u);
+    CHECK_EQ(frame->GetLowestPriority(), JobPriority::High);
+    CHECK_EQ(background->GetLowestPriority(), JobPriority::Low);
+
+    // Waiting on the background group itself may help with it
+    jobs.Wait(background);
+    CHECK(background->IsDone());
+
+    jobs.Shutdown();
+    jobs.Initialize();
+}
+
+AGK_TEST(JobSystem, ThenRunsAfterDependency)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Initialize(2);
+
+    std::atomic<U32> finished{ 0 };
+    std::atomic<U32> seenByContinuation{ 0 };
+    JobHandle first = jobs.CreateCounter();
+    JobHandle done = jobs.CreateCounter();
+
+    for (U32 i = 0; i < 16; ++i) {
+        jobs.Submit([&finished] { finished++; }, JobPriority::Low, first);
+    }
+    jobs.Then(first, [&] { seenByContinuation = finished.load(); }, JobPriority::High, done);
+    jobs.Wait(done);
+
+    CHECK_EQ(seenByContinuation.load(), 16u);
+}
+
+// Jobs still queued at shutdown are drained and may submit more work. That work runs inline
+// instead of re-entering Initialize, and the workers stay stopped until Initialize is called.
+AGK_TEST(JobSystem, ShutdownDrainsAndRunsLateSubmissionsInline)
+{
+    JobSystem& jobs = JobSystem::Get();
+    jobs.Shutdown();
+    jobs.Initialize(1);
+
+    std::atomic<U32> followUps{ 0 };
+    JobHandle counter = jobs.CreateCounter();
+    jobs.Submit([] { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }, JobPriority::High, counter);
+    for (U32 i = 0; i < 8; ++i) {
+        jobs.Submit([&jobs, &followUps, counter] {
+            jobs.Submit([&followUps] { followUps++; }, JobPriority::Normal, counter);
+        }, JobPriority::Low, counter);
+    }
+
+    jobs.Shutdown();
+    CHECK(!jobs.IsRunning());
+    CHECK(counter->IsDone());
+    CHECK_EQ(followUps.load(), 8u);
+
+    std::thread::id ranOn;
+    jobs.Submit([&ranOn] { ranOn = std::this_thread::get_id(); });
+    auto future = jobs.Async([] { return 42; });
+    CHECK(!jobs.IsRunning());
+    CHECK(ranOn == std::this_thread::get_id());
+    CHECK_EQ(future.get(), 42);
+
+    jobs.Initialize(2);
+    CHECK(jobs.IsRunning());
+}
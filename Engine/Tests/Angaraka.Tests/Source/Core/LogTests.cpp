@@ -0,0 +1,125 @@
+// Engine/Tests/Angaraka.Tests/Source/Core/LogTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/AIManager.hpp>
+#include <Angaraka/JobSystem.hpp>
+#include <spdlog/sinks/null_sink.h>
+
+import Angaraka.Core.Config;
+
+using namespace Angaraka;
+using namespace Angaraka::Logger;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // Installs an engine logger that formats into a null sink, restores the previous one after
+    class NullLoggerScope {
+    public:
+        explicit NullLoggerScope(spdlog::level::level_enum level)
+            : m_previous(Framework::GetCoreLogger())
+            , m_logger(CreateReference<spdlog::logger>("test_null", CreateReference<spdlog::sinks::null_sink_mt>()))
+        {
+            m_logger->set_level(level);
+            Framework::SetCoreLogger(m_logger);
+        }
+        ~NullLoggerScope() { Framework::SetCoreLogger(m_previous); }
+
+        void SetLevel(spdlog::level::level_enum level) { m_logger->set_level(level); }
+
+    private:
+        Reference<spdlog::logger> m_previous;
+        Reference<spdlog::logger> m_logger;
+    };
+
+    U32 s_evaluations = 0;
+
+    // Stands in for the per-token dumps on the dialogue path
+    String DescribeTokens(const std::vector<I64>& tokens) {
+        ++s_evaluations;
+        String text;
+        for (I64 token : tokens) {
+            text += std::format("{} ", token);
+        }
+        return text;
+    }
+
+    // Fixtures/Generation/dialogue_lm.onnx behind the tokenizer fixture and one faction config,
+    // loaded the way the game loads its dialogue resources
+    Scope<AI::AIManager> LoadDialogueManager() {
+        Config::AISystemConfig config;
+        config.warmupModels = false;
+        config.cacheOptimizedModels = false;    // Keep the fixture directory clean
+        config.enableResponseCache = false;     // Every request runs the whole path
+        config.dialogueBatchWindowMs = 0.0f;    // Time the path, not the batching window
+        config.maxDialogueTokens = 32;
+
+        auto manager = CreateScope<AI::AIManager>(config);
+        CHECK(manager->LoadSharedTokenizer(FixturePath("Tokenizer")));
+        manager->LoadFactionConfigs(FixturePath("Dialogue"));  // Only ashvattha has a config
+        CHECK(manager->IsFactionLoaded("ashvattha"));
+        CHECK(manager->LoadSharedDialogueModel(FixturePath("Generation/dialogue_lm.onnx")));
+        return manager;
+    }
+
+} // anonymous namespace
+
+AGK_TEST(Log, ArgumentsAreOnlyEvaluatedWhenWritten)
+{
+    const std::vector<I64> tokens = { 1, 2, 3 };
+    NullLoggerScope scope(spdlog::level::info);
+    s_evaluations = 0;
+
+    AGK_TRACE("Tokens: {}", DescribeTokens(tokens));
+    AGK_DEBUG("Tokens: {}", DescribeTokens(tokens));
+    CHECK_EQ(s_evaluations, 0u);
+    CHECK(!AGK_TRACE_ENABLED);
+    CHECK(!AGK_DEBUG_ENABLED);
+
+    AGK_INFO("Tokens: {}", DescribeTokens(tokens));
+    CHECK_EQ(s_evaluations, 1u);
+
+    // Trace is still skipped when the build compiles it out, whatever the runtime level
+    scope.SetLevel(spdlog::level::trace);
+    AGK_TRACE("Tokens: {}", DescribeTokens(tokens));
+    CHECK_EQ(s_evaluations, AGK_LOG_COMPILED(LogLevel::Trace) ? 2u : 1u);
+    CHECK_EQ(AGK_TRACE_ENABLED, AGK_LOG_COMPILED(LogLevel::Trace));
+
+    // No logger at all writes nothing and evaluates nothing
+    Framework::SetCoreLogger(nullptr);
+    AGK_ERROR("Tokens: {}", DescribeTokens(tokens));
+    CHECK_EQ(s_evaluations, AGK_LOG_COMPILED(LogLevel::Trace) ? 2u : 1u);
+}
+
+// Requests per second through GenerateDialogueSync: prompt build, tokenize, batched generation
+// and decode. The traces on that path are compiled out (Release) or filtered at runtime (Debug),
+// against the same requests writing them to a null sink; run both builds for the full picture.
+AGK_BENCHMARK(Log, DialogueTraceOnVsOff)
+{
+    constexpr U32 requests = 500;
+    Core::JobSystem::Get().Initialize(2);
+
+    NullLoggerScope scope(spdlog::level::info);
+    Scope<AI::AIManager> manager = LoadDialogueManager();
+
+    AI::DialogueRequest request;
+    request.factionId = "ashvattha";
+    request.npcId = "elder";
+    request.playerMessage = "What do the roots of the great tree remember?";
+
+    auto run = [&](const char* label) {
+        Stopwatch timer;
+        for (U32 i = 0; i < requests; ++i) {
+            AI::DialogueResponse response = manager->GenerateDialogueSync(request);
+            CHECK(response.trace.path == AI::DialoguePath::Generated);
+        }
+        ReportRate(label, requests, "requests", timer.ElapsedSeconds());
+    };
+
+    manager->GenerateDialogueSync(request);
+    run(AGK_LOG_COMPILED(LogLevel::Trace) ? "dialogue, trace filtered at runtime" : "dialogue, trace compiled out");
+
+    if constexpr (AGK_LOG_COMPILED(LogLevel::Trace)) {
+        scope.SetLevel(spdlog::level::trace);
+        run("dialogue, trace written to a null sink");
+    }
+}
@@ -0,0 +1,361 @@
+// Engine/Tests/Angaraka.Tests/Source/Core/ResourceCacheTests.cpp
+#include "../TestFramework.hpp"
+#include <Angaraka/ResourceCache.hpp>
+#include <Angaraka/Asset/BundleConfig.hpp>
+#include <algorithm>
+#include <barrier>
+#include <random>
+#include <thread>
+
+import Angaraka.Core.Resources;
+import Angaraka.Core.ResourceCache;
+import Angaraka.Core.GraphicsFactory;
+
+using namespace Angaraka;
+using namespace Angaraka::Core;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    class TestResource : public Resource {
+    public:
+        TestResource(const String& id, size_t size) : Resource(id), m_size(size) { m_isLoaded = true; }
+
+        size_t GetTypeId() const override { return 0x7E57; }
+        bool Load(const String&, void*) override { return true; }
+        void Unload() override {}
+        size_t GetSizeInBytes() const override { return m_size; }
+
+    private:
+        size_t m_size;
+    };
+
+    MemoryBudget MakeBudget(EvictionPolicy policy, size_t maxTotalMemory = 64 * 1024 * 1024) {
+        MemoryBudget budget;
+        budget.maxTotalMemory = maxTotalMemory;
+        budget.maxSingleResource = maxTotalMemory;
+        budget.evictionPolicy = policy;
+        budget.logEvictions = false;
+        return budget;
+    }
+
+    // Counts Create calls and the most that ever ran at once, in total and for meshes alone
+    struct FactoryCounters {
+        std::atomic<U32> calls{ 0 };
+        std::atomic<U32> active{ 0 };
+        std::atomic<U32> activeMeshes{ 0 };
+        std::atomic<U32> maxActive{ 0 };
+        std::atomic<U32> maxActiveMeshes{ 0 };
+    };
+
+    template<bool ThreadSafe>
+    class CountingFactory : public IGraphicsResourceFactory<CountingFactory<ThreadSafe>> {
+    public:
+        static constexpr bool IsThreadSafe = ThreadSafe;
+
+        explicit CountingFactory(Reference<FactoryCounters> counters) : m_counters(std::move(counters)) {}
+
+        Reference<Resource> CreateMeshImpl(const AssetDefinition& asset, void*) { return Create(asset, true); }
+        Reference<Resource> CreateTextureImpl(const AssetDefinition& asset, void*) { return Create(asset, false); }
+        Reference<Resource> CreateMaterialImpl(const AssetDefinition&, void*) { return nullptr; }
+        Reference<Resource> CreateSoundImpl(const AssetDefinition&, void*) { return nullptr; }
+
+    private:
+        Reference<FactoryCounters> m_counters;
+
+        static void RaiseMax(std::atomic<U32>& max, U32 value) {
+            U32 seen = max.load();
+            while (value > seen && !max.compare_exchange_weak(seen, value)) {}
+        }
+
+        Reference<Resource> Create(const AssetDefinition& asset, bool mesh) {
+            m_counters->calls++;
+            RaiseMax(m_counters->maxActive, m_counters->active.fetch_add(1) + 1);
+            if (mesh) {
+                RaiseMax(m_counters->maxActiveMeshes, m_counters->activeMeshes.fetch_add(1) + 1);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            if (mesh) {
+                m_counters->activeMeshes.fetch_sub(1);
+            }
+            m_counters->active.fetch_sub(1);
+            return CreateReference<TestResource>(asset.id, 1024);
+        }
+    };
+
+    // Loads every path from its own thread, all starting together
+    template<bool ThreadSafe>
+    std::vector<Reference<TestResource>> LoadConcurrently(const Reference<FactoryCounters>& counters,
+        const std::vector<String>& paths) {
+        CachedResourceManager manager("assets", MakeBudget(EvictionPolicy::LRU));
+        manager.SetGraphicsFactory(CreateReference<GraphicsResourceFactory>(CountingFactory<ThreadSafe>(counters)));
+
+        std::vector<Reference<TestResource>> results(paths.size());
+        std::barrier start(static_cast<std::ptrdiff_t>(paths.size()));
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < paths.size(); ++t) {
+            threads.emplace_back([&, t] {
+                start.arrive_and_wait();
+                results[t] = manager.GetResource<TestResource>(paths[t], paths[t]);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        return results;
+    }
+
+    String ResourceName(U32 index) {
+        return std::format("test/resource_{}", index);
+    }
+
+    constexpr EvictionPolicy c_policies[] = { EvictionPolicy::LRU, EvictionPolicy::Clock, EvictionPolicy::TinyLFU };
+
+    // An access trace as indices into a list of ids. Most lookups follow a Zipf distribution
+    // over the hot ids; with scans enabled, every scanInterval accesses a bundle of ids that
+    // are never asked for again is streamed through, as when a level bundle is reloaded.
+    std::vector<U32> MakeAccessTrace(U32 length, U32 hotIds, F64 skew, U32 scanInterval, U32 scanLength) {
+        std::vector<F64> cdf(hotIds);
+        F64 total = 0.0;
+        for (U32 i = 0; i < hotIds; ++i) {
+            total += 1.0 / std::pow(static_cast<F64>(i + 1), skew);
+            cdf[i] = total;
+        }
+
+        std::mt19937 random(23);
+        std::uniform_real_distribution<F64> uniform(0.0, total);
+        std::vector<U32> trace;
+        trace.reserve(length);
+        U32 nextScanId = hotIds;
+        while (trace.size() < length) {
+            if (scanInterval > 0 && trace.size() % scanInterval == scanInterval - 1) {
+                for (U32 i = 0; i < scanLength && trace.size() < length; ++i) {
+                    trace.push_back(nextScanId++);
+                }
+                continue;
+            }
+            trace.push_back(static_cast<U32>(std::lower_bound(cdf.begin(), cdf.end(), uniform(random)) - cdf.begin()));
+        }
+        return trace;
+    }
+
+} // anonymous namespace
+
+AGK_TEST(ResourceCache, PutThenGetCountsHitsAndMisses)
+{
+    for (EvictionPolicy policy : c_policies) {
+        ResourceCache cache(MakeBudget(policy));
+        auto resource = CreateReference<TestResource>("a", 100);
+        cache.Put("a", resource, 100);
+
+        CHECK(cache.Get("a") == resource);
+        CHECK(cache.Get("missing") == nullptr);
+        CHECK_EQ(cache.GetHitCount(), 1u);
+        CHECK_EQ(cache.GetMissCount(), 1u);
+        CHECK_EQ(cache.GetResourceCount(), 1u);
+        CHECK_EQ(cache.GetCurrentMemoryUsage(), 100u);
+
+        // Peek neither counts nor misses
+        CHECK(cache.Peek("a") == resource);
+        CHECK(cache.Peek("missing") == nullptr);
+        CHECK_EQ(cache.GetHitCount(), 1u);
+        CHECK_EQ(cache.GetMissCount(), 1u);
+
+        cache.Remove("a");
+        CHECK(cache.Peek("a") == nullptr);
+        CHECK_EQ(cache.GetCurrentMemoryUsage(), 0u);
+    }
+}
+
+AGK_TEST(ResourceCache, EvictionKeepsUsageUnderBudget)
+{
+    constexpr size_t resourceSize = 1024;
+    constexpr size_t budgetBytes = 64 * resourceSize;
+
+    for (EvictionPolicy policy : c_policies) {
+        ResourceCache cache(MakeBudget(policy, budgetBytes));
+        for (U32 i = 0; i < 512; ++i) {
+            String id = ResourceName(i);
+            cache.Put(id, CreateReference<TestResource>(id, resourceSize), resourceSize);
+            CHECK(cache.GetCurrentMemoryUsage() <= budgetBytes);
+        }
+        CHECK(cache.GetResourceCount() > 0);
+        CHECK(cache.GetEvictionStats().totalEvictions + cache.GetEvictionStats().admissionsRejected > 0);
+    }
+}
+
+AGK_TEST(ResourceCache, SetMemoryBudgetWhileReading)
+{
+    ResourceCache cache(MakeBudget(EvictionPolicy::Clock, 1024 * 1024));
+    for (U32 i = 0; i < 256; ++i) {
+        String id = ResourceName(i);
+        cache.Put(id, CreateReference<TestResource>(id, 1024), 1024);
+    }
+
+    std::atomic<bool> stop{ false };
+    std::vector<std::thread> readers;
+    for (U32 t = 0; t < 4; ++t) {
+        readers.emplace_back([&cache, &stop, t] {
+            U32 i = t;
+            while (!stop.load(std::memory_order_relaxed)) {
+                String id = ResourceName(i++ % 512);
+                if (!cache.Get(id)) {
+                    cache.Put(id, CreateReference<TestResource>(id, 1024), 1024);
+                }
+            }
+        });
+    }
+
+    for (U32 i = 0; i < 200; ++i) {
+        MemoryBudget budget = cache.GetMemoryBudget();
+        budget.maxTotalMemory = (i % 2 == 0) ? 128 * 1024 : 1024 * 1024;
+        budget.evictionThreshold = 80 + (i % 20);
+        cache.SetMemoryBudget(budget);
+    }
+    stop = true;
+    for (auto& reader : readers) reader.join();
+
+    MemoryBudget finalBudget = cache.GetMemoryBudget();
+    CHECK_EQ(finalBudget.maxTotalMemory, 1024u * 1024u);
+    CHECK_EQ(finalBudget.evictionPolicy, EvictionPolicy::Clock);
+}
+
+AGK_TEST(CachedResourceManager, ConcurrentMissesShareOneLoad)
+{
+    // Two ids requested four times each, so the shared load and the serialized factory are both exercised
+    std::vector<String> paths;
+    for (U32 t = 0; t < 8; ++t) {
+        paths.push_back((t % 2 == 0) ? "mesh_a.obj" : "mesh_b.obj");
+    }
+    auto counters = CreateReference<FactoryCounters>();
+    auto results = LoadConcurrently<false>(counters, paths);
+
+    CHECK_EQ(counters->calls.load(), 2u);
+    CHECK_EQ(counters->maxActiveMeshes.load(), 1u);
+    for (size_t t = 0; t < results.size(); ++t) {
+        CHECK(results[t] != nullptr);
+        CHECK(results[t] == results[t % 2]);
+    }
+    CHECK(results[0] != results[1]);
+}
+
+// A factory that is not thread-safe is locked per resource kind: meshes wait for meshes,
+// but a texture load runs alongside them
+AGK_TEST(CachedResourceManager, FactoryCallsAreSerializedPerKind)
+{
+    auto counters = CreateReference<FactoryCounters>();
+    auto results = LoadConcurrently<false>(counters, { "a.obj", "b.obj", "c.obj", "a.png", "b.png" });
+
+    CHECK_EQ(counters->calls.load(), 5u);
+    CHECK_EQ(counters->maxActiveMeshes.load(), 1u);
+    CHECK_EQ(counters->maxActive.load(), 2u);
+    for (const auto& result : results) {
+        CHECK(result != nullptr);
+    }
+}
+
+AGK_TEST(CachedResourceManager, ThreadSafeFactoriesLoadInParallel)
+{
+    auto counters = CreateReference<FactoryCounters>();
+    auto results = LoadConcurrently<true>(counters, { "a.obj", "b.obj", "c.obj", "d.obj" });
+
+    CHECK_EQ(counters->calls.load(), 4u);
+    CHECK(counters->maxActiveMeshes.load() > 1);
+    for (const auto& result : results) {
+        CHECK(result != nullptr);
+    }
+}
+
+// Lookup throughput across threads. The working set is 4x the number of cached ids so roughly
+// three quarters of lookups miss and go through Put, which exercises eviction under contention.
+AGK_BENCHMARK(ResourceCache, MultiThreadedHitMissThroughput)
+{
+    constexpr size_t resourceSize = 4096;
+    constexpr U32 cachedCount = 4096;
+    constexpr U32 opsPerThread = 200000;
+
+    std::vector<String> ids;
+    ids.reserve(cachedCount * 4);
+    for (U32 i = 0; i < cachedCount * 4; ++i) ids.push_back(ResourceName(i));
+
+    for (EvictionPolicy policy : c_policies) {
+        for (U32 threadCount : { 1u, 2u, 4u, 8u }) {
+            for (bool hitOnly : { true, false }) {
+                ResourceCache cache(MakeBudget(policy, cachedCount * resourceSize));
+                const U32 workingSet = hitOnly ? cachedCount / 2 : cachedCount * 4;
+                for (U32 i = 0; i < cachedCount / 2; ++i) {
+                    cache.Put(ids[i], CreateReference<TestResource>(ids[i], resourceSize), resourceSize);
+                }
+
+                std::barrier start(threadCount + 1);
+                std::vector<std::thread> threads;
+                for (U32 t = 0; t < threadCount; ++t) {
+                    threads.emplace_back([&, t] {
+                        // Per-thread xorshift so threads do not walk the ids in lockstep
+                        U32 state = 0x9E3779B9u ^ (t * 0x85EBCA6Bu);
+                        start.arrive_and_wait();
+                        for (U32 i = 0; i < opsPerThread; ++i) {
+                            state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+                            const String& id = ids[state % workingSet];
+                            if (!cache.Get(id)) {
+                                cache.Put(id, CreateReference<TestResource>(id, resourceSize), resourceSize);
+                            }
+                        }
+                    });
+                }
+
+                start.arrive_and_wait();
+                Stopwatch timer;
+                for (auto& thread : threads) thread.join();
+                F64 seconds = timer.ElapsedSeconds();
+
+                ReportRate(std::format("{} {} threads, {}", EvictionPolicyToString(policy), threadCount,
+                    hitOnly ? "hits" : std::format("{:.0f}% hits", cache.GetHitRatio() * 100.0f)),
+                    static_cast<F64>(threadCount) * opsPerThread, "ops", seconds);
+            }
+        }
+    }
+}
+
+// Replays access traces through each policy on one thread: a lookup, and on a miss a new resource
+// is Put as a loader would. Reports the hit ratio and the average cost of an access, including
+// the Put and eviction a miss triggers.
+AGK_BENCHMARK(ResourceCache, TraceReplayHitRatioByPolicy)
+{
+    constexpr size_t resourceSize = 4096;
+    constexpr U32 cachedCount = 2048;
+    constexpr U32 hotIds = 16384;
+    constexpr U32 traceLength = 1000000;
+
+    struct Trace {
+        const char* name;
+        std::vector<U32> accesses;
+    };
+    const Trace traces[] = {
+        { "zipf", MakeAccessTrace(traceLength, hotIds, 0.9, 0, 0) },
+        { "zipf + bundle scans", MakeAccessTrace(traceLength, hotIds, 0.9, 20000, 4096) },
+    };
+
+    U32 maxId = 0;
+    for (const Trace& trace : traces) {
+        maxId = std::max(maxId, *std::max_element(trace.accesses.begin(), trace.accesses.end()));
+    }
+    std::vector<String> ids;
+    ids.reserve(maxId + 1);
+    for (U32 i = 0; i <= maxId; ++i) ids.push_back(ResourceName(i));
+
+    for (const Trace& trace : traces) {
+        for (EvictionPolicy policy : c_policies) {
+            ResourceCache cache(MakeBudget(policy, cachedCount * resourceSize));
+
+            Stopwatch timer;
+            for (U32 access : trace.accesses) {
+                if (!cache.Get(ids[access])) {
+                    cache.Put(ids[access], CreateReference<TestResource>(ids[access], resourceSize), resourceSize);
+                }
+            }
+            F64 seconds = timer.ElapsedSeconds();
+
+            ReportNsPerOp(std::format("{}, {}: {:.1f}% hits", trace.name, EvictionPolicyToString(policy),
+                cache.GetHitRatio() * 100.0f), static_cast<F64>(trace.accesses.size()), seconds);
+        }
+    }
+}
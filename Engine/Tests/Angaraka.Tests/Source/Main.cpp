@@ -0,0 +1,71 @@
+// Engine/Tests/Angaraka.Tests/Source/Main.cpp
+#include "TestFramework.hpp"
+
+// Usage: Angaraka.Tests [--bench] [--filter <text>] [--fixtures <dir>]
+//   --bench     also run benchmarks (Release builds give meaningful numbers)
+//   --filter    only run cases whose "Suite.Name" contains <text>
+//   --fixtures  directory holding the fixture files (default: "Fixtures")
+int main(int argc, char** argv)
+{
+    using namespace Angaraka;
+    using namespace Angaraka::Tests;
+
+    bool runBenchmarks = false;
+    String filter;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--bench") {
+            runBenchmarks = true;
+        }
+        else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        }
+        else if (arg == "--fixtures" && i + 1 < argc) {
+            GetFixtureDirectory() = argv[++i];
+        }
+        else {
+            std::fprintf(stderr, "Unknown argument '%s'\nUsage: %s [--bench] [--filter <text>] [--fixtures <dir>]\n", argv[i], argv[0]);
+            return 2;
+        }
+    }
+
+    U32 passed = 0;
+    U32 failed = 0;
+    U32 benchmarks = 0;
+
+    for (const TestCase& test : GetRegistry()) {
+        if (test.isBenchmark && !runBenchmarks) continue;
+
+        String fullName = std::format("{}.{}", test.suite, test.name);
+        if (!filter.empty() && fullName.find(filter) == String::npos) continue;
+
+        std::printf("[ RUN  ] %s\n", fullName.c_str());
+        std::fflush(stdout);
+
+        try {
+            test.function();
+            if (test.isBenchmark) {
+                benchmarks++;
+            }
+            else {
+                passed++;
+            }
+            std::printf("[  OK  ] %s\n", fullName.c_str());
+        }
+        catch (const CheckFailure& failure) {
+            failed++;
+            std::printf("[ FAIL ] %s\n    %s\n", fullName.c_str(), failure.what());
+        }
+        catch (const std::exception& e) {
+            failed++;
+            std::printf("[ FAIL ] %s\n    Unexpected exception: %s\n", fullName.c_str(), e.what());
+        }
+        catch (...) {
+            failed++;
+            std::printf("[ FAIL ] %s\n    Unknown exception\n", fullName.c_str());
+        }
+    }
+
+    std::printf("\n%u passed, %u failed, %u benchmarks\n", passed, failed, benchmarks);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,301 @@
+// Engine/Tests/Angaraka.Tests/Source/Math/BatchTests.cpp
+#include "../TestFramework.hpp"
+#include <cstring>
+#include <random>
+#include <span>
+
+import Angaraka.Math.Vector3;
+import Angaraka.Math.Matrix4x4;
+import Angaraka.Math.Quaternion;
+import Angaraka.Math.BoundingBox;
+import Angaraka.Math.Batch;
+
+using namespace Angaraka;
+using namespace Angaraka::Math;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    using Batch::SimdLevel;
+
+    // Restores the dispatch level when a test leaves, even on a failed check
+    class SimdLevelScope {
+    public:
+        SimdLevelScope() : m_previous(Batch::GetSimdLevel()) {}
+        ~SimdLevelScope() { Batch::SetSimdLevel(m_previous); }
+
+    private:
+        SimdLevel m_previous;
+    };
+
+    std::vector<SimdLevel> SupportedLevels() {
+        std::vector<SimdLevel> levels;
+        for (U8 level = 0; level <= static_cast<U8>(Batch::GetSupportedSimdLevel()); ++level) {
+            levels.push_back(static_cast<SimdLevel>(level));
+        }
+        return levels;
+    }
+
+    // Sizes around the SSE and AVX widths so every tail path runs
+    constexpr size_t c_sizes[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1000 };
+
+    // Same bits, treating +0 and -0 as equal
+    bool SameBits(F32 a, F32 b) {
+        return std::memcmp(&a, &b, sizeof(F32)) == 0 || (a == 0.0f && b == 0.0f);
+    }
+
+    bool WithinTolerance(F32 a, F32 b, F32 relative) {
+        return std::abs(a - b) <= relative * std::max(1.0f, std::abs(a));
+    }
+
+    struct Inputs {
+        Matrix4x4 matrix;
+        Matrix4x4 affine;
+        std::vector<Vector3> points;
+        std::vector<Vector3> translations;
+        std::vector<Vector3> scales;
+        std::vector<Quaternion> rotations;
+        std::vector<Matrix4x4> lhs;
+        std::vector<Matrix4x4> rhs;
+        std::vector<BoundingBox> boxes;
+    };
+
+    Inputs MakeInputs(size_t count, U32 seed) {
+        std::mt19937 rng(seed);
+        auto random = [&rng](F32 low = -10.0f, F32 high = 10.0f) {
+            return std::uniform_real_distribution<F32>(low, high)(rng);
+        };
+        auto randomVector = [&random](F32 low = -10.0f, F32 high = 10.0f) {
+            return Vector3(random(low, high), random(low, high), random(low, high));
+        };
+        auto randomMatrix = [&random] {
+            Matrix4x4 matrix;
+            for (F32& value : matrix.m) value = random();
+            return matrix;
+        };
+
+        Inputs inputs;
+        inputs.matrix = randomMatrix();
+        inputs.affine = Matrix4x4::Translation(randomVector())
+            * Quaternion(random(), random(), random(), random()).Normalized().ToMatrix()
+            * Matrix4x4::Scale(randomVector(0.1f, 3.0f));
+
+        for (size_t i = 0; i < count; ++i) {
+            inputs.points.push_back(randomVector());
+            inputs.translations.push_back(randomVector());
+            inputs.scales.push_back(randomVector(0.1f, 3.0f));
+            // Every seventh rotation is degenerate to cover the identity fallback
+            inputs.rotations.push_back(i % 7 == 3 ? Quaternion(0.0f, 0.0f, 0.0f, 0.0f)
+                : Quaternion(random(), random(), random(), random()));
+            inputs.lhs.push_back(randomMatrix());
+            inputs.rhs.push_back(randomMatrix());
+            Vector3 center = randomVector();
+            Vector3 extents = randomVector(0.0f, 3.0f);
+            inputs.boxes.push_back(BoundingBox(center - extents, center + extents));
+        }
+        if (count > 2) {
+            inputs.points[1] = Vector3(0.0f, 0.0f, 0.0f);
+        }
+        return inputs;
+    }
+
+    void CheckSameVector(const Vector3& expected, const Vector3& actual) {
+        CHECK(SameBits(expected.x, actual.x) && SameBits(expected.y, actual.y) && SameBits(expected.z, actual.z));
+    }
+
+    void CheckSameMatrix(const Matrix4x4& expected, const Matrix4x4& actual) {
+        for (size_t k = 0; k < 16; ++k) {
+            CHECK(SameBits(expected.m[k], actual.m[k]));
+        }
+    }
+
+} // anonymous namespace
+
+AGK_TEST(MathBatch, PointsAndDirectionsMatchMemberFunctions)
+{
+    SimdLevelScope restore;
+    for (size_t count : c_sizes) {
+        Inputs inputs = MakeInputs(count, static_cast<U32>(count) + 1);
+        for (SimdLevel level : SupportedLevels()) {
+            Batch::SetSimdLevel(level);
+
+            std::vector<Vector3> points(count), directions(count);
+            Batch::TransformPoints(inputs.matrix, inputs.points, points);
+            Batch::TransformDirections(inputs.matrix, inputs.points, directions);
+
+            for (size_t i = 0; i < count; ++i) {
+                CheckSameVector(inputs.matrix.TransformPoint(inputs.points[i]), points[i]);
+                CheckSameVector(inputs.matrix.TransformDirection(inputs.points[i]), directions[i]);
+            }
+        }
+    }
+}
+
+AGK_TEST(MathBatch, MatrixProductsMatchOperator)
+{
+    SimdLevelScope restore;
+    for (size_t count : c_sizes) {
+        Inputs inputs = MakeInputs(count, static_cast<U32>(count) + 100);
+        for (SimdLevel level : SupportedLevels()) {
+            Batch::SetSimdLevel(level);
+
+            std::vector<Matrix4x4> pairwise(count), shared(count);
+            Batch::MultiplyMatrices(inputs.lhs, inputs.rhs, pairwise);
+            Batch::MultiplyMatrices(inputs.matrix, inputs.rhs, shared);
+
+            for (size_t i = 0; i < count; ++i) {
+                CheckSameMatrix(inputs.lhs[i] * inputs.rhs[i], pairwise[i]);
+                CheckSameMatrix(inputs.matrix * inputs.rhs[i], shared[i]);
+            }
+
+            // Output aliasing the left operand
+            std::vector<Matrix4x4> aliased = inputs.lhs;
+            Batch::MultiplyMatrices(aliased, inputs.rhs, aliased);
+            for (size_t i = 0; i < count; ++i) {
+                CheckSameMatrix(pairwise[i], aliased[i]);
+            }
+        }
+    }
+}
+
+AGK_TEST(MathBatch, ComposeAndNormalizeMatchMemberFunctions)
+{
+    SimdLevelScope restore;
+    for (size_t count : c_sizes) {
+        Inputs inputs = MakeInputs(count, static_cast<U32>(count) + 200);
+        for (SimdLevel level : SupportedLevels()) {
+            Batch::SetSimdLevel(level);
+
+            std::vector<Matrix4x4> composed(count);
+            std::vector<Quaternion> normalized(count);
+            Batch::ComposeTRS(inputs.translations, inputs.rotations, inputs.scales, composed);
+            Batch::NormalizeQuaternions(inputs.rotations, normalized);
+
+            for (size_t i = 0; i < count; ++i) {
+                // Equal up to the sign of zero entries
+                Matrix4x4 expected = Matrix4x4::Translation(inputs.translations[i])
+                    * inputs.rotations[i].ToMatrix() * Matrix4x4::Scale(inputs.scales[i]);
+                CheckSameMatrix(expected, composed[i]);
+
+                Quaternion expectedRotation = inputs.rotations[i].Normalized();
+                CHECK(SameBits(expectedRotation.x, normalized[i].x) && SameBits(expectedRotation.y, normalized[i].y) &&
+                    SameBits(expectedRotation.z, normalized[i].z) && SameBits(expectedRotation.w, normalized[i].w));
+            }
+
+            std::vector<Quaternion> aliased = inputs.rotations;
+            Batch::NormalizeQuaternions(aliased, aliased);
+            for (size_t i = 0; i < count; ++i) {
+                CHECK(SameBits(normalized[i].x, aliased[i].x) && SameBits(normalized[i].w, aliased[i].w));
+            }
+        }
+    }
+}
+
+// The batch kernel uses the per-axis min/max method instead of transforming the eight corners,
+// so it may differ from BoundingBox::Transform by rounding. SIMD levels must match scalar exactly.
+AGK_TEST(MathBatch, BoxesMatchWithinTolerance)
+{
+    SimdLevelScope restore;
+    for (size_t count : c_sizes) {
+        Inputs inputs = MakeInputs(count, static_cast<U32>(count) + 300);
+
+        Batch::SetSimdLevel(SimdLevel::Scalar);
+        std::vector<BoundingBox> scalar(count);
+        Batch::TransformBoxes(inputs.affine, inputs.boxes, scalar);
+
+        for (SimdLevel level : SupportedLevels()) {
+            Batch::SetSimdLevel(level);
+
+            std::vector<BoundingBox> boxes(count);
+            Batch::TransformBoxes(inputs.affine, inputs.boxes, boxes);
+
+            for (size_t i = 0; i < count; ++i) {
+                BoundingBox expected = inputs.boxes[i].Transform(inputs.affine);
+                for (size_t k = 0; k < 3; ++k) {
+                    CHECK(WithinTolerance(expected.min[k], boxes[i].min[k], 1e-5f));
+                    CHECK(WithinTolerance(expected.max[k], boxes[i].max[k], 1e-5f));
+                }
+                CheckSameVector(scalar[i].min, boxes[i].min);
+                CheckSameVector(scalar[i].max, boxes[i].max);
+            }
+        }
+    }
+}
+
+AGK_TEST(MathBatch, SetSimdLevelClampsToSupported)
+{
+    SimdLevelScope restore;
+    Batch::SetSimdLevel(SimdLevel::AVX2);
+    CHECK(static_cast<U8>(Batch::GetSimdLevel()) <= static_cast<U8>(Batch::GetSupportedSimdLevel()));
+    Batch::SetSimdLevel(SimdLevel::Scalar);
+    CHECK_EQ(Batch::GetSimdLevel(), SimdLevel::Scalar);
+}
+
+// Elements per second for each kernel at every supported level, next to a loop over the
+// existing member functions
+AGK_BENCHMARK(MathBatch, KernelThroughput)
+{
+    SimdLevelScope restore;
+    constexpr size_t count = 16384;
+    constexpr U32 iterations = 200;
+    Inputs inputs = MakeInputs(count, 7);
+
+    std::vector<Vector3> points(count);
+    std::vector<Matrix4x4> matrices(count);
+    std::vector<Quaternion> rotations(count);
+    std::vector<BoundingBox> boxes(count);
+
+    auto measure = [&](std::string_view name, const auto& body) {
+        body();     // Warm up caches and the dispatch table
+        Stopwatch timer;
+        for (U32 i = 0; i < iterations; ++i) body();
+        ReportRate(name, static_cast<F64>(count) * iterations, "elem", timer.ElapsedSeconds());
+    };
+
+    measure("TransformPoint (member loop)", [&] {
+        for (size_t i = 0; i < count; ++i) points[i] = inputs.matrix.TransformPoint(inputs.points[i]);
+        DoNotOptimize(points);
+    });
+    measure("operator* (member loop)", [&] {
+        for (size_t i = 0; i < count; ++i) matrices[i] = inputs.lhs[i] * inputs.rhs[i];
+        DoNotOptimize(matrices);
+    });
+    measure("Matrix4x4::TRS (member loop)", [&] {
+        for (size_t i = 0; i < count; ++i) matrices[i] = Matrix4x4::TRS(inputs.translations[i], inputs.rotations[i], inputs.scales[i]);
+        DoNotOptimize(matrices);
+    });
+    measure("Quaternion::Normalized (member loop)", [&] {
+        for (size_t i = 0; i < count; ++i) rotations[i] = inputs.rotations[i].Normalized();
+        DoNotOptimize(rotations);
+    });
+    measure("BoundingBox::Transform (member loop)", [&] {
+        for (size_t i = 0; i < count; ++i) boxes[i] = inputs.boxes[i].Transform(inputs.affine);
+        DoNotOptimize(boxes);
+    });
+
+    for (SimdLevel level : SupportedLevels()) {
+        Batch::SetSimdLevel(level);
+        const char* levelName = Batch::SimdLevelToString(level);
+
+        measure(std::format("TransformPoints ({})", levelName), [&] {
+            Batch::TransformPoints(inputs.matrix, inputs.points, points);
+            DoNotOptimize(points);
+        });
+        measure(std::format("MultiplyMatrices ({})", levelName), [&] {
+            Batch::MultiplyMatrices(inputs.lhs, inputs.rhs, matrices);
+            DoNotOptimize(matrices);
+        });
+        measure(std::format("ComposeTRS ({})", levelName), [&] {
+            Batch::ComposeTRS(inputs.translations, inputs.rotations, inputs.scales, matrices);
+            DoNotOptimize(matrices);
+        });
+        measure(std::format("NormalizeQuaternions ({})", levelName), [&] {
+            Batch::NormalizeQuaternions(inputs.rotations, rotations);
+            DoNotOptimize(rotations);
+        });
+        measure(std::format("TransformBoxes ({})", levelName), [&] {
+            Batch::TransformBoxes(inputs.affine, inputs.boxes, boxes);
+            DoNotOptimize(boxes);
+        });
+    }
+}
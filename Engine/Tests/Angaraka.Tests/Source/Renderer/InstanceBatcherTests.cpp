@@ -0,0 +1,206 @@
+// Engine/Tests/Angaraka.Tests/Source/Renderer/InstanceBatcherTests.cpp
+#include "../TestFramework.hpp"
+#include <cstring>
+
+import Angaraka.Core.Resources;
+import Angaraka.Math.Matrix4x4;
+import Angaraka.Graphics.InstanceBatcher;
+
+using namespace Angaraka;
+using namespace Angaraka::Graphics;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // The batcher only compares resource pointers
+    class TestMesh : public Core::Resource {
+    public:
+        explicit TestMesh(const String& id) : Resource(id) { m_isLoaded = true; }
+
+        size_t GetTypeId() const override { return 0x3E54; }
+        bool Load(const String&, void*) override { return true; }
+        void Unload() override {}
+        size_t GetSizeInBytes() const override { return 0; }
+    };
+
+    // Tags each draw with its submission index so packed instances can be traced back
+    Math::Matrix4x4 TaggedWorld(U32 tag) {
+        return Math::Matrix4x4::Translation(static_cast<F32>(tag), 0.0f, 0.0f);
+    }
+
+    U32 InstanceTag(const InstanceData& instance) {
+        return static_cast<U32>(instance.world[12]);
+    }
+
+    // Instance tags of one batch, in packed order, e.g. "0 2 5 "
+    String BatchTags(const InstanceBatcher& batcher, const DrawBatch& batch) {
+        String text;
+        for (U32 i = 0; i < batch.instanceCount; ++i) {
+            text += std::format("{} ", InstanceTag(batcher.GetInstances()[batch.firstInstance + i]));
+        }
+        return text;
+    }
+
+} // anonymous namespace
+
+// Every draw of a mesh joins one batch placed where the mesh first appeared, and instances
+// keep their submission order inside it.
+AGK_TEST(InstanceBatcher, GroupedRunMergesEveryDrawOfAMesh)
+{
+    TestMesh a("a"), b("b"), c("c");
+    Core::Resource* sequence[] = { &a, &b, &a, &c, &b, &a };
+
+    InstanceBatcher batcher;
+    batcher.Reset();
+    for (U32 i = 0; i < 6; ++i) {
+        batcher.Add(sequence[i], nullptr, TaggedWorld(i));
+    }
+    batcher.Flush(BatchOrder::Grouped);
+
+    auto batches = batcher.GetBatches();
+    CHECK_EQ(batches.size(), 3u);
+    CHECK_EQ(batcher.GetInstances().size(), 6u);
+    CHECK_EQ(batcher.GetDrawCount(), 6u);
+
+    CHECK(batches[0].mesh == &a);
+    CHECK(batches[1].mesh == &b);
+    CHECK(batches[2].mesh == &c);
+    CHECK_EQ(BatchTags(batcher, batches[0]), String("0 2 5 "));
+    CHECK_EQ(BatchTags(batcher, batches[1]), String("1 4 "));
+    CHECK_EQ(BatchTags(batcher, batches[2]), String("3 "));
+}
+
+// Only neighbours merge, so the packed instances are exactly the submission order
+AGK_TEST(InstanceBatcher, PreserveRunOnlyMergesNeighbours)
+{
+    TestMesh a("a"), b("b");
+    Core::Resource* sequence[] = { &a, &a, &b, &a, &a, &a };
+
+    InstanceBatcher batcher;
+    batcher.Reset();
+    for (U32 i = 0; i < 6; ++i) {
+        batcher.Add(sequence[i], nullptr, TaggedWorld(i));
+    }
+    batcher.Flush(BatchOrder::Preserve);
+
+    auto batches = batcher.GetBatches();
+    CHECK_EQ(batches.size(), 3u);
+    CHECK(batches[0].mesh == &a);
+    CHECK(batches[1].mesh == &b);
+    CHECK(batches[2].mesh == &a);
+    CHECK_EQ(BatchTags(batcher, batches[0]), String("0 1 "));
+    CHECK_EQ(BatchTags(batcher, batches[1]), String("2 "));
+    CHECK_EQ(BatchTags(batcher, batches[2]), String("3 4 5 "));
+
+    for (U32 i = 0; i < 6; ++i) {
+        CHECK_EQ(InstanceTag(batcher.GetInstances()[i]), i);
+    }
+}
+
+// A Flush splits equal draws on either side of it into separate batches whatever the order,
+// and the runs are packed back to back into one instance array.
+AGK_TEST(InstanceBatcher, BatchesSplitAtFlushBoundary)
+{
+    TestMesh a("a"), b("b");
+
+    InstanceBatcher batcher;
+    batcher.Reset();
+    batcher.Add(&a, nullptr, TaggedWorld(0));
+    batcher.Add(&a, nullptr, TaggedWorld(1));
+    batcher.Flush(BatchOrder::Grouped);
+    batcher.Flush(BatchOrder::Grouped);     // Empty runs add nothing
+    batcher.Add(&a, nullptr, TaggedWorld(2));
+    batcher.Add(&b, nullptr, TaggedWorld(3));
+    batcher.Add(&a, nullptr, TaggedWorld(4));
+    batcher.Flush(BatchOrder::Grouped);
+    batcher.Add(&a, nullptr, TaggedWorld(5));
+    batcher.Flush(BatchOrder::Preserve);
+
+    auto batches = batcher.GetBatches();
+    CHECK_EQ(batches.size(), 4u);
+    CHECK_EQ(BatchTags(batcher, batches[0]), String("0 1 "));
+    CHECK_EQ(BatchTags(batcher, batches[1]), String("2 4 "));
+    CHECK_EQ(BatchTags(batcher, batches[2]), String("3 "));
+    CHECK_EQ(BatchTags(batcher, batches[3]), String("5 "));
+
+    U32 next = 0;
+    for (const DrawBatch& batch : batches) {
+        CHECK_EQ(batch.firstInstance, next);
+        next += batch.instanceCount;
+    }
+    CHECK_EQ(next, static_cast<U32>(batcher.GetInstances().size()));
+
+    // Draws added after the last Flush are not batches yet, and Reset drops everything
+    batcher.Add(&b, nullptr, TaggedWorld(6));
+    CHECK_EQ(batcher.GetBatches().size(), 4u);
+    batcher.Reset();
+    CHECK(batcher.GetBatches().empty());
+    CHECK(batcher.GetInstances().empty());
+    CHECK_EQ(batcher.GetDrawCount(), 0u);
+}
+
+AGK_TEST(InstanceBatcher, MaterialsSplitBatchesOfOneMesh)
+{
+    TestMesh mesh("mesh"), stone("stone");
+
+    InstanceBatcher batcher;
+    batcher.Reset();
+    batcher.Add(&mesh, &stone, TaggedWorld(0));
+    batcher.Add(&mesh, nullptr, TaggedWorld(1));
+    batcher.Add(&mesh, &stone, TaggedWorld(2));
+    batcher.Flush(BatchOrder::Grouped);
+
+    auto batches = batcher.GetBatches();
+    CHECK_EQ(batches.size(), 2u);
+    CHECK(batches[0].material == &stone);
+    CHECK(batches[1].material == nullptr);
+    CHECK_EQ(BatchTags(batcher, batches[0]), String("0 2 "));
+    CHECK_EQ(BatchTags(batcher, batches[1]), String("1 "));
+}
+
+// The shader reads InstanceData as a column-major float4x4, so each packed element must be
+// the matrix's own storage: element (row, col) at col * 4 + row, translation in 12..14.
+AGK_TEST(InstanceBatcher, PacksWorldMatricesInColumnMajorOrder)
+{
+    static_assert(sizeof(InstanceData) == 16 * sizeof(F32), "InstanceData is one float4x4");
+
+    TestMesh a("a"), b("b");
+    Math::Matrix4x4 worlds[2];
+    for (U32 m = 0; m < 2; ++m) {
+        for (size_t row = 0; row < 4; ++row) {
+            for (size_t col = 0; col < 4; ++col) {
+                worlds[m](row, col) = static_cast<F32>(m * 100 + row * 10 + col);
+            }
+        }
+    }
+
+    for (BatchOrder order : { BatchOrder::Grouped, BatchOrder::Preserve }) {
+        InstanceBatcher batcher;
+        batcher.Reset();
+        batcher.Add(&a, nullptr, worlds[0]);
+        batcher.Add(&b, nullptr, worlds[1]);
+        batcher.Flush(order);
+
+        CHECK_EQ(batcher.GetInstances().size(), 2u);
+        for (U32 m = 0; m < 2; ++m) {
+            const InstanceData& instance = batcher.GetInstances()[m];
+            CHECK(std::memcmp(instance.world, worlds[m].GetColumnPtr(0), sizeof(instance.world)) == 0);
+            for (size_t row = 0; row < 4; ++row) {
+                for (size_t col = 0; col < 4; ++col) {
+                    CHECK_EQ(instance.world[col * 4 + row], worlds[m](row, col));
+                }
+            }
+        }
+    }
+
+    const Math::Matrix4x4 translation = Math::Matrix4x4::Translation(1.0f, 2.0f, 3.0f);
+    InstanceBatcher batcher;
+    batcher.Reset();
+    batcher.Add(&a, nullptr, translation);
+    batcher.Flush(BatchOrder::Grouped);
+    const InstanceData& instance = batcher.GetInstances()[0];
+    CHECK_EQ(instance.world[12], 1.0f);
+    CHECK_EQ(instance.world[13], 2.0f);
+    CHECK_EQ(instance.world[14], 3.0f);
+    CHECK_EQ(instance.world[15], 1.0f);
+}
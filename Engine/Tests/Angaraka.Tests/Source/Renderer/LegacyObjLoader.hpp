@@ -0,0 +1,229 @@
+// Engine/Tests/Angaraka.Tests/Source/Renderer/LegacyObjLoader.hpp
+#pragma once
+
+#include <Angaraka/MeshBase.hpp>
+#include <fstream>
+#include <sstream>
+
+namespace Angaraka::Tests::Legacy {
+
+    using namespace Angaraka::Graphics::DirectX12;
+
+    /**
+     * @brief The OBJ loader as it was before the memory-mapped rewrite, kept as a baseline
+     *
+     * Reads lines with getline and an istringstream per line and per face corner, and
+     * deduplicates vertices through a map keyed on formatted index strings. Only used to
+     * benchmark against and to check the new loader produces the same buffers; material
+     * libraries are skipped and relative indices are not supported, as before.
+     */
+    class ObjLoader {
+    public:
+        Scope<MeshData> Load(const String& filePath, VertexLayout targetLayout = VertexLayout::PNT) {
+            m_positions.clear();
+            m_normals.clear();
+            m_texCoords.clear();
+            m_triangles.clear();
+            m_name.clear();
+
+            if (!ParseFile(filePath)) {
+                return nullptr;
+            }
+
+            auto meshData = CreateScope<MeshData>();
+            if (!ConvertToMeshData(*meshData, targetLayout)) {
+                return nullptr;
+            }
+            return meshData;
+        }
+
+    private:
+        struct VertexIndex {
+            int position{ -1 };
+            int texCoord{ -1 };
+            int normal{ -1 };
+        };
+
+        struct Vertex {
+            DirectX::XMFLOAT3 position{ 0.0f, 0.0f, 0.0f };
+            DirectX::XMFLOAT3 normal{ 0.0f, 1.0f, 0.0f };
+            DirectX::XMFLOAT2 texCoord{ 0.0f, 0.0f };
+            DirectX::XMFLOAT4 color{ 1.0f, 1.0f, 1.0f, 1.0f };
+        };
+
+        std::vector<DirectX::XMFLOAT3> m_positions;
+        std::vector<DirectX::XMFLOAT3> m_normals;
+        std::vector<DirectX::XMFLOAT2> m_texCoords;
+        std::vector<VertexIndex> m_triangles;   // Three corners per triangle
+        String m_name;
+
+        bool ParseFile(const String& filePath) {
+            std::ifstream file(filePath);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            String line;
+            while (std::getline(file, line)) {
+                if (line.empty() || line[0] == '#') continue;
+
+                std::istringstream iss(line);
+                String token;
+                iss >> token;
+
+                try {
+                    if (token == "v") {
+                        DirectX::XMFLOAT3 pos;
+                        iss >> pos.x >> pos.y >> pos.z;
+                        m_positions.push_back(pos);
+                    }
+                    else if (token == "vn") {
+                        DirectX::XMFLOAT3 normal;
+                        iss >> normal.x >> normal.y >> normal.z;
+                        m_normals.push_back(normal);
+                    }
+                    else if (token == "vt") {
+                        DirectX::XMFLOAT2 texCoord;
+                        iss >> texCoord.x >> texCoord.y;
+                        texCoord.y = 1.0f - texCoord.y;
+                        m_texCoords.push_back(texCoord);
+                    }
+                    else if (token == "f") {
+                        if (!ParseFace(line)) {
+                            return false;
+                        }
+                    }
+                    else if (token == "o" || token == "g") {
+                        iss >> m_name;
+                    }
+                }
+                catch (const std::exception&) {
+                    return false;
+                }
+            }
+
+            return !m_positions.empty() && !m_triangles.empty();
+        }
+
+        bool ParseFace(const String& line) {
+            std::istringstream iss(line);
+            String token;
+            iss >> token;
+
+            std::vector<VertexIndex> corners;
+            String vertexStr;
+            while (iss >> vertexStr) {
+                VertexIndex corner;
+                std::istringstream vertexStream(vertexStr);
+                String indexStr;
+
+                if (std::getline(vertexStream, indexStr, '/')) {
+                    corner.position = std::stoi(indexStr) - 1;
+                    if (corner.position < 0 || corner.position >= static_cast<int>(m_positions.size())) {
+                        return false;
+                    }
+                }
+                if (std::getline(vertexStream, indexStr, '/') && !indexStr.empty()) {
+                    corner.texCoord = std::stoi(indexStr) - 1;
+                    if (corner.texCoord < 0 || corner.texCoord >= static_cast<int>(m_texCoords.size())) {
+                        corner.texCoord = -1;
+                    }
+                }
+                if (std::getline(vertexStream, indexStr) && !indexStr.empty()) {
+                    corner.normal = std::stoi(indexStr) - 1;
+                    if (corner.normal < 0 || corner.normal >= static_cast<int>(m_normals.size())) {
+                        corner.normal = -1;
+                    }
+                }
+                corners.push_back(corner);
+            }
+
+            if (corners.size() < 3) {
+                return false;
+            }
+
+            // Fan triangulation, which is also how quads were split
+            for (size_t i = 1; i + 1 < corners.size(); ++i) {
+                m_triangles.push_back(corners[0]);
+                m_triangles.push_back(corners[i]);
+                m_triangles.push_back(corners[i + 1]);
+            }
+            return true;
+        }
+
+        bool ConvertToMeshData(MeshData& meshData, VertexLayout targetLayout) {
+            meshData.Clear();
+            meshData.layout = VertexLayoutFactory::CreateLayout(targetLayout);
+            meshData.name = m_name.empty() ? "OBJ_Mesh" : m_name;
+
+            std::unordered_map<std::string, U32> vertexMap;
+            std::vector<Vertex> uniqueVertices;
+
+            for (const VertexIndex& corner : m_triangles) {
+                std::string vertexKey = std::to_string(corner.position) + "/" +
+                    std::to_string(corner.texCoord) + "/" +
+                    std::to_string(corner.normal);
+
+                U32 finalVertexIndex;
+                auto it = vertexMap.find(vertexKey);
+                if (it != vertexMap.end()) {
+                    finalVertexIndex = it->second;
+                }
+                else {
+                    Vertex vertex;
+                    vertex.position = m_positions[corner.position];
+                    if (corner.normal >= 0) {
+                        vertex.normal = m_normals[corner.normal];
+                    }
+                    if (corner.texCoord >= 0) {
+                        vertex.texCoord = m_texCoords[corner.texCoord];
+                    }
+
+                    finalVertexIndex = static_cast<U32>(uniqueVertices.size());
+                    uniqueVertices.push_back(vertex);
+                    vertexMap[vertexKey] = finalVertexIndex;
+                }
+                meshData.indices.push_back(finalVertexIndex);
+            }
+
+            meshData.vertexCount = static_cast<U32>(uniqueVertices.size());
+            meshData.indexCount = static_cast<U32>(meshData.indices.size());
+            PackVertices(uniqueVertices, meshData);
+            meshData.CalculateBounds();
+            return meshData.IsValid();
+        }
+
+        static void PackVertices(const std::vector<Vertex>& vertices, MeshData& meshData) {
+            const auto& layout = meshData.layout;
+            meshData.vertexData.resize(meshData.vertexCount * layout.vertexSize);
+
+            for (U32 i = 0; i < meshData.vertexCount; ++i) {
+                const Vertex& vertex = vertices[i];
+                U8* vertexPtr = meshData.vertexData.data() + i * layout.vertexSize;
+
+                for (const auto& attr : layout.attributes) {
+                    U8* attrPtr = vertexPtr + attr.offset;
+                    switch (attr.semantic) {
+                    case VertexSemantic::Position:
+                        if (attr.type == VertexAttributeType::Float3) memcpy(attrPtr, &vertex.position, sizeof(DirectX::XMFLOAT3));
+                        break;
+                    case VertexSemantic::Normal:
+                        if (attr.type == VertexAttributeType::Float3) memcpy(attrPtr, &vertex.normal, sizeof(DirectX::XMFLOAT3));
+                        break;
+                    case VertexSemantic::TexCoord0:
+                    case VertexSemantic::TexCoord1:
+                        if (attr.type == VertexAttributeType::Float2) memcpy(attrPtr, &vertex.texCoord, sizeof(DirectX::XMFLOAT2));
+                        break;
+                    case VertexSemantic::Color:
+                        if (attr.type == VertexAttributeType::Float4) memcpy(attrPtr, &vertex.color, sizeof(DirectX::XMFLOAT4));
+                        break;
+                    default:
+                        memset(attrPtr, 0, attr.GetSize());
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+} // namespace Angaraka::Tests::Legacy
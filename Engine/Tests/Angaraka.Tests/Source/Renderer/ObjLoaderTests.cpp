@@ -0,0 +1,163 @@
+// Engine/Tests/Angaraka.Tests/Source/Renderer/ObjLoaderTests.cpp
+#include "../TestFramework.hpp"
+#include "LegacyObjLoader.hpp"
+#include <Angaraka/JobSystem.hpp>
+#include <Angaraka/MeshBase.hpp>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+import Angaraka.Graphics.DirectX12.ObjLoader;
+
+using namespace Angaraka;
+using namespace Angaraka::Graphics::DirectX12;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // Fixtures/OBJ holds one grid written with relative and with absolute indices;
+    // generate_fixture.py in the same directory regenerates them.
+    const String c_relativeGrid = "OBJ/wavy_grid_relative.obj";
+    const String c_absoluteGrid = "OBJ/wavy_grid_absolute.obj";
+
+    Scope<MeshData> LoadMesh(const String& path, bool parallel, size_t minChunkBytes = 0) {
+        OBJ::Loader loader;
+        loader.SetParallel(parallel);
+        if (minChunkBytes > 0) {
+            loader.SetMinChunkBytes(minChunkBytes);
+        }
+        Scope<MeshData> mesh = loader.Load(path);
+        CHECK_EQ(loader.GetLastError(), String(""));
+        CHECK(mesh != nullptr);
+        return mesh;
+    }
+
+    // Everything the loader produces, bounds included, must match exactly
+    void CheckSameMesh(const MeshData& actual, const MeshData& expected) {
+        CHECK_EQ(actual.name, expected.name);
+        CHECK_EQ(actual.vertexCount, expected.vertexCount);
+        CHECK_EQ(actual.indexCount, expected.indexCount);
+        CHECK(actual.indices == expected.indices);
+        CHECK(actual.vertexData == expected.vertexData);
+        CHECK_EQ(actual.layout.vertexSize, expected.layout.vertexSize);
+        CHECK_EQ(actual.boundingBoxMin.x, expected.boundingBoxMin.x);
+        CHECK_EQ(actual.boundingBoxMax.y, expected.boundingBoxMax.y);
+        CHECK_EQ(actual.boundingSphereRadius, expected.boundingSphereRadius);
+    }
+
+    // A grid of quads with absolute v/vt/vn corners, about bytes in size
+    void WriteLargeGrid(const String& path, size_t bytes) {
+        std::ofstream file(path, std::ios::binary);
+        const U32 size = static_cast<U32>(std::sqrt(static_cast<F64>(bytes) / 110.0));
+        file << "o LargeGrid\n";
+        for (U32 y = 0; y <= size; ++y) {
+            for (U32 x = 0; x <= size; ++x) {
+                file << std::format("v {:.6f} {:.6f} {:.6f}\nvt {:.6f} {:.6f}\n",
+                    x * 0.1f, std::sin(x * 0.3f) * std::cos(y * 0.2f), y * 0.1f,
+                    static_cast<F32>(x) / size, static_cast<F32>(y) / size);
+            }
+            file << std::format("vn 0 1 {:.3f}\n", static_cast<F32>(y) / size);
+        }
+        for (U32 y = 0; y < size; ++y) {
+            for (U32 x = 0; x < size; ++x) {
+                const U32 a = y * (size + 1) + x + 1;
+                const U32 b = a + 1, c = a + size + 2, d = a + size + 1;
+                file << std::format("f {}/{}/{} {}/{}/{} {}/{}/{} {}/{}/{}\n",
+                    a, a, y + 1, b, b, y + 1, c, c, y + 2, d, d, y + 2);
+            }
+        }
+    }
+
+} // anonymous namespace
+
+// The absolute file is also loaded by the pre-rewrite loader, which pins down the exact
+// buffers expected from both files.
+AGK_TEST(ObjLoader, MatchesLegacyLoaderOnFixture)
+{
+    Legacy::ObjLoader legacy;
+    Scope<MeshData> expected = legacy.Load(FixturePath(c_absoluteGrid));
+    CHECK(expected != nullptr);
+    CHECK_EQ(expected->name, String("band48"));
+    CHECK(expected->indexCount > 10000);
+
+    CheckSameMesh(*LoadMesh(FixturePath(c_absoluteGrid), false), *expected);
+    CheckSameMesh(*LoadMesh(FixturePath(c_relativeGrid), false), *expected);
+}
+
+// Splitting the relative file into chunks resolves its negative indices per chunk, so faces
+// at the start of a chunk that reach back into the previous one are only right once
+// MergeChunks has rebased them. Every split must give the single-chunk result.
+AGK_TEST(ObjLoader, ChunkedParseMatchesSingleChunk)
+{
+    Core::JobSystem& jobs = Core::JobSystem::Get();
+    jobs.Initialize(4);
+
+    for (const String& fixture : { c_relativeGrid, c_absoluteGrid }) {
+        Scope<MeshData> single = LoadMesh(FixturePath(fixture), false);
+
+        // Chunk counts are capped by the worker count, so smaller chunks move the split points
+        for (size_t minChunkBytes : { 1024u, 4096u, 9973u, 65536u }) {
+            CheckSameMesh(*LoadMesh(FixturePath(fixture), true, minChunkBytes), *single);
+        }
+
+        // Files under twice the default chunk size are never split
+        CheckSameMesh(*LoadMesh(FixturePath(fixture), true), *single);
+    }
+}
+
+AGK_TEST(ObjLoader, ReportsTheFileLineOfAnErrorInAnyChunk)
+{
+    Core::JobSystem& jobs = Core::JobSystem::Get();
+    jobs.Initialize(4);
+
+    // A corrupt vertex near the end, in the last chunk when split
+    std::ifstream source(FixturePath(c_relativeGrid), std::ios::binary);
+    String text((std::istreambuf_iterator<char>(source)), std::istreambuf_iterator<char>());
+    const size_t at = text.rfind("\nv ") + 1;
+    text.replace(at, 2, "v x");
+    const size_t errorLine = std::count(text.begin(), text.begin() + at, '\n') + 1;
+    const String expectedError = std::format("Invalid vertex position at line {}", errorLine);
+
+    const String path = (std::filesystem::temp_directory_path() / "angaraka_obj_error.obj").string();
+    std::ofstream(path, std::ios::binary) << text;
+
+    for (bool parallel : { false, true }) {
+        OBJ::Loader loader;
+        loader.SetParallel(parallel);
+        loader.SetMinChunkBytes(4096);
+        CHECK(loader.Load(path) == nullptr);
+        CHECK_EQ(loader.GetLastError(), expectedError);
+    }
+    std::filesystem::remove(path);
+}
+
+// Load throughput on a generated ~64 MB grid: the legacy iostream loader, the mapped loader on
+// one thread, and the mapped loader split across the job system.
+AGK_BENCHMARK(ObjLoader, ParseThroughputVsLegacy)
+{
+    Core::JobSystem& jobs = Core::JobSystem::Get();
+    jobs.Initialize(0);
+
+    const String path = (std::filesystem::temp_directory_path() / "angaraka_obj_benchmark.obj").string();
+    WriteLargeGrid(path, 64 * 1024 * 1024);
+    const F64 megabytes = static_cast<F64>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+
+    Stopwatch timer;
+    Legacy::ObjLoader legacy;
+    Scope<MeshData> expected = legacy.Load(path);
+    ReportRate("legacy iostream", megabytes, "MB", timer.ElapsedSeconds());
+    CHECK(expected != nullptr);
+
+    timer.Restart();
+    Scope<MeshData> single = LoadMesh(path, false);
+    ReportRate("mapped, 1 thread", megabytes, "MB", timer.ElapsedSeconds());
+
+    timer.Restart();
+    Scope<MeshData> chunked = LoadMesh(path, true);
+    ReportRate(std::format("mapped, {} workers", jobs.GetWorkerCount()), megabytes, "MB", timer.ElapsedSeconds());
+
+    CheckSameMesh(*single, *expected);
+    CheckSameMesh(*chunked, *expected);
+    std::filesystem::remove(path);
+}
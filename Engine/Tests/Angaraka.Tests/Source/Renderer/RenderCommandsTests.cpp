@@ -0,0 +1,240 @@
+// Engine/Tests/Angaraka.Tests/Source/Renderer/RenderCommandsTests.cpp
+#include "../TestFramework.hpp"
+#include <algorithm>
+#include <random>
+
+import Angaraka.Core.Resources;
+import Angaraka.Math.Matrix4x4;
+import Angaraka.Graphics.InstanceBatcher;
+import Angaraka.Graphics.RenderCommands;
+
+using namespace Angaraka;
+using namespace Angaraka::Graphics;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    class TestMesh : public Core::Resource {
+    public:
+        explicit TestMesh(const String& id) : Resource(id) { m_isLoaded = true; }
+
+        size_t GetTypeId() const override { return 0x3E54; }
+        bool Load(const String&, void*) override { return true; }
+        void Unload() override {}
+        size_t GetSizeInBytes() const override { return 0; }
+    };
+
+    // Command types in order, e.g. "Pipeline Mesh Instances Draw "
+    String FormatCommands(std::span<const RenderCommand> commands) {
+        static constexpr const char* names[] = { "Pipeline", "Mesh", "Instances", "Draw" };
+        String text;
+        for (const RenderCommand& command : commands) {
+            text += std::format("{} ", names[static_cast<size_t>(command.type)]);
+        }
+        return text;
+    }
+
+    // What Scene hands the batcher each frame: entities sorted front to back, so equal meshes
+    // are scattered through the queue
+    struct SyntheticScene {
+        std::vector<Scope<TestMesh>> meshes;
+        std::vector<Core::Resource*> entityMeshes;
+        std::vector<Math::Matrix4x4> entityWorlds;
+
+        SyntheticScene(U32 entityCount, U32 meshCount) {
+            for (U32 i = 0; i < meshCount; ++i) {
+                meshes.push_back(CreateScope<TestMesh>(std::format("mesh_{}", i)));
+            }
+
+            std::mt19937 random(7);
+            std::uniform_real_distribution<F32> position(-500.0f, 500.0f);
+            std::vector<std::pair<F32, U32>> byDepth(entityCount);
+            for (U32 i = 0; i < entityCount; ++i) {
+                byDepth[i] = { position(random), static_cast<U32>(random() % meshCount) };
+            }
+            std::sort(byDepth.begin(), byDepth.end());
+
+            for (const auto& [depth, mesh] : byDepth) {
+                entityMeshes.push_back(meshes[mesh].get());
+                entityWorlds.push_back(Math::Matrix4x4::Translation(0.0f, 0.0f, depth));
+            }
+        }
+
+        // Mirrors Scene::RecordRenderCommands for a single opaque layer
+        void Record(InstanceBatcher& batcher, RenderCommandBuffer& commands, BatchOrder order) const {
+            batcher.Reset();
+            for (size_t i = 0; i < entityMeshes.size(); ++i) {
+                batcher.Add(entityMeshes[i], nullptr, entityWorlds[i]);
+            }
+            batcher.Flush(order);
+
+            commands.Reset();
+            commands.BindPipeline(DEFAULT_PIPELINE);
+            commands.AddBatches(batcher);
+        }
+    };
+
+} // anonymous namespace
+
+AGK_TEST(RenderCommands, RedundantBindsAreDropped)
+{
+    TestMesh a("a"), b("b");
+    RenderCommandBuffer commands;
+    commands.Reset();
+
+    commands.BindPipeline(DEFAULT_PIPELINE);
+    commands.BindPipeline(DEFAULT_PIPELINE);
+    commands.BindMesh(&a);
+    commands.BindMesh(&a);
+    commands.SetInstances(0);
+    commands.SetInstances(0);
+    commands.Draw(1);
+    commands.Draw(1);                       // Draws always record, even with unchanged state
+    commands.BindMesh(&b);
+    commands.SetInstances(0);
+    commands.Draw(3);
+
+    CHECK_EQ(FormatCommands(commands.GetCommands()), String("Pipeline Mesh Instances Draw Draw Mesh Draw "));
+    CHECK_EQ(commands.GetDrawCount(), 3u);
+
+    // Reset forgets the bound state, so the next frame binds again
+    commands.Reset();
+    CHECK(commands.GetCommands().empty());
+    commands.BindPipeline(DEFAULT_PIPELINE);
+    commands.BindMesh(&b);
+    CHECK_EQ(FormatCommands(commands.GetCommands()), String("Pipeline Mesh "));
+}
+
+// One SetInstances and Draw per batch, with instance offsets moved past anything already in
+// the buffer
+AGK_TEST(RenderCommands, AddBatchesRecordsOneDrawPerBatch)
+{
+    TestMesh a("a"), b("b");
+    InstanceBatcher batcher;
+    batcher.Reset();
+    for (Core::Resource* mesh : { &a, &b, &a, &a, &b }) {
+        batcher.Add(mesh, nullptr, Math::Matrix4x4::Translation(1.0f, 0.0f, 0.0f));
+    }
+    batcher.Flush(BatchOrder::Grouped);
+
+    RenderCommandBuffer commands;
+    commands.Reset();
+    InstanceData existing[2] = {};
+    CHECK_EQ(commands.AddInstances(existing), 0u);
+    commands.BindPipeline(DEFAULT_PIPELINE);
+    commands.AddBatches(batcher);
+
+    auto recorded = commands.GetCommands();
+    CHECK_EQ(FormatCommands(recorded), String("Pipeline Mesh Instances Draw Mesh Instances Draw "));
+    CHECK(recorded[1].bindMesh.mesh == &a);
+    CHECK_EQ(recorded[2].setInstances.firstInstance, 2u);
+    CHECK_EQ(recorded[3].draw.instanceCount, 3u);
+    CHECK(recorded[4].bindMesh.mesh == &b);
+    CHECK_EQ(recorded[5].setInstances.firstInstance, 5u);
+    CHECK_EQ(recorded[6].draw.instanceCount, 2u);
+
+    CHECK_EQ(commands.GetInstances().size(), 7u);
+    CHECK_EQ(commands.GetInstances()[2].world[12], 1.0f);
+    CHECK_EQ(commands.GetDrawCount(), 2u);
+}
+
+AGK_TEST(RenderCommands, NullExecutorCountsCommandsAndInvalidDraws)
+{
+    TestMesh a("a");
+    RenderCommandBuffer commands;
+    commands.Reset();
+    commands.Draw(1);                       // No pipeline or mesh yet
+    commands.BindPipeline(DEFAULT_PIPELINE);
+    commands.Draw(1);                       // Still no mesh
+    commands.BindMesh(&a);
+    commands.SetInstances(0);
+    commands.Draw(4);
+    commands.SetInstances(4);
+    commands.Draw(2);
+
+    NullRenderExecutor executor(true);
+    executor.Execute(commands);
+    executor.Execute(commands);
+
+    const RenderCommandStats& stats = executor.GetStats();
+    CHECK_EQ(stats.frames, 2u);
+    CHECK_EQ(stats.GetCount(RenderCommandType::BindPipeline), 2u);
+    CHECK_EQ(stats.GetCount(RenderCommandType::BindMesh), 2u);
+    CHECK_EQ(stats.GetCount(RenderCommandType::SetInstances), 4u);
+    CHECK_EQ(stats.GetCount(RenderCommandType::Draw), 8u);
+    CHECK_EQ(stats.GetStateChanges(), 8u);
+    CHECK_EQ(stats.instances, 12u);
+    CHECK_EQ(stats.invalidDraws, 4u);
+    CHECK_EQ(executor.GetRecordedCommands().size(), commands.GetCommands().size());
+
+    executor.ResetStats();
+    CHECK_EQ(executor.GetStats().frames, 0u);
+
+    // Without recording nothing is kept
+    NullRenderExecutor counting;
+    counting.Execute(commands);
+    CHECK(counting.GetRecordedCommands().empty());
+}
+
+// A grouped opaque layer draws each mesh once however the entities were sorted; a preserved
+// one only merges neighbours, which a depth sort rarely leaves next to each other.
+AGK_TEST(RenderCommands, SceneFrameCommandCounts)
+{
+    constexpr U32 entityCount = 10000;
+    constexpr U32 meshCount = 64;
+    SyntheticScene scene(entityCount, meshCount);
+    InstanceBatcher batcher;
+    RenderCommandBuffer commands;
+    NullRenderExecutor executor;
+
+    scene.Record(batcher, commands, BatchOrder::Grouped);
+    executor.Execute(commands);
+    const RenderCommandStats& stats = executor.GetStats();
+    CHECK_EQ(commands.GetDrawCount(), meshCount);
+    CHECK_EQ(stats.GetCount(RenderCommandType::Draw), U64(meshCount));
+    CHECK_EQ(stats.GetCount(RenderCommandType::BindPipeline), 1u);
+    CHECK_EQ(stats.GetCount(RenderCommandType::BindMesh), U64(meshCount));
+    CHECK_EQ(stats.GetCount(RenderCommandType::SetInstances), U64(meshCount));
+    CHECK_EQ(stats.instances, U64(entityCount));
+    CHECK_EQ(stats.invalidDraws, 0u);
+    CHECK_EQ(commands.GetCommands().size(), size_t(1 + 3 * meshCount));
+
+    executor.ResetStats();
+    scene.Record(batcher, commands, BatchOrder::Preserve);
+    executor.Execute(commands);
+    CHECK(commands.GetDrawCount() > entityCount / 2);
+    CHECK_EQ(executor.GetStats().instances, U64(entityCount));
+    CHECK_EQ(executor.GetStats().GetCount(RenderCommandType::BindMesh), U64(commands.GetDrawCount()));
+}
+
+// A headless 100k entity frame: batch, record and run on the null executor, with every
+// entity in one grouped opaque layer and, for comparison, in draw order.
+AGK_BENCHMARK(RenderCommands, HeadlessFrame100kEntities)
+{
+    constexpr U32 entityCount = 100000;
+    constexpr U32 frames = 20;
+
+    for (U32 meshCount : { 64u, 1024u }) {
+        SyntheticScene scene(entityCount, meshCount);
+        InstanceBatcher batcher;
+        RenderCommandBuffer commands;
+
+        for (BatchOrder order : { BatchOrder::Grouped, BatchOrder::Preserve }) {
+            NullRenderExecutor executor;
+            scene.Record(batcher, commands, order);     // Warms storage
+
+            Stopwatch timer;
+            for (U32 frame = 0; frame < frames; ++frame) {
+                scene.Record(batcher, commands, order);
+                executor.Execute(commands);
+            }
+            const F64 seconds = timer.ElapsedSeconds();
+
+            ReportRate(std::format("{} meshes, {}: {} draws, {} commands", meshCount,
+                order == BatchOrder::Grouped ? "grouped" : "preserved",
+                commands.GetDrawCount(), commands.GetCommands().size()),
+                frames, "frames", seconds);
+            ReportTime("  of which null execute", executor.GetStats().executeMs / frames);
+        }
+    }
+}
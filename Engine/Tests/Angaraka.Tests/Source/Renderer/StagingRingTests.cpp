@@ -0,0 +1,160 @@
+// Engine/Tests/Angaraka.Tests/Source/Renderer/StagingRingTests.cpp
+#include "../TestFramework.hpp"
+
+import Angaraka.Graphics.StagingRing;
+
+using namespace Angaraka;
+using namespace Angaraka::Graphics;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // Callbacks append their name, so the order they were handed out in can be checked
+    struct CallLog {
+        String calls;
+
+        StagingRing::Callback Record(const char* name) {
+            return [this, name] { calls += std::format("{} ", name); };
+        }
+
+        void Run(std::vector<StagingRing::Callback>& completed) {
+            for (auto& callback : completed) {
+                callback();
+            }
+            completed.clear();
+        }
+    };
+
+} // anonymous namespace
+
+AGK_TEST(StagingRing, SubmitReturnsFenceValuesInOrder)
+{
+    StagingRing ring(1024);
+    CHECK_EQ(ring.GetOpenFenceValue(), 1u);
+    CHECK_EQ(ring.GetCompletedFenceValue(), 0u);
+    CHECK(!ring.HasOpenWork());
+    CHECK_EQ(ring.Submit(), 0u);                        // Nothing recorded, nothing to signal
+    CHECK_EQ(ring.GetOpenFenceValue(), 1u);
+
+    CHECK_EQ(ring.Allocate(256, 16), 0u);
+    CHECK_EQ(ring.GetOpenUploads(), 1u);
+    CHECK_EQ(ring.GetOpenBytes(), 256u);
+    CHECK_EQ(ring.Submit(), 1u);
+    CHECK_EQ(ring.GetOpenUploads(), 0u);
+    CHECK_EQ(ring.GetOpenFenceValue(), 2u);
+
+    CHECK(ring.Allocate(256, 16) != StagingRing::INVALID_OFFSET);
+    CHECK_EQ(ring.Submit(), 2u);
+    CHECK_EQ(ring.GetBatchesInFlight(), 2u);
+    CHECK_EQ(ring.GetOldestFenceValue(), 1u);
+
+    // A fresh ring can continue from an existing fence's value
+    ring.Reset(1024, 40);
+    CHECK_EQ(ring.GetOpenFenceValue(), 40u);
+    CHECK(ring.IsComplete(39));
+    CHECK(!ring.IsComplete(40));
+    CHECK_EQ(ring.GetBatchesInFlight(), 0u);
+}
+
+// Callbacks go to the batch their fence value names, whether it is still open or already
+// submitted, and are handed out batch by batch as the fence passes.
+AGK_TEST(StagingRing, RetireHandsOutCallbacksInFenceOrder)
+{
+    StagingRing ring(1024);
+    CallLog log;
+    std::vector<StagingRing::Callback> completed;
+
+    ring.Allocate(128, 16);
+    ring.OnComplete(ring.GetOpenFenceValue(), log.Record("a1"));
+    const U64 first = ring.Submit();
+
+    ring.Allocate(128, 16);
+    ring.OnComplete(ring.GetOpenFenceValue(), log.Record("b1"));
+    ring.OnComplete(first, log.Record("a2"));           // Added to the submitted batch
+    const U64 second = ring.Submit();
+
+    ring.OnComplete(ring.GetOpenFenceValue(), log.Record("c1"));
+    CHECK(ring.HasOpenWork());                          // A callback alone keeps the batch open
+
+    ring.Retire(first - 1, completed);
+    CHECK(completed.empty());
+    CHECK_EQ(ring.GetUsedBytes(), 256u);
+
+    ring.Retire(first, completed);
+    log.Run(completed);
+    CHECK_EQ(log.calls, String("a1 a2 "));
+    CHECK(ring.IsComplete(first));
+    CHECK(!ring.IsComplete(second));
+    CHECK_EQ(ring.GetUsedBytes(), 128u);
+    CHECK_EQ(ring.GetOldestFenceValue(), second);
+
+    // A completed value past the open batch is clamped; its fence has not been signalled
+    ring.Retire(100, completed);
+    log.Run(completed);
+    CHECK_EQ(log.calls, String("a1 a2 b1 "));
+    CHECK_EQ(ring.GetCompletedFenceValue(), second);
+    CHECK(!ring.IsComplete(ring.GetOpenFenceValue()));
+    CHECK_EQ(ring.GetUsedBytes(), 0u);
+
+    const U64 third = ring.Submit();
+    ring.Retire(third, completed);
+    log.Run(completed);
+    CHECK_EQ(log.calls, String("a1 a2 b1 c1 "));
+    CHECK_EQ(ring.GetBatchesInFlight(), 0u);
+    CHECK_EQ(ring.GetOldestFenceValue(), 0u);
+}
+
+// Asking about a fence that has already retired never runs the callback inline; the next
+// Retire hands it out after that call's own batches.
+AGK_TEST(StagingRing, LateCallbacksRunOnNextRetire)
+{
+    StagingRing ring(1024);
+    CallLog log;
+    std::vector<StagingRing::Callback> completed;
+
+    ring.Allocate(64, 16);
+    const U64 first = ring.Submit();
+    ring.Retire(first, completed);
+    CHECK(completed.empty());
+
+    ring.OnComplete(first, log.Record("late"));
+    CHECK(log.calls.empty());
+
+    ring.Allocate(64, 16);
+    ring.OnComplete(ring.GetOpenFenceValue(), log.Record("next"));
+    const U64 second = ring.Submit();
+
+    // Even a Retire that completes nothing new hands out late callbacks
+    ring.Retire(first, completed);
+    log.Run(completed);
+    CHECK_EQ(log.calls, String("late "));
+
+    ring.OnComplete(first, log.Record("late2"));
+    ring.Retire(second, completed);
+    log.Run(completed);
+    CHECK_EQ(log.calls, String("late next late2 "));
+
+    // Reset drops callbacks that were never handed out
+    ring.OnComplete(second, log.Record("dropped"));
+    ring.OnComplete(ring.GetOpenFenceValue(), log.Record("dropped"));
+    ring.Reset(1024);
+    ring.Retire(10, completed);
+    CHECK(completed.empty());
+}
+
+// Staging space is only given back when the batch using it retires
+AGK_TEST(StagingRing, FullRingWaitsForRetire)
+{
+    StagingRing ring(1024);
+    std::vector<StagingRing::Callback> completed;
+
+    CHECK_EQ(ring.Allocate(768, 256), 0u);
+    const U64 first = ring.Submit();
+    CHECK_EQ(ring.Allocate(512, 256), StagingRing::INVALID_OFFSET);
+    CHECK_EQ(ring.GetOpenUploads(), 0u);                // Failed allocations are not uploads
+    CHECK(!ring.HasOpenWork());
+
+    ring.Retire(first, completed);
+    CHECK_EQ(ring.Allocate(512, 256), 0u);
+    CHECK_EQ(ring.Submit(), first + 1);
+}
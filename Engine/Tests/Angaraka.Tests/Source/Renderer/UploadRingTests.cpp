@@ -0,0 +1,156 @@
+// Engine/Tests/Angaraka.Tests/Source/Renderer/UploadRingTests.cpp
+#include "../TestFramework.hpp"
+#include <deque>
+#include <random>
+
+import Angaraka.Graphics.UploadRing;
+
+using namespace Angaraka;
+using namespace Angaraka::Graphics;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    constexpr U64 c_invalid = UploadRingAllocator::INVALID_OFFSET;
+
+    struct Range {
+        U64 begin;
+        U64 end;
+    };
+
+} // anonymous namespace
+
+AGK_TEST(UploadRing, AllocatesAlignedOffsetsUntilFull)
+{
+    UploadRingAllocator ring(1024);
+
+    CHECK_EQ(ring.Allocate(100, 16), 0u);
+    CHECK_EQ(ring.Allocate(100, 16), 112u);             // Padded up to the alignment
+    CHECK_EQ(ring.GetUsedBytes(), 212u);                // Padding counts as used
+    CHECK_EQ(ring.GetFrameBytes(), 212u);
+
+    CHECK_EQ(ring.Allocate(0, 16), c_invalid);
+    CHECK_EQ(ring.Allocate(2048, 16), c_invalid);
+    CHECK_EQ(ring.Allocate(900, 16), c_invalid);        // Would run into the first allocation after wrapping
+    CHECK_EQ(ring.GetUsedBytes(), 212u);
+
+    // Exactly filling the rest of the buffer
+    CHECK_EQ(ring.Allocate(812, 4), 212u);
+    CHECK_EQ(ring.GetUsedBytes(), 1024u);
+    CHECK_EQ(ring.Allocate(4, 4), c_invalid);
+
+    ring.Reset(512);
+    CHECK_EQ(ring.GetCapacity(), 512u);
+    CHECK_EQ(ring.GetUsedBytes(), 0u);
+    CHECK_EQ(ring.GetFramesInFlight(), 0u);
+    CHECK_EQ(ring.Allocate(512, 16), 0u);
+}
+
+// An allocation that does not fit before the end skips the tail and wraps to 0, but only once
+// the frames occupying the start have retired. The skipped tail is charged to the frame that
+// wrapped and handed back with it.
+AGK_TEST(UploadRing, WrapsOnceOlderFramesRetire)
+{
+    UploadRingAllocator ring(1024);
+
+    CHECK_EQ(ring.Allocate(512, 16), 0u);
+    ring.FinishFrame(1);
+    CHECK_EQ(ring.Allocate(256, 16), 512u);
+    ring.FinishFrame(2);
+    CHECK_EQ(ring.GetFramesInFlight(), 2u);
+
+    CHECK_EQ(ring.Allocate(512, 16), c_invalid);        // Frame 1 still holds 0..512
+    ring.Retire(0);
+    CHECK_EQ(ring.Allocate(512, 16), c_invalid);
+
+    ring.Retire(1);
+    CHECK_EQ(ring.GetUsedBytes(), 256u);
+    CHECK_EQ(ring.GetFramesInFlight(), 1u);
+    CHECK_EQ(ring.Allocate(512, 16), 0u);
+    CHECK_EQ(ring.GetFrameBytes(), 768u);               // Skipped tail 768..1024 included
+    CHECK_EQ(ring.GetUsedBytes(), 1024u);
+    CHECK_EQ(ring.Allocate(16, 16), c_invalid);
+    ring.FinishFrame(3);
+
+    // Frames retire in order and a fence past several retires all of them
+    ring.Retire(2);
+    CHECK_EQ(ring.GetUsedBytes(), 768u);
+    ring.Retire(10);
+    CHECK_EQ(ring.GetUsedBytes(), 0u);
+    CHECK_EQ(ring.GetFramesInFlight(), 0u);
+
+    // Once empty the whole capacity is one run again, whatever the head was
+    CHECK_EQ(ring.Allocate(1024, 16), 0u);
+}
+
+AGK_TEST(UploadRing, EmptyFramesAreNotTracked)
+{
+    UploadRingAllocator ring(256);
+    ring.FinishFrame(1);
+    CHECK_EQ(ring.GetFramesInFlight(), 0u);
+
+    CHECK_EQ(ring.Allocate(64, 16), 0u);
+    ring.FinishFrame(2);
+    ring.FinishFrame(3);
+    CHECK_EQ(ring.GetFramesInFlight(), 1u);
+    CHECK_EQ(ring.GetFrameBytes(), 0u);
+
+    ring.Retire(1);
+    CHECK_EQ(ring.GetUsedBytes(), 64u);
+    ring.Retire(2);
+    CHECK_EQ(ring.GetUsedBytes(), 0u);
+}
+
+// Random frames of random allocations with the GPU a few frames behind. Every allocation must
+// be aligned, inside the buffer and clear of every byte still in flight.
+AGK_TEST(UploadRing, LiveAllocationsNeverOverlap)
+{
+    constexpr U64 capacity = 64 * 1024;
+    constexpr U64 latency = 3;
+    UploadRingAllocator ring(capacity);
+    std::deque<std::vector<Range>> inFlight;
+    std::vector<Range> open;
+
+    std::mt19937 random(11);
+    U32 failures = 0;
+    for (U64 frame = 1; frame <= 2000; ++frame) {
+        const U32 allocations = random() % 24;
+        for (U32 i = 0; i < allocations; ++i) {
+            const U64 size = 1 + random() % 4096;
+            const U64 alignment = U64(1) << (random() % 9);
+            const U64 offset = ring.Allocate(size, alignment);
+            if (offset == c_invalid) {
+                ++failures;
+                continue;
+            }
+
+            CHECK_EQ(offset % alignment, 0u);
+            CHECK(offset + size <= capacity);
+            const Range range{ offset, offset + size };
+            for (const auto& frameRanges : inFlight) {
+                for (const Range& live : frameRanges) {
+                    CHECK(range.end <= live.begin || live.end <= range.begin);
+                }
+            }
+            for (const Range& live : open) {
+                CHECK(range.end <= live.begin || live.end <= range.begin);
+            }
+            open.push_back(range);
+        }
+
+        ring.FinishFrame(frame);
+        inFlight.push_back(std::move(open));
+        open.clear();
+        if (frame > latency) {
+            ring.Retire(frame - latency);
+            inFlight.pop_front();
+        }
+        CHECK(ring.GetUsedBytes() <= capacity);
+    }
+
+    // Some frames must have filled the ring for the wrap and full paths to be exercised
+    CHECK(failures > 0);
+
+    ring.Retire(U64(-1));
+    CHECK_EQ(ring.GetUsedBytes(), 0u);
+}
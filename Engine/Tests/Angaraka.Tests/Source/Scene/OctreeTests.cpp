@@ -0,0 +1,201 @@
+// Engine/Tests/Angaraka.Tests/Source/Scene/OctreeTests.cpp
+#include "../TestFramework.hpp"
+#include <random>
+#include <unordered_set>
+
+import Angaraka.Math.Vector3;
+import Angaraka.Math.Matrix4x4;
+import Angaraka.Math.BoundingBox;
+import Angaraka.Math.Frustum;
+import Angaraka.Scene.Entity;
+import Angaraka.Scene.Components.MeshRenderer;
+import Angaraka.Scene.Octree;
+
+using namespace Angaraka;
+using namespace Angaraka::SceneSystem;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    // Entities only keep their scene pointer and nothing here calls back into it, so the octree
+    // is exercised without a Scene and the renderer it needs
+    Scene* HeadlessScene() {
+        alignas(std::max_align_t) static std::byte s_standIn;
+        return reinterpret_cast<Scene*>(&s_standIn);
+    }
+
+    // Renderable entities, so frustum queries consider them; a MeshRenderer without a mesh has
+    // unit cube bounds around the entity
+    struct EntitySet {
+        std::vector<Scope<Entity>> owned;
+        std::vector<Entity*> entities;
+
+        Entity* Add(const Math::Vector3& position) {
+            owned.push_back(CreateScope<Entity>(owned.size() + 1, HeadlessScene()));
+            owned.back()->GetTransform().SetLocalPosition(position);
+            owned.back()->AddComponent<MeshRenderer>();
+            entities.push_back(owned.back().get());
+            return entities.back();
+        }
+    };
+
+    // Uniformly scattered in a cube of the given half size around the origin
+    EntitySet MakeScatteredEntities(U32 count, F32 halfSize, U32 seed) {
+        EntitySet set;
+        set.owned.reserve(count);
+        set.entities.reserve(count);
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<F32> coordinate(-halfSize, halfSize);
+        for (U32 i = 0; i < count; ++i) {
+            set.Add(Math::Vector3(coordinate(random), coordinate(random) * 0.1f, coordinate(random)));
+        }
+        return set;
+    }
+
+    Math::BoundingBox PointBounds(const Math::Vector3& position) {
+        return Math::BoundingBox(position - Math::Vector3(0.5f), position + Math::Vector3(0.5f));
+    }
+
+    Math::Frustum MakeCameraFrustum(const Math::Vector3& eye, const Math::Vector3& target, F32 farPlane) {
+        Math::Matrix4x4 view = Math::Matrix4x4::LookAt(eye, target, Math::Vector3(0.0f, 1.0f, 0.0f));
+        Math::Matrix4x4 projection = Math::Matrix4x4::Perspective(1.0f, 16.0f / 9.0f, 0.1f, farPlane);
+        return Math::Frustum(view, projection);
+    }
+
+    bool IsEachEntityFoundOnce(const Octree& octree, const EntitySet& set) {
+        std::vector<Entity*> results;
+        for (Entity* entity : set.entities) {
+            results.clear();
+            octree.Query(PointBounds(entity->GetTransform().GetWorldPosition()), results);
+            if (std::count(results.begin(), results.end(), entity) != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // anonymous namespace
+
+// The world starts small, so inserting the batch grows the root several times part way through.
+// Every entity must still be indexed exactly once afterwards.
+AGK_TEST(Octree, InsertMultipleExpandsRootWithinBatch)
+{
+    Octree::Config config;
+    config.worldBounds = Math::BoundingBox(Math::Vector3(-10.0f), Math::Vector3(10.0f));
+    Octree octree(config);
+
+    EntitySet set = MakeScatteredEntities(2000, 500.0f, 3);
+    octree.InsertMultiple(set.entities);
+
+    CHECK_EQ(octree.GetEntityCount(), 2000u);
+    CHECK(IsEachEntityFoundOnce(octree, set));
+
+    std::vector<Entity*> all;
+    octree.Query(octree.GetBounds(), all);
+    CHECK_EQ(std::unordered_set<Entity*>(all.begin(), all.end()).size(), size_t(2000));
+}
+
+// Re-inserting tracked entities inside a batch defers their moves to the end of the batch. A later
+// entity of the same batch grows the root, which re-indexes everything; the deferred moves must
+// still land and the batch must close normally.
+AGK_TEST(Octree, ExpansionKeepsPendingBatchUpdates)
+{
+    Octree::Config config;
+    config.worldBounds = Math::BoundingBox(Math::Vector3(-50.0f), Math::Vector3(50.0f));
+    Octree octree(config);
+
+    EntitySet set = MakeScatteredEntities(500, 40.0f, 7);
+    octree.InsertMultiple(set.entities);
+
+    // Move the first half, then add entities far outside the root in the same batch
+    std::vector<Entity*> batch;
+    for (U32 i = 0; i < 250; ++i) {
+        Entity* entity = set.entities[i];
+        entity->GetTransform().SetLocalPosition(entity->GetTransform().GetLocalPosition() + Math::Vector3(15.0f, 0.0f, 0.0f));
+        batch.push_back(entity);
+    }
+    for (U32 i = 0; i < 50; ++i) {
+        batch.push_back(set.Add(Math::Vector3(1000.0f + i * 10.0f, 0.0f, -1000.0f)));
+    }
+    octree.InsertMultiple(batch);
+
+    CHECK_EQ(octree.GetEntityCount(), 550u);
+    CHECK(IsEachEntityFoundOnce(octree, set));
+
+    // The batch is over, so a plain Update applies right away
+    Entity* moved = set.entities[0];
+    moved->GetTransform().SetLocalPosition(Math::Vector3(-900.0f, 0.0f, 900.0f));
+    octree.Update(moved);
+    std::vector<Entity*> results;
+    octree.Query(PointBounds(Math::Vector3(-900.0f, 0.0f, 900.0f)), results);
+    CHECK_EQ(results.size(), size_t(1));
+}
+
+// Frustum culling with no renderer: octree query against Scene's linear scan, for a camera looking
+// across a 2 km world from a few positions
+AGK_BENCHMARK(Octree, HeadlessFrustumCull)
+{
+    const Math::Vector3 eyes[] = {
+        Math::Vector3(0.0f, 50.0f, -1000.0f),
+        Math::Vector3(-800.0f, 50.0f, 0.0f),
+        Math::Vector3(0.0f, 300.0f, 0.0f),
+        Math::Vector3(700.0f, 20.0f, 700.0f),
+    };
+
+    for (U32 entityCount : { 10000u, 100000u }) {
+        EntitySet set = MakeScatteredEntities(entityCount, 1000.0f, 11);
+
+        Octree::Config config;
+        config.worldBounds = Math::BoundingBox(Math::Vector3(-1100.0f), Math::Vector3(1100.0f));
+        Octree octree(config);
+
+        Stopwatch timer;
+        octree.InsertMultiple(set.entities);
+        ReportRate(std::format("InsertMultiple, {} entities", entityCount), entityCount, "entities", timer.ElapsedSeconds());
+
+        std::vector<Math::Frustum> frustums;
+        for (const Math::Vector3& eye : eyes) {
+            frustums.push_back(MakeCameraFrustum(eye, Math::Vector3(0.0f), 600.0f));
+        }
+
+        constexpr U32 rounds = 20;
+        std::vector<Entity*> visible;
+        visible.reserve(entityCount);
+        size_t octreeVisible = 0;
+        timer.Restart();
+        for (U32 round = 0; round < rounds; ++round) {
+            for (const Math::Frustum& frustum : frustums) {
+                visible.clear();
+                octree.Query(frustum, visible);
+                octreeVisible += visible.size();
+            }
+        }
+        const F64 octreeSeconds = timer.ElapsedSeconds();
+
+        size_t linearVisible = 0;
+        timer.Restart();
+        for (U32 round = 0; round < rounds; ++round) {
+            for (const Math::Frustum& frustum : frustums) {
+                // What Scene does in SpatialQueryMode::Linear
+                visible.clear();
+                for (Entity* entity : set.entities) {
+                    const MeshRenderer* meshRenderer = entity->GetComponent<MeshRenderer>();
+                    if (entity->IsActive() && meshRenderer && meshRenderer->IsVisibleInFrustum(frustum)) {
+                        visible.push_back(entity);
+                    }
+                }
+                linearVisible += visible.size();
+            }
+        }
+        const F64 linearSeconds = timer.ElapsedSeconds();
+
+        // Both test the same MeshRenderer bounds, so they must agree on what is visible
+        CHECK_EQ(octreeVisible, linearVisible);
+
+        const F64 culls = static_cast<F64>(rounds) * frustums.size();
+        std::printf("    %u entities, %.1f%% visible\n", entityCount,
+            100.0 * static_cast<F64>(octreeVisible) / (culls * entityCount));
+        ReportNsPerOp(std::format("Octree cull, {} entities", entityCount), culls, octreeSeconds);
+        ReportNsPerOp(std::format("Linear cull, {} entities", entityCount), culls, linearSeconds);
+    }
+}
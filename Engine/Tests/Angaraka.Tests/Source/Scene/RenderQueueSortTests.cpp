@@ -0,0 +1,186 @@
+// Engine/Tests/Angaraka.Tests/Source/Scene/RenderQueueSortTests.cpp
+#include "../TestFramework.hpp"
+#include <algorithm>
+#include <random>
+
+import Angaraka.Math.Vector3;
+import Angaraka.Scene.Entity;
+import Angaraka.Scene;
+
+using namespace Angaraka;
+using namespace Angaraka::SceneSystem;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    using RenderEntry = Scene::RenderEntry;
+    using RenderQueueType = Scene::RenderQueueType;
+
+    // Only the entities' transforms are read, so no Scene and renderer are needed
+    Scene* HeadlessScene() {
+        alignas(std::max_align_t) static std::byte s_standIn;
+        return reinterpret_cast<Scene*>(&s_standIn);
+    }
+
+    struct RenderSet {
+        std::vector<Scope<Entity>> owned;
+        std::vector<RenderEntry> entries;   // Collection order, keys not built yet
+    };
+
+    // Entities scattered around a camera at the origin, spread over a few render layers
+    RenderSet MakeRenderSet(U32 count, U32 seed) {
+        RenderSet set;
+        set.owned.reserve(count);
+        set.entries.reserve(count);
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<F32> coordinate(-500.0f, 500.0f);
+        std::uniform_int_distribution<U32> layer(0, 3);
+        for (U32 i = 0; i < count; ++i) {
+            set.owned.push_back(CreateScope<Entity>(i + 1, HeadlessScene()));
+            set.owned.back()->GetTransform().SetLocalPosition(Math::Vector3(coordinate(random), coordinate(random), coordinate(random)));
+
+            RenderEntry entry;
+            entry.entity = set.owned.back().get();
+            entry.renderOrder = layer(random);
+            set.entries.push_back(entry);
+        }
+        return set;
+    }
+
+    // What Scene::CollectRenderables does for each entry it queues
+    void BuildSortKeys(std::vector<RenderEntry>& entries, RenderQueueType queue, const Math::Vector3& camera) {
+        for (RenderEntry& entry : entries) {
+            entry.distanceToCamera = (entry.entity->GetTransform().GetWorldPosition() - camera).Length();
+            entry.sortKey = Scene::MakeRenderSortKey(queue, entry.renderOrder, entry.distanceToCamera, nullptr);
+        }
+    }
+
+    // Scene's comparator sort before packed keys, distances are read from the transforms in every
+    // comparison and written back afterwards
+    void LegacySortRenderQueue(std::vector<RenderEntry>& entries, RenderQueueType queue, const Math::Vector3& camera) {
+        const bool backToFront = queue == RenderQueueType::Transparent;
+        std::sort(entries.begin(), entries.end(),
+            [&camera, backToFront](const RenderEntry& a, const RenderEntry& b) {
+                if (a.renderOrder != b.renderOrder) {
+                    return a.renderOrder < b.renderOrder;
+                }
+
+                F32 distA = (a.entity->GetTransform().GetWorldPosition() - camera).LengthSquared();
+                F32 distB = (b.entity->GetTransform().GetWorldPosition() - camera).LengthSquared();
+                return backToFront ? distA > distB : distA < distB;
+            });
+
+        for (RenderEntry& entry : entries) {
+            entry.distanceToCamera = (entry.entity->GetTransform().GetWorldPosition() - camera).Length();
+        }
+    }
+
+    // Layers ascending, then depth in the queue's direction. Keys keep 15 mantissa bits of the
+    // depth, so distances within about 0.003% of each other may come out in either order.
+    bool IsLayerThenDepthOrdered(const std::vector<RenderEntry>& entries, RenderQueueType queue) {
+        const bool backToFront = queue == RenderQueueType::Transparent;
+        for (size_t i = 1; i < entries.size(); ++i) {
+            const RenderEntry& previous = entries[i - 1];
+            const RenderEntry& current = entries[i];
+            if (previous.renderOrder != current.renderOrder) {
+                if (previous.renderOrder > current.renderOrder) {
+                    return false;
+                }
+                continue;
+            }
+
+            const F32 first = backToFront ? current.distanceToCamera : previous.distanceToCamera;
+            const F32 second = backToFront ? previous.distanceToCamera : current.distanceToCamera;
+            if (first > second * 1.0001f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // anonymous namespace
+
+// Below 64 entries the comparison sort runs, above it the radix sort; both must give the order
+// the comparator sort gave, for both directions
+AGK_TEST(RenderQueueSort, MatchesLegacyLayerAndDepthOrder)
+{
+    const Math::Vector3 camera(10.0f, 2.0f, -30.0f);
+    std::vector<RenderEntry> scratch;
+
+    for (U32 count : { 50u, 5000u }) {
+        RenderSet set = MakeRenderSet(count, count);
+        for (RenderQueueType queue : { RenderQueueType::Opaque, RenderQueueType::Transparent }) {
+            std::vector<RenderEntry> legacy = set.entries;
+            LegacySortRenderQueue(legacy, queue, camera);
+            CHECK(IsLayerThenDepthOrdered(legacy, queue));
+
+            std::vector<RenderEntry> sorted = set.entries;
+            BuildSortKeys(sorted, queue, camera);
+            Scene::SortRenderQueue(sorted, scratch);
+            CHECK_EQ(sorted.size(), legacy.size());
+            CHECK(IsLayerThenDepthOrdered(sorted, queue));
+        }
+    }
+}
+
+// Keys that only differ in a few bytes skip the other passes; equal keys keep collection order
+AGK_TEST(RenderQueueSort, EqualKeysKeepCollectionOrder)
+{
+    std::vector<RenderEntry> entries(1000);
+    for (U32 i = 0; i < entries.size(); ++i) {
+        entries[i].renderOrder = i;
+        entries[i].sortKey = (static_cast<U64>(i % 7) << 40) | (i % 3);
+    }
+
+    std::vector<RenderEntry> scratch;
+    Scene::SortRenderQueue(entries, scratch);
+    for (size_t i = 1; i < entries.size(); ++i) {
+        const RenderEntry& previous = entries[i - 1];
+        const RenderEntry& current = entries[i];
+        CHECK(previous.sortKey < current.sortKey
+            || (previous.sortKey == current.sortKey && previous.renderOrder < current.renderOrder));
+    }
+}
+
+// 50k entries per frame: the comparator sort with its distance pass against building the packed
+// keys, which CollectRenderables now does while queueing, plus the radix sort
+AGK_BENCHMARK(RenderQueueSort, LegacyVsRadix50k)
+{
+    constexpr U32 entryCount = 50000;
+    constexpr U32 rounds = 20;
+    const Math::Vector3 camera(10.0f, 2.0f, -30.0f);
+    RenderSet set = MakeRenderSet(entryCount, 5);
+
+    for (RenderQueueType queue : { RenderQueueType::Opaque, RenderQueueType::Transparent }) {
+        const char* queueName = queue == RenderQueueType::Opaque ? "opaque" : "transparent";
+
+        F64 legacySeconds = 0.0;
+        for (U32 round = 0; round < rounds; ++round) {
+            std::vector<RenderEntry> entries = set.entries;
+            Stopwatch timer;
+            LegacySortRenderQueue(entries, queue, camera);
+            legacySeconds += timer.ElapsedSeconds();
+            DoNotOptimize(entries.front());
+        }
+
+        // The scratch buffer lives in the Scene, so it is only allocated once here too
+        std::vector<RenderEntry> scratch;
+        F64 keySeconds = 0.0;
+        F64 radixSeconds = 0.0;
+        for (U32 round = 0; round < rounds; ++round) {
+            std::vector<RenderEntry> entries = set.entries;
+            Stopwatch timer;
+            BuildSortKeys(entries, queue, camera);
+            keySeconds += timer.ElapsedSeconds();
+
+            timer.Restart();
+            Scene::SortRenderQueue(entries, scratch);
+            radixSeconds += timer.ElapsedSeconds();
+            CHECK(IsLayerThenDepthOrdered(entries, queue));
+        }
+
+        ReportTime(std::format("Comparator sort, {} {}", entryCount, queueName), legacySeconds * 1000.0 / rounds);
+        ReportTime(std::format("Sort keys, {} {}", entryCount, queueName), keySeconds * 1000.0 / rounds);
+        ReportTime(std::format("Radix sort, {} {}", entryCount, queueName), radixSeconds * 1000.0 / rounds);
+    }
+}
@@ -0,0 +1,92 @@
+// Engine/Tests/Angaraka.Tests/Source/Scene/TransformSystemTests.cpp
+#include "../TestFramework.hpp"
+
+import Angaraka.Math.Vector3;
+import Angaraka.Math.Matrix4x4;
+import Angaraka.Math.Transform;
+import Angaraka.Scene.TransformSystem;
+
+using namespace Angaraka;
+using namespace Angaraka::SceneSystem;
+using namespace Angaraka::Tests;
+
+namespace {
+
+    TransformHandle RegisterAt(TransformSystem& system, const Math::Vector3& position, TransformHandle parent = InvalidTransformHandle) {
+        return system.Register(nullptr, Math::Transform(position), parent);
+    }
+
+    bool IsNear(const Math::Vector3& a, const Math::Vector3& b) {
+        return (a - b).LengthSquared() < 1e-8f;
+    }
+
+} // anonymous namespace
+
+AGK_TEST(TransformSystem, ChildWorldMatrixFollowsParent)
+{
+    TransformSystem system;
+    TransformHandle root = RegisterAt(system, Math::Vector3(1.0f, 0.0f, 0.0f));
+    TransformHandle child = RegisterAt(system, Math::Vector3(0.0f, 2.0f, 0.0f), root);
+    system.Update();
+
+    CHECK_EQ(system.GetLevelCount(), 2u);
+    CHECK(IsNear(system.GetWorldMatrix(child).GetTranslation(), Math::Vector3(1.0f, 2.0f, 0.0f)));
+
+    system.SetLocalPosition(root, Math::Vector3(5.0f, 0.0f, 0.0f));
+    system.Update();
+    CHECK(IsNear(system.GetWorldMatrix(child).GetTranslation(), Math::Vector3(5.0f, 2.0f, 0.0f)));
+}
+
+// a -> b -> c and d under b, then a is parented to c. The cycle is broken by detaching one slot
+// to the root; every handle stays valid and the chain below it is preserved.
+AGK_TEST(TransformSystem, ParentCycleIsDetachedToRoot)
+{
+    TransformSystem system;
+    TransformHandle a = RegisterAt(system, Math::Vector3(1.0f, 0.0f, 0.0f));
+    TransformHandle b = RegisterAt(system, Math::Vector3(0.0f, 1.0f, 0.0f), a);
+    TransformHandle c = RegisterAt(system, Math::Vector3(0.0f, 0.0f, 1.0f), b);
+    TransformHandle d = RegisterAt(system, Math::Vector3(0.0f, 0.0f, 4.0f), b);
+    TransformHandle other = RegisterAt(system, Math::Vector3(9.0f, 0.0f, 0.0f));
+    system.Update();
+
+    system.SetParent(a, c);
+    system.Update();
+
+    CHECK_EQ(system.GetTransformCount(), 5u);
+    CHECK(!system.HasPendingChanges());
+    for (TransformHandle handle : { a, b, c, d, other }) {
+        CHECK(system.IsValid(handle));
+    }
+
+    // a is the first slot of the cycle, so it becomes the root again
+    CHECK_EQ(system.GetLevelCount(), 3u);
+    CHECK(IsNear(system.GetWorldMatrix(a).GetTranslation(), Math::Vector3(1.0f, 0.0f, 0.0f)));
+    CHECK(IsNear(system.GetWorldMatrix(c).GetTranslation(), Math::Vector3(1.0f, 1.0f, 1.0f)));
+    CHECK(IsNear(system.GetWorldMatrix(d).GetTranslation(), Math::Vector3(1.0f, 1.0f, 4.0f)));
+
+    // Handles still map to their own slots after the reorder
+    system.SetLocalPosition(d, Math::Vector3(0.0f, 0.0f, 8.0f));
+    system.SetLocalPosition(other, Math::Vector3(-3.0f, 0.0f, 0.0f));
+    system.Update();
+    CHECK(IsNear(system.GetWorldMatrix(d).GetTranslation(), Math::Vector3(1.0f, 1.0f, 8.0f)));
+    CHECK(IsNear(system.GetWorldMatrix(other).GetTranslation(), Math::Vector3(-3.0f, 0.0f, 0.0f)));
+    CHECK(IsNear(system.GetLocalPosition(c), Math::Vector3(0.0f, 0.0f, 1.0f)));
+}
+
+// Two separate cycles, one of them a transform parented to itself
+AGK_TEST(TransformSystem, EveryParentCycleIsBroken)
+{
+    TransformSystem system;
+    TransformHandle self = RegisterAt(system, Math::Vector3(2.0f, 0.0f, 0.0f));
+    TransformHandle x = RegisterAt(system, Math::Vector3(0.0f, 1.0f, 0.0f));
+    TransformHandle y = RegisterAt(system, Math::Vector3(0.0f, 2.0f, 0.0f), x);
+    system.Update();
+
+    system.SetParent(self, self);
+    system.SetParent(x, y);
+    system.Update();
+
+    CHECK_EQ(system.GetLevelCount(), 2u);
+    CHECK(IsNear(system.GetWorldMatrix(self).GetTranslation(), Math::Vector3(2.0f, 0.0f, 0.0f)));
+    CHECK(IsNear(system.GetWorldMatrix(y).GetTranslation(), Math::Vector3(0.0f, 3.0f, 0.0f)));
+}
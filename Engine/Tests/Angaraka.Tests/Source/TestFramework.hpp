@@ -0,0 +1,151 @@
+// Engine/Tests/Angaraka.Tests/Source/TestFramework.hpp
+#pragma once
+
+#include <Angaraka/Base.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <format>
+#include <sstream>
+
+namespace Angaraka::Tests {
+
+    /**
+     * @brief A registered test or benchmark. Benchmarks only run when --bench is passed.
+     */
+    struct TestCase {
+        const char* suite;
+        const char* name;
+        void (*function)();
+        bool isBenchmark;
+    };
+
+    inline std::vector<TestCase>& GetRegistry() {
+        static std::vector<TestCase> registry;
+        return registry;
+    }
+
+    struct TestRegistrar {
+        TestRegistrar(const char* suite, const char* name, void (*function)(), bool isBenchmark) {
+            GetRegistry().push_back({ suite, name, function, isBenchmark });
+        }
+    };
+
+    /**
+     * @brief Thrown by a failed CHECK. The runner reports it and moves on to the next test.
+     */
+    class CheckFailure : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    template<typename T>
+    String FormatValue(const T& value) {
+        if constexpr (requires(std::ostream& os) { os << value; }) {
+            std::ostringstream stream;
+            stream << value;
+            return stream.str();
+        }
+        else {
+            return "<unprintable>";
+        }
+    }
+
+    [[noreturn]] inline void FailCheck(const char* file, int line, const String& message) {
+        throw CheckFailure(std::format("{}({}): {}", file, line, message));
+    }
+
+    /**
+     * @brief Wall clock timer for benchmarks
+     */
+    class Stopwatch {
+    public:
+        Stopwatch() : m_start(std::chrono::steady_clock::now()) {}
+
+        void Restart() { m_start = std::chrono::steady_clock::now(); }
+        F64 ElapsedSeconds() const {
+            return std::chrono::duration<F64>(std::chrono::steady_clock::now() - m_start).count();
+        }
+        F64 ElapsedMilliseconds() const { return ElapsedSeconds() * 1000.0; }
+
+    private:
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Benchmark output, one aligned line per measurement
+    inline void ReportRate(std::string_view label, F64 count, std::string_view unit, F64 seconds) {
+        F64 rate = seconds > 0.0 ? count / seconds : 0.0;
+        std::printf("    %-48.*s %12.2f %.*s/s  (%.2f ms)\n",
+            static_cast<int>(label.size()), label.data(), rate,
+            static_cast<int>(unit.size()), unit.data(), seconds * 1000.0);
+    }
+
+    inline void ReportTime(std::string_view label, F64 milliseconds) {
+        std::printf("    %-48.*s %12.3f ms\n", static_cast<int>(label.size()), label.data(), milliseconds);
+    }
+
+    // Cost per operation, for cases where a single call is the interesting number
+    inline void ReportNsPerOp(std::string_view label, F64 count, F64 seconds) {
+        F64 ns = count > 0.0 ? seconds * 1e9 / count : 0.0;
+        std::printf("    %-48.*s %12.2f ns/op  (%.2f ms)\n",
+            static_cast<int>(label.size()), label.data(), ns, seconds * 1000.0);
+    }
+
+    // Fixture files are read relative to this directory. Defaults to "Fixtures", which the post-build
+    // step copies next to the executable; --fixtures overrides it.
+    inline String& GetFixtureDirectory() {
+        static String directory = "Fixtures";
+        return directory;
+    }
+
+    inline String FixturePath(std::string_view relativePath) {
+        return std::format("{}/{}", GetFixtureDirectory(), relativePath);
+    }
+
+    // Keeps the optimizer from discarding a benchmarked result
+    template<typename T>
+    inline void DoNotOptimize(const T& value) {
+        static volatile const void* sink;
+        sink = &value;
+    }
+
+} // namespace Angaraka::Tests
+
+#define AGK_TEST_CONCAT_IMPL(a, b) a##b
+#define AGK_TEST_CONCAT(a, b) AGK_TEST_CONCAT_IMPL(a, b)
+
+#define AGK_REGISTER_CASE(suite, name, isBenchmark) \
+    static void AGK_TEST_CONCAT(suite, _##name)(); \
+    static ::Angaraka::Tests::TestRegistrar AGK_TEST_CONCAT(s_registrar_##suite, _##name)( \
+        #suite, #name, &AGK_TEST_CONCAT(suite, _##name), isBenchmark); \
+    static void AGK_TEST_CONCAT(suite, _##name)()
+
+#define AGK_TEST(suite, name)      AGK_REGISTER_CASE(suite, name, false)
+#define AGK_BENCHMARK(suite, name) AGK_REGISTER_CASE(suite, name, true)
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            ::Angaraka::Tests::FailCheck(__FILE__, __LINE__, "CHECK(" #condition ") failed"); \
+        } \
+    } while (false)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        const auto& agkActual = (actual); \
+        const auto& agkExpected = (expected); \
+        if (!(agkActual == agkExpected)) { \
+            ::Angaraka::Tests::FailCheck(__FILE__, __LINE__, std::format("CHECK_EQ(" #actual ", " #expected ") failed: {} != {}", \
+                ::Angaraka::Tests::FormatValue(agkActual), ::Angaraka::Tests::FormatValue(agkExpected))); \
+        } \
+    } while (false)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+    do { \
+        const double agkActual = static_cast<double>(actual); \
+        const double agkExpected = static_cast<double>(expected); \
+        if (!(std::abs(agkActual - agkExpected) <= static_cast<double>(tolerance))) { \
+            ::Angaraka::Tests::FailCheck(__FILE__, __LINE__, std::format("CHECK_NEAR(" #actual ", " #expected ") failed: {} vs {} (tolerance {})", \
+                agkActual, agkExpected, static_cast<double>(tolerance))); \
+        } \
+    } while (false)